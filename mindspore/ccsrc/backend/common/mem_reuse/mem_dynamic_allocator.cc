@@ -17,6 +17,7 @@
 #include "include/backend/mem_reuse/mem_dynamic_allocator.h"
 #include <string>
 #include <algorithm>
+#include <iterator>
 #include <numeric>
 #include <ostream>
 #include <utility>
@@ -61,6 +62,18 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
     stream_id = kDefaultStreamIndex;
   }
   size_t align_size = AlignMemorySize(size);
+  // Fast path: reuse the cached memory buf of the same size class without taking the pool lock.
+  bool cacheable = IsMemBufCacheable(align_size, from_persistent_mem, need_recycle, stream_id);
+  if (cacheable) {
+    auto cached_addr = mem_buf_cache_.Pop(align_size, stream_id);
+    if (cached_addr != nullptr) {
+      mem_buf_cache_.Track(cached_addr, align_size, stream_id);
+      MS_LOG(DEBUG) << "Alloc memory from mem buf cache, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
+                    << ", stream id: " << stream_id << ", address:" << cached_addr << ", size:" << size << "B.";
+      return cached_addr;
+    }
+  }
+
 #ifdef __APPLE__
   std::lock_guard<SpinLock> spin_lock(spin_lock_);
 #else
@@ -68,6 +81,19 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
 #endif
   // Find the memory buf by tensor size, if not find, then add new memory block and memory buf.
   DeviceMemPtr device_addr = FindAvailableMemBuf(align_size, from_persistent_mem, stream_id);
+  if (device_addr == nullptr && mem_buf_cache_.cached_size() != 0) {
+    // Return the cached memory bufs to the best-fit index before extending the pool.
+    MS_LOG(DEBUG) << "Find available mem buf failed, drain the mem buf cache of size: " << mem_buf_cache_.cached_size();
+    FreeCachedMemBufsInner(mem_buf_cache_.DrainAll());
+    device_addr = FindAvailableMemBuf(align_size, from_persistent_mem, stream_id);
+  }
+  if (device_addr == nullptr && IsEnableDefragment()) {
+    // Defragment the pool rather than extending it when the idle memory is enough but not continuous.
+    auto &mem_mng = from_persistent_mem ? persistent_mem_ : common_mem_;
+    if (IsFragmentationOom(align_size, mem_mng, stream_id)) {
+      DefragmentMemPool(mem_mng, stream_id);
+    }
+  }
   static bool init_recycle_memory = false;
   if (need_recycle && !init_recycle_memory) {
     // Force persist memory to be reserved when recycle memory is allocated for the first time
@@ -93,6 +119,9 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
   if (IsMemoryPoolRecycle()) {
     (void)mem_bufs_.insert(device_addr);
   }
+  if (cacheable && device_addr != nullptr) {
+    mem_buf_cache_.Track(device_addr, align_size, stream_id);
+  }
   MS_LOG(DEBUG) << "Alloc memory details, name:" << DynamicMemAllocatorDebugInfo::GetDebugInfo().name_
                 << ", persistent_mem:" << from_persistent_mem << ", stream id: " << stream_id
                 << ", address:" << device_addr << ", size:" << size << "B, total allocated mem:" << TotalMemStatistics()
@@ -115,6 +144,10 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(const
 #else
   std::lock_guard<std::mutex> locker(mutex_);
 #endif
+  // The pre-alloc memory will be split, so it can't be returned to the mem buf cache as a whole.
+  if (IsEnableMemBufCache()) {
+    mem_buf_cache_.Untrack(device_addr);
+  }
   // Remove the pre-alloc memory.
   auto mem_block = FindMemBlock(device_addr, common_mem_);
   if (mem_block == nullptr) {
@@ -328,6 +361,7 @@ DeviceMemPtr DynamicMemPoolBestFit::AddMemBlockAndMemBufByEagerFree(size_t size,
   if (!SyncAllStreams()) {
     MS_LOG(INTERNAL_EXCEPTION) << "Sync all streams failed.";
   }
+  FreeCachedMemBufsInner(mem_buf_cache_.DrainAll());
   FreeIdleMemsByEagerFree();
   auto mem_addr = FindMemBufByStatus(size, from_persistent_mem, DynamicMemBufStatus::kMemBufEagerFree, stream_id);
   if (mem_addr != nullptr) {
@@ -431,6 +465,132 @@ const size_t DynamicMemPoolBestFit::FreeIdleMemsByEagerFree() {
   return real_free_size;
 }
 
+const bool DynamicMemPoolBestFit::IsEnableDefragment() const {
+  static const bool enable_defragment = common::GetEnv("MS_DEV_ENABLE_MEM_DEFRAG") == "1";
+  return enable_defragment;
+}
+
+bool DynamicMemPoolBestFit::IsFragmentationOom(size_t size, const MemStatusManagerPtr &mem_mng,
+                                               uint32_t stream_id) {
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  const auto &idle_mem_buf_map = mem_mng->GetIdleMemBufMap(stream_id);
+  size_t total_idle_size = 0;
+  for (const auto &[mem_buf_size, mem_buf] : idle_mem_buf_map) {
+    total_idle_size += mem_buf_size;
+  }
+  if (total_idle_size < size) {
+    return false;
+  }
+  MS_LOG(INFO) << "The alloc size[" << size << "] fails because of fragmentation, total idle size[" << total_idle_size
+               << "] of stream id[" << stream_id << "], idle mem buf count[" << idle_mem_buf_map.size() << "].";
+  return true;
+}
+
+void DynamicMemPoolBestFit::DefragmentMemPool(const MemStatusManagerPtr &mem_mng, uint32_t stream_id) {
+  size_t release_size = 0;
+  if (IsEnableEagerFree()) {
+    // The eager free routine doesn't move any memory buf either. It frees the physical memory of all the idle memory
+    // bufs, including the ones in the partially used memory blocks, and turns them into eager free memory bufs which
+    // are combined with the adjacent eager free ones. So the alloc only gets a larger continuous buf where the idle
+    // bufs were next to the eager free ones, and the physical memory freed can back the new memory blocks.
+    if (!SyncAllStreams()) {
+      MS_LOG(WARNING) << "Sync all streams failed, skip defragmenting by eager free.";
+      return;
+    }
+    is_trigger_eager_free_ = true;
+    FreeCachedMemBufsInner(mem_buf_cache_.DrainAll());
+    release_size = FreeIdleMemsByEagerFree();
+    MS_LOG(INFO) << "Defragment memory pool by eager free, release size[" << release_size << "].";
+  } else {
+    // The idle memory blocks of other streams can be released only when all the streams are synchronized.
+    bool all_streams = SyncAllStreams();
+    release_size = ReleaseIdleMemBlocks(mem_mng, stream_id, all_streams);
+    MS_LOG(INFO) << "Defragment memory pool by releasing idle memory blocks, stream id[" << stream_id
+                 << "], all streams[" << all_streams << "], release size[" << release_size << "].";
+  }
+  if (release_size != 0) {
+    ++defragment_count_;
+  }
+}
+
+size_t DynamicMemPoolBestFit::ReleaseIdleMemBlocks(const MemStatusManagerPtr &mem_mng, uint32_t stream_id,
+                                                   bool all_streams) {
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  size_t release_size = 0;
+  auto &mem_block_list = mem_mng->mem_block_list_;
+  for (auto iter = mem_block_list.begin(); iter != mem_block_list.end();) {
+    const auto mem_block = *iter;
+    MS_EXCEPTION_IF_NULL(mem_block);
+    if (!all_streams && mem_block->stream_id_ != stream_id) {
+      ++iter;
+      continue;
+    }
+    // Only the memory block composed of one idle memory buf can be released, since the adjacent idle memory bufs are
+    // combined when freed and the used memory bufs can't be moved.
+    const auto &mem_buf_map = mem_block->block_all_mem_buf_map_;
+    if (mem_buf_map.size() != 1 || mem_buf_map.begin()->second->status_ != DynamicMemBufStatus::kMemBufIdle) {
+      ++iter;
+      continue;
+    }
+    if (!FreeDeviceMem(mem_block->device_addr())) {
+      MS_LOG(WARNING) << "Free device memory[" << mem_block->device_addr() << "] failed when defragmenting.";
+      ++iter;
+      continue;
+    }
+    const auto &mem_buf = mem_buf_map.begin()->second;
+    EraseMemBufByStatus(mem_buf->size_, mem_buf->device_addr_, mem_mng, DynamicMemBufStatus::kMemBufIdle,
+                        mem_block->stream_id_);
+    auto &stream_mem_blocks = mem_mng->mem_blocks_[mem_block->stream_id_];
+    (void)stream_mem_blocks.erase(std::remove(stream_mem_blocks.begin(), stream_mem_blocks.end(), mem_block),
+                                  stream_mem_blocks.end());
+    mem_mng->mps_.total_mem_size_ -= mem_block->size();
+    mem_mng->mps_.total_idle_mem_size_ -= mem_buf->size_;
+    release_size += mem_block->size();
+    iter = mem_block_list.erase(iter);
+  }
+  return release_size;
+}
+
+MemFragmentationInfo DynamicMemPoolBestFit::GetMemBlockFragmentationInfo(const DynamicMemBlockPtr &mem_block) {
+  MS_EXCEPTION_IF_NULL(mem_block);
+  MemFragmentationInfo info;
+  for (const auto &[device_addr, mem_buf] : mem_block->block_all_mem_buf_map_) {
+    MS_EXCEPTION_IF_NULL(mem_buf);
+    if (mem_buf->status_ != DynamicMemBufStatus::kMemBufIdle) {
+      continue;
+    }
+    info.total_idle_size_ += mem_buf->size_;
+    info.largest_idle_size_ = std::max(info.largest_idle_size_, mem_buf->size_);
+    ++info.idle_buf_count_;
+  }
+  return info;
+}
+
+std::vector<MemFragmentationInfo> DynamicMemPoolBestFit::BlockFragmentationStatistics() {
+#ifdef __APPLE__
+  std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+  std::lock_guard<std::mutex> locker(mutex_);
+#endif
+  std::vector<MemFragmentationInfo> infos;
+  (void)std::transform(common_mem_->mem_block_list_.begin(), common_mem_->mem_block_list_.end(),
+                       std::back_inserter(infos), GetMemBlockFragmentationInfo);
+  return infos;
+}
+
+std::map<uint32_t, MemFragmentationInfo> DynamicMemPoolBestFit::StreamFragmentationStatistics() {
+#ifdef __APPLE__
+  std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+  std::lock_guard<std::mutex> locker(mutex_);
+#endif
+  std::map<uint32_t, MemFragmentationInfo> infos;
+  for (const auto &mem_block : common_mem_->mem_block_list_) {
+    infos[mem_block->stream_id_].Accumulate(GetMemBlockFragmentationInfo(mem_block));
+  }
+  return infos;
+}
+
 bool DynamicMemPoolBestFit::IsSplit(size_t tensor_size, size_t mem_buf_size) const {
   return mem_buf_size - tensor_size >= kDynamicMemAlignSize;
 }
@@ -479,6 +639,10 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 }
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  // Fast path: put the memory buf into the cache of its stream without taking the pool lock.
+  if (IsEnableMemBufCache() && mem_buf_cache_.Push(device_addr)) {
+    return;
+  }
 #ifdef __APPLE__
   std::lock_guard<SpinLock> spin_lock(spin_lock_);
 #else
@@ -488,6 +652,9 @@ void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
 }
 
 void DynamicMemPoolBestFit::FreeTensorMemInner(const DeviceMemPtr &device_addr) {
+  if (IsEnableMemBufCache()) {
+    mem_buf_cache_.Untrack(device_addr);
+  }
   CombineMemBuf(device_addr, DynamicMemBufStatus::kMemBufUsed, DynamicMemBufStatus::kMemBufIdle);
 
   if (IsMemoryPoolRecycle()) {
@@ -499,6 +666,52 @@ void DynamicMemPoolBestFit::FreeTensorMemInner(const DeviceMemPtr &device_addr)
                 << "B, total idle mem:" << (TotalMemStatistics() - TotalUsedMemStatistics()) << "B.";
 }
 
+void DynamicMemPoolBestFit::FreeCachedMemBufsInner(const std::vector<DeviceMemPtr> &device_addrs) {
+  for (const auto &device_addr : device_addrs) {
+    CombineMemBuf(device_addr, DynamicMemBufStatus::kMemBufUsed, DynamicMemBufStatus::kMemBufIdle);
+  }
+}
+
+bool DynamicMemPoolBestFit::IsMemBufCacheable(size_t align_size, bool from_persistent_mem, bool need_recycle,
+                                              uint32_t stream_id) const {
+  if (!IsEnableMemBufCache() || from_persistent_mem || need_recycle) {
+    return false;
+  }
+  if (!MemBufCache::IsCacheable(align_size, stream_id)) {
+    return false;
+  }
+  // The memory pool recycle and memory profiling need the address records of every alloc and free.
+  return !IsMemoryPoolRecycle() && !common::IsNeedProfileMemory();
+}
+
+void DynamicMemPoolBestFit::DrainMemBufCache(uint32_t stream_id) {
+  if (!IsEnableMemBufCache()) {
+    return;
+  }
+  auto device_addrs = mem_buf_cache_.Drain(stream_id);
+  if (device_addrs.empty()) {
+    return;
+  }
+#ifdef __APPLE__
+  std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+  std::lock_guard<std::mutex> locker(mutex_);
+#endif
+  FreeCachedMemBufsInner(device_addrs);
+}
+
+void DynamicMemPoolBestFit::DrainAllMemBufCache() {
+  if (!IsEnableMemBufCache()) {
+    return;
+  }
+#ifdef __APPLE__
+  std::lock_guard<SpinLock> spin_lock(spin_lock_);
+#else
+  std::lock_guard<std::mutex> locker(mutex_);
+#endif
+  FreeCachedMemBufsInner(mem_buf_cache_.DrainAll());
+}
+
 void DynamicMemPoolBestFit::CombineMemBuf(const DeviceMemPtr &device_addr, DynamicMemBufStatus origin_status,
                                           DynamicMemBufStatus target_status) {
   MS_EXCEPTION_IF_NULL(device_addr);
@@ -640,6 +853,10 @@ void DynamicMemPoolBestFit::FreePartTensorMems(const std::vector<DeviceMemPtr> &
 #else
   std::lock_guard<std::mutex> locker(mutex_);
 #endif
+  // The keep addresses may locate in the cached memory bufs, so return them to the best-fit index first.
+  if (IsEnableMemBufCache()) {
+    FreeCachedMemBufsInner(mem_buf_cache_.DrainAll());
+  }
 
   for (auto &free_addr : free_addrs) {
     FreeTensorMemInner(free_addr);
@@ -754,6 +971,8 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
   std::lock_guard<std::mutex> locker(mutex_);
 #endif
   DumpDynamicMemPoolStateInfo();
+  // The cached memory bufs are released together with the memory blocks.
+  mem_buf_cache_.Clear();
 
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
     MS_EXCEPTION_IF_NULL(mem_mng);
@@ -782,9 +1001,12 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
     }
 
     std::ostringstream buf;
+    std::map<uint32_t, MemFragmentationInfo> stream_infos;
     for (size_t i = 0; i < mem_mng->mem_block_list_.size(); ++i) {
       size_t mem_block_used_size = 0;
       MS_EXCEPTION_IF_NULL(mem_mng->mem_block_list_[i]);
+      auto fragmentation_info = GetMemBlockFragmentationInfo(mem_mng->mem_block_list_[i]);
+      stream_infos[mem_mng->mem_block_list_[i]->stream_id_].Accumulate(fragmentation_info);
       for (auto mb = mem_mng->mem_block_list_[i]->block_all_mem_buf_map_.begin();
            mb != mem_mng->mem_block_list_[i]->block_all_mem_buf_map_.end(); ++mb) {
         if (mb->second->status_ == DynamicMemBufStatus::kMemBufUsed) {
@@ -795,7 +1017,14 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
         }
       }
       buf << ", block[" << i << "] block size:" << mem_mng->mem_block_list_[i]->mem_block_size_ / kMBToByte
-          << "M idle size:" << (mem_mng->mem_block_list_[i]->mem_block_size_ - mem_block_used_size) / kMBToByte << "M";
+          << "M idle size:" << (mem_mng->mem_block_list_[i]->mem_block_size_ - mem_block_used_size) / kMBToByte
+          << "M largest idle size:" << fragmentation_info.largest_idle_size_ / kMBToByte
+          << "M fragmentation:" << fragmentation_info.FragmentationRatio();
+    }
+    for (const auto &[stream_id, info] : stream_infos) {
+      buf << ", stream[" << stream_id << "] idle size:" << info.total_idle_size_ / kMBToByte
+          << "M largest idle size:" << info.largest_idle_size_ / kMBToByte << "M idle buf counts:" << info.idle_buf_count_
+          << " fragmentation:" << info.FragmentationRatio();
     }
 
     // Dump all the memory buf info
@@ -821,6 +1050,14 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
                << total_used_size_list[static_cast<int>(AllocatorType::kKernelOutput)] / kMBToByte
                << "M, other used size:" << total_used_size_list[static_cast<int>(AllocatorType::kOther)] / kMBToByte
                << "M.";
+  if (IsEnableDefragment()) {
+    MS_LOG(INFO) << "The dynamic memory pool defragment count:" << defragment_count_ << ".";
+  }
+  if (IsEnableMemBufCache()) {
+    MS_LOG(INFO) << "The mem buf cache size:" << MemBufCacheStatistics() / kMBToByte
+                 << "M, hit count:" << mem_buf_cache_.hit_count() << ", miss count:" << mem_buf_cache_.miss_count()
+                 << ".";
+  }
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo() {
@@ -977,6 +1214,99 @@ SizeMapMemBuf &MemStatusManager::GetOrCreateSizeMapMemBuf(std::map<uint32_t, Siz
   return container->at(stream_id);
 }
 
+DeviceMemPtr MemBufCache::Pop(size_t align_size, uint32_t stream_id) {
+  auto &stream_cache = stream_caches_[stream_id];
+  std::lock_guard<SpinLock> locker(stream_cache.lock_);
+  auto iter = stream_cache.size_class_addrs_.find(align_size);
+  if (iter == stream_cache.size_class_addrs_.end() || iter->second.empty()) {
+    (void)miss_count_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  auto device_addr = iter->second.back();
+  iter->second.pop_back();
+  stream_cache.cached_size_ -= align_size;
+  (void)cached_size_.fetch_sub(align_size, std::memory_order_relaxed);
+  (void)hit_count_.fetch_add(1, std::memory_order_relaxed);
+  return device_addr;
+}
+
+bool MemBufCache::Push(const DeviceMemPtr &device_addr) {
+  size_t align_size = 0;
+  uint32_t stream_id = 0;
+  {
+    auto &shard = GetShard(device_addr);
+    std::lock_guard<SpinLock> locker(shard.lock_);
+    auto iter = shard.addrs_.find(device_addr);
+    if (iter == shard.addrs_.end()) {
+      return false;
+    }
+    std::tie(align_size, stream_id) = iter->second;
+    (void)shard.addrs_.erase(iter);
+  }
+
+  auto &stream_cache = stream_caches_[stream_id];
+  std::lock_guard<SpinLock> locker(stream_cache.lock_);
+  if (stream_cache.cached_size_ + align_size > kMemBufCacheMaxSizePerStream) {
+    return false;
+  }
+  auto &addrs = stream_cache.size_class_addrs_[align_size];
+  if (addrs.size() >= kMemBufCacheMaxBufNumPerSize) {
+    return false;
+  }
+  addrs.push_back(device_addr);
+  stream_cache.cached_size_ += align_size;
+  (void)cached_size_.fetch_add(align_size, std::memory_order_relaxed);
+  return true;
+}
+
+void MemBufCache::Track(const DeviceMemPtr &device_addr, size_t align_size, uint32_t stream_id) {
+  auto &shard = GetShard(device_addr);
+  std::lock_guard<SpinLock> locker(shard.lock_);
+  shard.addrs_[device_addr] = std::make_pair(align_size, stream_id);
+}
+
+void MemBufCache::Untrack(const DeviceMemPtr &device_addr) {
+  auto &shard = GetShard(device_addr);
+  std::lock_guard<SpinLock> locker(shard.lock_);
+  (void)shard.addrs_.erase(device_addr);
+}
+
+std::vector<DeviceMemPtr> MemBufCache::Drain(uint32_t stream_id) {
+  std::vector<DeviceMemPtr> device_addrs;
+  if (stream_id >= kMemBufCacheMaxStreamNum) {
+    return device_addrs;
+  }
+  auto &stream_cache = stream_caches_[stream_id];
+  std::lock_guard<SpinLock> locker(stream_cache.lock_);
+  for (auto &[align_size, addrs] : stream_cache.size_class_addrs_) {
+    (void)std::copy(addrs.begin(), addrs.end(), std::back_inserter(device_addrs));
+    (void)cached_size_.fetch_sub(align_size * addrs.size(), std::memory_order_relaxed);
+  }
+  stream_cache.size_class_addrs_.clear();
+  stream_cache.cached_size_ = 0;
+  return device_addrs;
+}
+
+std::vector<DeviceMemPtr> MemBufCache::DrainAll() {
+  std::vector<DeviceMemPtr> device_addrs;
+  if (cached_size() == 0) {
+    return device_addrs;
+  }
+  for (uint32_t stream_id = 0; stream_id < kMemBufCacheMaxStreamNum; ++stream_id) {
+    auto stream_addrs = Drain(stream_id);
+    (void)std::copy(stream_addrs.begin(), stream_addrs.end(), std::back_inserter(device_addrs));
+  }
+  return device_addrs;
+}
+
+void MemBufCache::Clear() {
+  for (auto &shard : track_shards_) {
+    std::lock_guard<SpinLock> locker(shard.lock_);
+    shard.addrs_.clear();
+  }
+  (void)DrainAll();
+}
+
 void MemStatusManager::Clear() noexcept {
   mem_blocks_.clear();
   mem_block_list_.clear();
@@ -16,9 +16,12 @@
 
 #include "backend/common/somas/somas.h"
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iterator>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <random>
@@ -38,6 +41,7 @@
 #include "debug/rdr/string_recorder.h"
 #endif
 #include "include/common/thread_pool.h"
+#include "utils/profile.h"
 #ifndef ENABLE_SECURITY
 #include "plugin/device/ascend/hal/profiler/memory_profiling.h"
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
@@ -76,6 +80,54 @@ constexpr auto kLifeEnd = "life_end";
 constexpr auto kOffset = "offset";
 constexpr auto kCachedResultThreshold = 2000;
 constexpr size_t kLogMergedBlockSize = 10;
+constexpr auto kVmHWM = "VmHWM";
+constexpr size_t kMaxSolvedModelNum = 8;
+constexpr size_t kMaxSolvedModelMemorySize = 256 * 1024 * 1024;
+
+SolvedModelCache &SolvedModelCache::GetInstance() {
+  static SolvedModelCache instance;
+  return instance;
+}
+
+SolvedModelPtr SolvedModelCache::Fetch(const std::string &key) {
+  auto hash = std::hash<std::string>()(key);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = std::find_if(models_.begin(), models_.end(),
+                           [hash, &key](const Entry &entry) { return entry.hash_ == hash && entry.key_ == key; });
+  if (iter == models_.end()) {
+    return nullptr;
+  }
+  // Move the hit model to the front, and the least recently used one is evicted first.
+  models_.splice(models_.begin(), models_, iter);
+  return models_.front().model_;
+}
+
+void SolvedModelCache::Insert(const std::string &key, const SolvedModelPtr &model) {
+  MS_EXCEPTION_IF_NULL(model);
+  MS_EXCEPTION_IF_NULL(model->constraints_);
+  // The large bitset matrix is not kept in the memory.
+  if (model->constraints_->MemorySize() > kMaxSolvedModelMemorySize) {
+    MS_LOG(INFO) << "Skip caching the solved model of size " << model->constraints_->MemorySize();
+    return;
+  }
+  auto hash = std::hash<std::string>()(key);
+  std::lock_guard<std::mutex> lock(mutex_);
+  models_.remove_if([hash, &key](const Entry &entry) { return entry.hash_ == hash && entry.key_ == key; });
+  models_.push_front({hash, key, model});
+  if (models_.size() > kMaxSolvedModelNum) {
+    models_.pop_back();
+  }
+}
+
+void SolvedModelCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  models_.clear();
+}
+
+size_t SolvedModelCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return models_.size();
+}
 
 // set somas result
 void SetSomasResult(std::vector<std::pair<size_t, size_t>> &&output_somas_result,
@@ -179,11 +231,24 @@ bool Somas::Assign(const session::KernelGraph &graph) {
   }
 
   // Computing Conflict pairs
+  auto start_time = std::chrono::system_clock::now();
+  use_lifetime_interval_ = IsExecOrderTotal(graph);
+  model_key_ = CalcModelKey();
+  solved_model_ = SolvedModelCache::GetInstance().Fetch(model_key_);
   MS_LOG(INFO) << "Start Computing Conflict Matrix";
-  ComputeConflictMatrix();
+  if (solved_model_ != nullptr) {
+    ReuseSolvedModel();
+  } else {
+    ComputeConflictMatrix();
+  }
   MS_LOG(INFO) << "End Computing Conflict Matrix";
+  auto conflict_end_time = std::chrono::system_clock::now();
 
   Solve(graph);
+  auto solve_end_time = std::chrono::system_clock::now();
+  if (solved_model_ == nullptr) {
+    SaveSolvedModel();
+  }
 
   if (enable_cache_) {
     SaveSomasResult(graph);
@@ -192,6 +257,18 @@ bool Somas::Assign(const session::KernelGraph &graph) {
   UpdateSomasResultToGraph(graph);
   DumpSomasModelInfo("somas_tensor_offset", graph.graph_id());
 
+  MS_EXCEPTION_IF_NULL(reuse_constraints_);
+  MS_LOG(INFO) << "Somas compile info of graph " << graph.graph_id() << ", total time: "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(solve_end_time - start_time).count()
+               << " ms, conflict time: "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(conflict_end_time - start_time).count()
+               << " ms, solver time: "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(solve_end_time - conflict_end_time).count()
+               << " ms, incremental: " << (solved_model_ != nullptr) << ", reuse constraints: "
+               << (reuse_constraints_->is_interval() ? "lifetime interval" : "bitset matrix") << " of "
+               << reuse_constraints_->MemorySize() << " bytes, peak memory of process: "
+               << ProcessStatus::GetInstance().GetMemoryCost(kVmHWM) << " KB, footprint: " << reused_memory_size_
+               << " bytes.";
   MS_LOG(INFO) << "Somas Allocate end.";
   return true;
 }
@@ -1366,7 +1443,8 @@ void Somas::ComputeBasicMatrix() {
   MS_LOG(INFO) << "End Tensor To Node Dependency Computing";
 
   MS_LOG(INFO) << "Start Tensor Relation Computing";
-  reuse_matrix_.assign(tensor_count, VectorBitSet(tensor_count));
+  reuse_constraints_ = std::make_shared<ReuseConstraints>();
+  reuse_constraints_->InitMatrix(tensor_count);
 
   std::vector<TensorConflictInfo> tensor_conflict_info_list;
   std::vector<TensorConflictInfo> candidate_tensor_list;
@@ -1398,7 +1476,7 @@ void Somas::ComputeBasicMatrix() {
       auto task = [this, jobs, &tensor_conflict_info_list, &tensor_to_node_dependency]() {
         for (const auto &target_tensor : jobs) {
           ComputeOneTensorConflicts(target_tensor, tensor_conflict_info_list, tensor_to_node_dependency,
-                                    &reuse_matrix_);
+                                    reuse_constraints_.get());
         }
         return common::SUCCESS;
       };
@@ -1416,6 +1494,23 @@ void Somas::ComputeBasicMatrix() {
 }
 
 void Somas::ProcessSemiLifeLongTensor() {
+  MS_EXCEPTION_IF_NULL(reuse_constraints_);
+  if (reuse_constraints_->is_interval()) {
+    // The lifetime of semi-life long start tensor starts from the graph start, and the end one ends at the graph end.
+    for (const auto &calc_tensor : tensors_list_) {
+      MS_EXCEPTION_IF_NULL(calc_tensor);
+      const auto &lifetime = reuse_constraints_->GetLifetime(calc_tensor->GetId());
+      if (!lifetime.reusable_) {
+        continue;
+      }
+      if (calc_tensor->IsSemiLifelongStart()) {
+        reuse_constraints_->SetLifetime(calc_tensor->GetId(), 0, lifetime.end_);
+      } else if (calc_tensor->IsSemiLifelongEnd()) {
+        reuse_constraints_->SetLifetime(calc_tensor->GetId(), lifetime.start_, SIZE_MAX);
+      }
+    }
+    return;
+  }
   for (const auto &calc_tensor : tensors_list_) {
     MS_EXCEPTION_IF_NULL(calc_tensor);
     // if the tensor is semi-life long start, it can't reuse with tensor with smaller id.
@@ -1430,12 +1525,12 @@ void Somas::ProcessSemiLifeLongTensor() {
       if (depend_exec_order_) {
         if ((calc_tensor->IsSemiLifelongStart() && target_tensor->GetId() < calc_tensor->GetId()) ||
             (calc_tensor->IsSemiLifelongEnd() && target_tensor->GetId() > calc_tensor->GetId())) {
-          reuse_matrix_[calc_tensor->GetId()].SetBitFalse(target_tensor->GetId());
-          reuse_matrix_[target_tensor->GetId()].SetBitFalse(calc_tensor->GetId());
+          reuse_constraints_->SetConflict(calc_tensor->GetId(), target_tensor->GetId());
+          reuse_constraints_->SetConflict(target_tensor->GetId(), calc_tensor->GetId());
         }
       } else {
-        reuse_matrix_[calc_tensor->GetId()].SetBitFalse(target_tensor->GetId());
-        reuse_matrix_[target_tensor->GetId()].SetBitFalse(calc_tensor->GetId());
+        reuse_constraints_->SetConflict(calc_tensor->GetId(), target_tensor->GetId());
+        reuse_constraints_->SetConflict(target_tensor->GetId(), calc_tensor->GetId());
       }
     }
   }
@@ -1446,11 +1541,41 @@ void Somas::ComputeConflictMatrix() {
     MS_LOG(INFO) << "No Tensor for Conflict computing";
     return;
   }
-  ComputeBasicMatrix();
+  if (use_lifetime_interval_) {
+    ComputeLifetimeIntervals();
+  } else {
+    ComputeBasicMatrix();
+  }
   ProcessSemiLifeLongTensor();
   UpdateUnionTensorsConflict();
 }
 
+void Somas::ComputeLifetimeIntervals() {
+  MS_LOG(INFO) << "Start Conflict Computing (Lifetime Interval Model)";
+  auto start_conflict = std::chrono::system_clock::now();
+  UpdateTensorDestinations();
+
+  // The nodes run one by one in the execution order, so the tensor can be reused by the tensors generated after all its
+  // consumers, which means that their lifetimes from the source node to the last consumer don't overlap.
+  MS_EXCEPTION_IF_NULL(tensors_list_.back());
+  reuse_constraints_ = std::make_shared<ReuseConstraints>();
+  reuse_constraints_->InitLifetimes(tensors_list_.back()->GetId() + 1);
+  for (const auto &tensor : tensors_list_) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    // If the life cycle of the tensor is global, or the tensor does not need to allocate memory, it is not reused
+    if (tensor->IsLifelong() || tensor->GetAlignedSize() == 0) {
+      continue;
+    }
+    auto last_consumer = std::max_element(tensor->consumer_list_.begin(), tensor->consumer_list_.end());
+    auto end = last_consumer == tensor->consumer_list_.end() ? tensor->GetSourceNodeId() : *last_consumer;
+    reuse_constraints_->SetLifetime(tensor->GetId(), tensor->GetSourceNodeId(), end);
+  }
+
+  auto end_conflict = std::chrono::system_clock::now();
+  MS_LOG(INFO) << "End Basic Conflict Computing (Lifetime Interval Model)(time taken "
+               << std::chrono::duration_cast<std::chrono::milliseconds>(end_conflict - start_conflict).count() << "ms)";
+}
+
 void Somas::UpdateContiguousTensorList() {
   processed_contiguous_tensors_list_.clear();
   processed_contiguous_tensors_list_.insert(processed_contiguous_tensors_list_.end(), contiguous_tensors_list_.begin(),
@@ -1504,7 +1629,7 @@ void Somas::UpdateTensorDestinations() {
 void Somas::ComputeOneTensorConflicts(const TensorConflictInfo &target_tensor,
                                       const std::vector<TensorConflictInfo> &tensor_conflict_info_list,
                                       const vector<DynamicBitSet> &nodes_dependency,
-                                      std::vector<VectorBitSet> *tensor_relation) {
+                                      ReuseConstraints *tensor_relation) {
   auto target_tensor_id = target_tensor.tensor_id;
   auto target_src_node_id = target_tensor.src_node_id;
 
@@ -1520,9 +1645,64 @@ void Somas::ComputeOneTensorConflicts(const TensorConflictInfo &target_tensor,
     if (nodes_dependency[target_tensor_id].IsBitTrue(tensor_conflict_info.src_node_id) ||
         nodes_dependency[tensor_conflict_info.tensor_id].IsBitTrue(target_src_node_id)) {
       // calc_tensor and target_tensor have dependencies so they can reuse each other
-      (*tensor_relation)[target_tensor_id].SetBitTrue(tensor_conflict_info.tensor_id);
+      tensor_relation->SetReuse(target_tensor_id, tensor_conflict_info.tensor_id);
+    }
+  }
+}
+
+bool Somas::IsExecOrderTotal(const session::KernelGraph &graph) const {
+  // All the nodes are chained by the control tensors in the execution order of the only stream.
+  return depend_exec_order_ && streams_map_.size() == 1 && !graph.subgraph_multi_call();
+}
+
+std::string Somas::CalcModelKey() const {
+  // The reuse constraints only depend on the dependencies of nodes and the lifetimes of tensors, but not the sizes.
+  std::ostringstream oss;
+  oss << device_name_ << " " << depend_exec_order_ << " " << use_lifetime_interval_ << " " << nodes_list_.size() << " "
+      << tensors_list_.size() << "\n";
+  for (const auto &node : nodes_list_) {
+    MS_EXCEPTION_IF_NULL(node);
+    std::set<size_t> ancestor_ids;
+    (void)std::transform(node->ancestor_nodes_.begin(), node->ancestor_nodes_.end(),
+                         std::inserter(ancestor_ids, ancestor_ids.end()), [](const SomasNodePtr &ancestor) {
+                           MS_EXCEPTION_IF_NULL(ancestor);
+                           return ancestor->GetId();
+                         });
+    oss << "N" << node->GetId() << " " << node->GetStreamId() << ":";
+    for (auto id : ancestor_ids) {
+      oss << " " << id;
+    }
+    oss << "\n";
+  }
+  for (const auto &tensor : tensors_list_) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    oss << "T" << tensor->GetId() << " " << tensor->GetSourceNodeId() << " " << tensor->lifelong_value_ << " "
+        << (tensor->GetAlignedSize() == 0) << " " << tensor->destination_nodes_.size() << ":";
+    for (auto id : tensor->consumer_list_) {
+      oss << " " << id;
+    }
+    oss << "\n";
+  }
+  for (const auto &union_tensors : union_tensors_list_) {
+    oss << "U";
+    for (auto id : union_tensors) {
+      oss << " " << id;
     }
+    oss << "\n";
+  }
+  return oss.str();
+}
+
+void Somas::SaveSolvedModel() const {
+  if (reuse_constraints_ == nullptr || somas_solver_ == nullptr) {
+    return;
   }
+  auto solved_model = std::make_shared<SolvedModel>();
+  solved_model->constraints_ = reuse_constraints_;
+  solved_model->sorting_ = somas_solver_->GetBestSorting();
+  solved_model->fitting_ = somas_solver_->GetBestFitting();
+  solved_model->algorithm_ = somas_solver_->GetBestAlgorithm();
+  SolvedModelCache::GetInstance().Insert(model_key_, solved_model);
 }
 
 void Somas::Solve(const session::KernelGraph &graph) {
@@ -1553,8 +1733,16 @@ void Somas::Solve(const session::KernelGraph &graph) {
   somas_solver_ = std::make_shared<SomasSolverPre>();
   MS_EXCEPTION_IF_NULL(somas_solver_);
   auto core_list = GetCoreList();
-  auto status = somas_solver_->Solving(graph, &solver_tensor_desc_map_, &reuse_matrix_,
-                                       processed_contiguous_tensors_list_, core_list, false);
+  Status status;
+  if (solved_model_ != nullptr) {
+    // Only run the best strategy of the solved model of the same structure.
+    status = somas_solver_->Solving(graph, &solver_tensor_desc_map_, reuse_constraints_.get(),
+                                    processed_contiguous_tensors_list_, core_list, false, false,
+                                    solved_model_->sorting_, solved_model_->fitting_, solved_model_->algorithm_);
+  } else {
+    status = somas_solver_->Solving(graph, &solver_tensor_desc_map_, reuse_constraints_.get(),
+                                    processed_contiguous_tensors_list_, core_list, false);
+  }
   MS_LOG(INFO) << "End Solving";
 
   if (status != SUCCESS) {
@@ -1779,23 +1967,34 @@ void Somas::UpdateUnionTensorsConflict() {
                          return tensor->GetId();
                        });
 
+  MS_EXCEPTION_IF_NULL(reuse_constraints_);
   for (auto union_node_list : union_tensors_list_) {
     size_t head_tid = union_node_list[0];
+    if (reuse_constraints_->is_interval()) {
+      // The lifetime of the first tensor covers all the lifetimes of the union tensors.
+      for (size_t i = 1; i < union_node_list.size(); i++) {
+        reuse_constraints_->MergeLifetime(head_tid, union_node_list[i]);
+      }
+      continue;
+    }
     for (auto id : ids) {
-      if (!reuse_matrix_[head_tid].IsBitTrue(id)) {
+      if (!reuse_constraints_->CanReuse(head_tid, id)) {
         continue;
       }
       for (size_t i = 1; i < union_node_list.size(); i++) {
         auto tid = union_node_list[i];
-        if (!reuse_matrix_[tid].IsBitTrue(id)) {
-          reuse_matrix_[head_tid].SetBitFalse(id);
-          reuse_matrix_[id].SetBitFalse(head_tid);
+        if (!reuse_constraints_->CanReuse(tid, id)) {
+          reuse_constraints_->SetConflict(head_tid, id);
+          reuse_constraints_->SetConflict(id, head_tid);
           break;
         }
       }
     }
   }
+  UpdateUnionTensorsSize();
+}
 
+void Somas::UpdateUnionTensorsSize() {
   for (auto union_node_list : union_tensors_list_) {
     // if union_tensors_list has a zero, when need set all union_tensors in this list is zero
     bool zero_flag = std::any_of(union_node_list.begin(), union_node_list.end(), [this](size_t i) {
@@ -1834,6 +2033,17 @@ void Somas::UpdateUnionTensorsConflict() {
   }
 }
 
+void Somas::ReuseSolvedModel() {
+  MS_EXCEPTION_IF_NULL(solved_model_);
+  MS_LOG(INFO) << "Reuse the solved model " << std::hash<std::string>()(model_key_)
+               << " whose tensors only differ in the sizes.";
+  UpdateTensorDestinations();
+  reuse_constraints_ = solved_model_->constraints_;
+  MS_EXCEPTION_IF_NULL(tensors_list_.back());
+  union_tensors_list_ = GetRegularUnionTensorsList(tensors_list_.back()->GetId() + 1, union_tensors_list_);
+  UpdateUnionTensorsSize();
+}
+
 std::string Somas::SomasInfo(bool calc_hash) const {
   std::ostringstream oss;
   if (!calc_hash) {
@@ -2074,7 +2284,7 @@ void Somas::UpdateTensorPeak(const std::vector<SomasTensorPtr> &peak_tensors) co
         MS_EXCEPTION_IF_NULL(tensor);
         for (const auto &ptensor : peak_tensors) {
           MS_EXCEPTION_IF_NULL(ptensor);
-          if (reuse_matrix_[tensor->GetId()].IsBitTrue(ptensor->GetId())) {
+          if (reuse_constraints_->CanReuse(tensor->GetId(), ptensor->GetId())) {
             tensor->can_reuse_peak_mem_ += ptensor->aligned_size_;
           }
         }
@@ -2153,7 +2363,7 @@ size_t Somas::CalcLowerBound() const {
     peak_tensors.emplace_back(tensor);
   }
 
-  if (reuse_matrix_.empty()) {
+  if (reuse_constraints_ == nullptr || reuse_constraints_->empty()) {
     MS_LOG(INFO) << "No Tensor for Conflict computing, maybe cache is loaded";
     return max_lifetime;
   }
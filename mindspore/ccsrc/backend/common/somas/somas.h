@@ -17,8 +17,10 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_COMMON_SOMAS_SOMAS_H_
 #define MINDSPORE_CCSRC_BACKEND_COMMON_SOMAS_SOMAS_H_
 
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -50,6 +52,41 @@ struct TensorConflictInfo {
   TensorConflictInfo(size_t tensor_id, size_t src_node_id) : tensor_id(tensor_id), src_node_id(src_node_id) {}
 };
 
+// The solved model of graph, which is reused by the later graphs of the same structure whose tensors only differ in the
+// sizes, like the graphs of the other buckets of dynamic shape.
+struct SolvedModel {
+  ReuseConstraintsPtr constraints_;
+  SortingType sorting_;
+  FittingType fitting_;
+  AlgorithmType algorithm_;
+};
+using SolvedModelPtr = std::shared_ptr<SolvedModel>;
+
+// The solved models of the latest graphs in the process, which are keyed by the full structure of graph. The hash of
+// the key only speeds up the lookup, the key itself is compared so that a hash collision never reuses the constraints
+// of another graph.
+class BACKEND_EXPORT SolvedModelCache {
+ public:
+  static SolvedModelCache &GetInstance();
+
+  SolvedModelPtr Fetch(const std::string &key);
+  void Insert(const std::string &key, const SolvedModelPtr &model);
+  void Clear();
+  size_t size();
+
+ private:
+  SolvedModelCache() = default;
+  ~SolvedModelCache() = default;
+
+  struct Entry {
+    size_t hash_;
+    std::string key_;
+    SolvedModelPtr model_;
+  };
+  std::mutex mutex_;
+  std::list<Entry> models_;
+};
+
 struct Block {
   size_t start_offset_;
   size_t size_;
@@ -112,7 +149,12 @@ class BACKEND_EXPORT Somas {
   std::map<std::string, UnReuseType> un_reuse_node_name_;
   // end
 
-  std::vector<VectorBitSet> reuse_matrix_;
+  ReuseConstraintsPtr reuse_constraints_;
+  // Use the lifetime intervals instead of the bitset matrix as the reuse constraints.
+  bool use_lifetime_interval_{false};
+  // The key of the structure to reuse the solved model, and the solved model of the same structure.
+  std::string model_key_;
+  SolvedModelPtr solved_model_;
   // hash id
   std::string hash_id_;
 
@@ -174,11 +216,19 @@ class BACKEND_EXPORT Somas {
   static void ComputeOneTensorConflicts(const TensorConflictInfo &target_tensor,
                                         const std::vector<TensorConflictInfo> &tensor_conflict_info,
                                         const vector<DynamicBitSet> &nodes_dependency,
-                                        std::vector<VectorBitSet> *tensor_relation);
+                                        ReuseConstraints *tensor_relation);
+  void ComputeLifetimeIntervals();
   void UpdateTensorDestinations();
   void UpdateUnionTensorsConflict();
+  void UpdateUnionTensorsSize();
   void ProcessSemiLifeLongTensor();
 
+  // incremental solve
+  bool IsExecOrderTotal(const session::KernelGraph &graph) const;
+  std::string CalcModelKey() const;
+  void ReuseSolvedModel();
+  void SaveSolvedModel() const;
+
   // solver
   void Solve(const session::KernelGraph &graph);
   void UpdateUnionTensorsOffset();
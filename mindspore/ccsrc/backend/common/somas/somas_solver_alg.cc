@@ -127,7 +127,8 @@ bool FootPrint::findFirst(vector<Interval> *interval_v, const BlockTensor &block
   return bfound;
 }
 
-bool FootPrint::findOffset(const std::vector<VectorBitSet> *constraints, const BlockTensor &block, size_t *offset) {
+bool FootPrint::findOffset(const ReuseConstraints *constraints, const BlockTensor &block, size_t *offset) {
+  MS_EXCEPTION_IF_NULL(constraints);
   MS_EXCEPTION_IF_NULL(offset);
   vector<Interval> l_interval;
 
@@ -139,12 +140,12 @@ bool FootPrint::findOffset(const std::vector<VectorBitSet> *constraints, const B
   // transform constrained tensors in non eligible intervals
   if (block.Alone()) {
     if (m_algorithm_ == static_cast<uint32_t>(kManyObjects) && m_starts_.size() > 0 && m_starts_[0]->Alone() &&
-        !(*constraints)[block.m_start_tensor_->index_].IsBitTrue(m_starts_[0]->m_start_tensor_->index_)) {
+        !constraints->CanReuse(block.m_start_tensor_->index_, m_starts_[0]->m_start_tensor_->index_)) {
       return false;
     }
 
     for (const auto &allocated_tensor_info : m_tensors_info_) {
-      if (!(*constraints)[block.m_start_tensor_->index_].IsBitTrue(allocated_tensor_info.index_)) {
+      if (!constraints->CanReuse(block.m_start_tensor_->index_, allocated_tensor_info.index_)) {
         l_interval.emplace_back(allocated_tensor_info.offset_,
                                 allocated_tensor_info.offset_ + allocated_tensor_info.size_);
       }
@@ -156,7 +157,7 @@ bool FootPrint::findOffset(const std::vector<VectorBitSet> *constraints, const B
       for (const auto &allocated_tensor_info : m_tensors_info_) {
         auto allocated_offset = static_cast<int64_t>(allocated_tensor_info.offset_);
         auto allocated_size = static_cast<int64_t>(allocated_tensor_info.size_);
-        if (!(*constraints)[block_tensor->index_].IsBitTrue(allocated_tensor_info.index_)) {
+        if (!constraints->CanReuse(block_tensor->index_, allocated_tensor_info.index_)) {
           int64_t start_first_contiguous = allocated_offset - accumulator - SizeToLong(block_tensor->size_);
           int64_t end_first_contiguous = allocated_offset - accumulator + allocated_size;
           if (start_first_contiguous > start_offset) {
@@ -222,7 +223,7 @@ void FootPrint::printStats() {
   MS_LOG(DEBUG) << "Footprint blocks: " << m_starts_.size() << " \toffset: " << m_offset_;
 }
 bool FastHeuristic::Eval(vector<BlockTensor> *block_tensors_v, const std::shared_ptr<FootPrint> &foot_print,
-                         const std::vector<VectorBitSet> *pConstraints) {
+                         const ReuseConstraints *pConstraints) {
   MS_EXCEPTION_IF_NULL(foot_print);
   auto start = std::chrono::system_clock::now();
 
@@ -29,6 +29,12 @@ namespace mindspore {
 namespace somas {
 constexpr auto kSolBytesThreshold = 100 * 1024 * 1024;
 constexpr auto kSolNumThresholdMultiThread = 8;
+// The strategy of solver, the full set of strategies are searched in parallel unless a single one is specified.
+struct SolverStrategy {
+  AlgorithmType algorithm_;
+  SortingType sorting_;
+  FittingType fitting_;
+};
 Status SomasSolverPre::CheckTensors(const TensorsDescMap *pTensors, uint32_t index1, uint32_t index2) const {
   auto tensors = *pTensors;
   if (tensors[index1] == nullptr) {
@@ -124,16 +130,29 @@ void FindBest(size_t total_sol, const vector<std::shared_ptr<SomasSolverCore>> &
   }
 }
 Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
-                               const std::vector<VectorBitSet> *pConstraints,
-                               const vector<vector<size_t>> &continuous_v, const std::vector<int> &core_list,
-                               bool bVerifySolution, bool, SortingType, FittingType, AlgorithmType) {
+                               const ReuseConstraints *pConstraints, const vector<vector<size_t>> &continuous_v,
+                               const std::vector<int> &core_list, bool bVerifySolution, bool ball,
+                               SortingType sorting, FittingType fitting, AlgorithmType algorithm) {
   Status ret = SUCCESS;
   try {
+    MS_EXCEPTION_IF_NULL(pConstraints);
     TensorsDescMap &tensors = *ptensors;
-    constexpr size_t numSortingTypes = static_cast<size_t>(kNumSortingTypes);
-    constexpr size_t numFittingTypes = static_cast<size_t>(kNumFittingTypes);
-    constexpr size_t numAlgorithmTypes = static_cast<size_t>(kNumAlgorithmTypes);
-    constexpr size_t total_sol = numSortingTypes * numFittingTypes * numAlgorithmTypes;
+    vector<SolverStrategy> strategies;
+    if (ball) {
+      for (size_t algorithm_strategy = 0; algorithm_strategy < static_cast<size_t>(kNumAlgorithmTypes);
+           algorithm_strategy++) {
+        for (size_t sort_strategy = 0; sort_strategy < static_cast<size_t>(kNumSortingTypes); sort_strategy++) {
+          for (size_t branching_strategy = 0; branching_strategy < static_cast<size_t>(kNumFittingTypes);
+               branching_strategy++) {
+            strategies.push_back({AlgorithmType(algorithm_strategy), SortingType(sort_strategy),
+                                  FittingType(branching_strategy)});
+          }
+        }
+      }
+    } else {
+      strategies.push_back({algorithm, sorting, fitting});
+    }
+    const size_t total_sol = strategies.size();
     const double giga = 1024. * 1024. * 1024.;
 
     vector<std::shared_ptr<SomasSolverCore>> solvers;
@@ -143,23 +162,18 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
       return FAILED;
     }
     auto start = std::chrono::system_clock::now();
-    for (size_t algorithm_strategy = 0, sol = 0; algorithm_strategy < numAlgorithmTypes; algorithm_strategy++) {
-      for (size_t sort_strategy = 0; sort_strategy < numSortingTypes; sort_strategy++) {
-        for (size_t branching_strategy = 0; branching_strategy < numFittingTypes; branching_strategy++) {
-          std::shared_ptr<SomasSolverCore> pSolver =
-            std::make_shared<SomasSolverCore>(vecTensorsMap[sol], pConstraints, sol);
-          pSolver->SetAlgorithmStrategy(AlgorithmType(algorithm_strategy));
-          pSolver->SetSortingStrategy(SortingType(sort_strategy));
-          pSolver->SetFittingStrategy(FittingType(branching_strategy));
-          pSolver->VerifySolution(bVerifySolution);
-          auto task = [pSolver]() {
-            return pSolver->MemoryAllocationSolver() == SUCCESS ? common::SUCCESS : common::FAIL;
-          };
-          tasks.emplace_back(task);
-          solvers.emplace_back(pSolver);
-          sol++;
-        }
-      }
+    for (size_t sol = 0; sol < total_sol; sol++) {
+      std::shared_ptr<SomasSolverCore> pSolver =
+        std::make_shared<SomasSolverCore>(vecTensorsMap[sol], pConstraints, sol, ball);
+      pSolver->SetAlgorithmStrategy(strategies[sol].algorithm_);
+      pSolver->SetSortingStrategy(strategies[sol].sorting_);
+      pSolver->SetFittingStrategy(strategies[sol].fitting_);
+      pSolver->VerifySolution(bVerifySolution);
+      auto task = [pSolver]() {
+        return pSolver->MemoryAllocationSolver() == SUCCESS ? common::SUCCESS : common::FAIL;
+      };
+      tasks.emplace_back(task);
+      solvers.emplace_back(pSolver);
     }
     (void)common::ThreadPool::GetInstance().SyncRun(tasks, core_list);
     common::ThreadPool::GetInstance().ClearThreadPool();
@@ -173,6 +187,9 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
     }
     MS_EXCEPTION_IF_NULL(best_solver);
     max_offset_ = best_solver->GetUpperbound();
+    best_sorting_ = best_solver->sort_strategy_;
+    best_fitting_ = best_solver->branching_strategy_;
+    best_algorithm_ = best_solver->algorithm_;
     constexpr float kFloatPresent = 100.0;
     MS_LOG(INFO) << "SOMAS SOLVER RESUME:";
     MS_LOG(INFO) << "Best Solution:[" << 1 + best_info.best_sol << "/" << total_sol << "] ";
@@ -196,8 +213,7 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
 }
 
 void SomasSolverPre::Log(const session::KernelGraph &graph, const TensorsDescMap &tensors,
-                         const std::vector<VectorBitSet> *pConstraints,
-                         const vector<vector<size_t>> &continuous_v) const {
+                         const ReuseConstraints *pConstraints, const vector<vector<size_t>> &continuous_v) const {
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
   if (context_ptr->CanDump(kIntroductory)) {
@@ -207,7 +223,7 @@ void SomasSolverPre::Log(const session::KernelGraph &graph, const TensorsDescMap
   }
 }
 
-void SomasSolverPre::TensorRelationLog(const std::vector<VectorBitSet> *pConstraints,
+void SomasSolverPre::TensorRelationLog(const ReuseConstraints *pConstraints,
                                        const session::KernelGraph &graph) const {
   MS_LOG(INFO) << "SomasSolver::Log Writing somas_tensor_relation.ir..";
   auto context_ptr = MsContext::GetInstance();
@@ -216,10 +232,17 @@ void SomasSolverPre::TensorRelationLog(const std::vector<VectorBitSet> *pConstra
   std::string filename =
     GetSaveGraphsPathName("somas_tensor_relation_" + std::to_string(graph.graph_id()) + ".ir", save_graphs_path);
   std::ostringstream oss;
+  MS_EXCEPTION_IF_NULL(pConstraints);
   for (size_t tid1 = 0; tid1 < pConstraints->size(); tid1++) {
     oss << 't' << tid1 << ' ';
-    for (size_t tid2 = 0; tid2 < (*pConstraints)[tid1].bit_size_; tid2++) {
-      oss << 'H' << std::hex << (*pConstraints)[tid1].bit_[tid2];
+    if (pConstraints->is_interval()) {
+      const auto &lifetime = pConstraints->GetLifetime(tid1);
+      oss << 'L' << lifetime.start_ << ' ' << lifetime.end_ << ' ' << lifetime.reusable_;
+    } else {
+      const auto &row = pConstraints->GetRow(tid1);
+      for (size_t tid2 = 0; tid2 < row.bit_size_; tid2++) {
+        oss << 'H' << std::hex << row.bit_[tid2];
+      }
     }
     oss << std::endl << std::dec;
   }
@@ -168,6 +168,76 @@ class VectorBitSet {
   size_t bit_size_;
 };
 
+// The lifetime of tensor in the execution order, the tensor can't reuse any other tensor if it is not reusable.
+struct TensorLifetime {
+  size_t start_{0};
+  size_t end_{0};
+  bool reusable_{false};
+};
+
+// The reuse constraints of tensors, two tensors can share the same memory only if they can reuse each other. They are
+// kept in the bitset matrix in general. If all the nodes run one by one in the execution order, two tensors can reuse
+// each other if and only if their lifetimes don't overlap, and only the lifetime intervals are kept, which takes the
+// linear memory instead of the quadratic memory of matrix for the large graphs.
+class ReuseConstraints {
+ public:
+  ReuseConstraints() = default;
+  ~ReuseConstraints() = default;
+
+  void InitMatrix(size_t count) {
+    is_interval_ = false;
+    lifetimes_.clear();
+    matrix_.assign(count, VectorBitSet(count));
+  }
+  void InitLifetimes(size_t count) {
+    is_interval_ = true;
+    matrix_.clear();
+    lifetimes_.assign(count, TensorLifetime());
+  }
+  bool is_interval() const { return is_interval_; }
+  size_t size() const { return is_interval_ ? lifetimes_.size() : matrix_.size(); }
+  bool empty() const { return size() == 0; }
+
+  bool CanReuse(size_t index1, size_t index2) const {
+    if (!is_interval_) {
+      return matrix_[index1].IsBitTrue(index2);
+    }
+    const auto &lifetime1 = lifetimes_[index1];
+    const auto &lifetime2 = lifetimes_[index2];
+    return lifetime1.reusable_ && lifetime2.reusable_ &&
+           (lifetime1.start_ > lifetime2.end_ || lifetime2.start_ > lifetime1.end_);
+  }
+
+  // Only for the bitset matrix.
+  void SetReuse(size_t index1, size_t index2) { matrix_[index1].SetBitTrue(index2); }
+  void SetConflict(size_t index1, size_t index2) { matrix_[index1].SetBitFalse(index2); }
+  const VectorBitSet &GetRow(size_t index) const { return matrix_[index]; }
+
+  // Only for the lifetime intervals, setting the lifetime makes the tensor reusable.
+  void SetLifetime(size_t index, size_t start, size_t end) { lifetimes_[index] = {start, end, true}; }
+  const TensorLifetime &GetLifetime(size_t index) const { return lifetimes_[index]; }
+  // The tensor conflicts with all the tensors which conflict with the other one after merged.
+  void MergeLifetime(size_t index, size_t other) {
+    auto &lifetime = lifetimes_[index];
+    const auto &other_lifetime = lifetimes_[other];
+    lifetime.start_ = std::min(lifetime.start_, other_lifetime.start_);
+    lifetime.end_ = std::max(lifetime.end_, other_lifetime.end_);
+    lifetime.reusable_ = lifetime.reusable_ && other_lifetime.reusable_;
+  }
+
+  // The memory size of the constraints in bytes.
+  size_t MemorySize() const {
+    return is_interval_ ? lifetimes_.size() * sizeof(TensorLifetime)
+                        : matrix_.size() * (sizeof(VectorBitSet) + (matrix_.size() + CHAR_BIT - 1) / CHAR_BIT);
+  }
+
+ private:
+  bool is_interval_{false};
+  std::vector<VectorBitSet> matrix_;
+  std::vector<TensorLifetime> lifetimes_;
+};
+using ReuseConstraintsPtr = std::shared_ptr<ReuseConstraints>;
+
 struct SomasSolverTensorDesc {
   size_t index_;
   size_t size_;
@@ -219,17 +289,19 @@ class SomasSolverPre {
   SomasSolverPre &operator=(const SomasSolverPre &) = delete;
 
   size_t GetMaxOffset() const { return max_offset_; }
+  SortingType GetBestSorting() const { return best_sorting_; }
+  FittingType GetBestFitting() const { return best_fitting_; }
+  AlgorithmType GetBestAlgorithm() const { return best_algorithm_; }
 
-  Status Solving(const session::KernelGraph &graph, TensorsDescMap *ptensors,
-                 const std::vector<VectorBitSet> *pConstraints, const vector<vector<size_t>> &continuous_v,
-                 const std::vector<int> &core_list,
+  Status Solving(const session::KernelGraph &graph, TensorsDescMap *ptensors, const ReuseConstraints *pConstraints,
+                 const vector<vector<size_t>> &continuous_v, const std::vector<int> &core_list,
                  bool bVerifySolution,  // true -> Check continuous and non overlapping constraints solution
                  bool ball = true,      // true -> run full set of heuristics, false -> run single heuristic specified
                  SortingType sorting = kGreaterSizeSmallerIndex, FittingType fitting = kBest,
                  AlgorithmType algorithm = kManyObjects);
 
-  void Log(const session::KernelGraph &graph, const TensorsDescMap &tensors,
-           const std::vector<VectorBitSet> *pConstraints, const vector<vector<size_t>> &continuous_v) const;
+  void Log(const session::KernelGraph &graph, const TensorsDescMap &tensors, const ReuseConstraints *pConstraints,
+           const vector<vector<size_t>> &continuous_v) const;
 
   Status CheckTensors(const TensorsDescMap *pTensors, uint32_t index1, uint32_t index2) const;
   Status AddContiguousInfoInMap(const vector<vector<size_t>> &continuous_v, TensorsDescMap *pTensors) const;
@@ -238,11 +310,14 @@ class SomasSolverPre {
 
  private:
   size_t max_offset_;
+  SortingType best_sorting_{kGreaterSizeSmallerIndex};
+  FittingType best_fitting_{kBest};
+  AlgorithmType best_algorithm_{kManyObjects};
   void SolverInputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors,
                       const vector<vector<size_t>> &continuous_v) const;
   void SolverOutputLog(const session::KernelGraph &graph, const TensorsDescMap &tensors) const;
   vector<TensorsDescMap> CreateTensorsMaps(const TensorsDescMap &tensors, size_t total_sol) const;
-  void TensorRelationLog(const std::vector<VectorBitSet> *pConstraints, const session::KernelGraph &graph) const;
+  void TensorRelationLog(const ReuseConstraints *pConstraints, const session::KernelGraph &graph) const;
 };
 using SomasSolverPrePtr = std::shared_ptr<SomasSolverPre>;
 }  // namespace somas
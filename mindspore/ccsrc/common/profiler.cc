@@ -84,6 +84,8 @@ static const std::map<ProfilerEvent, std::string> kProfilerEventString = {
   {ProfilerEvent::kWaitKernelsInferFinish, "WaitKernelsInferFinish"},
   {ProfilerEvent::kWaitKernelsResizeFinish, "WaitKernelsResizeFinish"},
   {ProfilerEvent::kWaitKernelsLaunchFinish, "WaitKernelsLaunchFinish"},
+  {ProfilerEvent::kGradientBucketFill, "GradientBucketFill"},
+  {ProfilerEvent::kGradientBucketLaunch, "GradientBucketLaunch"},
   // Inner event.
   {ProfilerEvent::kKernelInferInner, "KernelInferInner"},
   {ProfilerEvent::kKernelInferDataSync, "KernelInferDataSync"},
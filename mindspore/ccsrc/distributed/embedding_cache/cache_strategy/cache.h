@@ -17,12 +17,33 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CHCHE_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CHCHE_H_
 
+#include <cstddef>
+#include <string>
 #include <utility>
 #include <vector>
-#include <list>
 
 namespace mindspore {
 namespace distributed {
+// The access counters of a cache, used to evaluate how well a cache strategy fits the access pattern.
+struct CacheStatistics {
+  // The number of Get calls which find the key in cache.
+  size_t hit_count{0};
+  // The number of Get calls which do not find the key in cache.
+  size_t miss_count{0};
+  // The number of elements evicted (swapped out) from cache.
+  size_t evict_count{0};
+
+  double hit_rate() const {
+    size_t total = hit_count + miss_count;
+    return total == 0 ? 0.0 : static_cast<double>(hit_count) / total;
+  }
+
+  std::string ToString() const {
+    return "hit: " + std::to_string(hit_count) + ", miss: " + std::to_string(miss_count) +
+           ", swap out: " + std::to_string(evict_count) + ", hit rate: " + std::to_string(hit_rate());
+  }
+};
+
 // An abstract class of general cache strategy that provides basic APIs for cache management, such as element access and
 // modification APIs: Get, Put, and query whether the cache hits API: Exists, etc.
 template <typename KeyType, typename ValueType>
@@ -45,10 +66,10 @@ class Cache {
   // on different cache strategies.
   virtual bool Get(const KeyType &key, ValueType *value) = 0;
 
-  // Get the most recently used element.
+  // Get the hottest element, e.g. the most recently used element for LRU strategy.
   virtual const Element &Front() const = 0;
 
-  // Get the least recently used element.
+  // Get the element which will be evicted first, e.g. the least recently used element for LRU strategy.
   virtual const Element &Back() const = 0;
 
   // Query whether the element corresponding to a particular key exists in the cache.
@@ -68,15 +89,23 @@ class Cache {
   // Get the current number of elements in the cache.
   virtual size_t size() const = 0;
 
-  // Dump all elements in the cache.
-  virtual const std::list<Element> &Export() const = 0;
+  // Dump all elements in the cache, ordered from the hottest to the coldest.
+  virtual std::vector<Element> Export() const = 0;
 
   // Get the maximum number of elements that the cache can hold.
   size_t capacity() const { return capacity_; }
 
+  // Get the hit/miss/evict counters since the cache was created or the counters were reset.
+  const CacheStatistics &statistics() const { return statistics_; }
+
+  void ResetStatistics() { statistics_ = CacheStatistics(); }
+
  protected:
   // The maximum number of elements that the cache can hold.
   size_t capacity_;
+
+  // The access counters, which are updated by the Get and TryEvict of each cache strategy.
+  CacheStatistics statistics_;
 };
 }  // namespace distributed
 }  // namespace mindspore
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CACHE_FACTORY_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CACHE_FACTORY_H_
+
+#include <memory>
+#include <string>
+#include <sstream>
+
+#include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "distributed/embedding_cache/cache_strategy/lru_cache.h"
+#include "distributed/embedding_cache/cache_strategy/lfu_cache.h"
+#include "distributed/embedding_cache/cache_strategy/tiny_lfu_cache.h"
+#include "utils/ms_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+// The environment variable used to choose the cache strategy of embedding tables. The value is a comma separated list,
+// an item 'policy' sets the strategy of all tables and an item 'embedding_key:policy' sets the strategy of one table,
+// e.g. "lru,3:tinylfu" uses W-TinyLFU for the table whose embedding key is 3 and LRU for the others.
+// The supported policies are "lru", "lfu" and "tinylfu", and LRU is used by default.
+constexpr auto kEnvEmbeddingCachePolicy = "MS_EMBEDDING_CACHE_POLICY";
+
+enum class CachePolicy { kLRU = 0, kLFU, kTinyLFU };
+
+inline std::string CachePolicyName(CachePolicy policy) {
+  switch (policy) {
+    case CachePolicy::kLFU:
+      return "lfu";
+    case CachePolicy::kTinyLFU:
+      return "tinylfu";
+    default:
+      return "lru";
+  }
+}
+
+inline CachePolicy ParseCachePolicy(const std::string &name) {
+  if (name == "lru") {
+    return CachePolicy::kLRU;
+  }
+  if (name == "lfu") {
+    return CachePolicy::kLFU;
+  }
+  if (name == "tinylfu") {
+    return CachePolicy::kTinyLFU;
+  }
+  MS_LOG(EXCEPTION) << "The cache policy in " << kEnvEmbeddingCachePolicy
+                    << " should be one of 'lru', 'lfu' and 'tinylfu', but got: " << name;
+}
+
+// Get the cache strategy of the embedding table from the policy config in the format of kEnvEmbeddingCachePolicy.
+// A negative embedding key means the default strategy, which is used by the caches shared by all tables.
+inline CachePolicy GetCachePolicy(const std::string &config, int32_t embedding_key) {
+  CachePolicy policy = CachePolicy::kLRU;
+  std::stringstream config_stream(config);
+  std::string item;
+  while (std::getline(config_stream, item, ',')) {
+    if (item.empty()) {
+      continue;
+    }
+    auto pos = item.find(':');
+    if (pos == std::string::npos) {
+      policy = ParseCachePolicy(item);
+      continue;
+    }
+    int32_t key = 0;
+    try {
+      key = std::stoi(item.substr(0, pos));
+    } catch (const std::exception &) {
+      MS_LOG(EXCEPTION) << "The embedding key in " << kEnvEmbeddingCachePolicy << " should be an integer, but got: "
+                        << item;
+    }
+    if (embedding_key >= 0 && key == embedding_key) {
+      // The policy of the table takes precedence over the default one, no matter the order of items.
+      return ParseCachePolicy(item.substr(pos + 1));
+    }
+  }
+  return policy;
+}
+
+inline CachePolicy GetCachePolicy(int32_t embedding_key) {
+  return GetCachePolicy(common::GetEnv(kEnvEmbeddingCachePolicy), embedding_key);
+}
+
+template <typename KeyType, typename ValueType>
+std::unique_ptr<Cache<KeyType, ValueType>> CreateCache(CachePolicy policy, size_t capacity) {
+  switch (policy) {
+    case CachePolicy::kLFU:
+      return std::make_unique<LFUCache<KeyType, ValueType>>(capacity);
+    case CachePolicy::kTinyLFU:
+      return std::make_unique<TinyLFUCache<KeyType, ValueType>>(capacity);
+    default:
+      return std::make_unique<LRUCache<KeyType, ValueType>>(capacity);
+  }
+}
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_CACHE_FACTORY_H_
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_INDEX_LIST_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_INDEX_LIST_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace mindspore {
+namespace distributed {
+// The index which does not point to any slot.
+constexpr uint32_t kInvalidSlot = UINT32_MAX;
+
+// The links of a slot in the IndexList.
+struct IndexListNode {
+  uint32_t prev{kInvalidSlot};
+  uint32_t next{kInvalidSlot};
+};
+
+// A doubly linked list threaded through the slots of an array by indices instead of pointers. The slots are allocated
+// once with the capacity of cache, so moving an element in the list only rewrites a few indices and no node is
+// allocated or freed. Several lists can share the same slot array, as long as a slot is in at most one of them.
+// The slot type is required to have the 'prev' and 'next' members of IndexListNode.
+class IndexList {
+ public:
+  template <typename Slot>
+  void PushFront(std::vector<Slot> *slots, uint32_t index) {
+    auto &slot = (*slots)[index];
+    slot.prev = kInvalidSlot;
+    slot.next = head_;
+    if (head_ != kInvalidSlot) {
+      (*slots)[head_].prev = index;
+    } else {
+      tail_ = index;
+    }
+    head_ = index;
+    ++size_;
+  }
+
+  template <typename Slot>
+  void Remove(std::vector<Slot> *slots, uint32_t index) {
+    auto &slot = (*slots)[index];
+    if (slot.prev != kInvalidSlot) {
+      (*slots)[slot.prev].next = slot.next;
+    } else {
+      head_ = slot.next;
+    }
+    if (slot.next != kInvalidSlot) {
+      (*slots)[slot.next].prev = slot.prev;
+    } else {
+      tail_ = slot.prev;
+    }
+    slot.prev = kInvalidSlot;
+    slot.next = kInvalidSlot;
+    --size_;
+  }
+
+  template <typename Slot>
+  void MoveToFront(std::vector<Slot> *slots, uint32_t index) {
+    if (head_ == index) {
+      return;
+    }
+    Remove(slots, index);
+    PushFront(slots, index);
+  }
+
+  uint32_t front() const { return head_; }
+  uint32_t back() const { return tail_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  uint32_t head_{kInvalidSlot};
+  uint32_t tail_{kInvalidSlot};
+  size_t size_{0};
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_INDEX_LIST_H_
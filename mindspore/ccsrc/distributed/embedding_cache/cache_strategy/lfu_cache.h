@@ -0,0 +1,218 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_LFU_CHCHE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_LFU_CHCHE_H_
+
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "distributed/embedding_cache/cache_strategy/index_list.h"
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+// The access frequency of an element in LFUCache saturates at this value.
+constexpr uint32_t kMaxLFUFrequency = 255;
+
+// This class implements the LFU (least frequently used) caching strategy, with the idea that "if data has been accessed
+// frequently, it is more likely to be accessed in the future." It suits the skewed accesses, such as the ids of CTR
+// models, in which a small set of hot ids are accessed again and again among a large number of cold ids.
+// The elements are held in an array of slots, the slots of the same access frequency are linked in the order of access
+// and the element evicted first is the least recently used one among the least frequently used ones. The frequency
+// saturates at kMaxLFUFrequency, so the lists of all frequencies fit in a small array and each access is O(1).
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class LFUCache : public Cache<KeyType, ValueType> {
+ public:
+  // The elements in cache are stored as key-value pairs.
+  using Element = typename Cache<KeyType, ValueType>::Element;
+
+  explicit LFUCache(size_t capacity) : Cache<KeyType, ValueType>(capacity), frequency_lists_(kMaxLFUFrequency + 1) {}
+
+  ~LFUCache() override = default;
+
+  // Insert an element (key-value pair) into the lfu cache.
+  // Updating an existing element counts as an access, and a new element starts with the frequency of one.
+  void Put(const KeyType &key, const ValueType &value) override {
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter != element_keys_to_slots_.end()) {
+      Touch(iter->second);
+      slots_[iter->second].element.second = value;
+      return;
+    }
+
+    if (IsFull()) {
+      MS_LOG(EXCEPTION) << "There is no space in lfu cache.";
+    }
+
+    uint32_t index = AllocSlot();
+    auto &slot = slots_[index];
+    slot.element = Element(key, value);
+    slot.frequency = 1;
+    frequency_lists_[slot.frequency].PushFront(&slots_, index);
+    (void)element_keys_to_slots_.emplace(key, index);
+    min_frequency_ = 1;
+    max_frequency_ = std::max(max_frequency_, slot.frequency);
+  }
+
+  // Query the corresponding Value from the cache according to the Key. If the element exists, the corresponding Value
+  // is assigned to parameter value and return true. If the element does not exist, return false.
+  // The access frequency of the element is increased by one.
+  bool Get(const KeyType &key, ValueType *value) override {
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter != element_keys_to_slots_.end()) {
+      Touch(iter->second);
+      MS_EXCEPTION_IF_NULL(value);
+      *value = slots_[iter->second].element.second;
+      ++this->statistics_.hit_count;
+      return true;
+    }
+    ++this->statistics_.miss_count;
+    return false;
+  }
+
+  // Get the most recently used element among the most frequently used ones.
+  const Element &Front() const override {
+    if (size() == 0) {
+      MS_LOG(EXCEPTION) << "There is no element in lfu cache.";
+    }
+    return slots_[frequency_lists_[max_frequency_].front()].element;
+  }
+
+  // Get the least recently used element among the least frequently used ones.
+  const Element &Back() const override {
+    if (size() == 0) {
+      MS_LOG(EXCEPTION) << "There is no element in lfu cache.";
+    }
+    return slots_[frequency_lists_[min_frequency_].back()].element;
+  }
+
+  // Query whether the element corresponding to a particular key exists in the cache.
+  bool Exists(const KeyType &key) const override {
+    return element_keys_to_slots_.find(key) != element_keys_to_slots_.end();
+  }
+
+  // Evict the least frequently used elements until there are 'reserve_size' free slots, the evicted elements are
+  // appended to 'evicted_elements'.
+  void TryEvict(size_t reserve_size, std::vector<Element> *evicted_elements) override {
+    MS_EXCEPTION_IF_NULL(evicted_elements);
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    if (reserve_size > capacity) {
+      MS_LOG(EXCEPTION) << "The evict number must be less or equal to lfu cache capacity: " << capacity
+                        << ", but got: " << reserve_size;
+    }
+
+    while (size() > capacity - reserve_size) {
+      auto &min_list = frequency_lists_[min_frequency_];
+      uint32_t index = min_list.back();
+      const auto &back_element = slots_[index].element;
+      evicted_elements->emplace_back(back_element.first, back_element.second);
+      (void)element_keys_to_slots_.erase(back_element.first);
+      min_list.Remove(&slots_, index);
+      free_slots_.push_back(index);
+      UpdateFrequencyRange();
+      ++this->statistics_.evict_count;
+    }
+  }
+
+  // Check whether the number of elements in cache reaches capacity.
+  bool IsFull() const override { return size() >= Cache<KeyType, ValueType>::capacity(); }
+
+  // Get the current number of elements in the cache.
+  size_t size() const override { return element_keys_to_slots_.size(); }
+
+  // Dump all elements in the lfu cache, from the most frequently used one to the least frequently used one.
+  std::vector<Element> Export() const override {
+    std::vector<Element> elements;
+    elements.reserve(size());
+    for (uint32_t frequency = max_frequency_; frequency >= min_frequency_ && frequency > 0; --frequency) {
+      for (uint32_t index = frequency_lists_[frequency].front(); index != kInvalidSlot; index = slots_[index].next) {
+        elements.push_back(slots_[index].element);
+      }
+    }
+    return elements;
+  }
+
+ private:
+  struct Slot : public IndexListNode {
+    Element element;
+    uint32_t frequency{0};
+  };
+
+  // Move the element to the list of the next frequency.
+  void Touch(uint32_t index) {
+    auto &slot = slots_[index];
+    if (slot.frequency == kMaxLFUFrequency) {
+      frequency_lists_[slot.frequency].MoveToFront(&slots_, index);
+      return;
+    }
+    frequency_lists_[slot.frequency].Remove(&slots_, index);
+    ++slot.frequency;
+    frequency_lists_[slot.frequency].PushFront(&slots_, index);
+    max_frequency_ = std::max(max_frequency_, slot.frequency);
+    if (frequency_lists_[min_frequency_].empty()) {
+      ++min_frequency_;
+    }
+  }
+
+  // Shrink the range of frequencies owned by some elements after an eviction.
+  void UpdateFrequencyRange() {
+    if (size() == 0) {
+      min_frequency_ = max_frequency_ = 0;
+      return;
+    }
+    while (frequency_lists_[min_frequency_].empty()) {
+      ++min_frequency_;
+    }
+    while (frequency_lists_[max_frequency_].empty()) {
+      --max_frequency_;
+    }
+  }
+
+  uint32_t AllocSlot() {
+    if (!free_slots_.empty()) {
+      uint32_t index = free_slots_.back();
+      free_slots_.pop_back();
+      return index;
+    }
+    slots_.emplace_back();
+    return static_cast<uint32_t>(slots_.size() - 1);
+  }
+
+  // The slots used to hold elements, which never shrink.
+  std::vector<Slot> slots_;
+
+  // The indices of slots whose elements have been evicted.
+  std::vector<uint32_t> free_slots_;
+
+  // The elements of each frequency in the order of access, indexed by frequency.
+  std::vector<IndexList> frequency_lists_;
+
+  // The minimum and maximum frequencies owned by some elements, both are zero if the cache is empty.
+  uint32_t min_frequency_{0};
+  uint32_t max_frequency_{0};
+
+  // The hash table used to quickly find the slot of an element.
+  mindspore::HashMap<KeyType, uint32_t, Hash, KeyEqual> element_keys_to_slots_;
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_LFU_CHCHE_H_
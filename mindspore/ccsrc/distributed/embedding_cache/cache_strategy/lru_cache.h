@@ -17,12 +17,12 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_LRU_CHCHE_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_LRU_CHCHE_H_
 
-#include <list>
 #include <vector>
 #include <utility>
 #include <functional>
 
 #include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "distributed/embedding_cache/cache_strategy/index_list.h"
 #include "utils/hash_map.h"
 #include "utils/log_adapter.h"
 
@@ -30,34 +30,30 @@ namespace mindspore {
 namespace distributed {
 // This class implements a common LRU (least recently used) caching strategy, with the idea that "if data has been
 // accessed recently, it is more likely to be accessed in the future."
-// The LRUCache implementation uses a linked list to hold elements and a hash table to quickly find the location of an
-// element in linked list.
+// The LRUCache implementation holds elements in an array of slots linked by indices in the order of access, and uses a
+// hash table to quickly find the slot of an element. A hit only relinks a few indices, and the slots of evicted
+// elements are reused by the newly inserted ones, so no memory is allocated once the cache is warmed up.
 template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
           typename KeyEqual = std::equal_to<KeyType>>
 class LRUCache : public Cache<KeyType, ValueType> {
  public:
   // The elements in cache are stored as key-value pairs.
   using Element = typename Cache<KeyType, ValueType>::Element;
-  // The Iter type is the iterator type of the linked list.
-  using Iter = typename std::list<Element>::iterator;
 
   explicit LRUCache(size_t capacity) : Cache<KeyType, ValueType>(capacity) {}
 
-  ~LRUCache() override {
-    elements_.clear();
-    element_keys_to_iters_.clear();
-  }
+  ~LRUCache() override = default;
 
   // Insert an element (key-value pair) into the lru cache.
   // The newly inserted element is considered hot data and will be placed at the head of the linked list, because this
   // element may have been replaced from a higher level cache.
   void Put(const KeyType &key, const ValueType &value) override {
-    const auto &iter = element_keys_to_iters_.find(key);
+    const auto &iter = element_keys_to_slots_.find(key);
     // The key exist in lru cache, move this element to the head of list.
-    if (iter != element_keys_to_iters_.end()) {
-      elements_.splice(elements_.begin(), elements_, iter->second);
+    if (iter != element_keys_to_slots_.end()) {
+      elements_.MoveToFront(&slots_, iter->second);
       // Update value.
-      elements_.begin()->second = value;
+      slots_[iter->second].element.second = value;
       return;
     }
 
@@ -66,22 +62,25 @@ class LRUCache : public Cache<KeyType, ValueType> {
     }
 
     // The key does not exist in lru cache, insert this new element at the head of list.
-    elements_.emplace_front(key, value);
-    (void)element_keys_to_iters_.emplace(key, elements_.begin());
+    uint32_t index = AllocSlot();
+    slots_[index].element = Element(key, value);
+    elements_.PushFront(&slots_, index);
+    (void)element_keys_to_slots_.emplace(key, index);
   }
 
   // Query the corresponding Value from the cache according to the Key. If the element exists, the corresponding Value
   // is assigned to parameter value and return true. If the element does not exist, return false.
   // The newly accessed element is moved to the head of the list, indicating that it was recently accessed.
   bool Get(const KeyType &key, ValueType *value) override {
-    const auto &iter = element_keys_to_iters_.find(key);
-    if (iter != element_keys_to_iters_.end()) {
-      // For performance, no element was constructed or destroyed.
-      elements_.splice(elements_.begin(), elements_, iter->second);
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter != element_keys_to_slots_.end()) {
+      elements_.MoveToFront(&slots_, iter->second);
       MS_EXCEPTION_IF_NULL(value);
-      *value = iter->second->second;
+      *value = slots_[iter->second].element.second;
+      ++this->statistics_.hit_count;
       return true;
     }
+    ++this->statistics_.miss_count;
     return false;
   }
 
@@ -90,7 +89,7 @@ class LRUCache : public Cache<KeyType, ValueType> {
     if (elements_.empty()) {
       MS_LOG(EXCEPTION) << "There is no element in lru cache.";
     }
-    return elements_.front();
+    return slots_[elements_.front()].element;
   }
 
   // Get the least recently used element.
@@ -98,12 +97,12 @@ class LRUCache : public Cache<KeyType, ValueType> {
     if (elements_.empty()) {
       MS_LOG(EXCEPTION) << "There is no element in lru cache.";
     }
-    return elements_.back();
+    return slots_[elements_.back()].element;
   }
 
   // Query whether the element corresponding to a particular key exists in the cache.
   bool Exists(const KeyType &key) const override {
-    return element_keys_to_iters_.find(key) != element_keys_to_iters_.end();
+    return element_keys_to_slots_.find(key) != element_keys_to_slots_.end();
   }
 
   // When the size of the cache is close to capacity, you can use this interface to evict some non-hot data to reserve
@@ -121,10 +120,13 @@ class LRUCache : public Cache<KeyType, ValueType> {
     }
 
     while (size() > capacity - reserve_size) {
-      const auto &back_element = elements_.back();
+      uint32_t index = elements_.back();
+      const auto &back_element = slots_[index].element;
       evicted_elements->emplace_back(back_element.first, back_element.second);
-      (void)element_keys_to_iters_.erase(back_element.first);
-      elements_.pop_back();
+      (void)element_keys_to_slots_.erase(back_element.first);
+      elements_.Remove(&slots_, index);
+      free_slots_.push_back(index);
+      ++this->statistics_.evict_count;
     }
   }
 
@@ -132,17 +134,44 @@ class LRUCache : public Cache<KeyType, ValueType> {
   bool IsFull() const override { return size() >= Cache<KeyType, ValueType>::capacity(); }
 
   // Get the current number of elements in the cache.
-  size_t size() const override { return element_keys_to_iters_.size(); }
-
-  // Dump all elements in the lru cache.
-  const std::list<Element> &Export() const override { return elements_; }
+  size_t size() const override { return element_keys_to_slots_.size(); }
+
+  // Dump all elements in the lru cache, from the most recently used one to the least recently used one.
+  std::vector<Element> Export() const override {
+    std::vector<Element> elements;
+    elements.reserve(elements_.size());
+    for (uint32_t index = elements_.front(); index != kInvalidSlot; index = slots_[index].next) {
+      elements.push_back(slots_[index].element);
+    }
+    return elements;
+  }
 
  private:
-  // The linked list used to hold elements.
-  std::list<Element> elements_;
+  struct Slot : public IndexListNode {
+    Element element;
+  };
+
+  uint32_t AllocSlot() {
+    if (!free_slots_.empty()) {
+      uint32_t index = free_slots_.back();
+      free_slots_.pop_back();
+      return index;
+    }
+    slots_.emplace_back();
+    return static_cast<uint32_t>(slots_.size() - 1);
+  }
+
+  // The slots used to hold elements, which never shrink.
+  std::vector<Slot> slots_;
+
+  // The indices of slots whose elements have been evicted.
+  std::vector<uint32_t> free_slots_;
+
+  // The elements in the order of access, the head is the most recently used one.
+  IndexList elements_;
 
-  // The hash table used to quickly find the location of an element in linked list.
-  mindspore::HashMap<KeyType, Iter, Hash, KeyEqual> element_keys_to_iters_;
+  // The hash table used to quickly find the slot of an element.
+  mindspore::HashMap<KeyType, uint32_t, Hash, KeyEqual> element_keys_to_slots_;
 };
 }  // namespace distributed
 }  // namespace mindspore
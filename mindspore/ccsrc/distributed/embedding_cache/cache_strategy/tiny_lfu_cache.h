@@ -0,0 +1,331 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_TINY_LFU_CHCHE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_TINY_LFU_CHCHE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "distributed/embedding_cache/cache_strategy/index_list.h"
+#include "utils/hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+// A count-min sketch which estimates the access frequency of keys in a small fixed memory, including the keys which
+// have been evicted from cache. All counters are halved once the number of samples reaches ten times of the width, so
+// the ids which were hot long ago are forgotten gradually.
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(size_t capacity) {
+    width_ = kMinWidth;
+    while (width_ < capacity) {
+      width_ <<= 1;
+    }
+    counters_.resize(kDepth * width_, 0);
+    sample_size_ = kSampleFactor * width_;
+  }
+
+  ~FrequencySketch() = default;
+
+  // Record an access of the key with the given hash.
+  void Increment(size_t hash) {
+    bool added = false;
+    for (size_t i = 0; i < kDepth; ++i) {
+      auto &counter = counters_[IndexOf(hash, i)];
+      if (counter < kMaxCounter) {
+        ++counter;
+        added = true;
+      }
+    }
+    if (added && ++samples_ >= sample_size_) {
+      Reset();
+    }
+  }
+
+  // Estimate the access frequency of the key with the given hash.
+  uint32_t Frequency(size_t hash) const {
+    uint32_t frequency = kMaxCounter;
+    for (size_t i = 0; i < kDepth; ++i) {
+      frequency = std::min<uint32_t>(frequency, counters_[IndexOf(hash, i)]);
+    }
+    return frequency;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kMinWidth = 64;
+  static constexpr size_t kSampleFactor = 10;
+  static constexpr uint8_t kMaxCounter = 15;
+
+  size_t IndexOf(size_t hash, size_t row) const {
+    // The fmix64 finalizer of MurmurHash3, seeded differently for each row.
+    uint64_t h = static_cast<uint64_t>(hash) + (row + 1) * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return row * width_ + (static_cast<size_t>(h) & (width_ - 1));
+  }
+
+  void Reset() {
+    for (auto &counter : counters_) {
+      counter >>= 1;
+    }
+    samples_ >>= 1;
+  }
+
+  // The counters of all rows, each row has width_ counters.
+  std::vector<uint8_t> counters_;
+  size_t width_{0};
+  size_t samples_{0};
+  size_t sample_size_{0};
+};
+
+// This class implements the W-TinyLFU caching strategy. A new element enters a small LRU window first, which absorbs
+// the bursts of new ids. When the window is over its size and the main area is full, the oldest element of the window
+// competes with the coldest element of the main area, and the one with the lower frequency estimated by the sketch is
+// evicted. The main area is a segmented LRU: the elements hit again are promoted from the probation segment to the
+// protected segment, so that the ids accessed only once can not flush the frequently used ones out of cache.
+// All segments are linked through the same array of slots by indices.
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class TinyLFUCache : public Cache<KeyType, ValueType> {
+ public:
+  // The elements in cache are stored as key-value pairs.
+  using Element = typename Cache<KeyType, ValueType>::Element;
+
+  explicit TinyLFUCache(size_t capacity) : Cache<KeyType, ValueType>(capacity), sketch_(capacity) {
+    window_capacity_ = std::max<size_t>(1, capacity / kWindowRatio);
+    main_capacity_ = capacity > window_capacity_ ? capacity - window_capacity_ : 0;
+    protected_capacity_ = main_capacity_ * kProtectedPercent / kPercent;
+  }
+
+  ~TinyLFUCache() override = default;
+
+  // Insert an element (key-value pair) into the cache. A new element is placed at the head of the window, and updating
+  // an existing element is handled as a hit, but it is not counted by the frequency sketch again.
+  void Put(const KeyType &key, const ValueType &value) override {
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter != element_keys_to_slots_.end()) {
+      OnHit(iter->second);
+      slots_[iter->second].element.second = value;
+      return;
+    }
+
+    if (IsFull()) {
+      MS_LOG(EXCEPTION) << "There is no space in tiny lfu cache.";
+    }
+
+    uint32_t index = AllocSlot();
+    auto &slot = slots_[index];
+    slot.element = Element(key, value);
+    slot.segment = kWindow;
+    window_.PushFront(&slots_, index);
+    (void)element_keys_to_slots_.emplace(key, index);
+    // The main area is not full yet, so the oldest element of the window is admitted without competition.
+    if (window_.size() > window_capacity_ && probation_.size() + protected_.size() < main_capacity_) {
+      MoveToProbation(window_.back());
+    }
+  }
+
+  // Query the corresponding Value from the cache according to the Key. If the element exists, the corresponding Value
+  // is assigned to parameter value and return true. If the element does not exist, return false.
+  // Both hits and misses are recorded by the frequency sketch.
+  bool Get(const KeyType &key, ValueType *value) override {
+    sketch_.Increment(hasher_(key));
+    const auto &iter = element_keys_to_slots_.find(key);
+    if (iter != element_keys_to_slots_.end()) {
+      OnHit(iter->second);
+      MS_EXCEPTION_IF_NULL(value);
+      *value = slots_[iter->second].element.second;
+      ++this->statistics_.hit_count;
+      return true;
+    }
+    ++this->statistics_.miss_count;
+    return false;
+  }
+
+  // Get the most recently used element of the hottest segment.
+  const Element &Front() const override {
+    if (size() == 0) {
+      MS_LOG(EXCEPTION) << "There is no element in tiny lfu cache.";
+    }
+    if (!protected_.empty()) {
+      return slots_[protected_.front()].element;
+    }
+    return slots_[window_.empty() ? probation_.front() : window_.front()].element;
+  }
+
+  // Get the element which will be evicted by the next TryEvict.
+  const Element &Back() const override {
+    if (size() == 0) {
+      MS_LOG(EXCEPTION) << "There is no element in tiny lfu cache.";
+    }
+    bool admit_candidate = false;
+    return slots_[SelectVictim(&admit_candidate)].element;
+  }
+
+  // Query whether the element corresponding to a particular key exists in the cache.
+  bool Exists(const KeyType &key) const override {
+    return element_keys_to_slots_.find(key) != element_keys_to_slots_.end();
+  }
+
+  // Evict the elements until there are 'reserve_size' free slots, the evicted elements are appended to
+  // 'evicted_elements'. Each eviction lets the oldest element of window compete with the coldest one of main area.
+  void TryEvict(size_t reserve_size, std::vector<Element> *evicted_elements) override {
+    MS_EXCEPTION_IF_NULL(evicted_elements);
+    const auto &capacity = Cache<KeyType, ValueType>::capacity();
+    if (reserve_size > capacity) {
+      MS_LOG(EXCEPTION) << "The evict number must be less or equal to tiny lfu cache capacity: " << capacity
+                        << ", but got: " << reserve_size;
+    }
+
+    while (size() > capacity - reserve_size) {
+      bool admit_candidate = false;
+      uint32_t index = SelectVictim(&admit_candidate);
+      const auto &victim = slots_[index].element;
+      evicted_elements->emplace_back(victim.first, victim.second);
+      (void)element_keys_to_slots_.erase(victim.first);
+      ListOf(slots_[index].segment).Remove(&slots_, index);
+      free_slots_.push_back(index);
+      ++this->statistics_.evict_count;
+      if (admit_candidate) {
+        MoveToProbation(window_.back());
+      }
+    }
+  }
+
+  // Check whether the number of elements in cache reaches capacity.
+  bool IsFull() const override { return size() >= Cache<KeyType, ValueType>::capacity(); }
+
+  // Get the current number of elements in the cache.
+  size_t size() const override { return element_keys_to_slots_.size(); }
+
+  // Dump all elements in the cache, in the order of the protected segment, the window and the probation segment.
+  std::vector<Element> Export() const override {
+    std::vector<Element> elements;
+    elements.reserve(size());
+    for (const auto *list : {&protected_, &window_, &probation_}) {
+      for (uint32_t index = list->front(); index != kInvalidSlot; index = slots_[index].next) {
+        elements.push_back(slots_[index].element);
+      }
+    }
+    return elements;
+  }
+
+ private:
+  // The window takes 1% of capacity and the protected segment takes 80% of the main area.
+  static constexpr size_t kWindowRatio = 100;
+  static constexpr size_t kProtectedPercent = 80;
+  static constexpr size_t kPercent = 100;
+
+  enum Segment : uint8_t { kWindow = 0, kProbation, kProtected };
+
+  struct Slot : public IndexListNode {
+    Element element;
+    Segment segment{kWindow};
+  };
+
+  IndexList &ListOf(Segment segment) {
+    return segment == kWindow ? window_ : (segment == kProbation ? probation_ : protected_);
+  }
+
+  void OnHit(uint32_t index) {
+    auto &slot = slots_[index];
+    if (slot.segment != kProbation) {
+      ListOf(slot.segment).MoveToFront(&slots_, index);
+      return;
+    }
+    probation_.Remove(&slots_, index);
+    slot.segment = kProtected;
+    protected_.PushFront(&slots_, index);
+    if (protected_.size() > protected_capacity_) {
+      // Demote the least recently used element of the protected segment, which gets another chance in probation.
+      uint32_t demoted = protected_.back();
+      protected_.Remove(&slots_, demoted);
+      slots_[demoted].segment = kProbation;
+      probation_.PushFront(&slots_, demoted);
+    }
+  }
+
+  void MoveToProbation(uint32_t index) {
+    window_.Remove(&slots_, index);
+    slots_[index].segment = kProbation;
+    probation_.PushFront(&slots_, index);
+  }
+
+  // Select the element to evict. If the window is over its size, its oldest element is the candidate to enter the main
+  // area and the coldest element of main area is the victim, 'admit_candidate' is set if the candidate wins.
+  uint32_t SelectVictim(bool *admit_candidate) const {
+    *admit_candidate = false;
+    uint32_t candidate = window_.size() > window_capacity_ ? window_.back() : kInvalidSlot;
+    uint32_t victim = !probation_.empty() ? probation_.back() : protected_.back();
+    if (victim == kInvalidSlot) {
+      return window_.back();
+    }
+    if (candidate == kInvalidSlot) {
+      return victim;
+    }
+    if (sketch_.Frequency(hasher_(slots_[candidate].element.first)) >
+        sketch_.Frequency(hasher_(slots_[victim].element.first))) {
+      *admit_candidate = true;
+      return victim;
+    }
+    return candidate;
+  }
+
+  uint32_t AllocSlot() {
+    if (!free_slots_.empty()) {
+      uint32_t index = free_slots_.back();
+      free_slots_.pop_back();
+      return index;
+    }
+    slots_.emplace_back();
+    return static_cast<uint32_t>(slots_.size() - 1);
+  }
+
+  // The slots used to hold elements, which never shrink.
+  std::vector<Slot> slots_;
+
+  // The indices of slots whose elements have been evicted.
+  std::vector<uint32_t> free_slots_;
+
+  // The segments of cache, each of them is in the order of access.
+  IndexList window_;
+  IndexList probation_;
+  IndexList protected_;
+
+  size_t window_capacity_{0};
+  size_t main_capacity_{0};
+  size_t protected_capacity_{0};
+
+  // The access frequency of recently accessed keys.
+  FrequencySketch sketch_;
+  Hash hasher_;
+
+  // The hash table used to quickly find the slot of an element.
+  mindspore::HashMap<KeyType, uint32_t, Hash, KeyEqual> element_keys_to_slots_;
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_CACHE_STRATEGY_TINY_LFU_CHCHE_H_
@@ -37,6 +37,27 @@ EmbeddingCacheTableManager &EmbeddingCacheTableManager::GetInstance() {
 void EmbeddingCacheTableManager::Initialize() {
   auto worker_num = ps::PSContext::instance()->worker_num();
   multi_batch_threshold_ = worker_num > 1 ? 1 : kMultiBatchThreshold;
+  std::string lookahead_env = common::GetEnv(kEnvEmbeddingCacheLookahead);
+  if (!lookahead_env.empty()) {
+    int lookahead = 0;
+    try {
+      lookahead = std::stoi(lookahead_env);
+    } catch (const std::exception &) {
+      MS_LOG(EXCEPTION) << "The value of " << kEnvEmbeddingCacheLookahead << " should be an integer, but got "
+                        << lookahead_env;
+    }
+    if (lookahead <= 0) {
+      MS_LOG(EXCEPTION) << "The value of " << kEnvEmbeddingCacheLookahead << " should be positive, but got "
+                        << lookahead;
+    }
+    if (worker_num > 1) {
+      MS_LOG(WARNING) << "The lookahead window of embedding cache prefetching is always 1 with multiple workers, the "
+                      << kEnvEmbeddingCacheLookahead << " is ignored.";
+    } else {
+      multi_batch_threshold_ = IntToSize(lookahead);
+    }
+  }
+  MS_LOG(INFO) << "The lookahead window of embedding cache prefetching: " << multi_batch_threshold_ << " batches.";
   GetEmbeddingTableSliceBound();
 
   device::DeviceContextKey host_key = {"CPU", 0};
@@ -48,6 +69,12 @@ void EmbeddingCacheTableManager::Initialize() {
 void EmbeddingCacheTableManager::Finalize(const device::DeviceContext *device_context) {
   hash_tables_.clear();
 
+  if (device_hash_map_ != nullptr) {
+    MS_LOG(INFO) << "Device hash map cache statistics: " << device_hash_map_->cache_statistics().ToString();
+  }
+  if (host_hash_map_ != nullptr) {
+    MS_LOG(INFO) << "Host hash map cache statistics: " << host_hash_map_->cache_statistics().ToString();
+  }
   device_hash_map_ = nullptr;
   host_hash_map_ = nullptr;
 
@@ -185,9 +212,12 @@ void EmbeddingCacheTableManager::AllocMemForEmbedding(const device::DeviceContex
     max_embedding_size = (embedding_size > max_embedding_size) ? embedding_size : max_embedding_size;
   }
 
-  device_hash_map_ = std::make_shared<EmbeddingHashMap>(device_cache_size_);
+  // The device and host hash maps are shared by all embedding tables, so they use the default cache policy.
+  auto cache_policy = GetCachePolicy(-1);
+  MS_LOG(INFO) << "The cache policy of device and host hash map: " << CachePolicyName(cache_policy);
+  device_hash_map_ = std::make_shared<EmbeddingHashMap>(device_cache_size_, cache_policy);
   MS_EXCEPTION_IF_NULL(device_hash_map_);
-  host_hash_map_ = std::make_shared<EmbeddingHashMap>(host_cache_size_);
+  host_hash_map_ = std::make_shared<EmbeddingHashMap>(host_cache_size_, cache_policy);
   MS_EXCEPTION_IF_NULL(host_hash_map_);
 
   hash_swap_index_addr_ = reinterpret_cast<int *>(
@@ -561,5 +591,82 @@ void EmbeddingStorageManager::Clear() {
 
   embedding_storages_.clear();
 }
+
+OverlappedTaskRunner::~OverlappedTaskRunner() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cond_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+bool OverlappedTaskRunner::Run(const std::function<bool()> &overlapped_task, const std::function<bool()> &main_task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&OverlappedTaskRunner::WorkerLoop, this);
+    }
+    task_ = overlapped_task;
+    task_done_ = false;
+    task_ret_ = true;
+    task_exception_ = nullptr;
+  }
+  task_cond_.notify_one();
+
+  bool main_ret = false;
+  try {
+    main_ret = main_task();
+  } catch (...) {
+    // The overlapped task may still use the data of the caller, so it must finish before the stack unwinds.
+    try {
+      (void)WaitOverlappedTask();
+    } catch (...) {
+      MS_LOG(ERROR) << "The overlapped task also throws an exception, which is dropped.";
+    }
+    throw;
+  }
+  bool overlapped_ret = WaitOverlappedTask();
+  return main_ret && overlapped_ret;
+}
+
+bool OverlappedTaskRunner::WaitOverlappedTask() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cond_.wait(lock, [this]() { return task_done_; });
+  if (task_exception_ != nullptr) {
+    std::rethrow_exception(task_exception_);
+  }
+  return task_ret_;
+}
+
+void OverlappedTaskRunner::WorkerLoop() {
+  while (true) {
+    std::function<bool()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this]() { return stop_ || !task_done_; });
+      if (stop_) {
+        return;
+      }
+      task = std::move(task_);
+    }
+    bool ret = false;
+    std::exception_ptr exception = nullptr;
+    try {
+      ret = task();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ret_ = ret;
+      task_exception_ = exception;
+      task_done_ = true;
+    }
+    done_cond_.notify_all();
+  }
+}
 }  // namespace distributed
 }  // namespace mindspore
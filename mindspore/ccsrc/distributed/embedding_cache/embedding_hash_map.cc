@@ -15,11 +15,11 @@
  */
 
 #include "include/backend/distributed/embedding_cache/embedding_hash_map.h"
-#include "distributed/embedding_cache/cache_strategy/lru_cache.h"
 
 namespace mindspore {
 namespace distributed {
-EmbeddingHashMap::EmbeddingHashMap(size_t hash_capacity) : hash_capacity_(hash_capacity), current_pos_(0) {
+EmbeddingHashMap::EmbeddingHashMap(size_t hash_capacity, CachePolicy cache_policy)
+    : hash_capacity_(hash_capacity), current_pos_(0) {
   hash_map_elements_.resize(hash_capacity);
   // In multi-device mode, embedding table are distributed on different devices by id interval,
   // and ids outside the range of local device will use the front and back positions of the table(for Ascend platform,
@@ -32,7 +32,7 @@ EmbeddingHashMap::EmbeddingHashMap(size_t hash_capacity) : hash_capacity_(hash_c
   if (valid_capacity_ == 0) {
     MS_LOG(ERROR) << "The invalid capacity is zero, please enlarge the capacity.";
   }
-  ids_to_indices_ = std::make_unique<LRUCache<int, int>>(valid_capacity_);
+  ids_to_indices_ = CreateCache<int, int>(cache_policy, valid_capacity_);
 }
 
 size_t EmbeddingHashMap::hash_step(const int hash_index) const { return hash_map_elements_[hash_index].step_; }
@@ -46,7 +46,9 @@ size_t EmbeddingHashMap::hash_capacity() const { return hash_capacity_; }
 
 bool EmbeddingHashMap::GetIndex(const int id, int *index) const { return ids_to_indices_->Get(id, index); }
 
-const std::list<EmbeddingHashMap::Element> &EmbeddingHashMap::Export() const { return ids_to_indices_->Export(); }
+std::vector<EmbeddingHashMap::Element> EmbeddingHashMap::Export() const { return ids_to_indices_->Export(); }
+
+const CacheStatistics &EmbeddingHashMap::cache_statistics() const { return ids_to_indices_->statistics(); }
 
 int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *const swap_out_ids,
                                 const size_t data_step, const size_t graph_running_step, size_t *const swap_out_size,
@@ -136,6 +138,7 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
 
 void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_;
+  MS_LOG(INFO) << "Dump cache statistics: " << ids_to_indices_->statistics().ToString();
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
   MS_LOG(INFO) << "Dump hash_map_unit: ";
   for (size_t i = 0; i < hash_map_elements_.size(); i++) {
@@ -17,7 +17,7 @@
 #include "distributed/embedding_cache/embedding_storage/embedding_storage.h"
 #include <map>
 #include <string>
-#include "distributed/embedding_cache/cache_strategy/lru_cache.h"
+#include "distributed/embedding_cache/cache_strategy/cache_factory.h"
 #include "distributed/persistent/storage/local_file.h"
 #if defined(__linux__) && defined(WITH_BACKEND)
 #include "include/backend/distributed/ps/ps_context.h"
@@ -56,8 +56,10 @@ void EmbeddingStorage<KeyType, ValueType, Allocator>::Initialize(const DeviceAdd
   uint32_t rank_id = 0;
 #endif
 
-  // 2. Create the host memory cache instance.
-  cache_ = std::make_unique<LRUCache<KeyType, int>>(cache_capacity_);
+  // 2. Create the host memory cache instance, the cache policy can be chosen for each embedding table.
+  auto cache_policy = GetCachePolicy(embedding_key_);
+  MS_LOG(INFO) << "The cache policy of embedding table[" << embedding_key_ << "]: " << CachePolicyName(cache_policy);
+  cache_ = CreateCache<KeyType, int>(cache_policy, cache_capacity_);
   MS_EXCEPTION_IF_NULL(cache_);
 
   // 3. Create the persistent storage instance.
@@ -86,6 +88,8 @@ void EmbeddingStorage<KeyType, ValueType, Allocator>::Initialize(const DeviceAdd
 template <typename KeyType, typename ValueType, typename Allocator>
 void EmbeddingStorage<KeyType, ValueType, Allocator>::Finalize() {
   MS_EXCEPTION_IF_NULL(cache_);
+  MS_LOG(INFO) << "The cache statistics of embedding table[" << embedding_key_
+               << "]: " << cache_->statistics().ToString();
   cache_ = nullptr;
   MS_EXCEPTION_IF_NULL(storage_);
   storage_->Finalize();
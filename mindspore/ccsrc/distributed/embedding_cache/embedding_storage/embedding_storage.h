@@ -72,6 +72,15 @@ class EmbeddingStorage : public AbstractEmbeddingStorage {
    */
   bool Get(const ConstDataWithLen &keys, const DataWithLen &values) override { return true; }
 
+  /**
+   * @brief Get the hit/miss/swap counters of the host cache of this embedding table.
+   * @return The counters of the host cache.
+   */
+  const CacheStatistics &cache_statistics() const {
+    MS_EXCEPTION_IF_NULL(cache_);
+    return cache_->statistics();
+  }
+
   /**
    * @brief Batch embeddings update/insert operation.
    * Update/Insert Embeddings in the host cache first, if the host cache has insufficient space, the expired elements
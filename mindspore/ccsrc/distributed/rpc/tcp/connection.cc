@@ -16,11 +16,14 @@
 
 #include "distributed/rpc/tcp/connection.h"
 
+#include <linux/errqueue.h>
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 #include "distributed/rpc/tcp/ssl_socket_operation.h"
+#include "distributed/rpc/tcp/shm_socket_operation.h"
 #include "distributed/rpc/tcp/connection_pool.h"
 
 namespace mindspore {
@@ -32,6 +35,23 @@ static std::mutex kPrintCountMutex;
 const size_t kPrintCountInterval = 1000;
 const int kPrintTimeInterval = 50000;
 
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define RPC_ZERO_COPY_SUPPORTED
+#endif
+
+namespace {
+// Append a piece of the message to the iovecs, the empty pieces are skipped.
+void AppendIoVec(std::vector<struct iovec> *io_vec, const void *base, size_t len) {
+  if (len == 0) {
+    return;
+  }
+  struct iovec vec;
+  vec.iov_base = const_cast<void *>(base);
+  vec.iov_len = len;
+  io_vec->push_back(vec);
+}
+}  // namespace
+
 // Handle socket events like read/write.
 void SocketEventHandler(int fd, uint32_t events, void *context) {
   Connection *conn = reinterpret_cast<Connection *>(context);
@@ -53,6 +73,10 @@ void SocketEventHandler(int fd, uint32_t events, void *context) {
     }
     return;
   }
+  // The notifications of zero copy sending are reported by EPOLLERR as well, which are not socket errors.
+  if ((events & EPOLLERR) > 0 && conn->zero_copy_threshold > 0 && conn->HandleZeroCopyNotification()) {
+    events &= ~static_cast<uint32_t>(EPOLLERR);
+  }
   // Handle write event.
   if ((events & EPOLLOUT) > 0) {
     (void)conn->recv_event_loop->UpdateEpollEvent(fd, EPOLLIN | EPOLLHUP | EPOLLERR);
@@ -135,7 +159,6 @@ Connection::Connection()
       send_event_loop(nullptr),
       recv_event_loop(nullptr),
       send_metrics(nullptr),
-      send_message(nullptr),
       recv_message(nullptr),
       recv_state(kMsgHeader),
       total_recv_len(0),
@@ -159,13 +182,11 @@ Connection::Connection()
   // Initialize the send message header.
   // This variable will be deleted in the `Close` method.
   send_metrics = new SendMetrics();
-  for (unsigned int i = 0; i < MAGICID_LEN; i++) {
-    if (i < sizeof(RPC_MAGICID) - 1) {
-      send_msg_header.magic[i] = RPC_MAGICID[i];
-    } else {
-      send_msg_header.magic[i] = '\0';
-    }
-  }
+
+  // The iovecs are referenced by the send kernel message, so they are reserved for the largest batch and never
+  // reallocated.
+  sending_messages.reserve(kMaxSendBatchMessageNum);
+  send_io_vec.reserve(kMaxSendBatchMessageNum * SEND_MSG_IO_VEC_LEN);
 
   // Initialize the send kernel message structure.
   send_kernel_msg.msg_control = nullptr;
@@ -173,8 +194,8 @@ Connection::Connection()
   send_kernel_msg.msg_flags = 0;
   send_kernel_msg.msg_name = nullptr;
   send_kernel_msg.msg_namelen = 0;
-  send_kernel_msg.msg_iov = send_io_vec;
-  send_kernel_msg.msg_iovlen = SEND_MSG_IO_VEC_LEN;
+  send_kernel_msg.msg_iov = send_io_vec.data();
+  send_kernel_msg.msg_iovlen = 0;
 }
 
 int Connection::Initialize() {
@@ -246,10 +267,10 @@ void Connection::Close() {
 
   // There's no need to release the recv_message because the lifecycle of this data is passed to the caller.
 
-  if (total_send_len != 0 && send_message != nullptr) {
-    delete send_message;
-    send_message = nullptr;
+  for (auto &sending_message : sending_messages) {
+    delete sending_message.message;
   }
+  sending_messages.clear();
 
   MessageBase *tmpMsg = nullptr;
   while (!send_message_queue.empty()) {
@@ -265,6 +286,12 @@ void Connection::Close() {
     socket_operation = nullptr;
   }
 
+  // The messages sent with zero copy can be released safely after the socket is closed.
+  while (!zero_copy_batches.empty()) {
+    ReleaseSendingMessages(&zero_copy_batches.front().messages);
+    zero_copy_batches.pop_front();
+  }
+
   if (send_metrics != nullptr) {
     delete send_metrics;
     send_metrics = nullptr;
@@ -285,8 +312,9 @@ int Connection::ReceiveMessage() {
   if (message_handler) {
     auto result = message_handler(recv_message);
     if (result != rpc::NULL_MSG) {
-      // Send the result message back to the tcp client if any.
-      FillSendMessage(result, "", false);
+      // Send the result message back to the tcp client if any. The message is queued since the sending batch may be
+      // partially sent.
+      send_message_queue.push(result);
       (void)Flush();
     }
   } else {
@@ -359,40 +387,25 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
     return;
   }
   if (msg->type == MessageBase::Type::KMSG) {
-    // The total len of array variable `send_io_vec` is `SEND_MSG_IO_VEC_LEN` whose value is 5 currently.
-    size_t index = 0;
+    // Each message takes at most `SEND_MSG_IO_VEC_LEN` iovecs, whose value is 5 currently.
+    sending_messages.emplace_back();
+    auto &sending_message = sending_messages.back();
+    sending_message.message = msg;
+    size_t real_data_size = 0;
     if (!isHttpKmsg) {
-      send_to = msg->to;
-      send_from = msg->from;
-      FillMessageHeader(*msg, &send_msg_header);
-
-      send_io_vec[index].iov_base = &send_msg_header;
-      send_io_vec[index].iov_len = sizeof(send_msg_header);
-      ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(msg->name.data());
-      send_io_vec[index].iov_len = msg->name.size();
-      ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(send_to.data());
-      send_io_vec[index].iov_len = send_to.size();
-      ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(send_from.data());
-      send_io_vec[index].iov_len = send_from.size();
-      ++index;
-      send_io_vec[index].iov_base = GetMessageBaseRealData(msg);
-      // The real size of the data body.
-      size_t real_data_size = GetMessageBaseRealDataSize(msg);
-      send_io_vec[index].iov_len = real_data_size;
-      ++index;
-      send_kernel_msg.msg_iov = send_io_vec;
-      send_kernel_msg.msg_iovlen = index;
-      total_send_len =
-        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + real_data_size;
-      send_message = msg;
-
-      // update metrics
-      send_metrics->UpdateMax(real_data_size);
-      send_metrics->last_send_msg_name = msg->name;
-      return;
+      sending_message.to = msg->to;
+      sending_message.from = msg->from;
+      FillMessageHeader(*msg, &sending_message.header);
+
+      AppendIoVec(&send_io_vec, &sending_message.header, sizeof(MessageHeader));
+      AppendIoVec(&send_io_vec, msg->name.data(), msg->name.size());
+      AppendIoVec(&send_io_vec, sending_message.to.data(), sending_message.to.size());
+      AppendIoVec(&send_io_vec, sending_message.from.data(), sending_message.from.size());
+      // The real data body is sent from the memory of message directly.
+      real_data_size = GetMessageBaseRealDataSize(msg);
+      AppendIoVec(&send_io_vec, GetMessageBaseRealData(msg), real_data_size);
+      total_send_len += sizeof(MessageHeader) + msg->name.size() + sending_message.to.size() +
+                        sending_message.from.size() + real_data_size;
     } else {
       if (advertise_addr_.empty()) {
         size_t idx = advertiseUrl.find(URL_PROTOCOL_IP_SEPARATOR);
@@ -403,16 +416,15 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
         }
       }
       msg->body = GenerateHttpMessage(msg);
+      real_data_size = GetMessageBaseRealDataSize(msg);
+      AppendIoVec(&send_io_vec, GetMessageBaseRealData(msg), real_data_size);
+      total_send_len += real_data_size;
+    }
+    send_kernel_msg.msg_iov = send_io_vec.data();
+    send_kernel_msg.msg_iovlen = send_io_vec.size();
+    if (zero_copy_threshold > 0 && real_data_size >= zero_copy_threshold) {
+      zero_copy_sending = true;
     }
-
-    send_io_vec[index].iov_base = GetMessageBaseRealData(msg);
-    size_t real_data_size = GetMessageBaseRealDataSize(msg);
-    send_io_vec[index].iov_len = real_data_size;
-    ++index;
-    send_kernel_msg.msg_iov = send_io_vec;
-    send_kernel_msg.msg_iovlen = index;
-    total_send_len = UlongToUint(real_data_size);
-    send_message = msg;
 
     // update metrics
     send_metrics->UpdateMax(real_data_size);
@@ -420,6 +432,187 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
   }
 }
 
+void Connection::FillSendBatch() {
+  while (!send_message_queue.empty() && sending_messages.size() < kMaxSendBatchMessageNum) {
+    MessageBase *msg = send_message_queue.front();
+    send_message_queue.pop();
+    if (msg->type != MessageBase::Type::KMSG) {
+      MS_LOG(WARNING) << "Drop the message " << msg->name << " whose type is not supported, to: " << destination;
+      delete msg;
+      continue;
+    }
+    FillSendMessage(msg, source, false);
+  }
+}
+
+size_t Connection::FinishSendBatch() {
+  size_t send_bytes = 0;
+  for (const auto &sending_message : sending_messages) {
+    size_t real_data_size = GetMessageBaseRealDataSize(sending_message.message);
+    output_buffer_size -= real_data_size;
+    send_bytes += real_data_size;
+  }
+  if (send_metrics != nullptr) {
+    send_metrics->accum_batch_count++;
+  }
+  if (zero_copy_sending) {
+    ZeroCopyBatch batch;
+    batch.last_send_call = zero_copy_send_calls;
+    batch.messages.swap(sending_messages);
+    zero_copy_batches.push_back(std::move(batch));
+    sending_messages.reserve(kMaxSendBatchMessageNum);
+    zero_copy_sending = false;
+    ReceiveZeroCopyNotification();
+  } else {
+    ReleaseSendingMessages(&sending_messages);
+  }
+  send_io_vec.clear();
+  send_kernel_msg.msg_iov = send_io_vec.data();
+  send_kernel_msg.msg_iovlen = 0;
+  return send_bytes;
+}
+
+void Connection::ReleaseSendingMessages(std::vector<SendingMessage> *messages) {
+  for (auto &sending_message : *messages) {
+    if (!FreeMessageMemory(sending_message.message)) {
+      MS_LOG(ERROR) << "Failed to free memory of the send message.";
+    }
+    delete sending_message.message;
+  }
+  messages->clear();
+}
+
+void Connection::EnableZeroCopy(size_t threshold) {
+  if (threshold == 0 || enable_ssl) {
+    return;
+  }
+#ifdef RPC_ZERO_COPY_SUPPORTED
+  int enable = 1;
+  if (setsockopt(socket_fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) != 0) {
+    MS_LOG(WARNING) << "Failed to enable zero copy sending for fd: " << socket_fd << ", errno: " << errno;
+    return;
+  }
+  zero_copy_threshold = threshold;
+#else
+  MS_LOG(WARNING) << "Zero copy sending is not supported by the system.";
+#endif
+}
+
+bool Connection::SwitchToShm(size_t ring_capacity) {
+  if (enable_ssl || type == ConnectionType::kShm || socket_operation == nullptr) {
+    return false;
+  }
+  auto shm_operation = std::make_unique<ShmSocketOperation>();
+  if (!shm_operation->Create(ring_capacity)) {
+    return false;
+  }
+
+  // The header-only message offering the segment, the id and the nonce of the segment are carried by the length fields.
+  MessageHeader header;
+  for (unsigned int i = 0; i < MAGICID_LEN; ++i) {
+    header.magic[i] = SHM_MAGICID[i];
+  }
+  uint64_t nonce = shm_operation->nonce();
+  const uint32_t kNonceShift = 32;
+  header.name_len = htonl(static_cast<uint32_t>(shm_operation->shm_id()));
+  header.to_len = htonl(static_cast<uint32_t>(nonce >> kNonceShift));
+  header.from_len = htonl(static_cast<uint32_t>(nonce));
+  header.body_len = 0;
+
+  struct iovec header_vec;
+  header_vec.iov_base = &header;
+  header_vec.iov_len = sizeof(header);
+  struct msghdr header_msg = {};
+  header_msg.msg_iov = &header_vec;
+  header_msg.msg_iovlen = 1;
+  size_t send_len = 0;
+  int retval = socket_operation->SendMessage(this, &header_msg, sizeof(header), &send_len);
+  if (retval != IO_RW_OK || send_len != sizeof(header)) {
+    MS_LOG(WARNING) << "Failed to offer the shared memory to " << destination << ", errno: " << errno;
+    return false;
+  }
+  if (!shm_operation->WaitForAttached(kShmAttachTimeoutInMs)) {
+    return false;
+  }
+
+  delete socket_operation;
+  socket_operation = shm_operation.release();
+  type = ConnectionType::kShm;
+  zero_copy_threshold = 0;
+  MS_LOG(INFO) << "The connection to " << destination << " is switched to the shared memory.";
+  return true;
+}
+
+void Connection::AcceptShm() {
+  if (type == ConnectionType::kShm) {
+    MS_LOG(WARNING) << "The connection from " << destination << " has already used the shared memory.";
+    return;
+  }
+  const uint32_t kNonceShift = 32;
+  int shm_id = static_cast<int>(ntohl(recv_msg_header.name_len));
+  uint64_t nonce = (static_cast<uint64_t>(ntohl(recv_msg_header.to_len)) << kNonceShift) |
+                   static_cast<uint64_t>(ntohl(recv_msg_header.from_len));
+  auto shm_operation = std::make_unique<ShmSocketOperation>();
+  if (!shm_operation->Attach(shm_id, nonce)) {
+    // The client keeps using tcp after it waits for attaching timeout.
+    MS_LOG(WARNING) << "Failed to attach the shared memory offered by " << destination << ", keep using tcp.";
+    return;
+  }
+  delete socket_operation;
+  socket_operation = shm_operation.release();
+  type = ConnectionType::kShm;
+  zero_copy_threshold = 0;
+  MS_LOG(INFO) << "The connection from " << destination << " is switched to the shared memory.";
+}
+
+bool Connection::HandleZeroCopyNotification() {
+  MS_EXCEPTION_IF_NULL(conn_mutex);
+  std::lock_guard<std::mutex> lock(*conn_mutex);
+  ReceiveZeroCopyNotification();
+  int so_error = 0;
+  socklen_t len = sizeof(so_error);
+  if (getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, &so_error, &len) != 0) {
+    return false;
+  }
+  return so_error == 0;
+}
+
+void Connection::ReceiveZeroCopyNotification() {
+#ifdef RPC_ZERO_COPY_SUPPORTED
+  // Each notification covers a range of sendmsg calls, which arrive in order except for rare cases.
+  while (true) {
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + CMSG_SPACE(sizeof(struct sockaddr_in6))];
+    struct msghdr notification = {};
+    notification.msg_control = control;
+    notification.msg_controllen = sizeof(control);
+    if (recvmsg(socket_fd, &notification, MSG_ERRQUEUE) < 0) {
+      break;
+    }
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&notification); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&notification, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      auto *err = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(cmsg));
+      if (err->ee_origin != SO_EE_ORIGIN_ZEROCOPY || err->ee_errno != 0) {
+        continue;
+      }
+      (void)zero_copy_pending_notifications.emplace(err->ee_info, err->ee_data);
+    }
+  }
+  for (auto iter = zero_copy_pending_notifications.begin();
+       iter != zero_copy_pending_notifications.end() && iter->first <= zero_copy_completed_calls;
+       iter = zero_copy_pending_notifications.erase(iter)) {
+    zero_copy_completed_calls = std::max(zero_copy_completed_calls, iter->second + 1);
+  }
+#endif
+  while (!zero_copy_batches.empty() && zero_copy_batches.front().last_send_call <= zero_copy_completed_calls) {
+    ReleaseSendingMessages(&zero_copy_batches.front().messages);
+    zero_copy_batches.pop_front();
+  }
+}
+
 void Connection::FillRecvMessage() {
   size_t recvNameLen = static_cast<size_t>(recv_msg_header.name_len);
   size_t recvToLen = static_cast<size_t>(recv_msg_header.to_len);
@@ -481,8 +674,10 @@ size_t Connection::Flush() {
   size_t total_send_bytes = 0;
   while (!send_message_queue.empty() || total_send_len != 0) {
     if (total_send_len == 0) {
-      FillSendMessage(send_message_queue.front(), source, false);
-      send_message_queue.pop();
+      FillSendBatch();
+      if (total_send_len == 0) {
+        break;
+      }
     }
     size_t sendLen = 0;
     int retval = socket_operation->SendMessage(this, &send_kernel_msg, total_send_len, &sendLen);
@@ -491,17 +686,7 @@ size_t Connection::Flush() {
       if (total_send_len == 0) {
         // update metrics
         send_metrics->UpdateError(false);
-
-        size_t real_data_size = GetMessageBaseRealDataSize(send_message);
-        output_buffer_size -= real_data_size;
-        total_send_bytes += real_data_size;
-
-        if (!FreeMessageMemory(send_message)) {
-          MS_LOG(ERROR) << "Failed to free memory of the send message.";
-        }
-        delete send_message;
-        send_message = nullptr;
-        break;
+        total_send_bytes += FinishSendBatch();
       }
     } else if (retval == IO_RW_OK && sendLen == 0) {
       // EAGAIN
@@ -544,6 +729,11 @@ bool Connection::ParseMessage() {
       }
       recv_len = 0;
 
+      if (strncmp(recv_msg_header.magic, SHM_MAGICID, sizeof(SHM_MAGICID) - 1) == 0) {
+        AcceptShm();
+        // The messages following the offer are read from the shared memory if it is attached.
+        return ParseMessage();
+      }
       if (strncmp(recv_msg_header.magic, RPC_MAGICID, sizeof(RPC_MAGICID) - 1) != 0) {
         MS_LOG(ERROR) << "Failed to check magicid, RPC_MAGICID: " << RPC_MAGICID
                       << ", recv magic_id: " << recv_msg_header.magic;
@@ -18,7 +18,10 @@
 #define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_CONNECTION_H_
 
 #include <queue>
+#include <deque>
+#include <map>
 #include <string>
+#include <vector>
 #include <mutex>
 #include <memory>
 
@@ -55,6 +58,7 @@ struct SendMetrics {
   // Reset all the metrics info.
   void Reset() {
     accum_msg_count = 0;
+    accum_batch_count = 0;
     max_msg_size = 0;
     error_code = 0;
     last_succ_msg_name = "";
@@ -65,6 +69,9 @@ struct SendMetrics {
   // The total number of bytes sent already.
   size_t accum_msg_count{0};
 
+  // The number of batches sent out, each batch gathers the queued messages into the same sendmsg calls.
+  size_t accum_batch_count{0};
+
   // The max message body size sent in bytes.
   size_t max_msg_size{0};
   int error_code{0};
@@ -74,6 +81,26 @@ struct SendMetrics {
   std::string last_send_msg_name;
 };
 
+/*
+ * A message in the sending batch of a connection. The header and the addresses are referenced by the iovecs of the
+ * batch, so they are kept with the message until the whole batch is sent out.
+ */
+struct SendingMessage {
+  MessageBase *message{nullptr};
+  MessageHeader header;
+  std::string to;
+  std::string from;
+};
+
+/*
+ * The messages sent with MSG_ZEROCOPY, whose memory is still referenced by the kernel until the notification of the
+ * last sendmsg call of the batch is received from the socket error queue.
+ */
+struct ZeroCopyBatch {
+  uint32_t last_send_call{0};
+  std::vector<SendingMessage> messages;
+};
+
 /*
  * Represents a TCP or SSL connection.
  */
@@ -100,7 +127,7 @@ struct Connection {
   int ReceiveMessage();
   void CheckMessageType();
 
-  // Fill the message to be sent based on the input message.
+  // Append the input message to the batch to be sent, the message body is sent from its own memory without copying.
   void FillSendMessage(MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg);
 
   void FillRecvMessage();
@@ -109,9 +136,22 @@ struct Connection {
     return !(that != nullptr && that->destination == destination && that->is_remote == is_remote);
   }
 
-  // Send all the messages in the message queue.
+  // Send all the messages in the message queue. The queued messages are gathered into batches and each batch is
+  // written by as few sendmsg calls as possible. Returns the body bytes of the messages sent out.
   size_t Flush();
 
+  // Enable MSG_ZEROCOPY for the messages whose body size is not less than the threshold. Only plain TCP connections
+  // support zero copy sending, and it is silently disabled if the kernel does not support it.
+  void EnableZeroCopy(size_t threshold);
+
+  // Receive the notifications of zero copy sending from the socket error queue and release the messages whose memory
+  // is no longer referenced by the kernel. Returns false if a real socket error is pending.
+  bool HandleZeroCopyNotification();
+
+  // Offer a shared memory segment to the server through the tcp socket and transfer the messages through it once the
+  // server attaches it. The connection keeps using tcp and returns false if the server does not attach it in time.
+  bool SwitchToShm(size_t ring_capacity);
+
   /**
    * @description: Set callback to allocate memory for this connection when receiving message from the remote.
    * @param {MemAllocateCallback} &allocate_cb: The allocating memory callback.
@@ -178,7 +218,7 @@ struct Connection {
   SendMetrics *send_metrics;
 
   // The message data waiting to be sent and receive through this connection..
-  MessageBase *send_message;
+  std::vector<SendingMessage> sending_messages;
   MessageBase *recv_message;
 
   // Owned by the tcp_comm.
@@ -194,13 +234,10 @@ struct Connection {
   size_t total_send_len;
   size_t recv_len;
 
-  std::string send_to;
-  std::string send_from;
   std::string recv_to;
   std::string recv_from;
 
   // Message header.
-  MessageHeader send_msg_header;
   MessageHeader recv_msg_header;
 
   // The message structure of kernel.
@@ -208,7 +245,7 @@ struct Connection {
   struct msghdr recv_kernel_msg;
 
   struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
-  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
+  std::vector<struct iovec> send_io_vec;
 
   ParseType recv_message_type{kTcpMsg};
 
@@ -224,6 +261,26 @@ struct Connection {
   // Buffer for messages to be sent.
   std::queue<MessageBase *> send_message_queue;
 
+  // Whether a task to flush the batched small messages has been added to the send event loop.
+  bool flush_scheduled{false};
+
+  // The body size threshold of the messages sent with MSG_ZEROCOPY, zero means zero copy sending is disabled.
+  size_t zero_copy_threshold{0};
+
+  // Whether the current sending batch is sent with MSG_ZEROCOPY.
+  bool zero_copy_sending{false};
+
+  // The number of successful sendmsg calls with MSG_ZEROCOPY, which are the ids of zero copy notifications, and the
+  // number of calls whose notifications have been received.
+  uint32_t zero_copy_send_calls{0};
+  uint32_t zero_copy_completed_calls{0};
+
+  // The batches sent with MSG_ZEROCOPY in the order of sending, which are waiting for notifications.
+  std::deque<ZeroCopyBatch> zero_copy_batches;
+
+  // The ranges of sendmsg calls of the notifications arrived out of order.
+  std::map<uint32_t, uint32_t> zero_copy_pending_notifications;
+
   uint64_t output_buffer_size;
 
   // The error code when sending or receiving messages.
@@ -248,6 +305,21 @@ struct Connection {
   // Make a http message based on given input message.
   std::string GenerateHttpMessage(MessageBase *msg);
 
+  // Take messages from the queue into the sending batch until the queue is empty or the batch is full.
+  void FillSendBatch();
+
+  // Release the messages of the sending batch after it is sent out, and return the body bytes of these messages.
+  size_t FinishSendBatch();
+
+  // Free the memory and delete the messages.
+  void ReleaseSendingMessages(std::vector<SendingMessage> *messages);
+
+  // Receive the notifications from the socket error queue and release the zero copy batches completed.
+  void ReceiveZeroCopyNotification();
+
+  // Attach the shared memory offered by the client in the received header, and switch the socket operation to it.
+  void AcceptShm();
+
   // Change the header body from network byte order to host byte order.
   void ReorderHeader(MessageHeader *header) const;
 
@@ -0,0 +1,368 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/tcp/shm_socket_operation.h"
+
+#include <securec.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+namespace {
+// The states of the shared memory segment during the handshake.
+constexpr uint32_t kShmOffered = 1;
+constexpr uint32_t kShmAttached = 2;
+constexpr uint32_t kShmAbandoned = 3;
+
+constexpr size_t kShmAlignment = 64;
+constexpr size_t kMinShmRingCapacity = 64 * 1024;
+
+// The interval to check the handshake state, and the max sleep interval when the sending ring is full.
+constexpr int kShmAttachCheckIntervalInUs = 100;
+constexpr size_t kShmMaxSendSleepInUs = 100;
+
+// Check whether the peer is alive every so many retries when the sending ring is full, and give up sending after the
+// max retry number like the tcp sending.
+constexpr size_t kShmPeerCheckInterval = 1000;
+constexpr size_t kShmSendRetry = 1024000;
+
+size_t DataOffset() { return (sizeof(ShmChannelHeader) + kShmAlignment - 1) / kShmAlignment * kShmAlignment; }
+
+void CopyMemory(char *dst, const char *src, size_t len) {
+  if (len == 0) {
+    return;
+  }
+  auto ret = memcpy_s(dst, len, src, len);
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "Failed to copy " << len << " bytes for the shared memory ring, error code: " << ret;
+  }
+}
+
+// Whether the peer of the socket has closed the connection, the data in the socket is not consumed.
+bool IsPeerClosed(int fd) {
+  char byte = 0;
+  auto ret = recv(fd, &byte, sizeof(byte), MSG_PEEK | MSG_DONTWAIT);
+  return ret == 0 || (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+}
+}  // namespace
+
+ShmSocketOperation::~ShmSocketOperation() {
+  if (shm_addr_ != nullptr) {
+    if (shmdt(shm_addr_) != 0) {
+      MS_LOG(WARNING) << "Failed to detach the shared memory " << shm_id_ << ", errno: " << errno;
+    }
+    shm_addr_ = nullptr;
+    header_ = nullptr;
+  }
+}
+
+bool ShmSocketOperation::Create(size_t ring_capacity) {
+  uint64_t capacity = kMinShmRingCapacity;
+  while (capacity < ring_capacity) {
+    capacity <<= 1;
+  }
+  size_t size = DataOffset() + 2 * capacity;
+  shm_id_ = shmget(IPC_PRIVATE, size, IPC_CREAT | IPC_EXCL | 0600);
+  if (shm_id_ == -1) {
+    MS_LOG(WARNING) << "Failed to create the shared memory of size " << size << ", errno: " << errno;
+    return false;
+  }
+  void *addr = shmat(shm_id_, nullptr, 0);
+  // Linux allows to attach a segment marked to be destroyed by its id, so the segment is marked at once and it is
+  // released by the kernel after both processes detach it, even if they exit abnormally.
+  if (shmctl(shm_id_, IPC_RMID, nullptr) != 0) {
+    MS_LOG(WARNING) << "Failed to mark the shared memory " << shm_id_ << " to be destroyed, errno: " << errno;
+  }
+  if (addr == reinterpret_cast<void *>(-1)) {
+    MS_LOG(WARNING) << "Failed to attach the shared memory " << shm_id_ << ", errno: " << errno;
+    return false;
+  }
+  shm_addr_ = static_cast<uint8_t *>(addr);
+  header_ = new (shm_addr_) ShmChannelHeader();
+  std::random_device random_device;
+  header_->nonce = (static_cast<uint64_t>(random_device()) << 32) | random_device();
+  header_->ring_capacity = capacity;
+  header_->state.store(kShmOffered, std::memory_order_release);
+  InitRings(true);
+  return true;
+}
+
+bool ShmSocketOperation::Attach(int shm_id, uint64_t nonce) {
+  struct shmid_ds shm_info;
+  if (shmctl(shm_id, IPC_STAT, &shm_info) != 0 || shm_info.shm_segsz < DataOffset()) {
+    MS_LOG(WARNING) << "Failed to get the shared memory " << shm_id << ", errno: " << errno;
+    return false;
+  }
+  void *addr = shmat(shm_id, nullptr, 0);
+  if (addr == reinterpret_cast<void *>(-1)) {
+    MS_LOG(WARNING) << "Failed to attach the shared memory " << shm_id << ", errno: " << errno;
+    return false;
+  }
+  shm_id_ = shm_id;
+  shm_addr_ = static_cast<uint8_t *>(addr);
+  header_ = reinterpret_cast<ShmChannelHeader *>(shm_addr_);
+
+  // The id may be reused by another segment if the client has abandoned this one, which is found by the nonce.
+  uint32_t state = kShmOffered;
+  if (header_->nonce != nonce || shm_info.shm_segsz < DataOffset() + 2 * header_->ring_capacity ||
+      !header_->state.compare_exchange_strong(state, kShmAttached)) {
+    MS_LOG(WARNING) << "The shared memory " << shm_id << " is not offered by the client, state: " << state;
+    (void)shmdt(shm_addr_);
+    shm_addr_ = nullptr;
+    header_ = nullptr;
+    return false;
+  }
+  InitRings(false);
+  return true;
+}
+
+bool ShmSocketOperation::WaitForAttached(uint32_t timeout_in_ms) {
+  MS_EXCEPTION_IF_NULL(header_);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_in_ms);
+  while (header_->state.load(std::memory_order_acquire) == kShmOffered && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(kShmAttachCheckIntervalInUs));
+  }
+  // The server may attach the segment at the same time, so only one of attaching and abandoning succeeds.
+  uint32_t state = kShmOffered;
+  if (header_->state.compare_exchange_strong(state, kShmAbandoned)) {
+    MS_LOG(WARNING) << "The shared memory " << shm_id_ << " is not attached by the server in " << timeout_in_ms
+                    << " ms.";
+    return false;
+  }
+  return state == kShmAttached;
+}
+
+void ShmSocketOperation::InitRings(bool is_client) {
+  MS_EXCEPTION_IF_NULL(header_);
+  auto capacity = header_->ring_capacity;
+  mask_ = capacity - 1;
+  char *data = reinterpret_cast<char *>(shm_addr_) + DataOffset();
+  size_t send_index = is_client ? 0 : 1;
+  size_t recv_index = 1 - send_index;
+  send_ring_ = &header_->rings[send_index];
+  recv_ring_ = &header_->rings[recv_index];
+  send_data_ = data + send_index * capacity;
+  recv_data_ = data + recv_index * capacity;
+}
+
+size_t ShmSocketOperation::ReadRing(char *buf, size_t len, bool peek) {
+  uint64_t head = recv_ring_->head.load(std::memory_order_relaxed);
+  uint64_t tail = recv_ring_->tail.load(std::memory_order_acquire);
+  size_t read_len = std::min(len, static_cast<size_t>(tail - head));
+  if (read_len == 0) {
+    return 0;
+  }
+  size_t offset = static_cast<size_t>(head & mask_);
+  size_t first_len = std::min(read_len, static_cast<size_t>(mask_ + 1 - offset));
+  CopyMemory(buf, recv_data_ + offset, first_len);
+  CopyMemory(buf + first_len, recv_data_, read_len - first_len);
+  if (!peek) {
+    recv_ring_->head.store(head + read_len, std::memory_order_release);
+  }
+  return read_len;
+}
+
+size_t ShmSocketOperation::WriteRing(const char *buf, size_t len) {
+  uint64_t tail = send_ring_->tail.load(std::memory_order_relaxed);
+  uint64_t head = send_ring_->head.load(std::memory_order_acquire);
+  size_t write_len = std::min(len, static_cast<size_t>(mask_ + 1 - (tail - head)));
+  if (write_len == 0) {
+    return 0;
+  }
+  size_t offset = static_cast<size_t>(tail & mask_);
+  size_t first_len = std::min(write_len, static_cast<size_t>(mask_ + 1 - offset));
+  CopyMemory(send_data_ + offset, buf, first_len);
+  CopyMemory(send_data_, buf + first_len, write_len - first_len);
+  send_ring_->tail.store(tail + write_len, std::memory_order_release);
+  return write_len;
+}
+
+bool ShmSocketOperation::DrainWakeUpBytes(Connection *connection) const {
+  const size_t kDrainBufferSize = 64;
+  char buf[kDrainBufferSize];
+  while (true) {
+    auto ret = recv(connection->socket_fd, buf, kDrainBufferSize, MSG_DONTWAIT);
+    if (ret > 0) {
+      continue;
+    }
+    if (ret == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      connection->error_code = (ret == 0) ? ECONNRESET : errno;
+      return false;
+    }
+    return true;
+  }
+}
+
+void ShmSocketOperation::WakeUpPeer(Connection *connection) {
+  // Order the data written before and the flag read after, which pairs with the fence in ReadOrWait.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (send_ring_->consumer_waiting.load(std::memory_order_relaxed) == 0 ||
+      send_ring_->consumer_waiting.exchange(0) == 0) {
+    return;
+  }
+  char byte = 0;
+  (void)send(connection->socket_fd, &byte, sizeof(byte), MSG_NOSIGNAL | MSG_DONTWAIT);
+}
+
+int ShmSocketOperation::ReadOrWait(Connection *connection, char *buf, size_t len, size_t *read_len) {
+  *read_len = ReadRing(buf, len);
+  if (*read_len > 0) {
+    return IO_RW_OK;
+  }
+  // The ring is empty, consume the wake up bytes and wait for the next one. The ring is checked again after the flag
+  // is set, in case the data is written before the peer reads the flag.
+  bool peer_alive = DrainWakeUpBytes(connection);
+  recv_ring_->consumer_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  *read_len = ReadRing(buf, len);
+  if (*read_len > 0) {
+    recv_ring_->consumer_waiting.store(0, std::memory_order_relaxed);
+    return IO_RW_OK;
+  }
+  return peer_alive ? IO_RW_OK : IO_RW_ERROR;
+}
+
+ssize_t ShmSocketOperation::ReceivePeek(Connection *connection, char *recvBuf, uint32_t recvLen) {
+  if (connection == nullptr || recvBuf == nullptr) {
+    return -1;
+  }
+  return static_cast<ssize_t>(ReadRing(recvBuf, recvLen, true));
+}
+
+int ShmSocketOperation::Receive(Connection *connection, char *recvBuf, size_t totalRecvLen, size_t *recvLen) {
+  if (connection == nullptr || recvBuf == nullptr || recvLen == nullptr) {
+    return IO_RW_ERROR;
+  }
+  *recvLen = 0;
+  while (*recvLen < totalRecvLen) {
+    size_t read_len = 0;
+    int retval = ReadOrWait(connection, recvBuf + *recvLen, totalRecvLen - *recvLen, &read_len);
+    if (retval != IO_RW_OK) {
+      return retval;
+    }
+    if (read_len == 0) {
+      break;
+    }
+    *recvLen += read_len;
+  }
+  return IO_RW_OK;
+}
+
+int ShmSocketOperation::ReceiveMessage(Connection *connection, struct msghdr *recvMsg, size_t totalRecvLen,
+                                       size_t *recvLen) {
+  if (connection == nullptr || recvMsg == nullptr || recvLen == nullptr) {
+    return IO_RW_ERROR;
+  }
+  // The received bytes are accumulated to recvLen and the iovecs are advanced past them like the tcp receiving, so a
+  // partially received message is continued in the next call.
+  while (*recvLen < totalRecvLen && recvMsg->msg_iovlen > 0) {
+    auto &vec = recvMsg->msg_iov[0];
+    if (vec.iov_len > 0) {
+      size_t read_len = 0;
+      int retval = ReadOrWait(connection, static_cast<char *>(vec.iov_base), vec.iov_len, &read_len);
+      if (retval != IO_RW_OK) {
+        return retval;
+      }
+      if (read_len == 0) {
+        break;
+      }
+      *recvLen += read_len;
+      vec.iov_base = static_cast<char *>(vec.iov_base) + read_len;
+      vec.iov_len -= read_len;
+    }
+    if (vec.iov_len == 0) {
+      ++recvMsg->msg_iov;
+      --recvMsg->msg_iovlen;
+    }
+  }
+  return IO_RW_OK;
+}
+
+int ShmSocketOperation::SendMessage(Connection *connection, struct msghdr *sendMsg, size_t totalSendLen,
+                                    size_t *sendLen) {
+  if (connection == nullptr || sendMsg == nullptr || sendLen == nullptr) {
+    return IO_RW_ERROR;
+  }
+  *sendLen = 0;
+  size_t retry = 0;
+  while (*sendLen < totalSendLen && sendMsg->msg_iovlen > 0) {
+    auto &vec = sendMsg->msg_iov[0];
+    size_t write_len = WriteRing(static_cast<const char *>(vec.iov_base), vec.iov_len);
+    *sendLen += write_len;
+    vec.iov_base = static_cast<char *>(vec.iov_base) + write_len;
+    vec.iov_len -= write_len;
+    if (vec.iov_len == 0) {
+      ++sendMsg->msg_iov;
+      --sendMsg->msg_iovlen;
+      continue;
+    }
+    if (write_len > 0) {
+      retry = 0;
+      continue;
+    }
+
+    // The ring is full, wake up the peer in case it is waiting and retry later.
+    WakeUpPeer(connection);
+    if (++retry % kShmPeerCheckInterval == 0) {
+      if (IsPeerClosed(connection->socket_fd)) {
+        MS_LOG(WARNING) << "The peer of the shared memory connection " << connection->destination << " is closed.";
+        connection->error_code = ECONNRESET;
+        return IO_RW_ERROR;
+      }
+      if (retry == kShmSendRetry) {
+        MS_LOG(WARNING) << "Failed to send message through the shared memory after retry " << kShmSendRetry
+                        << " times, to: " << connection->destination;
+        return IO_RW_OK;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min(retry, kShmMaxSendSleepInUs)));
+  }
+  WakeUpPeer(connection);
+  return IO_RW_OK;
+}
+
+void ShmSocketOperation::Close(Connection *connection) {
+  if (connection == nullptr) {
+    return;
+  }
+  (void)close(connection->socket_fd);
+  connection->socket_fd = -1;
+}
+
+void ShmSocketOperation::NewConnEventHandler(int, uint32_t, void *context) {
+  Connection *conn = reinterpret_cast<Connection *>(context);
+  if (conn == nullptr) {
+    return;
+  }
+  conn->state = ConnectionState::kConnected;
+}
+
+void ShmSocketOperation::ConnEstablishedEventHandler(int, uint32_t, void *context) {
+  Connection *conn = reinterpret_cast<Connection *>(context);
+  if (conn == nullptr) {
+    return;
+  }
+  conn->state = ConnectionState::kConnected;
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
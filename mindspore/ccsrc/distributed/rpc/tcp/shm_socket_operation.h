@@ -0,0 +1,119 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_SHM_SOCKET_OPERATION_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_SHM_SOCKET_OPERATION_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "distributed/rpc/tcp/connection.h"
+#include "distributed/rpc/tcp/socket_operation.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// A single producer single consumer byte ring in the shared memory. The positions increase monotonically and are
+// wrapped by the capacity, which is a power of two.
+struct ShmRing {
+  alignas(64) std::atomic<uint64_t> head{0};
+  alignas(64) std::atomic<uint64_t> tail{0};
+  // Set by the consumer before it waits for the socket to be readable, then the producer writes a byte to the socket
+  // to wake it up after new data is written.
+  alignas(64) std::atomic<uint32_t> consumer_waiting{0};
+};
+
+// The header at the beginning of the shared memory segment of a connection, followed by the data of the two rings.
+struct ShmChannelHeader {
+  uint64_t nonce{0};
+  uint64_t ring_capacity{0};
+  std::atomic<uint32_t> state{0};
+  // The ring from the client to the server and the ring from the server to the client.
+  ShmRing rings[2];
+};
+
+/*
+ * The socket operation which transfers the messages through a pair of rings in the shared memory between two processes
+ * on the same host. The tcp socket of the connection is kept to detect the disconnection and to wake up the peer, so
+ * the connection is still driven by the events of the socket like the tcp and ssl ones.
+ */
+class ShmSocketOperation : public SocketOperation {
+ public:
+  ShmSocketOperation() = default;
+  ~ShmSocketOperation() override;
+
+  // Create the shared memory segment as the client of the connection, whose capacity of each ring is at least
+  // 'ring_capacity' bytes.
+  bool Create(size_t ring_capacity);
+
+  // Attach the shared memory segment created by the client of the connection, the nonce is used to make sure the
+  // segment is the one created by the client.
+  bool Attach(int shm_id, uint64_t nonce);
+
+  // Wait for the server to attach the shared memory segment created by this client. The segment is abandoned if the
+  // server does not attach it in time, and then both the client and the server keep using tcp.
+  bool WaitForAttached(uint32_t timeout_in_ms);
+
+  int shm_id() const { return shm_id_; }
+  uint64_t nonce() const { return header_ == nullptr ? 0 : header_->nonce; }
+
+  ssize_t ReceivePeek(Connection *connection, char *recvBuf, uint32_t recvLen) override;
+  int Receive(Connection *connection, char *recvBuf, size_t totalRecvLen, size_t *recvLen) override;
+  int ReceiveMessage(Connection *connection, struct msghdr *recvMsg, size_t totalRecvLen, size_t *recvLen) override;
+
+  int SendMessage(Connection *connection, struct msghdr *sendMsg, size_t totalSendLen, size_t *sendLen) override;
+
+  void Close(Connection *connection) override;
+
+  void NewConnEventHandler(int fd, uint32_t events, void *context) override;
+  void ConnEstablishedEventHandler(int fd, uint32_t events, void *context) override;
+
+ private:
+  // Map the rings of the attached segment for the client or the server.
+  void InitRings(bool is_client);
+
+  // Copy the data available in the receiving ring to the buffer, and return the number of bytes copied. The data is
+  // kept in the ring if 'peek' is true.
+  size_t ReadRing(char *buf, size_t len, bool peek = false);
+
+  // Copy the data to the free space of the sending ring, and return the number of bytes copied.
+  size_t WriteRing(const char *buf, size_t len);
+
+  // Read the data available into the buffer. If the ring is empty, mark the consumer waiting so the peer will wake up
+  // this connection through the socket. Returns IO_RW_ERROR if the peer has closed the connection.
+  int ReadOrWait(Connection *connection, char *buf, size_t len, size_t *read_len);
+
+  // Drain the wake up bytes from the socket, returns false if the peer has closed the connection.
+  bool DrainWakeUpBytes(Connection *connection) const;
+
+  // Wake up the peer through the socket if it is waiting for data.
+  void WakeUpPeer(Connection *connection);
+
+  int shm_id_{-1};
+  uint8_t *shm_addr_{nullptr};
+  ShmChannelHeader *header_{nullptr};
+
+  ShmRing *send_ring_{nullptr};
+  ShmRing *recv_ring_{nullptr};
+  char *send_data_{nullptr};
+  char *recv_data_{nullptr};
+  uint64_t mask_{0};
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif
@@ -81,6 +81,10 @@ bool TCPClient::Connect(const std::string &dst_url, size_t retry_count, const Me
 
 bool TCPClient::IsConnected(const std::string &dst_url) { return tcp_comm_->IsConnected(dst_url); }
 
+bool TCPClient::IsConnectedThroughShm(const std::string &dst_url) { return tcp_comm_->IsConnectedThroughShm(dst_url); }
+
+size_t TCPClient::GetSendBatchNum(const std::string &dst_url) { return tcp_comm_->GetSendBatchNum(dst_url); }
+
 bool TCPClient::Disconnect(const std::string &dst_url, size_t timeout_in_sec) {
   bool rt = false;
   if (!tcp_comm_->Disconnect(dst_url)) {
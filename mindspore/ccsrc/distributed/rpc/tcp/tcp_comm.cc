@@ -23,10 +23,28 @@
 #include "actor/aid.h"
 #include "include/backend/distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace distributed {
 namespace rpc {
+namespace {
+// Get the size in bytes set by the environment variable, the default value is returned if it is not set or invalid.
+size_t GetSizeFromEnv(const char *env_name, size_t default_value) {
+  std::string env_value = common::GetEnv(env_name);
+  if (env_value.empty()) {
+    return default_value;
+  }
+  try {
+    return std::stoul(env_value);
+  } catch (const std::exception &) {
+    MS_LOG(WARNING) << "The value of " << env_name << " should be a non-negative integer, but got: " << env_value
+                    << ". Use the default value " << default_value << " instead.";
+    return default_value;
+  }
+}
+}  // namespace
+
 void DoDisconnect(int fd, Connection *conn, uint32_t error, int soError) {
   if (conn == nullptr) {
     return;
@@ -113,6 +131,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
   }
 
   conn->socket_fd = acceptFd;
+  conn->EnableZeroCopy(tcpmgr->zero_copy_threshold_);
   conn->source = tcpmgr->url_;
   conn->destination = SocketOperation::GetPeer(acceptFd);
   conn->peer = conn->destination;
@@ -155,6 +174,15 @@ bool TCPComm::Initialize() {
   conn_mutex_ = std::make_shared<std::mutex>();
   MS_EXCEPTION_IF_NULL(conn_mutex_);
 
+  batch_message_size_ = GetSizeFromEnv(kEnvRpcBatchMessageSize, kDefaultBatchMessageSize);
+  zero_copy_threshold_ = GetSizeFromEnv(kEnvRpcZeroCopyThreshold, 0);
+  if (!enable_ssl_ && common::GetEnv(kEnvRpcShmTransport) != "0") {
+    shm_buffer_size_ = GetSizeFromEnv(kEnvRpcShmBufferSize, kDefaultShmBufferSize);
+  }
+  MS_LOG(INFO) << "The max body size of batched messages is " << batch_message_size_
+               << ", the min body size of zero copy messages is " << zero_copy_threshold_
+               << ", and the shared memory buffer size is " << shm_buffer_size_;
+
   recv_event_loop_ = new (std::nothrow) EventLoop();
   if (recv_event_loop_ == nullptr) {
     MS_LOG(ERROR) << "Failed to create recv evLoop.";
@@ -236,7 +264,9 @@ void TCPComm::ReadCallBack(void *connection) {
   do {
     retval = ReceiveMessage(conn);
     ++count;
-  } while (retval > 0 && count < max_recv_count);
+    // The shared memory connection is woken up only when its ring becomes non-empty, so all the messages in the ring
+    // must be consumed here rather than waiting for the next event of the socket.
+  } while (retval > 0 && (count < max_recv_count || conn->type == ConnectionType::kShm));
 
   return;
 }
@@ -328,11 +358,32 @@ void TCPComm::DropMessage(MessageBase *msg) {
   ptr = nullptr;
 }
 
+void TCPComm::ScheduleFlush(Connection *conn) {
+  if (conn->flush_scheduled) {
+    return;
+  }
+  conn->flush_scheduled = true;
+  std::string destination = conn->destination;
+  // The task is executed in the next round of the send event loop, after the messages sent in this round are queued.
+  send_event_loop_->AddTask([destination, this] {
+    std::lock_guard<std::mutex> lock(*conn_mutex_);
+    Connection *conn = conn_pool_->FindConnection(destination);
+    if (conn == nullptr) {
+      return false;
+    }
+    conn->flush_scheduled = false;
+    if (conn->state == ConnectionState::kConnected) {
+      (void)conn->Flush();
+    }
+    return true;
+  });
+}
+
 bool TCPComm::Send(MessageBase *msg, size_t *const send_bytes, bool sync) {
   if (msg == nullptr) {
     return false;
   }
-  auto task = [msg, send_bytes, this] {
+  auto task = [msg, send_bytes, sync, this] {
     std::lock_guard<std::mutex> lock(*conn_mutex_);
     // Search connection by the target address
     std::string destination = msg->to.Url();
@@ -366,10 +417,14 @@ bool TCPComm::Send(MessageBase *msg, size_t *const send_bytes, bool sync) {
       return false;
     }
 
-    if (conn->total_send_len == 0) {
-      conn->FillSendMessage(msg, url_, false);
-    } else {
-      (void)conn->send_message_queue.emplace(msg);
+    (void)conn->send_message_queue.emplace(msg);
+    // The small messages sent asynchronously are corked until the next round of the send event loop or a full batch is
+    // queued, so that they are written together with the other messages to the same destination by one sendmsg call.
+    size_t body_size = (msg->data != nullptr) ? msg->size : msg->body.size();
+    if (!sync && batch_message_size_ > 0 && body_size <= batch_message_size_ &&
+        conn->send_message_queue.size() < kMaxSendBatchMessageNum) {
+      ScheduleFlush(conn);
+      return true;
     }
     auto bytes = conn->Flush();
     if (send_bytes != nullptr) {
@@ -435,6 +490,7 @@ bool TCPComm::Connect(const std::string &dst_url, const MemFreeCallback &free_cb
     }
 
     conn->socket_fd = sock_fd;
+    conn->EnableZeroCopy(zero_copy_threshold_);
     conn->event_callback = std::bind(&TCPComm::EventCallBack, this, std::placeholders::_1);
     conn->write_callback = std::bind(&TCPComm::WriteCallBack, this, std::placeholders::_1);
     conn->read_callback = std::bind(&TCPComm::ReadCallBack, this, std::placeholders::_1);
@@ -468,6 +524,11 @@ bool TCPComm::Connect(const std::string &dst_url, const MemFreeCallback &free_cb
     if (conn->state != ConnectionState::kConnected) {
       return false;
     }
+    // The peer on the same host is reached through the shared memory, no message is sent before the switch since the
+    // connection is not in the pool yet.
+    if (shm_buffer_size_ > 0 && SocketOperation::GetIP(dst_url) == dst_url_to_src_ip_[dst_url]) {
+      (void)conn->SwitchToShm(shm_buffer_size_);
+    }
     conn_pool_->AddConnection(conn);
     conn->SetMessageFreeCallback(free_cb);
   }
@@ -485,6 +546,20 @@ bool TCPComm::IsConnected(const std::string &dst_url) {
   return false;
 }
 
+bool TCPComm::IsConnectedThroughShm(const std::string &dst_url) {
+  MS_EXCEPTION_IF_NULL(conn_pool_);
+  Connection *conn = conn_pool_->FindConnection(dst_url);
+  return conn != nullptr && conn->state == ConnectionState::kConnected && conn->type == ConnectionType::kShm;
+}
+
+size_t TCPComm::GetSendBatchNum(const std::string &dst_url) {
+  MS_EXCEPTION_IF_NULL(conn_mutex_);
+  MS_EXCEPTION_IF_NULL(conn_pool_);
+  std::lock_guard<std::mutex> lock(*conn_mutex_);
+  Connection *conn = conn_pool_->FindConnection(dst_url);
+  return (conn != nullptr && conn->send_metrics != nullptr) ? conn->send_metrics->accum_batch_count : 0;
+}
+
 bool TCPComm::Disconnect(const std::string &dst_url) {
   MS_EXCEPTION_IF_NULL(conn_mutex_);
   MS_EXCEPTION_IF_NULL(conn_pool_);
@@ -40,7 +40,13 @@ void ConnectedEventHandler(int fd, uint32_t events, void *context);
 class TCPComm {
  public:
   explicit TCPComm(bool enable_ssl = false)
-      : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr), enable_ssl_(enable_ssl) {}
+      : server_fd_(-1),
+        recv_event_loop_(nullptr),
+        send_event_loop_(nullptr),
+        enable_ssl_(enable_ssl),
+        batch_message_size_(kDefaultBatchMessageSize),
+        zero_copy_threshold_(0),
+        shm_buffer_size_(0) {}
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm() = default;
@@ -61,6 +67,10 @@ class TCPComm {
   // Connection operation for a specified destination.
   bool Connect(const std::string &dst_url, const MemFreeCallback &free_cb);
   bool IsConnected(const std::string &dst_url);
+  // Check if the connection to dst_url transfers the messages through the shared memory.
+  bool IsConnectedThroughShm(const std::string &dst_url);
+  // Get the number of message batches sent through the connection to dst_url.
+  size_t GetSendBatchNum(const std::string &dst_url);
   bool Disconnect(const std::string &dst_url);
 
   // Send the message from the source to the destination.
@@ -100,6 +110,9 @@ class TCPComm {
 
   static void DropMessage(MessageBase *msg);
 
+  // Add a task to the send event loop to flush the connection to the destination, unless one has been added.
+  void ScheduleFlush(Connection *conn);
+
   // Read and write events.
   void ReadCallBack(void *conn);
   void WriteCallBack(void *conn);
@@ -130,6 +143,16 @@ class TCPComm {
 
   bool enable_ssl_;
 
+  // The max body size of the messages sent asynchronously in batches, see kEnvRpcBatchMessageSize.
+  size_t batch_message_size_;
+
+  // The min body size of the messages sent with MSG_ZEROCOPY, see kEnvRpcZeroCopyThreshold.
+  size_t zero_copy_threshold_;
+
+  // The size of the shared memory ring of the connections to the same host, zero disables the shared memory transport.
+  // See kEnvRpcShmTransport.
+  size_t shm_buffer_size_;
+
   friend void OnAccept(int server, uint32_t events, void *arg);
   friend int DoConnect(const std::string &to, Connection *conn, ConnectionCallBack event_callback,
                        ConnectionCallBack write_callback, ConnectionCallBack read_callback);
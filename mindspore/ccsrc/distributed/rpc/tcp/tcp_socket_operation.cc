@@ -124,8 +124,27 @@ int TCPSocketOperation::SendMessage(Connection *connection, struct msghdr *sendM
   const int sleep_interval_factor = 10;
   *sendLen = 0;
 
+  int flags = MSG_NOSIGNAL;
+#ifdef MSG_ZEROCOPY
+  if (connection->zero_copy_sending) {
+    flags |= MSG_ZEROCOPY;
+  }
+#endif
+
   while (*sendLen != totalSendLen) {
-    auto retval = sendmsg(connection->socket_fd, sendMsg, MSG_NOSIGNAL);
+    auto retval = sendmsg(connection->socket_fd, sendMsg, flags);
+#ifdef MSG_ZEROCOPY
+    if ((flags & MSG_ZEROCOPY) != 0) {
+      if (retval >= 0) {
+        // Each successful sendmsg call with MSG_ZEROCOPY gets a notification, whose id is the number of calls before.
+        ++connection->zero_copy_send_calls;
+      } else if (errno == ENOBUFS) {
+        // The pinned pages exceed the socket option memory limit, fall back to copying for the rest of this batch.
+        flags &= ~MSG_ZEROCOPY;
+        continue;
+      }
+    }
+#endif
     if (retval < 0) {
       ++eagainCount;
       if (errno != EAGAIN) {
@@ -136,7 +155,7 @@ int TCPSocketOperation::SendMessage(Connection *connection, struct msghdr *sendM
         MS_LOG(WARNING) << "Failed to call sendmsg after retry " + std::to_string(EAGAIN_RETRY) +
                              " times and errno is: "
                         << errno << " " << strerror(errno);
-        *sendLen = 0;
+        // Return the bytes sent already, the iovecs have been advanced past them.
         return IO_RW_OK;
       }
       if (eagainCount % print_interval == 0) {
@@ -17,10 +17,15 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_EMBEDDING_CHCHE_UTILS_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_EMBEDDING_CHCHE_UTILS_H_
 
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <future>
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <tuple>
 #include <utility>
@@ -50,6 +55,9 @@ static constexpr size_t kMaxIdsPerThread = 10000;
 
 // Prefetch 16 batchs data once.
 static constexpr size_t kMultiBatchThreshold = 16;
+// The environment variable used to set the lookahead window of prefetching, that is the number of batches whose ids
+// are deduplicated and analysed together ahead of the computed graph.
+constexpr auto kEnvEmbeddingCacheLookahead = "MS_EMBEDDING_CACHE_LOOKAHEAD";
 
 using mindspore::device::DeviceAddress;
 using mindspore::kernel::Address;
@@ -122,6 +130,13 @@ struct EmbeddingCacheStatisticsInfo {
   size_t mem_cache_swap_out_size_{0};
   size_t mem_cache_swap_in_size_{0};
   size_t mem_cache_hit_count_{0};
+  // The number of steps that the prefetching runs ahead of the computed graph when the batches are analysed.
+  size_t lookahead_steps_{0};
+  // The time costs in microseconds of prefetching the batches: analysing cache, stalling for the computed graph to
+  // release cache slots during analysis, and swapping the embeddings between device, local host and remote.
+  uint64_t analyse_cost_us_{0};
+  uint64_t wait_graph_cost_us_{0};
+  uint64_t swap_cost_us_{0};
 };
 
 // Origin id data item recorder.
@@ -406,6 +421,44 @@ class BACKEND_EXPORT EmbeddingStorageManager {
   HashMap<int32_t, std::shared_ptr<storage::AbstractEmbeddingStorage>> embedding_storages_;
 };
 
+/**
+ * @brief Run a task on a persistent worker thread, overlapped with another task on the caller thread. It is used to
+ * overlap the swaps of embeddings between local host and remote with the ones between device and local host, without
+ * creating a thread for each step.
+ */
+class BACKEND_EXPORT OverlappedTaskRunner {
+ public:
+  OverlappedTaskRunner() = default;
+  ~OverlappedTaskRunner();
+
+  /**
+   * @brief Run `overlapped_task` on the worker thread and `main_task` on the caller thread, and return after both of
+   * them finish, even if one of them throws, in which case the exception is rethrown to the caller.
+   * @param[in] `overlapped_task`: The task run on the worker thread.
+   * @param[in] `main_task`: The task run on the caller thread.
+   * @return true if both the tasks succeed, else false.
+   */
+  bool Run(const std::function<bool()> &overlapped_task, const std::function<bool()> &main_task);
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(OverlappedTaskRunner);
+
+  void WorkerLoop();
+  // Wait for the overlapped task to finish, and return its result or rethrow its exception.
+  bool WaitOverlappedTask();
+
+  // The worker thread is created by the first run and lives until the runner is destroyed.
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable done_cond_;
+  std::function<bool()> task_;
+  bool task_done_{true};
+  bool task_ret_{true};
+  std::exception_ptr task_exception_;
+  bool stop_{false};
+};
+
 /**
  * @brief Create a new embedding storage instance for specific key and value type, and add the instance to
  * EmbeddingStorageManager.
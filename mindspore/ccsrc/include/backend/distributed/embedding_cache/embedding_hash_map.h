@@ -21,12 +21,12 @@
 #include <utility>
 #include <memory>
 #include <vector>
-#include <list>
 #include <mutex>
 #include "utils/hash_map.h"
 #include "utils/convert_utils_base.h"
 #include "include/backend/visible.h"
 #include "distributed/embedding_cache/cache_strategy/cache.h"
+#include "distributed/embedding_cache/cache_strategy/cache_factory.h"
 
 namespace mindspore {
 namespace distributed {
@@ -54,7 +54,7 @@ class BACKEND_EXPORT EmbeddingHashMap {
  public:
   using Element = typename Cache<int, int>::Element;
 
-  explicit EmbeddingHashMap(size_t hash_capacity);
+  explicit EmbeddingHashMap(size_t hash_capacity, CachePolicy cache_policy = CachePolicy::kLRU);
 
   ~EmbeddingHashMap() = default;
 
@@ -76,7 +76,10 @@ class BACKEND_EXPORT EmbeddingHashMap {
   // Get index by id.
   bool GetIndex(const int id, int *index) const;
 
-  const std::list<Element> &Export() const;
+  std::vector<Element> Export() const;
+
+  // Get the hit/miss/swap counters of the id -> index cache.
+  const CacheStatistics &cache_statistics() const;
 
   // Reset the hash map.
   void Reset() {}
@@ -35,6 +35,30 @@ using ConnectionCallBack = std::function<void(void *connection)>;
 constexpr int SEND_MSG_IO_VEC_LEN = 5;
 constexpr int RECV_MSG_IO_VEC_LEN = 4;
 
+// The max number of messages gathered into one sending batch, the iovecs of a batch must not exceed IOV_MAX.
+constexpr size_t kMaxSendBatchMessageNum = 64;
+
+// The environment variable to set the max body size in bytes of the messages sent asynchronously in batches. Such a
+// small message is not sent at once but waits for the other messages sent to the same destination in the same round of
+// the send event loop, then they are written together. Zero disables the batching.
+constexpr char kEnvRpcBatchMessageSize[] = "MS_RPC_BATCH_MESSAGE_SIZE";
+constexpr size_t kDefaultBatchMessageSize = 4096;
+
+// The environment variable to set the min body size in bytes of the messages sent with MSG_ZEROCOPY. The pages of
+// these messages are pinned instead of copied into the socket buffer, which only pays off for large tensors. Zero copy
+// sending is disabled by default.
+constexpr char kEnvRpcZeroCopyThreshold[] = "MS_RPC_ZERO_COPY_THRESHOLD";
+
+// The environment variable to enable the shared memory transport between the processes on the same host, the messages
+// are transferred through the rings in shared memory instead of the loopback tcp. It is enabled by default and "0"
+// disables it. The transport is not used for ssl connections.
+constexpr char kEnvRpcShmTransport[] = "MS_RPC_SHM_TRANSPORT";
+// The environment variable to set the size in bytes of the shared memory ring in each direction of a connection.
+constexpr char kEnvRpcShmBufferSize[] = "MS_RPC_SHM_BUFFER_SIZE";
+constexpr size_t kDefaultShmBufferSize = 4 << 20;
+// The time to wait for the server to attach the shared memory, the connection keeps using tcp after timeout.
+constexpr uint32_t kShmAttachTimeoutInMs = 1000;
+
 constexpr unsigned int MAGICID_LEN = 4;
 constexpr int SENDMSG_QUEUELEN = 1024;
 constexpr int SENDMSG_DROPED = -1;
@@ -47,7 +71,7 @@ constexpr size_t MAX_KMSG_BODY_LEN = 1073741824;
 enum ParseType { kTcpMsg = 1, kHttpReq, kHttpRsp, kUnknown };
 enum State { kMsgHeader, kBody };
 enum ConnectionState { kInit = 1, kConnecting, kConnected, kDisconnecting, kClose };
-enum ConnectionType { kTcp = 1, kSSL };
+enum ConnectionType { kTcp = 1, kSSL, kShm };
 enum ConnectionPriority { kPriorityLow = 1, kPriorityHigh };
 
 static const int g_httpKmsgEnable = -1;
@@ -73,6 +97,8 @@ static const int SOCKET_KEEPINTERVAL = 5;
 static const int SOCKET_KEEPCOUNT = 3;
 
 static const char RPC_MAGICID[] = "RPC0";
+// The magic of the header-only message which offers the shared memory of a connection to the server.
+static const char SHM_MAGICID[] = "SHM0";
 static const char TCP_RECV_EVLOOP_THREADNAME[] = "RECV_EVENT_LOOP";
 static const char TCP_SEND_EVLOOP_THREADNAME[] = "SEND_EVENT_LOOP";
 
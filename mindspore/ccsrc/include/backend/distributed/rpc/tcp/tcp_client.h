@@ -52,6 +52,12 @@ class BACKEND_EXPORT TCPClient : public RPCClientBase {
   // Check if the connection to dst_url has been established.
   bool IsConnected(const std::string &dst_url) override;
 
+  // Check if the connection to dst_url transfers the messages through the shared memory.
+  bool IsConnectedThroughShm(const std::string &dst_url);
+
+  // Get the number of message batches sent to dst_url.
+  size_t GetSendBatchNum(const std::string &dst_url);
+
   // Disconnect from the specified server.
   bool Disconnect(const std::string &dst_url, size_t timeout_in_sec = 5) override;
 
@@ -27,12 +27,12 @@
 #include <mutex>
 #include <string>
 #include <tuple>
+#include <atomic>
+#include <unordered_map>
 #include "utils/ms_utils.h"
 #include "include/backend/visible.h"
 #include "include/common/utils/stream_util.h"
-#ifdef __APPLE__
 #include "mindrt/include/async/spinlock.h"
-#endif
 
 namespace mindspore {
 namespace device {
@@ -45,6 +45,16 @@ constexpr int kAllocatorTypeNum = 5;
 constexpr size_t kDynamicMemAlignSize = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 constexpr size_t kDynamicMemAllocUnitSize = 1024 << 20;
+// The max aligned size (4M) of memory buf which can be served by the mem buf cache.
+constexpr size_t kMemBufCacheMaxBufSize = 4 << 20;
+// The max number of cached memory bufs in one size class of one stream.
+constexpr size_t kMemBufCacheMaxBufNumPerSize = 64;
+// The max total size (256M) of cached memory bufs of one stream.
+constexpr size_t kMemBufCacheMaxSizePerStream = 256 << 20;
+// The streams whose id is not less than this number always use the locked path.
+constexpr uint32_t kMemBufCacheMaxStreamNum = 64;
+// The shard number of the address tracking map, which is used to find the size and stream of the freed address.
+constexpr size_t kMemBufCacheShardNum = 16;
 
 // The Comparator of device address from small to large.
 using DeviceMemPtr = void(*);
@@ -68,6 +78,84 @@ using DynamicMemBlockPtr = std::shared_ptr<DynamicMemBlock>;
 struct MemStatusManager;
 using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 
+// The fragmentation information of memory block or stream. The fragmentation ratio is the part of idle memory which is
+// out of the largest idle extent, 0 means all the idle memory is continuous.
+struct MemFragmentationInfo {
+  size_t total_idle_size_{0};
+  size_t largest_idle_size_{0};
+  size_t idle_buf_count_{0};
+
+  void Accumulate(const MemFragmentationInfo &other) {
+    total_idle_size_ += other.total_idle_size_;
+    largest_idle_size_ = std::max(largest_idle_size_, other.largest_idle_size_);
+    idle_buf_count_ += other.idle_buf_count_;
+  }
+  double FragmentationRatio() const {
+    if (total_idle_size_ == 0) {
+      return 0.0;
+    }
+    return 1.0 - static_cast<double>(largest_idle_size_) / static_cast<double>(total_idle_size_);
+  }
+};
+
+// The size class cache in front of the best-fit index, which is used to serve the repeated alloc and free of the same
+// aligned size without taking the pool lock. The cached memory bufs keep the used status in the memory block, and are
+// returned to the best-fit index when the cache of the stream is drained.
+class MemBufCache {
+ public:
+  MemBufCache() = default;
+  ~MemBufCache() = default;
+
+  // Whether the alloc can be served by the cache.
+  static bool IsCacheable(size_t align_size, uint32_t stream_id) {
+    return align_size <= kMemBufCacheMaxBufSize && stream_id < kMemBufCacheMaxStreamNum;
+  }
+
+  // Pop a cached memory buf of the size class, return nullptr if miss.
+  DeviceMemPtr Pop(size_t align_size, uint32_t stream_id);
+  // Push the freed address into the cache of its stream, return false if the address is not tracked or the cache is
+  // full, then the caller need free it by the locked path.
+  bool Push(const DeviceMemPtr &device_addr);
+
+  // Record the size and stream of the cacheable address which is in use.
+  void Track(const DeviceMemPtr &device_addr, size_t align_size, uint32_t stream_id);
+  // Remove the address from tracking when it is freed or split by the locked path.
+  void Untrack(const DeviceMemPtr &device_addr);
+
+  // Take out all the cached addresses of the stream.
+  std::vector<DeviceMemPtr> Drain(uint32_t stream_id);
+  std::vector<DeviceMemPtr> DrainAll();
+  // Drop all the cached and tracked addresses without freeing, used when the device memory is released.
+  void Clear();
+
+  size_t cached_size() const { return cached_size_.load(std::memory_order_relaxed); }
+  size_t hit_count() const { return hit_count_.load(std::memory_order_relaxed); }
+  size_t miss_count() const { return miss_count_.load(std::memory_order_relaxed); }
+
+ private:
+  struct TrackShard {
+    SpinLock lock_;
+    // Key is the device address, value is the aligned size and stream id.
+    std::unordered_map<DeviceMemPtr, std::pair<size_t, uint32_t>> addrs_;
+  };
+  struct StreamCache {
+    SpinLock lock_;
+    // Key is the aligned size, value is the cached device addresses.
+    std::unordered_map<size_t, std::vector<DeviceMemPtr>> size_class_addrs_;
+    size_t cached_size_{0};
+  };
+
+  TrackShard &GetShard(const DeviceMemPtr &device_addr) {
+    return track_shards_[(reinterpret_cast<uintptr_t>(device_addr) / kDynamicMemAlignSize) % kMemBufCacheShardNum];
+  }
+
+  TrackShard track_shards_[kMemBufCacheShardNum];
+  StreamCache stream_caches_[kMemBufCacheMaxStreamNum];
+  std::atomic<size_t> cached_size_{0};
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+};
+
 // The main class of dynamic memory pool.
 class BACKEND_EXPORT DynamicMemPoolBestFit {
  public:
@@ -90,6 +178,11 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   // Release the real device memory.
   void ReleaseDeviceRes();
 
+  // Return the cached memory bufs of the stream to the best-fit index, which needs to be called when the stream is
+  // synchronized to keep the stream semantics of memory reuse.
+  void DrainMemBufCache(uint32_t stream_id);
+  void DrainAllMemBufCache();
+
   // Get the minimum memory unit size using for dynamic extend.
   size_t MemAllocUnitSize(bool from_persistent_mem = false) const;
   // Set the minimum memory unit size using for dynamic extend.
@@ -101,6 +194,15 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   size_t TotalIdleMemStatistics() const;
   size_t TotalEagerFreeMemStatistics() const;
   size_t UsedMemPeakStatistics() const;
+  // The size of memory bufs in the mem buf cache, which is also counted in the used memory.
+  size_t MemBufCacheStatistics() const { return mem_buf_cache_.cached_size(); }
+
+  // The fragmentation information of each memory block of the common pool, in the order of device address.
+  std::vector<MemFragmentationInfo> BlockFragmentationStatistics();
+  // The fragmentation information of each stream of the common pool.
+  std::map<uint32_t, MemFragmentationInfo> StreamFragmentationStatistics();
+  // The number of times the memory pool releases idle memory to defragment instead of being extended.
+  size_t DefragmentCountStatistics() const { return defragment_count_; }
 
   // Display the brief state information of memory block and memory buf.
   void DumpDynamicMemPoolStateInfo();
@@ -135,6 +237,13 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   virtual size_t FreeDeviceMemByEagerFree(const DeviceMemPtr addr, const size_t size) { return 0; }
   const size_t FreeIdleMemsByEagerFree();
 
+  // Whether to serve the small allocs by the lock free fast path of mem buf cache.
+  virtual const bool IsEnableMemBufCache() const { return false; }
+
+  // Whether to defragment the memory pool when the alloc fails only because of the fragmentation, which can be enabled
+  // by setting the env MS_DEV_ENABLE_MEM_DEFRAG=1.
+  virtual const bool IsEnableDefragment() const;
+
  private:
   // Find available memory buf from total pools by status, which contains idle and eager free.
   DeviceMemPtr FindAvailableMemBuf(size_t size, bool from_persistent_mem, uint32_t stream_id);
@@ -153,6 +262,19 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   DeviceMemPtr CreateMemBlockAndMemBuf(size_t size, bool from_persistent_mem, DeviceMemPtr source_addr,
                                        size_t source_size, DynamicMemBufStatus mem_buf_status, uint32_t stream_id);
 
+  // Judge whether the alloc fails only because of the fragmentation, which means the total idle memory of the stream
+  // in the pool of the alloc is enough but there isn't a continuous idle memory buf.
+  bool IsFragmentationOom(size_t size, const MemStatusManagerPtr &mem_mng, uint32_t stream_id);
+  // The used memory bufs can't be moved, so the pool is not compacted. Instead the physical memory of idle memory bufs
+  // is freed by the eager free routine if enabled, otherwise the memory blocks which are totally idle are released to
+  // the device, so that the memory block can be extended by continuous memory. The defragment count is increased only
+  // when some memory is released.
+  void DefragmentMemPool(const MemStatusManagerPtr &mem_mng, uint32_t stream_id);
+  // Release the totally idle memory blocks of the pool, return the released size.
+  size_t ReleaseIdleMemBlocks(const MemStatusManagerPtr &mem_mng, uint32_t stream_id, bool all_streams);
+  // Calculate the fragmentation information of the idle memory bufs in the memory block.
+  static MemFragmentationInfo GetMemBlockFragmentationInfo(const DynamicMemBlockPtr &mem_block);
+
   // Judge whether need split the memory buf by alloc size and memory buf size.
   bool IsSplit(size_t tensor_size, size_t mem_buf_size) const;
   // Split the memory buf by alloc size.
@@ -166,6 +288,10 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
 
   // Free memory inner with no lock, the caller need lock.
   void FreeTensorMemInner(const DeviceMemPtr &device_addr);
+  // Free the cached memory bufs inner with no lock, the caller need lock.
+  void FreeCachedMemBufsInner(const std::vector<DeviceMemPtr> &device_addrs);
+  // Whether the alloc can use the fast path of mem buf cache.
+  bool IsMemBufCacheable(size_t align_size, bool from_persistent_mem, bool need_recycle, uint32_t stream_id) const;
   // Combine the memory buf when memory free, to avoid the memory fragmentation.
   void CombineMemBuf(const DeviceMemPtr &device_addr, DynamicMemBufStatus origin_status,
                      DynamicMemBufStatus target_status);
@@ -196,6 +322,9 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   size_t config_unit_size_{kDynamicMemAllocUnitSize};
   // Flag for eager free routine. This flag set to false when initializing, and set to true when triggering oom.
   bool is_trigger_eager_free_{false};
+  // The size class cache in front of the best-fit index.
+  MemBufCache mem_buf_cache_;
+  size_t defragment_count_{0};
 };
 
 // Recording information for debugging the memory allocator.
@@ -75,6 +75,8 @@ enum class ProfilerEvent {
   kWaitKernelsInferFinish,
   kWaitKernelsResizeFinish,
   kWaitKernelsLaunchFinish,
+  kGradientBucketFill,
+  kGradientBucketLaunch,
 
   // Inner event is not counted in the total time.
   kKernelInferInner,
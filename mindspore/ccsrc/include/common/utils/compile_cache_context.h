@@ -38,6 +38,10 @@ constexpr char kRolePServer[] = "pserver_";
 constexpr char kRolePScheduler[] = "pscheduler_";
 constexpr char kGroupCkptFileName[] = "group.ckpt";
 constexpr char kDataQueueNameCacheFileName[] = "data_queue_name.json";
+// The meta of backend compile cache records the key the cache is built with, and the cache is missed if any field of
+// the key changes. Bump the version when the format of backend compile cache changes.
+constexpr char kBackendCompileCacheMetaSuffix[] = "_meta.json";
+constexpr char kBackendCompileCacheVersion[] = "1";
 
 struct CachedIOSizeInfo {
   std::string json_name;
@@ -103,6 +107,10 @@ class COMMON_EXPORT CompileCacheContext {
   void set_init_compile_cache(const bool &init) { init_compile_cache_ = init; }
   bool init_compile_cache() const { return init_compile_cache_; }
 
+  // The hash of the frontend compile cache file, which identifies the graph to be compiled by backend.
+  void SetFrontGraphCacheHash(const std::string &hash) { front_graph_cache_hash_ = hash; }
+  const std::string &FrontGraphCacheHash() const { return front_graph_cache_hash_; }
+
  private:
   CompileCacheContext() = default;
   ~CompileCacheContext() = default;
@@ -125,6 +133,7 @@ class COMMON_EXPORT CompileCacheContext {
   std::string compile_cache_dep_files_hash_ = "";
   bool has_cached_queue_name_{false};
   bool init_compile_cache_{false};
+  std::string front_graph_cache_hash_;
 };
 }  // namespace mindspore
 
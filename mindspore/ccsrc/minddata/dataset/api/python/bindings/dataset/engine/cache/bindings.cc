@@ -45,7 +45,11 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                     .def(py::init<>())
                     .def_readwrite("avg_cache_sz", &CacheServiceStat::avg_cache_sz)
                     .def_readwrite("num_mem_cached", &CacheServiceStat::num_mem_cached)
-                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached);
+                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached)
+                    .def_readwrite("num_compressed_cached", &CacheServiceStat::num_compressed_cached)
+                    .def_readwrite("num_hot_hit", &CacheServiceStat::num_hot_hit)
+                    .def_readwrite("num_warm_hit", &CacheServiceStat::num_warm_hit)
+                    .def_readwrite("num_cold_hit", &CacheServiceStat::num_cold_hit);
                 }));
 
 }  // namespace dataset
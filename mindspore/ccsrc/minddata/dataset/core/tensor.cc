@@ -63,7 +63,11 @@ namespace dataset {
 Tensor::Tensor(TensorShape shape, DataType type) : shape_(std::move(shape)), type_(type), data_(nullptr) {}
 
 Tensor::Tensor(Tensor &&other) noexcept
-    : shape_(std::move(other.shape_)), type_(other.type_), data_(other.data_), data_end_(other.data_end_) {
+    : shape_(std::move(other.shape_)),
+      type_(other.type_),
+      data_(other.data_),
+      data_end_(other.data_end_),
+      external_data_(std::move(other.external_data_)) {
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
@@ -85,6 +89,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     data_ = other.data_;
     data_end_ = other.data_end_;
     yuv_shape_ = std::move(other.yuv_shape_);
+    external_data_ = std::move(other.external_data_);
 #ifdef ENABLE_PYTHON
     if (type_.value() == DataType::DE_PYTHON) {
       py::gil_scoped_acquire gil_acquire;
@@ -151,6 +156,24 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateFromMemoryNoCopy(const TensorShape &shape, const DataType &type, const uchar *src,
+                                      std::shared_ptr<void> holder, TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(holder);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.known(), "Failed to create tensor, tensor shape is unknown.");
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(),
+                               "Failed to create tensor without copy, data type should be numeric, but got: " +
+                                 type.ToString());
+  *out = std::make_shared<Tensor>(shape, type);
+  CHECK_FAIL_RETURN_UNEXPECTED(out != nullptr, "Allocate memory failed.");
+  // the tensor only reads the external memory, the holder keeps it alive until the tensor is destroyed
+  (*out)->data_ = const_cast<uchar *>(src);
+  (*out)->data_end_ = (*out)->data_ + (*out)->SizeInBytes();
+  (*out)->external_data_ = std::move(holder);
+  return Status::OK();
+}
+
 Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src, const dsize_t &length,
                                 TensorPtr *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
@@ -458,6 +481,11 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Name: Destructor
 // Description: Destructor
 Tensor::~Tensor() {
+  if (external_data_ != nullptr) {  // the data is external memory which is not owned by the tensor
+    data_ = nullptr;
+    data_end_ = nullptr;
+    external_data_.reset();
+  }
 #ifdef ENABLE_PYTHON
   if (!static_cast<bool>(python_array_)) {  // the data is not np.ndarray from python layer
 #endif
@@ -642,6 +670,7 @@ void Tensor::Invalidate() {
   type_ = DataType(DataType::DE_UNKNOWN);
   data_ = nullptr;
   data_end_ = nullptr;
+  external_data_.reset();
 #ifdef ENABLE_PYTHON
   if (type_.value() == DataType::DE_PYTHON) {
     py::gil_scoped_acquire gil_acquire;
@@ -107,6 +107,16 @@ class DATASET_API Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor which wraps the external memory without copying the data.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor, only numeric types are supported
+  /// \param[in] src pointer to the source data, which should be valid as long as the holder is alive
+  /// \param[in] holder the owner of the source data, it is released when the tensor is destroyed
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromMemoryNoCopy(const TensorShape &shape, const DataType &type, const uchar *src,
+                                       std::shared_ptr<void> holder, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -860,6 +870,9 @@ class DATASET_API Tensor {
   /// shape for interpretation of YUV image
   std::vector<uint32_t> yuv_shape_;
 
+  /// Hold the external memory which data_ points to without memcpy cost
+  std::shared_ptr<void> external_data_;
+
 #ifdef ENABLE_PYTHON
   /// Store python dictionary wrapper
   py::object python_dict_;
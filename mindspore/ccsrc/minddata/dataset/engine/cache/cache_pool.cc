@@ -15,18 +15,64 @@
  */
 #include "minddata/dataset/engine/cache/cache_pool.h"
 
+#include <zlib.h>
+
+#include <limits>
+
 #include "minddata/dataset/engine/cache/cache_server.h"
 #include "minddata/dataset/util/services.h"
 #include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// The rows read from the warm or the cold tier this many times are promoted to the hot tier
+constexpr uint32_t kPromoteFreq = 2;
+// The number of rows the demotion clock visits at most in one pass
+constexpr int64_t kMaxDemoteScan = 4096;
+// The compressed copy is kept only if it is smaller than this ratio of the raw row
+constexpr double kMaxCompressRatio = 0.8;
+// The default ratio of the memory cap used by the hot tier, the rest is left to the compressed rows
+constexpr float kDftHotMemRatio = 0.5;
+}  // namespace
+
 CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr),
+      tiering_(common::GetEnv("MS_DEV_DATASET_CACHE_TIERING") == "1"),
+      hot_mem_limit_(0),
+      hot_bytes_(0),
+      warm_bytes_(0),
+      hot_hit_(0),
+      warm_hit_(0),
+      cold_hit_(0),
+      clock_hand_(-1) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
   min_avail_mem_ = static_cast<uint64_t>(CacheServerHW::GetTotalSystemMemory() * (1.0 - mp_->GetMemoryCapRatio()));
+  if (tiering_) {
+    float hot_ratio = kDftHotMemRatio;
+    std::string env_ratio = common::GetEnv("MS_DEV_DATASET_CACHE_HOT_RATIO");
+    if (!env_ratio.empty()) {
+      try {
+        hot_ratio = std::stof(env_ratio);
+      } catch (const std::exception &e) {
+        MS_LOG(WARNING) << "Invalid MS_DEV_DATASET_CACHE_HOT_RATIO: " << env_ratio << ", use the default value.";
+        hot_ratio = kDftHotMemRatio;
+      }
+      if (hot_ratio <= 0 || hot_ratio > 1) {
+        MS_LOG(WARNING) << "MS_DEV_DATASET_CACHE_HOT_RATIO should be in (0, 1], but got: " << env_ratio
+                        << ", use the default value.";
+        hot_ratio = kDftHotMemRatio;
+      }
+    }
+    hot_mem_limit_ = static_cast<uint64_t>(mp_->GetAvailableMemory() * hot_ratio);
+    MS_LOG(INFO) << "CachePool tiering is enabled, the hot tier can use up to " << hot_mem_limit_ << " bytes.";
+  }
 }
 
 Status CachePool::DoServiceStart() {
@@ -79,6 +125,28 @@ Status CachePool::DoServiceStop() {
 
 CachePool::~CachePool() noexcept { (void)ServiceStop(); }
 
+Status CachePool::AllocateMemory(size_t sz, pointer *p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
+  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
+  // than the lower bound. (The default is 20% of physical RAM)
+  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
+    MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
+                    << ". The cache server will not cache any more data.";
+    return STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
+  }
+  Status rc = mp_->Allocate(sz, reinterpret_cast<void **>(p));
+  // Adjust the soft limit and usage counting when every 100M memory are used.
+  if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
+    soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
+    temp_mem_usage_ = 0;
+  }
+  if (rc.IsOk()) {
+    temp_mem_usage_ += sz;
+  }
+  return rc;
+}
+
 Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf) {
   DataLocator bl;
   Status rc;
@@ -88,23 +156,16 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
-  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
-  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
-  // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
-    MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
-                    << ". The cache server will not cache any more data.";
-    rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
+  if (tiering_ && !ReserveHotBytes(sz)) {
+    // The hot tier is full. The row waits in the warm or the cold tier until it is read often enough.
+    rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Hot tier is full.");
   } else {
-    rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
-    // Adjust the soft limit and usage counting when every 100M memory are used.
-    if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
-      soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
-      temp_mem_usage_ = 0;
+    rc = AllocateMemory(sz, &bl.ptr);
+    if (rc.IsError() && tiering_) {
+      hot_bytes_ -= sz;
     }
   }
   if (rc.IsOk()) {
-    temp_mem_usage_ += sz;
     // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
     if (CacheServerHW::numa_enabled()) {
       auto &cs = CacheServer::GetInstance();
@@ -125,15 +186,21 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       pos += v.GetSize();
     }
     if (rc.IsError()) {
+      if (tiering_) {
+        hot_bytes_ -= sz;
+      }
       mp_->Deallocate(bl.ptr);
       bl.ptr = nullptr;
       return rc;
     }
   } else if (rc == StatusCode::kMDOutOfMemory) {
-    // If no memory, write to disk.
-    if (sm_ != nullptr) {
+    if (tiering_) {
+      RETURN_IF_NOT_OK(PlaceWarmOrCold(buf, &bl));
+    } else if (sm_ != nullptr) {
+      // If no memory, write to disk.
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
       RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      bl.on_disk = true;
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -150,6 +217,11 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   }
   // Duplicate key is treated as error and we will also free the memory.
   if (rc.IsError() && bl.ptr != nullptr) {
+    if (tiering_ && bl.IsHot()) {
+      hot_bytes_ -= sz;
+    } else if (bl.IsWarm()) {
+      warm_bytes_ -= bl.compressed_sz;
+    }
     mp_->Deallocate(bl.ptr);
     bl.ptr = nullptr;
     return rc;
@@ -157,28 +229,248 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   return rc;
 }
 
-Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
+bool CachePool::ReserveHotBytes(size_t sz) {
+  // The check and the reservation are done in one step, so the concurrent inserts never exceed the limit together.
+  uint64_t hot_bytes = hot_bytes_.load();
+  do {
+    if (hot_bytes + sz > hot_mem_limit_) {
+      return false;
+    }
+  } while (!hot_bytes_.compare_exchange_weak(hot_bytes, hot_bytes + sz));
+  return true;
+}
+
+Status CachePool::PlaceWarmOrCold(const std::vector<ReadableSlice> &buf, DataLocator *bl) {
+  RETURN_UNEXPECTED_IF_NULL(bl);
+  std::string compressed;
+  // Only keep the compressed copy in memory if it saves a reasonable amount of memory.
+  if (Compress(buf, bl->sz, &compressed).IsOk() && compressed.size() < bl->sz * kMaxCompressRatio) {
+    pointer p = nullptr;
+    if (AllocateMemory(compressed.size(), &p).IsOk()) {
+      WritableSlice dest(p, compressed.size());
+      Status rc = WritableSlice::Copy(&dest, ReadableSlice(compressed.data(), compressed.size()));
+      if (rc.IsError()) {
+        mp_->Deallocate(p);
+        return rc;
+      }
+      bl->ptr = p;
+      bl->compressed_sz = compressed.size();
+      warm_bytes_ += bl->compressed_sz;
+      return Status::OK();
+    }
+  }
+  bl->ptr = nullptr;
+  bl->compressed_sz = 0;
+  // The spill file is log structured and never rewritten, so a row which was spilled before can be demoted for free.
+  if (bl->on_disk) {
+    return Status::OK();
+  }
+  if (sm_ == nullptr) {
+    RETURN_STATUS_OOM("No enough storage for cache server to cache data.");
+  }
+  MS_LOG(DEBUG) << "Spill to disk ... " << bl->sz << " bytes.";
+  RETURN_IF_NOT_OK(sm_->Write(&bl->storage_key, buf));
+  bl->on_disk = true;
+  return Status::OK();
+}
+
+Status CachePool::Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::string *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  z_stream strm{};
+  CHECK_FAIL_RETURN_UNEXPECTED(deflateInit(&strm, Z_BEST_SPEED) == Z_OK, "Failed to initialize zlib.");
+  out->resize(deflateBound(&strm, sz));
+  strm.next_out = reinterpret_cast<Bytef *>(&(*out)[0]);
+  strm.avail_out = static_cast<uInt>(out->size());
+  int ret = Z_OK;
+  for (auto &v : buf) {
+    if (v.GetSize() > std::numeric_limits<uInt>::max()) {
+      ret = Z_BUF_ERROR;
+      break;
+    }
+    strm.next_in = reinterpret_cast<Bytef *>(const_cast<void *>(v.GetPointer()));
+    strm.avail_in = static_cast<uInt>(v.GetSize());
+    ret = deflate(&strm, Z_NO_FLUSH);
+    if (ret != Z_OK) {
+      break;
+    }
+  }
+  if (ret == Z_OK) {
+    ret = deflate(&strm, Z_FINISH);
+  }
+  out->resize(strm.total_out);
+  (void)deflateEnd(&strm);
+  CHECK_FAIL_RETURN_UNEXPECTED(ret == Z_STREAM_END, "Failed to compress the row, zlib error: " + std::to_string(ret));
+  return Status::OK();
+}
+
+Status CachePool::Decompress(const_pointer src, size_t compressed_sz, WritableSlice *dest, size_t sz) {
   RETURN_UNEXPECTED_IF_NULL(dest);
-  auto r = tree_->Search(key);
-  if (r.second) {
+  if (dest->GetSize() < sz) {
+    RETURN_STATUS_UNEXPECTED("Destination buffer too small. Expect at least " + std::to_string(sz) +
+                             " but length = " + std::to_string(dest->GetSize()));
+  }
+  uLongf dest_len = sz;
+  int ret = uncompress(reinterpret_cast<Bytef *>(dest->GetMutablePointer()), &dest_len, src, compressed_sz);
+  CHECK_FAIL_RETURN_UNEXPECTED(ret == Z_OK && dest_len == sz,
+                               "Failed to decompress the row, zlib error: " + std::to_string(ret));
+  return Status::OK();
+}
+
+Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  bool promote = false;
+  size_t sz = 0;
+  {
+    auto r = tree_->Search(key);
+    if (r.second) {
+      auto &it = r.first;
+      if (it->IsHot()) {
+        ReadableSlice src(it->ptr, it->sz);
+        RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      } else if (it->IsWarm()) {
+        RETURN_IF_NOT_OK(Decompress(it->ptr, it->compressed_sz, dest, it->sz));
+      } else if (sm_ != nullptr) {
+        size_t expectedLength = 0;
+        RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
+        if (expectedLength != it->sz) {
+          MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
+                        << " Internal key: " << key << "\n";
+          RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+        }
+      }
+      sz = it->sz;
+      if (bytesRead != nullptr) {
+        *bytesRead = sz;
+      }
+      promote = tiering_ && !it->IsHot() && it->freq >= kPromoteFreq;
+    } else {
+      RETURN_STATUS_UNEXPECTED("Key not found");
+    }
+  }
+  // The leaf of the tree must be unlocked before the row is moved.
+  if (promote) {
+    RETURN_IF_NOT_OK(Promote(key, ReadableSlice(dest->GetPointer(), sz)));
+  }
+  return Status::OK();
+}
+
+Status CachePool::Promote(key_type key, const ReadableSlice &src) {
+  // Skip the promotion if another reader is moving the rows, the row will be promoted on its next access.
+  std::unique_lock<std::mutex> lock(tier_mux_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return Status::OK();
+  }
+  size_t sz = src.GetSize();
+  if (!ReserveHotBytes(sz)) {
+    // The hot rows may be demoted by others meanwhile, so the bytes needed never go below zero.
+    uint64_t hot_bytes = hot_bytes_.load();
+    size_t bytes_needed = hot_bytes + sz > hot_mem_limit_ ? hot_bytes + sz - hot_mem_limit_ : sz;
+    size_t bytes_freed = 0;
+    RETURN_IF_NOT_OK(Demote(bytes_needed, &bytes_freed));
+    if (!ReserveHotBytes(sz)) {
+      // The hot rows are all accessed more frequently than this one so far.
+      return Status::OK();
+    }
+  }
+  DataLocator bl;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second || r.first->IsHot()) {
+      hot_bytes_ -= sz;
+      return Status::OK();
+    }
+    bl = *r.first;
+  }
+  pointer p = nullptr;
+  if (AllocateMemory(sz, &p).IsError()) {
+    hot_bytes_ -= sz;
+    return Status::OK();
+  }
+  WritableSlice dest(p, sz);
+  Status rc = WritableSlice::Copy(&dest, src);
+  if (rc.IsError()) {
+    hot_bytes_ -= sz;
+    mp_->Deallocate(p);
+    return rc;
+  }
+  pointer old_ptr = bl.ptr;
+  size_t old_compressed_sz = bl.compressed_sz;
+  bl.ptr = p;
+  bl.compressed_sz = 0;
+  if (CacheServerHW::numa_enabled()) {
+    auto &cs = CacheServer::GetInstance();
+    bl.node_id = mp_->FindNode(bl.ptr);
+    bl.node_hit = (bl.node_id == cs.GetHWControl()->GetMyNode());
+  }
+  // The readers hold the leaf lock while they copy the row, so the old buffer is no longer used once it is swapped.
+  (void)tree_->DoUpdate(key, bl);
+  if (old_ptr != nullptr) {
+    mp_->Deallocate(old_ptr);
+    warm_bytes_ -= old_compressed_sz;
+  }
+  return Status::OK();
+}
+
+Status CachePool::Demote(size_t bytes_needed, size_t *bytes_freed) {
+  RETURN_UNEXPECTED_IF_NULL(bytes_freed);
+  *bytes_freed = 0;
+  key_type start = clock_hand_;
+  if (!tree_->Search(start).second) {
+    // The clock goes back to the first row.
+    tree_->LockShared();
+    bool empty = (tree_->begin() == tree_->end());
+    if (!empty) {
+      start = tree_->begin().key();
+    }
+    tree_->Unlock();
+    if (empty) {
+      return Status::OK();
+    }
+  }
+  std::vector<key_type> victims;
+  {
+    auto r = tree_->Search(start);
+    if (!r.second) {
+      return Status::OK();
+    }
     auto &it = r.first;
-    if (it->ptr != nullptr) {
-      ReadableSlice src(it->ptr, it->sz);
-      RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
-    } else if (sm_ != nullptr) {
-      size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
-                      << " Internal key: " << key << "\n";
-        RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+    size_t victim_bytes = 0;
+    for (int64_t scanned = 0; it != tree_->end() && scanned < kMaxDemoteScan && victim_bytes < bytes_needed;
+         ++it, ++scanned) {
+      auto &locator = it.value();
+      if (!locator.IsHot()) {
+        continue;
+      }
+      auto freq = locator.freq.load();
+      if (freq > 0) {
+        (void)locator.freq.compare_exchange_strong(freq, freq / 2);
+        continue;
       }
+      victims.push_back(it.key());
+      victim_bytes += locator.sz;
     }
-    if (bytesRead != nullptr) {
-      *bytesRead = it->sz;
+    clock_hand_ = (it != tree_->end()) ? it.key() : -1;
+  }
+  for (auto key : victims) {
+    DataLocator bl;
+    {
+      auto r = tree_->Search(key);
+      if (!r.second || !r.first->IsHot()) {
+        continue;
+      }
+      bl = *r.first;
     }
-  } else {
-    RETURN_STATUS_UNEXPECTED("Key not found");
+    // The buffer of a hot row is only released with tier_mux_ held, so it is safe to read without the leaf lock.
+    pointer old_ptr = bl.ptr;
+    Status rc = PlaceWarmOrCold({ReadableSlice(old_ptr, bl.sz)}, &bl);
+    if (rc == StatusCode::kMDOutOfMemory) {
+      break;
+    }
+    RETURN_IF_NOT_OK(rc);
+    (void)tree_->DoUpdate(key, bl);
+    mp_->Deallocate(old_ptr);
+    hot_bytes_ -= bl.sz;
+    *bytes_freed += bl.sz;
   }
   return Status::OK();
 }
@@ -191,6 +483,10 @@ Path CachePool::GetSpillPath() const {
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
   CacheStat cs{-1, -1, 0, 0, 0, 0};
+  cs.num_compressed_cached = 0;
+  cs.num_hot_hit = hot_hit_;
+  cs.num_warm_hit = warm_hit_;
+  cs.num_cold_hit = cold_hit_;
   int64_t total_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
@@ -198,8 +494,10 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
       total_sz += it.value().sz;
-      if (it.value().ptr != nullptr) {
+      if (it.value().IsHot()) {
         ++cs.num_mem_cached;
+      } else if (it.value().IsWarm()) {
+        ++cs.num_compressed_cached;
       } else {
         ++cs.num_disk_cached;
       }
@@ -218,7 +516,7 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   }
   if (total_sz > 0) {
     // integer arithmetic. NO need to cast to float or double.
-    cs.average_cache_sz = total_sz / (cs.num_disk_cached + cs.num_mem_cached);
+    cs.average_cache_sz = total_sz / (cs.num_disk_cached + cs.num_mem_cached + cs.num_compressed_cached);
     if (cs.average_cache_sz == 0) {
       cs.average_cache_sz = 1;
     }
@@ -228,16 +526,25 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
 }
 
 Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb,
-                                 flatbuffers::Offset<DataLocatorMsg> *out) const {
+                                 flatbuffers::Offset<DataLocatorMsg> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
+    ++it->freq;
+    if (it->IsHot()) {
+      ++hot_hit_;
+    } else if (it->IsWarm()) {
+      ++warm_hit_;
+    } else {
+      ++cold_hit_;
+    }
     DataLocatorMsgBuilder bld(*fbb);
     bld.add_key(key);
     bld.add_size(it->sz);
     bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    // A zero address makes the row fetched by Read, which can serve all the tiers.
+    bld.add_addr(tiering_ || !it->IsHot() ? 0 : reinterpret_cast<int64_t>(it->ptr));
     auto offset = bld.Finish();
     *out = offset;
   } else {
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -45,22 +46,56 @@ class CachePool : public Service {
   using const_reference = const base_type &;
   using value_allocator = Allocator<base_type>;
 
-  // An internal class to locate the whereabouts of a backed up buffer which can be either in
+  // An internal class to locate the whereabouts of a backed up buffer which can be either in memory (raw or
+  // compressed) or on disk.
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator()
+        : ptr(nullptr),
+          sz(0),
+          node_id(0),
+          node_hit(false),
+          storage_key(0),
+          compressed_sz(0),
+          on_disk(false),
+          freq(0) {}
     ~DataLocator() = default;
-    DataLocator(const DataLocator &other) = default;
-    DataLocator &operator=(const DataLocator &other) = default;
+    DataLocator(const DataLocator &other)
+        : ptr(other.ptr),
+          sz(other.sz),
+          node_id(other.node_id),
+          node_hit(other.node_hit),
+          storage_key(other.storage_key),
+          compressed_sz(other.compressed_sz),
+          on_disk(other.on_disk),
+          freq(other.freq.load()) {}
+    DataLocator &operator=(const DataLocator &other) {
+      if (&other != this) {
+        ptr = other.ptr;
+        sz = other.sz;
+        node_id = other.node_id;
+        node_hit = other.node_hit;
+        storage_key = other.storage_key;
+        compressed_sz = other.compressed_sz;
+        on_disk = other.on_disk;
+        freq = other.freq.load();
+      }
+      return *this;
+    }
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
       storage_key = other.storage_key;
+      compressed_sz = other.compressed_sz;
+      on_disk = other.on_disk;
+      freq = other.freq.load();
       other.ptr = nullptr;
       other.sz = 0;
       other.storage_key = 0;
+      other.compressed_sz = 0;
+      other.on_disk = false;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
@@ -69,17 +104,27 @@ class CachePool : public Service {
         node_id = other.node_id;
         node_hit = other.node_hit;
         storage_key = other.storage_key;
+        compressed_sz = other.compressed_sz;
+        on_disk = other.on_disk;
+        freq = other.freq.load();
         other.ptr = nullptr;
         other.sz = 0;
         other.storage_key = 0;
+        other.compressed_sz = 0;
+        other.on_disk = false;
       }
       return *this;
     }
+    bool IsHot() const { return ptr != nullptr && compressed_sz == 0; }
+    bool IsWarm() const { return ptr != nullptr && compressed_sz > 0; }
     pointer ptr;
     size_t sz;
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
     StorageManager::key_type storage_key;
+    size_t compressed_sz;        // non-zero if ptr points to the compressed data
+    bool on_disk;                // storage_key is valid, the copy on disk is kept even if the buffer is promoted
+    std::atomic<uint32_t> freq;  // access count, which is halved every time the demotion clock passes by
   };
 
   using data_index = BPlusTree<int64_t, DataLocator>;
@@ -96,6 +141,10 @@ class CachePool : public Service {
     int64_t average_cache_sz;
     int64_t num_numa_hit;
     std::vector<key_type> gap;
+    int64_t num_compressed_cached;
+    int64_t num_hot_hit;
+    int64_t num_warm_hit;
+    int64_t num_cold_hit;
   };
 
   /// \brief Constructor
@@ -127,11 +176,14 @@ class CachePool : public Service {
   /// \param[out] dest The cached buffer will be copied to this destination represented by a WritableSlice
   /// \param[out] bytesRead Optional. Number of bytes read.
   /// \return Error code
-  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
+  /// \note If tiering is on, a row which is read frequently from the compressed or the disk tier is promoted.
+  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr);
 
-  /// \brief Serialize a DataLocator
+  /// \brief Serialize a DataLocator, which also counts the access of the row.
+  /// \note If tiering is on, the address is not given out since the buffer can be moved to another tier at any time,
+  /// the row has to be fetched by Read.
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
-                        flatbuffers::Offset<DataLocatorMsg> *) const;
+                        flatbuffers::Offset<DataLocatorMsg> *);
 
   /// \brief Get statistics.
   /// \return CacheStat object
@@ -143,7 +195,31 @@ class CachePool : public Service {
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
 
+  /// \brief Whether the rows are spread over the hot, warm (compressed in memory) and cold (on disk) tiers, which is
+  /// turned on by the env MS_DEV_DATASET_CACHE_TIERING=1.
+  bool IsTieringEnabled() const { return tiering_; }
+
  private:
+  // Allocate memory from the pool within the soft limit of memory usage
+  Status AllocateMemory(size_t sz, pointer *p);
+
+  // Reserve the bytes of a row in the hot tier, false if the hot tier is full
+  bool ReserveHotBytes(size_t sz);
+
+  // Store a buffer in the warm tier if it compresses well, otherwise in the cold tier. The locator is updated.
+  Status PlaceWarmOrCold(const std::vector<ReadableSlice> &buf, DataLocator *bl);
+
+  // Move a row read from the warm or the cold tier to the hot tier, the rows rarely accessed are demoted for it.
+  Status Promote(key_type key, const ReadableSlice &src);
+
+  // Demote the hot rows until the given bytes are freed. The rows are visited like a clock, the access count of a
+  // visited row is halved and the row is demoted once its count drops to zero. It is called with tier_mux_ held.
+  Status Demote(size_t bytes_needed, size_t *bytes_freed);
+
+  static Status Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::string *out);
+
+  static Status Decompress(const_pointer src, size_t compressed_sz, WritableSlice *dest, size_t sz);
+
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
   const std::string subfolder_;
@@ -154,6 +230,16 @@ class CachePool : public Service {
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
   const int kMemoryCapAdjustInterval = 104857600;
+
+  bool tiering_;
+  uint64_t hot_mem_limit_;             // the upper bound of the bytes of hot rows
+  std::atomic<uint64_t> hot_bytes_;    // the bytes of hot rows
+  std::atomic<uint64_t> warm_bytes_;   // the bytes of compressed rows
+  std::atomic<int64_t> hot_hit_;       // the number of accesses served by each tier
+  std::atomic<int64_t> warm_hit_;
+  std::atomic<int64_t> cold_hit_;
+  std::mutex tier_mux_;                // serializes the moves of rows between the tiers
+  key_type clock_hand_;                // the key where the next demotion starts from
 };
 }  // namespace dataset
 }  // namespace mindspore
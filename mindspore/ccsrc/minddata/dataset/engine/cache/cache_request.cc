@@ -36,6 +36,17 @@ Status BaseRequest::Wait() {
   RETURN_IF_NOT_OK(PostReply());
   return Status::OK();
 }
+std::string GetTierHitRate(const CacheServiceStat &stat) {
+  int64_t total_hit = stat.num_hot_hit + stat.num_warm_hit + stat.num_cold_hit;
+  if (total_hit <= 0) {
+    return "n/a";
+  }
+  const int64_t kPercent = 100;
+  return std::to_string(stat.num_hot_hit * kPercent / total_hit) + "/" +
+         std::to_string(stat.num_warm_hit * kPercent / total_hit) + "/" +
+         std::to_string(stat.num_cold_hit * kPercent / total_hit);
+}
+
 Status CacheRowRequest::SerializeCacheRowRequest(const CacheClient *cc, const TensorRow &row) {
   CHECK_FAIL_RETURN_UNEXPECTED(row.size() > 0, "Empty tensor row");
   CHECK_FAIL_RETURN_UNEXPECTED(cc->SupportLocalClient() == support_local_bypass_, "Local bypass mismatch");
@@ -304,6 +315,10 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_compressed_cached = msg->num_compressed_cached();
+  stat_.num_hot_hit = msg->num_hot_hit();
+  stat_.num_warm_hit = msg->num_warm_hit();
+  stat_.num_cold_hit = msg->num_cold_hit();
   return Status::OK();
 }
 
@@ -332,6 +347,10 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.num_compressed_cached = current_session_info->stats()->num_compressed_cached();
+    stats.num_hot_hit = current_session_info->stats()->num_hot_hit();
+    stats.num_warm_hit = current_session_info->stats()->num_warm_hit();
+    stats.num_cold_hit = current_session_info->stats()->num_cold_hit();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
@@ -45,6 +45,10 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_compressed_cached;
+  int64_t num_hot_hit;
+  int64_t num_warm_hit;
+  int64_t num_cold_hit;
 };
 
 struct CacheServerCfgInfo {
@@ -53,6 +57,11 @@ struct CacheServerCfgInfo {
   std::string spill_dir;
 };
 
+/// \brief Format the share of the rows fetched from the hot, the warm and the cold tier as "hot/warm/cold" in percent
+/// \param[in] stat The statistics of a cache
+/// \return The formatted hit rates, or "n/a" if no row has been fetched
+std::string GetTierHitRate(const CacheServiceStat &stat);
+
 /// \brief Info structure ListSessionsRequest
 struct SessionCacheInfo {
   session_id_type session_id;
@@ -37,6 +37,7 @@ constexpr int64_t field_width_thirteen = 13;
 constexpr int64_t field_width_fourteen = 14;
 constexpr int64_t field_width_sixteen = 16;
 constexpr int64_t field_width_eighteen = 18;
+constexpr int64_t field_width_twenty = 20;
 
 namespace mindspore {
 namespace dataset {
@@ -488,6 +489,29 @@ Status CachePerfRun::StartPipelines() {
   return Status::OK();
 }
 
+Status CachePerfRun::PrintCacheStat() {
+  CacheServiceStat stat{};
+  RETURN_IF_NOT_OK(cc_->GetStat(&stat));
+
+  std::cout << "Get statistics for this session:\n";
+  std::cout << std::setw(field_width_twelve) << "Mem cached" << std::setw(field_width_twelve) << "Disk cached"
+            << std::setw(field_width_sixteen) << "Avg cache size" << std::setw(field_width_ten) << "Numa hit"
+            << std::setw(field_width_twelve) << "Compressed" << std::setw(field_width_twenty) << "Hit% hot/warm/cold"
+            << std::endl;
+  std::string stat_mem_cached = (stat.num_mem_cached == 0) ? "n/a" : std::to_string(stat.num_mem_cached);
+  std::string stat_disk_cached = (stat.num_disk_cached == 0) ? "n/a" : std::to_string(stat.num_disk_cached);
+  std::string stat_avg_cached = (stat.avg_cache_sz == 0) ? "n/a" : std::to_string(stat.avg_cache_sz);
+  std::string stat_numa_hit = (stat.num_numa_hit == 0) ? "n/a" : std::to_string(stat.num_numa_hit);
+  std::string stat_compressed_cached =
+    (stat.num_compressed_cached == 0) ? "n/a" : std::to_string(stat.num_compressed_cached);
+
+  std::cout << std::setw(field_width_twelve) << stat_mem_cached << std::setw(field_width_twelve) << stat_disk_cached
+            << std::setw(field_width_sixteen) << stat_avg_cached << std::setw(field_width_ten) << stat_numa_hit
+            << std::setw(field_width_twelve) << stat_compressed_cached << std::setw(field_width_twenty)
+            << GetTierHitRate(stat) << std::endl;
+  return Status::OK();
+}
+
 Status CachePerfRun::Cleanup() {
   // Destroy the cache. We no longer need it around.
   RETURN_IF_NOT_OK(cc_->DestroyCache());
@@ -566,20 +590,7 @@ Status CachePerfRun::Run() {
     return rc;
   }
 
-  CacheServiceStat stat{};
-  RETURN_IF_NOT_OK(cc_->GetStat(&stat));
-
-  std::cout << "Get statistics for this session:\n";
-  std::cout << std::setw(field_width_twelve) << "Mem cached" << std::setw(field_width_twelve) << "Disk cached"
-            << std::setw(field_width_sixteen) << "Avg cache size" << std::setw(field_width_ten) << "Numa hit"
-            << std::endl;
-  std::string stat_mem_cached = (stat.num_mem_cached == 0) ? "n/a" : std::to_string(stat.num_mem_cached);
-  std::string stat_disk_cached = (stat.num_disk_cached == 0) ? "n/a" : std::to_string(stat.num_disk_cached);
-  std::string stat_avg_cached = (stat.avg_cache_sz == 0) ? "n/a" : std::to_string(stat.avg_cache_sz);
-  std::string stat_numa_hit = (stat.num_numa_hit == 0) ? "n/a" : std::to_string(stat.num_numa_hit);
-
-  std::cout << std::setw(12) << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
-            << std::setw(10) << stat_numa_hit << std::endl;
+  RETURN_IF_NOT_OK(PrintCacheStat());
 
   // Toggle write mode off since the rest are just read only.
   // Simplest way is call this special internal function.
@@ -606,6 +617,8 @@ Status CachePerfRun::Run() {
     std::cout << "Epoch " << epoch_num
               << " (read phase) per pipeline per worker summary. Buffer size = " << cc_->GetPrefetchSize() << std::endl;
     PrintEpochSummary();
+    // The rows move between the tiers of cache server while they are fetched
+    RETURN_IF_NOT_OK(PrintCacheStat());
     ++epoch_num;
   }
 
@@ -93,6 +93,7 @@ class CachePerfRun {
   Status GetSession();
   Status ListenToPipeline(int32_t workerId);
   void PrintEpochSummary() const;
+  Status PrintCacheStat();
   Status StartPipelines();
   Status Cleanup();
   int32_t SanityCheck(std::map<int32_t, int32_t> seen_opts);
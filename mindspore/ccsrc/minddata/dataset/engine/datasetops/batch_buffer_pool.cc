@@ -0,0 +1,91 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/batch_buffer_pool.h"
+
+#include <iterator>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+Status BatchBufferPool::Acquire(uint64_t size, std::shared_ptr<uint8_t> *buffer) {
+  RETURN_UNEXPECTED_IF_NULL(buffer);
+  std::unique_ptr<uint8_t[]> data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = free_buffers_.find(size);
+    if (iter != free_buffers_.end() && !iter->second.empty()) {
+      data = std::move(iter->second.back());
+      iter->second.pop_back();
+      cached_bytes_ -= size;
+      ++hit_count_;
+    }
+  }
+  if (data == nullptr) {
+    // allocate at least one byte, so that the empty tensors also have a valid buffer
+    data.reset(new (std::nothrow) uint8_t[size > 0 ? size : 1]);
+    CHECK_FAIL_RETURN_UNEXPECTED(data != nullptr, "Batch: failed to allocate buffer of size: " + std::to_string(size));
+  }
+  // the buffer is freed directly if the pool has been destroyed when the tensor is released
+  std::weak_ptr<BatchBufferPool> weak_pool = weak_from_this();
+  *buffer = std::shared_ptr<uint8_t>(data.release(), [weak_pool, size](uint8_t *ptr) {
+    auto pool = weak_pool.lock();
+    if (pool != nullptr) {
+      pool->Release(size, ptr);
+    } else {
+      delete[] ptr;
+    }
+  });
+  return Status::OK();
+}
+
+void BatchBufferPool::Release(uint64_t size, uint8_t *data) {
+  std::unique_ptr<uint8_t[]> buffer(data);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size > max_cached_bytes_) {
+    return;
+  }
+  // the shape of batch changes, e.g. the last batch or the padded batch, drop the buffers of other sizes first
+  for (auto iter = free_buffers_.begin(); iter != free_buffers_.end() && cached_bytes_ + size > max_cached_bytes_;) {
+    if (iter->first == size) {
+      ++iter;
+      continue;
+    }
+    while (!iter->second.empty() && cached_bytes_ + size > max_cached_bytes_) {
+      iter->second.pop_back();
+      cached_bytes_ -= iter->first;
+    }
+    iter = iter->second.empty() ? free_buffers_.erase(iter) : std::next(iter);
+  }
+  if (cached_bytes_ + size > max_cached_bytes_) {
+    return;
+  }
+  free_buffers_[size].emplace_back(std::move(buffer));
+  cached_bytes_ += size;
+}
+
+uint64_t BatchBufferPool::CachedBytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cached_bytes_;
+}
+
+uint64_t BatchBufferPool::HitCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+}  // namespace dataset
+}  // namespace mindspore
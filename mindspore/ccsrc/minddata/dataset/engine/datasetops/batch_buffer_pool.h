@@ -0,0 +1,66 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BUFFER_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BUFFER_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A pool of the output buffers of BatchOp. The buffer of a batched tensor is given back to the pool when the
+/// tensor is destroyed, so the batches of the same shape reuse the memory instead of allocating it every time.
+class BatchBufferPool : public std::enable_shared_from_this<BatchBufferPool> {
+ public:
+  /// \brief Constructor
+  /// \param[in] max_cached_bytes The upper limit of the bytes kept by the pool, the buffers given back beyond the
+  ///     limit are freed.
+  explicit BatchBufferPool(uint64_t max_cached_bytes) : max_cached_bytes_(max_cached_bytes) {}
+
+  ~BatchBufferPool() = default;
+
+  BatchBufferPool(const BatchBufferPool &) = delete;
+  BatchBufferPool &operator=(const BatchBufferPool &) = delete;
+
+  /// \brief Take a buffer of the given size from the pool, a new one is allocated if there is no free buffer.
+  /// \param[in] size The size of buffer in bytes.
+  /// \param[out] buffer The buffer, which goes back to the pool when the last reference is released.
+  /// \return Status The status code returned
+  Status Acquire(uint64_t size, std::shared_ptr<uint8_t> *buffer);
+
+  /// \brief The bytes of the free buffers kept by the pool.
+  uint64_t CachedBytes();
+
+  /// \brief The number of buffers reused so far.
+  uint64_t HitCount();
+
+ private:
+  void Release(uint64_t size, uint8_t *data);
+
+  std::mutex mutex_;
+  uint64_t max_cached_bytes_;
+  uint64_t cached_bytes_ = 0;
+  uint64_t hit_count_ = 0;
+  std::unordered_map<uint64_t, std::vector<std::unique_ptr<uint8_t[]>>> free_buffers_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_BUFFER_POOL_H_
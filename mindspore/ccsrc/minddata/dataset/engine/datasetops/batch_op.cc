@@ -15,6 +15,9 @@
  */
 #include "minddata/dataset/engine/datasetops/batch_op.h"
 
+#include <cmath>
+#include <future>
+#include <limits>
 #include <utility>
 
 #include "utils/ms_utils.h"
@@ -27,6 +30,13 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// the upper limit of the free buffers kept by the pool of batch
+constexpr uint64_t kMaxCachedBatchBytes = 1ULL << 30;
+// the columns are copied in parallel only if the batch is large enough to pay for the threads
+constexpr uint64_t kParallelBatchCopyBytes = 4ULL << 20;
+}  // namespace
+
 #ifdef ENABLE_PYTHON
 BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size, int32_t num_workers,
                  const std::vector<std::string> &in_col, const std::vector<std::string> &out_col,
@@ -55,6 +65,9 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
     // Ensure there are at least 2 queue slots for whole operation.  If only 1 worker, increase queue size to 2.
     worker_connector_size_ = std::max(2, worker_connector_size_);
   }
+  if (common::GetEnv("MS_DEV_DATASET_BATCH_POOL") == "1") {
+    buffer_pool_ = std::make_shared<BatchBufferPool>(kMaxCachedBatchBytes);
+  }
 }
 
 Status BatchOp::operator()() {
@@ -293,6 +306,205 @@ Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *tensor_
   return Status::OK();
 }
 
+namespace {
+// the bytes of one element of pad value, in the type of column
+Status GetPadElement(const std::shared_ptr<Tensor> &pad_val, const DataType &type, std::vector<uint8_t> *pad_element) {
+  pad_element->assign(type.SizeInBytes(), 0);
+  if (pad_val == nullptr) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(pad_val->type().IsNumeric(),
+                               "PadEnd: can not pad numeric and string tensors together, but got: " +
+                                 pad_val->type().ToString() + " and " + type.ToString() + ".");
+  // the same as PadEnd, pad value is converted to float first and then to the type of column
+  std::shared_ptr<Tensor> float_pad_value;
+  RETURN_IF_NOT_OK(TypeCast(pad_val, &float_pad_value, DataType(DataType::DE_FLOAT32)));
+  float val = 0.;
+  RETURN_IF_NOT_OK(float_pad_value->GetItemAt<float>(&val, {}));
+  if (std::fabs(val) <= std::numeric_limits<float>::epsilon()) {
+    return Status::OK();
+  }
+  std::shared_ptr<Tensor> typed_pad_value;
+  RETURN_IF_NOT_OK(TypeCast(float_pad_value, &typed_pad_value, type));
+  CHECK_FAIL_RETURN_UNEXPECTED(typed_pad_value->SizeInBytes() == static_cast<dsize_t>(pad_element->size()),
+                               "PadEnd: pad value should be a scalar, but got shape: " +
+                                 typed_pad_value->shape().ToString());
+  (void)std::copy(typed_pad_value->GetBuffer(), typed_pad_value->GetBuffer() + pad_element->size(),
+                  pad_element->begin());
+  return Status::OK();
+}
+
+// fill the slot of a row with pad value, then copy the part of row which fits into the padded shape
+Status PadRowToBatch(const std::shared_ptr<Tensor> &src, const TensorShape &dst_shape,
+                     const std::vector<uint8_t> &pad_element, uint8_t *dst) {
+  const size_t element_size = pad_element.size();
+  const auto dst_size = static_cast<size_t>(dst_shape.NumOfElements()) * element_size;
+  if (std::all_of(pad_element.begin(), pad_element.end(), [](uint8_t byte) { return byte == 0; })) {
+    (void)std::fill(dst, dst + dst_size, 0);
+  } else {
+    for (size_t offset = 0; offset < dst_size; offset += element_size) {
+      (void)std::copy(pad_element.begin(), pad_element.end(), dst + offset);
+    }
+  }
+
+  const TensorShape &src_shape = src->shape();
+  const auto rank = static_cast<int32_t>(src_shape.Rank());
+  std::vector<dsize_t> copy_shape(rank);
+  std::vector<dsize_t> src_strides(rank, 1);
+  std::vector<dsize_t> dst_strides(rank, 1);
+  for (int32_t dim = rank - 1; dim >= 0; --dim) {
+    copy_shape[dim] = std::min(src_shape[dim], dst_shape[dim]);
+    if (copy_shape[dim] == 0) {
+      return Status::OK();
+    }
+    if (dim < rank - 1) {
+      src_strides[dim] = src_strides[dim + 1] * src_shape[dim + 1];
+      dst_strides[dim] = dst_strides[dim + 1] * dst_shape[dim + 1];
+    }
+  }
+  // walk through the indices of all dims but the last one, and copy the last dim at each index
+  const uchar *src_data = src->GetBuffer();
+  const auto copy_size = static_cast<size_t>(copy_shape[rank - 1]) * element_size;
+  std::vector<dsize_t> index(rank, 0);
+  while (true) {
+    dsize_t src_offset = 0;
+    dsize_t dst_offset = 0;
+    for (int32_t dim = 0; dim < rank - 1; ++dim) {
+      src_offset += index[dim] * src_strides[dim];
+      dst_offset += index[dim] * dst_strides[dim];
+    }
+    (void)std::copy(src_data + src_offset * element_size, src_data + src_offset * element_size + copy_size,
+                    dst + dst_offset * element_size);
+    int32_t dim = rank - 2;
+    while (dim >= 0 && ++index[dim] == copy_shape[dim]) {
+      index[dim] = 0;
+      --dim;
+    }
+    if (dim < 0) {
+      break;
+    }
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status BatchOp::CopyColumnToPooledTensor(const std::unique_ptr<TensorQTable> *table, size_t column_index,
+                                         const std::vector<dsize_t> *pad_shape, const std::shared_ptr<Tensor> &pad_val,
+                                         const std::shared_ptr<BatchBufferPool> &pool,
+                                         std::shared_ptr<Tensor> *batched_tensor) {
+  RETURN_UNEXPECTED_IF_NULL(table);
+  RETURN_UNEXPECTED_IF_NULL(pool);
+  RETURN_UNEXPECTED_IF_NULL(batched_tensor);
+  const auto batch_size = static_cast<dsize_t>((*table)->size());
+  const std::shared_ptr<Tensor> &first_tensor = (*table)->front().at(column_index);
+  const DataType type = first_tensor->type();
+  // rank 0 tensors are never padded, the same as PadEnd
+  const bool padded = pad_shape != nullptr && first_tensor->Rank() != 0;
+  const TensorShape row_shape = padded ? TensorShape(*pad_shape) : first_tensor->shape();
+  const auto row_size = static_cast<size_t>(row_shape.NumOfElements()) * type.SizeInBytes();
+  std::vector<uint8_t> pad_element;
+  if (padded) {
+    RETURN_IF_NOT_OK(GetPadElement(pad_val, type, &pad_element));
+  }
+
+  std::shared_ptr<uint8_t> buffer;
+  RETURN_IF_NOT_OK(pool->Acquire(row_size * static_cast<size_t>(batch_size), &buffer));
+  for (dsize_t row_index = 0; row_index < batch_size; ++row_index) {
+    const std::shared_ptr<Tensor> &old_tensor = (**table)[row_index][column_index];
+    CHECK_FAIL_RETURN_UNEXPECTED(old_tensor->type() == type,
+                                 "Cannot batch tensors with different types in column " +
+                                   std::to_string(column_index) + ". First element had type " + type.ToString() +
+                                   " and this element had type " + old_tensor->type().ToString());
+    uint8_t *dst = buffer.get() + static_cast<size_t>(row_index) * row_size;
+    if (old_tensor->shape() == row_shape) {
+      (void)std::copy(old_tensor->GetBuffer(), old_tensor->GetBuffer() + row_size, dst);
+    } else if (padded) {
+      RETURN_IF_NOT_OK(PadRowToBatch(old_tensor, row_shape, pad_element, dst));
+    } else {
+      RETURN_STATUS_UNEXPECTED("Cannot batch tensors with different shapes in column " + std::to_string(column_index) +
+                               ". First element had shape " + row_shape.ToString() + " and this element had shape " +
+                               old_tensor->shape().ToString());
+    }
+  }
+  uint8_t *data = buffer.get();
+  return Tensor::CreateFromMemoryNoCopy(row_shape.PrependDim(batch_size), type, data, std::move(buffer),
+                                        batched_tensor);
+}
+
+Status BatchOp::BatchRowsWithPool(const std::unique_ptr<TensorQTable> *table, TensorRow *batched_tensor_row, bool pad,
+                                  const PadInfo &pad_info,
+                                  const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                                  bool contains_per_batch_map, const std::shared_ptr<BatchBufferPool> &pool) {
+  RETURN_UNEXPECTED_IF_NULL(table);
+  RETURN_UNEXPECTED_IF_NULL(batched_tensor_row);
+  RETURN_UNEXPECTED_IF_NULL(pool);
+  const auto batch_size = static_cast<dsize_t>((*table)->size());
+  const size_t num_columns = (*table)->front().size();
+  std::set<int32_t> pad_cols;
+  std::vector<std::shared_ptr<Tensor>> pad_vals(num_columns, nullptr);
+  std::vector<std::vector<dsize_t>> pad_shapes(num_columns);
+  if (pad) {
+    RETURN_IF_NOT_OK(ComputePadShapes(table, pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
+  }
+
+  // the numeric columns are copied into the pooled buffers, the others take the original path
+  std::vector<std::shared_ptr<Tensor>> batched_tensors(num_columns);
+  std::vector<size_t> pooled_cols;
+  uint64_t pooled_size = 0;
+  for (size_t col_id = 0; col_id < num_columns; ++col_id) {
+    const std::shared_ptr<Tensor> &first_tensor = (*table)->front()[col_id];
+    const bool padded = pad_cols.find(static_cast<int32_t>(col_id)) != pad_cols.end();
+    if (first_tensor->type().IsNumeric()) {
+      pooled_cols.push_back(col_id);
+      pooled_size += static_cast<uint64_t>(first_tensor->SizeInBytes() * batch_size);
+      continue;
+    }
+    if (padded) {
+      for (TensorRow &row : **table) {
+        std::shared_ptr<Tensor> pad_tensor;
+        RETURN_IF_NOT_OK(PadEnd(row[col_id], &pad_tensor, pad_shapes[col_id], pad_vals[col_id]));
+        row[col_id] = pad_tensor;
+      }
+    }
+    RETURN_IF_NOT_OK(
+      ConvertRowsToTensor(table, &batched_tensors[col_id], batch_size, col_id, contains_per_batch_map));
+  }
+
+  auto copy_column = [&](size_t col_id) {
+    const bool padded = pad_cols.find(static_cast<int32_t>(col_id)) != pad_cols.end();
+    return CopyColumnToPooledTensor(table, col_id, padded ? &pad_shapes[col_id] : nullptr, pad_vals[col_id], pool,
+                                    &batched_tensors[col_id]);
+  };
+  Status rc;
+  if (pooled_cols.size() > 1 && pooled_size >= kParallelBatchCopyBytes) {
+    // the columns are independent, the first one is copied by the current thread while the others are copied aside
+    std::vector<std::future<Status>> futures;
+    futures.reserve(pooled_cols.size() - 1);
+    for (size_t i = 1; i < pooled_cols.size(); ++i) {
+      futures.emplace_back(std::async(std::launch::async, copy_column, pooled_cols[i]));
+    }
+    rc = copy_column(pooled_cols[0]);
+    for (auto &future : futures) {
+      Status col_rc = future.get();
+      if (rc.IsOk()) {
+        rc = col_rc;
+      }
+    }
+  } else {
+    for (size_t col_id : pooled_cols) {
+      rc = copy_column(col_id);
+      if (rc.IsError()) {
+        break;
+      }
+    }
+  }
+  RETURN_IF_NOT_OK(rc);
+  for (auto &tensor : batched_tensors) {
+    batched_tensor_row->emplace_back(std::move(tensor));
+  }
+  return Status::OK();
+}
+
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
   // let Python layer know the worker id of this thread
@@ -363,6 +575,10 @@ Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchIn
     RETURN_IF_NOT_OK(MapColumns(&tensor_info_pair, &concat_batch));
   }  // pass it through pyfunc
 #endif
+  if (buffer_pool_ != nullptr && !concat_batch && tensor_info_pair.first->size() > 1) {
+    return BatchRowsWithPool(&tensor_info_pair.first, batched_tensor_row, pad_, pad_info_, column_name_id_map_,
+                             contains_per_batch_map, buffer_pool_);
+  }
   if (pad_) {
     RETURN_IF_NOT_OK(PadColumns(&tensor_info_pair.first, pad_info_, column_name_id_map_));
   }  // do padding if needed
@@ -604,32 +820,54 @@ Status BatchOp::InvokeBatchMapFunc(TensorTable *input, TensorTable *output, CBat
 Status BatchOp::PadColumns(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
                            const std::unordered_map<std::string, int32_t> &column_name_id_map) {
   RETURN_UNEXPECTED_IF_NULL(table);  // placeholder for now, might need this in the future
+  std::vector<std::shared_ptr<Tensor>> pad_vals(column_name_id_map.size(),
+                                                nullptr);  // value to pad each column's tensor with, default nullptr
+  std::set<int32_t> pad_cols;
+  std::vector<std::vector<dsize_t>> pad_shapes(column_name_id_map.size());
+  RETURN_IF_NOT_OK(ComputePadShapes(table, pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
+
+  // call pad on each tensor that needs to be padded
+  for (TensorRow &row : **table) {
+    for (size_t col_id : pad_cols) {
+      std::shared_ptr<Tensor> pad_tensor;
+      RETURN_IF_NOT_OK(PadEnd(row[col_id], &pad_tensor, pad_shapes[col_id], pad_vals[col_id]));
+      row[col_id] = pad_tensor;
+    }
+  }
+  return Status::OK();
+}
+
+Status BatchOp::ComputePadShapes(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                                 const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                                 std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
+                                 std::vector<std::vector<dsize_t>> *pad_shapes) {
+  RETURN_UNEXPECTED_IF_NULL(table);
+  RETURN_UNEXPECTED_IF_NULL(pad_cols);
+  RETURN_UNEXPECTED_IF_NULL(pad_vals);
+  RETURN_UNEXPECTED_IF_NULL(pad_shapes);
   CHECK_FAIL_RETURN_UNEXPECTED(
     (*table)->front().size() == column_name_id_map.size(),
     "Invalid parameter, size of column_name_id_map must be equal to num of data columns. map size: " +
       std::to_string(column_name_id_map.size()) + ", column nums: " + std::to_string((*table)->front().size()));
-  std::vector<std::shared_ptr<Tensor>> pad_vals(column_name_id_map.size(),
-                                                nullptr);  // value to pad each column's tensor with, default nullptr
-  std::set<int32_t> pad_cols;
   // padded_shape provided by user, maximum shapes of current batch of tensors
-  std::vector<std::vector<dsize_t>> pad_shapes(column_name_id_map.size()), max_shapes(column_name_id_map.size());
-  RETURN_IF_NOT_OK(UnpackPadInfo(pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
+  std::vector<std::vector<dsize_t>> max_shapes(column_name_id_map.size());
+  RETURN_IF_NOT_OK(UnpackPadInfo(pad_info, column_name_id_map, pad_cols, pad_vals, pad_shapes));
 
   // init each shape in max_shape to {-1,-1...} init each unspecified shape in pad_shape to -1 as well
-  for (size_t col_id : pad_cols) {
+  for (size_t col_id : *pad_cols) {
     max_shapes[col_id] = std::vector<dsize_t>((*table)->front()[col_id]->Rank(), -1);
-    if (pad_shapes[col_id].empty()) {
-      pad_shapes[col_id] = max_shapes[col_id];  // fill pad shape with -1
+    if ((*pad_shapes)[col_id].empty()) {
+      (*pad_shapes)[col_id] = max_shapes[col_id];  // fill pad shape with -1
     }
     CHECK_FAIL_RETURN_UNEXPECTED(
-      pad_shapes[col_id].size() == max_shapes[col_id].size(),
+      (*pad_shapes)[col_id].size() == max_shapes[col_id].size(),
       "Invalid pad_info, rank of pad_shape must be equal to rank of specified column. pad_shapes rank:" +
-        std::to_string(pad_shapes[col_id].size()) + ", column rank: " + std::to_string(max_shapes[col_id].size()));
+        std::to_string((*pad_shapes)[col_id].size()) + ", column rank: " + std::to_string(max_shapes[col_id].size()));
   }
 
   // calculate maximum shape for each column that needs to be padded
   for (const TensorRow &row : **table) {  // iterator each row in a batch
-    for (size_t col_id : pad_cols) {      // iterator each tensor in a row
+    for (size_t col_id : *pad_cols) {     // iterator each tensor in a row
       CHECK_FAIL_RETURN_UNEXPECTED(
         row[col_id]->Rank() == max_shapes[col_id].size(),
         "Invalid data, data to be padded together need to have the same rank, got shape 1: " +
@@ -641,22 +879,13 @@ Status BatchOp::PadColumns(const std::unique_ptr<TensorQTable> *table, const Pad
   }
 
   // if user sets a dimension to -1 (None in python), use the max value for current dimension
-  for (size_t col_id : pad_cols) {
-    for (size_t dim = 0; dim < pad_shapes[col_id].size(); dim++) {
-      if (pad_shapes[col_id][dim] < 0) {
-        pad_shapes[col_id][dim] = max_shapes[col_id][dim];
+  for (size_t col_id : *pad_cols) {
+    for (size_t dim = 0; dim < (*pad_shapes)[col_id].size(); dim++) {
+      if ((*pad_shapes)[col_id][dim] < 0) {
+        (*pad_shapes)[col_id][dim] = max_shapes[col_id][dim];
       }
     }
   }
-
-  // call pad on each tensor that needs to be padded
-  for (TensorRow &row : **table) {
-    for (size_t col_id : pad_cols) {
-      std::shared_ptr<Tensor> pad_tensor;
-      RETURN_IF_NOT_OK(PadEnd(row[col_id], &pad_tensor, pad_shapes[col_id], pad_vals[col_id]));
-      row[col_id] = pad_tensor;
-    }
-  }
   return Status::OK();
 }
 
@@ -30,6 +30,7 @@
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/batch_buffer_pool.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/util/status.h"
 
@@ -148,6 +149,22 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   static Status PadColumns(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
                            const std::unordered_map<std::string, int32_t> &column_name_id_map);
 
+  // batch the rows into buffers taken from the pool. The numeric columns are padded while they are copied into the
+  // batch, so that each of them is written only once, and the large columns are copied in parallel. The other
+  // columns are padded and batched as usual.
+  // @param const std::unique_ptr<TensorQTable> *table - table that has the rows for batching
+  // @param TensorRow *batched_tensor_row - dest row to hold batched tensors
+  // @param bool pad - whether to perform padding on tensor
+  // @param const PadInfo &pad_info pad info
+  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param bool contains_per_batch_map - whether user has provided per_batch_map
+  // @param const std::shared_ptr<BatchBufferPool> &pool - the pool which the output buffers are taken from
+  // @return Status The status code returned
+  static Status BatchRowsWithPool(const std::unique_ptr<TensorQTable> *table, TensorRow *batched_tensor_row, bool pad,
+                                  const PadInfo &pad_info,
+                                  const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                                  bool contains_per_batch_map, const std::shared_ptr<BatchBufferPool> &pool);
+
   int64_t GetTreeBatchSize() override;
 
   bool IsPython() const override {
@@ -196,6 +213,32 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
                               std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
                               std::vector<std::vector<dsize_t>> *pad_shapes);
 
+  // compute the shape each column is padded to, which is the pad_shape given by user or the max shape of the batch
+  // @param table
+  // @param const PadInfo &pad_info pad info
+  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param std::set<int32_t> *pad_cols, col ids to perform pad on
+  // @param std::vector<std::shared_ptr<Tensor>> *pad_vals, padding value for each column
+  // @param std::vector<std::vector<dsize_t>> *pad_shapes, the shape to pad to for each column
+  // @return Status The status code returned
+  static Status ComputePadShapes(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                                 const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                                 std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
+                                 std::vector<std::vector<dsize_t>> *pad_shapes);
+
+  // copy a numeric column of the rows into a buffer taken from the pool, padding the rows on the way if needed
+  // @param const std::unique_ptr<TensorQTable> *table - table that has the rows for batching
+  // @param size_t column_index - the column to be batched
+  // @param const std::vector<dsize_t> *pad_shape - the shape to pad to, nullptr if the column is not padded
+  // @param const std::shared_ptr<Tensor> &pad_val - the value to pad with, zero if it is nullptr
+  // @param const std::shared_ptr<BatchBufferPool> &pool - the pool which the output buffer is taken from
+  // @param std::shared_ptr<Tensor> *batched_tensor - the batched tensor
+  // @return Status The status code returned
+  static Status CopyColumnToPooledTensor(const std::unique_ptr<TensorQTable> *table, size_t column_index,
+                                         const std::vector<dsize_t> *pad_shape, const std::shared_ptr<Tensor> &pad_val,
+                                         const std::shared_ptr<BatchBufferPool> &pool,
+                                         std::shared_ptr<Tensor> *batched_tensor);
+
   // get the batch size for next batch
   // @return Status The status code returned
   Status GetBatchSize(int32_t *batch_size, CBatchInfo info);
@@ -236,6 +279,7 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   py::function batch_map_func_;   // Function pointer of per batch map function
 #endif
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;  // python multiprocessing instance
+  std::shared_ptr<BatchBufferPool> buffer_pool_;             // recycled output buffers, nullptr if it is disabled
 
  protected:
   Status Launch() override;
@@ -162,6 +162,7 @@ Status CacheOp::WaitForCachingAllRows() {
   MS_LOG(INFO) << "Number of rows cached: " << num_rows_;
   MS_LOG(INFO) << "Number of rows cached in memory : " << stat.num_mem_cached;
   MS_LOG(INFO) << "Number of rows spilled to disk : " << stat.num_disk_cached;
+  MS_LOG(INFO) << "Number of rows compressed in memory : " << stat.num_compressed_cached;
   MS_LOG(INFO) << "Average cache size : " << stat.avg_cache_sz;
   // Now all rows are cached and we have done a sync point check up. Next phase is
   // is pick up fetch input from sampler and pass up to the caller.
@@ -282,6 +282,10 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  // \brief Getter function
+  // \return the bytes of rows held by the internal buffer of current op, -1 if the op does not buffer rows
+  virtual int64_t BufferMemoryUsage() const { return -1; }
+
   // \brief Getter function
   // \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
@@ -16,6 +16,7 @@
 #if defined(_WIN32) || defined(_WIN64)
 #include <stdlib.h>
 #endif
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
@@ -47,6 +48,8 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       shuffle_last_row_idx_(0),
       shuffle_buffer_state_(kShuffleStateInit) {}
 
+void ShuffleOp::SetMaxBufferBytes(int64_t max_buffer_bytes) { max_buffer_bytes_ = max_buffer_bytes; }
+
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
 Status ShuffleOp::SelfReset() {
@@ -60,6 +63,8 @@ Status ShuffleOp::SelfReset() {
   }
 
   shuffle_buffer_ = std::make_unique<TensorTable>();
+  buffer_bytes_ = 0;
+  pending_row_.clear();
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
   return Status::OK();
@@ -77,30 +82,48 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
     out << "\nShuffle size: " << shuffle_size_ << "\nShuffle buffer state: " << shuffle_buffer_state_
-        << "\nShuffle seed: " << shuffle_seed_ << "\n\n";
+        << "\nShuffle seed: " << shuffle_seed_ << "\nMax buffer bytes: " << max_buffer_bytes_ << "\n\n";
   }
 }
 
 // Private function to add a new row to the shuffle buffer.
 Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
-  // If the last slot of our shuffle buffer was not the full size of the shuffle buffer then we are
-  // filling it during the initial fill codepath and thus growing it's size. In that case, we push
-  // back the new row to grow our shuffle buffer size by 1.
-  // If we are already at the full size, then we overwrite the last slot with our row (and the last
-  // slot better be empty because it should already have been swapped out during the random row
-  // selection that was done previously!)
-  if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
-    shuffle_buffer_->push_back(std::move(new_shuffle_row));
-    shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
-  } else {
-    if (!(*shuffle_buffer_)[shuffle_last_row_idx_].empty()) {
-      RETURN_STATUS_UNEXPECTED("[Internal ERROR] Last row of shuffle buffer should not be occupied!");
-    }
-    (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+  if (shuffle_buffer_->size() >= static_cast<size_t>(shuffle_size_)) {
+    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Shuffle buffer should not hold more rows than the shuffle size!");
   }
+  buffer_bytes_ += RowSizeInBytes(new_shuffle_row);
+  peak_buffer_bytes_ = std::max(peak_buffer_bytes_, buffer_bytes_.load());
+  // The shuffle buffer is kept contiguous, so the new row always goes to the tail. The tail slot of a drawn
+  // row has already been popped during the random row selection.
+  shuffle_buffer_->push_back(std::move(new_shuffle_row));
+  shuffle_last_row_idx_ = static_cast<int32_t>(shuffle_buffer_->size()) - 1;
   return Status::OK();
 }
 
+Status ShuffleOp::AddPendingRowToShuffleBuffer() {
+  if (pending_row_.empty()) {
+    return Status::OK();
+  }
+  // An empty buffer always takes the row, otherwise a row larger than the limit could never be shuffled out
+  if (max_buffer_bytes_ > 0 && !shuffle_buffer_->empty() &&
+      buffer_bytes_ + RowSizeInBytes(pending_row_) > max_buffer_bytes_) {
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(pending_row_)));
+  pending_row_.clear();
+  return Status::OK();
+}
+
+int64_t ShuffleOp::RowSizeInBytes(const TensorRow &row) {
+  int64_t row_size = 0;
+  for (const auto &tensor : row) {
+    if (tensor != nullptr) {
+      row_size += tensor->SizeInBytes();
+    }
+  }
+  return row_size;
+}
+
 Status ShuffleOp::GetShuffledRowImpl(TensorRow *const row, bool is_pull_mode) {
   RETURN_UNEXPECTED_IF_NULL(row);
   // Step 1)
@@ -109,42 +132,36 @@ Status ShuffleOp::GetShuffledRowImpl(TensorRow *const row, bool is_pull_mode) {
   // in the table as an empty vector
   int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
   TensorRow random_row = std::move((*shuffle_buffer_)[random_slot]);
+  buffer_bytes_ -= RowSizeInBytes(random_row);
   *row = std::move(random_row);
 
   // Step 2)
   // Take the last row from shuffle buffer, and swap it into the row position that was
-  // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
+  // just vacated.  This makes the shuffle buffer contiguous, then pop the empty slot at the
   // tail of the shuffle buffer.
   if (random_slot != shuffle_last_row_idx_) {
     (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
   }
+  shuffle_buffer_->pop_back();
+  shuffle_last_row_idx_--;
 
   // Step 3)
-  // Refill the last slot of the shuffle buffer with the next row from input if we are in the
-  // active state.
+  // Refill the tail of the shuffle buffer with the next row from input if we are in the
+  // active state. A row which is still pending for the byte limit is retried before fetching a new one.
   // If we are in the draining state, we do not need to fetch another row to replace the one we
   // just drained.
-  if (shuffle_buffer_state_ == kShuffleStateActive) {
-    TensorRow new_row;
+  if (shuffle_buffer_state_ == kShuffleStateActive && pending_row_.empty()) {
     if (!is_pull_mode) {
-      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&pending_row_));
     } else {
-      RETURN_IF_NOT_OK(child_[0]->GetNextRowPullMode(&new_row));
+      RETURN_IF_NOT_OK(child_[0]->GetNextRowPullMode(&pending_row_));
     }
 
-    if (!new_row.empty()) {
-      RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
-    } else {
+    if (pending_row_.empty()) {
       shuffle_buffer_state_ = kShuffleStateDrain;
     }
   }
-
-  // If we are draining, reposition (decrement) our tail index in the shuffle buffer since we
-  // just drained a row from it.
-  if (shuffle_buffer_state_ == kShuffleStateDrain) {
-    shuffle_last_row_idx_--;
-  }
-  return Status::OK();
+  return AddPendingRowToShuffleBuffer();
 }
 
 // Class functor operator () override.
@@ -234,24 +251,31 @@ Status ShuffleOp::InitShuffleBuffer(bool is_pull_mode) {
     RETURN_STATUS_UNEXPECTED("[Internal ERROR] Unable to fetch a single row for shuffle buffer.");
   }
 
-  // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
-  // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
-    // Add the previously fetched row
-    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+  // Now fill the rest of the shuffle buffer until we are unable to get the next row, we reached
+  // the desired shuffle buffer size, or the next row does not fit in the bytes limit.
+  pending_row_ = std::move(new_row);
+  while (shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
+    // Add the previously fetched row, it stays pending once the buffer holds as many bytes as allowed
+    RETURN_IF_NOT_OK(AddPendingRowToShuffleBuffer());
+    if (!pending_row_.empty()) {
+      break;
+    }
 
     // Fetch the next row
     if (!is_pull_mode) {
-      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+      RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&pending_row_));
     } else {
       // Fetch the next row
-      RETURN_IF_NOT_OK(child_[0]->GetNextRowPullMode(&new_row));
+      RETURN_IF_NOT_OK(child_[0]->GetNextRowPullMode(&pending_row_));
+    }
+    if (pending_row_.empty()) {
+      break;
     }
   }
 
   // If we quit the loop due to being at the shuffle size, still need to add the last row here.
-  if (!new_row.empty()) {
-    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+  if (!pending_row_.empty()) {
+    RETURN_IF_NOT_OK(AddPendingRowToShuffleBuffer());
     shuffle_buffer_state_ = kShuffleStateActive;  // Transition to the active state
   } else {
     // If init phase doesn't have more rows, then skip the active state and jump straight to the
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_OP_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_OP_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <queue>
@@ -97,6 +98,18 @@ class ShuffleOp : public PipelineOp {
   /// \return Status The status code.
   void Skip(int64_t skip_steps);
 
+  /// \brief Set the upper limit of the bytes held by the shuffle buffer.
+  /// \param[in] max_buffer_bytes The upper limit of the bytes held by the shuffle buffer, 0 for no limit. A row which
+  ///     does not fit waits outside the buffer until enough rows are drained, so the buffer holds fewer rows than
+  ///     shuffle_size. A single row larger than the limit is still buffered alone.
+  void SetMaxBufferBytes(int64_t max_buffer_bytes);
+
+  /// \brief The bytes of rows held by the shuffle buffer, which is sampled by the profiling.
+  int64_t BufferMemoryUsage() const override { return buffer_bytes_; }
+
+  /// \brief The most bytes of rows ever held by the shuffle buffer.
+  int64_t PeakBufferMemoryUsage() const { return peak_buffer_bytes_; }
+
  protected:
   /// \brief Gets the implementation status for operator in pull mode
   /// \return implementation status
@@ -113,6 +126,10 @@ class ShuffleOp : public PipelineOp {
   /// \return Status The status code returned
   Status InitShuffleBuffer(bool is_pull_mode);
 
+  /// \brief Moves the pending row into the shuffle buffer if it fits in max_buffer_bytes_ or the buffer is empty.
+  /// \return Status The status code returned
+  Status AddPendingRowToShuffleBuffer();
+
   /// \brief Gets one row out of the shuffle buffer and fills the vacant row with the last row in the buffer. This
   ///     implemented function is for both pull mode and non-pull mode. If it's in non-pull mode, fetch data from the
   ///     internal child iterator. Otherwise, fetch by calling GetNextRowPullMode() of its child node.
@@ -121,6 +138,9 @@ class ShuffleOp : public PipelineOp {
   /// \return Status The status code returned
   Status GetShuffledRowImpl(TensorRow *row, bool is_pull_mode);
 
+  // The bytes of the tensors of row.
+  static int64_t RowSizeInBytes(const TensorRow &row);
+
   // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
   // itself rather than waiting for the reset driven from operators above it in the pipeline.
   // @return Status The status code returned
@@ -140,6 +160,11 @@ class ShuffleOp : public PipelineOp {
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
+  int64_t max_buffer_bytes_{0};           // The upper limit of bytes held by the shuffle buffer, 0 for no limit
+  std::atomic<int64_t> buffer_bytes_{0};  // The bytes held by the shuffle buffer
+  int64_t peak_buffer_bytes_{0};          // The most bytes ever held by the shuffle buffer
+  TensorRow pending_row_;                 // The fetched row waiting for the buffer to drain below max_buffer_bytes_
+
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
   bool eof_received_{false};                       // flag to indicate if eof is reached in pull mode.
 };
@@ -62,6 +62,10 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, std::vector<std::str
 
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
+  // read the blob data from the memory mapped pages, and wrap the numeric columns into tensors without copy
+  shard_reader_->SetZeroCopy(common::GetEnv("MS_DEV_MINDRECORD_ZERO_COPY") == "1");
+  // read the next sampled rows ahead with the async io, so that fewer workers are needed to saturate the disk
+  shard_reader_->SetPrefetchSize(mindrecord::AsyncIOEngine::GetReadaheadDepth());
   RETURN_IF_NOT_OK(shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_,
                                        operators_, num_padded_));
 
@@ -205,13 +209,29 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
 Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
   RETURN_UNEXPECTED_IF_NULL(fetched_row);
   *fetched_row = {};
-  auto task_content_ptr = std::make_shared<mindrecord::TASK_CONTENT>(
-    mindrecord::TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>());
-  RETURN_IF_NOT_OK(shard_reader_->GetNextById(row_id, worker_id, &task_content_ptr));
-  auto task_type = task_content_ptr->first;
-  auto tupled_buffer = task_content_ptr->second;
+  auto task_type = mindrecord::TaskType::kCommonTask;
+  std::vector<std::tuple<mindrecord::ShardBlobView, mindrecord::json>> tupled_buffer;
+  // keep the copied blob data alive until the tensors are created
+  std::shared_ptr<mindrecord::TASK_CONTENT> task_content_ptr;
+  if (shard_reader_->GetZeroCopy()) {
+    auto task_view_ptr = std::make_shared<mindrecord::TASK_VIEW_CONTENT>(
+      mindrecord::TaskType::kCommonTask, std::vector<std::tuple<mindrecord::ShardBlobView, mindrecord::json>>());
+    RETURN_IF_NOT_OK(shard_reader_->GetNextById(row_id, worker_id, &task_view_ptr));
+    task_type = task_view_ptr->first;
+    tupled_buffer = std::move(task_view_ptr->second);
+  } else {
+    task_content_ptr = std::make_shared<mindrecord::TASK_CONTENT>(
+      mindrecord::TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>());
+    RETURN_IF_NOT_OK(shard_reader_->GetNextById(row_id, worker_id, &task_content_ptr));
+    task_type = task_content_ptr->first;
+    for (const auto &tupled_row : task_content_ptr->second) {
+      const auto &columns_blob = std::get<0>(tupled_row);
+      (void)tupled_buffer.emplace_back(mindrecord::ShardBlobView(nullptr, columns_blob.data(), columns_blob.size()),
+                                       std::get<1>(tupled_row));
+    }
+  }
   if (task_type == mindrecord::TaskType::kPaddedTask) {
-    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, mindrecord::ShardBlobView(), mindrecord::json(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
     fetched_row->setPath(file_path);
     fetched_row->setId(row_id);
@@ -221,8 +241,8 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   }
   if (task_type == mindrecord::TaskType::kCommonTask) {
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
+      const mindrecord::ShardBlobView &columns_blob = std::get<0>(tupled_row);
+      const mindrecord::json &columns_json = std::get<1>(tupled_row);
       RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type));
       std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
       fetched_row->setPath(file_path);
@@ -233,7 +253,7 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobView &columns_blob,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   RETURN_UNEXPECTED_IF_NULL(tensor_row);
   for (int32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
@@ -271,9 +291,9 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
         data = reinterpret_cast<const unsigned char *>(data_ptr.get());
       }
     } else {
-      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr,
-                                                          &n_bytes, &column_data_type, &column_data_type_size,
-                                                          &column_shape));
+      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob.data(), columns_blob.size(),
+                                                          columns_json, &data, &data_ptr, &n_bytes, &column_data_type,
+                                                          &column_data_type_size, &column_shape));
     }
 
     std::shared_ptr<Tensor> tensor;
@@ -284,6 +304,9 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
     CHECK_FAIL_RETURN_UNEXPECTED(column_data_type_size != 0,
                                  "[Internal ERROR] Found memory size of column data type is 0.");
     auto num_elements = n_bytes / column_data_type_size;
+    // the data is not copied if it points into the mapped page and is aligned to its data type
+    bool no_copy = columns_blob.page() != nullptr && data_ptr == nullptr && data != nullptr && type.IsNumeric() &&
+                   reinterpret_cast<uintptr_t>(data) % type.SizeInBytes() == 0;
     if (type == DataType::DE_STRING) {
       std::string s{data, data + n_bytes};
       RETURN_IF_NOT_OK(Tensor::CreateScalar(s, &tensor));
@@ -299,17 +322,27 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       } else {
         RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
       }
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      RETURN_IF_NOT_OK(CreateTensorFromBlob(new_shape, type, data, no_copy ? columns_blob.page() : nullptr, &tensor));
     } else {
       std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
       auto new_shape = TensorShape(shapeDetails);
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      RETURN_IF_NOT_OK(CreateTensorFromBlob(new_shape, type, data, no_copy ? columns_blob.page() : nullptr, &tensor));
     }
     tensor_row->push_back(std::move(tensor));
   }
   return Status::OK();
 }
 
+Status MindRecordOp::CreateTensorFromBlob(const TensorShape &shape, const DataType &type, const unsigned char *data,
+                                          const std::shared_ptr<mindrecord::ShardMappedPage> &page,
+                                          std::shared_ptr<Tensor> *tensor) {
+  if (page == nullptr || shape.NumOfElements() == 0) {
+    return Tensor::CreateFromMemory(shape, type, data, tensor);
+  }
+  // the tensor holds the page, so that the page is unmapped after all the tensors of it are released
+  return Tensor::CreateFromMemoryNoCopy(shape, type, data, page, tensor);
+}
+
 // Overrides base class reset method.  When an operator does a reset, it cleans up any state
 // info from it's previous execution and then initializes itself so that it can be executed
 // again.
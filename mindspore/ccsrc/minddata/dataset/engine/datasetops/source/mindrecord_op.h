@@ -122,11 +122,22 @@ class MindRecordOp : public MappableLeafOp {
 
   /// Parses a single cell and puts the data into a tensor
   /// @param tensor_row - the tensor row to put the parsed data in
-  /// @param columns_blob - the blob data received from the reader
+  /// @param columns_blob - the view of blob data received from the reader, the numeric columns are wrapped into the
+  ///     tensors without copy if the view refers to a mapped page
   /// @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobView &columns_blob,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
+  /// Creates the tensor from the blob data
+  /// @param shape - the shape of tensor
+  /// @param type - the data type of tensor
+  /// @param data - the data of column
+  /// @param page - the mapped page which the data points into, the data is copied if it is nullptr
+  /// @param tensor - the created tensor
+  Status CreateTensorFromBlob(const TensorShape &shape, const DataType &type, const unsigned char *data,
+                              const std::shared_ptr<mindrecord::ShardMappedPage> &page,
+                              std::shared_ptr<Tensor> *tensor);
+
   Status LoadTensorRow(row_id_type row_id, TensorRow *row) override {
     return Status(StatusCode::kMDSyntaxError, "[Internal ERROR] Cannot call this method.");
   }
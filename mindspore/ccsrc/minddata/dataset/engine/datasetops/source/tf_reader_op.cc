@@ -33,6 +33,7 @@
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/wait_post.h"
+#include "minddata/mindrecord/include/shard_async_io.h"
 #include "utils/file_utils.h"
 #include "utils/system/crc32c.h"
 
@@ -333,6 +334,12 @@ Status TFReaderOp::SendRecordBytesRow(const std::string &filename, const std::st
 
 Status TFReaderOp::HelperLoadNonCompFile(const std::string &filename, int64_t start_offset, int64_t end_offset,
                                          int32_t worker_id, const std::string &realpath_value) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto readahead_depth = mindrecord::AsyncIOEngine::GetReadaheadDepth();
+  if (readahead_depth > 0) {
+    return HelperLoadNonCompFileAsync(filename, start_offset, end_offset, worker_id, realpath_value, readahead_depth);
+  }
+#endif
   std::ifstream reader;
   reader.open(realpath_value, std::ios::in);
   if (!reader) {
@@ -376,6 +383,48 @@ Status TFReaderOp::HelperLoadNonCompFile(const std::string &filename, int64_t st
 }
 
 #if !defined(_WIN32) && !defined(_WIN64)
+Status TFReaderOp::HelperLoadNonCompFileAsync(const std::string &filename, int64_t start_offset, int64_t end_offset,
+                                              int32_t worker_id, const std::string &realpath_value,
+                                              uint32_t readahead_depth) {
+  mindrecord::AsyncSequentialReader reader(kTFRecordReadaheadChunkSize, readahead_depth);
+  RETURN_IF_NOT_OK(reader.Open(realpath_value));
+
+  int64_t rows_total = 0;
+  while (!reader.Eof()) {
+    if (!GetLoadJaggedConnector()) {
+      break;
+    }
+    RETURN_IF_INTERRUPTED();
+    // the rows after the end offset are not needed
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
+
+    // read length and ignore crc header
+    int64_t record_length = 0;
+    RETURN_IF_NOT_OK(reader.Read(&record_length, kTFRecordRecLenSize));
+    RETURN_IF_NOT_OK(reader.Read(nullptr, kTFRecordHeadFootSize));
+    CHECK_FAIL_RETURN_UNEXPECTED(record_length >= 0, "Invalid file, the length of record in " + filename +
+                                                       " is negative: " + std::to_string(record_length));
+
+    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
+      // read serialized Example
+      std::string serialized_example;
+      serialized_example.resize(static_cast<size_t>(record_length));
+      RETURN_IF_NOT_OK(reader.Read(&serialized_example[0], static_cast<uint64_t>(record_length)));
+      RETURN_IF_NOT_OK(SendRecordBytesRow(filename, serialized_example, worker_id));
+    } else {
+      // skip the rows which are not in the range
+      RETURN_IF_NOT_OK(reader.Read(nullptr, static_cast<uint64_t>(record_length)));
+    }
+
+    // ignore crc footer
+    RETURN_IF_NOT_OK(reader.Read(nullptr, kTFRecordHeadFootSize));
+    rows_total++;
+  }
+  return Status::OK();
+}
+
 Status TFReaderOp::HelperLoadCompGZIPFile(const std::string &filename, int64_t start_offset, int64_t end_offset,
                                           int32_t worker_id, const std::string &realpath_value) {
   gzFile file = gzopen(realpath_value.c_str(), "rb");
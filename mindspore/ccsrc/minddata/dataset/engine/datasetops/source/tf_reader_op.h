@@ -49,6 +49,7 @@ namespace mindspore {
 namespace dataset {
 const std::streamsize kTFRecordRecLenSize = sizeof(int64_t);
 const std::streamsize kTFRecordHeadFootSize = sizeof(int32_t);  // header has same size with footer
+const uint64_t kTFRecordReadaheadChunkSize = 1 << 20;           // size of each read of the async io
 const std::streamsize kZLIBChunkSize = 16384;
 
 template <typename T>
@@ -170,6 +171,20 @@ class TFReaderOp : public NonMappableLeafOp {
   Status HelperLoadNonCompFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id,
                                const std::string &realpath_value);
 
+#if !defined(_WIN32) && !defined(_WIN64)
+  // Helper function to read a non-compressed TFRecord file with the async io, the next chunks of the file are read
+  // ahead while the current records are parsed.
+  // @param filename - the TFRecord file to read.
+  // @param start_offset - the start offset of file.
+  // @param end_offset - the end offset of file.
+  // @param worker_id - the id of the worker that is executing this function.
+  // @param realpath_value - the real path for filename.
+  // @param readahead_depth - the number of chunks which are read ahead.
+  // @return Status - the error code returned.
+  Status HelperLoadNonCompFileAsync(const std::string &filename, int64_t start_offset, int64_t end_offset,
+                                    int32_t worker_id, const std::string &realpath_value, uint32_t readahead_depth);
+#endif
+
 #if !defined(_WIN32) && !defined(_WIN64)
   // ZLIBStream struct to initial ZLIB stream
   typedef struct ZLIBStreamInflate {
@@ -16,10 +16,13 @@
 
 #include "minddata/dataset/engine/ir/datasetops/shuffle_node.h"
 
+#include <cstdlib>
+
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/opt/pass.h"
 #include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/status.h"
+#include "utils/ms_utils.h"
 namespace mindspore {
 namespace dataset {
 
@@ -42,6 +45,13 @@ void ShuffleNode::Print(std::ostream &out) const {
 // Function to build the ShuffleOp
 Status ShuffleNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
   auto op = std::make_shared<ShuffleOp>(shuffle_size_, shuffle_seed_, connector_que_size_, reset_every_epoch_);
+  // the shuffle buffer of large dataset may take too much memory, it can be bounded in MB
+  std::string max_buffer_mb = common::GetEnv("MS_DEV_DATASET_SHUFFLE_BUFFER_MB");
+  int64_t max_buffer_bytes = max_buffer_mb.empty() ? 0 : std::strtoll(max_buffer_mb.c_str(), nullptr, 10);
+  if (max_buffer_bytes > 0) {
+    constexpr int64_t kBytesPerMB = 1024 * 1024;
+    op->SetMaxBufferBytes(max_buffer_bytes * kBytesPerMB);
+  }
   op->SetTotalRepeats(GetTotalRepeats());
   op->SetNumRepeatsPerEpoch(GetNumRepeatsPerEpoch());
   node_ops->push_back(op);
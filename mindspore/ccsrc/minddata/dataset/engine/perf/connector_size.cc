@@ -47,9 +47,14 @@ Status ConnectorSize::Sample() {
   // Tree Iterator is in PostOrder (leaf first, e.g., 3,2,1)
   // reverse the order of the vector to get the root first.
   std::reverse(cur_row.begin(), cur_row.end());
+  BufferMemorySample cur_memory;
+  (void)std::transform(tree_->begin(), tree_->end(), std::back_inserter(cur_memory),
+                       [](const DatasetOp &op) { return op.BufferMemoryUsage(); });
+  std::reverse(cur_memory.begin(), cur_memory.end());
   std::lock_guard<std::mutex> guard(lock_);
   // Push new row of sample
   sample_table_.push_back(cur_row);
+  buffer_memory_table_.push_back(cur_memory);
   (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
   return Status::OK();
 }
@@ -66,6 +71,10 @@ json ConnectorSize::ParseOpInfo(const DatasetOp &node) const {
   if (!node.inlined() && node.Name() != "DataQueueOp") {
     metrics["output_queue"] = {{"length", node.ConnectorCapacity()}};
   }
+  // only the ops which buffer rows, e.g. ShuffleOp, report the memory usage of buffer
+  if (node.BufferMemoryUsage() >= 0) {
+    metrics["buffer_memory"] = json::object();
+  }
   json_node["metrics"] = metrics;
 
   auto children = node.Children();
@@ -100,6 +109,13 @@ Status ConnectorSize::SaveToFile(const std::string &dir_path, const std::string
     if (ops_data[idx]["metrics"].contains("output_queue") && ops_data[idx]["op_type"] != "DataQueueOp") {
       ops_data[idx]["metrics"]["output_queue"]["size"] = cur_queue_size;
     }
+    if (ops_data[idx]["metrics"].contains("buffer_memory")) {
+      std::vector<int64_t> cur_memory_usage;
+      (void)std::transform(buffer_memory_table_.begin(), buffer_memory_table_.end(),
+                           std::back_inserter(cur_memory_usage),
+                           [&](const BufferMemorySample &sample) { return sample[idx]; });
+      ops_data[idx]["metrics"]["buffer_memory"]["bytes"] = cur_memory_usage;
+    }
   }
 
   // Discard the content of the file when opening.
@@ -127,6 +143,7 @@ Status ConnectorSize::Init() {
 void ConnectorSize::Clear() {
   ts_.clear();
   sample_table_.clear();
+  buffer_memory_table_.clear();
   initial_nodes_data.clear();
 }
 
@@ -163,6 +180,26 @@ Status ConnectorSize::GetOpConnectorSize(int32_t op_id, uint64_t start_time, uin
   return Status::OK();
 }
 
+Status ConnectorSize::GetOpBufferMemoryUsage(int32_t op_id, uint64_t start_time, uint64_t end_time,
+                                             std::vector<int64_t> *result) {
+  RETURN_UNEXPECTED_IF_NULL(result);
+  CHECK_FAIL_RETURN_UNEXPECTED(start_time < end_time,
+                               "Expected start_time < end_time. Got start_ts: " + std::to_string(start_time) +
+                                 " end_ts: " + std::to_string(end_time));
+  std::lock_guard<std::mutex> guard(lock_);
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    ts_.size() == buffer_memory_table_.size(),
+    "Expected ts_.size() == buffer_memory_table_.size(). Got ts_.size: " + std::to_string(ts_.size()) +
+      " buffer_memory_table_.size: " + std::to_string(buffer_memory_table_.size()));
+  auto start_index = std::distance(ts_.begin(), std::lower_bound(ts_.begin(), ts_.end(), start_time));
+  auto end_index = std::distance(ts_.begin(), std::upper_bound(ts_.begin(), ts_.end(), end_time));
+  // op_id corresponds to the index in sample vector
+  (void)std::transform(buffer_memory_table_.begin() + start_index, buffer_memory_table_.begin() + end_index,
+                       std::back_inserter(*result),
+                       [&](const BufferMemorySample &sample) { return sample[static_cast<size_t>(op_id)]; });
+  return Status::OK();
+}
+
 Path ConnectorSize::GetFileName(const std::string &dir_path, const std::string &rank_id) {
   return Path(dir_path) / Path("pipeline_profiling_" + rank_id + ".json");
 }
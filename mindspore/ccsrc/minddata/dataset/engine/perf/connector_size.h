@@ -40,6 +40,9 @@ class ConnectorSize : public Sampling {
   // A circular buffer will be implemented in the future to make this table more flexible.
   using ConnectorSizeSample = std::vector<int>;
   using ConnectorSizeSampleTable = std::vector<ConnectorSizeSample>;
+  // The bytes held by the buffer of each op, e.g. the shuffle buffer, are sampled together with the connector size
+  using BufferMemorySample = std::vector<int64_t>;
+  using BufferMemorySampleTable = std::vector<BufferMemorySample>;
   using Timestamps = std::vector<uint64_t>;
 
  public:
@@ -68,6 +71,9 @@ class ConnectorSize : public Sampling {
   // Get the vector of connector sizes of given op for samples taken between start and end time
   Status GetOpConnectorSize(int32_t op_id, uint64_t start_time, uint64_t end_time, std::vector<int32_t> *result);
 
+  // Get the vector of buffer memory usage of given op for samples taken between start and end time
+  Status GetOpBufferMemoryUsage(int32_t op_id, uint64_t start_time, uint64_t end_time, std::vector<int64_t> *result);
+
   // Clear all collected data
   void Clear() override;
 
@@ -76,9 +82,10 @@ class ConnectorSize : public Sampling {
 
  private:
   json initial_nodes_data;  // store data when execution tree is running. (all information for ops except sampled data)
-  ExecutionTree *tree_ = nullptr;          // ExecutionTree pointer
-  ConnectorSizeSampleTable sample_table_;  // Dataset structure to store all samples of connector size sampling
-  Timestamps ts_;                          // time of sample
+  ExecutionTree *tree_ = nullptr;                // ExecutionTree pointer
+  ConnectorSizeSampleTable sample_table_;        // Dataset structure to store all samples of connector size sampling
+  BufferMemorySampleTable buffer_memory_table_;  // Samples of buffer memory usage, in the same order as sample_table_
+  Timestamps ts_;                                // time of sample
 };
 
 }  // namespace dataset
@@ -562,6 +562,20 @@ Status ProfilingManager::GetConnectorSizeByTime(int32_t op_id, uint64_t start_ts
   return connector_node->GetOpConnectorSize(op_id, start_ts, end_ts, result);
 }
 
+Status ProfilingManager::GetBufferMemoryUsageByEpoch(int32_t op_id, int32_t epoch_num, std::vector<int64_t> *result) {
+  uint64_t start_ts = 0, end_ts = 0;
+  RETURN_IF_NOT_OK(EpochToTimeInterval(epoch_num, &start_ts, &end_ts));
+  return GetBufferMemoryUsageByTime(op_id, start_ts, end_ts, result);
+}
+
+Status ProfilingManager::GetBufferMemoryUsageByTime(int32_t op_id, uint64_t start_ts, uint64_t end_ts,
+                                                    std::vector<int64_t> *result) {
+  std::shared_ptr<Sampling> node;
+  RETURN_IF_NOT_OK(GetSamplingNode(kConnectorSizeSamplingName, &node));
+  auto connector_node = std::dynamic_pointer_cast<ConnectorSize>(node);
+  return connector_node->GetOpBufferMemoryUsage(op_id, start_ts, end_ts, result);
+}
+
 Status ProfilingManager::GetPipelineTimeByEpoch(int32_t epoch_num, std::vector<int32_t> *result) {
   uint32_t start_step = 0, end_step = 0;
   RETURN_IF_NOT_OK(EpochToStepInterval(epoch_num, &start_step, &end_step));
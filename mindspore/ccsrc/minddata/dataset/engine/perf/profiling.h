@@ -377,6 +377,21 @@ class ProfilingManager {
   /// \return Status object with the error code
   Status GetConnectorSizeByTime(int32_t op_id, uint64_t start_ts, uint64_t end_ts, std::vector<int32_t> *result);
 
+  /// \brief API to get the memory usage of the buffer of an MD operator, e.g. the shuffle buffer of ShuffleOp
+  /// \param [in] op_id The id of the operator
+  /// \param [in] epoch_num The epoch number for which results are requested
+  /// \param [out] result A vector with the sampled bytes held by the buffer, -1 if the operator does not buffer rows
+  /// \return Status object with the error code
+  Status GetBufferMemoryUsageByEpoch(int32_t op_id, int32_t epoch_num, std::vector<int64_t> *result);
+
+  /// \brief API to get the memory usage of the buffer of an MD operator, e.g. the shuffle buffer of ShuffleOp
+  /// \param [in] op_id The id of the operator
+  /// \param [in] start_ts The time interval start range in ms
+  /// \param [in] end_ts The time interval end range in ms
+  /// \param [out] result A vector with the sampled bytes held by the buffer, -1 if the operator does not buffer rows
+  /// \return Status object with the error code
+  Status GetBufferMemoryUsageByTime(int32_t op_id, uint64_t start_ts, uint64_t end_ts, std::vector<int64_t> *result);
+
   /// \brief API to get the connector size of DatasetIterator or DataQueueOp
   /// \param [in] epoch_num The epoch number for which results are requested
   /// \param [out] result A vector with connector size at each step
@@ -116,6 +116,9 @@ const int kMaxShardCount = 1000;  // write
 const int kMinConsumerCount = 1;
 const int kMaxConsumerCount = 128;
 
+// the rows read ahead but not consumed are at most kPrefetchBoundFactor times of the readahead size
+const size_t kPrefetchBoundFactor = 2;
+
 const int kMaxSchemaCount = 1;
 const int kMaxThreadCount = 32;
 const int kMaxFieldCount = 100;
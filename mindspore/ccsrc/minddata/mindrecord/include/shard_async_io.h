@@ -0,0 +1,164 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_ASYNC_IO_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_ASYNC_IO_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief a read request of a file range, the buffer is filled asynchronously by AsyncIOEngine
+class MINDRECORD_API AsyncReadRequest {
+ public:
+  AsyncReadRequest(int fd, uint64_t offset, uint64_t size) : fd_(fd), offset_(offset), buffer_(size) {}
+
+  ~AsyncReadRequest() = default;
+
+  AsyncReadRequest(const AsyncReadRequest &) = delete;
+  AsyncReadRequest &operator=(const AsyncReadRequest &) = delete;
+
+  /// \brief wait for the request to be completed
+  /// \return the status of read
+  Status Wait();
+
+  /// \brief whether the request is completed
+  bool IsDone();
+
+  /// \brief the buffer which holds the data, it is valid after Wait() returns OK
+  std::vector<uint8_t> *GetBuffer() { return &buffer_; }
+
+ private:
+  friend class AsyncIOEngine;
+
+  void Complete(const Status &rc);
+
+  int fd_;
+  uint64_t offset_;
+  std::vector<uint8_t> buffer_;
+  uint64_t read_bytes_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool done_{false};
+  Status rc_;
+};
+
+/// \brief the async io layer shared by the dataset leaf ops, the reads are submitted to io_uring if the kernel
+/// supports it, otherwise they are served by a few threads with pread
+class MINDRECORD_API AsyncIOEngine {
+ public:
+  static AsyncIOEngine &GetInstance();
+
+  ~AsyncIOEngine();
+
+  AsyncIOEngine(const AsyncIOEngine &) = delete;
+  AsyncIOEngine &operator=(const AsyncIOEngine &) = delete;
+
+  /// \brief submit a batch of read requests, the requests are completed asynchronously
+  /// \param[in] requests the read requests
+  /// \return Status
+  Status SubmitRead(const std::vector<std::shared_ptr<AsyncReadRequest>> &requests);
+
+  /// \brief whether the reads are submitted to io_uring
+  bool IsIOUringEnabled();
+
+  /// \brief the number of reads in flight for each reader, which is set by the env MS_DEV_DATASET_ASYNC_IO_DEPTH
+  /// \return the depth of readahead, 0 if the async io is disabled
+  static uint32_t GetReadaheadDepth();
+
+ private:
+  AsyncIOEngine() = default;
+
+  // initialize the backend lazily, io_uring is tried first
+  Status Init();
+  bool InitIOUring();
+  void FinalizeIOUring();
+  // submit the pending requests to io_uring as many as the queue depth allows, should be called with mutex_ held
+  void SubmitPendingToIOUring();
+  void IOUringCompletionLoop();
+  void ReadWorkerLoop();
+  // read the remaining bytes of the request with pread
+  static Status ReadRemaining(AsyncReadRequest *request);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool inited_{false};
+  std::atomic<bool> stop_{false};
+  bool use_io_uring_{false};
+  std::deque<std::shared_ptr<AsyncReadRequest>> pending_requests_;
+  std::unordered_map<AsyncReadRequest *, std::shared_ptr<AsyncReadRequest>> inflight_requests_;
+  std::vector<std::thread> threads_;
+
+  // the io_uring which is set up by raw syscalls, since liburing is not a dependency
+  struct IOUring;
+  std::unique_ptr<IOUring> ring_;
+};
+
+/// \brief read a file sequentially with readahead, the next chunks are read asynchronously while the current one
+/// is consumed
+class MINDRECORD_API AsyncSequentialReader {
+ public:
+  /// \brief constructor
+  /// \param[in] chunk_size the size of each read
+  /// \param[in] readahead_num the number of chunks which are read ahead
+  AsyncSequentialReader(uint64_t chunk_size, uint32_t readahead_num);
+
+  ~AsyncSequentialReader();
+
+  AsyncSequentialReader(const AsyncSequentialReader &) = delete;
+  AsyncSequentialReader &operator=(const AsyncSequentialReader &) = delete;
+
+  /// \brief open the file to be read
+  Status Open(const std::string &file_path);
+
+  /// \brief read the next bytes of file
+  /// \param[out] data the buffer to be filled, nullptr to skip the bytes
+  /// \param[in] size the number of bytes to be read
+  /// \return Status, error if the file has less bytes than required
+  Status Read(void *data, uint64_t size);
+
+  /// \brief whether all the bytes have been read
+  bool Eof() const { return position_ >= file_size_; }
+
+ private:
+  // submit the reads of chunks until readahead_num_ chunks are in flight
+  Status Readahead();
+
+  uint64_t chunk_size_;
+  uint32_t readahead_num_;
+  int fd_ = -1;
+  uint64_t file_size_ = 0;
+  uint64_t position_ = 0;        // the position of the next byte to be consumed
+  uint64_t next_offset_ = 0;     // the offset of the next chunk to be submitted
+  uint64_t chunk_position_ = 0;  // the position in the front chunk
+  std::deque<std::shared_ptr<AsyncReadRequest>> chunks_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_ASYNC_IO_H_
@@ -0,0 +1,169 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+// suffix of the columnar index file, which is written next to the mindrecord file and its ".db" meta file
+const char kColumnarIndexSuffix[] = ".idx";
+
+/// \brief the columns of locations which every row of the index has, the names are the same as the columns of
+/// sqlite table INDEXES
+enum class IndexColumn : uint32_t {
+  kRowId = 0,
+  kRowGroupId,
+  kPageIdRaw,
+  kPageOffsetRaw,
+  kPageOffsetRawEnd,
+  kPageIdBlob,
+  kPageOffsetBlob,
+  kPageOffsetBlobEnd,
+  kNum
+};
+
+/// \brief write the columnar index of a mindrecord file, the rows are added by ShardIndexGenerator while the sqlite
+/// index is generated
+class MINDRECORD_API ShardColumnarIndexWriter {
+ public:
+  /// \brief constructor
+  /// \param[in] shard_name the file name of mindrecord file, which is verified when the index is loaded
+  /// \param[in] fields the name and the sql type of index fields, e.g. {"label_0", "INTEGER"}
+  ShardColumnarIndexWriter(const std::string &shard_name,
+                           const std::vector<std::pair<std::string, std::string>> &fields)
+      : shard_name_(shard_name), fields_(fields), field_values_(fields.size()) {}
+
+  ~ShardColumnarIndexWriter() = default;
+
+  /// \brief add a row of index
+  /// \param[in] locations the values of the columns in IndexColumn
+  /// \param[in] values the values of index fields, in the order of fields
+  /// \return Status
+  Status AddRow(const std::vector<uint64_t> &locations, const std::vector<std::string> &values);
+
+  /// \brief sort the rows and write them to file
+  /// \param[in] file_path the path of index file
+  /// \param[in] meta_file_path the path of sqlite meta file, whose size and modification time are recorded
+  /// \return Status
+  Status Commit(const std::string &file_path, const std::string &meta_file_path);
+
+ private:
+  std::string shard_name_;
+  std::vector<std::pair<std::string, std::string>> fields_;
+  std::vector<std::vector<uint64_t>> rows_;
+  std::vector<std::vector<std::string>> field_values_;
+};
+
+/// \brief the columnar index of a mindrecord file. The locations of rows are stored as arrays ordered by row id, and
+/// each index field keeps the rows sorted by value, so the queries of ShardReader are served by binary search on the
+/// file mapped into memory instead of sql scans.
+class MINDRECORD_API ShardColumnarIndex {
+ public:
+  ShardColumnarIndex() = default;
+
+  ~ShardColumnarIndex();
+
+  ShardColumnarIndex(const ShardColumnarIndex &) = delete;
+  ShardColumnarIndex &operator=(const ShardColumnarIndex &) = delete;
+
+  /// \brief load the index file
+  /// \param[in] file_path the path of index file
+  /// \param[out] index_ptr the loaded index
+  /// \return Status, error if the file does not exist or is broken
+  static Status Load(const std::string &file_path, std::shared_ptr<ShardColumnarIndex> *index_ptr);
+
+  /// \brief the file name of mindrecord file which the index belongs to
+  const std::string &GetShardName() const { return shard_name_; }
+
+  uint64_t GetRowCount() const { return row_count_; }
+
+  /// \brief whether the meta file is the same as the one which the index is generated with, the index is stale if
+  /// the meta file has been regenerated or modified since, e.g. by the hash check or the encryption
+  bool MatchMetaFile(const std::string &meta_file_path) const;
+
+  /// \brief the rows whose ROW_ID equals to row_id
+  Status GetRowsByRowId(uint64_t row_id, std::vector<uint64_t> *rows) const;
+
+  /// \brief the rows in blob page, which are ordered by row id
+  /// \param[in] page_id the PAGE_ID_BLOB of rows
+  /// \param[in] criteria the name of index field and the value it should equal to, ignored if the name is empty
+  /// \param[out] rows the rows found
+  /// \return Status
+  Status GetRowsByPage(uint64_t page_id, const std::pair<std::string, std::string> &criteria,
+                       std::vector<uint64_t> *rows) const;
+
+  /// \brief the distinct blob pages which contain the rows satisfying the criteria, in ascending order
+  Status GetPagesByCriteria(const std::pair<std::string, std::string> &criteria, std::vector<uint64_t> *pages) const;
+
+  /// \brief the distinct values of index field
+  Status GetDistinctValues(const std::string &field, std::set<std::string> *values) const;
+
+  /// \brief fetch the columns of rows as text, which is the same as the result of sqlite
+  /// \param[in] columns the names of IndexColumn or index fields
+  /// \param[in] rows the rows to be fetched, all the rows are fetched if it is nullptr
+  /// \param[out] labels the values of columns of each row
+  /// \return Status
+  Status SelectRows(const std::vector<std::string> &columns, const std::vector<uint64_t> *rows,
+                    std::vector<std::vector<std::string>> *labels) const;
+
+ private:
+  struct Field {
+    std::string type;
+    const uint64_t *value_offsets{nullptr};  // row_count_ + 1 offsets in values
+    const uint64_t *sorted_rows{nullptr};    // rows sorted by value
+    const char *values{nullptr};
+  };
+
+  Status Parse();
+
+  Status GetField(const std::string &name, const Field **field) const;
+
+  // the rows of sorted_rows whose value equals to the given one, as [first, last)
+  std::pair<const uint64_t *, const uint64_t *> EqualRange(const Field &field, const std::string &value) const;
+
+  const uint64_t *GetColumn(IndexColumn column) const {
+    return locations_ + static_cast<uint64_t>(column) * row_count_;
+  }
+
+  const uint8_t *data_{nullptr};
+  uint64_t size_{0};
+  bool mapped_{false};
+  std::vector<uint8_t> buffer_;  // holds the file content if it can not be mapped
+
+  std::string shard_name_;
+  uint64_t row_count_{0};
+  uint64_t meta_file_size_{0};
+  uint64_t meta_file_mtime_{0};
+  const uint64_t *locations_{nullptr};         // the columns of IndexColumn, ordered by row id
+  const uint64_t *page_sorted_rows_{nullptr};  // rows sorted by PAGE_ID_BLOB
+  std::unordered_map<std::string, Field> fields_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
@@ -25,6 +25,7 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "./sqlite3.h"
 
@@ -99,6 +100,14 @@ class MINDRECORD_API ShardIndexGenerator {
 
   Status CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
+  /// \brief the names and sql types of index fields in columnar index
+  Status GenerateColumnarIndexFields(std::vector<std::pair<std::string, std::string>> *fields);
+
+  /// \brief add the rows which are inserted into sqlite to the columnar index
+  static Status AddRowsToColumnarIndex(const ROW_DATA &data,
+                                       const std::vector<std::pair<std::string, std::string>> &fields,
+                                       ShardColumnarIndexWriter *writer);
+
   Status AddBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,   // NOLINT
                          const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset,  // NOLINT
                          std::fstream &in);                                                          // NOLINT
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief a page of mindrecord file which is mapped into memory, it is unmapped when the last reference is released
+class MINDRECORD_API ShardMappedPage {
+ public:
+  ShardMappedPage(void *map_addr, uint64_t map_size, uint64_t page_shift, uint64_t page_size)
+      : map_addr_(map_addr), map_size_(map_size), page_shift_(page_shift), page_size_(page_size) {}
+
+  ~ShardMappedPage();
+
+  ShardMappedPage(const ShardMappedPage &) = delete;
+  ShardMappedPage &operator=(const ShardMappedPage &) = delete;
+
+  /// \brief the start address of the page
+  const uint8_t *GetData() const { return static_cast<const uint8_t *>(map_addr_) + page_shift_; }
+
+  /// \brief the size of the page, the last page of file may be smaller than the page size in header
+  uint64_t GetSize() const { return page_size_; }
+
+ private:
+  void *map_addr_;       // address returned by mmap, which is aligned to the system page
+  uint64_t map_size_;    // size of the mapped region
+  uint64_t page_shift_;  // shift of the mindrecord page in the mapped region
+  uint64_t page_size_;   // size of the mindrecord page
+};
+
+/// \brief a read-only view of the blob data in a mapped page, the view keeps the page mapped
+class MINDRECORD_API ShardBlobView {
+ public:
+  ShardBlobView() = default;
+
+  ShardBlobView(std::shared_ptr<ShardMappedPage> page, const uint8_t *data, uint64_t size)
+      : page_(std::move(page)), data_(data), size_(size) {}
+
+  ~ShardBlobView() = default;
+
+  const uint8_t *data() const { return data_; }
+
+  uint64_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  /// \brief the page which the view belongs to, nullptr if the view doesn't refer to a mapped page
+  const std::shared_ptr<ShardMappedPage> &page() const { return page_; }
+
+ private:
+  std::shared_ptr<ShardMappedPage> page_{nullptr};
+  const uint8_t *data_{nullptr};
+  uint64_t size_{0};
+};
+
+/// \brief mindrecord file which maps the pages into memory on demand, the mapped page is shared by all the views
+/// until they are released
+class MINDRECORD_API ShardMappedFile {
+ public:
+  ShardMappedFile() = default;
+
+  ~ShardMappedFile();
+
+  ShardMappedFile(const ShardMappedFile &) = delete;
+  ShardMappedFile &operator=(const ShardMappedFile &) = delete;
+
+  /// \brief open the file to be mapped
+  /// \param[in] file_path the path of mindrecord file
+  /// \return Status
+  Status Open(const std::string &file_path);
+
+  /// \brief map the page into memory, or share the page if it has been mapped
+  /// \param[in] page_id the id of page
+  /// \param[in] offset the offset of page in file
+  /// \param[in] page_size the page size in header
+  /// \param[out] page_ptr the mapped page
+  /// \return Status
+  Status MapPage(uint64_t page_id, uint64_t offset, uint64_t page_size, std::shared_ptr<ShardMappedPage> *page_ptr);
+
+  /// \brief the number of pages which are still referenced
+  size_t GetMappedPageNum();
+
+ private:
+  int fd_ = -1;
+  uint64_t file_size_ = 0;
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::weak_ptr<ShardMappedPage>> mapped_pages_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
@@ -42,11 +42,14 @@
 #include <vector>
 #include "minddata/mindrecord/include/common/log_adapter.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_async_io.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -58,6 +61,7 @@ namespace mindrecord {
 using ROW_GROUPS = std::pair<std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
 using ROW_GROUP_BRIEF = std::tuple<std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
+using TASK_VIEW_CONTENT = std::pair<TaskType, std::vector<std::tuple<ShardBlobView, json>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
 class MINDRECORD_API ShardReader {
@@ -184,6 +188,11 @@ class MINDRECORD_API ShardReader {
   Status GetNextById(const int64_t &task_id, const int32_t &consumer_id,
                      std::shared_ptr<TASK_CONTENT> *task_content_ptr);
 
+  /// \brief return a row by id without copying the blob data, zero copy should be enabled before opening
+  /// \return the views of blob data in the mapped page, the page is kept mapped until all the views are released
+  Status GetNextById(const int64_t &task_id, const int32_t &consumer_id,
+                     std::shared_ptr<TASK_VIEW_CONTENT> *task_content_ptr);
+
   /// \brief  get blob filed list
   /// \return blob field list
   std::pair<ShardType, std::vector<std::string>> GetBlobFields();
@@ -196,6 +205,21 @@ class MINDRECORD_API ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set flag of reading the blob data from the memory-mapped pages, should be called before opening
+  /// \return null
+  void SetZeroCopy(bool zero_copy) { zero_copy_ = zero_copy; }
+
+  /// \brief get flag of zero copy
+  bool GetZeroCopy() const { return zero_copy_; }
+
+  /// \brief set the number of sampled rows which are read ahead asynchronously, 0 to disable readahead. It only
+  /// works in fast load mode and should be called before opening
+  /// \return null
+  void SetPrefetchSize(uint32_t prefetch_size) { prefetch_size_ = prefetch_size; }
+
+  /// \brief get the number of sampled rows which are read ahead
+  uint32_t GetPrefetchSize() const { return prefetch_size_; }
+
   /// \brief get all classes
   Status GetAllClasses(const std::string &category_field, std::shared_ptr<std::set<std::string>> category_ptr);
 
@@ -239,8 +263,10 @@ class MINDRECORD_API ShardReader {
                                           std::shared_ptr<ROW_GROUPS> *row_group_ptr);
 
   /// \brief read all rows in one shard
-  Status ReadAllRowsInShard(int shard_id, const int32_t &consumer_id, const std::string &sql,
-                            const std::vector<std::string> &columns,
+  /// \param[in] fields the fields of index to be read
+  /// \param[in] row_id the row to be read, all the rows are read if it is negative
+  Status ReadAllRowsInShard(int shard_id, const int32_t &consumer_id, const std::vector<std::string> &fields,
+                            int64_t row_id, const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
@@ -266,10 +292,33 @@ class MINDRECORD_API ShardReader {
   /// \brief verify the validity of dataset
   Status VerifyDataset(sqlite3 **db, const string &file);
 
+  /// \brief load the columnar indexes of shards, the shard without a valid columnar index falls back to sqlite
+  void LoadColumnarIndexes(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary);
+
+  /// \brief get the columnar index of shard, nullptr if the shard is queried by sqlite
+  std::shared_ptr<ShardColumnarIndex> GetColumnarIndex(int shard_id);
+
+  /// \brief get the name of column in index, which is suffixed by its schema id
+  Status GetIndexFieldName(const std::string &column, std::string *field_name);
+
+  /// \brief query the fields of rows in blob page from the columnar index, which is the counterpart of the sql
+  /// "SELECT fields FROM INDEXES WHERE PAGE_ID_BLOB = page_id AND criteria"
+  Status QueryColumnarIndexByPage(const std::shared_ptr<ShardColumnarIndex> &columnar_index,
+                                  const std::vector<std::string> &fields, int page_id,
+                                  const std::pair<std::string, std::string> &criteria,
+                                  std::vector<std::vector<std::string>> *labels);
+
   /// \brief get column values
   Status GetLabels(int page_id, int shard_id, const std::vector<std::string> &columns,
                    const std::pair<std::string, std::string> &criteria, std::shared_ptr<std::vector<json>> *labels_ptr);
 
+  /// \brief convert the values of index fields to json by schema
+  Status ConvertIndexLabels(const std::vector<std::vector<std::string>> &labels,
+                            const std::vector<std::string> &columns, std::shared_ptr<std::vector<json>> *labels_ptr);
+
+  /// \brief convert the offsets of blob data in page
+  std::vector<std::vector<uint64_t>> ConvertImageOffsets(const std::vector<std::vector<std::string>> &image_offsets);
+
   /// \brief get column values from raw data page
   Status GetLabelsFromPage(int page_id, int shard_id, const std::vector<std::string> &columns,
                            const std::pair<std::string, std::string> &criteria,
@@ -302,13 +351,35 @@ class MINDRECORD_API ShardReader {
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
+  /// \brief get the location of blob data and the scalar variable fields of one task
+  Status GetTaskBlobLocation(int64_t task_id, uint32_t consumer_id, TaskType *task_type, uint32_t *shard_id,
+                             uint64_t *page_id, uint32_t *blob_start, uint32_t *blob_end, json *var_fields);
+
+  /// \brief open the files to be mapped into memory
+  Status OpenMappedFiles();
+
+  /// \brief get the real path of mindrecord file
+  Status GetRealFilePath(const std::string &file, std::string *real_path);
+
+  /// \brief open the files to be read ahead asynchronously
+  Status OpenPrefetchFiles();
+
+  /// \brief submit the reads of the next sampled rows, so that the window of readahead is kept full
+  Status PrefetchTasks(uint32_t consumer_id);
+
+  /// \brief take the read request of the task if it has been read ahead
+  std::shared_ptr<AsyncReadRequest> TakePrefetchedTask(int64_t task_id);
+
+  /// \brief wait for the inflight reads and drop the rows which are read ahead
+  void ClearPrefetchedTasks();
+
   /// \brief get labels from binary file
   Status GetLabelsFromBinaryFile(int shard_id, const std::vector<std::string> &columns,
                                  const std::vector<std::vector<std::string>> &label_offsets,
                                  std::shared_ptr<std::vector<json>> *labels_ptr);
 
   /// \brief get classes in one shard
-  void GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
+  void GetClassesInShard(sqlite3 *db, int shard_id, const std::string &field_name,
                          std::shared_ptr<std::set<std::string>> category_ptr);
 
   /// \brief get number of classes
@@ -326,9 +397,12 @@ class MINDRECORD_API ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardColumnarIndex>> columnar_indexes_;            // columnar index list
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files_;                   // memory-mapped file list
+  std::vector<int> prefetch_fds_;                                                // file handle list of readahead
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -341,6 +415,7 @@ class MINDRECORD_API ShardReader {
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
   bool interrupt_ = false;    // reader interrupted
+  bool zero_copy_ = false;    // read blob data from the memory-mapped pages
 
   int64_t num_padded_;  // number of padding samples
 
@@ -358,6 +433,15 @@ class MINDRECORD_API ShardReader {
   std::unordered_map<int, std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>>> delivery_map_;
   // Delivery/Iterator mode end
 
+  // Readahead begin
+  uint32_t prefetch_size_ = 0;         // number of sampled rows which are read ahead
+  std::mutex prefetch_mutex_;          // locker for readahead
+  int64_t prefetch_position_ = 0;      // index into the sample ids vector for the next row to be read ahead
+  std::atomic<int64_t> consumed_num_;  // number of rows which are consumed
+  // map of the task id to its read request
+  std::unordered_map<int64_t, std::shared_ptr<AsyncReadRequest>> prefetch_requests_;
+  // Readahead end
+
   // all metadata in the index is not loaded during initialization
   LoadMode load_mode_;
 
@@ -45,11 +45,20 @@ class MINDRECORD_API ShardShuffle : public ShardOperator {
   // Shuffle the file sequence but keep the order of data within each file
   Status ShuffleFiles(ShardTaskList &tasks);  // NOLINT
 
+  // Split each file into blocks of block_rows_ samples and shuffle the blocks of all files, the order of data within
+  // each block is kept, so the block is still read sequentially
+  Status ShuffleBlocks(ShardTaskList &tasks);  // NOLINT
+
+  // The number of samples in each block of Shuffle.FILES, which is set by the env MS_DEV_DATASET_SHUFFLE_BLOCK_ROWS.
+  // The whole file is a block if it is not set.
+  static int64_t GetBlockRows();
+
   uint32_t shuffle_seed_;
   int64_t no_of_samples_;
   bool replacement_;
   bool reshuffle_each_epoch_;
   ShuffleType shuffle_type_;
+  int64_t block_rows_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,475 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_async_io.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define MINDRECORD_ENABLE_IO_URING
+#endif
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr uint32_t kIOUringQueueDepth = 128;
+constexpr size_t kAsyncIOThreadNum = 4;
+constexpr unsigned long kMaxReadaheadDepth = 1024;
+// user data of the request to wake up the completion thread
+constexpr uint64_t kWakeUpUserData = 0;
+#ifdef MINDRECORD_ENABLE_IO_URING
+// the max number of opcodes in the probe of io_uring
+constexpr size_t kIOUringProbeOpNum = 256;
+
+// IORING_OP_READ is not supported before linux 5.6, and neither is IORING_REGISTER_PROBE
+bool IsIOUringReadSupported(int ring_fd) {
+  std::vector<uint8_t> buffer(sizeof(io_uring_probe) + kIOUringProbeOpNum * sizeof(io_uring_probe_op), 0);
+  auto probe = reinterpret_cast<io_uring_probe *>(buffer.data());
+  if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, kIOUringProbeOpNum) < 0) {
+    return false;
+  }
+  return probe->last_op >= IORING_OP_READ && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+#endif
+}  // namespace
+
+Status AsyncReadRequest::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return done_; });
+  return rc_;
+}
+
+bool AsyncReadRequest::IsDone() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return done_;
+}
+
+void AsyncReadRequest::Complete(const Status &rc) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rc_ = rc;
+    done_ = true;
+  }
+  cv_.notify_all();
+}
+
+#ifdef MINDRECORD_ENABLE_IO_URING
+struct AsyncIOEngine::IOUring {
+  int ring_fd = -1;
+  unsigned *sq_head = nullptr;
+  unsigned *sq_tail = nullptr;
+  unsigned *sq_mask = nullptr;
+  unsigned *sq_array = nullptr;
+  unsigned sq_entries = 0;
+  io_uring_sqe *sqes = nullptr;
+  unsigned *cq_head = nullptr;
+  unsigned *cq_tail = nullptr;
+  unsigned *cq_mask = nullptr;
+  io_uring_cqe *cqes = nullptr;
+  void *sq_ptr = nullptr;
+  size_t sq_size = 0;
+  void *cq_ptr = nullptr;
+  size_t cq_size = 0;
+  size_t sqes_size = 0;
+  // the number of requests which are submitted but not completed
+  unsigned inflight = 0;
+};
+
+bool AsyncIOEngine::InitIOUring() {
+  auto ring = std::make_unique<IOUring>();
+  io_uring_params params;
+  (void)memset(&params, 0, sizeof(params));
+  ring->ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, kIOUringQueueDepth, &params));
+  if (ring->ring_fd < 0) {
+    MS_LOG(INFO) << "io_uring is not available, errno: " << errno << ", the reads are served by threads.";
+    return false;
+  }
+  ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    ring->sq_size = std::max(ring->sq_size, ring->cq_size);
+    ring->cq_size = ring->sq_size;
+  }
+  ring->sq_ptr =
+    mmap(nullptr, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQ_RING);
+  ring->cq_ptr = single_mmap ? ring->sq_ptr
+                             : mmap(nullptr, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                    ring->ring_fd, IORING_OFF_CQ_RING);
+  ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  void *sqes = mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                    IORING_OFF_SQES);
+  ring_ = std::move(ring);
+  if (ring_->sq_ptr == MAP_FAILED || ring_->cq_ptr == MAP_FAILED || sqes == MAP_FAILED) {
+    MS_LOG(WARNING) << "Failed to map the rings of io_uring, errno: " << errno << ", the reads are served by threads.";
+    ring_->sqes = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe *>(sqes);
+    FinalizeIOUring();
+    return false;
+  }
+  auto sq_base = static_cast<uint8_t *>(ring_->sq_ptr);
+  ring_->sq_head = reinterpret_cast<unsigned *>(sq_base + params.sq_off.head);
+  ring_->sq_tail = reinterpret_cast<unsigned *>(sq_base + params.sq_off.tail);
+  ring_->sq_mask = reinterpret_cast<unsigned *>(sq_base + params.sq_off.ring_mask);
+  ring_->sq_array = reinterpret_cast<unsigned *>(sq_base + params.sq_off.array);
+  ring_->sq_entries = params.sq_entries;
+  ring_->sqes = static_cast<io_uring_sqe *>(sqes);
+  auto cq_base = static_cast<uint8_t *>(ring_->cq_ptr);
+  ring_->cq_head = reinterpret_cast<unsigned *>(cq_base + params.cq_off.head);
+  ring_->cq_tail = reinterpret_cast<unsigned *>(cq_base + params.cq_off.tail);
+  ring_->cq_mask = reinterpret_cast<unsigned *>(cq_base + params.cq_off.ring_mask);
+  ring_->cqes = reinterpret_cast<io_uring_cqe *>(cq_base + params.cq_off.cqes);
+  if (!IsIOUringReadSupported(ring_->ring_fd)) {
+    MS_LOG(INFO) << "The read of io_uring is not supported by the kernel, the reads are served by threads.";
+    FinalizeIOUring();
+    return false;
+  }
+  return true;
+}
+
+void AsyncIOEngine::FinalizeIOUring() {
+  if (ring_ == nullptr) {
+    return;
+  }
+  if (ring_->sqes != nullptr) {
+    (void)munmap(ring_->sqes, ring_->sqes_size);
+  }
+  if (ring_->cq_ptr != nullptr && ring_->cq_ptr != MAP_FAILED && ring_->cq_ptr != ring_->sq_ptr) {
+    (void)munmap(ring_->cq_ptr, ring_->cq_size);
+  }
+  if (ring_->sq_ptr != nullptr && ring_->sq_ptr != MAP_FAILED) {
+    (void)munmap(ring_->sq_ptr, ring_->sq_size);
+  }
+  if (ring_->ring_fd >= 0) {
+    (void)close(ring_->ring_fd);
+  }
+  ring_.reset();
+}
+
+void AsyncIOEngine::SubmitPendingToIOUring() {
+  unsigned tail = *ring_->sq_tail;
+  unsigned to_submit = 0;
+  // the number of inflight requests is limited by the queue depth, so that the completion queue never overflows
+  while (!pending_requests_.empty() && ring_->inflight < ring_->sq_entries) {
+    auto request = std::move(pending_requests_.front());
+    pending_requests_.pop_front();
+    unsigned index = tail & *ring_->sq_mask;
+    io_uring_sqe *sqe = &ring_->sqes[index];
+    (void)memset(sqe, 0, sizeof(io_uring_sqe));
+    if (request == nullptr) {
+      sqe->opcode = IORING_OP_NOP;
+      sqe->user_data = kWakeUpUserData;
+    } else {
+      sqe->opcode = IORING_OP_READ;
+      sqe->fd = request->fd_;
+      sqe->addr = reinterpret_cast<uint64_t>(request->buffer_.data() + request->read_bytes_);
+      sqe->len = static_cast<uint32_t>(request->buffer_.size() - request->read_bytes_);
+      sqe->off = request->offset_ + request->read_bytes_;
+      sqe->user_data = reinterpret_cast<uint64_t>(request.get());
+      inflight_requests_[request.get()] = request;
+    }
+    ring_->sq_array[index] = index;
+    ++tail;
+    ++to_submit;
+    ++ring_->inflight;
+  }
+  if (to_submit == 0) {
+    return;
+  }
+  __atomic_store_n(ring_->sq_tail, tail, __ATOMIC_RELEASE);
+  while (syscall(__NR_io_uring_enter, ring_->ring_fd, to_submit, 0, 0, nullptr, 0) < 0 && errno == EINTR) {
+  }
+}
+
+void AsyncIOEngine::IOUringCompletionLoop() {
+  for (;;) {
+    auto ret = syscall(__NR_io_uring_enter, ring_->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    if (ret < 0 && errno != EINTR) {
+      MS_LOG(ERROR) << "Failed to wait for the completion of io_uring, errno: " << errno;
+    }
+    std::vector<std::pair<std::shared_ptr<AsyncReadRequest>, Status>> completed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      unsigned head = *ring_->cq_head;
+      unsigned tail = __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE);
+      for (; head != tail; ++head) {
+        const io_uring_cqe &cqe = ring_->cqes[head & *ring_->cq_mask];
+        --ring_->inflight;
+        if (cqe.user_data == kWakeUpUserData) {
+          continue;
+        }
+        auto iter = inflight_requests_.find(reinterpret_cast<AsyncReadRequest *>(cqe.user_data));
+        if (iter == inflight_requests_.end()) {
+          continue;
+        }
+        auto request = std::move(iter->second);
+        (void)inflight_requests_.erase(iter);
+        if (cqe.res < 0) {
+          (void)completed.emplace_back(request, STATUS_ERROR_MR(StatusCode::kMDUnexpectedError,
+                                                                "Failed to read file asynchronously, errno: " +
+                                                                  std::to_string(-cqe.res)));
+        } else if (cqe.res == 0) {
+          (void)completed.emplace_back(request, STATUS_ERROR_MR(StatusCode::kMDUnexpectedError,
+                                                                "Failed to read file asynchronously, the offset: " +
+                                                                  std::to_string(request->offset_) +
+                                                                  " exceeds the end of file."));
+        } else {
+          request->read_bytes_ += static_cast<uint64_t>(cqe.res);
+          if (request->read_bytes_ < request->buffer_.size()) {
+            // submit the remaining bytes of short read again
+            pending_requests_.push_front(request);
+          } else {
+            (void)completed.emplace_back(request, Status::OK());
+          }
+        }
+      }
+      __atomic_store_n(ring_->cq_head, head, __ATOMIC_RELEASE);
+      SubmitPendingToIOUring();
+      if (stop_ && ring_->inflight == 0 && pending_requests_.empty()) {
+        break;
+      }
+    }
+    // notify the waiters without holding the lock of engine
+    for (auto &item : completed) {
+      item.first->Complete(item.second);
+    }
+  }
+}
+#else
+struct AsyncIOEngine::IOUring {};
+
+bool AsyncIOEngine::InitIOUring() { return false; }
+
+void AsyncIOEngine::FinalizeIOUring() { ring_.reset(); }
+
+void AsyncIOEngine::SubmitPendingToIOUring() {}
+
+void AsyncIOEngine::IOUringCompletionLoop() {}
+#endif
+
+AsyncIOEngine &AsyncIOEngine::GetInstance() {
+  static AsyncIOEngine instance;
+  return instance;
+}
+
+AsyncIOEngine::~AsyncIOEngine() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    if (use_io_uring_) {
+      // wake up the completion thread by a nop request
+      pending_requests_.push_back(nullptr);
+      SubmitPendingToIOUring();
+    }
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  FinalizeIOUring();
+}
+
+Status AsyncIOEngine::Init() {
+  if (inited_) {
+    return Status::OK();
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  use_io_uring_ = InitIOUring();
+  if (use_io_uring_) {
+    (void)threads_.emplace_back(&AsyncIOEngine::IOUringCompletionLoop, this);
+  } else {
+    for (size_t i = 0; i < kAsyncIOThreadNum; ++i) {
+      (void)threads_.emplace_back(&AsyncIOEngine::ReadWorkerLoop, this);
+    }
+  }
+  inited_ = true;
+  MS_LOG(INFO) << "Async io engine is initialized, io_uring enabled: " << use_io_uring_;
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("Async io is not supported on Windows.");
+#endif
+}
+
+bool AsyncIOEngine::IsIOUringEnabled() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Init().IsOk() && use_io_uring_;
+}
+
+uint32_t AsyncIOEngine::GetReadaheadDepth() {
+  std::string depth = common::GetEnv("MS_DEV_DATASET_ASYNC_IO_DEPTH");
+  if (depth.empty()) {
+    return 0;
+  }
+  try {
+    auto value = std::stoul(depth);
+    return static_cast<uint32_t>(std::min<unsigned long>(value, kMaxReadaheadDepth));
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "The value of MS_DEV_DATASET_ASYNC_IO_DEPTH: " << depth
+                    << " is invalid, it should be a non-negative integer, the async io is disabled.";
+    return 0;
+  }
+}
+
+Status AsyncIOEngine::SubmitRead(const std::vector<std::shared_ptr<AsyncReadRequest>> &requests) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(!stop_, "[Internal ERROR] Async io engine has been stopped.");
+    RETURN_IF_NOT_OK_MR(Init());
+    for (const auto &request : requests) {
+      RETURN_UNEXPECTED_IF_NULL_MR(request);
+      if (request->buffer_.empty()) {
+        request->Complete(Status::OK());
+        continue;
+      }
+      pending_requests_.push_back(request);
+    }
+    if (use_io_uring_) {
+      // the whole batch is submitted by one syscall
+      SubmitPendingToIOUring();
+      return Status::OK();
+    }
+  }
+  cv_.notify_all();
+  return Status::OK();
+}
+
+void AsyncIOEngine::ReadWorkerLoop() {
+  for (;;) {
+    std::shared_ptr<AsyncReadRequest> request;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !pending_requests_.empty(); });
+      if (pending_requests_.empty()) {
+        return;
+      }
+      request = std::move(pending_requests_.front());
+      pending_requests_.pop_front();
+    }
+    request->Complete(ReadRemaining(request.get()));
+  }
+}
+
+Status AsyncIOEngine::ReadRemaining(AsyncReadRequest *request) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  while (request->read_bytes_ < request->buffer_.size()) {
+    auto ret = pread(request->fd_, request->buffer_.data() + request->read_bytes_,
+                     request->buffer_.size() - request->read_bytes_,
+                     static_cast<off_t>(request->offset_ + request->read_bytes_));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ret >= 0, "Failed to read file asynchronously, errno: " + std::to_string(errno));
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ret > 0, "Failed to read file asynchronously, the offset: " +
+                                               std::to_string(request->offset_) + " exceeds the end of file.");
+    request->read_bytes_ += static_cast<uint64_t>(ret);
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("Async io is not supported on Windows.");
+#endif
+}
+
+AsyncSequentialReader::AsyncSequentialReader(uint64_t chunk_size, uint32_t readahead_num)
+    : chunk_size_(std::max<uint64_t>(chunk_size, 1)), readahead_num_(std::max<uint32_t>(readahead_num, 1)) {}
+
+AsyncSequentialReader::~AsyncSequentialReader() {
+  // the inflight reads should be completed before the file is closed
+  for (auto &chunk : chunks_) {
+    (void)chunk->Wait();
+  }
+  chunks_.clear();
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (fd_ >= 0) {
+    (void)close(fd_);
+  }
+#endif
+  fd_ = -1;
+}
+
+Status AsyncSequentialReader::Open(const std::string &file_path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd_ < 0, "[Internal ERROR] The file has been opened: " + file_path);
+  fd_ = open(file_path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd_ >= 0, "Invalid file, failed to open file: " + file_path +
+                                              ", errno: " + std::to_string(errno));
+  struct stat file_stat;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fstat(fd_, &file_stat) == 0, "Invalid file, failed to get the size of file: " +
+                                                                  file_path + ", errno: " + std::to_string(errno));
+  file_size_ = static_cast<uint64_t>(file_stat.st_size);
+  return Readahead();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("Async io is not supported on Windows.");
+#endif
+}
+
+Status AsyncSequentialReader::Readahead() {
+  std::vector<std::shared_ptr<AsyncReadRequest>> requests;
+  while (chunks_.size() < readahead_num_ && next_offset_ < file_size_) {
+    uint64_t size = std::min(chunk_size_, file_size_ - next_offset_);
+    auto request = std::make_shared<AsyncReadRequest>(fd_, next_offset_, size);
+    chunks_.push_back(request);
+    requests.push_back(request);
+    next_offset_ += size;
+  }
+  if (requests.empty()) {
+    return Status::OK();
+  }
+  return AsyncIOEngine::GetInstance().SubmitRead(requests);
+}
+
+Status AsyncSequentialReader::Read(void *data, uint64_t size) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd_ >= 0, "[Internal ERROR] The file is not opened.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(size <= file_size_ - std::min(position_, file_size_),
+                                  "Invalid file, failed to read " + std::to_string(size) +
+                                    " bytes at the offset: " + std::to_string(position_) +
+                                    ", the file size is: " + std::to_string(file_size_));
+  auto dst = static_cast<uint8_t *>(data);
+  while (size > 0) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(!chunks_.empty(), "[Internal ERROR] No chunk is read ahead.");
+    auto &chunk = chunks_.front();
+    RETURN_IF_NOT_OK_MR(chunk->Wait());
+    auto *buffer = chunk->GetBuffer();
+    uint64_t copy_size = std::min(size, buffer->size() - chunk_position_);
+    if (dst != nullptr) {
+      (void)std::copy(buffer->begin() + chunk_position_, buffer->begin() + chunk_position_ + copy_size, dst);
+      dst += copy_size;
+    }
+    chunk_position_ += copy_size;
+    position_ += copy_size;
+    size -= copy_size;
+    if (chunk_position_ == buffer->size()) {
+      chunks_.pop_front();
+      chunk_position_ = 0;
+      RETURN_IF_NOT_OK_MR(Readahead());
+    }
+  }
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,503 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_columnar_index.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// "MRCIDX" with the format version, the layout of file is:
+//   magic | version, field count | row count | shard name | size and modification time of meta file
+//   | locations: IndexColumn::kNum columns of row count uint64, ordered by ROW_ID
+//   | rows sorted by PAGE_ID_BLOB
+//   | for each field: name | type | row count + 1 offsets of values | rows sorted by value | values
+// the strings are stored as length and bytes, every section is aligned to 8 bytes
+constexpr uint64_t kColumnarIndexMagic = 0x000058444943524DULL;
+constexpr uint32_t kColumnarIndexVersion = 2;
+constexpr uint64_t kColumnarIndexAlign = 8;
+
+// the names of IndexColumn
+const std::vector<std::string> kIndexColumnNames = {
+  "ROW_ID",       "ROW_GROUP_ID",     "PAGE_ID_RAW",         "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END",
+  "PAGE_ID_BLOB", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
+
+// the size and the modification time in nanoseconds of file
+Status GetFileStamp(const std::string &file_path, uint64_t *size, uint64_t *mtime) {
+  struct stat file_stat;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(stat(file_path.c_str(), &file_stat) == 0,
+                                  "Invalid file, failed to get the status of file: " + file_path);
+  constexpr uint64_t kNanosecondsPerSecond = 1000000000;
+  *size = static_cast<uint64_t>(file_stat.st_size);
+#if defined(__linux__)
+  *mtime = static_cast<uint64_t>(file_stat.st_mtim.tv_sec) * kNanosecondsPerSecond +
+           static_cast<uint64_t>(file_stat.st_mtim.tv_nsec);
+#else
+  *mtime = static_cast<uint64_t>(file_stat.st_mtime) * kNanosecondsPerSecond;
+#endif
+  return Status::OK();
+}
+
+uint64_t AlignUp(uint64_t size) { return (size + kColumnarIndexAlign - 1) / kColumnarIndexAlign * kColumnarIndexAlign; }
+
+// the columns of TEXT and BLOB are compared as bytes, the others have numeric affinity in sqlite
+bool IsNumericType(const std::string &type) { return type != "TEXT" && type != "BLOB"; }
+
+bool ParseNumber(const std::string &value, long double *number) {
+  if (value.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  *number = std::strtold(value.c_str(), &end);
+  return errno == 0 && end == value.c_str() + value.size();
+}
+
+// order the values as sqlite: the numbers are compared by value and are less than the texts
+int CompareValue(bool numeric, const std::string &lhs, const std::string &rhs) {
+  if (numeric) {
+    long double lhs_number = 0;
+    long double rhs_number = 0;
+    bool lhs_is_number = ParseNumber(lhs, &lhs_number);
+    bool rhs_is_number = ParseNumber(rhs, &rhs_number);
+    if (lhs_is_number && rhs_is_number) {
+      return lhs_number < rhs_number ? -1 : (rhs_number < lhs_number ? 1 : 0);
+    }
+    if (lhs_is_number != rhs_is_number) {
+      return lhs_is_number ? -1 : 1;
+    }
+  }
+  return lhs.compare(rhs);
+}
+
+class IndexFileWriter {
+ public:
+  explicit IndexFileWriter(std::ofstream *out) : out_(out) {}
+
+  void WriteUInt64(uint64_t value) { WriteBytes(&value, sizeof(value)); }
+
+  void WriteUInt64Array(const std::vector<uint64_t> &values) {
+    WriteBytes(values.data(), values.size() * sizeof(uint64_t));
+  }
+
+  void WriteString(const std::string &value) {
+    WriteUInt64(value.size());
+    WriteBytes(value.data(), value.size());
+    Pad();
+  }
+
+  void WriteBytes(const void *data, uint64_t size) {
+    (void)out_->write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    written_ += size;
+  }
+
+  void Pad() {
+    static const char kZeros[kColumnarIndexAlign] = {0};
+    WriteBytes(kZeros, AlignUp(written_) - written_);
+  }
+
+ private:
+  std::ofstream *out_;
+  uint64_t written_{0};
+};
+
+class IndexFileReader {
+ public:
+  IndexFileReader(const uint8_t *data, uint64_t size) : data_(data), size_(size) {}
+
+  Status ReadUInt64(uint64_t *value) {
+    const uint64_t *ptr = nullptr;
+    RETURN_IF_NOT_OK_MR(ReadUInt64Array(1, &ptr));
+    *value = *ptr;
+    return Status::OK();
+  }
+
+  Status ReadUInt64Array(uint64_t num, const uint64_t **values) {
+    const uint8_t *bytes = nullptr;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(num <= size_ / sizeof(uint64_t), "Invalid columnar index, the file is truncated.");
+    RETURN_IF_NOT_OK_MR(ReadBytes(num * sizeof(uint64_t), &bytes));
+    *values = reinterpret_cast<const uint64_t *>(bytes);
+    return Status::OK();
+  }
+
+  Status ReadString(std::string *value) {
+    uint64_t len = 0;
+    const uint8_t *bytes = nullptr;
+    RETURN_IF_NOT_OK_MR(ReadUInt64(&len));
+    RETURN_IF_NOT_OK_MR(ReadBytes(len, &bytes));
+    value->assign(reinterpret_cast<const char *>(bytes), len);
+    return Status::OK();
+  }
+
+  // the bytes are skipped to the next aligned position
+  Status ReadBytes(uint64_t size, const uint8_t **bytes) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(size <= size_ - position_, "Invalid columnar index, the file is truncated.");
+    *bytes = data_ + position_;
+    position_ = std::min(size_, AlignUp(position_ + size));
+    return Status::OK();
+  }
+
+ private:
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t position_{0};
+};
+}  // namespace
+
+Status ShardColumnarIndexWriter::AddRow(const std::vector<uint64_t> &locations,
+                                        const std::vector<std::string> &values) {
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(locations.size() == static_cast<size_t>(IndexColumn::kNum),
+                                  "[Internal ERROR] The number of locations of row should be " +
+                                    std::to_string(static_cast<size_t>(IndexColumn::kNum)) + ", but got: " +
+                                    std::to_string(locations.size()));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(values.size() == fields_.size(),
+                                  "[Internal ERROR] The number of index field values should be " +
+                                    std::to_string(fields_.size()) + ", but got: " + std::to_string(values.size()));
+  rows_.push_back(locations);
+  for (size_t i = 0; i < values.size(); ++i) {
+    field_values_[i].push_back(values[i]);
+  }
+  return Status::OK();
+}
+
+Status ShardColumnarIndexWriter::Commit(const std::string &file_path, const std::string &meta_file_path) {
+  const uint64_t row_count = rows_.size();
+  uint64_t meta_file_size = 0;
+  uint64_t meta_file_mtime = 0;
+  RETURN_IF_NOT_OK_MR(GetFileStamp(meta_file_path, &meta_file_size, &meta_file_mtime));
+  auto column_value = [this](uint64_t row, IndexColumn column) { return rows_[row][static_cast<size_t>(column)]; };
+
+  // the rows are stored in the order of row id
+  std::vector<uint64_t> order(row_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&column_value](uint64_t lhs, uint64_t rhs) {
+    return column_value(lhs, IndexColumn::kRowId) < column_value(rhs, IndexColumn::kRowId);
+  });
+
+  // write to a temporary file first, so that the readers never see a partial index
+  std::string tmp_path = file_path + ".tmp";
+  std::ofstream out(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(out.good(),
+                                  "Invalid file, failed to open columnar index file for writing: " + tmp_path);
+  IndexFileWriter writer(&out);
+  writer.WriteUInt64(kColumnarIndexMagic);
+  uint32_t version_and_field_num[] = {kColumnarIndexVersion, static_cast<uint32_t>(fields_.size())};
+  writer.WriteBytes(version_and_field_num, sizeof(version_and_field_num));
+  writer.WriteUInt64(row_count);
+  writer.WriteString(shard_name_);
+  writer.WriteUInt64(meta_file_size);
+  writer.WriteUInt64(meta_file_mtime);
+
+  std::vector<uint64_t> column(row_count);
+  for (uint32_t col = 0; col < static_cast<uint32_t>(IndexColumn::kNum); ++col) {
+    for (uint64_t i = 0; i < row_count; ++i) {
+      column[i] = column_value(order[i], static_cast<IndexColumn>(col));
+    }
+    writer.WriteUInt64Array(column);
+  }
+
+  std::vector<uint64_t> sorted_rows(row_count);
+  std::iota(sorted_rows.begin(), sorted_rows.end(), 0);
+  std::stable_sort(sorted_rows.begin(), sorted_rows.end(), [&column_value, &order](uint64_t lhs, uint64_t rhs) {
+    return column_value(order[lhs], IndexColumn::kPageIdBlob) < column_value(order[rhs], IndexColumn::kPageIdBlob);
+  });
+  writer.WriteUInt64Array(sorted_rows);
+
+  for (size_t f = 0; f < fields_.size(); ++f) {
+    writer.WriteString(fields_[f].first);
+    writer.WriteString(fields_[f].second);
+    const auto &values = field_values_[f];
+    std::vector<uint64_t> value_offsets(row_count + 1, 0);
+    for (uint64_t i = 0; i < row_count; ++i) {
+      value_offsets[i + 1] = value_offsets[i] + values[order[i]].size();
+    }
+    writer.WriteUInt64Array(value_offsets);
+
+    bool numeric = IsNumericType(fields_[f].second);
+    std::iota(sorted_rows.begin(), sorted_rows.end(), 0);
+    std::stable_sort(sorted_rows.begin(), sorted_rows.end(), [&values, &order, numeric](uint64_t lhs, uint64_t rhs) {
+      return CompareValue(numeric, values[order[lhs]], values[order[rhs]]) < 0;
+    });
+    writer.WriteUInt64Array(sorted_rows);
+
+    for (uint64_t i = 0; i < row_count; ++i) {
+      writer.WriteBytes(values[order[i]].data(), values[order[i]].size());
+    }
+    writer.Pad();
+  }
+  out.close();
+  if (!out.good()) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED_MR("Invalid file, failed to write columnar index file: " + tmp_path);
+  }
+  (void)std::remove(file_path.c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(std::rename(tmp_path.c_str(), file_path.c_str()) == 0,
+                                  "Invalid file, failed to rename columnar index file to: " + file_path);
+  MS_LOG(INFO) << "Write " << row_count << " rows to columnar index: " << file_path;
+  return Status::OK();
+}
+
+ShardColumnarIndex::~ShardColumnarIndex() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (mapped_ && munmap(const_cast<uint8_t *>(data_), size_) != 0) {
+    MS_LOG(WARNING) << "Failed to unmap the columnar index, errno: " << errno;
+  }
+#endif
+  data_ = nullptr;
+}
+
+Status ShardColumnarIndex::Load(const std::string &file_path, std::shared_ptr<ShardColumnarIndex> *index_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(index_ptr);
+  auto index = std::make_shared<ShardColumnarIndex>();
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file_path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd >= 0, "Invalid file, failed to open columnar index: " + file_path);
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED_MR("Invalid file, failed to get the size of columnar index: " + file_path);
+  }
+  index->size_ = static_cast<uint64_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, index->size_, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(addr != MAP_FAILED,
+                                  "Failed to map columnar index: " + file_path + ", errno: " + std::to_string(errno));
+  index->data_ = static_cast<const uint8_t *>(addr);
+  index->mapped_ = true;
+#else
+  std::ifstream in(file_path, std::ios::in | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(in.good(), "Invalid file, failed to open columnar index: " + file_path);
+  index->buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  index->data_ = index->buffer_.data();
+  index->size_ = index->buffer_.size();
+#endif
+  RETURN_IF_NOT_OK_MR(index->Parse());
+  *index_ptr = index;
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::Parse() {
+  IndexFileReader reader(data_, size_);
+  uint64_t magic = 0;
+  RETURN_IF_NOT_OK_MR(reader.ReadUInt64(&magic));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(magic == kColumnarIndexMagic, "Invalid columnar index, the magic number mismatches.");
+  const uint8_t *bytes = nullptr;
+  RETURN_IF_NOT_OK_MR(reader.ReadBytes(sizeof(uint32_t) * 2, &bytes));
+  const uint32_t *version_and_field_num = reinterpret_cast<const uint32_t *>(bytes);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(version_and_field_num[0] == kColumnarIndexVersion,
+                                  "Invalid columnar index, the version: " + std::to_string(version_and_field_num[0]) +
+                                    " is not supported.");
+  uint32_t field_num = version_and_field_num[1];
+  RETURN_IF_NOT_OK_MR(reader.ReadUInt64(&row_count_));
+  RETURN_IF_NOT_OK_MR(reader.ReadString(&shard_name_));
+  RETURN_IF_NOT_OK_MR(reader.ReadUInt64(&meta_file_size_));
+  RETURN_IF_NOT_OK_MR(reader.ReadUInt64(&meta_file_mtime_));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(row_count_ <= size_ / sizeof(uint64_t),
+                                  "Invalid columnar index, the row count: " + std::to_string(row_count_) +
+                                    " exceeds the file size.");
+  RETURN_IF_NOT_OK_MR(reader.ReadUInt64Array(static_cast<uint64_t>(IndexColumn::kNum) * row_count_, &locations_));
+  RETURN_IF_NOT_OK_MR(reader.ReadUInt64Array(row_count_, &page_sorted_rows_));
+
+  for (uint32_t f = 0; f < field_num; ++f) {
+    std::string name;
+    Field field;
+    RETURN_IF_NOT_OK_MR(reader.ReadString(&name));
+    RETURN_IF_NOT_OK_MR(reader.ReadString(&field.type));
+    RETURN_IF_NOT_OK_MR(reader.ReadUInt64Array(row_count_ + 1, &field.value_offsets));
+    RETURN_IF_NOT_OK_MR(reader.ReadUInt64Array(row_count_, &field.sorted_rows));
+    RETURN_IF_NOT_OK_MR(reader.ReadBytes(field.value_offsets[row_count_], &bytes));
+    field.values = reinterpret_cast<const char *>(bytes);
+    for (uint64_t i = 0; i < row_count_; ++i) {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(
+        field.sorted_rows[i] < row_count_ && field.value_offsets[i] <= field.value_offsets[i + 1],
+        "Invalid columnar index, the index field: " + name + " is broken.");
+    }
+    fields_[name] = field;
+  }
+  for (uint64_t i = 0; i < row_count_; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(page_sorted_rows_[i] < row_count_, "Invalid columnar index, the rows are broken.");
+  }
+  return Status::OK();
+}
+
+bool ShardColumnarIndex::MatchMetaFile(const std::string &meta_file_path) const {
+  uint64_t meta_file_size = 0;
+  uint64_t meta_file_mtime = 0;
+  if (GetFileStamp(meta_file_path, &meta_file_size, &meta_file_mtime).IsError()) {
+    return false;
+  }
+  return meta_file_size == meta_file_size_ && meta_file_mtime == meta_file_mtime_;
+}
+
+Status ShardColumnarIndex::GetField(const std::string &name, const Field **field) const {
+  auto iter = fields_.find(name);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(iter != fields_.end(),
+                                  "[Internal ERROR] Index field: " + name + " can not found in columnar index.");
+  *field = &iter->second;
+  return Status::OK();
+}
+
+std::pair<const uint64_t *, const uint64_t *> ShardColumnarIndex::EqualRange(const Field &field,
+                                                                             const std::string &value) const {
+  bool numeric = IsNumericType(field.type);
+  auto less_than_value = [&field, numeric](uint64_t row, const std::string &val) {
+    std::string row_value(field.values + field.value_offsets[row],
+                          field.value_offsets[row + 1] - field.value_offsets[row]);
+    return CompareValue(numeric, row_value, val) < 0;
+  };
+  auto greater_than_value = [&field, numeric](const std::string &val, uint64_t row) {
+    std::string row_value(field.values + field.value_offsets[row],
+                          field.value_offsets[row + 1] - field.value_offsets[row]);
+    return CompareValue(numeric, val, row_value) < 0;
+  };
+  const uint64_t *first = std::lower_bound(field.sorted_rows, field.sorted_rows + row_count_, value, less_than_value);
+  const uint64_t *last = std::upper_bound(first, field.sorted_rows + row_count_, value, greater_than_value);
+  return std::make_pair(first, last);
+}
+
+Status ShardColumnarIndex::GetRowsByRowId(uint64_t row_id, std::vector<uint64_t> *rows) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(rows);
+  const uint64_t *row_ids = GetColumn(IndexColumn::kRowId);
+  auto range = std::equal_range(row_ids, row_ids + row_count_, row_id);
+  for (auto iter = range.first; iter != range.second; ++iter) {
+    rows->push_back(static_cast<uint64_t>(iter - row_ids));
+  }
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::GetRowsByPage(uint64_t page_id, const std::pair<std::string, std::string> &criteria,
+                                         std::vector<uint64_t> *rows) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(rows);
+  const uint64_t *page_ids = GetColumn(IndexColumn::kPageIdBlob);
+  const uint64_t *first =
+    std::lower_bound(page_sorted_rows_, page_sorted_rows_ + row_count_, page_id,
+                     [page_ids](uint64_t row, uint64_t id) { return page_ids[row] < id; });
+  const uint64_t *last = std::upper_bound(first, page_sorted_rows_ + row_count_, page_id,
+                                          [page_ids](uint64_t id, uint64_t row) { return id < page_ids[row]; });
+  const Field *field = nullptr;
+  if (!criteria.first.empty()) {
+    RETURN_IF_NOT_OK_MR(GetField(criteria.first, &field));
+  }
+  bool numeric = field != nullptr && IsNumericType(field->type);
+  for (auto iter = first; iter != last; ++iter) {
+    uint64_t row = *iter;
+    if (field != nullptr) {
+      std::string value(field->values + field->value_offsets[row],
+                        field->value_offsets[row + 1] - field->value_offsets[row]);
+      if (CompareValue(numeric, value, criteria.second) != 0) {
+        continue;
+      }
+    }
+    rows->push_back(row);
+  }
+  std::sort(rows->begin(), rows->end());
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::GetPagesByCriteria(const std::pair<std::string, std::string> &criteria,
+                                              std::vector<uint64_t> *pages) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(pages);
+  const uint64_t *page_ids = GetColumn(IndexColumn::kPageIdBlob);
+  if (criteria.first.empty()) {
+    for (uint64_t i = 0; i < row_count_; ++i) {
+      uint64_t page_id = page_ids[page_sorted_rows_[i]];
+      if (pages->empty() || pages->back() != page_id) {
+        pages->push_back(page_id);
+      }
+    }
+    return Status::OK();
+  }
+  const Field *field = nullptr;
+  RETURN_IF_NOT_OK_MR(GetField(criteria.first, &field));
+  auto range = EqualRange(*field, criteria.second);
+  for (auto iter = range.first; iter != range.second; ++iter) {
+    pages->push_back(page_ids[*iter]);
+  }
+  std::sort(pages->begin(), pages->end());
+  pages->erase(std::unique(pages->begin(), pages->end()), pages->end());
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::GetDistinctValues(const std::string &field_name, std::set<std::string> *values) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(values);
+  const Field *field = nullptr;
+  RETURN_IF_NOT_OK_MR(GetField(field_name, &field));
+  // the equal values are adjacent in the sorted rows
+  std::string last_value;
+  for (uint64_t i = 0; i < row_count_; ++i) {
+    uint64_t row = field->sorted_rows[i];
+    std::string value(field->values + field->value_offsets[row],
+                      field->value_offsets[row + 1] - field->value_offsets[row]);
+    if (i == 0 || value != last_value) {
+      (void)values->insert(value);
+      last_value = std::move(value);
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::SelectRows(const std::vector<std::string> &columns, const std::vector<uint64_t> *rows,
+                                      std::vector<std::vector<std::string>> *labels) const {
+  RETURN_UNEXPECTED_IF_NULL_MR(labels);
+  // resolve the columns before fetching the rows
+  std::vector<const uint64_t *> location_columns(columns.size(), nullptr);
+  std::vector<const Field *> field_columns(columns.size(), nullptr);
+  for (size_t i = 0; i < columns.size(); ++i) {
+    auto iter = std::find(kIndexColumnNames.begin(), kIndexColumnNames.end(), columns[i]);
+    if (iter != kIndexColumnNames.end()) {
+      location_columns[i] = GetColumn(static_cast<IndexColumn>(iter - kIndexColumnNames.begin()));
+    } else {
+      RETURN_IF_NOT_OK_MR(GetField(columns[i], &field_columns[i]));
+    }
+  }
+
+  uint64_t row_num = rows == nullptr ? row_count_ : rows->size();
+  labels->reserve(labels->size() + row_num);
+  for (uint64_t i = 0; i < row_num; ++i) {
+    uint64_t row = rows == nullptr ? i : (*rows)[i];
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(row < row_count_, "[Internal ERROR] The row: " + std::to_string(row) +
+                                                        " exceeds the row count of columnar index: " +
+                                                        std::to_string(row_count_));
+    std::vector<std::string> label;
+    label.reserve(columns.size());
+    for (size_t c = 0; c < columns.size(); ++c) {
+      if (location_columns[c] != nullptr) {
+        label.emplace_back(std::to_string(location_columns[c][row]));
+      } else {
+        const Field *field = field_columns[c];
+        label.emplace_back(field->values + field->value_offsets[row],
+                           field->value_offsets[row + 1] - field->value_offsets[row]);
+      }
+    }
+    labels->push_back(std::move(label));
+  }
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
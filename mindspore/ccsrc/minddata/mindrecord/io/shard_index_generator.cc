@@ -511,6 +511,13 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
       "-a): " +
       shard_address);
   }
+  // the columnar index is written along with the sqlite index
+  std::shared_ptr<std::string> fn_ptr;
+  RELEASE_AND_RETURN_IF_NOT_OK_MR(GetFileName(shard_address, &fn_ptr), db, in);
+  std::vector<std::pair<std::string, std::string>> index_fields;
+  RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateColumnarIndexFields(&index_fields), db, in);
+  ShardColumnarIndexWriter columnar_index_writer(*fn_ptr, index_fields);
+
   auto sql_code = sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   if (sql_code != SQLITE_OK) {
     in.close();
@@ -524,6 +531,8 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
     RELEASE_AND_RETURN_IF_NOT_OK_MR(GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, &row_data_ptr), db,
                                     in);
     RELEASE_AND_RETURN_IF_NOT_OK_MR(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
+    RELEASE_AND_RETURN_IF_NOT_OK_MR(AddRowsToColumnarIndex(*row_data_ptr, index_fields, &columnar_index_writer), db,
+                                    in);
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
   }
   sql_code = sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
@@ -538,6 +547,50 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   // Close database
   sqlite3_close(db);
   db = nullptr;
+  return columnar_index_writer.Commit(shard_address + kColumnarIndexSuffix, shard_address + ".db");
+}
+
+Status ShardIndexGenerator::GenerateColumnarIndexFields(std::vector<std::pair<std::string, std::string>> *fields) {
+  RETURN_UNEXPECTED_IF_NULL_MR(fields);
+  for (const auto &field : fields_) {
+    std::shared_ptr<Schema> schema_ptr;
+    RETURN_IF_NOT_OK_MR(shard_header_.GetSchemaByID(field.first, &schema_ptr));
+    json json_schema = (schema_ptr->GetSchema())["schema"];
+    std::shared_ptr<std::string> fn_ptr;
+    RETURN_IF_NOT_OK_MR(GenerateFieldName(field, &fn_ptr));
+    fields->emplace_back(*fn_ptr, ConvertJsonToSQL(TakeFieldType(field.second, json_schema)));
+  }
+  return Status::OK();
+}
+
+Status ShardIndexGenerator::AddRowsToColumnarIndex(const ROW_DATA &data,
+                                                   const std::vector<std::pair<std::string, std::string>> &fields,
+                                                   ShardColumnarIndexWriter *writer) {
+  RETURN_UNEXPECTED_IF_NULL_MR(writer);
+  const std::vector<std::string> location_place_holders = {
+    ":ROW_ID",       ":ROW_GROUP_ID",     ":PAGE_ID_RAW",         ":PAGE_OFFSET_RAW", ":PAGE_OFFSET_RAW_END",
+    ":PAGE_ID_BLOB", ":PAGE_OFFSET_BLOB", ":PAGE_OFFSET_BLOB_END"};
+  for (auto &row : data) {
+    std::map<std::string, std::string> row_values;
+    for (auto &field : row) {
+      row_values[std::get<0>(field)] = std::get<2>(field);
+    }
+    std::vector<uint64_t> locations;
+    for (const auto &place_holder : location_place_holders) {
+      auto iter = row_values.find(place_holder);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(iter != row_values.end(),
+                                      "[Internal ERROR] Failed to get " + place_holder + " of index row.");
+      locations.push_back(std::stoull(iter->second));
+    }
+    std::vector<std::string> values;
+    for (const auto &field : fields) {
+      auto iter = row_values.find(":" + field.first);
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(iter != row_values.end(),
+                                      "[Internal ERROR] Failed to get index field " + field.first + " of index row.");
+      values.push_back(iter->second);
+    }
+    RETURN_IF_NOT_OK_MR(writer->AddRow(locations, values));
+  }
   return Status::OK();
 }
 
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+
+namespace mindspore {
+namespace mindrecord {
+ShardMappedPage::~ShardMappedPage() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (map_addr_ != nullptr && munmap(map_addr_, map_size_) != 0) {
+    MS_LOG(WARNING) << "Failed to unmap the page of mindrecord file, errno: " << errno;
+  }
+#endif
+  map_addr_ = nullptr;
+}
+
+ShardMappedFile::~ShardMappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  // the mapped pages are still valid after the file is closed
+  if (fd_ >= 0) {
+    (void)close(fd_);
+  }
+#endif
+  fd_ = -1;
+}
+
+Status ShardMappedFile::Open(const std::string &file_path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd_ < 0, "[Internal ERROR] The mapped file has been opened: " + file_path);
+  fd_ = open(file_path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    fd_ >= 0, "Invalid file, failed to open file for mapping mindrecord files. Please check file path, permission and "
+              "open files limit(ulimit -a): " +
+                file_path);
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    (void)close(fd_);
+    fd_ = -1;
+    RETURN_STATUS_UNEXPECTED_MR("Invalid file, failed to get the size of mindrecord file: " + file_path);
+  }
+  file_size_ = static_cast<uint64_t>(file_stat.st_size);
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("Mapping mindrecord file into memory is not supported on Windows.");
+#endif
+}
+
+Status ShardMappedFile::MapPage(uint64_t page_id, uint64_t offset, uint64_t page_size,
+                                std::shared_ptr<ShardMappedPage> *page_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(page_ptr);
+#if !defined(_WIN32) && !defined(_WIN64)
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = mapped_pages_.find(page_id);
+  if (iter != mapped_pages_.end()) {
+    *page_ptr = iter->second.lock();
+    if (*page_ptr != nullptr) {
+      return Status::OK();
+    }
+    (void)mapped_pages_.erase(iter);
+  }
+
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd_ >= 0, "[Internal ERROR] The mapped file is not opened.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(offset < file_size_, "[Internal ERROR] The offset of page: " +
+                                                         std::to_string(offset) + " exceeds the file size: " +
+                                                         std::to_string(file_size_));
+  // the offset of mmap should be aligned to the system page
+  static const uint64_t kSystemPageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t map_offset = offset / kSystemPageSize * kSystemPageSize;
+  uint64_t page_shift = offset - map_offset;
+  uint64_t real_page_size = std::min(page_size, file_size_ - offset);
+  uint64_t map_size = page_shift + real_page_size;
+  // the page is mapped privately, so that the tensors wrapping it can be written with copy-on-write
+  void *map_addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd_, static_cast<off_t>(map_offset));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(map_addr != MAP_FAILED, "Failed to map the page: " + std::to_string(page_id) +
+                                                            " of mindrecord file, errno: " + std::to_string(errno));
+  *page_ptr = std::make_shared<ShardMappedPage>(map_addr, map_size, page_shift, real_page_size);
+  mapped_pages_[page_id] = *page_ptr;
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("Mapping mindrecord file into memory is not supported on Windows.");
+#endif
+}
+
+size_t ShardMappedFile::GetMappedPageNum() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<size_t>(std::count_if(mapped_pages_.begin(), mapped_pages_.end(),
+                                           [](const auto &item) { return !item.second.expired(); }));
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -16,6 +16,10 @@
 
 #include "minddata/mindrecord/include/shard_reader.h"
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include <algorithm>
 #include <thread>
 
@@ -44,6 +48,7 @@ ShardReader::ShardReader()
       total_blob_size_(0),
       sample_id_position_(0),
       deliver_id_(0),
+      consumed_num_(0),
       load_mode_(LoadMode::kFast),
       shard_sample_count_() {}
 
@@ -108,6 +113,7 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
   for (const auto &rg : row_group_summary) {
     num_rows_ += std::get<get_index>(rg);
   }
+  LoadColumnarIndexes(row_group_summary);
 
   if (num_rows_ > SLOW_LOAD_THRESHOLD) {
     load_mode_ = LoadMode::kSlow;
@@ -181,6 +187,75 @@ Status ShardReader::VerifyDataset(sqlite3 **db, const string &file) {
   return Status::OK();
 }
 
+void ShardReader::LoadColumnarIndexes(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary) {
+  constexpr int64_t get_index = 3;
+  std::vector<uint64_t> shard_rows(file_paths_.size(), 0);
+  for (const auto &rg : row_group_summary) {
+    auto shard_id = static_cast<size_t>(std::get<0>(rg));
+    if (shard_id < shard_rows.size()) {
+      shard_rows[shard_id] += std::get<get_index>(rg);
+    }
+  }
+  columnar_indexes_.assign(file_paths_.size(), nullptr);
+  for (size_t shard_id = 0; shard_id < file_paths_.size(); ++shard_id) {
+    std::string index_path = file_paths_[shard_id] + kColumnarIndexSuffix;
+    if (!std::ifstream(index_path).good()) {
+      MS_LOG(INFO) << "The columnar index: " << index_path << " does not exist, query the index by meta file.";
+      continue;
+    }
+    std::shared_ptr<ShardColumnarIndex> columnar_index;
+    std::shared_ptr<std::string> fn_ptr;
+    auto rc = ShardColumnarIndex::Load(index_path, &columnar_index);
+    if (rc.IsOk()) {
+      rc = GetFileName(file_paths_[shard_id], &fn_ptr);
+    }
+    // the stale index which is left by the files generated before is ignored
+    if (rc.IsError() || columnar_index->GetShardName() != *fn_ptr ||
+        columnar_index->GetRowCount() != shard_rows[shard_id] ||
+        !columnar_index->MatchMetaFile(file_paths_[shard_id] + ".db")) {
+      MS_LOG(WARNING) << "The columnar index: " << index_path
+                      << " does not match the mindrecord file, query the index by meta file. " << rc.ToString();
+      continue;
+    }
+    columnar_indexes_[shard_id] = columnar_index;
+  }
+}
+
+std::shared_ptr<ShardColumnarIndex> ShardReader::GetColumnarIndex(int shard_id) {
+  if (shard_id < 0 || shard_id >= static_cast<int>(columnar_indexes_.size())) {
+    return nullptr;
+  }
+  return columnar_indexes_[shard_id];
+}
+
+Status ShardReader::GetIndexFieldName(const std::string &column, std::string *field_name) {
+  RETURN_UNEXPECTED_IF_NULL_MR(field_name);
+  for (const auto &field : GetShardHeader()->GetFields()) {
+    if (field.second == column) {
+      std::shared_ptr<std::string> fn_ptr;
+      RETURN_IF_NOT_OK_MR(ShardIndexGenerator::GenerateFieldName(field, &fn_ptr));
+      *field_name = *fn_ptr;
+      return Status::OK();
+    }
+  }
+  RETURN_STATUS_UNEXPECTED_MR("Invalid data, column: " + column + " can not found in index fields.");
+}
+
+Status ShardReader::QueryColumnarIndexByPage(const std::shared_ptr<ShardColumnarIndex> &columnar_index,
+                                             const std::vector<std::string> &fields, int page_id,
+                                             const std::pair<std::string, std::string> &criteria,
+                                             std::vector<std::vector<std::string>> *labels) {
+  RETURN_UNEXPECTED_IF_NULL_MR(columnar_index);
+  RETURN_UNEXPECTED_IF_NULL_MR(labels);
+  std::pair<std::string, std::string> index_criteria{"", criteria.second};
+  if (!criteria.first.empty()) {
+    RETURN_IF_NOT_OK_MR(GetIndexFieldName(criteria.first, &index_criteria.first));
+  }
+  std::vector<uint64_t> rows;
+  RETURN_IF_NOT_OK_MR(columnar_index->GetRowsByPage(page_id, index_criteria, &rows));
+  return columnar_index->SelectRows(fields, &rows, labels);
+}
+
 Status ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
   auto schema_ptr = GetShardHeader()->GetSchemas()[0];
   auto schema = schema_ptr->GetSchema()["schema"];
@@ -225,9 +300,130 @@ Status ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Succeed to open file, path: " << file;
   }
+  if (zero_copy_) {
+    RETURN_IF_NOT_OK_MR(OpenMappedFiles());
+  }
+  if (prefetch_size_ > 0 && load_mode_ == LoadMode::kFast) {
+    RETURN_IF_NOT_OK_MR(OpenPrefetchFiles());
+  }
   return Status::OK();
 }
 
+Status ShardReader::GetRealFilePath(const std::string &file, std::string *real_path) {
+  RETURN_UNEXPECTED_IF_NULL_MR(real_path);
+  std::optional<std::string> dir = "";
+  std::optional<std::string> local_file_name = "";
+  FileUtils::SplitDirAndFileName(file, &dir, &local_file_name);
+  if (!dir.has_value()) {
+    dir = ".";
+  }
+
+  auto realpath = FileUtils::GetRealPath(dir.value().c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    realpath.has_value(), "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file);
+
+  std::optional<std::string> whole_path = "";
+  FileUtils::ConcatDirAndFileName(&realpath, &local_file_name, &whole_path);
+  *real_path = whole_path.value();
+  return Status::OK();
+}
+
+Status ShardReader::OpenMappedFiles() {
+  mapped_files_.clear();
+  for (const auto &file : file_paths_) {
+    std::string whole_path;
+    RETURN_IF_NOT_OK_MR(GetRealFilePath(file, &whole_path));
+    auto mapped_file = std::make_shared<ShardMappedFile>();
+    RETURN_IF_NOT_OK_MR(mapped_file->Open(whole_path));
+    mapped_files_.push_back(mapped_file);
+    MS_LOG(INFO) << "Succeed to open file for mapping, path: " << file;
+  }
+  return Status::OK();
+}
+
+Status ShardReader::OpenPrefetchFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (const auto &file : file_paths_) {
+    std::string whole_path;
+    RETURN_IF_NOT_OK_MR(GetRealFilePath(file, &whole_path));
+    int fd = open(whole_path.c_str(), O_RDONLY);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      fd >= 0, "Invalid file, failed to open files for reading mindrecord files ahead. Please check file path, "
+               "permission and open files limit(ulimit -a): " +
+                 file);
+    prefetch_fds_.push_back(fd);
+  }
+  MS_LOG(INFO) << "Succeed to open files for readahead, the number of rows read ahead: " << prefetch_size_;
+#else
+  MS_LOG(WARNING) << "Reading mindrecord files ahead is not supported on Windows, readahead is disabled.";
+  prefetch_size_ = 0;
+#endif
+  return Status::OK();
+}
+
+Status ShardReader::PrefetchTasks(uint32_t consumer_id) {
+  std::vector<std::shared_ptr<AsyncReadRequest>> requests;
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    const auto &sample_ids = tasks_.sample_ids_;
+    int64_t window_end = std::min(consumed_num_.load() + static_cast<int64_t>(prefetch_size_),
+                                  static_cast<int64_t>(sample_ids.size()));
+    // the rows which are read ahead but not consumed are bounded, in case they are sampled in a different order
+    while (prefetch_position_ < window_end && prefetch_requests_.size() < kPrefetchBoundFactor * prefetch_size_) {
+      int64_t task_id = sample_ids[prefetch_position_++];
+      if (prefetch_requests_.find(task_id) != prefetch_requests_.end()) {
+        continue;
+      }
+      TaskType task_type = TaskType::kCommonTask;
+      uint32_t shard_id = 0;
+      uint64_t page_id = 0;
+      uint32_t blob_start = 0;
+      uint32_t blob_end = 0;
+      json var_fields;
+      RETURN_IF_NOT_OK_MR(GetTaskBlobLocation(task_id, consumer_id, &task_type, &shard_id, &page_id, &blob_start,
+                                              &blob_end, &var_fields));
+      if (task_type == TaskType::kPaddedTask) {
+        continue;
+      }
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_id < prefetch_fds_.size(), "[Internal ERROR] 'shard_id': " +
+                                                                         std::to_string(shard_id) + " is out of bound.");
+      auto request = std::make_shared<AsyncReadRequest>(
+        prefetch_fds_[shard_id], header_size_ + page_size_ * page_id + blob_start, blob_end - blob_start);
+      prefetch_requests_[task_id] = request;
+      requests.push_back(request);
+    }
+  }
+  if (requests.empty()) {
+    return Status::OK();
+  }
+  return AsyncIOEngine::GetInstance().SubmitRead(requests);
+}
+
+std::shared_ptr<AsyncReadRequest> ShardReader::TakePrefetchedTask(int64_t task_id) {
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  auto iter = prefetch_requests_.find(task_id);
+  if (iter == prefetch_requests_.end()) {
+    return nullptr;
+  }
+  auto request = std::move(iter->second);
+  (void)prefetch_requests_.erase(iter);
+  return request;
+}
+
+void ShardReader::ClearPrefetchedTasks() {
+  std::unordered_map<int64_t, std::shared_ptr<AsyncReadRequest>> requests;
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    requests.swap(prefetch_requests_);
+    prefetch_position_ = 0;
+    consumed_num_ = 0;
+  }
+  // the buffers of inflight reads should not be released before they are completed, wait without holding the lock
+  for (auto &item : requests) {
+    (void)item.second->Wait();
+  }
+}
+
 Status ShardReader::ExtendRandomFileStreams(const int n_new_consumers) {
   CHECK_FAIL_RETURN_UNEXPECTED_MR(n_new_consumers > 0,
                                   "n_new_consumers must be a positive number. Got: " + std::to_string(n_new_consumers));
@@ -309,6 +505,15 @@ Status ShardReader::ShrinkRandomFileStreams(const int n_remove_consumers) {
 }
 
 void ShardReader::FileStreamsOperator() {
+  // the mapped pages referenced by the views are unmapped when the views are released
+  mapped_files_.clear();
+  ClearPrefetchedTasks();
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto fd : prefetch_fds_) {
+    (void)close(fd);
+  }
+#endif
+  prefetch_fds_.clear();
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
       file_streams_[i]->close();
@@ -487,26 +692,42 @@ Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, cons
   }
   return Status::OK();
 }
-Status ShardReader::ReadAllRowsInShard(int shard_id, const int32_t &consumer_id, const std::string &sql,
+Status ShardReader::ReadAllRowsInShard(int shard_id, const int32_t &consumer_id,
+                                       const std::vector<std::string> &fields, int64_t row_id,
                                        const std::vector<std::string> &columns,
                                        std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                                        std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
-  auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
-  char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
-  if (rc != SQLITE_OK) {
-    std::ostringstream oss;
-    oss << "[Internal ERROR] Failed to execute the sql [ " << sql << " ] while reading meta file, " << errmsg;
+  auto columnar_index = GetColumnarIndex(shard_id);
+  if (columnar_index != nullptr) {
+    if (row_id < 0) {
+      RETURN_IF_NOT_OK_MR(columnar_index->SelectRows(fields, nullptr, &labels));
+    } else {
+      std::vector<uint64_t> rows;
+      RETURN_IF_NOT_OK_MR(columnar_index->GetRowsByRowId(static_cast<uint64_t>(row_id), &rows));
+      RETURN_IF_NOT_OK_MR(columnar_index->SelectRows(fields, &rows, &labels));
+    }
+  } else {
+    std::string sql = "SELECT ";
+    for (size_t i = 0; i < fields.size(); ++i) {
+      sql += (i == 0 ? "" : ", ") + fields[i];
+    }
+    sql += row_id < 0 ? " FROM INDEXES ORDER BY ROW_ID ;" : " FROM INDEXES WHERE ROW_ID = " + std::to_string(row_id);
+    auto db = database_paths_[shard_id];
+    char *errmsg = nullptr;
+    int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
+    if (rc != SQLITE_OK) {
+      std::ostringstream oss;
+      oss << "[Internal ERROR] Failed to execute the sql [ " << sql << " ] while reading meta file, " << errmsg;
+      sqlite3_free(errmsg);
+      sqlite3_close(db);
+      db = nullptr;
+      RETURN_STATUS_UNEXPECTED_MR(oss.str());
+    }
     sqlite3_free(errmsg);
-    sqlite3_close(db);
-    db = nullptr;
-    RETURN_STATUS_UNEXPECTED_MR(oss.str());
   }
   MS_LOG(DEBUG) << "Succeed to get " << labels.size() << " records from shard " << std::to_string(shard_id)
                 << " index.";
-
-  sqlite3_free(errmsg);
   return ConvertLabelToJson(labels, file_streams_random_[consumer_id][shard_id], offset_ptr, shard_id, columns,
                             col_val_ptr);
 }
@@ -524,10 +745,9 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   std::shared_ptr<std::string> fn_ptr;
   RETURN_IF_NOT_OK_MR(
     ShardIndexGenerator::GenerateFieldName(std::make_pair(index_columns[category_field], category_field), &fn_ptr));
-  std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
+    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, *fn_ptr, category_ptr);
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -536,11 +756,24 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   return Status::OK();
 }
 
-void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
+void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string &field_name,
                                     std::shared_ptr<std::set<std::string>> category_ptr) {
+  auto columnar_index = GetColumnarIndex(shard_id);
+  if (columnar_index != nullptr) {
+    std::set<std::string> categories;
+    auto rc = columnar_index->GetDistinctValues(field_name, &categories);
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << rc.ToString();
+      return;
+    }
+    std::lock_guard<std::mutex> lck(shard_locker_);
+    category_ptr->insert(categories.begin(), categories.end());
+    return;
+  }
   if (db == nullptr) {
     return;
   }
+  std::string sql = "SELECT DISTINCT " + field_name + " FROM INDEXES";
   std::vector<std::vector<std::string>> columns;
   char *errmsg = nullptr;
   int ret = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &columns, &errmsg);
@@ -564,30 +797,27 @@ void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string
 Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
                                     std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(row_group_ptr);
-  std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
+  std::vector<std::string> fields = {"ROW_GROUP_ID", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
 
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
-      fields += ',';
       std::shared_ptr<std::string> fn_ptr;
       RETURN_IF_NOT_OK_MR(
         ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_[columns[i]], columns[i]), &fn_ptr));
-      fields += *fn_ptr;
+      fields.push_back(*fn_ptr);
     }
   } else {  // fetch raw data from Raw page while some field is not index.
-    fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END ";
+    fields.insert(fields.end(), {"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END"});
   }
 
-  std::string sql = "SELECT " + fields + " FROM INDEXES ORDER BY ROW_ID ;";
-
   std::vector<std::future<Status>> async_results;
   auto status = Status::OK();
   for (int x = 0; x < shard_count_; x++) {
-    async_results.push_back(std::async(std::launch::async, &ShardReader::ReadAllRowsInShard, this, x, 0, sql, columns,
-                                       offset_ptr, col_val_ptr));
+    async_results.push_back(std::async(std::launch::async, &ShardReader::ReadAllRowsInShard, this, x, 0, fields, -1,
+                                       columns, offset_ptr, col_val_ptr));
   }
 
   for (auto i = 0; i < async_results.size(); i++) {
@@ -607,25 +837,23 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
                                                      const int32_t &consumer_id, const uint32_t &sample_id,
                                                      std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(row_group_ptr);
-  std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
+  std::vector<std::string> fields = {"ROW_GROUP_ID", "PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"};
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
-      fields += ',';
       std::shared_ptr<std::string> fn_ptr;
       RETURN_IF_NOT_OK_MR(
         ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_[columns[i]], columns[i]), &fn_ptr));
-      fields += *fn_ptr;
+      fields.push_back(*fn_ptr);
     }
   } else {  // fetch raw data from Raw page while some field is not index.
-    fields += ", PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END ";
+    fields.insert(fields.end(), {"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END"});
   }
 
-  std::string sql = "SELECT " + fields + " FROM INDEXES WHERE ROW_ID = " + std::to_string(sample_id);
-
-  RETURN_IF_NOT_OK_MR(ReadAllRowsInShard(shard_id, consumer_id, sql, columns, offset_ptr, col_val_ptr));
+  RETURN_IF_NOT_OK_MR(ReadAllRowsInShard(shard_id, consumer_id, fields, static_cast<int64_t>(sample_id), columns,
+                                         offset_ptr, col_val_ptr));
   *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
   return Status::OK();
 }
@@ -684,6 +912,17 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  std::vector<std::vector<std::string>> image_offsets;
+  auto columnar_index = GetColumnarIndex(shard_id);
+  if (columnar_index != nullptr) {
+    auto rc = QueryColumnarIndexByPage(columnar_index, {"PAGE_OFFSET_BLOB", "PAGE_OFFSET_BLOB_END"}, page_id, criteria,
+                                       &image_offsets);
+    if (rc.IsError()) {
+      MS_LOG(EXCEPTION) << rc.ToString();
+    }
+    return ConvertImageOffsets(image_offsets);
+  }
+
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END FROM INDEXES WHERE PAGE_ID_BLOB = :page_id_blob";
@@ -693,7 +932,6 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
     sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = :criteria";
   }
   sql += ";";
-  std::vector<std::vector<std::string>> image_offsets;
 
   sqlite3_stmt *stmt = nullptr;
   if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
@@ -735,7 +973,11 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
   }
 
   MS_LOG(DEBUG) << "Succeed to get " << image_offsets.size() << " records from index.";
+  return ConvertImageOffsets(image_offsets);
+}
 
+std::vector<std::vector<uint64_t>> ShardReader::ConvertImageOffsets(
+  const std::vector<std::vector<std::string>> &image_offsets) {
   std::vector<std::vector<uint64_t>> res;
   for (int i = static_cast<int>(image_offsets.size()) - 1; i >= 0; i--) {
     res.emplace_back(std::vector<uint64_t>{0, 0});
@@ -755,6 +997,14 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
 Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string, std::string> &criteria,
                                        std::shared_ptr<std::vector<uint64_t>> *pages_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(pages_ptr);
+  auto columnar_index = GetColumnarIndex(shard_id);
+  if (columnar_index != nullptr) {
+    std::pair<std::string, std::string> index_criteria{"", criteria.second};
+    if (!criteria.first.empty()) {
+      RETURN_IF_NOT_OK_MR(GetIndexFieldName(criteria.first, &index_criteria.first));
+    }
+    return columnar_index->GetPagesByCriteria(index_criteria, pages_ptr->get());
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT DISTINCT PAGE_ID_BLOB FROM INDEXES WHERE 1 = 1 ";
@@ -928,6 +1178,13 @@ Status ShardReader::GetLabelsFromPage(int page_id, int shard_id, const std::vect
                                       const std::pair<std::string, std::string> &criteria,
                                       std::shared_ptr<std::vector<json>> *labels_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(labels_ptr);
+  auto columnar_index = GetColumnarIndex(shard_id);
+  if (columnar_index != nullptr) {
+    std::vector<std::vector<std::string>> label_offsets;
+    std::vector<std::string> fields = {"PAGE_ID_RAW", "PAGE_OFFSET_RAW", "PAGE_OFFSET_RAW_END"};
+    RETURN_IF_NOT_OK_MR(QueryColumnarIndexByPage(columnar_index, fields, page_id, criteria, &label_offsets));
+    return GetLabelsFromBinaryFile(shard_id, columns, label_offsets, labels_ptr);
+  }
   // get page info from sqlite
   auto db = database_paths_[shard_id];
   std::string sql =
@@ -980,6 +1237,17 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
                               std::shared_ptr<std::vector<json>> *labels_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(labels_ptr);
   if (all_in_index_) {
+    auto labels = std::make_shared<std::vector<std::vector<std::string>>>();
+    auto columnar_index = GetColumnarIndex(shard_id);
+    if (columnar_index != nullptr) {
+      std::vector<std::string> fields;
+      for (const auto &column : columns) {
+        fields.emplace_back();
+        RETURN_IF_NOT_OK_MR(GetIndexFieldName(column, &fields.back()));
+      }
+      RETURN_IF_NOT_OK_MR(QueryColumnarIndexByPage(columnar_index, fields, page_id, criteria, labels.get()));
+      return ConvertIndexLabels(*labels, columns, labels_ptr);
+    }
     auto db = database_paths_[shard_id];
     std::string fields;
     for (unsigned int i = 0; i < columns.size(); ++i) {
@@ -992,7 +1260,6 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
     if (fields.empty()) {
       fields = "*";
     }
-    auto labels = std::make_shared<std::vector<std::vector<std::string>>>();
     std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = :page_id_blob";
     if (!criteria.first.empty()) {
       sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria;";
@@ -1031,33 +1298,40 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
 
       MS_LOG(DEBUG) << "Succeed to get " << labels->size() << " records from index.";
     }
-    for (unsigned int i = 0; i < labels->size(); ++i) {
-      (*labels_ptr)->emplace_back(json{});
-    }
-    for (unsigned int i = 0; i < labels->size(); ++i) {
-      json construct_json;
-      for (unsigned int j = 0; j < columns.size(); ++j) {
-        // construct json "f1": value
-        auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
-
-        // convert the string to base type by schema
-        if (schema[columns[j]]["type"] == "int32") {
-          construct_json[columns[j]] = StringToNum<int32_t>((*labels)[i][j]);
-        } else if (schema[columns[j]]["type"] == "int64") {
-          construct_json[columns[j]] = StringToNum<int64_t>((*labels)[i][j]);
-        } else if (schema[columns[j]]["type"] == "float32") {
-          construct_json[columns[j]] = StringToNum<float>((*labels)[i][j]);
-        } else if (schema[columns[j]]["type"] == "float64") {
-          construct_json[columns[j]] = StringToNum<double>((*labels)[i][j]);
-        } else {
-          construct_json[columns[j]] = std::string((*labels)[i][j]);
-        }
+    return ConvertIndexLabels(*labels, columns, labels_ptr);
+  }
+  return GetLabelsFromPage(page_id, shard_id, columns, criteria, labels_ptr);
+}
+
+Status ShardReader::ConvertIndexLabels(const std::vector<std::vector<std::string>> &labels,
+                                       const std::vector<std::string> &columns,
+                                       std::shared_ptr<std::vector<json>> *labels_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(labels_ptr);
+  for (unsigned int i = 0; i < labels.size(); ++i) {
+    (*labels_ptr)->emplace_back(json{});
+  }
+  for (unsigned int i = 0; i < labels.size(); ++i) {
+    json construct_json;
+    for (unsigned int j = 0; j < columns.size(); ++j) {
+      // construct json "f1": value
+      auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+
+      // convert the string to base type by schema
+      if (schema[columns[j]]["type"] == "int32") {
+        construct_json[columns[j]] = StringToNum<int32_t>(labels[i][j]);
+      } else if (schema[columns[j]]["type"] == "int64") {
+        construct_json[columns[j]] = StringToNum<int64_t>(labels[i][j]);
+      } else if (schema[columns[j]]["type"] == "float32") {
+        construct_json[columns[j]] = StringToNum<float>(labels[i][j]);
+      } else if (schema[columns[j]]["type"] == "float64") {
+        construct_json[columns[j]] = StringToNum<double>(labels[i][j]);
+      } else {
+        construct_json[columns[j]] = std::string(labels[i][j]);
       }
-      (*(*labels_ptr))[i] = construct_json;
     }
-    return Status::OK();
+    (*(*labels_ptr))[i] = construct_json;
   }
-  return GetLabelsFromPage(page_id, shard_id, columns, criteria, labels_ptr);
+  return Status::OK();
 }
 
 bool ResortRowGroups(std::tuple<int, int, int, int> a, std::tuple<int, int, int, int> b) {
@@ -1081,11 +1355,15 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   std::shared_ptr<std::string> fn_ptr;
   (void)ShardIndexGenerator::GenerateFieldName(std::make_pair(map_schema_id_fields[category_field], category_field),
                                                &fn_ptr);
-  std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count);
   auto category_ptr = std::make_shared<std::set<std::string>>();
   sqlite3 *db = nullptr;
   for (int x = 0; x < shard_count; x++) {
+    // the classes are counted from the columnar index without opening the meta file
+    if (GetColumnarIndex(x) != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInShard, this, nullptr, x, *fn_ptr, category_ptr);
+      continue;
+    }
     std::string path_utf8 = "";
 #if defined(_WIN32) || defined(_WIN64)
     path_utf8 = FileUtils::GB2312ToUTF_8((file_paths_[x] + ".db").data());
@@ -1099,7 +1377,7 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
       MS_LOG(ERROR) << "[Internal ERROR] Failed to open meta file: " << file_paths_[x] + ".db, " << sqlite3_errmsg(db);
       return -1;
     }
-    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, db, x, sql, category_ptr);
+    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, db, x, *fn_ptr, category_ptr);
   }
 
   for (int x = 0; x < shard_count; x++) {
@@ -1449,9 +1727,15 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
   return Status::OK();
 }
 
-Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
-                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
-  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+Status ShardReader::GetTaskBlobLocation(int64_t task_id, uint32_t consumer_id, TaskType *task_type,
+                                        uint32_t *shard_id, uint64_t *page_id, uint32_t *blob_start,
+                                        uint32_t *blob_end, json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_type);
+  RETURN_UNEXPECTED_IF_NULL_MR(shard_id);
+  RETURN_UNEXPECTED_IF_NULL_MR(page_id);
+  RETURN_UNEXPECTED_IF_NULL_MR(blob_start);
+  RETURN_UNEXPECTED_IF_NULL_MR(blob_end);
+  RETURN_UNEXPECTED_IF_NULL_MR(var_fields);
   if (load_mode_ == LoadMode::kFast || load_mode_ == LoadMode::kLazy) {
     // All tasks are done
     CHECK_FAIL_RETURN_UNEXPECTED_MR(task_id < tasks_.Size(), "[Internal ERROR] 'task_id': " + std::to_string(task_id) +
@@ -1463,23 +1747,17 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
         " is out of bound: " + std::to_string(num_padded_ + shard_sample_count_[shard_sample_count_.size() - 1]));
   }
 
-  uint32_t shard_id = 0;
   uint32_t group_id = 0;
-  uint32_t blob_start = 0;
-  uint32_t blob_end = 0;
-  json var_fields;
   // Pick up task from task list
   ShardTask task = tasks_.GetTaskByID(task_id);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    *task_content_ptr =
-      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
     return Status::OK();
   }
 
-  shard_id = std::get<0>(std::get<1>(task));  // shard id
+  *shard_id = std::get<0>(std::get<1>(task));  // shard id
 
   if (load_mode_ == LoadMode::kLazy || load_mode_ == LoadMode::kSlow) {
     // get scalar variable fields by sample id
@@ -1488,29 +1766,61 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     // read the meta from index
     std::shared_ptr<ROW_GROUPS> row_group_ptr;
     RETURN_IF_NOT_OK_MR(
-      ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, consumer_id, sample_id_in_shard, &row_group_ptr));
+      ReadRowGroupByShardIDAndSampleID(selected_columns_, *shard_id, consumer_id, sample_id_in_shard, &row_group_ptr));
     auto &offsets = std::get<0>(*row_group_ptr);
     auto &local_columns = std::get<1>(*row_group_ptr);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[*shard_id][0][1];        // group_id
+    *blob_start = offsets[*shard_id][0][2];     // blob start
+    *blob_end = offsets[*shard_id][0][3];       // blob end
+    *var_fields = local_columns[*shard_id][0];  // scalar variable field
   } else {
     group_id = std::get<1>(std::get<1>(task));  // group id
-    blob_start = std::get<2>(task)[0];          // blob start
-    blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    *blob_start = std::get<2>(task)[0];         // blob start
+    *blob_end = std::get<2>(task)[1];           // blob end
+    *var_fields = std::get<3>(task);            // scalar variable field
   }
 
-  // read the blob from data file
   std::shared_ptr<Page> page_ptr;
-  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
-  MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
+  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, *shard_id, &page_ptr));
+  MS_LOG(DEBUG) << "Success to get page by group id: " << group_id;
+  *page_id = page_ptr->GetPageID();
+  return Status::OK();
+}
+
+Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
+                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t page_id = 0;
+  uint32_t blob_start = 0;
+  uint32_t blob_end = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK_MR(
+    GetTaskBlobLocation(task_id, consumer_id, &task_type, &shard_id, &page_id, &blob_start, &blob_end, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    return Status::OK();
+  }
+
+  if (!prefetch_fds_.empty()) {
+    RETURN_IF_NOT_OK_MR(PrefetchTasks(consumer_id));
+    auto request = TakePrefetchedTask(task_id);
+    consumed_num_++;
+    if (request != nullptr) {
+      RETURN_IF_NOT_OK_MR(request->Wait());
+      std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
+      batch.emplace_back(std::move(*request->GetBuffer()), std::move(var_fields));
+      *task_content_ptr = std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::move(batch));
+      return Status::OK();
+    }
+  }
 
   // Pack image list
   std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  auto file_offset = header_size_ + page_size_ * page_id + blob_start;
 
   auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
@@ -1645,6 +1955,45 @@ Status ShardReader::GetNextById(const int64_t &task_id, const int32_t &consumer_
   return Status::OK();
 }
 
+Status ShardReader::GetNextById(const int64_t &task_id, const int32_t &consumer_id,
+                                std::shared_ptr<TASK_VIEW_CONTENT> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+  if (interrupt_) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(zero_copy_ && !mapped_files_.empty(),
+                                  "[Internal ERROR] Zero copy should be enabled before opening the reader.");
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t page_id = 0;
+  uint32_t blob_start = 0;
+  uint32_t blob_end = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK_MR(
+    GetTaskBlobLocation(task_id, consumer_id, &task_type, &shard_id, &page_id, &blob_start, &blob_end, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_VIEW_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<ShardBlobView, json>>());
+    return Status::OK();
+  }
+
+  // the blob data is a view of the mapped page, which is shared by all the rows in the page
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_id < mapped_files_.size(),
+                                  "[Internal ERROR] 'shard_id': " + std::to_string(shard_id) + " is out of bound.");
+  std::shared_ptr<ShardMappedPage> page;
+  RETURN_IF_NOT_OK_MR(mapped_files_[shard_id]->MapPage(page_id, header_size_ + page_size_ * page_id, page_size_, &page));
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(blob_start <= blob_end && blob_end <= page->GetSize(),
+                                  "[Internal ERROR] The blob data [" + std::to_string(blob_start) + ", " +
+                                    std::to_string(blob_end) + ") exceeds the page size: " +
+                                    std::to_string(page->GetSize()));
+  const uint8_t *blob_data = page->GetData() + blob_start;
+  std::vector<std::tuple<ShardBlobView, json>> batch;
+  batch.emplace_back(ShardBlobView(std::move(page), blob_data, blob_end - blob_start), std::move(var_fields));
+
+  *task_content_ptr = std::make_shared<TASK_VIEW_CONTENT>(TaskType::kCommonTask, std::move(batch));
+  return Status::OK();
+}
+
 Status ShardReader::UnCompressBlob(const std::vector<uint8_t> &raw_blob_data,
                                    std::shared_ptr<std::vector<std::vector<uint8_t>>> *blob_data_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(blob_data_ptr);
@@ -1680,6 +2029,7 @@ void ShardReader::Reset() {
     deliver_id_ = 0;
   }
   cv_delivery_.notify_all();
+  ClearPrefetchedTasks();
 }
 
 void ShardReader::ShuffleTask() {
@@ -1710,6 +2060,8 @@ void ShardReader::ShuffleTask() {
   } else {
     tasks_.generator_ids_.ResetShardIndexAndID();
   }
+  // the rows of the new epoch are sampled in a different order
+  ClearPrefetchedTasks();
 }
 
 const std::vector<int64_t> *ShardReader::GetSampleIds() {
@@ -17,6 +17,11 @@
 #include "minddata/mindrecord/include/shard_shuffle.h"
 
 #include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace mindrecord {
@@ -25,7 +30,8 @@ ShardShuffle::ShardShuffle(uint32_t seed, ShuffleType shuffle_type)
       no_of_samples_(0),
       replacement_(false),
       reshuffle_each_epoch_(true),
-      shuffle_type_(shuffle_type) {}
+      shuffle_type_(shuffle_type),
+      block_rows_(GetBlockRows()) {}
 
 ShardShuffle::ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacement, bool reshuffle_each_epoch,
                            ShuffleType shuffle_type)
@@ -33,7 +39,8 @@ ShardShuffle::ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacemen
       no_of_samples_(no_of_samples),
       replacement_(replacement),
       reshuffle_each_epoch_(reshuffle_each_epoch),
-      shuffle_type_(shuffle_type) {}
+      shuffle_type_(shuffle_type),
+      block_rows_(GetBlockRows()) {}
 
 int64_t ShardShuffle::GetNumSamples(int64_t dataset_size, int64_t num_classes) {
   if (replacement_) {
@@ -67,7 +74,70 @@ Status ShardShuffle::CategoryShuffle(ShardTaskList &tasks) {
   return Status::OK();
 }
 
+int64_t ShardShuffle::GetBlockRows() {
+  std::string block_rows = common::GetEnv("MS_DEV_DATASET_SHUFFLE_BLOCK_ROWS");
+  if (block_rows.empty()) {
+    return 0;
+  }
+  try {
+    return std::max<int64_t>(std::stoll(block_rows), 0);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "The value of MS_DEV_DATASET_SHUFFLE_BLOCK_ROWS: " << block_rows
+                    << " is invalid, it should be a non-negative integer, the files are shuffled as a whole.";
+    return 0;
+  }
+}
+
+Status ShardShuffle::ShuffleBlocks(ShardTaskList &tasks) {
+  if (no_of_samples_ == 0) {
+    no_of_samples_ = tasks.Size();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    no_of_samples_ > 0, "Invalid input, 'num_samples' should be positive but got: " + std::to_string(no_of_samples_));
+  auto shard_sample_count = GetShardSampleCount();
+
+  // the blocks never cross the boundary of files
+  // -- before --
+  // file1: [0, 1, 2]
+  // file2: [3, 4, 5, 6]
+  // block_rows: 2
+  // blocks: [0, 1], [2], [3, 4], [5, 6]
+  // -- after --
+  // permutation : [3, 4, 2, 5, 6, 0, 1]
+  std::vector<std::pair<int64_t, int64_t>> blocks;  // the start index and size of each block
+  int64_t start_index = 0;
+  for (size_t i = 0; i < shard_sample_count.size(); i++) {
+    for (int64_t block_start = start_index; block_start < shard_sample_count[i]; block_start += block_rows_) {
+      blocks.emplace_back(block_start, std::min(block_rows_, shard_sample_count[i] - block_start));
+    }
+    start_index = shard_sample_count[i];
+  }
+  std::shuffle(blocks.begin(), blocks.end(), std::default_random_engine(shuffle_seed_));
+
+  auto original_permutation = tasks.permutation_;
+  int64_t whole_index = 0;
+  for (const auto &block : blocks) {
+    (void)std::copy(original_permutation.begin() + block.first,
+                    original_permutation.begin() + block.first + block.second,
+                    tasks.permutation_.begin() + whole_index);
+    whole_index += block.second;
+  }
+
+  auto total_no = tasks.Size();
+  int64_t samples_to_assign =
+    (no_of_samples_ > 0 && no_of_samples_ < total_no) ? no_of_samples_ : tasks.sample_ids_.size();
+  ShardTaskList new_tasks;
+  for (int64_t i = 0; i < samples_to_assign; ++i) {
+    new_tasks.AssignTask(tasks, tasks.permutation_[i]);
+  }
+  ShardTaskList::TaskListSwap(tasks, new_tasks);
+  return Status::OK();
+}
+
 Status ShardShuffle::ShuffleFiles(ShardTaskList &tasks) {
+  if (block_rows_ > 0) {
+    return ShuffleBlocks(tasks);
+  }
   if (no_of_samples_ == 0) {
     no_of_samples_ = tasks.Size();
   }
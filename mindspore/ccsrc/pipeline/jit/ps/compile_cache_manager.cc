@@ -187,6 +187,7 @@ std::pair<FuncGraphPtr, LayoutMap> LoadFuncGraphFromMindIR(const py::dict &weigh
   auto ms_context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(ms_context);
   ms_context->SetCellReuseLevel(CellReuseLevel::kNoCellReuse);
+  auto front_graph_cache_hash = system::sha256::GetHashFromFile(realpath.value());
   MindIRLoader mindir_loader;
   mindir_loader.set_weights_value_map(GenerateWeightsValueMap(weights));
   mindir_loader.set_has_parallel_info(has_parallel_info);
@@ -195,6 +196,7 @@ std::pair<FuncGraphPtr, LayoutMap> LoadFuncGraphFromMindIR(const py::dict &weigh
   auto &context = CompileCacheContext::GetInstance();
   context.SetFrontNameToFrontNode(name_to_node);
   context.SetFrontGraph(fg);
+  context.SetFrontGraphCacheHash(front_graph_cache_hash);
   context.InsertBackendGraphCachePath(fg, GetBackendCompileCachePathWithoutExtension(idx));
   if (ms_context->CellReuseLevel() != CellReuseLevel::kNoCellReuse) {
     MS_LOG(INFO) << "Cell reuse(@lazy_inline) actually takes effect.";
@@ -232,7 +234,11 @@ bool ExportFuncGraphToMindIR(const FuncGraphPtr &fg, const FuncGraphPtr &layout_
   }
 #endif
   MindIRExporter mindir_exporter;
-  return mindir_exporter.SaveProtoToFile(proto.get(), compile_cache_path);
+  if (!mindir_exporter.SaveProtoToFile(proto.get(), compile_cache_path)) {
+    return false;
+  }
+  context.SetFrontGraphCacheHash(system::sha256::GetHashFromFile(compile_cache_path));
+  return true;
 }
 
 bool ExportDepFilesHash(const std::string &compile_cache_dep_files_hash) {
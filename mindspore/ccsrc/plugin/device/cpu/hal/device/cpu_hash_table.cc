@@ -17,6 +17,7 @@
 
 #include <string>
 #include <algorithm>
+#include <mutex>
 
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
@@ -26,6 +27,36 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+// The bytes of a value slab, the values are allocated from the memory pool slab by slab instead of one by one.
+constexpr size_t kValueSlabBytes = static_cast<size_t>(1) << 18;
+// The minimum number of slots of a non-empty shard.
+constexpr size_t kMinSlotNum = 16;
+// The slots are kept at most half full, so the probing sequences stay short.
+constexpr size_t kMaxLoadFactorInverse = 2;
+// The distance in keys of prefetching the slots during the batch lookup.
+constexpr size_t kPrefetchDistance = 8;
+
+// Mix the bits of key, the high bits select the shard and the low bits select the slot.
+inline uint64_t HashKey(uint64_t key) {
+  constexpr uint64_t kMixMultiplier1 = 0xff51afd7ed558ccdULL;
+  constexpr uint64_t kMixMultiplier2 = 0xc4ceb9fe1a85ec53ULL;
+  constexpr size_t kMixShift = 33;
+  key ^= key >> kMixShift;
+  key *= kMixMultiplier1;
+  key ^= key >> kMixShift;
+  key *= kMixMultiplier2;
+  key ^= key >> kMixShift;
+  return key;
+}
+
+inline void PrefetchAddress(const void *addr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr);
+#endif
+}
+}  // namespace
+
 template <typename Key, typename Value>
 CPUHashTable<Key, Value>::CPUHashTable(size_t value_dim, const std::string &initializer)
     : value_dim_(value_dim), value_size_(0), initializer_(initializer), default_value_(0) {
@@ -46,6 +77,7 @@ CPUHashTable<Key, Value>::~CPUHashTable() {
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Initialize() {
   value_size_ = value_dim_ * sizeof(Value);
+  slab_element_num_ = value_size_ == 0 ? 1 : std::max(kValueSlabBytes / value_size_, static_cast<size_t>(1));
   return true;
 }
 
@@ -54,77 +86,223 @@ bool CPUHashTable<Key, Value>::Finalize() {
   return Clear();
 }
 
+template <typename Key, typename Value>
+void CPUHashTable<Key, Value>::GroupByShard(const Key *keys, size_t key_num, std::vector<uint64_t> *hashes,
+                                            std::vector<size_t> *offsets, std::vector<size_t> *indices) const {
+  constexpr size_t kHashBits = 64;
+  hashes->resize(key_num);
+  offsets->assign(kShardNum + 1, 0);
+  indices->resize(key_num);
+  for (size_t i = 0; i < key_num; ++i) {
+    (*hashes)[i] = HashKey(static_cast<uint64_t>(keys[i]));
+    ++(*offsets)[((*hashes)[i] >> (kHashBits - kShardBits)) + 1];
+  }
+  for (size_t i = 0; i < kShardNum; ++i) {
+    (*offsets)[i + 1] += (*offsets)[i];
+  }
+  // Keep the order of keys in each shard, so the duplicated keys are handled in the same order as the inputs.
+  std::vector<size_t> cursors(offsets->begin(), offsets->end() - 1);
+  for (size_t i = 0; i < key_num; ++i) {
+    (*indices)[cursors[(*hashes)[i] >> (kHashBits - kShardBits)]++] = i;
+  }
+}
+
+template <typename Key, typename Value>
+size_t CPUHashTable<Key, Value>::FindSlot(const Shard &shard, const Key &key, uint64_t hash) const {
+  const size_t slot_num = shard.slots.size();
+  if (slot_num == 0) {
+    return slot_num;
+  }
+  const size_t mask = slot_num - 1;
+  for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    const auto &item = shard.slots[slot];
+    if (item.pos == 0) {
+      return slot_num;
+    }
+    if (item.key == key) {
+      return slot;
+    }
+  }
+}
+
+template <typename Key, typename Value>
+void CPUHashTable<Key, Value>::Rehash(Shard *shard, size_t element_num) {
+  size_t slot_num = kMinSlotNum;
+  while (slot_num < element_num * kMaxLoadFactorInverse) {
+    slot_num <<= 1;
+  }
+  if (slot_num <= shard->slots.size()) {
+    return;
+  }
+  std::vector<Slot> slots(slot_num, Slot{Key(), 0});
+  const size_t mask = slot_num - 1;
+  for (size_t pos = 0; pos < shard->keys.size(); ++pos) {
+    size_t slot = HashKey(static_cast<uint64_t>(shard->keys[pos])) & mask;
+    while (slots[slot].pos != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = {shard->keys[pos], pos + 1};
+  }
+  shard->slots.swap(slots);
+}
+
+template <typename Key, typename Value>
+size_t CPUHashTable<Key, Value>::FindOrAddElement(Shard *shard, const Key &key, uint64_t hash, Status status,
+                                                  bool *is_new) {
+  MS_EXCEPTION_IF_NULL(shard);
+  MS_EXCEPTION_IF_NULL(is_new);
+  if ((shard->keys.size() + 1) * kMaxLoadFactorInverse > shard->slots.size()) {
+    Rehash(shard, shard->keys.size() + 1);
+  }
+  const size_t mask = shard->slots.size() - 1;
+  size_t slot = hash & mask;
+  for (; shard->slots[slot].pos != 0; slot = (slot + 1) & mask) {
+    if (shard->slots[slot].key == key) {
+      *is_new = false;
+      return shard->slots[slot].pos - 1;
+    }
+  }
+
+  // The key does not exist, append a new element and allocate a new value slab if the last one is full.
+  size_t pos = shard->keys.size();
+  if (pos / slab_element_num_ >= shard->slabs.size()) {
+    auto slab = static_cast<Value *>(AllocateMemory(slab_element_num_ * value_size_));
+    MS_EXCEPTION_IF_NULL(slab);
+    shard->slabs.push_back(slab);
+  }
+  shard->keys.push_back(key);
+  shard->statuses.push_back(status);
+  shard->slots[slot] = {key, pos + 1};
+  ++size_;
+  *is_new = true;
+  return pos;
+}
+
+template <typename Key, typename Value>
+void CPUHashTable<Key, Value>::EraseElement(Shard *shard, size_t slot) {
+  MS_EXCEPTION_IF_NULL(shard);
+  const size_t mask = shard->slots.size() - 1;
+  const size_t pos = shard->slots[slot].pos - 1;
+
+  // Backward shift the following slots of the probing sequence instead of leaving a tombstone.
+  size_t hole = slot;
+  for (size_t next = (hole + 1) & mask; shard->slots[next].pos != 0; next = (next + 1) & mask) {
+    size_t home = HashKey(static_cast<uint64_t>(shard->slots[next].key)) & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      shard->slots[hole] = shard->slots[next];
+      hole = next;
+    }
+  }
+  shard->slots[hole].pos = 0;
+
+  // Move the last element to the erased position to keep the elements dense.
+  const size_t last = shard->keys.size() - 1;
+  if (pos != last) {
+    const auto &last_key = shard->keys[last];
+    auto last_slot = FindSlot(*shard, last_key, HashKey(static_cast<uint64_t>(last_key)));
+    if (last_slot == shard->slots.size()) {
+      MS_LOG(EXCEPTION) << "The key: " << last_key << " is missing in the index of hash table.";
+    }
+    shard->slots[last_slot].pos = pos + 1;
+    shard->keys[pos] = last_key;
+    shard->statuses[pos] = shard->statuses[last];
+    auto ret = memcpy_s(GetValue(*shard, pos), value_size_, GetValue(*shard, last), value_size_);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+    }
+  }
+  shard->keys.pop_back();
+  shard->statuses.pop_back();
+  --size_;
+
+  // Return the slabs which are no longer used to the memory pool, one spare slab is kept to avoid thrashing.
+  const size_t used_slab_num = (shard->keys.size() + slab_element_num_ - 1) / slab_element_num_;
+  while (shard->slabs.size() > used_slab_num + 1) {
+    FreeMemory(shard->slabs.back());
+    shard->slabs.pop_back();
+  }
+}
+
+template <typename Key, typename Value>
+bool CPUHashTable<Key, Value>::InitializeValue(Value *value) const {
+  MS_EXCEPTION_IF_NULL(value);
+  if (initializer_.empty()) {
+    std::fill_n(value, value_dim_, default_value_);
+    return true;
+  }
+  if (initializer_ == kNormalDistribution) {
+    // initialize normal distribution parameter
+    const double mean = 0.0;
+    const double sigma = 0.01;
+    std::random_device rd;
+    const std::uint64_t seed = rd();
+    size_t skip = 0;
+    random::GenerateRandoms<Value, Generator, NormalDistribution>(seed, skip, value, value_dim_, mean, sigma);
+  } else if (initializer_ == kOnesDistribution) {
+    std::fill_n(value, value_dim_, static_cast<Value>(1));
+  } else if (initializer_ == kZerosDistribution) {
+    std::fill_n(value, value_dim_, static_cast<Value>(0));
+  } else {
+    MS_LOG(ERROR) << "Unsupported initializer: " << initializer_;
+    return false;
+  }
+  return true;
+}
+
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Find(const Key *keys, size_t key_num, bool insert_default_value, Value *outputs,
                                     void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-
   MS_EXCEPTION_IF_NULL(outputs);
-  // Find and copy values to output buffer if the keys exist.
-  for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-    size_t offset = i * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    if (values_.find(key) != values_.end()) {
-      // Copy the value of the key from the hash table to the outputs.
-      auto value = values_[key].first;
-      MS_EXCEPTION_IF_NULL(value);
-      auto ret = memcpy_s(outputs + offset, dst_size, value, src_size);
-      if (ret != EOK) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return false;
-      }
+  if (key_num == 0) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(keys);
+  std::vector<uint64_t> hashes;
+  std::vector<size_t> offsets;
+  std::vector<size_t> indices;
+  GroupByShard(keys, key_num, &hashes, &offsets, &indices);
+
+  for (size_t shard_id = 0; shard_id < kShardNum; ++shard_id) {
+    if (offsets[shard_id] == offsets[shard_id + 1]) {
       continue;
     }
-
-    if (!insert_default_value) {
-      MS_LOG(ERROR) << "The key: " << key << " does not exist in the hash table.";
-      return false;
+    auto &shard = shards_[shard_id];
+    // The missing keys are inserted only if insert_default_value is true, otherwise the shard is read only.
+    std::unique_lock<std::shared_mutex> write_lock(shard.mutex, std::defer_lock);
+    std::shared_lock<std::shared_mutex> read_lock(shard.mutex, std::defer_lock);
+    if (insert_default_value) {
+      write_lock.lock();
+    } else {
+      read_lock.lock();
     }
-
-    // Insert key-value pair into values_ by default_value or initializer
-    if (!initializer_.empty()) {
-      // allocate memory for value
-      auto value_addr = static_cast<Value *>(AllocateMemory(value_size_));
-      MS_EXCEPTION_IF_NULL(value_addr);
-      (void)values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), Status::kModified));
-      if (initializer_ == kNormalDistribution) {
-        // initialize normal distribution parameter
-        const double mean = 0.0;
-        const double sigma = 0.01;
-        std::random_device rd;
-        const std::uint64_t seed = rd();
-        size_t skip = 0;
-        random::GenerateRandoms<Value, Generator, NormalDistribution>(seed, skip, value_addr, value_dim_, mean, sigma);
-      } else if (initializer_ == kOnesDistribution) {
-        default_value_ = 1;
-        for (size_t k = 0; k < value_dim_; ++k) {
-          value_addr[k] = default_value_;
+    for (size_t k = offsets[shard_id]; k < offsets[shard_id + 1]; ++k) {
+      // Prefetch the slot of the following key, so the cache misses of probing overlap with the copy of values.
+      if (k + kPrefetchDistance < offsets[shard_id + 1] && !shard.slots.empty()) {
+        auto next_hash = hashes[indices[k + kPrefetchDistance]];
+        PrefetchAddress(&shard.slots[next_hash & (shard.slots.size() - 1)]);
+      }
+      const size_t i = indices[k];
+      const auto &key = keys[i];
+      Value *value = nullptr;
+      auto slot = FindSlot(shard, key, hashes[i]);
+      if (slot != shard.slots.size()) {
+        // Copy the value of the key from the hash table to the outputs.
+        value = GetValue(shard, shard.slots[slot].pos - 1);
+      } else {
+        if (!insert_default_value) {
+          MS_LOG(ERROR) << "The key: " << key << " does not exist in the hash table.";
+          return false;
         }
-      } else if (initializer_ == kZerosDistribution) {
-        default_value_ = 0;
-        for (size_t k = 0; k < value_dim_; ++k) {
-          value_addr[k] = default_value_;
+        // Insert key-value pair by default_value or initializer.
+        bool is_new = false;
+        auto pos = FindOrAddElement(&shard, key, hashes[i], Status::kModified, &is_new);
+        value = GetValue(shard, pos);
+        if (!InitializeValue(value)) {
+          return false;
         }
-      } else {
-        MS_LOG(ERROR) << "Unsupported initializer: " << initializer_;
-        return false;
+        is_dirty_ = true;
       }
-      auto ret = memcpy_s(outputs + offset, dst_size, value_addr, src_size);
-      if (ret != EOK) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return false;
-      }
-    } else {
-      // if there's no key in values_
-      auto value_addr = static_cast<Value *>(AllocateMemory(value_size_));
-      MS_EXCEPTION_IF_NULL(value_addr);
-      (void)values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), Status::kModified));
-      for (size_t k = 0; k < value_dim_; ++k) {
-        value_addr[k] = default_value_;
-      }
-      auto ret = memcpy_s(outputs + offset, dst_size, value_addr, src_size);
+      auto ret = memcpy_s(outputs + i * value_dim_, value_size_, value, value_size_);
       if (ret != EOK) {
         MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
         return false;
@@ -136,31 +314,30 @@ bool CPUHashTable<Key, Value>::Find(const Key *keys, size_t key_num, bool insert
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Value *values, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
   MS_ERROR_IF_NULL(keys);
   MS_ERROR_IF_NULL(values);
+  std::vector<uint64_t> hashes;
+  std::vector<size_t> offsets;
+  std::vector<size_t> indices;
+  GroupByShard(keys, key_num, &hashes, &offsets, &indices);
 
-  for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-
-    auto iter = values_.find(key);
-    // The the key does not exist, a new value buffer should be allocated firstly.
-    if (iter == values_.end()) {
-      auto value_addr = AllocateMemory(value_size_);
-      MS_EXCEPTION_IF_NULL(value_addr);
-      iter = values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), Status::kModified)).first;
+  for (size_t shard_id = 0; shard_id < kShardNum; ++shard_id) {
+    if (offsets[shard_id] == offsets[shard_id + 1]) {
+      continue;
     }
-
-    // Do the insertion copy.
-    size_t offset = i * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(iter->second.first, dst_size, values + offset, src_size);
-    if (ret != EOK) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
+    auto &shard = shards_[shard_id];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    for (size_t k = offsets[shard_id]; k < offsets[shard_id + 1]; ++k) {
+      const size_t i = indices[k];
+      bool is_new = false;
+      auto pos = FindOrAddElement(&shard, keys[i], hashes[i], Status::kModified, &is_new);
+      auto ret = memcpy_s(GetValue(shard, pos), value_size_, values + i * value_dim_, value_size_);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+      shard.statuses[pos] = Status::kModified;
     }
-    iter->second.second = Status::kModified;
   }
   is_dirty_ = true;
   return true;
@@ -168,28 +345,31 @@ bool CPUHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Val
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Value *values, Status *statuses, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
   MS_ERROR_IF_NULL(keys);
   MS_ERROR_IF_NULL(values);
   MS_ERROR_IF_NULL(statuses);
+  std::vector<uint64_t> hashes;
+  std::vector<size_t> offsets;
+  std::vector<size_t> indices;
+  GroupByShard(keys, key_num, &hashes, &offsets, &indices);
 
-  for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-
-    auto iter = values_.find(key);
-    // The the key does not exist, a new value buffer should be allocated firstly.
-    if (iter == values_.end()) {
-      auto value_addr = AllocateMemory(value_size_);
-      MS_EXCEPTION_IF_NULL(value_addr);
-      iter = values_.emplace(key, std::make_pair(static_cast<Value *>(value_addr), statuses[i])).first;
+  for (size_t shard_id = 0; shard_id < kShardNum; ++shard_id) {
+    if (offsets[shard_id] == offsets[shard_id + 1]) {
+      continue;
     }
-
-    auto ret = memcpy_s(iter->second.first, value_size_, values + (i * value_dim_), value_size_);
-    if (ret != EOK) {
-      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
+    auto &shard = shards_[shard_id];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    for (size_t k = offsets[shard_id]; k < offsets[shard_id + 1]; ++k) {
+      const size_t i = indices[k];
+      bool is_new = false;
+      auto pos = FindOrAddElement(&shard, keys[i], hashes[i], statuses[i], &is_new);
+      auto ret = memcpy_s(GetValue(shard, pos), value_size_, values + (i * value_dim_), value_size_);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+      shard.statuses[pos] = statuses[i];
     }
-    iter->second.second = statuses[i];
   }
   is_dirty_ = true;
   return true;
@@ -197,22 +377,30 @@ bool CPUHashTable<Key, Value>::Insert(const Key *keys, size_t key_num, const Val
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Erase(const Key *keys, size_t key_num, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (key_num == 0) {
+    return true;
+  }
+  MS_ERROR_IF_NULL(keys);
+  std::vector<uint64_t> hashes;
+  std::vector<size_t> offsets;
+  std::vector<size_t> indices;
+  GroupByShard(keys, key_num, &hashes, &offsets, &indices);
 
   // Erase all the keys in the hash table.
-  for (size_t i = 0; i < key_num; ++i) {
-    const auto &key = keys[i];
-    auto iter = values_.find(key);
-    if (iter != values_.end()) {
-      auto value = iter->second.first;
-      (void)values_.erase(key);
-
-      // Return the memory of value to the pool.
-      MS_EXCEPTION_IF_NULL(value);
-      FreeMemory(value);
-    } else {
-      MS_LOG(ERROR) << "The key: " << key << " does not exist in the hash table.";
-      return false;
+  for (size_t shard_id = 0; shard_id < kShardNum; ++shard_id) {
+    if (offsets[shard_id] == offsets[shard_id + 1]) {
+      continue;
+    }
+    auto &shard = shards_[shard_id];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    for (size_t k = offsets[shard_id]; k < offsets[shard_id + 1]; ++k) {
+      const size_t i = indices[k];
+      auto slot = FindSlot(shard, keys[i], hashes[i]);
+      if (slot == shard.slots.size()) {
+        MS_LOG(ERROR) << "The key: " << keys[i] << " does not exist in the hash table.";
+        return false;
+      }
+      EraseElement(&shard, slot);
     }
   }
   return true;
@@ -220,33 +408,55 @@ bool CPUHashTable<Key, Value>::Erase(const Key *keys, size_t key_num, void *) {
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Reserve(size_t new_capacity, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  values_.reserve(new_capacity);
+  // The keys are spread evenly over the shards, reserve a little more for each shard to absorb the skew.
+  const size_t shard_capacity = (new_capacity + kShardNum - 1) / kShardNum;
+  for (auto &shard : shards_) {
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.keys.reserve(shard_capacity);
+    shard.statuses.reserve(shard_capacity);
+    Rehash(&shard, shard_capacity + shard_capacity / kShardNum);
+  }
   return true;
 }
 
+template <typename Key, typename Value>
+template <typename Func>
+void CPUHashTable<Key, Value>::ForEachElement(size_t begin, size_t end, const Func &func) const {
+  size_t shard_begin = 0;
+  for (const auto &shard : shards_) {
+    if (shard_begin >= end) {
+      break;
+    }
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const size_t shard_size = shard.keys.size();
+    const size_t first = begin > shard_begin ? begin - shard_begin : 0;
+    const size_t last = std::min(end - shard_begin, shard_size);
+    for (size_t pos = first; pos < last; ++pos) {
+      func(shard.keys[pos], GetValue(shard, pos), shard.statuses[pos]);
+    }
+    shard_begin += shard_size;
+  }
+}
+
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::GetKeysAndValues(Key *keys, Value *values, void *) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
+  MS_ERROR_IF_NULL(keys);
+  MS_ERROR_IF_NULL(values);
   size_t index = 0;
-  for (auto iter = values_.begin(); iter != values_.end(); iter++) {
-    auto key = iter->first;
-    auto value = iter->second.first;
+  bool succeed = true;
+  ForEachElement(0, size(), [&](const Key &key, const Value *value, Status) {
     // Copy the key.
     keys[index] = key;
 
     // Copy the value.
-    size_t offset = index * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(values + offset, dst_size, value, src_size);
+    auto ret = memcpy_s(values + index * value_dim_, value_size_, value, value_size_);
     if (ret != EOK) {
       MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-      return false;
+      succeed = false;
     }
     ++index;
-  }
-  return true;
+  });
+  return succeed;
 }
 
 template <typename Key, typename Value>
@@ -304,30 +514,22 @@ HashTableExportData CPUHashTable<Key, Value>::ExportSliceFully(size_t begin, siz
   auto statuses_data = reinterpret_cast<Status *>(statuses->data());
 
   size_t index = 0;
-  auto begin_iter = values_.begin();
-  std::advance(begin_iter, begin);
-  auto end_iter = values_.begin();
-  std::advance(end_iter, end);
-  for (auto iter = begin_iter; iter != end_iter; ++iter) {
-    auto key = iter->first;
-    auto value = iter->second.first;
-    auto status = iter->second.second;
-
+  ForEachElement(begin, end, [&](const Key &key, const Value *value, Status status) {
+    if (index >= size) {
+      return;
+    }
     // Export the key.
     keys_data[index] = key;
     // Export the status.
     statuses_data[index] = status;
 
     // Export the value.
-    size_t offset = index * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(values_data + offset, dst_size, value, src_size);
+    auto ret = memcpy_s(values_data + index * value_dim_, value_size_, value, value_size_);
     if (ret != EOK) {
       MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
     }
     ++index;
-  }
+  });
   return {keys, values, statuses};
 }
 
@@ -337,16 +539,13 @@ HashTableExportData CPUHashTable<Key, Value>::ExportSliceIncrementally(size_t be
     MS_LOG(EXCEPTION) << "Invalid export position parameter, begin: " << begin << ", end: " << end;
   }
 
-  auto begin_iter = values_.begin();
-  std::advance(begin_iter, begin);
-  auto end_iter = values_.begin();
-  std::advance(end_iter, end);
-
   // 1. Count export number of all modified elememts.
-  size_t update_elements_size = LongToSize(
-    std::count_if(begin_iter, end_iter, [](typename std::unordered_map<Key, ValueStatusPair>::const_reference item) {
-      return item.second.second != Status::kUnchanged;
-    }));
+  size_t update_elements_size = 0;
+  ForEachElement(begin, end, [&update_elements_size](const Key &, const Value *, Status status) {
+    if (status != Status::kUnchanged) {
+      ++update_elements_size;
+    }
+  });
 
   auto keys = std::make_shared<std::vector<char>>(update_elements_size * sizeof(Key));
   auto keys_data = reinterpret_cast<Key *>(keys->data());
@@ -357,12 +556,9 @@ HashTableExportData CPUHashTable<Key, Value>::ExportSliceIncrementally(size_t be
 
   // 2. Export all modified elememts.
   size_t index = 0;
-  for (auto iter = begin_iter; iter != end_iter; ++iter) {
-    auto key = iter->first;
-    auto value = iter->second.first;
-    auto status = iter->second.second;
-    if (status == Status::kUnchanged) {
-      continue;
+  ForEachElement(begin, end, [&](const Key &key, const Value *value, Status status) {
+    if (status == Status::kUnchanged || index >= update_elements_size) {
+      return;
     }
 
     // Export the key.
@@ -371,15 +567,12 @@ HashTableExportData CPUHashTable<Key, Value>::ExportSliceIncrementally(size_t be
     statuses_data[index] = status;
 
     // Export the value.
-    size_t offset = index * value_dim_;
-    size_t src_size = value_size_;
-    size_t dst_size = value_size_;
-    auto ret = memcpy_s(values_data + offset, dst_size, value, src_size);
+    auto ret = memcpy_s(values_data + index * value_dim_, value_size_, value, value_size_);
     if (ret != EOK) {
       MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
     }
     ++index;
-  }
+  });
   return {keys, values, statuses};
 }
 
@@ -442,14 +635,12 @@ HashTableExportData CPUHashTable<Key, Value>::ExportSlice(bool incremental, bool
 
 template <typename Key, typename Value>
 size_t CPUHashTable<Key, Value>::capacity() const {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  return values_.size();
+  return size_;
 }
 
 template <typename Key, typename Value>
 size_t CPUHashTable<Key, Value>::size() const {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  return values_.size();
+  return size_;
 }
 
 template <typename Key, typename Value>
@@ -459,15 +650,20 @@ bool CPUHashTable<Key, Value>::is_dirty() const {
 
 template <typename Key, typename Value>
 bool CPUHashTable<Key, Value>::Clear() {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  // Return all the memory of values in hash table to the memory pool.
-  for (auto iter = values_.begin(); iter != values_.end(); iter++) {
-    auto value = iter->second.first;
-    if (value != nullptr) {
-      FreeMemory(value);
+  for (auto &shard : shards_) {
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    // Return all the memory of value slabs in the shard to the memory pool.
+    for (auto slab : shard.slabs) {
+      if (slab != nullptr) {
+        FreeMemory(slab);
+      }
     }
+    size_ -= shard.keys.size();
+    shard.slabs.clear();
+    shard.keys.clear();
+    shard.statuses.clear();
+    shard.slots.clear();
   }
-  (void)values_.clear();
   return true;
 }
 
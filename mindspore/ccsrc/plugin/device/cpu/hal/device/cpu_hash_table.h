@@ -16,8 +16,9 @@
 #ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_HASH_TABLE_H_
 #define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_HASH_TABLE_H_
 
+#include <array>
+#include <atomic>
 #include <shared_mutex>
-#include <unordered_map>
 #include <random>
 #include <vector>
 #include <string>
@@ -39,12 +40,13 @@ using DataType = float;
 using Generator = random::Philox;
 using NormalDistribution = random::NormalDistribution<double>;
 
-// A hash table base on the host side cpu.
+// A hash table base on the host side cpu. The elements are spread over shards by the hash of keys so that the writers
+// of different shards do not block each other, and each shard is an open addressing hash table whose values are kept in
+// contiguous slabs.
 template <typename Key, typename Value>
 class CPUHashTable : public HashTable<Key, Value> {
  public:
   using Status = HashTableElementStatus;
-  using ValueStatusPair = std::pair<Value *, Status>;
 
   CPUHashTable(size_t value_dim, const std::string &initializer);
   CPUHashTable(size_t value_dim, const Value &default_value);
@@ -85,25 +87,76 @@ class CPUHashTable : public HashTable<Key, Value> {
   bool Clear() override;
 
  private:
-  // Export all keys, values and status of the hash table in the iterator interval [begin, end).
+  // The number of shards, which should be a power of 2.
+  static constexpr size_t kShardBits = 4;
+  static constexpr size_t kShardNum = static_cast<size_t>(1) << kShardBits;
+
+  // The slot of the open addressing index, `pos` is the position of the element in the shard plus 1, 0 means the slot
+  // is empty.
+  struct Slot {
+    Key key;
+    size_t pos;
+  };
+
+  // The elements of a shard are stored densely in the insertion order: keys and statuses in arrays and values in the
+  // fixed size slabs, so the position of an element is also the order of export. The slots map keys to positions by
+  // linear probing.
+  struct Shard {
+    std::vector<Key> keys;
+    std::vector<Status> statuses;
+    std::vector<Value *> slabs;
+    std::vector<Slot> slots;
+    mutable std::shared_mutex mutex;
+  };
+
+  // Export all keys, values and status of the hash table in the position interval [begin, end), the positions of the
+  // elements are counted through the shards one by one.
   HashTableExportData ExportSliceFully(size_t begin, size_t end);
 
-  // Export the keys, values and status in the iterator interval [begin, end) which are modified or erased since last
+  // Export the keys, values and status in the position interval [begin, end) which are modified or erased since last
   // import or export.
   HashTableExportData ExportSliceIncrementally(size_t begin, size_t end);
 
+  // Visit the elements in the position interval [begin, end) in order.
+  template <typename Func>
+  void ForEachElement(size_t begin, size_t end, const Func &func) const;
+
+  // Group the indices of keys by shard, the indices of keys in shard i are in [offsets[i], offsets[i + 1]) of indices.
+  void GroupByShard(const Key *keys, size_t key_num, std::vector<uint64_t> *hashes, std::vector<size_t> *offsets,
+                    std::vector<size_t> *indices) const;
+
+  // Return the slot of the key in the shard, or the size of slots if the key does not exist.
+  size_t FindSlot(const Shard &shard, const Key &key, uint64_t hash) const;
+
+  // Return the position of the key in the shard, a new element is appended if the key does not exist.
+  size_t FindOrAddElement(Shard *shard, const Key &key, uint64_t hash, Status status, bool *is_new);
+
+  // Remove the element in the slot, the last element of the shard is moved to its position.
+  void EraseElement(Shard *shard, size_t slot);
+
+  // Rebuild the slots of shard to hold at least `element_num` elements within the max load factor.
+  void Rehash(Shard *shard, size_t element_num);
+
+  Value *GetValue(const Shard &shard, size_t pos) const {
+    return shard.slabs[pos / slab_element_num_] + (pos % slab_element_num_) * value_dim_;
+  }
+
+  // Fill the value of a missing key by default_value or initializer.
+  bool InitializeValue(Value *value) const;
+
   // Allocate host memory from dynamic memory pool.
   void *AllocateMemory(size_t size) const;
 
   // Free host memory to dynamic memory pool.
   void FreeMemory(void *ptr) const;
 
-  // The key-value style elements stored in this hash table.
-  std::unordered_map<Key, ValueStatusPair> values_;
+  std::array<Shard, kShardNum> shards_;
+
+  // The total number of elements of all shards.
+  std::atomic<size_t> size_{0};
 
-  // This mutex is to guarantee the thread-safe of the `values_` above.
-  // The perforcemence of this thread-safe mechanism is poor, so a more efficient way could be used later.
-  mutable std::shared_mutex mutex_;
+  // The number of elements in a value slab.
+  size_t slab_element_num_{1};
 
   // The value dimension and byte size for each key.
   size_t value_dim_;
@@ -114,9 +167,9 @@ class CPUHashTable : public HashTable<Key, Value> {
   Value default_value_;
   // The flag records whether the elements of the hash table have changed since the last export, true means that there
   // has been a change.
-  bool is_dirty_{true};
+  std::atomic<bool> is_dirty_{true};
 
-  // Record the position of slice export, the elements in the iterator interval [begin_, end_) of hash table will be
+  // Record the position of slice export, the elements in the position interval [begin_, end_) of hash table will be
   // exported.
   size_t begin_{0};
   size_t end_{0};
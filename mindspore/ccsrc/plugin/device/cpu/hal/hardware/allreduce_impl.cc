@@ -19,12 +19,89 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include <map>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
+#include "utils/convert_utils_base.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 namespace {
 constexpr size_t kWaitTimeout = 30;
+// The retry number and interval in seconds to get the host names of all the ranks.
+constexpr size_t kGetHostNamesRetry = 200;
+constexpr uint32_t kGetHostNamesInterval = 3;
+
+AllReduceAlgorithm ParseAllReduceAlgorithm(const std::string &name) {
+  static const std::map<std::string, AllReduceAlgorithm> kAlgorithms = {
+    {"", AllReduceAlgorithm::kAuto},
+    {"ring", AllReduceAlgorithm::kRing},
+    {"recursive_doubling", AllReduceAlgorithm::kRecursiveDoubling},
+    {"rabenseifner", AllReduceAlgorithm::kRabenseifner},
+    {"hierarchical", AllReduceAlgorithm::kHierarchical},
+    {"reduce_broadcast", AllReduceAlgorithm::kReduceBroadcast}};
+  auto iter = kAlgorithms.find(name);
+  if (iter == kAlgorithms.end()) {
+    MS_LOG(EXCEPTION) << "The value of " << kEnvCpuAllReduceAlgorithm
+                      << " should be one of 'ring', 'recursive_doubling', 'rabenseifner', 'hierarchical' and "
+                         "'reduce_broadcast', but got: "
+                      << name;
+  }
+  return iter->second;
+}
+
+// Split the data into chunks whose sizes differ by one at most.
+void SplitChunks(size_t data_num, size_t chunk_num, std::vector<size_t> *chunk_sizes,
+                 std::vector<size_t> *chunk_offsets) {
+  chunk_sizes->assign(chunk_num, data_num / chunk_num);
+  chunk_offsets->assign(chunk_num, 0);
+  for (size_t i = 0; i < data_num % chunk_num; i++) {
+    (*chunk_sizes)[i]++;
+  }
+  for (size_t i = 1; i < chunk_num; i++) {
+    (*chunk_offsets)[i] = (*chunk_offsets)[i - 1] + (*chunk_sizes)[i - 1];
+  }
+}
+
+size_t LargestPowerOfTwo(size_t num) {
+  size_t pof2 = 1;
+  while (pof2 * 2 <= num) {
+    pof2 *= 2;
+  }
+  return pof2;
+}
+
+// The index in the group of the rank whose index is 'new_index' after the ranks are folded.
+size_t UnfoldedIndex(size_t new_index, size_t rem) { return new_index < rem ? new_index * 2 + 1 : new_index + rem; }
+
+// Add the received data to the buffer with the SIMD implementation of the cpu kernels.
+bool ReduceSum(float *buff, const unsigned char *data, size_t size) {
+  const auto *src = reinterpret_cast<const float *>(data);
+  size_t num = size / sizeof(float);
+  const size_t kMaxReduceNum = static_cast<size_t>(std::numeric_limits<int>::max());
+  for (size_t start = 0; start < num; start += kMaxReduceNum) {
+    int reduce_num = static_cast<int>(std::min(kMaxReduceNum, num - start));
+    if (ElementAdd(buff + start, src + start, buff + start, reduce_num) != NNACL_OK) {
+      MS_LOG(ERROR) << "Failed to reduce the received data of size " << size;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CopyData(void *dst, const unsigned char *data, size_t size) {
+  int memcpy_ret = memcpy_s(dst, size, data, size);
+  if (memcpy_ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s received data error, errorno(" << memcpy_ret << ")";
+    return false;
+  }
+  return true;
+}
 }  // namespace
 
 bool AllReduceLauncher::Initialize() {
@@ -42,10 +119,71 @@ bool AllReduceLauncher::Initialize() {
   }
 
   node_role_ = cluster_ctx->node_role();
-  rank_size_ = static_cast<size_t>(cluster_ctx->node_num(cluster_ctx->node_role()));
+  auto rank_size = static_cast<size_t>(cluster_ctx->node_num(cluster_ctx->node_role()));
+  std::vector<std::string> host_names;
+  if (cgn != nullptr && node_role_ != distributed::kEnvRoleOfScheduler) {
+    // All the ranks must agree on the topology, otherwise they may choose different algorithms and wait for each
+    // other forever, so the host names are waited until all the ranks are registered.
+    for (size_t retry = 0; retry < kGetHostNamesRetry; retry++) {
+      host_names = cgn->GetHostNames(node_role_);
+      if (host_names.size() == rank_size) {
+        break;
+      }
+      (void)sleep(kGetHostNamesInterval);
+    }
+    if (host_names.size() != rank_size) {
+      MS_LOG(EXCEPTION) << "Failed to get the host names of all the " << rank_size << " ranks, only got "
+                        << host_names.size();
+    }
+  }
+  InitRanks(rank_id_, rank_size, ParseAllReduceAlgorithm(common::GetEnv(kEnvCpuAllReduceAlgorithm)), host_names);
   return true;
 }
 
+void AllReduceLauncher::InitRanks(size_t rank_id, size_t rank_size, AllReduceAlgorithm algorithm,
+                                  const std::vector<std::string> &host_names) {
+  rank_id_ = rank_id;
+  rank_size_ = rank_size;
+  world_ranks_.resize(rank_size_);
+  for (size_t i = 0; i < rank_size_; i++) {
+    world_ranks_[i] = SizeToUint(i);
+  }
+  algorithm_ = algorithm;
+  if (!host_names.empty()) {
+    InitTopology(host_names);
+  }
+}
+
+void AllReduceLauncher::InitTopology(const std::vector<std::string> &host_names) {
+  // The hosts are ordered by the smallest rank on them, and the ranks on a host are ordered by the rank id.
+  std::vector<std::string> hosts;
+  std::map<std::string, std::vector<uint32_t>> host_ranks;
+  for (size_t i = 0; i < rank_size_; i++) {
+    if (host_ranks.count(host_names[i]) == 0) {
+      hosts.push_back(host_names[i]);
+    }
+    host_ranks[host_names[i]].push_back(SizeToUint(i));
+  }
+  local_ranks_ = host_ranks[host_names[rank_id_]];
+  local_index_ = LongToSize(std::find(local_ranks_.begin(), local_ranks_.end(), rank_id_) - local_ranks_.begin());
+  bool uniform = std::all_of(host_ranks.begin(), host_ranks.end(),
+                             [this](const auto &item) { return item.second.size() == local_ranks_.size(); });
+  if (!uniform || hosts.size() == 1 || local_ranks_.size() == 1) {
+    MS_LOG(INFO) << "The hierarchical AllReduce is disabled, host number: " << hosts.size()
+                 << ", rank number of this host: " << local_ranks_.size() << ", uniform: " << uniform;
+    return;
+  }
+  for (size_t i = 0; i < hosts.size(); i++) {
+    cross_ranks_.push_back(host_ranks[hosts[i]][local_index_]);
+    if (hosts[i] == host_names[rank_id_]) {
+      cross_index_ = i;
+    }
+  }
+  hierarchical_available_ = true;
+  MS_LOG(INFO) << "The hierarchical AllReduce is available, local ranks: " << local_ranks_
+               << ", cross host ranks: " << cross_ranks_;
+}
+
 bool AllReduceLauncher::Finalize() {
   MS_EXCEPTION_IF_NULL(abs_node_);
   if (!abs_node_->Finish()) {
@@ -66,138 +204,441 @@ bool AllReduceLauncher::Execute(const void *input_data, void *const output_data,
     return true;
   }
   size_t data_num = data_size / sizeof(float);
-  if (data_num < rank_size_) {
+  auto algorithm = algorithm_;
+  if (algorithm == AllReduceAlgorithm::kHierarchical && !hierarchical_available_) {
+    algorithm = AllReduceAlgorithm::kAuto;
+  }
+  // Reduce within the hosts first if the data is large enough to be split among the local ranks.
+  if (algorithm == AllReduceAlgorithm::kAuto && hierarchical_available_ && data_size > kRecursiveDoublingMaxSize &&
+      data_num >= local_ranks_.size()) {
+    algorithm = AllReduceAlgorithm::kHierarchical;
+  }
+  if (algorithm == AllReduceAlgorithm::kReduceBroadcast) {
     MS_LOG(DEBUG) << "AllReduceLauncher executes ReduceBroadcastAllReduce algorithm on the rank " << rank_id_;
     return ReduceBroadcastAllReduce(input_data, output_data, data_size);
   }
-  // If the data number is not less than the node number, the RingAllReduce algorithm is used.
-  MS_LOG(DEBUG) << "AllReduceLauncher executes RingAllReduce algorithm on the rank " << rank_id_;
-  return RingAllReduce(input_data, output_data, data_size);
-}
 
-bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const {
-  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
-  if (memcpy_ret != EOK) {
-    MS_LOG(ERROR) << "RingAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
-    return false;
+  // The input and output are the same buffer when the AllReduce is launched in place.
+  if (output_data != input_data) {
+    int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "AllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+      return false;
+    }
   }
   MS_EXCEPTION_IF_CHECK_FAIL((rank_size_ != 0), "The rank size is zero.");
-  size_t data_num = data_size / sizeof(float);
-  size_t chunk_size = data_num / rank_size_;
-  size_t remainder_size = data_num % rank_size_;
-  std::vector<size_t> chunk_sizes(rank_size_, chunk_size);
-  // The rest of the data should be assigned to each chunk.
-  for (size_t i = 0; i < remainder_size; i++) {
-    chunk_sizes[i]++;
-  }
-  // Store offsets to get every data chunk's address.
-  std::vector<size_t> chunk_offset;
-  for (size_t i = 0; i < rank_size_; i++) {
-    size_t ofs =
-      std::accumulate(chunk_sizes.begin(), chunk_sizes.begin() + SizeToLong(i), size_t(0), std::plus<size_t>());
-    chunk_offset.push_back(ofs);
+  if (rank_size_ == 1) {
+    return true;
   }
-
   auto *output_buff = reinterpret_cast<float *>(output_data);
-  uint32_t send_to_rank = SizeToUint((rank_id_ + 1) % rank_size_);
-  uint32_t rec_from_rank = SizeToUint((rank_id_ - 1 + rank_size_) % rank_size_);
-  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", rank_size_:" << rank_size_ << ", rank_id_:" << rank_id_
-                << ", chunk_size:" << chunk_size << ", remainder_size:" << remainder_size
-                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
-                << ", rec_from_rank:" << rec_from_rank;
-
-  // Ring ReduceScatter.
-  MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
-  MS_EXCEPTION_IF_NULL(abs_node_);
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    // Step 1: Async send data to next rank.
-    size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    // Step 2: Async receive data to next rank and wait until it's done.
-    size_t rec_chunk_index = (rank_id_ - i - 1 + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring ReduceScatter send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+  if (algorithm == AllReduceAlgorithm::kHierarchical) {
+    MS_LOG(DEBUG) << "AllReduceLauncher executes HierarchicalAllReduce algorithm on the rank " << rank_id_;
+    return HierarchicalAllReduce(output_buff, data_num);
+  }
+  return GroupAllReduce(output_buff, data_num, world_ranks_, rank_id_, algorithm);
+}
 
+AllReduceAlgorithm AllReduceLauncher::SelectAlgorithm(size_t data_num, size_t group_size) const {
+  size_t data_size = data_num * sizeof(float);
+  if (data_size <= kRecursiveDoublingMaxSize || data_num < group_size) {
+    return AllReduceAlgorithm::kRecursiveDoubling;
+  }
+  if (data_size <= kRabenseifnerMaxSize) {
+    return AllReduceAlgorithm::kRabenseifner;
+  }
+  return AllReduceAlgorithm::kRing;
+}
+
+bool AllReduceLauncher::GroupAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks, size_t index,
+                                       AllReduceAlgorithm algorithm) const {
+  if (ranks.size() <= 1) {
+    return true;
+  }
+  if (algorithm != AllReduceAlgorithm::kRing && algorithm != AllReduceAlgorithm::kRecursiveDoubling &&
+      algorithm != AllReduceAlgorithm::kRabenseifner) {
+    algorithm = SelectAlgorithm(data_num, ranks.size());
+  }
+  // Every block of Rabenseifner's algorithm should not be empty.
+  if (algorithm == AllReduceAlgorithm::kRabenseifner && data_num < LargestPowerOfTwo(ranks.size())) {
+    algorithm = AllReduceAlgorithm::kRecursiveDoubling;
+  }
+  switch (algorithm) {
+    case AllReduceAlgorithm::kRecursiveDoubling:
+      MS_LOG(DEBUG) << "AllReduceLauncher executes RecursiveDoublingAllReduce algorithm on the rank " << rank_id_;
+      return RecursiveDoublingAllReduce(buff, data_num, ranks, index);
+    case AllReduceAlgorithm::kRabenseifner:
+      MS_LOG(DEBUG) << "AllReduceLauncher executes RabenseifnerAllReduce algorithm on the rank " << rank_id_;
+      return RabenseifnerAllReduce(buff, data_num, ranks, index);
+    default:
+      MS_LOG(DEBUG) << "AllReduceLauncher executes RingAllReduce algorithm on the rank " << rank_id_;
+      return RingAllReduce(buff, data_num, ranks, index);
+  }
+}
+
+bool AllReduceLauncher::SendRecv(uint32_t send_to, const void *send_data, size_t send_size, uint32_t recv_from,
+                                 size_t recv_size, const SegmentHandler &on_received) const {
+  // The data is copied into the sending buffer of the connection, so the buffer can be reduced in place right after
+  // the sending is issued.
+  std::vector<uint64_t> send_req_ids;
+  const auto *send_bytes = static_cast<const unsigned char *>(send_data);
+  for (size_t offset = 0; offset < send_size; offset += kPipelineSegmentSize) {
+    size_t size = std::min(kPipelineSegmentSize, send_size - offset);
+    send_req_ids.push_back(SendAsync(send_to, send_bytes + offset, size));
+  }
+  for (size_t offset = 0; offset < recv_size; offset += kPipelineSegmentSize) {
+    size_t size = std::min(kPipelineSegmentSize, recv_size - offset);
     std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait receiving [" << rec_req_id.first << "," << rec_req_id.second
-                    << "] failed.";
+    if (!Receive(recv_from, &rec_ptr)) {
+      MS_LOG(ERROR) << "Wait receiving from rank " << recv_from << " failed.";
       return false;
     }
-    // Step 3: Reduce the data, so we can overlap the time cost of send.
     MS_EXCEPTION_IF_NULL(rec_ptr);
-    const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-    for (size_t j = 0; j < chunk_sizes[rec_chunk_index]; j++) {
-      rec_chunk[j] += tmp_data[j];
+    if (rec_ptr->size() != size) {
+      MS_LOG(ERROR) << "The size of data received from rank " << recv_from << " is " << rec_ptr->size()
+                    << ", but expected " << size;
+      return false;
     }
-    // Step 4: Wait until send is done.
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait sending " << send_req_id << " failed.";
+    if (!on_received(offset, rec_ptr->data(), size)) {
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End Ring ReduceScatter.";
+  for (auto send_req_id : send_req_ids) {
+    if (!WaitSend(send_req_id)) {
+      MS_LOG(ERROR) << "Wait sending " << send_req_id << " to rank " << send_to << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
 
-  // Ring AllGather.
-  MS_LOG(DEBUG) << "Start Ring AllGather.";
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    size_t send_chunk_index = (rank_id_ - i + 1 + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    size_t rec_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
+bool AllReduceLauncher::RingReduceScatter(float *buff, const std::vector<size_t> &chunk_sizes,
+                                          const std::vector<size_t> &chunk_offsets, const std::vector<uint32_t> &ranks,
+                                          size_t index) const {
+  size_t group_size = ranks.size();
+  uint32_t send_to_rank = ranks[(index + 1) % group_size];
+  uint32_t rec_from_rank = ranks[(index + group_size - 1) % group_size];
+  for (size_t i = 0; i + 1 < group_size; i++) {
+    // Each step sends the chunk reduced in the last step, so the chunk of 'index' is reduced by all ranks at last.
+    size_t send_chunk_index = (index + 2 * group_size - i - 1) % group_size;
+    size_t rec_chunk_index = (index + 2 * group_size - i - 2) % group_size;
+    float *rec_chunk = buff + chunk_offsets[rec_chunk_index];
+    MS_LOG(DEBUG) << "Ring ReduceScatter send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
+                  << ", send data_num:" << chunk_sizes[send_chunk_index]
+                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+    if (!SendRecv(send_to_rank, buff + chunk_offsets[send_chunk_index], chunk_sizes[send_chunk_index] * sizeof(float),
+                  rec_from_rank, chunk_sizes[rec_chunk_index] * sizeof(float),
+                  [rec_chunk](size_t offset, const unsigned char *data, size_t size) {
+                    return ReduceSum(rec_chunk + offset / sizeof(float), data, size);
+                  })) {
+      MS_LOG(ERROR) << "Ring ReduceScatter failed at iteration " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AllReduceLauncher::RingAllGather(float *buff, const std::vector<size_t> &chunk_sizes,
+                                      const std::vector<size_t> &chunk_offsets, const std::vector<uint32_t> &ranks,
+                                      size_t index) const {
+  size_t group_size = ranks.size();
+  uint32_t send_to_rank = ranks[(index + 1) % group_size];
+  uint32_t rec_from_rank = ranks[(index + group_size - 1) % group_size];
+  for (size_t i = 0; i + 1 < group_size; i++) {
+    size_t send_chunk_index = (index + group_size - i) % group_size;
+    size_t rec_chunk_index = (index + 2 * group_size - i - 1) % group_size;
+    auto *rec_chunk = reinterpret_cast<unsigned char *>(buff + chunk_offsets[rec_chunk_index]);
     MS_LOG(DEBUG) << "Ring AllGather send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
                   << ", send data_num:" << chunk_sizes[send_chunk_index]
                   << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+    if (!SendRecv(send_to_rank, buff + chunk_offsets[send_chunk_index], chunk_sizes[send_chunk_index] * sizeof(float),
+                  rec_from_rank, chunk_sizes[rec_chunk_index] * sizeof(float),
+                  [rec_chunk](size_t offset, const unsigned char *data, size_t size) {
+                    return CopyData(rec_chunk + offset, data, size);
+                  })) {
+      MS_LOG(ERROR) << "Ring AllGather failed at iteration " << i;
+      return false;
+    }
+  }
+  return true;
+}
 
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring AllGather wait receiving " << rec_req_id << " failed.";
+bool AllReduceLauncher::RingAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks,
+                                      size_t index) const {
+  std::vector<size_t> chunk_sizes;
+  std::vector<size_t> chunk_offsets;
+  SplitChunks(data_num, ranks.size(), &chunk_sizes, &chunk_offsets);
+  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", group size:" << ranks.size() << ", index:" << index
+                << ", chunk_sizes:" << chunk_sizes;
+  return RingReduceScatter(buff, chunk_sizes, chunk_offsets, ranks, index) &&
+         RingAllGather(buff, chunk_sizes, chunk_offsets, ranks, index);
+}
+
+bool AllReduceLauncher::FoldRanks(float *buff, size_t data_num, const std::vector<uint32_t> &ranks, size_t index,
+                                  int64_t *new_index) const {
+  size_t rem = ranks.size() - LargestPowerOfTwo(ranks.size());
+  size_t data_size = data_num * sizeof(float);
+  if (index >= 2 * rem) {
+    *new_index = SizeToLong(index - rem);
+    return true;
+  }
+  // The even rank of the first 2 * rem ranks sends its data to the next odd rank and waits for the result.
+  if (index % 2 == 0) {
+    *new_index = -1;
+    return SendRecv(ranks[index + 1], buff, data_size, ranks[index + 1], 0, nullptr);
+  }
+  *new_index = SizeToLong(index / 2);
+  return SendRecv(ranks[index - 1], nullptr, 0, ranks[index - 1], data_size,
+                  [buff](size_t offset, const unsigned char *data, size_t size) {
+                    return ReduceSum(buff + offset / sizeof(float), data, size);
+                  });
+}
+
+bool AllReduceLauncher::UnfoldRanks(float *buff, size_t data_num, const std::vector<uint32_t> &ranks,
+                                    size_t index) const {
+  size_t rem = ranks.size() - LargestPowerOfTwo(ranks.size());
+  size_t data_size = data_num * sizeof(float);
+  if (index >= 2 * rem) {
+    return true;
+  }
+  if (index % 2 == 1) {
+    return SendRecv(ranks[index - 1], buff, data_size, ranks[index - 1], 0, nullptr);
+  }
+  auto *output = reinterpret_cast<unsigned char *>(buff);
+  return SendRecv(ranks[index + 1], nullptr, 0, ranks[index + 1], data_size,
+                  [output](size_t offset, const unsigned char *data, size_t size) {
+                    return CopyData(output + offset, data, size);
+                  });
+}
+
+bool AllReduceLauncher::RecursiveDoublingAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks,
+                                                   size_t index) const {
+  size_t pof2 = LargestPowerOfTwo(ranks.size());
+  size_t rem = ranks.size() - pof2;
+  size_t data_size = data_num * sizeof(float);
+  int64_t new_index = -1;
+  if (!FoldRanks(buff, data_num, ranks, index, &new_index)) {
+    MS_LOG(ERROR) << "Recursive doubling failed to fold the ranks.";
+    return false;
+  }
+  if (new_index >= 0) {
+    // Exchange the whole data with the partner of doubling distance and reduce it.
+    for (size_t mask = 1; mask < pof2; mask <<= 1) {
+      uint32_t peer_rank = ranks[UnfoldedIndex(LongToSize(new_index) ^ mask, rem)];
+      if (!SendRecv(peer_rank, buff, data_size, peer_rank, data_size,
+                    [buff](size_t offset, const unsigned char *data, size_t size) {
+                      return ReduceSum(buff + offset / sizeof(float), data, size);
+                    })) {
+        MS_LOG(ERROR) << "Recursive doubling failed to exchange data with rank " << peer_rank;
+        return false;
+      }
+    }
+  }
+  return UnfoldRanks(buff, data_num, ranks, index);
+}
+
+bool AllReduceLauncher::RabenseifnerAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks,
+                                              size_t index) const {
+  size_t pof2 = LargestPowerOfTwo(ranks.size());
+  size_t rem = ranks.size() - pof2;
+  int64_t new_index = -1;
+  if (!FoldRanks(buff, data_num, ranks, index, &new_index)) {
+    MS_LOG(ERROR) << "Rabenseifner AllReduce failed to fold the ranks.";
+    return false;
+  }
+  if (new_index < 0) {
+    return UnfoldRanks(buff, data_num, ranks, index);
+  }
+
+  std::vector<size_t> block_sizes;
+  std::vector<size_t> block_offsets;
+  SplitChunks(data_num, pof2, &block_sizes, &block_offsets);
+  auto block_bytes = [&block_sizes](size_t begin, size_t end) {
+    return std::accumulate(block_sizes.begin() + SizeToLong(begin), block_sizes.begin() + SizeToLong(end), size_t(0)) *
+           sizeof(float);
+  };
+  size_t my_index = LongToSize(new_index);
+
+  // Recursive halving ReduceScatter: exchange half of the blocks kept with the partner of doubling distance, and keep
+  // reducing the other half until this rank owns the reduced block of its new index.
+  size_t send_idx = 0;
+  size_t recv_idx = 0;
+  size_t last_idx = pof2;
+  size_t mask = 1;
+  for (; mask < pof2; mask <<= 1) {
+    size_t peer_index = my_index ^ mask;
+    uint32_t peer_rank = ranks[UnfoldedIndex(peer_index, rem)];
+    size_t half = pof2 / (mask * 2);
+    size_t send_end = last_idx;
+    size_t recv_end = last_idx;
+    if (my_index < peer_index) {
+      send_idx = recv_idx + half;
+      recv_end = send_idx;
+    } else {
+      recv_idx = send_idx + half;
+      send_end = recv_idx;
+    }
+    float *recv_buff = buff + block_offsets[recv_idx];
+    if (!SendRecv(peer_rank, buff + block_offsets[send_idx], block_bytes(send_idx, send_end), peer_rank,
+                  block_bytes(recv_idx, recv_end), [recv_buff](size_t offset, const unsigned char *data, size_t size) {
+                    return ReduceSum(recv_buff + offset / sizeof(float), data, size);
+                  })) {
+      MS_LOG(ERROR) << "Recursive halving ReduceScatter failed to exchange data with rank " << peer_rank;
       return false;
     }
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    memcpy_ret = memcpy_s(rec_chunk, chunk_sizes[rec_chunk_index] * sizeof(float), rec_ptr->data(), rec_ptr->size());
-    if (memcpy_ret != 0) {
-      MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
+    send_idx = recv_idx;
+    last_idx = recv_idx + half;
+  }
+
+  // Recursive doubling AllGather in the reverse order of the ReduceScatter.
+  for (mask = pof2 / 2; mask > 0; mask >>= 1) {
+    size_t peer_index = my_index ^ mask;
+    uint32_t peer_rank = ranks[UnfoldedIndex(peer_index, rem)];
+    size_t half = pof2 / (mask * 2);
+    size_t send_begin = send_idx;
+    size_t send_end = 0;
+    size_t recv_begin = 0;
+    size_t recv_end = 0;
+    if (my_index < peer_index) {
+      send_end = send_idx + half;
+      recv_begin = send_end;
+      recv_end = recv_begin + half;
+    } else {
+      send_end = send_idx + half;
+      recv_begin = send_idx - half;
+      recv_end = send_idx;
+    }
+    auto *recv_buff = reinterpret_cast<unsigned char *>(buff + block_offsets[recv_begin]);
+    auto copy_received = [recv_buff](size_t offset, const unsigned char *data, size_t size) {
+      return CopyData(recv_buff + offset, data, size);
+    };
+    if (!SendRecv(peer_rank, buff + block_offsets[send_begin], block_bytes(send_begin, send_end), peer_rank,
+                  block_bytes(recv_begin, recv_end), copy_received)) {
+      MS_LOG(ERROR) << "Recursive doubling AllGather failed to exchange data with rank " << peer_rank;
       return false;
     }
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "RingAllReduce wait sending " << send_req_id << " failed.";
+    send_idx = std::min(send_begin, recv_begin);
+  }
+  return UnfoldRanks(buff, data_num, ranks, index);
+}
+
+bool AllReduceLauncher::HierarchicalAllReduce(float *buff, size_t data_num) const {
+  std::vector<size_t> chunk_sizes;
+  std::vector<size_t> chunk_offsets;
+  SplitChunks(data_num, local_ranks_.size(), &chunk_sizes, &chunk_offsets);
+  if (!RingReduceScatter(buff, chunk_sizes, chunk_offsets, local_ranks_, local_index_)) {
+    MS_LOG(ERROR) << "Hierarchical AllReduce failed to reduce the data within the host.";
+    return false;
+  }
+  // The ranks with the same local index own the same chunk, which is reduced among the hosts by the algorithm suited
+  // to the chunk size.
+  if (!GroupAllReduce(buff + chunk_offsets[local_index_], chunk_sizes[local_index_], cross_ranks_, cross_index_,
+                      AllReduceAlgorithm::kAuto)) {
+    MS_LOG(ERROR) << "Hierarchical AllReduce failed to reduce the data among the hosts.";
+    return false;
+  }
+  if (!RingAllGather(buff, chunk_sizes, chunk_offsets, local_ranks_, local_index_)) {
+    MS_LOG(ERROR) << "Hierarchical AllReduce failed to gather the data within the host.";
+    return false;
+  }
+  return true;
+}
+
+bool AllReduceLauncher::ReduceScatter(const void *input_data, void *const output_data, size_t recv_size) const {
+  MS_EXCEPTION_IF_NULL(input_data);
+  MS_EXCEPTION_IF_NULL(output_data);
+  if (node_role_ == distributed::kEnvRoleOfScheduler) {
+    return true;
+  }
+  MS_EXCEPTION_IF_CHECK_FAIL((rank_size_ != 0), "The rank size is zero.");
+  size_t recv_num = recv_size / sizeof(float);
+  std::vector<float> buff(recv_num * rank_size_);
+  int memcpy_ret = memcpy_s(buff.data(), buff.size() * sizeof(float), input_data, buff.size() * sizeof(float));
+  if (memcpy_ret != EOK) {
+    MS_LOG(ERROR) << "ReduceScatter memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+    return false;
+  }
+  std::vector<size_t> chunk_sizes(rank_size_, recv_num);
+  std::vector<size_t> chunk_offsets(rank_size_, 0);
+  for (size_t i = 1; i < rank_size_; i++) {
+    chunk_offsets[i] = chunk_offsets[i - 1] + recv_num;
+  }
+  if (!RingReduceScatter(buff.data(), chunk_sizes, chunk_offsets, world_ranks_, rank_id_)) {
+    return false;
+  }
+  memcpy_ret = memcpy_s(output_data, recv_size, buff.data() + chunk_offsets[rank_id_], recv_num * sizeof(float));
+  if (memcpy_ret != EOK) {
+    MS_LOG(ERROR) << "ReduceScatter memcpy_s output_data error, errorno(" << memcpy_ret << ")";
+    return false;
+  }
+  return true;
+}
+
+bool AllReduceLauncher::AllToAll(const void *input_data, void *const output_data, size_t block_size) const {
+  MS_EXCEPTION_IF_NULL(input_data);
+  MS_EXCEPTION_IF_NULL(output_data);
+  if (node_role_ == distributed::kEnvRoleOfScheduler) {
+    return true;
+  }
+  const auto *input = static_cast<const unsigned char *>(input_data);
+  auto *output = static_cast<unsigned char *>(output_data);
+  if (!CopyData(output + rank_id_ * block_size, input + rank_id_ * block_size, block_size)) {
+    return false;
+  }
+  // Pairwise exchange: in the step i, send to the rank i after this one and receive from the rank i before this one,
+  // so every rank sends and receives exactly one block in each step.
+  for (size_t step = 1; step < rank_size_; step++) {
+    size_t send_to_rank = (rank_id_ + step) % rank_size_;
+    size_t rec_from_rank = (rank_id_ + rank_size_ - step) % rank_size_;
+    unsigned char *rec_block = output + rec_from_rank * block_size;
+    if (!SendRecv(SizeToUint(send_to_rank), input + send_to_rank * block_size, block_size, SizeToUint(rec_from_rank),
+                  block_size, [rec_block](size_t offset, const unsigned char *data, size_t size) {
+                    return CopyData(rec_block + offset, data, size);
+                  })) {
+      MS_LOG(ERROR) << "AllToAll failed to exchange data with rank " << send_to_rank << " and " << rec_from_rank;
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End Ring AllGather.";
   return true;
 }
 
 const std::shared_ptr<ps::core::CollectiveNode> &AllReduceLauncher::collective_node() const { return abs_node_; }
 
+uint64_t AllReduceLauncher::SendAsync(uint32_t rank, const void *data, size_t size) const {
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  return abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, rank, data, size);
+}
+
+bool AllReduceLauncher::WaitSend(uint64_t request_id) const {
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  return abs_node_->Wait(request_id, kWaitTimeout);
+}
+
+bool AllReduceLauncher::Receive(uint32_t rank, std::shared_ptr<std::vector<unsigned char>> *data) const {
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rank, data);
+  return abs_node_->CollectiveWait(rec_req_id, kWaitTimeout);
+}
+
 bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *const output_data,
                                                  size_t data_size) const {
-  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
-  if (memcpy_ret != EOK) {
-    MS_LOG(ERROR) << "ReduceBroadcastAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
-    return false;
+  int memcpy_ret = EOK;
+  if (output_data != input_data) {
+    memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "ReduceBroadcastAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+      return false;
+    }
   }
   size_t data_num = data_size / sizeof(float);
   float *output_buff = reinterpret_cast<float *>(output_data);
   // Reduce data to rank 0 process.
   MS_LOG(DEBUG) << "Start Reduce to rank 0 process.";
-  MS_EXCEPTION_IF_NULL(abs_node_);
   if (rank_id_ == 0) {
     for (uint32_t i = 1; i < rank_size_; i++) {
       std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
       MS_LOG(DEBUG) << "Reduce rank 0 receive from rank " << i;
-      auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, i, &rec_ptr);
-      if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-        MS_LOG(ERROR) << "Reduce wait receiving " << rec_req_id << " failed.";
+      if (!Receive(i, &rec_ptr)) {
+        MS_LOG(ERROR) << "Reduce wait receiving from rank " << i << " failed.";
         return false;
       }
       MS_EXCEPTION_IF_NULL(rec_ptr);
@@ -208,9 +649,8 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
     }
   } else {
     MS_LOG(DEBUG) << "Reduce send data to rank 0 process.";
-    auto send_req_id =
-      abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, 0, input_data, data_num * sizeof(float));
-    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
+    auto send_req_id = SendAsync(0, input_data, data_num * sizeof(float));
+    if (!WaitSend(send_req_id)) {
       MS_LOG(ERROR) << "Reduce wait sending " << send_req_id << " failed.";
       return false;
     }
@@ -222,9 +662,8 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
   if (rank_id_ == 0) {
     for (uint32_t i = 1; i < rank_size_; i++) {
       MS_LOG(DEBUG) << "Broadcast data to process " << i;
-      auto send_req_id =
-        abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, i, output_buff, data_num * sizeof(float));
-      if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
+      auto send_req_id = SendAsync(i, output_buff, data_num * sizeof(float));
+      if (!WaitSend(send_req_id)) {
         MS_LOG(ERROR) << "Broadcast wait sending " << send_req_id << " failed.";
         return false;
       }
@@ -232,9 +671,8 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
   } else {
     MS_LOG(DEBUG) << "Broadcast receive from rank 0.";
     std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, 0, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Broadcast wait receiving " << rec_req_id << " failed.";
+    if (!Receive(0, &rec_ptr)) {
+      MS_LOG(ERROR) << "Broadcast wait receiving from rank 0 failed.";
       return false;
     }
     MS_EXCEPTION_IF_NULL(rec_ptr);
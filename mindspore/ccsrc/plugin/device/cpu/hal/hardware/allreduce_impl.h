@@ -19,34 +19,117 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <functional>
 #include "include/backend/distributed/cluster/cluster_context.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// The environment variable to choose the AllReduce algorithm of the cpu collective library, which is one of "ring",
+// "recursive_doubling", "rabenseifner", "hierarchical" and "reduce_broadcast". If it is not set, the algorithm is
+// chosen by the data size and whether the ranks are spread over several hosts.
+constexpr char kEnvCpuAllReduceAlgorithm[] = "MS_CPU_ALLREDUCE_ALGORITHM";
+
+enum class AllReduceAlgorithm { kAuto = 0, kRing, kRecursiveDoubling, kRabenseifner, kHierarchical, kReduceBroadcast };
+
+// The data no larger than this size is reduced by recursive doubling, whose latency is log(p) steps.
+constexpr size_t kRecursiveDoublingMaxSize = 32 * 1024;
+// The data no larger than this size is reduced by Rabenseifner's algorithm, i.e. the recursive halving ReduceScatter
+// followed by the recursive doubling AllGather, the larger data is reduced by the pipelined ring.
+constexpr size_t kRabenseifnerMaxSize = 16 * 1024 * 1024;
+// The data sent in one step is split into segments of this size, so the reduction of a received segment overlaps with
+// the transfer of the following ones.
+constexpr size_t kPipelineSegmentSize = 1024 * 1024;
+
 class AllReduceLauncher {
  public:
   AllReduceLauncher(const AllReduceLauncher &) = delete;
   AllReduceLauncher &operator=(const AllReduceLauncher &) = delete;
   AllReduceLauncher() = default;
-  ~AllReduceLauncher() = default;
+  virtual ~AllReduceLauncher() = default;
 
   bool Initialize();
   bool Finalize();
 
+  // AllReduce the float data of 'data_size' bytes by sum.
   bool Execute(const void *input_data, void *const output_data, size_t data_size) const;
 
+  // Reduce the float data of 'rank_size * recv_size' bytes by sum, and the rank i gets the i-th block of 'recv_size'
+  // bytes of the result.
+  bool ReduceScatter(const void *input_data, void *const output_data, size_t recv_size) const;
+
+  // Send the i-th block of 'block_size' bytes of the input to the rank i, and receive the i-th block of the output from
+  // the rank i.
+  bool AllToAll(const void *input_data, void *const output_data, size_t block_size) const;
+
   const std::shared_ptr<ps::core::CollectiveNode> &collective_node() const;
 
+ protected:
+  // Set up the ranks and the algorithm, and the topology of the ranks if their host names are given.
+  void InitRanks(size_t rank_id, size_t rank_size, AllReduceAlgorithm algorithm,
+                 const std::vector<std::string> &host_names);
+
+  // The point to point transport between the ranks by the collective node. The data is copied when the sending is
+  // issued, and the receiving blocks until the next message from the rank arrives.
+  virtual uint64_t SendAsync(uint32_t rank, const void *data, size_t size) const;
+  virtual bool WaitSend(uint64_t request_id) const;
+  virtual bool Receive(uint32_t rank, std::shared_ptr<std::vector<unsigned char>> *data) const;
+
  private:
   size_t rank_id_{0};
   size_t rank_size_{0};
   std::string node_role_{distributed::kEnvRoleOfWorker};
   std::shared_ptr<ps::core::CollectiveNode> abs_node_{nullptr};
 
-  bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  AllReduceAlgorithm algorithm_{AllReduceAlgorithm::kAuto};
+  // All the ranks, the ranks on the host of this rank, and the ranks with the same local index as this rank on all the
+  // hosts. The hierarchical algorithm is available only if every host runs the same number of ranks.
+  std::vector<uint32_t> world_ranks_;
+  std::vector<uint32_t> local_ranks_;
+  std::vector<uint32_t> cross_ranks_;
+  size_t local_index_{0};
+  size_t cross_index_{0};
+  bool hierarchical_available_{false};
+
+  // Group the ranks by their hosts to build the topology of the hierarchical algorithm.
+  void InitTopology(const std::vector<std::string> &host_names);
+
+  // Choose the flat algorithm for the data reduced among a group of ranks if the algorithm is not set.
+  AllReduceAlgorithm SelectAlgorithm(size_t data_num, size_t group_size) const;
+
+  // AllReduce the data in place among the ranks of the group, 'index' is the index of this rank in 'ranks'.
+  bool GroupAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks, size_t index,
+                      AllReduceAlgorithm algorithm) const;
+  bool RingAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks, size_t index) const;
+  bool RecursiveDoublingAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks,
+                                  size_t index) const;
+  bool RabenseifnerAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ranks, size_t index) const;
+  // Ring ReduceScatter within the host, AllReduce the owned chunk with the ranks on other hosts, then ring AllGather
+  // within the host, so only 1/local_size of the data crosses the hosts.
+  bool HierarchicalAllReduce(float *buff, size_t data_num) const;
   bool ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+
+  // The ring ReduceScatter after which the rank of 'index' owns the reduced chunk of 'index', and the ring AllGather
+  // which starts from the same layout.
+  bool RingReduceScatter(float *buff, const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offsets,
+                         const std::vector<uint32_t> &ranks, size_t index) const;
+  bool RingAllGather(float *buff, const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offsets,
+                     const std::vector<uint32_t> &ranks, size_t index) const;
+
+  // Fold the ranks beyond the largest power of two into their neighbours before recursive doubling or halving, and
+  // send the result back to them afterwards. Returns the new index of this rank, or -1 if it is folded.
+  bool FoldRanks(float *buff, size_t data_num, const std::vector<uint32_t> &ranks, size_t index,
+                 int64_t *new_index) const;
+  bool UnfoldRanks(float *buff, size_t data_num, const std::vector<uint32_t> &ranks, size_t index) const;
+
+  // Send the data to 'send_to' and receive 'recv_size' bytes from 'recv_from' at the same time. Both the data are
+  // split into pipeline segments, and each received segment is passed to 'on_received' with its offset in bytes
+  // before the sending is waited.
+  using SegmentHandler = std::function<bool(size_t offset, const unsigned char *data, size_t size)>;
+  bool SendRecv(uint32_t send_to, const void *send_data, size_t send_size, uint32_t recv_from, size_t recv_size,
+                const SegmentHandler &on_received) const;
 };
 }  // namespace cpu
 }  // namespace device
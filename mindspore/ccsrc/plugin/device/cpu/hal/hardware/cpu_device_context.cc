@@ -71,6 +71,7 @@
 #include "plugin/device/cpu/hal/device/cpu_device_synchronizer.h"
 #include "ops/framework_ops.h"
 #include "kernel/oplib/oplib.h"
+#include "runtime/graph_scheduler/actor/gradient_bucket_actor.h"
 
 namespace mindspore {
 namespace device {
@@ -128,10 +129,23 @@ void CPUDeviceContext::Initialize() {
 
 void CPUDeviceContext::Destroy() {
   MS_EXCEPTION_IF_NULL(device_res_manager_);
+  // The static memory of replayed graphs must be freed before the memory pool is finalized.
+  auto cpu_graph_executor = dynamic_cast<CPUGraphExecutor *>(graph_executor_.get());
+  if (cpu_graph_executor != nullptr) {
+    cpu_graph_executor->Clear();
+  }
   device_res_manager_->Destroy();
   initialized_ = false;
 }
 
+RunMode CPUDeviceContext::GetRunMode(const FuncGraphPtr &func_graph) const {
+  if (IsGraphReplayable(func_graph)) {
+    MS_LOG(INFO) << "The graph " << func_graph->ToString() << " is replayed by the cpu graph executor.";
+    return RunMode::kGraphMode;
+  }
+  return RunMode::kKernelMode;
+}
+
 void CPUDeviceResManager::Initialize() {
   mem_manager_ = std::make_shared<CPUMemoryManager>();
   MS_EXCEPTION_IF_NULL(mem_manager_);
@@ -161,6 +175,16 @@ void CPUDeviceResManager::FreePartMemorys(const std::vector<void *> &free_addrs,
   CPUMemoryPool::GetInstance().FreePartTensorMems(free_addrs, keep_addrs, keep_addr_sizes);
 }
 
+bool CPUDeviceResManager::SyncStream(size_t stream_id) const {
+  CPUMemoryPool::GetInstance().DrainMemBufCache(SizeToUint(stream_id));
+  return true;
+}
+
+bool CPUDeviceResManager::SyncAllStreams() const {
+  CPUMemoryPool::GetInstance().DrainAllMemBufCache();
+  return true;
+}
+
 std::vector<void *> CPUDeviceResManager::AllocateContinuousMemory(const std::vector<size_t> &size_list,
                                                                   uint32_t stream_id) const {
   MS_EXCEPTION_IF_NULL(mem_manager_);
@@ -302,7 +326,10 @@ void CPUKernelExecutor::OptimizeGraphImpl(const KernelGraphPtr &graph) const {
   pm->AddPass(std::make_shared<opt::InsertTypeTransformOp>("insert_type_transform_op"));
   pm->AddPass(std::make_shared<opt::FlattenValueSequenceInPyExecute>("flatten_value_sequence_in_pyexecute"));
   pm->AddPass(std::make_shared<opt::InsertFormatTransformOpCPU>("insert_format_transform_op_cpu"));
-  pm->AddPass(std::make_shared<opt::AllReduceFusion>());
+  // The gradient AllReduce kernels are fused into the buckets at runtime when the gradient bucket is enabled.
+  if (runtime::GetGradientBucketSize() == 0) {
+    pm->AddPass(std::make_shared<opt::AllReduceFusion>());
+  }
   pm->AddPass(std::make_shared<opt::InsertCastCPU>("insert_cast"));
   pm->AddPass(std::make_shared<opt::EraseVisitAttr>());
   pm->AddPass(std::make_shared<opt::InsertTensorMoveForCommunication>());
@@ -580,6 +607,7 @@ bool CPUKernelExecutor::DoLaunchKernel(const CNodePtr &kernel, const std::vector
   MS_EXCEPTION_IF_NULL(kernel_mod);
   uint64_t start_time = 0;
   PROFILER_START(start_time);
+  kernel::ParallelLaunchNumaGuard numa_guard(inputs);
   auto ret = kernel_mod->Launch(inputs, workspace, outputs, nullptr);
   PROFILER_END(start_time, runtime::ProfilerModule::kKernel, runtime::ProfilerEvent::kKernelLaunch,
                kernel->fullname_with_scope(), false);
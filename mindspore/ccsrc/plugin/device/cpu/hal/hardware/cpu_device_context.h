@@ -23,6 +23,7 @@
 #include "runtime/hardware/device_context.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "runtime/device/memory_manager.h"
+#include "plugin/device/cpu/hal/hardware/cpu_graph_executor.h"
 
 namespace mindspore {
 namespace device {
@@ -48,6 +49,10 @@ class CPUDeviceResManager : public DeviceResManager {
   void FreeMemory(void *ptr) const override;
   void FreePartMemorys(const std::vector<void *> &free_addrs, const std::vector<void *> &keep_addrs,
                        const std::vector<size_t> &keep_addr_sizes) const override;
+
+  // The cached memory of memory pool is returned to the best-fit index when the stream is synchronized.
+  bool SyncStream(size_t stream_id) const override;
+  bool SyncAllStreams() const override;
 };
 
 class CPUKernelExecutor : public KernelExecutor {
@@ -96,7 +101,7 @@ class CPUKernelExecutor : public KernelExecutor {
   mutable std::mutex launch_mutex_;
 };
 
-class CPUDeviceContext : public DeviceInterface<CPUKernelExecutor, CPUDeviceResManager> {
+class CPUDeviceContext : public DeviceInterface<CPUKernelExecutor, CPUDeviceResManager, CPUGraphExecutor> {
  public:
   explicit CPUDeviceContext(const DeviceContextKey &device_context_key) : DeviceInterface(device_context_key) {}
   ~CPUDeviceContext() override = default;
@@ -105,7 +110,8 @@ class CPUDeviceContext : public DeviceInterface<CPUKernelExecutor, CPUDeviceResM
 
   void Destroy() override;
 
-  RunMode GetRunMode(const FuncGraphPtr &func_graph) const override { return RunMode::kKernelMode; }
+  // The static shape graph is launched in the graph mode by the CPUGraphExecutor if the env MS_CPU_GRAPH_REPLAY is set.
+  RunMode GetRunMode(const FuncGraphPtr &func_graph) const override;
 
  private:
   DISABLE_COPY_AND_ASSIGN(CPUDeviceContext);
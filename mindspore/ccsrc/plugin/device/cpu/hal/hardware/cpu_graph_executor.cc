@@ -0,0 +1,332 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/cpu_graph_executor.h"
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include "include/backend/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "include/common/profiler.h"
+#include "ops/framework_ops.h"
+#include "ops/structure_ops.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The kernels which communicate with other processes or devices, or whose launch order is decided at runtime.
+bool IsReplayUnsupportedKernel(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>()) {
+    return false;
+  }
+  if (common::AnfAlgo::IsCallNode(node) || common::AnfAlgo::IsCommunicationOp(node) ||
+      common::AnfAlgo::CheckPrimitiveType(node, prim::kPrimConditionSwitch) ||
+      common::AnfAlgo::CheckPrimitiveType(node, prim::kPrimConditionGather)) {
+    return true;
+  }
+  static const std::set<std::string> unsupported_kernels = {kRpcSendOpName, kRpcRecvOpName, kGetNextOpName,
+                                                            kPyExecuteOpName};
+  return unsupported_kernels.count(common::AnfAlgo::GetCNodeName(node)) > 0;
+}
+
+int64_t GetDependLevel(const AnfNodePtr &node, mindspore::HashMap<AnfNode *, int64_t> *node_levels) {
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(node_levels);
+  const auto &iter = node_levels->find(node.get());
+  if (iter != node_levels->end()) {
+    return iter->second;
+  }
+  // The parameters and value nodes don't depend on any kernel.
+  int64_t level = -1;
+  if (node->isa<CNode>()) {
+    // The nodes which are not launched, such as Depend, UpdateState and TupleGetItem, pass the dependencies through.
+    const auto &cnode = node->cast<CNodePtr>();
+    for (size_t i = 1; i < cnode->size(); ++i) {
+      level = std::max(level, GetDependLevel(cnode->input(i), node_levels));
+    }
+  }
+  (*node_levels)[node.get()] = level;
+  return level;
+}
+}  // namespace
+
+bool IsGraphReplayable(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  const auto &replay_mode = common::GetEnv(kEnvCpuGraphReplay);
+  if (replay_mode != kCpuGraphReplaySerial && replay_mode != kCpuGraphReplayParallel) {
+    return false;
+  }
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->get_param<int>(MS_CTX_EXECUTION_MODE) != kGraphMode || !func_graph->isa<session::KernelGraph>()) {
+    return false;
+  }
+
+  auto nodes = TopoSort(func_graph->get_return(), SuccDeeperSimple);
+  return std::none_of(nodes.begin(), nodes.end(), [](const AnfNodePtr &node) {
+    if (node == nullptr) {
+      return false;
+    }
+    return IsReplayUnsupportedKernel(node) || common::AnfAlgo::IsDynamicShape(node) ||
+           common::AnfAlgo::IsDynamicSequence(node) || common::AnfAlgo::IsNodeMutableScalar(node);
+  });
+}
+
+bool CPUGraphExecutor::RunGraph(const FuncGraphPtr &graph, const std::vector<tensor::Tensor> &,
+                                std::vector<tensor::Tensor> *, const std::map<string, string> &) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto kernel_graph = graph->cast<KernelGraphPtr>();
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  ReplaySchedulePtr schedule = nullptr;
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    auto &cached_schedule = schedules_[kernel_graph->graph_id()];
+    if (cached_schedule == nullptr) {
+      runtime::ProfilerRecorder profiler(runtime::ProfilerModule::kRuntime, runtime::ProfilerEvent::kPreLaunch,
+                                         "CaptureGraph_" + std::to_string(kernel_graph->graph_id()));
+      cached_schedule = Capture(kernel_graph);
+    }
+    schedule = cached_schedule;
+  }
+  MS_EXCEPTION_IF_NULL(schedule);
+
+  if (!schedule->levels_.empty()) {
+    return LaunchInParallel(schedule);
+  }
+  return std::all_of(schedule->kernels_.begin(), schedule->kernels_.end(),
+                     [this](const ReplayKernel &replay_kernel) { return LaunchKernel(replay_kernel); });
+}
+
+void CPUGraphExecutor::Clear() {
+  MS_EXCEPTION_IF_NULL(device_context_);
+  MS_EXCEPTION_IF_NULL(device_context_->device_res_manager_);
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (auto &schedule_iter : schedules_) {
+    const auto &schedule = schedule_iter.second;
+    if (schedule == nullptr) {
+      continue;
+    }
+    for (auto &address : schedule->captured_addresses_) {
+      address->set_ptr(nullptr);
+    }
+    for (auto &ptr : schedule->static_memory_) {
+      device_context_->device_res_manager_->FreeMemory(ptr);
+    }
+  }
+  schedules_.clear();
+}
+
+ReplaySchedulePtr CPUGraphExecutor::Capture(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto schedule = std::make_shared<ReplaySchedule>();
+  AssignStaticMemory(graph, schedule);
+
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    ReplayKernel replay_kernel;
+    replay_kernel.kernel_ = kernel;
+    replay_kernel.kernel_mod_ = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(replay_kernel.kernel_mod_);
+    for (size_t i = 0; i < common::AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      const auto &address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i, false);
+      MS_EXCEPTION_IF_NULL(address);
+      (void)replay_kernel.inputs_.emplace_back(address->kernel_tensor().get());
+    }
+    for (size_t i = 0; i < replay_kernel.kernel_mod_->GetWorkspaceSizeList().size(); ++i) {
+      const auto &address = AnfAlgo::GetMutableWorkspaceAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      (void)replay_kernel.workspaces_.emplace_back(address->kernel_tensor().get());
+    }
+    for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel); ++i) {
+      const auto &address = AnfAlgo::GetMutableOutputAddr(kernel, i, false);
+      MS_EXCEPTION_IF_NULL(address);
+      (void)replay_kernel.outputs_.emplace_back(address->kernel_tensor().get());
+    }
+    (void)schedule->kernels_.emplace_back(std::move(replay_kernel));
+  }
+
+  // The memory of somas is reused by the kernels which are serial in the execution order, so the parallel launch is
+  // only enabled for the graphs whose internal tensors have their own memory.
+  if (common::GetEnv(kEnvCpuGraphReplay) == kCpuGraphReplayParallel) {
+    if (graph->somas_whole_block_size() == 0) {
+      BuildLevels(graph, schedule);
+    } else {
+      MS_LOG(WARNING) << "The graph " << graph->graph_id() << " uses the somas and can't be replayed in parallel, "
+                      << "set the memory optimize level to O0 to enable the parallel replay.";
+    }
+  }
+  MS_LOG(INFO) << "Capture the launch schedule of graph " << graph->graph_id()
+               << ", kernel num: " << schedule->kernels_.size() << ", level num: " << schedule->levels_.size()
+               << ", static memory num: " << schedule->static_memory_.size();
+  return schedule;
+}
+
+void CPUGraphExecutor::AssignStaticMemory(const KernelGraphPtr &graph, const ReplaySchedulePtr &schedule) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(schedule);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  const auto &res_manager = device_context_->device_res_manager_;
+  MS_EXCEPTION_IF_NULL(res_manager);
+  auto allocate = [&schedule, &res_manager, &graph](size_t size) {
+    auto ptr = res_manager->AllocateMemory(size);
+    if (ptr == nullptr) {
+      MS_LOG(EXCEPTION) << "Allocate the static memory for replaying graph " << graph->graph_id()
+                        << " failed, size: " << size;
+    }
+    (void)schedule->static_memory_.emplace_back(ptr);
+    return ptr;
+  };
+
+  // The memory of graph outputs is allocated by the super kernel actor in every step.
+  std::set<DeviceAddress *> skipped_addresses;
+  for (const auto &output_with_index : common::AnfAlgo::GetAllOutputWithIndex(graph->output())) {
+    const auto &real_output = common::AnfAlgo::FetchRealNodeSkipMonadControl(output_with_index);
+    MS_EXCEPTION_IF_NULL(real_output.first);
+    if (real_output.first->isa<CNode>() && AnfAlgo::OutputAddrExist(real_output.first, real_output.second, false)) {
+      (void)skipped_addresses.insert(AnfAlgo::GetMutableOutputAddr(real_output, false).get());
+    }
+  }
+
+  // The somas offsets are fixed after compiling, so the whole block is allocated only once.
+  uint8_t *somas_base = nullptr;
+  if (graph->somas_whole_block_size() != 0) {
+    somas_base = static_cast<uint8_t *>(allocate(graph->somas_whole_block_size()));
+  }
+  auto assign = [&](const DeviceAddressPtr &address, const std::vector<std::pair<size_t, size_t>> &somas_result,
+                    size_t index) {
+    MS_EXCEPTION_IF_NULL(address);
+    // Skip the ref addresses which are shared with the parameters and the addresses which have been assigned.
+    if (address->GetPtr() != nullptr || !skipped_addresses.insert(address.get()).second) {
+      return;
+    }
+    void *ptr = nullptr;
+    if (index < somas_result.size() && somas_result[index].second != 0) {
+      MS_EXCEPTION_IF_NULL(somas_base);
+      ptr = somas_base + somas_result[index].first;
+    } else if (address->GetSize() != 0) {
+      ptr = allocate(address->GetSize());
+    } else {
+      return;
+    }
+    address->set_ptr(ptr);
+    (void)schedule->captured_addresses_.emplace_back(address.get());
+  };
+
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    auto kernel_info = dynamic_cast<device::KernelInfo *>(kernel->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    const auto &somas_outputs = kernel_info->somas_output_result();
+    for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel); ++i) {
+      assign(AnfAlgo::GetMutableOutputAddr(kernel, i, false), somas_outputs, i);
+    }
+    const auto &somas_workspaces = kernel_info->somas_workspace_result();
+    for (size_t i = 0; i < kernel_info->workspace_address_list().size(); ++i) {
+      assign(AnfAlgo::GetMutableWorkspaceAddr(kernel, i), somas_workspaces, i);
+    }
+  }
+}
+
+void CPUGraphExecutor::BuildLevels(const KernelGraphPtr &graph, const ReplaySchedulePtr &schedule) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(schedule);
+  mindspore::HashMap<AnfNode *, int64_t> node_levels;
+  int64_t max_level = -1;
+  // The kernels after the in-place kernel can't run before it, even if they read the ref parameter without the data
+  // dependency on it.
+  int64_t barrier_level = 0;
+  for (size_t index = 0; index < schedule->kernels_.size(); ++index) {
+    const auto &kernel = schedule->kernels_[index].kernel_;
+    bool is_inplace = false;
+    for (size_t i = 0; i < schedule->kernels_[index].outputs_.size(); ++i) {
+      is_inplace = is_inplace || graph->IsInRefOutputMap({kernel, i});
+    }
+
+    int64_t level = barrier_level;
+    if (is_inplace) {
+      level = std::max(level, max_level + 1);
+      barrier_level = level + 1;
+    } else {
+      for (size_t i = 1; i < kernel->size(); ++i) {
+        level = std::max(level, GetDependLevel(kernel->input(i), &node_levels) + 1);
+      }
+    }
+    node_levels[kernel.get()] = level;
+    max_level = std::max(max_level, level);
+    if (schedule->levels_.size() <= LongToSize(level)) {
+      schedule->levels_.resize(LongToSize(level) + 1);
+    }
+    (void)schedule->levels_[LongToSize(level)].emplace_back(index);
+  }
+
+  // The parallel launch is useless for the graph without independent kernels.
+  if (schedule->levels_.size() == schedule->kernels_.size()) {
+    schedule->levels_.clear();
+  }
+}
+
+bool CPUGraphExecutor::LaunchKernel(const ReplayKernel &replay_kernel) const {
+  MS_EXCEPTION_IF_NULL(device_context_);
+  const auto &kernel_executor = device_context_->GetKernelExecutor(false);
+  MS_EXCEPTION_IF_NULL(kernel_executor);
+  if (!kernel_executor->LaunchKernel(replay_kernel.kernel_, replay_kernel.inputs_, replay_kernel.workspaces_,
+                                     replay_kernel.outputs_, replay_kernel.kernel_mod_, nullptr)) {
+    MS_LOG(ERROR) << "Launch kernel failed: " << replay_kernel.kernel_->fullname_with_scope();
+    return false;
+  }
+  return true;
+}
+
+bool CPUGraphExecutor::LaunchInParallel(const ReplaySchedulePtr &schedule) const {
+  MS_EXCEPTION_IF_NULL(schedule);
+  std::atomic<bool> success{true};
+  std::vector<common::Task> tasks;
+  for (const auto &level : schedule->levels_) {
+    if (level.size() == 1) {
+      if (!LaunchKernel(schedule->kernels_[level[0]])) {
+        return false;
+      }
+      continue;
+    }
+    tasks.clear();
+    for (auto index : level) {
+      (void)tasks.emplace_back([this, &schedule, &success, index]() {
+        try {
+          if (!LaunchKernel(schedule->kernels_[index])) {
+            success = false;
+          }
+        } catch (const std::exception &e) {
+          MS_LOG(ERROR) << "Launch kernel " << schedule->kernels_[index].kernel_->fullname_with_scope()
+                        << " failed and catch exception: " << e.what();
+          success = false;
+        }
+        return common::SUCCESS;
+      });
+    }
+    kernel::ParallelLaunch(tasks);
+    if (!success) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_HARDWARE_CPU_GRAPH_EXECUTOR_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_HARDWARE_CPU_GRAPH_EXECUTOR_H_
+
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <mutex>
+#include "runtime/hardware/device_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The environment variable to replay the static shape graphs on CPU. The graph is launched by the super kernel actor
+// instead of one kernel actor per kernel when it is set, and the launch schedule is captured at the first step and
+// replayed in the later steps:
+//  "1": Launch the kernels one by one in the execution order.
+//  "2": Launch the independent kernels of the same level in parallel, which only works for the graphs not using somas.
+constexpr char kEnvCpuGraphReplay[] = "MS_CPU_GRAPH_REPLAY";
+constexpr char kCpuGraphReplaySerial[] = "1";
+constexpr char kCpuGraphReplayParallel[] = "2";
+
+// Whether the graph can be replayed by the CPU graph executor, the graph must be static shape and have no kernels
+// which communicate with other processes or devices.
+bool IsGraphReplayable(const FuncGraphPtr &func_graph);
+
+// The captured launch information of one kernel, the kernel tensors keep the same during the replay and only the device
+// ptr of graph inputs and outputs is updated by the super kernel actor in every step.
+struct ReplayKernel {
+  CNodePtr kernel_;
+  kernel::KernelMod *kernel_mod_{nullptr};
+  std::vector<kernel::KernelTensor *> inputs_;
+  std::vector<kernel::KernelTensor *> workspaces_;
+  std::vector<kernel::KernelTensor *> outputs_;
+};
+
+// The launch schedule of one graph. The kernels are in the execution order, and grouped into the levels in which the
+// kernels don't depend on each other if the parallel launch is enabled.
+struct ReplaySchedule {
+  std::vector<ReplayKernel> kernels_;
+  std::vector<std::vector<size_t>> levels_;
+  // The memory allocated for the internal outputs and workspaces, which is kept until the executor is cleared.
+  std::vector<void *> static_memory_;
+  // The device addresses whose ptr is set by the capture.
+  std::vector<DeviceAddress *> captured_addresses_;
+};
+using ReplaySchedulePtr = std::shared_ptr<ReplaySchedule>;
+
+class CPUGraphExecutor : public GraphExecutor {
+ public:
+  CPUGraphExecutor() = default;
+  ~CPUGraphExecutor() override = default;
+
+  // Replay the launch schedule of graph, and capture it at the first time.
+  bool RunGraph(const FuncGraphPtr &graph, const std::vector<tensor::Tensor> &inputs,
+                std::vector<tensor::Tensor> *outputs, const std::map<string, string> &compile_options) override;
+
+  // Release the captured schedules and the memory of them, must be called before the memory pool is finalized.
+  void Clear();
+
+ private:
+  // Assign the memory to the internal outputs and workspaces, and cache the kernel tensors of every kernel.
+  ReplaySchedulePtr Capture(const KernelGraphPtr &graph) const;
+  void AssignStaticMemory(const KernelGraphPtr &graph, const ReplaySchedulePtr &schedule) const;
+  // Group the kernels into the levels by the dependencies.
+  void BuildLevels(const KernelGraphPtr &graph, const ReplaySchedulePtr &schedule) const;
+
+  bool LaunchKernel(const ReplayKernel &replay_kernel) const;
+  bool LaunchInParallel(const ReplaySchedulePtr &schedule) const;
+
+  std::mutex mutex_;
+  std::map<uint32_t, ReplaySchedulePtr> schedules_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_HARDWARE_CPU_GRAPH_EXECUTOR_H_
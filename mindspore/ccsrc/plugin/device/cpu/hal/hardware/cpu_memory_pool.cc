@@ -16,6 +16,7 @@
 
 #include "plugin/device/cpu/hal/hardware/cpu_memory_pool.h"
 #include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
 #include "include/common/utils/utils.h"
 
 namespace mindspore {
@@ -47,6 +48,11 @@ bool CPUMemoryPool::FreeDeviceMem(const DeviceMemPtr &addr) {
 }
 
 size_t CPUMemoryPool::free_mem_size() { return mindspore::GetSystemMemorySize(kMemAvailable); }
+
+const bool CPUMemoryPool::IsEnableMemBufCache() const {
+  static const bool enable_mem_buf_cache = common::GetEnv("MS_DEV_DISABLE_MEM_BUF_CACHE") != "1";
+  return enable_mem_buf_cache;
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
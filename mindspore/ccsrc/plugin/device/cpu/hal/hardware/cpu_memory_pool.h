@@ -37,6 +37,11 @@ class BACKEND_EXPORT CPUMemoryPool : public DynamicMemPoolBestFit {
   bool FreeDeviceMem(const DeviceMemPtr &addr) override;
   size_t free_mem_size() override;
 
+ protected:
+  // The small allocs from kernel actors and pynative launch threads are served by the mem buf cache, which can be
+  // disabled by setting the env MS_DEV_DISABLE_MEM_BUF_CACHE=1.
+  const bool IsEnableMemBufCache() const override;
+
  private:
   CPUMemoryPool() = default;
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
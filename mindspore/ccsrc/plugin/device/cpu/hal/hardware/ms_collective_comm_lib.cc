@@ -15,6 +15,7 @@
  */
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
+#include "ir/dtype.h"
 
 #include "utils/ms_context.h"
 #include "include/backend/distributed/constants.h"
@@ -228,6 +229,32 @@ bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size
   return ret;
 }
 
+bool MsCollectiveCommLib::ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
+                                        CollectiveOpReduceType reduce_op, const std::string &, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(launcher_);
+  if (data_type != TypeId::kNumberTypeFloat32) {
+    MS_LOG(EXCEPTION) << "ReduceScatter only support float32.";
+  }
+  if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
+    MS_LOG(EXCEPTION) << "ReduceScatter only support reduce sum.";
+  }
+  return launcher_->ReduceScatter(send_buff, recv_buff, recv_count * sizeof(float));
+}
+
+bool MsCollectiveCommLib::AllToAll(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
+                                   const std::string &, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(launcher_);
+  size_t type_size = GetTypeByte(TypeIdToType(data_type));
+  if (type_size == 0) {
+    MS_LOG(EXCEPTION) << "AllToAll does not support the data type " << TypeIdLabel(data_type);
+  }
+  return launcher_->AllToAll(send_buff, recv_buff, send_count * type_size);
+}
+
 bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
                                     const std::string &, void *) {
   CHECK_IF_NULL(send_buff);
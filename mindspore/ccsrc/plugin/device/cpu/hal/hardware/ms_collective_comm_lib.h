@@ -72,9 +72,11 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
-                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
+
+  // Send the i-th block of 'send_count' elements to the rank i, and receive the i-th block from the rank i.
+  bool AllToAll(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
+                const std::string &group_name, void *stream = nullptr);
 
  private:
   MsCollectiveCommLib();
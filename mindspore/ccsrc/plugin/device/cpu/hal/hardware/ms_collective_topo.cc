@@ -172,6 +172,8 @@ MessageBase *const TopologyNode::HandleMessage(MessageBase *const message) {
   if (received_messages_.find(rank_id) == received_messages_.end()) {
     queue = new std::queue<MessageBase *>();
     received_messages_[rank_id] = queue;
+  } else {
+    queue = received_messages_[rank_id];
   }
   MS_EXCEPTION_IF_NULL(queue);
   queue->push(message);
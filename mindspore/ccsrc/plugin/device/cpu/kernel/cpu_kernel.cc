@@ -198,6 +198,54 @@ ActorThreadPool *GetActorMgrInnerThreadPool() {
   return thread_pool;
 }
 
+namespace {
+// The chunks which each thread gets when the thread pool steals task splits.
+constexpr size_t kWorkStealingChunksPerThread = 4;
+
+// The numa node which owns the inputs of the kernel launched in the current thread, -1 if unknown.
+thread_local int launch_numa_node = -1;
+
+// The number of the task splits which the range of count is split into. Without work stealing, each thread gets a
+// single split. With work stealing, each thread gets a few smaller chunks, so that the idle threads can steal the
+// chunks queued behind a slow one. The chunks are kept no smaller than the block size.
+size_t GetRangeSplitNum(const ThreadPool *thread_pool, size_t count, float block_size, size_t thread_num) {
+  if (!thread_pool->work_stealing()) {
+    return thread_num;
+  }
+  size_t block_num = block_size < 1 ? count : static_cast<size_t>(std::ceil(count / block_size));
+  return std::max(thread_num, std::min({thread_num * kWorkStealingChunksPerThread, block_num, count}));
+}
+
+void LaunchOnNumaNode(ThreadPool *thread_pool, const Func &func, Content content, size_t task_num) {
+  if (launch_numa_node >= 0) {
+    (void)thread_pool->ParallelLaunchOnNumaNode(func, content, SizeToInt(task_num), launch_numa_node);
+    return;
+  }
+  (void)thread_pool->ParallelLaunch(func, content, task_num);
+}
+}  // namespace
+
+ParallelLaunchNumaGuard::ParallelLaunchNumaGuard(const std::vector<KernelTensor *> &inputs)
+    : prev_numa_node_(launch_numa_node) {
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  auto thread_pool = actor_manager == nullptr ? nullptr : actor_manager->GetActorThreadPool();
+  if (thread_pool == nullptr || thread_pool->numa_node_num() <= 1) {
+    return;
+  }
+  const KernelTensor *largest_input = nullptr;
+  for (const auto &input : inputs) {
+    if (input != nullptr && input->device_ptr() != nullptr &&
+        (largest_input == nullptr || input->size() > largest_input->size())) {
+      largest_input = input;
+    }
+  }
+  if (largest_input != nullptr) {
+    launch_numa_node = ThreadPool::GetNumaNodeOfAddress(largest_input->device_ptr());
+  }
+}
+
+ParallelLaunchNumaGuard::~ParallelLaunchNumaGuard() { launch_numa_node = prev_numa_node_; }
+
 // Use threadpool of mindrt
 void ParallelLaunch(const CTask &task, size_t count, float block_size, Content content, ThreadPool *pool) {
   if (count == 0) {
@@ -210,7 +258,8 @@ void ParallelLaunch(const CTask &task, size_t count, float block_size, Content c
   }
 
   size_t thread_num = count < block_size * kernel_thread_num ? std::ceil(count / block_size) : kernel_thread_num;
-  size_t once_compute_size = (count + thread_num - 1) / thread_num;
+  size_t split_num = GetRangeSplitNum(thread_pool, count, block_size, thread_num);
+  size_t once_compute_size = (count + split_num - 1) / split_num;
   size_t task_num = count / once_compute_size;
   if (count % once_compute_size != 0) {
     task_num += 1;
@@ -221,7 +270,7 @@ void ParallelLaunch(const CTask &task, size_t count, float block_size, Content c
     task(start, end);
     return common::SUCCESS;
   };
-  (void)thread_pool->ParallelLaunch(func, content, task_num);
+  LaunchOnNumaNode(thread_pool, func, content, task_num);
 }
 
 void ParallelLaunch(const std::vector<common::Task> &tasks, Content content, ThreadPool *pool) {
@@ -236,7 +285,8 @@ void ParallelLaunch(const std::vector<common::Task> &tasks, Content content, Thr
   }
 
   size_t thread_num = count < kernel_thread_num ? count : kernel_thread_num;
-  size_t once_compute_size = (count + thread_num - 1) / thread_num;
+  size_t split_num = GetRangeSplitNum(thread_pool, count, 1, thread_num);
+  size_t once_compute_size = (count + split_num - 1) / split_num;
   size_t task_num = count / once_compute_size;
   if (count % once_compute_size != 0) {
     task_num += 1;
@@ -249,7 +299,7 @@ void ParallelLaunch(const std::vector<common::Task> &tasks, Content content, Thr
     }
     return common::SUCCESS;
   };
-  (void)thread_pool->ParallelLaunch(func, content, task_num);
+  LaunchOnNumaNode(thread_pool, func, content, task_num);
 }
 
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
@@ -318,6 +318,18 @@ class TransposeIterator {
 };
 
 ActorThreadPool *GetActorMgrInnerThreadPool();
+
+// Route the task splits of ParallelLaunch in the current thread to the workers of the numa node which owns the largest
+// input of the kernel while the guard is alive, if the actor thread pool is partitioned to multiple numa nodes.
+class BACKEND_EXPORT ParallelLaunchNumaGuard {
+ public:
+  explicit ParallelLaunchNumaGuard(const std::vector<KernelTensor *> &inputs);
+  ~ParallelLaunchNumaGuard();
+
+ private:
+  int prev_numa_node_;
+};
+
 void ParallelLaunch(const CTask &task, size_t count, float block_size = 128.0, Content content = nullptr,
                     ThreadPool *pool = nullptr);
 void ParallelLaunch(const std::vector<common::Task> &tasks, Content content = nullptr, ThreadPool *pool = nullptr);
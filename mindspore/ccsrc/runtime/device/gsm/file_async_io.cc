@@ -0,0 +1,210 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/gsm/file_async_io.h"
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+#ifndef _MSC_VER
+namespace {
+constexpr size_t kMaxIOThreadNum = 8;
+constexpr mode_t kSwapFileMode = 0600;
+
+double ElapsedMicroseconds(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Read or write the whole block, the pread and pwrite may transfer less bytes than requested.
+bool TransferBlock(int fd, bool read, uint8_t *data, size_t size, size_t offset) {
+  while (size > 0) {
+    auto ret = read ? pread(fd, data, size, static_cast<off_t>(offset))
+                    : pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      return false;
+    }
+    data += ret;
+    size -= static_cast<size_t>(ret);
+    offset += static_cast<size_t>(ret);
+  }
+  return true;
+}
+}  // namespace
+
+FileAsyncIO::~FileAsyncIO() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  block_cond_.notify_all();
+  for (auto &io_thread : io_threads_) {
+    if (io_thread.joinable()) {
+      io_thread.join();
+    }
+  }
+}
+
+bool FileAsyncIO::Init(const AsyncIOConf &conf) {
+  if (conf.block_size == 0 || conf.queue_depth == 0) {
+    MS_LOG(WARNING) << "Invalid block size " << conf.block_size << " or queue depth " << conf.queue_depth;
+    return false;
+  }
+  if (!io_threads_.empty()) {
+    return true;
+  }
+  block_size_ = conf.block_size;
+  size_t thread_num = std::min({conf.queue_depth, kMaxIOThreadNum,
+                                std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1))});
+  for (size_t i = 0; i < thread_num; ++i) {
+    (void)io_threads_.emplace_back(&FileAsyncIO::Run, this);
+  }
+  MS_LOG(INFO) << "Init the io threads, thread num: " << thread_num << ", block size: " << block_size_;
+  return true;
+}
+
+bool FileAsyncIO::Submit(bool read, const std::string &file_name, void *data, size_t byte_num, AsyncIOToken *token) {
+  MS_EXCEPTION_IF_NULL(token);
+  if (io_threads_.empty()) {
+    MS_LOG(WARNING) << "The io threads are not initialized.";
+    return false;
+  }
+  if (data == nullptr && byte_num != 0) {
+    MS_LOG(WARNING) << "The data to " << (read ? "read from " : "write to ") << file_name << " is null.";
+    return false;
+  }
+  auto request = std::make_shared<Request>();
+  // The swap file is reused by the tensors of different sizes, so the stale tail of the last write is truncated.
+  request->fd_ =
+    read ? open(file_name.c_str(), O_RDONLY) : open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, kSwapFileMode);
+  if (request->fd_ < 0) {
+    MS_LOG(WARNING) << "Open file " << file_name << " failed, error: " << strerror(errno);
+    return false;
+  }
+  request->pending_block_num_ = (byte_num + block_size_ - 1) / block_size_;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  *token = ++next_token_;
+  if (request->pending_block_num_ == 0) {
+    (void)close(request->fd_);
+    requests_[*token] = request;
+    return true;
+  }
+  if (in_flight_request_num_++ == 0) {
+    busy_start_ = std::chrono::steady_clock::now();
+  }
+  if (read) {
+    statistics_.read_bytes_ += byte_num;
+  } else {
+    statistics_.write_bytes_ += byte_num;
+  }
+  requests_[*token] = request;
+  auto buffer = static_cast<uint8_t *>(data);
+  for (size_t offset = 0; offset < byte_num; offset += block_size_) {
+    blocks_.push_back({request, read, buffer + offset, std::min(block_size_, byte_num - offset), offset});
+  }
+  block_cond_.notify_all();
+  return true;
+}
+
+void FileAsyncIO::FinishBlock(const Block &block, bool success) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &request = block.request_;
+  request->success_ = request->success_ && success;
+  if (--request->pending_block_num_ != 0) {
+    return;
+  }
+  if (close(request->fd_) != 0) {
+    request->success_ = false;
+  }
+  if (--in_flight_request_num_ == 0) {
+    statistics_.busy_time_us_ += ElapsedMicroseconds(busy_start_);
+  }
+  finish_cond_.notify_all();
+}
+
+void FileAsyncIO::Run() {
+  while (true) {
+    Block block;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      block_cond_.wait(lock, [this]() { return stop_ || !blocks_.empty(); });
+      if (stop_ && blocks_.empty()) {
+        return;
+      }
+      block = blocks_.front();
+      blocks_.pop_front();
+    }
+    auto success = TransferBlock(block.request_->fd_, block.read_, block.data_, block.size_, block.offset_);
+    FinishBlock(block, success);
+  }
+}
+
+bool FileAsyncIO::Wait(AsyncIOToken token) {
+  auto start = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto &iter = requests_.find(token);
+  if (iter == requests_.end()) {
+    MS_LOG(WARNING) << "Invalid async io token " << token;
+    return false;
+  }
+  auto request = iter->second;
+  (void)requests_.erase(iter);
+  if (request->pending_block_num_ != 0) {
+    finish_cond_.wait(lock, [&request]() { return request->pending_block_num_ == 0; });
+    statistics_.stall_time_us_ += ElapsedMicroseconds(start);
+  }
+  return request->success_;
+}
+
+bool FileAsyncIO::ReadAsync(const std::string &file_name, void *data, size_t byte_num, AsyncIOToken *token) {
+  return Submit(true, file_name, data, byte_num, token);
+}
+
+bool FileAsyncIO::WriteAsync(const std::string &file_name, const void *data, size_t byte_num, AsyncIOToken *token) {
+  return Submit(false, file_name, const_cast<void *>(data), byte_num, token);
+}
+
+bool FileAsyncIO::Read(const std::string &file_name, void *data, size_t byte_num) {
+  AsyncIOToken token = kInvalidAsyncIOToken;
+  return ReadAsync(file_name, data, byte_num, &token) && Wait(token);
+}
+
+bool FileAsyncIO::Write(const std::string &file_name, const void *data, size_t byte_num) {
+  AsyncIOToken token = kInvalidAsyncIOToken;
+  return WriteAsync(file_name, data, byte_num, &token) && Wait(token);
+}
+
+AsyncIOStatistics FileAsyncIO::GetStatistics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto statistics = statistics_;
+  if (in_flight_request_num_ != 0) {
+    statistics.busy_time_us_ += ElapsedMicroseconds(busy_start_);
+  }
+  return statistics;
+}
+#endif
+}  // namespace device
+}  // namespace mindspore
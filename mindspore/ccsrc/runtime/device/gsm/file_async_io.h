@@ -0,0 +1,86 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_FILE_ASYNC_IO_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_FILE_ASYNC_IO_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "runtime/device/gsm/io_handle.h"
+
+namespace mindspore {
+namespace device {
+// The async io on the plain files by the io threads, which is used when the aio plugin is unavailable. Each request is
+// split into the blocks of block size, and the blocks are read or written by the io threads in parallel, so the local
+// file on the nvme disk can be accessed with the queue depth of the io thread num.
+class BACKEND_EXPORT FileAsyncIO : public AsyncIO {
+ public:
+  FileAsyncIO() = default;
+  ~FileAsyncIO() override;
+  bool Init(const AsyncIOConf &conf) override;
+  bool Read(const std::string &file_name, void *data, size_t byte_num) override;
+  bool Write(const std::string &file_name, const void *data, size_t byte_num) override;
+  bool ReadAsync(const std::string &file_name, void *data, size_t byte_num, AsyncIOToken *token) override;
+  bool WriteAsync(const std::string &file_name, const void *data, size_t byte_num, AsyncIOToken *token) override;
+  bool Wait(AsyncIOToken token) override;
+  AsyncIOStatistics GetStatistics();
+
+ private:
+  struct Request {
+    int fd_{-1};
+    size_t pending_block_num_{0};
+    bool success_{true};
+  };
+  using RequestPtr = std::shared_ptr<Request>;
+
+  struct Block {
+    RequestPtr request_;
+    bool read_{false};
+    uint8_t *data_{nullptr};
+    size_t size_{0};
+    size_t offset_{0};
+  };
+
+  bool Submit(bool read, const std::string &file_name, void *data, size_t byte_num, AsyncIOToken *token);
+  void Run();
+  void FinishBlock(const Block &block, bool success);
+
+  size_t block_size_{0};
+  std::vector<std::thread> io_threads_;
+  std::mutex mutex_;
+  std::condition_variable block_cond_;
+  std::condition_variable finish_cond_;
+  std::deque<Block> blocks_;
+  std::map<AsyncIOToken, RequestPtr> requests_;
+  AsyncIOToken next_token_{kInvalidAsyncIOToken};
+  bool stop_{false};
+
+  // Record the wall time when any request is in flight to compute the achieved bandwidth.
+  size_t in_flight_request_num_{0};
+  std::chrono::steady_clock::time_point busy_start_;
+  AsyncIOStatistics statistics_;
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_FILE_ASYNC_IO_H_
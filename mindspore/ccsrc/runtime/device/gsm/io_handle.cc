@@ -24,12 +24,30 @@
 #include "utils/system/env.h"
 #include "utils/file_utils.h"
 #include "include/common/utils/offload_context.h"
+#include "runtime/device/gsm/file_async_io.h"
 
 namespace mindspore {
 namespace device {
 constexpr size_t kFileHeadOffset = 0;
 constexpr char kReadFileMode[] = "r+";
 constexpr size_t kAlignSize = 0x1ff;
+// The tokens of the io threads are marked by the highest bit to be distinguished from the tokens of aio plugin.
+constexpr AsyncIOToken kFileAsyncIOTokenFlag = static_cast<AsyncIOToken>(1) << (sizeof(AsyncIOToken) * 8 - 1);
+
+IOHandle::IOHandle() {
+#ifndef _MSC_VER
+  const auto &offload_context = OffloadContext::GetInstance();
+  if (offload_context == nullptr) {
+    return;
+  }
+  file_aio_ = std::make_shared<FileAsyncIO>();
+  if (!file_aio_->Init({offload_context->aio_block_size(), offload_context->aio_queue_depth()})) {
+    MS_LOG(WARNING) << "Init the io threads failed, block size: " << offload_context->aio_block_size()
+                    << ", queue depth: " << offload_context->aio_queue_depth();
+    file_aio_ = nullptr;
+  }
+#endif
+}
 
 void IOHandle::LoadAio(const std::string &aio_shared_lib_name, const std::string &instance_func_name) {
 #ifdef _MSC_VER
@@ -71,6 +89,9 @@ bool IOHandle::Read(const std::string &file_name, void *data, size_t byte_num) c
   if (aio_ != nullptr && IsAligned(data, byte_num)) {
     return aio_->Read(file_name, data, byte_num);
   }
+  if (file_aio_ != nullptr) {
+    return file_aio_->Read(file_name, data, byte_num);
+  }
   const auto &fs = system::Env::GetFileSystem();
   MS_EXCEPTION_IF_NULL(fs);
   auto file = fs->CreateWriteFile(file_name, kReadFileMode);
@@ -82,6 +103,9 @@ bool IOHandle::Write(const std::string &file_name, const void *data, size_t byte
   if (aio_ != nullptr && IsAligned(data, byte_num)) {
     return aio_->Write(file_name, data, byte_num);
   }
+  if (file_aio_ != nullptr) {
+    return file_aio_->Write(file_name, data, byte_num);
+  }
   const auto &fs = system::Env::GetFileSystem();
   MS_EXCEPTION_IF_NULL(fs);
   auto file = fs->CreateWriteFile(file_name);
@@ -93,6 +117,14 @@ bool IOHandle::ReadAsync(const std::string &file_name, void *data, size_t byte_n
   if (aio_ != nullptr && IsAligned(data, byte_num)) {
     return aio_->ReadAsync(file_name, data, byte_num, token);
   }
+  MS_EXCEPTION_IF_NULL(token);
+  if (file_aio_ != nullptr) {
+    if (!file_aio_->ReadAsync(file_name, data, byte_num, token)) {
+      return false;
+    }
+    *token |= kFileAsyncIOTokenFlag;
+    return true;
+  }
   const auto &fs = system::Env::GetFileSystem();
   MS_EXCEPTION_IF_NULL(fs);
   auto file = fs->CreateWriteFile(file_name, kReadFileMode);
@@ -105,6 +137,14 @@ bool IOHandle::WriteAsync(const std::string &file_name, const void *data, size_t
   if (aio_ != nullptr && IsAligned(data, byte_num)) {
     return aio_->WriteAsync(file_name, data, byte_num, token);
   }
+  MS_EXCEPTION_IF_NULL(token);
+  if (file_aio_ != nullptr) {
+    if (!file_aio_->WriteAsync(file_name, data, byte_num, token)) {
+      return false;
+    }
+    *token |= kFileAsyncIOTokenFlag;
+    return true;
+  }
   const auto &fs = system::Env::GetFileSystem();
   MS_EXCEPTION_IF_NULL(fs);
   auto file = fs->CreateWriteFile(file_name);
@@ -116,7 +156,17 @@ bool IOHandle::IsAligned(const void *data, const size_t byte_num) const {
   return ((byte_num & kAlignSize) == 0) && ((reinterpret_cast<size_t>(data) & kAlignSize) == 0);
 }
 
-bool IOHandle::Wait(AsyncIOToken token) const { return aio_ == nullptr || aio_->Wait(token); }
+bool IOHandle::Wait(AsyncIOToken token) const {
+  if ((token & kFileAsyncIOTokenFlag) != 0) {
+    MS_EXCEPTION_IF_NULL(file_aio_);
+    return file_aio_->Wait(token & ~kFileAsyncIOTokenFlag);
+  }
+  return aio_ == nullptr || aio_->Wait(token);
+}
+
+AsyncIOStatistics IOHandle::GetStatistics() const {
+  return file_aio_ == nullptr ? AsyncIOStatistics() : file_aio_->GetStatistics();
+}
 
 bool IOHandle::DeleteSwapFile(const std::string &file_name) const {
   const auto &fs = system::Env::GetFileSystem();
@@ -34,6 +34,17 @@ struct AsyncIOConf {
   size_t queue_depth;
 };
 
+struct AsyncIOStatistics {
+  size_t read_bytes_{0};
+  size_t write_bytes_{0};
+  // The wall time in microseconds when any io request is in flight.
+  double busy_time_us_{0};
+  // The time in microseconds blocked in waiting for the io requests.
+  double stall_time_us_{0};
+  // The achieved bandwidth in bytes per microsecond, which is equal to MB/s.
+  double Bandwidth() const { return busy_time_us_ == 0 ? 0 : (read_bytes_ + write_bytes_) / busy_time_us_; }
+};
+
 class AsyncIO {
  public:
   AsyncIO() = default;
@@ -46,9 +57,11 @@ class AsyncIO {
   virtual bool Wait(AsyncIOToken token) = 0;
 };
 
+class FileAsyncIO;
+
 class BACKEND_EXPORT IOHandle {
  public:
-  IOHandle() = default;
+  IOHandle();
   ~IOHandle() = default;
   bool DeleteSwapFile(const std::string &file_name) const;
   bool CreateSwapFile(const std::string &file_name) const;
@@ -58,10 +71,13 @@ class BACKEND_EXPORT IOHandle {
   bool ReadAsync(const std::string &file_name, void *data, size_t byte_num, AsyncIOToken *token) const;
   bool WriteAsync(const std::string &file_name, const void *data, size_t byte_num, AsyncIOToken *token) const;
   bool Wait(AsyncIOToken sync_token) const;
+  // The statistics of the io by the io threads when the aio plugin is unavailable.
+  AsyncIOStatistics GetStatistics() const;
 
  private:
   bool IsAligned(const void *data, size_t byte_num) const;
   AsyncIO *aio_{nullptr};
+  std::shared_ptr<FileAsyncIO> file_aio_{nullptr};
 };
 using IOHandlePtr = std::shared_ptr<IOHandle>;
 }  // namespace device
@@ -0,0 +1,332 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/gsm/mem_budget_planner.h"
+#include <algorithm>
+#include <limits>
+#include "include/common/utils/anfalgo.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// Every kernel costs one microsecond at least for the launch.
+constexpr double kKernelLaunchCost = 1.0;
+constexpr double kInfiniteCost = std::numeric_limits<double>::max();
+// The kernels with random seed generate different outputs in the recompute.
+const char *const kRandomSeedAttrs[] = {"seed", "seed2"};
+}  // namespace
+
+MemBudgetPlanner::MemBudgetPlanner(const std::vector<std::shared_ptr<MemUsageKernelInfo>> &kernel_infos,
+                                   const std::vector<std::shared_ptr<MemUsageTensorInfo>> &tensor_infos,
+                                   const std::shared_ptr<SwapContext> &context)
+    : kernel_infos_(kernel_infos), tensor_infos_(tensor_infos), context_(context), kernel_num_(kernel_infos.size()) {
+  MS_EXCEPTION_IF_NULL(context_);
+  producers_.resize(tensor_infos_.size(), kernel_num_);
+  kernel_costs_.resize(kernel_num_, kKernelLaunchCost);
+  for (size_t kernel_id = 0; kernel_id < kernel_num_; ++kernel_id) {
+    const auto &kernel_info = kernel_infos_[kernel_id];
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    size_t bytes = 0;
+    for (const auto *tensors :
+         {&kernel_info->input_tensors_, &kernel_info->output_tensors_, &kernel_info->workspace_tensors_}) {
+      for (auto tensor_id : *tensors) {
+        if (tensor_id >= tensor_infos_.size()) {
+          MS_LOG(EXCEPTION) << "Invalid tensor id " << tensor_id << " of kernel " << kernel_id;
+        }
+        bytes += tensor_infos_[tensor_id]->tensor_size_;
+      }
+    }
+    for (auto tensor_id : kernel_info->output_tensors_) {
+      producers_[tensor_id] = kernel_id;
+    }
+    if (context_->compute_bandwidth_ != 0) {
+      kernel_costs_[kernel_id] += static_cast<double>(bytes) / context_->compute_bandwidth_;
+    }
+  }
+  host_link_used_.resize(kernel_num_, 0);
+  disk_link_used_.resize(kernel_num_, 0);
+}
+
+void MemBudgetPlanner::SetKernelCosts(const std::vector<double> &kernel_costs) {
+  if (kernel_costs.size() != kernel_num_) {
+    MS_LOG(EXCEPTION) << "The size of kernel costs " << kernel_costs.size() << " is not equal to the kernel num "
+                      << kernel_num_;
+  }
+  kernel_costs_ = kernel_costs;
+}
+
+double MemBudgetPlanner::GetKernelCost(size_t kernel_id) const {
+  if (kernel_id >= kernel_costs_.size()) {
+    MS_LOG(EXCEPTION) << "Invalid kernel id " << kernel_id << ", kernel num is " << kernel_costs_.size();
+  }
+  return kernel_costs_[kernel_id];
+}
+
+bool MemBudgetPlanner::EnoughSpace(const ActivationSpanPtr &span, const std::vector<size_t> &mem_used,
+                                   size_t total_mem_size) const {
+  MS_EXCEPTION_IF_NULL(span);
+  for (size_t index = span->last_index_ + 1; index < span->current_index_; ++index) {
+    if (mem_used[index % kernel_num_] + span->tensor_size_ > total_mem_size) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MemBudgetPlanner::Occupy(const ActivationSpanPtr &span, std::vector<size_t> *mem_used) const {
+  MS_EXCEPTION_IF_NULL(span);
+  MS_EXCEPTION_IF_NULL(mem_used);
+  for (size_t index = span->last_index_ + 1; index < span->current_index_; ++index) {
+    (*mem_used)[index % kernel_num_] += span->tensor_size_;
+  }
+}
+
+double MemBudgetPlanner::TransferTime(const ActivationSpanPtr &span, size_t bandwidth) const {
+  MS_EXCEPTION_IF_NULL(span);
+  if (bandwidth == 0) {
+    return kInfiniteCost;
+  }
+  // The output span is only swapped out, and the others are swapped out and in.
+  const double copy_num = span->output_span_ ? 1.0 : 2.0;
+  return copy_num * span->tensor_size_ / bandwidth;
+}
+
+double MemBudgetPlanner::SwapCost(const ActivationSpanPtr &span, size_t bandwidth,
+                                  const std::vector<double> &link_used) const {
+  auto transfer_time = TransferTime(span, bandwidth);
+  if (transfer_time == kInfiniteCost) {
+    return kInfiniteCost;
+  }
+  double idle_time = 0;
+  for (size_t index = span->last_index_ + 1; index < span->current_index_; ++index) {
+    auto kernel_id = index % kernel_num_;
+    idle_time += std::max(kernel_costs_[kernel_id] - link_used[kernel_id], 0.0);
+  }
+  return std::max(transfer_time - idle_time, 0.0);
+}
+
+void MemBudgetPlanner::OccupyLink(const ActivationSpanPtr &span, double transfer_time,
+                                  std::vector<double> *link_used) const {
+  MS_EXCEPTION_IF_NULL(link_used);
+  for (size_t index = span->last_index_ + 1; index < span->current_index_ && transfer_time > 0; ++index) {
+    auto kernel_id = index % kernel_num_;
+    auto occupied = std::min(std::max(kernel_costs_[kernel_id] - (*link_used)[kernel_id], 0.0), transfer_time);
+    (*link_used)[kernel_id] += occupied;
+    transfer_time -= occupied;
+  }
+}
+
+bool MemBudgetPlanner::IsModifiedBetween(size_t tensor_id, size_t start, size_t end) const {
+  const auto &tensor_info = tensor_infos_[tensor_id];
+  MS_EXCEPTION_IF_NULL(tensor_info);
+  if (tensor_info->is_inplace_tensor_) {
+    return true;
+  }
+  for (auto kernel_id : tensor_info->used_by_kernels_) {
+    if (kernel_id <= start || kernel_id >= end) {
+      continue;
+    }
+    const auto &kernel_info = kernel_infos_[kernel_id];
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    if (kernel_info->update_input_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MemBudgetPlanner::IsRecomputable(const ActivationSpanPtr &span) const {
+  MS_EXCEPTION_IF_NULL(span);
+  if (span->output_span_ || span->current_index_ >= kernel_num_ || span->tensor_id_ >= tensor_infos_.size()) {
+    return false;
+  }
+  const auto &tensor_info = tensor_infos_[span->tensor_id_];
+  MS_EXCEPTION_IF_NULL(tensor_info);
+  if (tensor_info->node_ == nullptr || !tensor_info->node_->isa<CNode>() || tensor_info->is_workspace_ ||
+      tensor_info->is_fused_ || tensor_info->is_graph_output_) {
+    return false;
+  }
+  auto producer = producers_[span->tensor_id_];
+  if (producer >= kernel_num_ || producer > span->last_index_) {
+    return false;
+  }
+  const auto &kernel_info = kernel_infos_[producer];
+  MS_EXCEPTION_IF_NULL(kernel_info);
+  // The kernel with multiple outputs would overwrite the other outputs which may be swapped out in the recompute.
+  if (kernel_info->is_comm_ || kernel_info->update_input_ || kernel_info->output_tensors_.size() != 1) {
+    return false;
+  }
+  const auto &cnode = tensor_info->node_->cast<CNodePtr>();
+  for (const auto attr : kRandomSeedAttrs) {
+    if (common::AnfAlgo::HasNodeAttr(attr, cnode)) {
+      return false;
+    }
+  }
+  if (IsModifiedBetween(span->tensor_id_, producer, span->current_index_)) {
+    return false;
+  }
+  return std::none_of(kernel_info->input_tensors_.begin(), kernel_info->input_tensors_.end(),
+                      [this, producer, &span](size_t input) {
+                        return IsModifiedBetween(input, producer, span->current_index_);
+                      });
+}
+
+bool MemBudgetPlanner::IsAvailable(size_t tensor_id, size_t kernel_id) const {
+  const auto &tensor_info = tensor_infos_[tensor_id];
+  MS_EXCEPTION_IF_NULL(tensor_info);
+  const auto &used_by_kernels = tensor_info->used_by_kernels_;
+  if (std::find(used_by_kernels.begin(), used_by_kernels.end(), kernel_id) != used_by_kernels.end()) {
+    return true;
+  }
+  const auto &iter = kept_spans_.find(tensor_id);
+  if (iter == kept_spans_.end()) {
+    return false;
+  }
+  return std::any_of(iter->second.begin(), iter->second.end(), [this, kernel_id](const auto &gap) {
+    return (gap.first < kernel_id && kernel_id < gap.second) ||
+           (gap.first < kernel_id + kernel_num_ && kernel_id + kernel_num_ < gap.second);
+  });
+}
+
+bool MemBudgetPlanner::CanRecompute(const ActivationSpanPtr &span, const std::vector<size_t> &mem_used) const {
+  if (!IsRecomputable(span)) {
+    return false;
+  }
+  const auto &kernel_info = kernel_infos_[producers_[span->tensor_id_]];
+  size_t workspace_size = 0;
+  for (auto tensor_id : kernel_info->workspace_tensors_) {
+    workspace_size += tensor_infos_[tensor_id]->tensor_size_;
+  }
+  if (mem_used[span->current_index_] + workspace_size > context_->hbm_mem_size_) {
+    return false;
+  }
+  return std::all_of(kernel_info->input_tensors_.begin(), kernel_info->input_tensors_.end(),
+                     [this, &span](size_t input) { return IsAvailable(input, span->current_index_); });
+}
+
+double MemBudgetPlanner::EvictCost(const ActivationSpanPtr &span) const {
+  double cost = kInfiniteCost;
+  if (context_->swap_supported_) {
+    cost = std::min(SwapCost(span, context_->host_bandwidth_, host_link_used_),
+                    SwapCost(span, context_->disk_bandwidth_, disk_link_used_));
+  }
+  if (IsRecomputable(span)) {
+    cost = std::min(cost, kernel_costs_[producers_[span->tensor_id_]]);
+  }
+  return cost;
+}
+
+void MemBudgetPlanner::PlanEvictedSpan(const ActivationSpanPtr &span, std::vector<size_t> *mem_used,
+                                       std::vector<size_t> *host_mem_used) {
+  span->plan_ = ActivationPlanType::kKeep;
+  span->cost_ = kInfiniteCost;
+  if (context_->swap_supported_ && EnoughSpace(span, *host_mem_used, context_->cpu_mem_size_)) {
+    span->plan_ = ActivationPlanType::kSwapToHost;
+    span->cost_ = SwapCost(span, context_->host_bandwidth_, host_link_used_);
+  }
+  if (CanRecompute(span, *mem_used)) {
+    auto recompute_cost = kernel_costs_[producers_[span->tensor_id_]];
+    if (recompute_cost < span->cost_) {
+      span->plan_ = ActivationPlanType::kRecompute;
+      span->cost_ = recompute_cost;
+    }
+  }
+  if (context_->swap_supported_) {
+    auto disk_cost = SwapCost(span, context_->disk_bandwidth_, disk_link_used_);
+    if (disk_cost < span->cost_) {
+      span->plan_ = ActivationPlanType::kSwapToDisk;
+      span->cost_ = disk_cost;
+    }
+  }
+
+  if (span->plan_ == ActivationPlanType::kSwapToHost) {
+    Occupy(span, host_mem_used);
+    OccupyLink(span, TransferTime(span, context_->host_bandwidth_), &host_link_used_);
+  } else if (span->plan_ == ActivationPlanType::kSwapToDisk) {
+    OccupyLink(span, TransferTime(span, context_->disk_bandwidth_), &disk_link_used_);
+  } else if (span->plan_ == ActivationPlanType::kKeep) {
+    // No way to leave the device memory, keep it beyond the budget.
+    span->cost_ = 0;
+    Occupy(span, mem_used);
+    (void)kept_spans_[span->tensor_id_].emplace_back(span->last_index_, span->current_index_);
+  }
+}
+
+void MemBudgetPlanner::Plan(const std::vector<ActivationSpanPtr> &spans, std::vector<size_t> *mem_used,
+                            std::vector<size_t> *host_mem_used) {
+  MS_EXCEPTION_IF_NULL(mem_used);
+  MS_EXCEPTION_IF_NULL(host_mem_used);
+  if (mem_used->size() < kernel_num_ || host_mem_used->size() < kernel_num_) {
+    MS_LOG(EXCEPTION) << "The size of memory used " << mem_used->size() << " or host memory used "
+                      << host_mem_used->size() << " is less than the kernel num " << kernel_num_;
+  }
+  if (kernel_num_ == 0) {
+    return;
+  }
+
+  // Keep the spans which are the most expensive to evict per byte of memory first.
+  std::vector<std::pair<double, ActivationSpanPtr>> sorted_spans;
+  for (const auto &span : spans) {
+    MS_EXCEPTION_IF_NULL(span);
+    auto evict_cost = EvictCost(span);
+    auto priority = (evict_cost == kInfiniteCost || span->weight_ == 0) ? kInfiniteCost : evict_cost / span->weight_;
+    (void)sorted_spans.emplace_back(priority, span);
+  }
+  std::stable_sort(sorted_spans.begin(), sorted_spans.end(), [](const auto &left, const auto &right) {
+    if (left.first != right.first) {
+      return left.first > right.first;
+    }
+    return left.second->weight_ < right.second->weight_;
+  });
+
+  std::vector<ActivationSpanPtr> evicted_spans;
+  for (const auto &item : sorted_spans) {
+    const auto &span = item.second;
+    if (EnoughSpace(span, *mem_used, context_->hbm_mem_size_)) {
+      span->plan_ = ActivationPlanType::kKeep;
+      span->cost_ = 0;
+      Occupy(span, mem_used);
+      (void)kept_spans_[span->tensor_id_].emplace_back(span->last_index_, span->current_index_);
+    } else {
+      (void)evicted_spans.emplace_back(span);
+    }
+  }
+
+  // The recompute needs the inputs of producer kernel, so the evicted spans are planned after all the kept spans.
+  std::map<ActivationPlanType, size_t> plan_nums;
+  size_t over_budget_num = 0;
+  for (const auto &span : evicted_spans) {
+    PlanEvictedSpan(span, mem_used, host_mem_used);
+    ++plan_nums[span->plan_];
+    if (span->plan_ == ActivationPlanType::kKeep) {
+      ++over_budget_num;
+    } else {
+      total_cost_ += span->cost_;
+    }
+  }
+  if (over_budget_num != 0) {
+    MS_LOG(WARNING) << over_budget_num << " spans can't leave the device memory, the memory budget "
+                    << context_->hbm_mem_size_ << " may be exceeded.";
+  }
+  MS_LOG(INFO) << "Memory budget plan, span num: " << spans.size()
+               << ", keep: " << (spans.size() - evicted_spans.size() + over_budget_num)
+               << ", recompute: " << plan_nums[ActivationPlanType::kRecompute]
+               << ", swap to host: " << plan_nums[ActivationPlanType::kSwapToHost]
+               << ", swap to disk: " << plan_nums[ActivationPlanType::kSwapToDisk]
+               << ", estimated stall: " << total_cost_ << "us";
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_MEM_BUDGET_PLANNER_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_MEM_BUDGET_PLANNER_H_
+#include <memory>
+#include <vector>
+#include <map>
+#include <utility>
+#include "runtime/device/gsm/swap_strategy.h"
+#include "include/backend/visible.h"
+namespace mindspore {
+namespace device {
+// The environment variable to plan the activations by the memory budget when the memory offload is enabled.
+constexpr char kEnvEnableMemBudgetPlan[] = "MS_DEV_ENABLE_MEM_BUDGET_PLAN";
+
+enum class ActivationPlanType { kKeep, kRecompute, kSwapToHost, kSwapToDisk };
+
+// The span is the gap between two adjacent uses of a tensor, in which the tensor can leave the device memory.
+struct ActivationSpan {
+  size_t tensor_id_{0};
+  size_t tensor_size_{0};
+  size_t last_index_{0};
+  size_t current_index_{0};
+  size_t weight_{0};
+  bool output_span_{false};
+  ActivationPlanType plan_{ActivationPlanType::kKeep};
+  // The estimated stall in microseconds caused by the plan.
+  double cost_{0};
+};
+using ActivationSpanPtr = std::shared_ptr<ActivationSpan>;
+
+// Plan each span to keep the tensor in device memory, or release and recompute it by its producer kernel, or swap it to
+// host or disk, so that the memory used by each kernel doesn't exceed the budget of hbm_mem_size_ with the least stall.
+// The kernel cost is estimated by the bytes the kernel reads and writes, the swap stalls only when its transfer can't
+// be hidden by the idle link time of the kernels in the gap, and the recompute stalls for the cost of producer kernel.
+class BACKEND_EXPORT MemBudgetPlanner {
+ public:
+  MemBudgetPlanner(const std::vector<std::shared_ptr<MemUsageKernelInfo>> &kernel_infos,
+                   const std::vector<std::shared_ptr<MemUsageTensorInfo>> &tensor_infos,
+                   const std::shared_ptr<SwapContext> &context);
+  ~MemBudgetPlanner() = default;
+
+  // Replace the estimated kernel costs by the measured ones in microseconds.
+  void SetKernelCosts(const std::vector<double> &kernel_costs);
+  double GetKernelCost(size_t kernel_id) const;
+
+  // The mem_used contains the memory used by each kernel without spans, and the kept spans are added to it. The spans
+  // swapped to host are added to the host_mem_used.
+  void Plan(const std::vector<ActivationSpanPtr> &spans, std::vector<size_t> *mem_used,
+            std::vector<size_t> *host_mem_used);
+  double total_cost() const { return total_cost_; }
+
+ private:
+  bool EnoughSpace(const ActivationSpanPtr &span, const std::vector<size_t> &mem_used, size_t total_mem_size) const;
+  void Occupy(const ActivationSpanPtr &span, std::vector<size_t> *mem_used) const;
+  double TransferTime(const ActivationSpanPtr &span, size_t bandwidth) const;
+  double SwapCost(const ActivationSpanPtr &span, size_t bandwidth, const std::vector<double> &link_used) const;
+  void OccupyLink(const ActivationSpanPtr &span, double transfer_time, std::vector<double> *link_used) const;
+  double EvictCost(const ActivationSpanPtr &span) const;
+  bool IsRecomputable(const ActivationSpanPtr &span) const;
+  bool IsModifiedBetween(size_t tensor_id, size_t start, size_t end) const;
+  bool IsAvailable(size_t tensor_id, size_t kernel_id) const;
+  bool CanRecompute(const ActivationSpanPtr &span, const std::vector<size_t> &mem_used) const;
+  void PlanEvictedSpan(const ActivationSpanPtr &span, std::vector<size_t> *mem_used,
+                       std::vector<size_t> *host_mem_used);
+
+  std::vector<std::shared_ptr<MemUsageKernelInfo>> kernel_infos_;
+  std::vector<std::shared_ptr<MemUsageTensorInfo>> tensor_infos_;
+  std::shared_ptr<SwapContext> context_;
+  size_t kernel_num_{0};
+  std::vector<double> kernel_costs_;
+  // The producer kernel of each tensor, which is kernel_num_ for the graph inputs.
+  std::vector<size_t> producers_;
+  // The time in microseconds of each kernel which is taken by the transfers to host and disk.
+  std::vector<double> host_link_used_;
+  std::vector<double> disk_link_used_;
+  // The gaps (last use, next use) in which the tensor is kept in device memory.
+  std::map<size_t, std::vector<std::pair<size_t, size_t>>> kept_spans_;
+  double total_cost_{0};
+};
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_MEM_BUDGET_PLANNER_H_
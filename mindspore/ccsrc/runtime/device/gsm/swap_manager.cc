@@ -157,6 +157,18 @@ SwapManager::SwapManager(size_t stream_id, mindspore::device::DynamicMemPoolBest
   (void)FileUtils::CreateNotExistDirs(offload_context->offload_path(), true);
 }
 
+SwapManager::~SwapManager() {
+  if (io_handle_ == nullptr) {
+    return;
+  }
+  const auto &statistics = io_handle_->GetStatistics();
+  if (statistics.read_bytes_ + statistics.write_bytes_ != 0) {
+    MS_LOG(INFO) << "Swap file io read " << statistics.read_bytes_ << " bytes, write " << statistics.write_bytes_
+                 << " bytes, bandwidth " << statistics.Bandwidth() << " MB/s, stall time " << statistics.stall_time_us_
+                 << " us.";
+  }
+}
+
 template <class Input, class Output>
 bool SwapManager::TryAllocate(std::queue<const DeviceAddress *> queue, const Input &input, uint32_t stream_id,
                               Output (SwapManager::*allocate_func)(const Input &, uint32_t),
@@ -345,6 +357,11 @@ bool SwapManager::WaitAsyncIO(mindspore::device::AsyncIOToken sync_token) {
   return io_handle_->Wait(sync_token);
 }
 
+AsyncIOStatistics SwapManager::GetIOStatistics() const {
+  MS_EXCEPTION_IF_NULL(io_handle_);
+  return io_handle_->GetStatistics();
+}
+
 void SwapManager::AddSwappableTensor(const DeviceAddressPtr &device_address) {
   candidates_.Add(device_address);
   device_address->set_swappable(true);
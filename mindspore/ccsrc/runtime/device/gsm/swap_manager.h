@@ -66,7 +66,7 @@ class SwappableTensorCandidates {
 class BACKEND_EXPORT SwapManager {
  public:
   SwapManager(size_t stream_id, DynamicMemPoolBestFit *device_memory_pool, PinMemPool *pin_mem_pool);
-  ~SwapManager() = default;
+  ~SwapManager();
   // Device memory
   void *AllocDeviceMemory(size_t size, uint32_t stream_id = kDefaultStreamIndex);
   std::vector<void *> AllocDeviceContinuousMem(const std::vector<size_t> &size_list,
@@ -85,6 +85,7 @@ class BACKEND_EXPORT SwapManager {
   bool HostMemoryToFile(const std::string &file_name, const void *data, size_t byte_num, bool async,
                         AsyncIOToken *sync_token);
   bool WaitAsyncIO(AsyncIOToken sync_token);
+  AsyncIOStatistics GetIOStatistics() const;
 
   // Swapping and swappable tensors
   void AddSwappableTensor(const DeviceAddressPtr &device_address);
@@ -54,6 +54,10 @@ enum class SwapActionType {
   kDDR2DISK,
   kDISK2DDR,
   kAllocHBM,
+  // Release the device memory of tensor after its last use before the gap, and run its producer kernel again to
+  // regenerate it before the next use.
+  kFreeHBM,
+  kRecompute,
 };
 
 struct TensorAction {
@@ -120,7 +124,8 @@ struct SwapStrategy {
       {SwapActionType::kHBM2DDR, "HBM2DDR"},   {SwapActionType::kHBM2DISK, "HBM2DISK"},
       {SwapActionType::kDDR2HBM, "DDR2HBM"},   {SwapActionType::kDISK2HBM, "DISK2HBM"},
       {SwapActionType::kDDR2DISK, "DDR2DISK"}, {SwapActionType::kDISK2DDR, "DISK2DDR"},
-      {SwapActionType::kAllocHBM, "AllocHBM"},
+      {SwapActionType::kAllocHBM, "AllocHBM"}, {SwapActionType::kFreeHBM, "FreeHBM"},
+      {SwapActionType::kRecompute, "Recompute"},
     };
     static const size_t kBytesPerGB = 1 << 30;
     for (auto const &swap_mem : swap_mem_sizes) {
@@ -146,6 +151,16 @@ class SwapContext {
   bool offload_param_to_disk_{false};
   bool offload_checkpoint_to_cpu_{false};
   bool offload_checkpoint_to_disk_{false};
+  // Plan each activation to keep, recompute or swap by the cost model under the memory budget of hbm_mem_size_.
+  bool enable_budget_plan_{false};
+  // The device memory can't be moved to host or disk, so the budget plan only recomputes. The scheduler only builds the
+  // plan for the devices which support swap for now.
+  bool swap_supported_{true};
+  // The bandwidths in bytes per microsecond of the cost model, the compute bandwidth is the bytes a kernel reads and
+  // writes per microsecond.
+  size_t host_bandwidth_{10000};
+  size_t disk_bandwidth_{1000};
+  size_t compute_bandwidth_{20000};
 };
 }  // namespace device
 }  // namespace mindspore
@@ -80,6 +80,8 @@ size_t GetFirstKernelIndex(const std::shared_ptr<MemUsageTensorInfo> &info,
 }
 }  // namespace
 const size_t kSwapVirtualNodeNum = 2;  // Mark graph start and end node as virtual node
+// The number of kernels ahead of the next use to read the tensor from disk to host.
+const size_t kDiskPrefetchDistance = 2;
 void SwapStrategyBuilder::ResetState(const KernelGraphPtr &graph, const std::shared_ptr<SwapContext> &context) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(context);
@@ -97,6 +99,7 @@ void SwapStrategyBuilder::ResetState(const KernelGraphPtr &graph, const std::sha
 
   span_level1_.clear();
   span_level2_.clear();
+  span_recompute_.clear();
   auto tmp_queue = std::priority_queue<std::shared_ptr<Span>, std::vector<std::shared_ptr<Span>>, SpanCmp>();
   span_queue_.swap(tmp_queue);
 
@@ -237,12 +240,36 @@ void SwapStrategyBuilder::ClassifyOffloadSpanLevel(const std::vector<std::shared
   }
 }
 
+void SwapStrategyBuilder::ClassifySpanByBudget() {
+  MS_EXCEPTION_IF_NULL(analyzer_);
+  std::vector<std::shared_ptr<Span>> spans;
+  while (!span_queue_.empty()) {
+    (void)spans.emplace_back(span_queue_.top());
+    span_queue_.pop();
+  }
+  MemBudgetPlanner planner(analyzer_->GetMemUsageKernelInfos(), analyzer_->GetMemUsageTensorInfos(), context_);
+  planner.Plan(spans, &mem_used_level0_, &mem_used_level1_);
+  for (const auto &span : spans) {
+    if (span->plan_ == ActivationPlanType::kSwapToHost) {
+      (void)span_level1_.emplace_back(span);
+    } else if (span->plan_ == ActivationPlanType::kSwapToDisk) {
+      (void)span_level2_.emplace_back(span);
+    } else if (span->plan_ == ActivationPlanType::kRecompute) {
+      (void)span_recompute_.emplace_back(span);
+    }
+  }
+}
+
 void SwapStrategyBuilder::ClassifySpanLevel() {
   MS_EXCEPTION_IF_NULL(context_);
   ClassifyOffloadSpanLevel(offload_param_spans_, context_->offload_param_to_cpu_);
   offload_param_spans_.clear();
   ClassifyOffloadSpanLevel(offload_checkpoint_spans_, context_->offload_checkpoint_to_cpu_);
   offload_checkpoint_spans_.clear();
+  if (context_->enable_budget_plan_) {
+    ClassifySpanByBudget();
+    return;
+  }
 
   while (!span_queue_.empty()) {
     auto span = span_queue_.top();
@@ -422,6 +449,23 @@ void SwapStrategyBuilder::HandleFusedTensor() {
   }
 }
 
+void SwapStrategyBuilder::AddDiskPrefetchAction(const std::shared_ptr<Span> &span) {
+  MS_EXCEPTION_IF_NULL(span);
+  // The prefetch must be after the swap out at last_index_ + 1.
+  if (span->current_index_ <= span->last_index_ + kDiskPrefetchDistance + 1) {
+    return;
+  }
+  // The tensor stays in host from the prefetch to the next use, so the read overlaps with the kernels in between.
+  auto prefetch_span = std::make_shared<Span>();
+  prefetch_span->tensor_id_ = span->tensor_id_;
+  prefetch_span->tensor_size_ = span->tensor_size_;
+  prefetch_span->last_index_ = span->current_index_ - kDiskPrefetchDistance - 1;
+  prefetch_span->current_index_ = span->current_index_;
+  if (EnoughSpaceForSpan(prefetch_span, &mem_used_level1_, total_mem_level1_)) {
+    AddTensorAction(SwapActionType::kDISK2DDR, span->tensor_id_, (prefetch_span->last_index_ + 1) % kernel_num_);
+  }
+}
+
 void SwapStrategyBuilder::SpanToTensorAction() {
   for (auto span : span_level1_) {
     MS_EXCEPTION_IF_NULL(span);
@@ -435,9 +479,16 @@ void SwapStrategyBuilder::SpanToTensorAction() {
     MS_EXCEPTION_IF_NULL(span);
     AddTensorAction(SwapActionType::kHBM2DISK, span->tensor_id_, span->last_index_ + 1);
     if (!span->output_span_) {
+      AddDiskPrefetchAction(span);
       AddTensorAction(SwapActionType::kDISK2HBM, span->tensor_id_, span->current_index_ % kernel_num_);
     }
   }
+
+  for (auto span : span_recompute_) {
+    MS_EXCEPTION_IF_NULL(span);
+    AddTensorAction(SwapActionType::kFreeHBM, span->tensor_id_, span->last_index_ + 1);
+    AddTensorAction(SwapActionType::kRecompute, span->tensor_id_, span->current_index_);
+  }
 }
 
 std::shared_ptr<SwapStrategy> SwapStrategyBuilder::BuildStrategy(const KernelGraphPtr &graph) {
@@ -22,6 +22,7 @@
 #include <utility>
 #include "runtime/device/gsm/swap_strategy.h"
 #include "runtime/device/gsm/mem_usage_analyzer.h"
+#include "runtime/device/gsm/mem_budget_planner.h"
 #include "include/backend/visible.h"
 namespace mindspore {
 namespace device {
@@ -32,14 +33,7 @@ class BACKEND_EXPORT SwapStrategyBuilder {
   std::shared_ptr<SwapStrategy> Build(const KernelGraphPtr &graph, const std::shared_ptr<SwapContext> &context);
 
  protected:
-  struct Span {
-    size_t tensor_id_{0};
-    size_t tensor_size_{0};
-    size_t last_index_{0};
-    size_t current_index_{0};
-    size_t weight_{0};
-    bool output_span_{false};
-  };
+  using Span = ActivationSpan;
 
   struct SpanCmp {
     bool operator()(const std::shared_ptr<Span> &left, const std::shared_ptr<Span> &right) const {
@@ -53,6 +47,7 @@ class BACKEND_EXPORT SwapStrategyBuilder {
   bool EnoughSpaceForSpan(const std::shared_ptr<Span> &span, std::vector<size_t> *mem_used,
                           size_t total_mem_size) const;
   void SpanToTensorAction();
+  void AddDiskPrefetchAction(const std::shared_ptr<Span> &span);
 
  private:
   void ResetState(const KernelGraphPtr &graph, const std::shared_ptr<SwapContext> &context);
@@ -60,6 +55,7 @@ class BACKEND_EXPORT SwapStrategyBuilder {
   void BuildSpans();
   void ClassifyOffloadSpanLevel(const std::vector<std::shared_ptr<Span>> &spans, bool offload_to_ddr);
   void ClassifySpanLevel();
+  void ClassifySpanByBudget();
 
   size_t PreAllocFusedTensor(const std::shared_ptr<MemUsageTensorInfo> &info, size_t kernel_index);
   void AddFusedTensorSpan(const std::shared_ptr<MemUsageTensorInfo> &info, size_t start_index,
@@ -81,6 +77,7 @@ class BACKEND_EXPORT SwapStrategyBuilder {
   std::vector<std::shared_ptr<Span>> offload_checkpoint_spans_;
   std::vector<std::shared_ptr<Span>> span_level1_;
   std::vector<std::shared_ptr<Span>> span_level2_;
+  std::vector<std::shared_ptr<Span>> span_recompute_;
   std::vector<size_t> mem_used_level0_;
   std::vector<size_t> mem_used_level1_;
   size_t total_mem_level0_{0};
@@ -138,6 +138,8 @@ struct ActorSet {
   LoopCountActorPtr loop_count_actor_{nullptr};
   OutputActorPtr output_actor_{nullptr};
   ControlActorSetPtr control_actors_{nullptr};
+  // The gradient buckets which fuse the gradient AllReduce kernel actors at runtime.
+  GradientBucketGroupPtr gradient_bucket_group_{nullptr};
 #ifdef ENABLE_RPC_ACTOR
   RpcActorSetPtr rpc_actors_{nullptr};
 #endif
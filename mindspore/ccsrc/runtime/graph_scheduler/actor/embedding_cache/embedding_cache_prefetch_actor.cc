@@ -15,6 +15,7 @@
  */
 
 #include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_actor.h"
+#include <chrono>
 #include <limits>
 #include "backend/common/optimizer/dynamic_shape/dynamic_shape_helper.h"
 #include "kernel/common_utils.h"
@@ -37,6 +38,11 @@ using mindspore::session::KernelGraph;
 constexpr size_t kDefaultQueueCapacity = 128;
 
 namespace {
+uint64_t ElapsedUs(const std::chrono::steady_clock::time_point &start_time) {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count());
+}
+
 // Generate unique inter process edge name, format:
 // src role + src rank id -> dst role + dst rank id + embedding cache operation + parameter key.
 std::string GenerateInterProcessEdge(const std::string &src_role, uint32_t src_rank, const std::string &dst_role,
@@ -210,7 +216,11 @@ void EmbeddingCachePrefetchActor::Initialize() {
   }
   MS_EXCEPTION_IF_NULL(device_context_);
   MS_EXCEPTION_IF_NULL(device_context_->device_res_manager_);
-  if (!device_context_->device_res_manager_->CreateStream(&stream_id_)) {
+  if (device_context_->GetDeviceType() == device::DeviceType::kCPU) {
+    // There is no device stream on CPU, the host memory of CPU device stands in for the device cache, and the memcpy
+    // and cache kernels run synchronously.
+    MS_LOG(INFO) << "The embedding cache prefetch actor runs on CPU, the device cache is kept in host memory.";
+  } else if (!device_context_->device_res_manager_->CreateStream(&stream_id_)) {
     MS_LOG(EXCEPTION) << "Create stream failed.";
   }
 
@@ -277,6 +287,20 @@ void EmbeddingCachePrefetchActor::Finalize(bool finalize_remote) {
     emb_ops_ = nullptr;
   }
 
+  if (total_prefetch_num_ > 0) {
+    MS_LOG(INFO) << "Embedding cache prefetched " << total_prefetch_num_
+                 << " times, batch ids: " << total_prefetch_info_.batch_id_count_
+                 << ", unique ids: " << total_prefetch_info_.batch_id_unique_count_
+                 << ", device cache hit: " << total_prefetch_info_.hash_hit_count_
+                 << ", host to device: " << total_prefetch_info_.host_to_device_size_
+                 << ", device to host: " << total_prefetch_info_.device_to_host_size_
+                 << ", server to host: " << total_prefetch_info_.server_to_host_size_
+                 << ", host to server: " << total_prefetch_info_.host_to_server_size_
+                 << ", analyse cost: " << total_prefetch_info_.analyse_cost_us_
+                 << "us, stall for graph: " << total_prefetch_info_.wait_graph_cost_us_
+                 << "us, swap cost: " << total_prefetch_info_.swap_cost_us_ << "us.";
+  }
+
   rpc_operators_.clear();
   finalized_ = true;
   initialized_ = false;
@@ -536,6 +560,15 @@ void EmbeddingCachePrefetchActor::AnalyseCacheTask(const std::string &channel_na
     EmbeddingCacheStatisticsInfo *statistics_info = new (std::nothrow) EmbeddingCacheStatisticsInfo();
     MS_EXCEPTION_IF_NULL(statistics_info);
 
+    // The batches analysed ahead of the graph, whose evicted cache slots may still be used by the running graph.
+    statistics_info->lookahead_steps_ = unique_ids->data_step_ > graph_step_ ? unique_ids->data_step_ - graph_step_ : 0;
+    statistics_info->batch_id_unique_count_ = unique_ids_num;
+    for (auto batch_size : unique_ids->multi_batch_size_) {
+      statistics_info->batch_id_count_ += batch_size;
+    }
+    auto start_time = std::chrono::steady_clock::now();
+    uint64_t wait_graph_time_us = wait_graph_time_us_.load();
+
     // Analyse cache hit/miss
     if (!emb_ops_->AnalyseCache(unique_ids->ids_, unique_ids_num, unique_ids->data_step_, &graph_step_,
                                 &device_cache_need_wait_graph_, &host_cache_need_wait_graph_, indices,
@@ -544,6 +577,8 @@ void EmbeddingCachePrefetchActor::AnalyseCacheTask(const std::string &channel_na
       StopPrefetchCachePipeline();
       return;
     }
+    statistics_info->analyse_cost_us_ = ElapsedUs(start_time);
+    statistics_info->wait_graph_cost_us_ = wait_graph_time_us_.load() - wait_graph_time_us;
 
     // Push analyse result to update cache queue
     CacheAnalysis *cache_analysis =
@@ -583,19 +618,11 @@ void EmbeddingCachePrefetchActor::UpdateCacheTask(const std::string &channel_nam
       continue;
     }
 
-    for (const auto &item : embedding_cache_table_manager.hash_tables_) {
-      const auto &hash_info = item.second;
-      MS_EXCEPTION_IF_CHECK_FAIL(PushCacheFromLocalHostToRemote(hash_info, cache_analysis),
-                                 "Push cache from local host to remote failed.");
-      MS_EXCEPTION_IF_CHECK_FAIL(emb_ops_->PushCacheFromDeviceToLocalHost(hash_info, cache_analysis),
-                                 "Push cache from device to local host failed.");
-      MS_EXCEPTION_IF_CHECK_FAIL(InitLocalCacheForNewIds(hash_info, cache_analysis),
-                                 "Initialize the local cache values using random generator.");
-      MS_EXCEPTION_IF_CHECK_FAIL(PullCacheFromRemoteToLocalHost(hash_info, cache_analysis),
-                                 "Pull cache from remote to local host failed.");
-      MS_EXCEPTION_IF_CHECK_FAIL(emb_ops_->PullCacheFromLocalHostToDevice(hash_info, cache_analysis),
-                                 "Pull cache from local host to device failed.");
-    }
+    auto start_time = std::chrono::steady_clock::now();
+    MS_EXCEPTION_IF_CHECK_FAIL(UpdateCache(cache_analysis), "Update embedding cache failed.");
+    MS_EXCEPTION_IF_NULL(cache_analysis->statistics_info_);
+    cache_analysis->statistics_info_->swap_cost_us_ = ElapsedUs(start_time);
+    ReportPrefetchStep(cache_analysis);
 
     IdsAndIndices *ids_and_indices =
       new (std::nothrow) IdsAndIndices(cache_analysis->unique_ids_, cache_analysis->indices_,
@@ -610,6 +637,75 @@ void EmbeddingCachePrefetchActor::UpdateCacheTask(const std::string &channel_nam
   }
 }
 
+bool EmbeddingCachePrefetchActor::UpdateCache(const CacheAnalysis *cache_analysis) {
+  MS_ERROR_IF_NULL(cache_analysis);
+  MS_ERROR_IF_NULL(emb_ops_);
+  const auto &hash_tables = embedding_cache_table_manager.hash_tables_;
+  // 1. The rows evicted from local host cache must be pushed to remote before they are overwritten.
+  for (const auto &item : hash_tables) {
+    RETURN_IF_FALSE_WITH_LOG(PushCacheFromLocalHostToRemote(item.second, cache_analysis),
+                             "Push cache from local host to remote failed.");
+  }
+
+  // 2. The rows pulled from remote and the rows swapped out from device are different rows of local host cache, so
+  // the rpc with remote runs in another thread and overlaps with the memcpy between device and local host.
+  auto pull_task = [this, &hash_tables, cache_analysis]() {
+    for (const auto &item : hash_tables) {
+      RETURN_IF_FALSE_WITH_LOG(InitLocalCacheForNewIds(item.second, cache_analysis),
+                               "Initialize the local cache values using random generator failed.");
+      RETURN_IF_FALSE_WITH_LOG(PullCacheFromRemoteToLocalHost(item.second, cache_analysis),
+                               "Pull cache from remote to local host failed.");
+    }
+    return true;
+  };
+  auto push_task = [this, &hash_tables, cache_analysis]() {
+    for (const auto &item : hash_tables) {
+      RETURN_IF_FALSE_WITH_LOG(emb_ops_->PushCacheFromDeviceToLocalHost(item.second, cache_analysis),
+                               "Push cache from device to local host failed.");
+    }
+    return true;
+  };
+  if (!swap_runner_.Run(pull_task, push_task)) {
+    return false;
+  }
+
+  // 3. All rows needed by device are in local host cache now.
+  for (const auto &item : hash_tables) {
+    RETURN_IF_FALSE_WITH_LOG(emb_ops_->PullCacheFromLocalHostToDevice(item.second, cache_analysis),
+                             "Pull cache from local host to device failed.");
+  }
+  return true;
+}
+
+void EmbeddingCachePrefetchActor::ReportPrefetchStep(const CacheAnalysis *cache_analysis) {
+  MS_EXCEPTION_IF_NULL(cache_analysis);
+  MS_EXCEPTION_IF_NULL(cache_analysis->unique_ids_);
+  const auto *info = cache_analysis->statistics_info_;
+  MS_EXCEPTION_IF_NULL(info);
+  MS_LOG(INFO) << "Embedding cache prefetch data step: " << cache_analysis->unique_ids_->data_step_
+               << ", batch num: " << cache_analysis->unique_ids_->multi_batch_size_.size()
+               << ", lookahead steps: " << info->lookahead_steps_ << ", batch ids: " << info->batch_id_count_
+               << ", unique ids: " << info->batch_id_unique_count_ << ", device cache hit: " << info->hash_hit_count_
+               << ", host to device: " << info->host_to_device_size_
+               << ", device to host: " << info->device_to_host_size_
+               << ", server to host: " << info->server_to_host_size_
+               << ", host to server: " << info->host_to_server_size_ << ", new ids: " << info->new_id_size_
+               << ", analyse cost: " << info->analyse_cost_us_ << "us, stall for graph: " << info->wait_graph_cost_us_
+               << "us, swap cost: " << info->swap_cost_us_ << "us.";
+
+  ++total_prefetch_num_;
+  total_prefetch_info_.batch_id_count_ += info->batch_id_count_;
+  total_prefetch_info_.batch_id_unique_count_ += info->batch_id_unique_count_;
+  total_prefetch_info_.hash_hit_count_ += info->hash_hit_count_;
+  total_prefetch_info_.host_to_device_size_ += info->host_to_device_size_;
+  total_prefetch_info_.device_to_host_size_ += info->device_to_host_size_;
+  total_prefetch_info_.server_to_host_size_ += info->server_to_host_size_;
+  total_prefetch_info_.host_to_server_size_ += info->host_to_server_size_;
+  total_prefetch_info_.analyse_cost_us_ += info->analyse_cost_us_;
+  total_prefetch_info_.wait_graph_cost_us_ += info->wait_graph_cost_us_;
+  total_prefetch_info_.swap_cost_us_ += info->swap_cost_us_;
+}
+
 void EmbeddingCachePrefetchActor::TransformIdsToIndicesTask(const std::string &channel_name) {
   const auto &queue_iter = channel_to_queues_.find(channel_name);
   if (queue_iter == channel_to_queues_.end()) {
@@ -690,8 +786,11 @@ bool EmbeddingCachePrefetchActor::WaitGraphRun() {
   MS_LOG(INFO) << "Hash table has no space to insert new data and retries within 2 minutes.";
   std::unique_lock<std::mutex> locker(data_mutex_);
   const int64_t longest_time_to_wait = 120;
-  if (!data_parser_.wait_for(locker, std::chrono::seconds(longest_time_to_wait),
-                             [this] { return graph_step_ > graph_running_step_; })) {
+  auto start_time = std::chrono::steady_clock::now();
+  bool graph_run = data_parser_.wait_for(locker, std::chrono::seconds(longest_time_to_wait),
+                                         [this] { return graph_step_ > graph_running_step_; });
+  wait_graph_time_us_ += ElapsedUs(start_time);
+  if (!graph_run) {
     std::string err_info = "Prefetch embedding cache timeout, please enlarge the vocab cache size(graph step:" +
                            std::to_string(graph_step_) + ", graph running step:" + std::to_string(graph_running_step_) +
                            ").";
@@ -236,6 +236,13 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   void UpdateCacheTask(const std::string &channel_name);
   void TransformIdsToIndicesTask(const std::string &channel_name);
 
+  // Swap the embeddings of all tables according to the cache analysis result, the swap between local host cache and
+  // remote is overlapped with the swap between device cache and local host cache.
+  bool UpdateCache(const CacheAnalysis *cache_analysis);
+
+  // Report the swap sizes and time costs of the prefetched batches, and accumulate them into total_prefetch_info_.
+  void ReportPrefetchStep(const CacheAnalysis *cache_analysis);
+
   // Set current error information before finalizing actor.
   void SetErrorInfo(const std::string &error_info);
 
@@ -268,6 +275,16 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   // Statistics on the cache hit rate of the host and device and the information used to update cache.
   EmbeddingCacheStatisticsInfo statistics_info_;
 
+  // The accumulated statistics of all prefetched batches, which is reported when the actor is finalized.
+  EmbeddingCacheStatisticsInfo total_prefetch_info_;
+  size_t total_prefetch_num_{0};
+
+  // The accumulated time in microseconds that cache analysis stalls for the computed graph in WaitGraphRun.
+  std::atomic<uint64_t> wait_graph_time_us_{0};
+
+  // Run the swaps between local host cache and remote overlapped with the ones between device and local host cache.
+  distributed::OverlappedTaskRunner swap_runner_;
+
   // Model parallelism is used between multiple workers, and local_embedding_slice_bounds_ records the feature range
   // corresponding to the embedding table slice of the process.
   std::pair<int, int> local_embedding_slice_bounds_;
@@ -0,0 +1,197 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/gradient_bucket_actor.h"
+#include "runtime/graph_scheduler/actor/kernel_actor.h"
+#include "include/common/profiler.h"
+
+namespace mindspore {
+namespace runtime {
+std::vector<std::vector<size_t>> PartitionGradientBuckets(const std::vector<GradientInfo> &gradients,
+                                                          size_t bucket_size) {
+  std::vector<std::vector<size_t>> buckets;
+  size_t current_size = 0;
+  int64_t current_fusion = 0;
+  int64_t current_begin_position = 0;
+  for (size_t i = 0; i < gradients.size(); ++i) {
+    const auto &gradient = gradients[i];
+    // A gradient larger than the bucket size takes a bucket alone.
+    bool need_new_bucket = buckets.empty() || (gradient.fusion != current_fusion) ||
+                           (current_size + gradient.size > bucket_size) ||
+                           (gradient.depend_position >= current_begin_position);
+    if (need_new_bucket) {
+      (void)buckets.emplace_back();
+      current_size = 0;
+      current_fusion = gradient.fusion;
+      current_begin_position = gradient.position;
+    }
+    (void)buckets.back().emplace_back(i);
+    current_size += gradient.size;
+  }
+  return buckets;
+}
+
+std::shared_ptr<GradientBucketActor> &GradientBucketActor::GetInstance() {
+  static std::shared_ptr<GradientBucketActor> instance =
+    std::shared_ptr<GradientBucketActor>(new GradientBucketActor());
+  return instance;
+}
+
+void GradientBucket::Pack(const std::vector<DeviceTensor *> &inputs) {
+  if (inputs.size() != members_.size()) {
+    MS_LOG(EXCEPTION) << "The input num " << inputs.size() << " is not equal to the gradient num "
+                      << members_.size() << " of " << name_;
+  }
+  if (buffer_.size() < size_) {
+    buffer_.resize(size_);
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const auto &input = inputs[i];
+    MS_EXCEPTION_IF_NULL(input);
+    auto end = (i + 1 < offsets_.size()) ? offsets_[i + 1] : size_;
+    if (input->GetSize() != end - offsets_[i]) {
+      MS_LOG(EXCEPTION) << "The size of gradient " << i << " is " << input->GetSize() << ", but the size in " << name_
+                        << " is " << (end - offsets_[i]);
+    }
+    auto ret = memcpy_s(buffer_.data() + offsets_[i], size_ - offsets_[i], input->GetPtr(), input->GetSize());
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Pack the gradient " << i << " into " << name_ << " failed, errno: " << ret;
+    }
+  }
+}
+
+void GradientBucket::Unpack(const std::vector<DeviceTensor *> &outputs) const {
+  if (outputs.size() != members_.size()) {
+    MS_LOG(EXCEPTION) << "The output num " << outputs.size() << " is not equal to the gradient num "
+                      << members_.size() << " of " << name_;
+  }
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    const auto &output = outputs[i];
+    MS_EXCEPTION_IF_NULL(output);
+    auto ret = memcpy_s(output->GetMutablePtr(), output->GetSize(), buffer_.data() + offsets_[i], output->GetSize());
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Unpack the gradient " << i << " from " << name_ << " failed, errno: " << ret;
+    }
+  }
+}
+
+std::vector<GradientBucket *> GradientBucketGroup::AddReadyGradient(GradientBucket *const bucket) {
+  MS_EXCEPTION_IF_NULL(bucket);
+  std::vector<GradientBucket *> launch_buckets;
+  if (++bucket->ready_num_ < bucket->members_.size()) {
+    return launch_buckets;
+  }
+  // The full bucket waits for the previous buckets to keep the same order of collectives among the ranks.
+  while (next_launch_index_ < buckets_.size()) {
+    const auto &next_bucket = buckets_[next_launch_index_];
+    MS_EXCEPTION_IF_NULL(next_bucket);
+    if (!next_bucket->IsFull()) {
+      break;
+    }
+    next_bucket->ready_num_ = 0;
+    ++next_launch_index_;
+    (void)launch_buckets.emplace_back(next_bucket.get());
+  }
+  if (next_launch_index_ == buckets_.size()) {
+    next_launch_index_ = 0;
+  }
+  return launch_buckets;
+}
+
+void GradientBucketGroup::Reset() {
+  for (const auto &bucket : buckets_) {
+    MS_EXCEPTION_IF_NULL(bucket);
+    bucket->ready_num_ = 0;
+  }
+  next_launch_index_ = 0;
+}
+
+void GradientBucketActor::AddGradient(OpContext<DeviceTensor> *const context, KernelActor *const kernel_actor) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(kernel_actor);
+  auto bucket = kernel_actor->gradient_bucket_;
+  MS_EXCEPTION_IF_NULL(bucket);
+  auto group = bucket->group_;
+  MS_EXCEPTION_IF_NULL(group);
+  // The buckets of the failed step would never be full, and the kernel actors stop without the launch callback.
+  if (IsRunningFailed(context)) {
+    group->Reset();
+    return;
+  }
+  if (bucket->ready_num_ == 0) {
+    PROFILER_START(bucket->fill_start_time_);
+  }
+  if (bucket->ready_num_ + 1 == bucket->members_.size()) {
+    PROFILER_END(bucket->fill_start_time_, ProfilerModule::kRuntime, ProfilerEvent::kGradientBucketFill,
+                 bucket->name_, false);
+  }
+
+  for (auto launch_bucket : group->AddReadyGradient(bucket)) {
+    if (!IsRunningFailed(context)) {
+      try {
+        LaunchBucket(context, launch_bucket);
+      } catch (const std::exception &e) {
+        MsException::Instance().SetException();
+        MS_LOG(ERROR) << "Failed to launch " << launch_bucket->name_ << " and catch exception: " << e.what();
+        context->error_info_ = e.what();
+        context->SetFailed(kFailure);
+      }
+    }
+    for (auto &member : launch_bucket->members_) {
+      ActorDispatcher::Send(member->GetAID(), &KernelActor::OnGradientBucketLaunchFinish, context);
+    }
+  }
+}
+
+void GradientBucketActor::LaunchBucket(OpContext<DeviceTensor> *const context, GradientBucket *const bucket) const {
+  MS_EXCEPTION_IF_NULL(bucket);
+  ProfilerRecorder profiler(ProfilerModule::kKernel, ProfilerEvent::kGradientBucketLaunch, bucket->name_);
+  MS_LOG(DEBUG) << "Begin launch " << bucket->name_ << ", gradient num: " << bucket->members_.size()
+                << ", size: " << bucket->size_;
+  std::vector<DeviceTensor *> inputs;
+  std::vector<DeviceTensor *> outputs;
+  for (const auto &member : bucket->members_) {
+    MS_EXCEPTION_IF_NULL(member);
+    (void)inputs.emplace_back(member->input_device_tensors_[0]);
+    (void)outputs.emplace_back(member->output_device_tensors_[0]);
+  }
+  bucket->Pack(inputs);
+
+  // Launch the fused AllReduce in place by the kernel mod of the first gradient.
+  auto buffer = bucket->buffer_.data();
+  const auto &first_member = bucket->members_.front();
+  const auto &device_context = first_member->device_contexts_[0];
+  MS_EXCEPTION_IF_NULL(device_context);
+  if (bucket->kernel_tensor_ == nullptr) {
+    // Only the float32 gradients are bucketed, and the shape is the element number of the bucket.
+    bucket->kernel_tensor_ = std::make_shared<kernel::KernelTensor>(
+      buffer, bucket->size_, Format::DEFAULT_FORMAT, kNumberTypeFloat32,
+      ShapeVector{SizeToLong(bucket->size_ / sizeof(float))}, device_context->device_context_key().device_name_,
+      device_context->device_context_key().device_id_);
+  }
+  bucket->kernel_tensor_->set_device_ptr(buffer);
+  std::vector<KernelTensor *> kernel_tensors = {bucket->kernel_tensor_.get()};
+  if (!device_context->GetKernelExecutor(false)->LaunchKernel(first_member->kernel_, kernel_tensors, {},
+                                                              kernel_tensors, first_member->kernel_mod_, nullptr)) {
+    std::string error_info = "#umsg#Kernel error:#umsg#Launch " + bucket->name_ + " failed.";
+    SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+  }
+
+  bucket->Unpack(outputs);
+  MS_LOG(DEBUG) << "End launch " << bucket->name_;
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_GRADIENT_BUCKET_ACTOR_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_GRADIENT_BUCKET_ACTOR_H_
+
+#include <vector>
+#include <string>
+#include <memory>
+
+#include "runtime/graph_scheduler/actor/actor_common.h"
+#include "kernel/kernel.h"
+#include "utils/ms_utils.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace runtime {
+class KernelActor;
+
+// The environment variable to enable the gradient bucketing of the data parallel training on CPU. The value is the max
+// size of one bucket in MB, e.g. "25" or "0.5", and the gradient bucketing is disabled if it is not set or is zero.
+// The gradient AllReduce kernels which are marked by the frontend allreduce fusion pass are not fused at compile time
+// when it is enabled, instead they are fused into the buckets at runtime.
+constexpr char kEnvCpuGradientBucketSize[] = "MS_CPU_GRADIENT_BUCKET_SIZE";
+constexpr double kMBToByte = 1024.0 * 1024.0;
+
+// Get the max size of gradient bucket in bytes from kEnvCpuGradientBucketSize, returns 0 if it is disabled.
+inline size_t GetGradientBucketSize() {
+  auto env = common::GetEnv(kEnvCpuGradientBucketSize);
+  if (env.empty()) {
+    return 0;
+  }
+  double size_in_mb = 0;
+  try {
+    size_in_mb = std::stod(env);
+  } catch (const std::exception &) {
+    MS_LOG(EXCEPTION) << "The value of " << kEnvCpuGradientBucketSize << " should be a number, but got: " << env;
+  }
+  if (size_in_mb < 0) {
+    MS_LOG(EXCEPTION) << "The value of " << kEnvCpuGradientBucketSize << " should not be negative, but got: " << env;
+  }
+  return static_cast<size_t>(size_in_mb * kMBToByte);
+}
+
+// The information of gradient AllReduce kernel used to partition the gradient buckets.
+struct GradientInfo {
+  // The position of the kernel in the execution order.
+  int64_t position;
+  // The size of the gradient in bytes.
+  size_t size;
+  // The fusion id set by the frontend allreduce fusion pass.
+  int64_t fusion;
+  // The max position of the gradient AllReduce kernels which this kernel depends on directly or indirectly, and -1
+  // means that it doesn't depend on any gradient AllReduce kernel.
+  int64_t depend_position;
+};
+
+// Partition the gradients in the execution order into the buckets, and return the indexes of gradients in each
+// bucket. A new bucket is started when the fusion id changes, the bucket size exceeds 'bucket_size' or the gradient
+// depends on one in the current bucket, which would never be filled otherwise.
+BACKEND_EXPORT std::vector<std::vector<size_t>> PartitionGradientBuckets(const std::vector<GradientInfo> &gradients,
+                                                                         size_t bucket_size);
+
+struct GradientBucketGroup;
+// The gradient AllReduce kernels fused into one collective at runtime. The gradients are packed into the staging buffer
+// and reduced together once all of them are ready.
+struct GradientBucket {
+  GradientBucket(size_t index, GradientBucketGroup *group)
+      : index_(index), name_("GradientBucket_" + std::to_string(index)), group_(group) {}
+  ~GradientBucket() = default;
+
+  // Whether the gradients of all the members are ready in the current step.
+  bool IsFull() const { return ready_num_ == members_.size(); }
+  // Pack the gradients of members into the staging buffer in the order of members, and unpack the reduced gradients
+  // from the staging buffer to the outputs of members.
+  void Pack(const std::vector<DeviceTensor *> &inputs);
+  void Unpack(const std::vector<DeviceTensor *> &outputs) const;
+
+  size_t index_;
+  std::string name_;
+  GradientBucketGroup *group_;
+  // The kernel actors of gradient AllReduce and the offsets of their gradients in the staging buffer.
+  std::vector<KernelActor *> members_;
+  std::vector<size_t> offsets_;
+  size_t size_{0};
+
+  // The number of members whose gradients are ready in the current step.
+  size_t ready_num_{0};
+  // The time when the first gradient is ready, used to profile the bucket filling.
+  uint64_t fill_start_time_{0};
+
+  std::vector<uint8_t> buffer_;
+  kernel::KernelTensorPtr kernel_tensor_{nullptr};
+};
+using GradientBucketPtr = std::shared_ptr<GradientBucket>;
+
+// The gradient buckets of one actor set. The buckets are launched in the order of index in every step, so that all the
+// ranks issue the collectives in the same order no matter which bucket is filled first.
+struct GradientBucketGroup {
+  // Mark one gradient of the bucket ready, and return the full buckets which are next to launch in the order of index.
+  std::vector<GradientBucket *> AddReadyGradient(GradientBucket *const bucket);
+  // Clear the ready gradients of the unfinished step, which is called at the beginning of step and after it fails.
+  void Reset();
+
+  std::vector<GradientBucketPtr> buckets_;
+  size_t next_launch_index_{0};
+};
+using GradientBucketGroupPtr = std::shared_ptr<GradientBucketGroup>;
+
+// The gradient bucket actor receives the ready gradients from the kernel actors of gradient AllReduce and launches the
+// buckets once they are full on its exclusive thread, so the communication overlaps the computation of backward.
+class BACKEND_EXPORT GradientBucketActor : public ActorBase {
+ public:
+  static std::shared_ptr<GradientBucketActor> &GetInstance();
+  ~GradientBucketActor() override = default;
+
+  // Add the ready gradient of kernel actor into its bucket, and launch the full buckets in order. The kernel actors of
+  // the launched bucket are called back by 'OnGradientBucketLaunchFinish'.
+  void AddGradient(OpContext<DeviceTensor> *const context, KernelActor *const kernel_actor);
+
+ private:
+  GradientBucketActor() : ActorBase("GradientBucketActor") {}
+  DISABLE_COPY_AND_ASSIGN(GradientBucketActor);
+
+  // Pack the gradients into the staging buffer, launch the fused AllReduce and unpack the results to the outputs.
+  void LaunchBucket(OpContext<DeviceTensor> *const context, GradientBucket *const bucket) const;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_GRADIENT_BUCKET_ACTOR_H_
@@ -435,25 +435,37 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   PreLaunchKernel(context);
 
   bool skip_launch = CollectiveManager::instance()->need_reinit() || IsSkippedLaunch(kernel_, nullptr);
+  // The gradient is reduced together with the others in the same bucket on the thread of gradient bucket actor, which
+  // calls back OnGradientBucketLaunchFinish to continue.
+  if (!skip_launch && gradient_bucket_ != nullptr) {
+    ActorDispatcher::Send(GradientBucketActor::GetInstance()->GetAID(), &GradientBucketActor::AddGradient, context,
+                          this);
+    return;
+  }
   if (!skip_launch && !LaunchKernel(context)) {
     MS_LOG(EXCEPTION) << "#umsg#Kernel error:#umsg#Launch kernel failed: " + kernel_->fullname_with_scope();
   }
+  FinishLaunchKernel(context);
+}
 
-  // Record mem info, because async send may free device info.
-  if (recorder_aid_ != nullptr || debug_aid_ != nullptr) {
-    for (size_t i = 0; i < input_device_tensors_.size(); ++i) {
-      mem_info_.inputs_[i]->addr = input_device_tensors_[i]->GetMutablePtr();
-      mem_info_.inputs_[i]->size = input_device_tensors_[i]->GetSize();
-    }
-    for (size_t i = 0; i < output_device_tensors_.size(); ++i) {
-      mem_info_.outputs_[i]->addr = output_device_tensors_[i]->GetMutablePtr();
-      mem_info_.outputs_[i]->size = output_device_tensors_[i]->GetSize();
-    }
-    for (size_t i = 0; i < workspace_device_tensors_.size(); ++i) {
-      mem_info_.workspaces_[i]->addr = workspace_device_tensors_[i]->GetMutablePtr();
-      mem_info_.workspaces_[i]->size = workspace_device_tensors_[i]->GetSize();
-    }
+void KernelActor::OnGradientBucketLaunchFinish(OpContext<DeviceTensor> *const context) {
+  if (IsRunningFailed(context)) {
+    MS_LOG(INFO) << "Run failed and early stop for kernel: " << kernel_->fullname_with_scope();
+    return;
+  }
+  try {
+    FinishLaunchKernel(context);
+  } catch (const std::exception &e) {
+    MsException::Instance().SetException();
+    std::string error_info =
+      "#umsg#Kernel error:#umsg#run kernel[" + kernel_->fullname_with_scope() + "] failed, exception: " + e.what();
+    SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
   }
+}
+
+void KernelActor::FinishLaunchKernel(OpContext<DeviceTensor> *const context) {
+  // Record mem info, because async send may free device info.
+  RecordMemInfo();
 
   // Debug actor is blocked, must wait debug actor callback message to process continue.
   if (debug_aid_ != nullptr) {
@@ -464,6 +476,24 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   PostLaunchKernel(context);
 }
 
+void KernelActor::RecordMemInfo() {
+  if (recorder_aid_ == nullptr && debug_aid_ == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < input_device_tensors_.size(); ++i) {
+    mem_info_.inputs_[i]->addr = input_device_tensors_[i]->GetMutablePtr();
+    mem_info_.inputs_[i]->size = input_device_tensors_[i]->GetSize();
+  }
+  for (size_t i = 0; i < output_device_tensors_.size(); ++i) {
+    mem_info_.outputs_[i]->addr = output_device_tensors_[i]->GetMutablePtr();
+    mem_info_.outputs_[i]->size = output_device_tensors_[i]->GetSize();
+  }
+  for (size_t i = 0; i < workspace_device_tensors_.size(); ++i) {
+    mem_info_.workspaces_[i]->addr = workspace_device_tensors_[i]->GetMutablePtr();
+    mem_info_.workspaces_[i]->size = workspace_device_tensors_[i]->GetSize();
+  }
+}
+
 void KernelActor::CopyInputDeviceTensor(const OpData<DeviceTensor> *input_data,
                                         OpContext<DeviceTensor> *const context) {
   size_t input_data_index = IntToSize(input_data->index_);
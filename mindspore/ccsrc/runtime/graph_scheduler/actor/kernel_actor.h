@@ -28,6 +28,7 @@
 #include "runtime/graph_scheduler/actor/kernel_async_launch_actor.h"
 #include "runtime/graph_scheduler/actor/kernel_async_infer_actor.h"
 #include "runtime/graph_scheduler/actor/kernel_async_resize_actor.h"
+#include "runtime/graph_scheduler/actor/gradient_bucket_actor.h"
 #include "runtime/hardware/device_context.h"
 #include "runtime/graph_scheduler/device_tensor_store.h"
 #include "kernel/kernel.h"
@@ -95,6 +96,8 @@ class KernelActor : public DebugAwareActor {
   void SendMemoryFreeReq(OpContext<DeviceTensor> *const context) override;
   // The callback after memory alloc finished.
   void OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) override;
+  // The callback after the gradient bucket which contains this kernel is launched by GradientBucketActor.
+  void OnGradientBucketLaunchFinish(OpContext<DeviceTensor> *const context);
 
   const CNodePtr &kernel() const { return kernel_; }
   const std::set<size_t> &modifiable_ref_input_indexes() const { return modifiable_ref_input_indexes_; }
@@ -103,6 +106,7 @@ class KernelActor : public DebugAwareActor {
   bool is_launch_skipped() const { return is_launch_skipped_; }
   bool inputs_continuous_memory() const { return inputs_continuous_memory_; }
   SomasInfo *somas_info() const { return somas_info_; }
+  GradientBucket *gradient_bucket() const { return gradient_bucket_; }
   const std::set<size_t> &somas_graph_output_indexes() const { return somas_graph_output_indexes_; }
   CallbackCounterPtr callback_counter() const { return callback_counter_; }
   void set_callback_counter(const CallbackCounterPtr &callback_counter) { callback_counter_ = callback_counter; }
@@ -202,6 +206,7 @@ class KernelActor : public DebugAwareActor {
   friend class ControlNodeScheduler;
   friend class InlineControlFlowScheduler;
   friend class SchedulerHelper;
+  friend class GradientBucketActor;
 #ifdef ENABLE_RPC_ACTOR
   friend class RpcNodeScheduler;
 #endif
@@ -222,6 +227,11 @@ class KernelActor : public DebugAwareActor {
   void PreLaunchKernel(OpContext<DeviceTensor> *const context);
   // The processing after kernel launch: 1.erase input, 2.free memory, 3.send output.
   void PostLaunchKernel(OpContext<DeviceTensor> *const context);
+  // The processing after the kernel is launched by this actor or by GradientBucketActor: 1.record the memory info,
+  // 2.debug, 3.post launch.
+  void FinishLaunchKernel(OpContext<DeviceTensor> *const context);
+  // Record the memory info of kernel launch for the debug actor and recorder actor.
+  void RecordMemInfo();
   // Back refresh the dynamic device tensor stores that have been triggered copy.
   void RefreshDeviceTensorCopyStore(OpContext<DeviceTensor> *const context);
 
@@ -251,6 +261,10 @@ class KernelActor : public DebugAwareActor {
   // Whether the inputs need continuous memory, used to check the inputs legitimacy.
   bool inputs_continuous_memory_;
 
+  // The gradient bucket which fuses the gradient AllReduce kernel with others at runtime, and the kernel is launched by
+  // GradientBucketActor instead of this actor if it is not null.
+  GradientBucket *gradient_bucket_{nullptr};
+
   CallbackCounterPtr callback_counter_;
 
   // The stream resource of the KernelActor to launch kernel.
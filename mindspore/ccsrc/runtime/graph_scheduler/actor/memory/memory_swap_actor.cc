@@ -19,9 +19,28 @@
 #include <map>
 
 #include "runtime/graph_scheduler/device_tensor_store.h"
+#include "include/backend/kernel_info.h"
 
 namespace mindspore {
 namespace runtime {
+namespace {
+// The memory of somas is an offset in the whole block, and the persistent memory lives as long as the graph, so only
+// the memory allocated from the dynamic pool alone can be freed and recomputed.
+bool IsDynamicPoolMemory(const DeviceTensor *device_tensor) {
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  if (device_tensor->is_ptr_persisted() || !device_tensor->from_mem_pool()) {
+    return false;
+  }
+  const auto &node_with_index = device_tensor->GetNodeIndex();
+  if (node_with_index.first == nullptr || !node_with_index.first->isa<CNode>()) {
+    return true;
+  }
+  const auto kernel_info = dynamic_cast<device::KernelInfo *>(node_with_index.first->kernel_info());
+  return kernel_info == nullptr ||
+         !kernel_info->IsTensorEnableSomas(kernel_info->somas_output_result(), node_with_index.second);
+}
+}  // namespace
+
 void MemorySwapActor::FetchRealParameters(OpContext<mindspore::runtime::DeviceTensor> *context) {
   MS_EXCEPTION_IF_NULL(context);
   const auto &data_iter = input_op_datas_.find(context->sequential_num_);
@@ -102,11 +121,92 @@ void MemorySwapActor::AllocDeviceContinuousMem(const std::vector<DeviceTensor *>
   }
 }
 
+void MemorySwapActor::FreeDeviceMem(const std::vector<DeviceTensor *> &device_tensors) {
+  MS_EXCEPTION_IF_CHECK_FAIL((!device_contexts_.empty()), "The device context doesn't exist.");
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]->device_res_manager_);
+  for (const auto device_tensor : device_tensors) {
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    if (device_tensor->GetPtr() == nullptr || !IsDynamicPoolMemory(device_tensor)) {
+      continue;
+    }
+    device_contexts_[0]->device_res_manager_->FreeMemory(device_tensor);
+  }
+}
+
+void MemorySwapActor::Recompute(OpContext<mindspore::runtime::DeviceTensor> *const context,
+                                const std::vector<DeviceTensor *> &device_tensors) {
+  MS_EXCEPTION_IF_CHECK_FAIL((!device_contexts_.empty()), "The device context doesn't exist.");
+  const auto &device_context = device_contexts_[0];
+  MS_EXCEPTION_IF_NULL(device_context);
+  const auto &res_manager = device_context->device_res_manager_;
+  MS_EXCEPTION_IF_NULL(res_manager);
+  for (const auto device_tensor : device_tensors) {
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    const auto &iter = recompute_kernels_.find(device_tensor);
+    if (iter == recompute_kernels_.end()) {
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR(*context, "The kernel to recompute the device tensor doesn't exist.");
+    }
+    const auto &kernel = iter->second;
+    MS_EXCEPTION_IF_NULL(kernel);
+    // The memory which is not freed by kFreeHBM still holds the data, there is nothing to recompute.
+    if (device_tensor->GetPtr() != nullptr) {
+      MS_LOG(DEBUG) << "Skip recomputing the resident device tensor of kernel: " << kernel->fullname_with_scope();
+      continue;
+    }
+    if (!res_manager->AllocateMemory(device_tensor)) {
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR(*context, "Allocate memory to recompute failed.");
+    }
+
+    std::vector<KernelTensor *> inputs;
+    const auto input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      const auto &input_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i, false);
+      MS_EXCEPTION_IF_NULL(input_address);
+      (void)inputs.emplace_back(input_address->kernel_tensor().get());
+    }
+    std::vector<KernelTensor *> outputs;
+    const auto output_num = AnfAlgo::GetOutputAddressNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      const auto &output_address = AnfAlgo::GetMutableOutputAddr(kernel, i, false);
+      MS_EXCEPTION_IF_NULL(output_address);
+      (void)outputs.emplace_back(output_address->kernel_tensor().get());
+    }
+    std::vector<KernelTensor *> workspaces;
+    // Only the workspaces allocated here are freed after the launch, the others belong to somas or the kernel actor.
+    std::vector<DeviceTensor *> workspace_addresses;
+    const auto &kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      const auto &workspace_address = AnfAlgo::GetMutableWorkspaceAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(workspace_address);
+      if (workspace_address->GetPtr() == nullptr) {
+        if (!res_manager->AllocateMemory(workspace_address.get())) {
+          SET_OPCONTEXT_FAIL_RET_WITH_ERROR(*context, "Allocate workspace memory to recompute failed.");
+        }
+        (void)workspace_addresses.emplace_back(workspace_address.get());
+      }
+      (void)workspaces.emplace_back(workspace_address->kernel_tensor().get());
+    }
+
+    MS_LOG(DEBUG) << "Recompute kernel: " << kernel->fullname_with_scope();
+    const auto &kernel_executor = device_context->GetKernelExecutor(false);
+    MS_EXCEPTION_IF_NULL(kernel_executor);
+    if (!kernel_executor->LaunchKernel(kernel, inputs, workspaces, outputs, kernel_mod,
+                                       res_manager->GetStream(stream_id_))) {
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR(*context, "Launch kernel to recompute failed.");
+    }
+    for (const auto workspace_address : workspace_addresses) {
+      res_manager->FreeMemory(workspace_address);
+    }
+  }
+}
+
 void MemorySwapActor::Swap(OpContext<mindspore::runtime::DeviceTensor> *const context, device::StorageType to,
-                           const std::vector<DeviceTensor *> &device_tensors) {
+                           bool async, const std::vector<DeviceTensor *> &device_tensors) {
   for (const auto &device_tensor : device_tensors) {
     MS_EXCEPTION_IF_NULL(device_tensor);
-    if (!device_tensor->MoveTo(to, false, kDefaultStreamIndex)) {
+    if (!device_tensor->MoveTo(to, async, kDefaultStreamIndex)) {
       SET_OPCONTEXT_FAIL_RET_WITH_ERROR(*context, "Swap tensor failed.");
     }
   }
@@ -128,8 +228,14 @@ void MemorySwapActor::Run(OpContext<mindspore::runtime::DeviceTensor> *const con
     const auto &device_tensors = GetDeviceTensors(device_tensor_indexes);
     if (action_type == device::SwapActionType::kAllocHBM) {
       AllocDeviceContinuousMem(device_tensors);
+    } else if (action_type == device::SwapActionType::kFreeHBM) {
+      FreeDeviceMem(device_tensors);
+    } else if (action_type == device::SwapActionType::kRecompute) {
+      Recompute(context, device_tensors);
     } else if (action_type != device::SwapActionType::kUnDefined) {
-      Swap(context, swap_to_map[action_type], device_tensors);
+      // The file io is overlapped with the following kernels, and the next move of the tensor waits for it to finish.
+      bool async = action_type == device::SwapActionType::kHBM2DISK || action_type == device::SwapActionType::kDISK2DDR;
+      Swap(context, swap_to_map[action_type], async, device_tensors);
     } else {
       MS_LOG(WARNING) << "Unknown swap action type, skip.";
     }
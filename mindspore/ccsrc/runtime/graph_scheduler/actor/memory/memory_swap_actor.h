@@ -46,13 +46,20 @@ class MemorySwapActor : public AbstractActor {
   }
   ~MemorySwapActor() override = default;
 
+  // The producer kernels of the device tensors to recompute.
+  void set_recompute_kernels(const mindspore::HashMap<DeviceTensor *, CNodePtr> &recompute_kernels) {
+    recompute_kernels_ = recompute_kernels;
+  }
+
  protected:
   void Run(OpContext<DeviceTensor> *context) override;
   void FetchRealParameters(OpContext<DeviceTensor> *context);
 
  private:
   void AllocDeviceContinuousMem(const std::vector<DeviceTensor *> &device_tensors);
-  static void Swap(OpContext<mindspore::runtime::DeviceTensor> *const context, device::StorageType to,
+  void FreeDeviceMem(const std::vector<DeviceTensor *> &device_tensors);
+  void Recompute(OpContext<DeviceTensor> *const context, const std::vector<DeviceTensor *> &device_tensors);
+  static void Swap(OpContext<mindspore::runtime::DeviceTensor> *const context, device::StorageType to, bool async,
                    const std::vector<DeviceTensor *> &device_tensors);
   void UpdateDeviceTensors(OpContext<DeviceTensor> *context);
   std::vector<DeviceTensor *> GetDeviceTensors(const std::vector<size_t> &indexes);
@@ -63,6 +70,7 @@ class MemorySwapActor : public AbstractActor {
   std::vector<std::pair<device::SwapActionType, vector<size_t>>> swap_actions_;
   std::vector<DeviceTensor *> real_parameters_;
   size_t fixed_device_tensor_num_{0};
+  mindspore::HashMap<DeviceTensor *, CNodePtr> recompute_kernels_;
 };
 
 class MemorySwapInActor : public MemorySwapActor {
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/backend_compile_cache.h"
+#include <fstream>
+#include <cstdio>
+#include "include/common/debug/common.h"
+#include "include/common/utils/compile_cache_context.h"
+#include "include/common/utils/utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr char kCacheMetaVersion[] = "version";
+constexpr char kCacheMetaDeviceTarget[] = "device_target";
+constexpr char kCacheMetaGraphHash[] = "graph_hash";
+constexpr char kCacheMetaCompileTime[] = "compile_time_us";
+
+bool CacheFilesExist(const std::string &cache_path) {
+  return Common::FileExists(cache_path + kJsonSuffix) && Common::FileExists(cache_path + kMindIrSuffix);
+}
+}  // namespace
+
+void BackendCompileCache::BeginCompile(const std::string &cache_path, const nlohmann::json &key, bool use_cache) {
+  Reset();
+  cache_path_ = cache_path;
+  key_ = key;
+  compile_start_time_ = GetCurrentUSec();
+  if (use_cache && Check(cache_path_, key_, &cached_compile_time_)) {
+    use_cache_ = true;
+    ++hit_num_;
+    return;
+  }
+  // The missed cache is exported again, including the stale cache built with a different key.
+  export_cache_ = true;
+  ++miss_num_;
+  if (use_cache) {
+    // The device compile cache, such as the GE cache, is built with the missed backend graph, so it can't be used by
+    // the kernel graph which is compiled again.
+    MS_LOG(INFO) << "The backend compile cache " << cache_path_ << " is missed, disable the device compile cache.";
+    CompileCacheContext::GetInstance().SetUseCompileCache(false);
+  }
+}
+
+void BackendCompileCache::Reset() {
+  use_cache_ = false;
+  export_cache_ = false;
+}
+
+void BackendCompileCache::Export(const std::function<void()> &cache_func, const std::string &graph_name) const {
+  MS_EXCEPTION_IF_NULL(cache_func);
+  auto compile_time = GetCurrentUSec() - compile_start_time_;
+  // Remove the stale cache first, so that a failed export never leaves a valid meta which refers to the cache of
+  // another graph.
+  Remove(cache_path_);
+  cache_func();
+  (void)ExportMeta(cache_path_, key_, compile_time);
+  MS_LOG(INFO) << "Backend compile cache miss for graph " << graph_name << ", compile time: " << compile_time
+               << "us, hit num: " << hit_num_ << ", miss num: " << miss_num_;
+}
+
+void BackendCompileCache::ReportHit(const std::string &graph_name) const {
+  auto compile_time = GetCurrentUSec() - compile_start_time_;
+  auto saved_time = cached_compile_time_ > compile_time ? cached_compile_time_ - compile_time : 0;
+  MS_LOG(INFO) << "Backend compile cache hit for graph " << graph_name << ", compile time: " << compile_time
+               << "us, saved time: " << saved_time << "us, hit num: " << hit_num_ << ", miss num: " << miss_num_;
+}
+
+nlohmann::json BackendCompileCache::GenKey(const std::string &device_target, const std::string &graph_hash) {
+  nlohmann::json key;
+  key[kCacheMetaVersion] = kBackendCompileCacheVersion;
+  key[kCacheMetaDeviceTarget] = device_target;
+  key[kCacheMetaGraphHash] = graph_hash;
+  return key;
+}
+
+bool BackendCompileCache::Check(const std::string &cache_path, const nlohmann::json &key,
+                                uint64_t *const compile_time) {
+  MS_EXCEPTION_IF_NULL(compile_time);
+  if (!CacheFilesExist(cache_path)) {
+    MS_LOG(INFO) << "The backend compile cache " << cache_path << " does not exist.";
+    return false;
+  }
+  const auto &meta_path = cache_path + kBackendCompileCacheMetaSuffix;
+  std::ifstream meta_fs(meta_path);
+  if (!meta_fs.good()) {
+    MS_LOG(INFO) << "Open the meta file of backend compile cache " << meta_path << " failed.";
+    return false;
+  }
+  nlohmann::json meta;
+  try {
+    meta_fs >> meta;
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Parse the meta file of backend compile cache " << meta_path << " failed: " << e.what();
+    return false;
+  }
+  if (!meta.is_object()) {
+    MS_LOG(INFO) << "The meta file of backend compile cache " << meta_path << " is invalid: " << meta.dump();
+    return false;
+  }
+  for (const auto &[name, value] : key.items()) {
+    if (!meta.contains(name) || meta[name] != value) {
+      MS_LOG(INFO) << "The " << name << " of backend compile cache is "
+                   << (meta.contains(name) ? meta[name].dump() : "null") << ", but the current one is "
+                   << value.dump();
+      return false;
+    }
+  }
+  try {
+    *compile_time = meta.value(kCacheMetaCompileTime, static_cast<uint64_t>(0));
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "The compile time in the meta file of backend compile cache " << meta_path
+                 << " is invalid: " << e.what();
+    *compile_time = 0;
+  }
+  return true;
+}
+
+void BackendCompileCache::Remove(const std::string &cache_path) {
+  for (const auto &suffix : {kBackendCompileCacheMetaSuffix, kJsonSuffix, kMindIrSuffix}) {
+    const auto &file_path = cache_path + suffix;
+    if (Common::FileExists(file_path) && (std::remove(file_path.c_str()) != 0)) {
+      MS_LOG(WARNING) << "Remove the stale backend compile cache file " << file_path << " failed.";
+    }
+  }
+}
+
+bool BackendCompileCache::ExportMeta(const std::string &cache_path, const nlohmann::json &key,
+                                     uint64_t compile_time) {
+  if (!CacheFilesExist(cache_path)) {
+    MS_LOG(WARNING) << "Export the backend compile cache " << cache_path << " failed.";
+    return false;
+  }
+  auto meta = key;
+  meta[kCacheMetaCompileTime] = compile_time;
+  if (!Common::SaveStringToFile(cache_path + kBackendCompileCacheMetaSuffix, meta.dump())) {
+    MS_LOG(WARNING) << "Export the meta file of backend compile cache " << cache_path << " failed.";
+    return false;
+  }
+  return true;
+}
+}  // namespace runtime
+}  // namespace mindspore
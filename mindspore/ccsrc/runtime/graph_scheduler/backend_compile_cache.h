@@ -0,0 +1,76 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_BACKEND_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_BACKEND_COMPILE_CACHE_H_
+
+#include <string>
+#include <functional>
+#include "nlohmann/json.hpp"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace runtime {
+// The backend compile cache of the whole graph, which is the optimized kernel graph and the kernel build info. The
+// cache is used only if the meta file next to it records the same key as the current compilation, otherwise the cache
+// is missed and exported again after the graph is compiled.
+class BACKEND_EXPORT BackendCompileCache {
+ public:
+  BackendCompileCache() = default;
+  ~BackendCompileCache() = default;
+
+  // Begin compiling the graph whose cache is at 'cache_path', the cache is used if 'use_cache' is set and the cache
+  // matches the key, otherwise it is exported after the graph is compiled. The device compile cache is disabled if
+  // the cache is missed, since it is built with the stale backend graph.
+  void BeginCompile(const std::string &cache_path, const nlohmann::json &key, bool use_cache);
+  // Reset the flags after compiling the graph, so that the cache is neither used nor exported by the graphs compiled
+  // later.
+  void Reset();
+  // Export the cache by 'cache_func' after removing the stale cache, and then export the meta of the cache.
+  void Export(const std::function<void()> &cache_func, const std::string &graph_name) const;
+  // Report the compile time and the time saved by the cache which is used to compile the graph.
+  void ReportHit(const std::string &graph_name) const;
+
+  bool use_cache() const { return use_cache_; }
+  bool export_cache() const { return export_cache_; }
+  size_t hit_num() const { return hit_num_; }
+  size_t miss_num() const { return miss_num_; }
+
+  // The key of the cache, the cache can only be used by the same graph on the same device target.
+  static nlohmann::json GenKey(const std::string &device_target, const std::string &graph_hash);
+  // Check whether the cache exists and matches the key, and get the backend compile time which is saved by the cache.
+  static bool Check(const std::string &cache_path, const nlohmann::json &key, uint64_t *const compile_time);
+  // Remove the files of the cache and its meta.
+  static void Remove(const std::string &cache_path);
+  // Export the meta of the cache, which fails if the cache is not exported.
+  static bool ExportMeta(const std::string &cache_path, const nlohmann::json &key, uint64_t compile_time);
+
+ private:
+  bool use_cache_{false};
+  bool export_cache_{false};
+  std::string cache_path_;
+  nlohmann::json key_;
+
+  // The compile time is the cost of backend compiling before preprocessing the graph, which is saved by the cache.
+  uint64_t compile_start_time_{0};
+  uint64_t cached_compile_time_{0};
+  size_t hit_num_{0};
+  size_t miss_num_{0};
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_BACKEND_COMPILE_CACHE_H_
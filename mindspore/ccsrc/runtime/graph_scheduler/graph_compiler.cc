@@ -109,28 +109,6 @@ bool EnableBackendCompileCache(const FuncGraphPtr &func_graph, const device::Dev
   return true;
 }
 
-bool UseCacheToCompileGraph(const FuncGraphPtr &func_graph, const device::DeviceType &device_type) {
-  if (!EnableBackendCompileCache(func_graph, device_type)) {
-    return false;
-  }
-  auto &context = CompileCacheContext::GetInstance();
-  if (!context.UseCompileCache()) {
-    return false;
-  }
-  return true;
-}
-
-bool ExportCompileCache(const FuncGraphPtr &func_graph, const device::DeviceType &device_type) {
-  if (!EnableBackendCompileCache(func_graph, device_type)) {
-    return false;
-  }
-  auto &context = CompileCacheContext::GetInstance();
-  if (context.UseCompileCache()) {
-    return false;
-  }
-  return true;
-}
-
 // Fetch the real input of the nop node recursively.
 AnfNodePtr FetchRealNodeByNopNode(const AnfNodePtr &node) {
   MS_EXCEPTION_IF_NULL(node);
@@ -635,22 +613,30 @@ GraphId GraphCompiler::CompileWholeGraphForGraphRunMode(const FuncGraphPtr &func
   auto device_target = device_context->GetDeviceType();
   KernelGraphPtr root_graph;
   bool need_return_ahead = false;
-  if (UseCacheToCompileGraph(func_graph, device_target)) {
+  if (EnableBackendCompileCache(func_graph, device_target)) {
+    auto &compile_cache_context = CompileCacheContext::GetInstance();
+    backend_compile_cache_.BeginCompile(
+      compile_cache_context.GetBackendGraphCachePath(func_graph),
+      BackendCompileCache::GenKey(device_context->device_context_key().device_name_,
+                                  compile_cache_context.FrontGraphCacheHash()),
+      compile_cache_context.UseCompileCache());
+  } else {
+    backend_compile_cache_.Reset();
+  }
+  if (backend_compile_cache_.use_cache()) {
     root_graph = session_->ConstructKernelGraph(&all_graphs);
-    use_cache_to_compile_graph_ = true;
   } else {
     root_graph = ConstructKernelGraphForGraphRunMode(func_graph, device_context, &all_graphs, &need_return_ahead);
   }
   GraphId graph_id = root_graph->graph_id();
   if (need_return_ahead) {
+    backend_compile_cache_.Reset();
     return graph_id;
   }
-  if (ExportCompileCache(func_graph, device_target)) {
-    export_compile_cache_ = true;
-  }
   if (!func_graph->has_flag(kFlagPyNativeRunInGraph)) {
     graph_id = CompileGraphImpl(root_graph, device_context);
   }
+  backend_compile_cache_.Reset();
   if (CompileCacheEnable()) {
     CompileCacheContext::GetInstance().Clear();
   }
@@ -687,8 +673,9 @@ GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph, const Devic
   MS_EXCEPTION_IF_NULL(session_);
   const auto &context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context);
-  if (use_cache_to_compile_graph_) {
+  if (backend_compile_cache_.use_cache()) {
     UseCacheToCompileGraphImpl(graph, device_context);
+    backend_compile_cache_.ReportHit(graph->ToString());
   } else {
 #ifdef ENABLE_DUMP_IR
     if (context->CanDump(kIntroductory)) {
@@ -752,8 +739,8 @@ GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph, const Devic
     }
   }
 
-  if (export_compile_cache_) {
-    session_->CacheKernelGraph(graph);
+  if (backend_compile_cache_.export_cache()) {
+    backend_compile_cache_.Export([this, &graph]() { session_->CacheKernelGraph(graph); }, graph->ToString());
   }
   // Adjust kernel graph before run graph.
   device_context->GetKernelExecutor(false)->PreprocessBeforeRun(graph);
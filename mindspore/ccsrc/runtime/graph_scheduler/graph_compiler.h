@@ -27,6 +27,7 @@
 #include "runtime/hardware/device_context.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "runtime/graph_scheduler/control_node_parser.h"
+#include "runtime/graph_scheduler/backend_compile_cache.h"
 #include "backend/common/session/session_basic.h"
 #include "backend/common/session/session_factory.h"
 #include "ir/tensor.h"
@@ -218,8 +219,7 @@ class GraphCompiler {
   // The member variable 'session_' will be removed after removing session module.
   // Now all the GraphCompiler share the same 'session_'.
   session::SessionPtr session_;
-  bool use_cache_to_compile_graph_ = false;
-  bool export_compile_cache_ = false;
+  BackendCompileCache backend_compile_cache_;
 };
 
 }  // namespace runtime
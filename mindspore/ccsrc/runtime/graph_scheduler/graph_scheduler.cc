@@ -23,6 +23,7 @@
 #include "runtime/graph_scheduler/actor/kernel_async_launch_actor.h"
 #include "runtime/graph_scheduler/actor/kernel_async_infer_actor.h"
 #include "runtime/graph_scheduler/actor/kernel_async_resize_actor.h"
+#include "runtime/graph_scheduler/actor/gradient_bucket_actor.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
 #include "runtime/graph_scheduler/optimizer/optimizer.h"
@@ -30,6 +31,7 @@
 #include "runtime/graph_scheduler/optimizer/memory_actor_insert.h"
 #include "runtime/graph_scheduler/optimizer/invalid_data_arrow_elimination.h"
 #include "runtime/graph_scheduler/optimizer/batch_data_arrow_fusion.h"
+#include "runtime/graph_scheduler/optimizer/critical_path_priority.h"
 #include "runtime/graph_scheduler/optimizer/multi_actor_fusion.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "include/common/profiler.h"
@@ -438,6 +440,22 @@ void GraphScheduler::Initialize() {
     MS_LOG(INTERNAL_EXCEPTION) << "#dmsg#Runtime error info:#dmsg#Actor manager init failed.";
   }
   default_actor_thread_num_ = actor_thread_num;
+  // Partition the threads per numa node, and the parallel kernels can run on the numa node of the input buffers.
+  if (common::GetEnv("MS_DEV_ENABLE_NUMA_AWARE_THREAD_POOL") == "1") {
+    SetNumaTopology();
+  }
+  // The idle threads steal the task splits of the parallel kernels from the busy threads.
+  if (common::GetEnv("MS_DEV_ENABLE_WORK_STEALING") == "1") {
+    auto thread_pool = actor_manager->GetActorThreadPool();
+    MS_EXCEPTION_IF_NULL(thread_pool);
+    thread_pool->SetWorkStealing(true);
+  }
+  // The ready actors run in the order of the critical path priorities which are set in the actor set optimizing.
+  if (common::GetEnv(kEnvEnableCriticalPathScheduling) == "1") {
+    auto thread_pool = actor_manager->GetActorThreadPool();
+    MS_EXCEPTION_IF_NULL(thread_pool);
+    thread_pool->SetPriorityScheduling(true);
+  }
   common::SetOMPThreadNum();
   MS_LOG(INFO) << "The actor thread number: " << actor_thread_num
                << ", the kernel thread number: " << (actor_and_kernel_thread_num - actor_thread_num);
@@ -748,6 +766,11 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<std::vecto
   }
 #endif
 
+  // Clear the gradients left in the buckets by the last failed step.
+  if (actor_set->gradient_bucket_group_ != nullptr) {
+    actor_set->gradient_bucket_group_->Reset();
+  }
+
   // Construct OpContext.
   OpContext<DeviceTensor> op_context;
   std::vector<Promise<int>> result(1);
@@ -829,6 +852,11 @@ void GraphScheduler::ChildAfterFork() {
     actor_manager->ResetActorAfterFork(KernelAsyncLaunchActor::GetInstance());
   }
 
+  if (already_spawn_gradient_bucket_actor_) {
+    already_spawn_gradient_bucket_actor_ = false;
+    actor_manager->ResetActorAfterFork(GradientBucketActor::GetInstance());
+  }
+
   MS_LOG(DEBUG) << "GraphScheduler reinitialize after fork done.";
 }
 
@@ -941,6 +969,7 @@ ActorSetPtr GraphScheduler::Build(const GraphCompilerInfo &graph_compiler_info)
     BuildDataPrepareActor(graph_compiler_info, actor_set->data_source_actors_, host_queue);
   actor_set->control_actors_ = control_node_scheduler_.Build(graph_compiler_info, memory_manager_aid_);
   actor_set->swap_actors_ = swap_node_scheduler_.Build(graph_compiler_info, recorder_aid_);
+  BuildGradientBucket(actor_set.get(), graph_compiler_info);
 
 #ifdef ENABLE_RPC_ACTOR
   MS_EXCEPTION_IF_NULL(rpc_node_scheduler_);
@@ -1106,6 +1135,11 @@ void GraphScheduler::Link(ActorSet *actor_set, const GraphCompilerInfo &graph_co
       std::vector<CNodePtr> communication_nodes;
       const auto &group_name = (parser->IsInited() ? parser->FetchGroupNameByKernelGraph(graph) : default_group_name);
       LinkDataArrowInNonSinkMode(graph, graph_compiler_info, &auto_monad_actors, &communication_nodes);
+      // The order of communication nodes in the gradient buckets is guaranteed by the gradient bucket actor instead,
+      // and linking them by the execution order would prevent the buckets from being filled.
+      if (actor_set->gradient_bucket_group_ != nullptr) {
+        continue;
+      }
       (void)group_name_to_communication_nodes[group_name].first.insert(
         group_name_to_communication_nodes[group_name].first.end(), communication_nodes.begin(),
         communication_nodes.end());
@@ -1152,6 +1186,9 @@ void GraphScheduler::Optimize(const ActorSetPtr &actor_set) const {
     optimizer->AddPass(std::make_shared<MultiActorFusion>());
   }
   optimizer->AddPass(std::make_shared<BatchDataArrowFusion>());
+  if (common::GetEnv(kEnvEnableCriticalPathScheduling) == "1") {
+    optimizer->AddPass(std::make_shared<CriticalPathPriority>());
+  }
   optimizer->Optimize(actor_set);
   any_type_graph_scheduler_.Optimize(actor_set, graph_output_to_actor_);
 }
@@ -1494,6 +1531,140 @@ std::vector<AbstractActorPtr> GraphScheduler::BuildNoInputKernelActor(const Acto
   return no_input_kernel_actors;
 }
 
+namespace {
+// Whether the kernel actor is the gradient AllReduce which can be fused into the gradient bucket at runtime, the
+// gradient AllReduce is marked with a positive fusion id by the frontend allreduce fusion pass.
+bool IsGradientBucketCandidate(const KernelActorPtr &kernel_actor) {
+  MS_EXCEPTION_IF_NULL(kernel_actor);
+  const auto &kernel = kernel_actor->kernel();
+  MS_EXCEPTION_IF_NULL(kernel);
+  if ((common::AnfAlgo::GetCNodeName(kernel) != kAllReduceOpName) || kernel_actor->is_launch_skipped() ||
+      kernel_actor->is_dynamic_shape() || IsSkippedLaunch(kernel, nullptr)) {
+    return false;
+  }
+  if ((common::AnfAlgo::GetInputTensorNum(kernel) != 1) || (AnfAlgo::GetOutputTensorNum(kernel) != 1) ||
+      (AnfAlgo::GetInputDeviceDataType(kernel, 0) != kNumberTypeFloat32)) {
+    return false;
+  }
+  return common::AnfAlgo::HasNodeAttr(kAttrFusion, kernel) &&
+         (common::AnfAlgo::GetNodeAttr<int64_t>(kernel, kAttrFusion) > 0);
+}
+
+// Collect the gradient infos of the candidate kernel actors in the execution order. The depend position is propagated
+// through all the nodes of graph including the monad ones, because they are linked by the control arrows.
+std::vector<GradientInfo> CollectGradientInfos(const KernelGraphPtr &graph,
+                                               const mindspore::HashMap<AnfNodePtr, KernelActorPtr> &candidates) {
+  MS_EXCEPTION_IF_NULL(graph);
+  mindspore::HashMap<AnfNodePtr, int64_t> positions;
+  const auto &execution_order = graph->execution_order();
+  for (size_t i = 0; i < execution_order.size(); ++i) {
+    if (candidates.count(execution_order[i]) > 0) {
+      positions[execution_order[i]] = SizeToLong(i);
+    }
+  }
+
+  mindspore::HashMap<AnfNodePtr, int64_t> depend_positions;
+  std::vector<GradientInfo> gradient_infos;
+  for (const auto &node : TopoSort(graph->get_return())) {
+    MS_EXCEPTION_IF_NULL(node);
+    if (!node->isa<CNode>()) {
+      continue;
+    }
+    int64_t depend_position = -1;
+    for (const auto &input : node->cast<CNodePtr>()->inputs()) {
+      auto iter = depend_positions.find(input);
+      if (iter != depend_positions.end()) {
+        depend_position = std::max(depend_position, iter->second);
+      }
+    }
+    auto position_iter = positions.find(node);
+    if (position_iter == positions.end()) {
+      depend_positions[node] = depend_position;
+      continue;
+    }
+    depend_positions[node] = std::max(depend_position, position_iter->second);
+    (void)gradient_infos.emplace_back(
+      GradientInfo{position_iter->second, AnfAlgo::GetOutputTensorMemSize(node, 0),
+                   common::AnfAlgo::GetNodeAttr<int64_t>(node, kAttrFusion), depend_position});
+  }
+  std::sort(gradient_infos.begin(), gradient_infos.end(),
+            [](const GradientInfo &a, const GradientInfo &b) { return a.position < b.position; });
+  return gradient_infos;
+}
+}  // namespace
+
+void GraphScheduler::BuildGradientBucket(ActorSet *const actor_set, const GraphCompilerInfo &graph_compiler_info) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  auto bucket_size = GetGradientBucketSize();
+  if (bucket_size == 0) {
+    return;
+  }
+  // The buckets are launched in a fixed order, which requires that each gradient AllReduce runs once in every step and
+  // that there are no control arrows between them by the execution order.
+  const auto &parser = graph_compiler_info.control_node_parser_;
+  if ((graph_compiler_info.strategy_ != GraphExecutionStrategy::kPipeline) || execution_order_running_ ||
+      (graph_compiler_info.graphs_.size() != 1) || (parser != nullptr && parser->IsInited()) ||
+      (debug_aid_ != nullptr)) {
+    MS_LOG(INFO) << "The gradient bucket is not supported by the actor set: " << actor_set->name_;
+    return;
+  }
+  const auto &graph = graph_compiler_info.graphs_[0];
+  MS_EXCEPTION_IF_NULL(graph);
+  if (graph->is_dynamic_shape() || graph->is_graph_run_mode()) {
+    return;
+  }
+
+  mindspore::HashMap<AnfNodePtr, KernelActorPtr> candidates;
+  for (const auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    MS_EXCEPTION_IF_NULL(kernel_actor->device_contexts_[0]);
+    if ((kernel_actor->device_contexts_[0]->device_context_key().device_name_ == kCPUDevice) &&
+        IsGradientBucketCandidate(kernel_actor)) {
+      candidates[kernel_actor->kernel()] = kernel_actor;
+    }
+  }
+  // The other communication kernels running concurrently with the buckets would break the order of collectives.
+  for (const auto &kernel : graph->execution_order()) {
+    if (common::AnfAlgo::IsCommunicationOp(kernel) && (candidates.count(kernel) == 0)) {
+      MS_LOG(INFO) << "The communication kernel " << kernel->fullname_with_scope()
+                   << " can't be fused into the gradient bucket, and the gradient bucket is disabled for the graph "
+                   << graph->graph_id();
+      return;
+    }
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  const auto &gradient_infos = CollectGradientInfos(graph, candidates);
+  const auto &execution_order = graph->execution_order();
+  auto group = std::make_shared<GradientBucketGroup>();
+  for (const auto &bucket_indexes : PartitionGradientBuckets(gradient_infos, bucket_size)) {
+    auto bucket = std::make_shared<GradientBucket>(group->buckets_.size(), group.get());
+    for (auto index : bucket_indexes) {
+      const auto &kernel_actor = candidates[execution_order[LongToSize(gradient_infos[index].position)]];
+      MS_EXCEPTION_IF_NULL(kernel_actor);
+      kernel_actor->gradient_bucket_ = bucket.get();
+      (void)bucket->members_.emplace_back(kernel_actor.get());
+      (void)bucket->offsets_.emplace_back(bucket->size_);
+      bucket->size_ += gradient_infos[index].size;
+    }
+    MS_LOG(INFO) << "Build " << bucket->name_ << " for graph " << graph->graph_id()
+                 << ", gradient num: " << bucket->members_.size() << ", size: " << bucket->size_;
+    (void)group->buckets_.emplace_back(bucket);
+  }
+  actor_set->gradient_bucket_group_ = group;
+
+  if (!already_spawn_gradient_bucket_actor_) {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    MS_EXCEPTION_IF_NULL(actor_manager);
+    auto &gradient_bucket_actor = GradientBucketActor::GetInstance();
+    MS_EXCEPTION_IF_NULL(gradient_bucket_actor);
+    (void)actor_manager->Spawn(gradient_bucket_actor, false);
+    already_spawn_gradient_bucket_actor_ = true;
+  }
+}
+
 KernelActorPtr GraphScheduler::GenerateRpcActor(const CNodePtr &kernel, const DeviceContext *device_context,
                                                 GraphExecutionStrategy strategy,
                                                 const std::set<size_t> &ref_input_indexes,
@@ -3070,6 +3241,31 @@ void GraphScheduler::BindNumaNode() {
 #endif
 }
 
+void GraphScheduler::SetNumaTopology() {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__) && !defined(ENABLE_ANDROID)
+  if (numa_handle_ == nullptr) {
+    numa_handle_ = GetNumaAdapterHandle();
+    if (numa_handle_ == nullptr) {
+      MS_LOG(WARNING) << "Load numa library failed, the thread pool is not numa aware.";
+      return;
+    }
+  }
+  std::vector<std::vector<int>> numa_nodes_cpus;
+  auto ret = LoadNumaNodesCpuInfo(numa_handle_.get(), &numa_nodes_cpus);
+  if (ret != StatusCode::kSuccess || numa_nodes_cpus.size() <= 1) {
+    MS_LOG(INFO) << "There is no more than one numa node, the thread pool is not numa aware.";
+    return;
+  }
+  auto thread_pool = ActorMgr::GetActorMgrRef()->GetActorThreadPool();
+  MS_EXCEPTION_IF_NULL(thread_pool);
+  if (thread_pool->SetNumaTopology(numa_nodes_cpus) != THREAD_OK) {
+    MS_LOG(WARNING) << "Set the numa topology of the thread pool failed.";
+    return;
+  }
+  MS_LOG(INFO) << "The thread pool is partitioned to " << numa_nodes_cpus.size() << " numa nodes.";
+#endif
+}
+
 #ifdef ENABLE_RPC_ACTOR
 bool GraphScheduler::HaveRpcActors(const ActorSet *actor_set) const {
   MS_EXCEPTION_IF_NULL(actor_set);
@@ -127,6 +127,8 @@ class BACKEND_EXPORT GraphScheduler {
                                             const HostTensorQueuePtr &host_queue);
   std::vector<AbstractActorPtr> BuildNoInputKernelActor(const ActorSet *actor_set,
                                                         GraphExecutionStrategy strategy) const;
+  // Fuse the gradient AllReduce kernel actors into the size bounded buckets which are launched by GradientBucketActor.
+  void BuildGradientBucket(ActorSet *const actor_set, const GraphCompilerInfo &graph_compiler_info);
 
   // Generate rpc actor object inherited from kernel actor.
   KernelActorPtr GenerateRpcActor(const CNodePtr &kernel, const DeviceContext *device_context,
@@ -231,6 +233,8 @@ class BACKEND_EXPORT GraphScheduler {
   void DumpFinalActor(const ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info);
   // bind thread pool to same numa node
   void BindNumaNode();
+  // partition the threads of thread pool per numa node
+  void SetNumaTopology();
 
   // Refresh the context and thread pool before run model.
   void RefreshContextAndThreadPool(ActorSet *const actor_set, ActorThreadPool *const thread_pool);
@@ -286,6 +290,7 @@ class BACKEND_EXPORT GraphScheduler {
   bool init_{false};
   bool already_spawn_kernel_async_launch_actor_{false};
   bool already_spawn_kernel_async_infer_resize_actor_{false};
+  bool already_spawn_gradient_bucket_actor_{false};
 };
 }  // namespace runtime
 }  // namespace mindspore
@@ -27,6 +27,7 @@
 #include "include/backend/distributed/collective/collective_manager.h"
 #include "include/common/utils/comm_manager.h"
 #include "runtime/device/gsm/swap_strategy_builder.h"
+#include "runtime/device/gsm/mem_budget_planner.h"
 #include "runtime/device/memory_offload_strategy.h"
 #include "runtime/graph_scheduler/scheduler_helper.h"
 #include "runtime/graph_scheduler/control_node_parser.h"
@@ -134,6 +135,30 @@ std::map<size_t, size_t> GetActionTensors(const std::shared_ptr<device::SwapActi
   return tensor_indexes;
 }
 
+mindspore::HashMap<DeviceTensor *, CNodePtr> GetRecomputeKernels(
+  const std::shared_ptr<device::SwapAction> &swap_action, const std::shared_ptr<device::SwapStrategy> &swap_strategy) {
+  MS_EXCEPTION_IF_NULL(swap_action);
+  MS_EXCEPTION_IF_NULL(swap_strategy);
+  mindspore::HashMap<DeviceTensor *, CNodePtr> recompute_kernels;
+  for (const auto &tensor_action : swap_action->actions_) {
+    MS_EXCEPTION_IF_NULL(tensor_action);
+    if (tensor_action->action_ != device::SwapActionType::kRecompute) {
+      continue;
+    }
+    if (tensor_action->tensor_id_ >= swap_strategy->tensor_infos_.size()) {
+      MS_LOG(EXCEPTION) << "Invalid tensor id " << tensor_action->tensor_id_;
+    }
+    const auto &tensor_info = swap_strategy->tensor_infos_[tensor_action->tensor_id_];
+    MS_EXCEPTION_IF_NULL(tensor_info);
+    MS_EXCEPTION_IF_NULL(tensor_info->node_);
+    const auto &kernel = tensor_info->node_->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(kernel);
+    const auto &output_addr = AnfAlgo::GetMutableOutputAddr(kernel, tensor_info->index_, false);
+    recompute_kernels[output_addr.get()] = kernel;
+  }
+  return recompute_kernels;
+}
+
 void GenActionIndexList(const std::map<size_t, size_t> &tensors_id_index_map,
                         const std::shared_ptr<device::SwapAction> &swap_action,
                         const std::shared_ptr<device::SwapStrategy> &swap_strategy,
@@ -199,6 +224,7 @@ std::shared_ptr<device::SwapContext> GetSwapContext() {
     swap_context->offload_checkpoint_to_cpu_ = (offload_checkpoint == kOffloadTargetCPU);
     swap_context->offload_checkpoint_to_disk_ = (offload_checkpoint == kOffloadTargetDisk);
   }
+  swap_context->enable_budget_plan_ = (common::GetEnv(device::kEnvEnableMemBudgetPlan) == "1");
   return swap_context;
 }
 }  // namespace
@@ -302,6 +328,7 @@ void MemSwapScheduler::BuildSwapActorForGraph(const KernelGraphPtr &graph, const
   MS_EXCEPTION_IF_NULL(parser);
   MS_EXCEPTION_IF_NULL(device_context);
   MS_EXCEPTION_IF_NULL(actors);
+  // The cpu memory can't be swapped, so the budget plan is not built for the graph of cpu either.
   if (graph->is_dynamic_shape() || device_context->GetDeviceType() == device::DeviceType::kCPU) {
     return;
   }
@@ -335,6 +362,7 @@ void MemSwapScheduler::BuildSwapActorForGraph(const KernelGraphPtr &graph, const
     const string swap_actor_name = kMemSwapActorNamePrefix + std::to_string(swap_actor_num++);
     auto swap_actor = std::make_shared<MemorySwapActor>(swap_actor_name, recorder_aid_, kDefaultStreamIndex,
                                                         fixed_device_address, device_context, actor_actions);
+    swap_actor->set_recompute_kernels(GetRecomputeKernels(iter.second, swap_strategy));
     (void)actors->emplace_back(swap_actor);
     // Link data arrow from EntranceActor to MemorySwapActor later in Link
     data_dependency_[graph_id][swap_actor].swap(real_parameter_index);
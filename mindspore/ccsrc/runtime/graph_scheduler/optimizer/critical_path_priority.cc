@@ -0,0 +1,159 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/optimizer/critical_path_priority.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include "runtime/graph_scheduler/scheduler_helper.h"
+#include "runtime/graph_scheduler/actor/kernel_actor.h"
+#include "include/backend/anf_runtime_algorithm.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The memory size of one cost unit, and every actor costs one unit at least for the message passing.
+constexpr size_t kCostUnitBytes = 1024;
+
+int64_t EstimateActorCost(const AbstractActor *actor) {
+  MS_EXCEPTION_IF_NULL(actor);
+  if (actor->type() != KernelTransformType::kKernelActor) {
+    return 1;
+  }
+  const auto &kernel_actor = dynamic_cast<const KernelActor *>(actor);
+  MS_EXCEPTION_IF_NULL(kernel_actor);
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel_actor->kernel());
+  if (kernel_mod == nullptr) {
+    return 1;
+  }
+  const auto &input_sizes = kernel_mod->GetInputSizeList();
+  const auto &output_sizes = kernel_mod->GetOutputSizeList();
+  size_t bytes = std::accumulate(input_sizes.begin(), input_sizes.end(), static_cast<size_t>(0)) +
+                 std::accumulate(output_sizes.begin(), output_sizes.end(), static_cast<size_t>(0));
+  return 1 + SizeToLong(bytes / kCostUnitBytes);
+}
+}  // namespace
+
+std::vector<int64_t> ComputeCriticalPathPriorities(const std::vector<std::vector<size_t>> &successors,
+                                                   const std::vector<int64_t> &costs) {
+  if (successors.size() != costs.size()) {
+    MS_LOG(EXCEPTION) << "The size of successors " << successors.size() << " is not equal to the size of costs "
+                      << costs.size();
+  }
+  enum class VisitState { kUnvisited, kVisiting, kVisited };
+  std::vector<VisitState> states(costs.size(), VisitState::kUnvisited);
+  std::vector<int64_t> priorities(costs.size(), 0);
+
+  // Visit the nodes in post order by the explicit stack of (node, next successor position) to support the long paths.
+  std::vector<std::pair<size_t, size_t>> stack;
+  for (size_t root = 0; root < costs.size(); ++root) {
+    if (states[root] != VisitState::kUnvisited) {
+      continue;
+    }
+    states[root] = VisitState::kVisiting;
+    (void)stack.emplace_back(root, 0);
+    while (!stack.empty()) {
+      auto node = stack.back().first;
+      auto &next_position = stack.back().second;
+      if (next_position < successors[node].size()) {
+        auto successor = successors[node][next_position++];
+        if (successor >= costs.size()) {
+          MS_LOG(EXCEPTION) << "The successor " << successor << " of node " << node << " is out of range "
+                            << costs.size();
+        }
+        // The successor in visiting is in the cycle and the edge to it is ignored.
+        if (states[successor] == VisitState::kUnvisited) {
+          states[successor] = VisitState::kVisiting;
+          (void)stack.emplace_back(successor, 0);
+        }
+        continue;
+      }
+
+      int64_t max_successor_priority = 0;
+      for (auto successor : successors[node]) {
+        if (states[successor] == VisitState::kVisited) {
+          max_successor_priority = std::max(max_successor_priority, priorities[successor]);
+        }
+      }
+      priorities[node] = costs[node] + max_successor_priority;
+      states[node] = VisitState::kVisited;
+      stack.pop_back();
+    }
+  }
+  return priorities;
+}
+
+void CriticalPathPriority::Process(ActorSet *const actor_set, AbstractActor *const) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  auto actors = SchedulerHelper::CollectActors(actor_set);
+
+  // The fused actors are represented by their fusion actor in the graph of priorities.
+  mindspore::HashMap<const AbstractActor *, size_t> actor_to_index;
+  std::vector<AbstractActor *> nodes;
+  for (const auto &actor : actors) {
+    MS_EXCEPTION_IF_NULL(actor);
+    if (actor->parent_fusion_actor() == nullptr) {
+      actor_to_index[actor.get()] = nodes.size();
+      (void)nodes.emplace_back(actor.get());
+    }
+  }
+  std::vector<int64_t> costs(nodes.size(), 0);
+  auto fetch_index = [&actor_to_index](const AbstractActor *actor) {
+    if (actor != nullptr && actor->parent_fusion_actor() != nullptr) {
+      actor = actor->parent_fusion_actor();
+    }
+    const auto &iter = actor_to_index.find(actor);
+    return iter == actor_to_index.end() ? SIZE_MAX : iter->second;
+  };
+  for (const auto &actor : actors) {
+    auto index = fetch_index(actor.get());
+    if (index != SIZE_MAX && actor->type() != KernelTransformType::kFusionActor) {
+      costs[index] += EstimateActorCost(actor.get());
+    }
+  }
+
+  std::vector<std::vector<size_t>> successors(nodes.size());
+  auto add_successor = [&](const AbstractActorPtr &from_actor, const AID &to_op_id) {
+    auto from_index = fetch_index(from_actor.get());
+    auto to_index = fetch_index(FetchActor(to_op_id.Name()));
+    if (from_index != SIZE_MAX && to_index != SIZE_MAX && from_index != to_index) {
+      (void)successors[from_index].emplace_back(to_index);
+    }
+  };
+  for (const auto &actor : actors) {
+    for (const auto &data_arrow : actor->output_data_arrows()) {
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      add_successor(actor, data_arrow->to_op_id_);
+    }
+    for (const auto &control_arrow : actor->output_control_arrows()) {
+      MS_EXCEPTION_IF_NULL(control_arrow);
+      add_successor(actor, control_arrow->to_op_id_);
+    }
+  }
+
+  auto priorities = ComputeCriticalPathPriorities(successors, costs);
+  for (const auto &actor : actors) {
+    auto index = fetch_index(actor.get());
+    if (index != SIZE_MAX) {
+      actor->set_priority(priorities[index]);
+    }
+  }
+  MS_LOG(INFO) << "The critical path priorities of actor set " << actor_set->name_ << " are set, actor num: "
+               << nodes.size() << ", max priority: "
+               << (priorities.empty() ? 0 : *std::max_element(priorities.begin(), priorities.end()));
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_CRITICAL_PATH_PRIORITY_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_CRITICAL_PATH_PRIORITY_H_
+
+#include <vector>
+#include <memory>
+#include "runtime/graph_scheduler/optimizer/optimizer.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace runtime {
+// The environment variable to enable the critical path scheduling of actors. The actor thread pool runs the ready
+// actors in the order of the priorities computed by the CriticalPathPriority pass instead of fifo.
+constexpr char kEnvEnableCriticalPathScheduling[] = "MS_DEV_ENABLE_CRITICAL_PATH_SCHEDULING";
+
+// Compute the priority of each node as the length of the longest path from the node to the end, which is the sum of
+// the costs of nodes in the path. The edges which form the cycles, like the loop from the loop count actor to the data
+// prepare actor, are ignored.
+BACKEND_EXPORT std::vector<int64_t> ComputeCriticalPathPriorities(const std::vector<std::vector<size_t>> &successors,
+                                                                  const std::vector<int64_t> &costs);
+
+// Set the static priorities of actors by the critical path, so that the actors in the long critical path don't wait
+// behind the cheap side branches. The cost of kernel actor is estimated by the memory size it reads and writes, and the
+// fused actors share the priority of their fusion actor which is spawned to run them.
+class CriticalPathPriority : public ActorPass {
+ public:
+  CriticalPathPriority() : ActorPass("critical_path_priority", false) {}
+  ~CriticalPathPriority() override = default;
+
+ protected:
+  void Process(ActorSet *const actor_set, AbstractActor *const actor) override;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_OPTIMIZER_CRITICAL_PATH_PRIORITY_H_
@@ -24,6 +24,13 @@ namespace runtime {
 namespace {
 bool SupportFusion(const AbstractActorPtr &actor) {
   MS_EXCEPTION_IF_NULL(actor);
+  // The kernel actor in the gradient bucket is called back by the gradient bucket actor, so it must be spawned alone.
+  if (actor->type() == KernelTransformType::kKernelActor) {
+    const auto &kernel_actor = dynamic_cast<KernelActor *>(actor.get());
+    if ((kernel_actor != nullptr) && (kernel_actor->gradient_bucket() != nullptr)) {
+      return false;
+    }
+  }
   if ((actor->type() == KernelTransformType::kDeviceDataSourceActor) ||
       (actor->type() == KernelTransformType::kHostDataSourceActor) ||
       (actor->type() == KernelTransformType::kKernelActor) ||
@@ -117,5 +117,6 @@ void CompileCacheContext::Clear() {
   front_graph_to_backend_graph_cache_path_.clear();
   backend_param_gen_from_frontend_param_.clear();
   restricted_scenarios_ = false;
+  front_graph_cache_hash_.clear();
 }
 }  // namespace mindspore
@@ -81,6 +81,11 @@ class MS_CORE_API ActorBase {
 
   void set_thread_pool(ActorThreadPool *pool) { pool_ = pool; }
 
+  // The static priority of actor, the ready actors with higher priority run first if the priority scheduling of actor
+  // thread pool is enabled.
+  void set_priority(int64_t priority) { priority_ = priority; }
+  int64_t priority() const { return priority_; }
+
   // Judge if actor running by the received message number, the default is true.
   virtual bool IsActive(int msg_num) { return true; }
 
@@ -215,6 +220,7 @@ class MS_CORE_API ActorBase {
   uint32_t recordNextPoint = 0;
 
   ActorThreadPool *pool_{nullptr};
+  int64_t priority_{0};
   std::shared_ptr<ActorMgr> actor_mgr_;
 };
 using ActorReference = std::shared_ptr<ActorBase>;
@@ -24,6 +24,14 @@
 namespace mindspore {
 size_t ActorThreadPool::actor_queue_size_ = kMaxHqueueSize;
 
+namespace {
+// the pool whose actor is running on the current actor thread, and the ready actor to run inline after it
+thread_local ActorThreadPool *running_pool = nullptr;
+thread_local ActorBase *inline_actor = nullptr;
+// the number of the actors made ready by the running actor, only the single ready successor runs inline
+thread_local size_t ready_successor_num = 0;
+}  // namespace
+
 void ActorWorker::CreateThread() { thread_ = std::make_unique<std::thread>(&ActorWorker::RunWithSpin, this); }
 
 void ActorWorker::RunWithSpin() {
@@ -40,8 +48,8 @@ void ActorWorker::RunWithSpin() {
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
   while (alive_) {
-    // only run either local KernelTask or PoolQueue ActorTask
-    if (RunLocalKernelTask() || RunQueueActorTask()) {
+    // only run either local KernelTask or PoolQueue ActorTask, steal KernelTask when both are empty
+    if (RunLocalKernelTask() || RunQueueActorTask() || StealKernelTask()) {
       spin_count_ = 0;
     } else {
       YieldAndDeactive();
@@ -57,12 +65,23 @@ bool ActorWorker::RunQueueActorTask() {
   if (pool_ == nullptr) {
     return false;
   }
-  auto actor = reinterpret_cast<ActorThreadPool *>(pool_)->PopActorFromQueue();
+  auto pool = reinterpret_cast<ActorThreadPool *>(pool_);
+  auto actor = pool->PopActorFromQueue();
   if (actor == nullptr) {
     return false;
   }
 
+  running_pool = pool;
+  ready_successor_num = 0;
   actor->Run();
+  // run the chain of single ready successors one after another, which skips the queue and the wake up
+  while (inline_actor != nullptr) {
+    auto next_actor = inline_actor;
+    inline_actor = nullptr;
+    ready_successor_num = 0;
+    next_actor->Run();
+  }
+  running_pool = nullptr;
   return true;
 }
 
@@ -86,10 +105,10 @@ ActorThreadPool::~ActorThreadPool() {
   do {
     {
 #ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
+      terminate = actor_queue_.Empty() && priority_actor_num_.load() == 0;
 #else
       std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
+      terminate = actor_queue_.empty() && priority_actor_num_.load() == 0;
 #endif
     }
     if (!terminate) {
@@ -110,24 +129,75 @@ ActorThreadPool::~ActorThreadPool() {
 }
 
 ActorBase *ActorThreadPool::PopActorFromQueue() {
+  // the actors without priority are the global service actors like the memory manager, which unblock the others
+  ActorBase *actor = nullptr;
 #ifdef USE_HQUEUE
-  return actor_queue_.Dequeue();
+  actor = actor_queue_.Dequeue();
 #else
-  std::lock_guard<std::mutex> _l(actor_mutex_);
-  if (actor_queue_.empty()) {
+  {
+    std::lock_guard<std::mutex> _l(actor_mutex_);
+    if (!actor_queue_.empty()) {
+      actor = actor_queue_.front();
+      actor_queue_.pop();
+    }
+  }
+#endif
+  if (actor != nullptr || priority_actor_num_.load(std::memory_order_acquire) == 0) {
+    return actor;
+  }
+  std::lock_guard<std::mutex> _l(priority_mutex_);
+  if (priority_queue_.empty()) {
     return nullptr;
   }
-  auto actor = actor_queue_.front();
-  actor_queue_.pop();
+  actor = priority_queue_.top().actor_;
+  priority_queue_.pop();
+  if (!priority_queue_.empty()) {
+    top_priority_.store(priority_queue_.top().priority_, std::memory_order_release);
+  }
+  priority_actor_num_.fetch_sub(1, std::memory_order_release);
   return actor;
-#endif
+}
+
+bool ActorThreadPool::TryRunInline(ActorBase *actor) {
+  if (running_pool != this) {
+    return false;
+  }
+  if (++ready_successor_num > 1) {
+    // the running actor fans out, the successors are not a chain and are all scheduled by the queue
+    if (inline_actor != nullptr) {
+      auto held_actor = inline_actor;
+      inline_actor = nullptr;
+      EnqueueActor(held_actor);
+    }
+    return false;
+  }
+  // the queued actor with higher priority should run first
+  if (priority_actor_num_.load(std::memory_order_acquire) > 0 &&
+      top_priority_.load(std::memory_order_acquire) > actor->priority()) {
+    return false;
+  }
+  inline_actor = actor;
+  return true;
 }
 
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
+  if (priority_scheduling() && TryRunInline(actor)) {
+    THREAD_DEBUG("actor[%s] runs inline", actor->GetAID().Name().c_str());
+    return;
+  }
+  EnqueueActor(actor);
+}
+
+void ActorThreadPool::EnqueueActor(ActorBase *actor) {
+  if (priority_scheduling() && actor->priority() > 0) {
+    std::lock_guard<std::mutex> _l(priority_mutex_);
+    priority_queue_.push({actor->priority(), priority_sequence_++, actor});
+    top_priority_.store(priority_queue_.top().priority_, std::memory_order_release);
+    priority_actor_num_.fetch_add(1, std::memory_order_release);
+  } else {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
     }
@@ -84,6 +84,12 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
   virtual void PushActorToQueue(ActorBase *actor);
   virtual ActorBase *PopActorFromQueue();
 
+  // enable the ready actors with positive priority to run in the order of priority instead of fifo, and the actor
+  // thread runs the successor inline if it is the only actor made ready by the finished actor and no queued actor
+  // has higher priority
+  void SetPriorityScheduling(bool enable) { priority_scheduling_.store(enable, std::memory_order_release); }
+  bool priority_scheduling() const { return priority_scheduling_.load(std::memory_order_acquire); }
+
  protected:
   ActorThreadPool() = default;
 
@@ -95,8 +101,29 @@ class MS_CORE_API ActorThreadPool : public ThreadPool {
   std::queue<ActorBase *> actor_queue_;
 #endif
 
+  // the ready actor in the priority queue, the actors with the same priority keep the fifo order by the sequence
+  struct PriorityActor {
+    int64_t priority_;
+    uint64_t sequence_;
+    ActorBase *actor_;
+    bool operator<(const PriorityActor &other) const {
+      return priority_ < other.priority_ || (priority_ == other.priority_ && sequence_ > other.sequence_);
+    }
+  };
+  std::mutex priority_mutex_;
+  std::priority_queue<PriorityActor> priority_queue_;
+  uint64_t priority_sequence_{0};
+  std::atomic_size_t priority_actor_num_{0};
+  // the highest priority in the priority queue, only valid when priority_actor_num_ is not zero
+  std::atomic<int64_t> top_priority_{0};
+  std::atomic_bool priority_scheduling_{false};
+
  private:
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  // keep the actor in the inline slot of the current actor thread, returns false if it should be queued
+  bool TryRunInline(ActorBase *actor);
+  // push the actor to the priority queue or the fifo queue and wake up an idle actor thread
+  void EnqueueActor(ActorBase *actor);
 
   // Support to set the size of actor queue.
   static size_t actor_queue_size_;
@@ -453,6 +453,30 @@ int CoreAffinity::BindThreads(const std::vector<Worker *> &workers, BindMode bin
   }
 }
 
+int CoreAffinity::BindThreadsToNumaNodes(const std::vector<Worker *> &workers,
+                                         const std::vector<std::vector<int>> &numa_node_cpus) {
+#ifdef _WIN32
+  return THREAD_OK;
+#elif defined(BIND_CORE)
+  for (auto worker : workers) {
+    if (worker->bind_core() >= 0 || worker->numa_node() < 0 ||
+        static_cast<size_t>(worker->numa_node()) >= numa_node_cpus.size()) {
+      continue;
+    }
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int i : numa_node_cpus[worker->numa_node()]) {
+      CPU_SET(i, &mask);
+    }
+    int ret = SetAffinity(worker->handle(), &mask);
+    if (ret != THREAD_OK) {
+      return THREAD_ERROR;
+    }
+  }
+#endif  // BIND_CORE
+  return THREAD_OK;
+}
+
 int CoreAffinity::BindThreads(const std::vector<Worker *> &workers, const std::vector<int> &core_list) {
   // the size of core_list doesn't have to be the same as the size of workers(thread_num)
   bind_id_ = core_list;
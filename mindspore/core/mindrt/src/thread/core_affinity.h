@@ -59,6 +59,8 @@ class CoreAffinity {
 
   int BindThreads(const std::vector<Worker *> &workers, const std::vector<int> &core_list);
   int BindThreads(const std::vector<Worker *> &workers, BindMode bind_mode);
+  // bind the workers which are not bound to a core to all the cpus of their numa nodes
+  int BindThreadsToNumaNodes(const std::vector<Worker *> &workers, const std::vector<std::vector<int>> &numa_node_cpus);
   int BindProcess(BindMode bind_mode);
   std::vector<int> GetCoreId(size_t thread_num, BindMode bind_mode) const;
   void SetCoreId(const std::vector<int> &core_list);
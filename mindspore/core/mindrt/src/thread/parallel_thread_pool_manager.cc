@@ -24,6 +24,7 @@ namespace {
 const char *kInnerModelParallelRunner = "inner_model_parallel_runner";
 const char *kInnerRunnerID = "inner_runner_id";
 const char *kInnerModelID = "inner_model_id";
+const char *kInnerNumaID = "inner_numa_id";
 }  // namespace
 ParallelThreadPoolManager *ParallelThreadPoolManager::GetInstance() {
   static ParallelThreadPoolManager instance;
@@ -131,6 +132,12 @@ void ParallelThreadPoolManager::BindPoolToRunner(
     return;
   }
   runner_id_pools_[runner_id].at(model_id) = parallel_pool;
+  int numa_node = -1;
+  auto item_numa = it_id->second.find(kInnerNumaID);
+  if (item_numa != it_id->second.end()) {
+    numa_node = std::atoi(item_numa->second.c_str());
+  }
+  pool_numa_node_[parallel_pool] = numa_node;
   auto all_workers = parallel_pool->GetParallelPoolWorkers();
   for (size_t i = 0; i < all_workers.size(); i++) {
     auto worker = static_cast<ParallelWorker *>(all_workers[i]);
@@ -197,7 +204,8 @@ void ParallelThreadPoolManager::SetFreePool(const std::string &runner_id, int mo
   }
 }
 
-ParallelThreadPool *ParallelThreadPoolManager::GetIdleThreadPool(const std::string &runner_id, ParallelTask *task) {
+ParallelThreadPool *ParallelThreadPoolManager::GetIdleThreadPool(const std::string &runner_id, ParallelTask *task,
+                                                                 ParallelThreadPool *curr_pool) {
   std::shared_lock<std::shared_mutex> l(pool_manager_mutex_);
   auto runner_worker_num_iter = runner_worker_num_.find(runner_id);
   auto worker_init_num_iter = worker_init_num_.find(runner_id);
@@ -214,9 +222,22 @@ ParallelThreadPool *ParallelThreadPoolManager::GetIdleThreadPool(const std::stri
   if (runner_id_pools_iter == runner_id_pools_.end()) {
     return nullptr;
   }
+  int curr_numa_node = -1;
+  auto curr_numa_node_iter = pool_numa_node_.find(curr_pool);
+  if (curr_numa_node_iter != pool_numa_node_.end()) {
+    curr_numa_node = curr_numa_node_iter->second;
+  }
   auto &all_pools = runner_id_pools_iter->second;
   for (int pool_index = all_pools.size() - 1; pool_index >= 0; pool_index--) {
     auto &pool = all_pools[pool_index];
+    if (curr_numa_node >= 0) {
+      // the input buffers of the task are located on the numa node of the current pool
+      auto pool_numa_node_iter = pool_numa_node_.find(pool);
+      if (pool_numa_node_iter != pool_numa_node_.end() && pool_numa_node_iter->second >= 0 &&
+          pool_numa_node_iter->second != curr_numa_node) {
+        continue;
+      }
+    }
     if (pool->IsIdlePool()) {
       auto pool_workers_iter = pool_workers_.find(pool);
       if (pool_workers_iter == pool_workers_.end()) {
@@ -246,6 +267,7 @@ void ParallelThreadPoolManager::ResetParallelThreadPoolManager(const std::string
   auto pools = runner_id_pools_[runner_id];
   for (auto &pool : pools) {
     pool_workers_.erase(pool);
+    pool_numa_node_.erase(pool);
   }
   runner_id_pools_.erase(runner_id);
   has_idle_pool_.erase(runner_id);
@@ -261,6 +283,7 @@ ParallelThreadPoolManager::~ParallelThreadPoolManager() {
   THREAD_INFO("~ParallelThreadPoolManager start.");
   std::unique_lock<std::shared_mutex> l(pool_manager_mutex_);
   pool_workers_.clear();
+  pool_numa_node_.clear();
   runner_id_pools_.clear();
   has_idle_pool_.clear();
   enable_shared_thread_pool_.clear();
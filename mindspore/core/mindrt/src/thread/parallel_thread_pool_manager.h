@@ -58,7 +58,10 @@ class MS_CORE_API ParallelThreadPoolManager {
 
   int GetTaskNum(const std::map<std::string, std::map<std::string, std::string>> *config_info);
 
-  ParallelThreadPool *GetIdleThreadPool(const std::string &runner_id, ParallelTask *task);
+  // the idle pool on the same numa node as the current pool is preferred, and the pool on the other numa node
+  // is not used to avoid the cross-socket memory access
+  ParallelThreadPool *GetIdleThreadPool(const std::string &runner_id, ParallelTask *task,
+                                        ParallelThreadPool *curr_pool = nullptr);
 
  private:
   ParallelThreadPoolManager() = default;
@@ -68,6 +71,8 @@ class MS_CORE_API ParallelThreadPoolManager {
   std::map<std::string, std::vector<ParallelThreadPool *>> runner_id_pools_;
   // pool sorted by model worker id
   std::unordered_map<ParallelThreadPool *, std::vector<ParallelWorker *>> pool_workers_;
+  // pool <=> numa node id of the model runner
+  std::unordered_map<ParallelThreadPool *, int> pool_numa_node_;
 
   std::shared_mutex pool_manager_mutex_;
   std::map<std::string, bool> has_idle_pool_;
@@ -311,7 +311,7 @@ int ParallelThreadPool::ParallelLaunch(const Func &func, Content content, int ta
       static_cast<ParallelWorker *>(worker)->ActivateByOtherPoolTask();
     }
     if (thread_num_ < task_num) {
-      idle_pool = ParallelThreadPoolManager::GetInstance()->GetIdleThreadPool(bind_runner_id_, p_task);
+      idle_pool = ParallelThreadPoolManager::GetInstance()->GetIdleThreadPool(bind_runner_id_, p_task, this);
     }
   }
 
@@ -17,7 +17,13 @@
 #include <sched.h>
 #include <unistd.h>
 #endif
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/syscall.h>
+#endif
 #include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include "thread/threadpool.h"
 #include "thread/core_affinity.h"
 #if !defined(_WIN32) && !defined(BUILD_LITE)
@@ -27,6 +33,28 @@
 namespace mindspore {
 std::mutex ThreadPool::create_thread_pool_muntex_;
 
+namespace {
+// run the task split with the scales of the worker which it is assigned to
+void RunTaskSplit(TaskSplit *task_split) {
+  auto task = task_split->task_;
+  auto task_id = task_split->task_id_;
+  task->status |= task->func(task->content, task_id, task_split->lhs_scale_, task_split->rhs_scale_);
+  (void)++task->finished;
+}
+
+int FindNumaNodeOfCore(const std::vector<std::vector<int>> &numa_node_cpus, int core) {
+  if (core < 0) {
+    return -1;
+  }
+  for (size_t i = 0; i < numa_node_cpus.size(); ++i) {
+    if (std::find(numa_node_cpus[i].begin(), numa_node_cpus[i].end(), core) != numa_node_cpus[i].end()) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+}  // namespace
+
 Worker::~Worker() {
   {
     std::lock_guard<std::mutex> _l(mutex_);
@@ -102,6 +130,9 @@ void Worker::SetAffinity() {
 
 void Worker::InitWorkerMask(const std::vector<int> &core_list, const size_t workers_size) {
   core_list_ = core_list;
+  if (!core_list.empty()) {
+    bind_core_ = core_list[workers_size % core_list.size()];
+  }
 #ifdef _WIN32
   static uint32_t windows_core_index = 0;
   core_id_ = windows_core_index++;
@@ -133,7 +164,7 @@ void Worker::Run() {
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
   while (alive_) {
-    if (RunLocalKernelTask()) {
+    if (RunLocalKernelTask() || StealKernelTask()) {
       spin_count_ = 0;
     } else {
       RunOtherKernelTask();
@@ -150,13 +181,26 @@ bool Worker::TryRunTask(TaskSplit *task_split) {
   if (task_split == nullptr) {
     return false;
   }
-  auto task = task_split->task_;
-  auto task_id = task_split->task_id_;
-  task->status |= task->func(task->content, task_id, lhs_scale_, rhs_scale_);
-  (void)++task->finished;
+  RunTaskSplit(task_split);
   return true;
 }
 
+bool Worker::StealKernelTask() {
+  if (pool_ == nullptr || !pool_->work_stealing()) {
+    return false;
+  }
+  const auto &task_queues = pool_->task_queues();
+  for (auto index : steal_order_) {
+    if (index >= task_queues.size() || task_queues[index]->Empty()) {
+      continue;
+    }
+    if (TryRunTask(task_queues[index]->Dequeue())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool Worker::RunLocalKernelTask() {
   bool res = false;
   Task *task = task_.load(std::memory_order_consume);
@@ -237,6 +281,8 @@ void Worker::Active(std::vector<TaskSplit> *task_list, int task_id_start, int ta
       to_atomic_task = 1;
     }
     for (int i = task_id_start + to_atomic_task; i < task_id_end; ++i) {
+      (*task_list)[i].lhs_scale_ = lhs_scale_;
+      (*task_list)[i].rhs_scale_ = rhs_scale_;
       while (!local_task_queue_->Enqueue(&(*task_list)[i])) {
       }
     }
@@ -296,6 +342,17 @@ int ThreadPool::TaskQueuesInit(size_t thread_num) {
 }
 
 int ThreadPool::ParallelLaunch(const Func &func, Content content, int task_num) {
+  return LaunchTask(func, content, task_num);
+}
+
+int ThreadPool::ParallelLaunchOnNumaNode(const Func &func, Content content, int task_num, int numa_node) {
+  if (numa_node < 0 || static_cast<size_t>(numa_node) >= numa_node_workers_.size()) {
+    return ParallelLaunch(func, content, task_num);
+  }
+  return LaunchTask(func, content, task_num, numa_node);
+}
+
+int ThreadPool::LaunchTask(const Func &func, Content content, int task_num, int numa_node) {
   // if single thread, run master thread
   if (task_num <= 1) {
     return SyncRunFunc(func, content, 0, task_num);
@@ -310,13 +367,17 @@ int ThreadPool::ParallelLaunch(const Func &func, Content content, int task_num)
     (void)task_list.emplace_back(TaskSplit{&task, i});
   }
   Worker *curr = CurrentWorker();
-  DistributeTask(&task_list, &task, task_num, curr);
+  DistributeTask(&task_list, &task, task_num, curr, numa_node);
   // synchronization
   // wait until the finished is equal to task_num
   while (task.finished != task_num) {
     if (curr != nullptr) {
       (void)curr->RunLocalKernelTask();
     }
+    // help the slow workers instead of waiting idly
+    if (work_stealing() && (curr != nullptr ? curr->StealKernelTask() : StealTask())) {
+      continue;
+    }
     std::this_thread::yield();
   }
   // check the return value of task
@@ -349,13 +410,18 @@ int ThreadPool::SyncRunFunc(const Func &func, Content content, int start, int en
   return THREAD_OK;
 }
 
-void ThreadPool::DistributeTask(std::vector<TaskSplit> *task_list, Task *task, int task_num, Worker *curr) const {
+void ThreadPool::DistributeTask(std::vector<TaskSplit> *task_list, Task *task, int task_num, Worker *curr,
+                                int numa_node) const {
   int sum_frequency = 0;
   std::vector<Worker *> assigned;
   assigned.reserve(task_num);
   int num = static_cast<int>(workers_.size()) - 1;
   int offset = 0;
   bool use_curr = (curr != nullptr);
+  // the current thread on the other numa node doesn't run the task splits routed to the numa node
+  if (numa_node >= 0 && use_curr && curr->numa_node() != numa_node) {
+    use_curr = false;
+  }
   // if the current thread isn't nullptr, that is the curr is a ActorThread,
   // then assign (task_num - 1) tasks to workers, and run the last one by itself
   int num_assigned = use_curr ? task_num - 1 : task_num;
@@ -366,6 +432,9 @@ void ThreadPool::DistributeTask(std::vector<TaskSplit> *task_list, Task *task, i
   }
 
   for (int i = num; i >= offset && count < num_assigned; --i) {
+    if (numa_node >= 0 && workers_[i]->numa_node() != numa_node) {
+      continue;
+    }
     if (workers_[i]->available()) {
       assigned.push_back(workers_[i]);
       sum_frequency += workers_[i]->frequency();
@@ -373,6 +442,27 @@ void ThreadPool::DistributeTask(std::vector<TaskSplit> *task_list, Task *task, i
     }
   }
 
+  if (numa_node >= 0 && !use_curr) {
+    if (assigned.empty()) {
+      // all the workers of the numa node are busy, queue the task splits to them rather than the other numa nodes
+      for (int i = num; i >= offset; --i) {
+        if (workers_[i]->numa_node() == numa_node) {
+          assigned.push_back(workers_[i]);
+          sum_frequency += workers_[i]->frequency();
+        }
+      }
+    }
+    if (assigned.empty()) {
+      // only the actor threads belong to the numa node
+      DistributeTask(task_list, task, task_num, curr);
+      return;
+    }
+    // keep all the task splits in the numa node instead of running the rest in the current thread
+    CalculateScales(assigned, sum_frequency);
+    ActiveWorkers(assigned, task_list, task_num, curr);
+    return;
+  }
+
   if (use_curr) {
     assigned.push_back(curr);
     sum_frequency += curr->frequency();
@@ -535,6 +625,121 @@ void ThreadPool::SetMinSpinCount(int spin_count) {
   min_spin_count_ = spin_count;
 }
 
+void ThreadPool::SetWorkStealing(bool enable) {
+  if (enable) {
+    InitStealOrder();
+  }
+  work_stealing_.store(enable, std::memory_order_release);
+  THREAD_INFO("set work stealing: %d", enable);
+}
+
+void ThreadPool::InitStealOrder() {
+  std::lock_guard<std::mutex> _l(pool_mutex_);
+  if (steal_order_inited_) {
+    return;
+  }
+  // the workers bound to the nearest cores come first, which are likely to share the cache with the thief,
+  // and the workers at the same distance are ordered as a ring starting from the thief
+  size_t worker_num = workers_.size();
+  for (size_t i = 0; i < worker_num; ++i) {
+    std::vector<size_t> steal_order;
+    for (size_t j = 1; j < worker_num; ++j) {
+      steal_order.push_back((i + j) % worker_num);
+    }
+    auto core_distance = [this, i](size_t index) {
+      // the workers on the other numa nodes come last
+      if (workers_[i]->numa_node() != workers_[index]->numa_node()) {
+        return std::numeric_limits<int>::max();
+      }
+      if (workers_[i]->bind_core() < 0 || workers_[index]->bind_core() < 0) {
+        return 0;
+      }
+      return std::abs(workers_[i]->bind_core() - workers_[index]->bind_core());
+    };
+    std::stable_sort(steal_order.begin(), steal_order.end(),
+                     [&core_distance](size_t lhs, size_t rhs) { return core_distance(lhs) < core_distance(rhs); });
+    workers_[i]->InitStealOrder(steal_order);
+  }
+  steal_order_inited_ = true;
+}
+
+int ThreadPool::SetNumaTopology(const std::vector<std::vector<int>> &numa_node_cpus) {
+  std::lock_guard<std::mutex> _l(pool_mutex_);
+  if (workers_.empty() || numa_node_cpus.empty()) {
+    THREAD_ERROR("the workers or the numa topology is empty.");
+    return THREAD_ERROR;
+  }
+  if (steal_order_inited_) {
+    THREAD_ERROR("the numa topology should be set before enabling the work stealing.");
+    return THREAD_ERROR;
+  }
+  size_t cpu_num = 0;
+  for (const auto &cpus : numa_node_cpus) {
+    cpu_num += cpus.size();
+  }
+  if (cpu_num == 0) {
+    THREAD_ERROR("there is no cpu in the numa topology.");
+    return THREAD_ERROR;
+  }
+  numa_node_workers_.assign(numa_node_cpus.size(), {});
+  size_t worker_num = workers_.size();
+  for (size_t i = 0; i < worker_num; ++i) {
+    // the worker bound to a core belongs to the numa node of the core,
+    // and the others are partitioned in proportion to the cpu number of each numa node
+    int numa_node = FindNumaNodeOfCore(numa_node_cpus, workers_[i]->bind_core());
+    if (numa_node < 0) {
+      size_t position = i * cpu_num / worker_num;
+      size_t node_cpu_end = 0;
+      for (size_t j = 0; j < numa_node_cpus.size(); ++j) {
+        node_cpu_end += numa_node_cpus[j].size();
+        if (position < node_cpu_end) {
+          numa_node = static_cast<int>(j);
+          break;
+        }
+      }
+    }
+    workers_[i]->set_numa_node(numa_node);
+    numa_node_workers_[numa_node].push_back(workers_[i]);
+    THREAD_INFO("worker[%zu] belongs to numa node[%d]", i, numa_node);
+  }
+  if (affinity_ != nullptr) {
+    return affinity_->BindThreadsToNumaNodes(workers_, numa_node_cpus);
+  }
+  return THREAD_OK;
+}
+
+int ThreadPool::GetNumaNodeOfAddress(const void *addr) {
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SYS_get_mempolicy)
+  if (addr == nullptr) {
+    return -1;
+  }
+  // MPOL_F_NODE | MPOL_F_ADDR: return the numa node of the page which the address is located at
+  constexpr uint64_t kMpolFNode = 1;
+  constexpr uint64_t kMpolFAddr = 1 << 1;
+  int numa_node = -1;
+  if (syscall(SYS_get_mempolicy, &numa_node, nullptr, 0, addr, kMpolFNode | kMpolFAddr) != 0) {
+    return -1;
+  }
+  return numa_node;
+#else
+  return -1;
+#endif
+}
+
+bool ThreadPool::StealTask() const {
+  for (const auto &task_queue : task_queues_) {
+    if (task_queue->Empty()) {
+      continue;
+    }
+    auto task_split = task_queue->Dequeue();
+    if (task_split != nullptr) {
+      RunTaskSplit(task_split);
+      return true;
+    }
+  }
+  return false;
+}
+
 ThreadPool *ThreadPool::CreateThreadPool(size_t thread_num, const std::vector<int> &core_list) {
   std::lock_guard<std::mutex> lock(create_thread_pool_muntex_);
   ThreadPool *pool = new (std::nothrow) ThreadPool();
@@ -73,6 +73,10 @@ typedef struct TaskSplit {
   TaskSplit(Task *task, int task_id) : task_(task), task_id_(task_id) {}
   Task *task_;
   int task_id_;
+  // the scales of the worker which the split is assigned to,
+  // keep them so that the split can be stolen and run by other workers
+  float lhs_scale_{0.};
+  float rhs_scale_{kMaxScale};
 } TaskSplit;
 
 class ThreadPool;
@@ -96,6 +100,13 @@ class Worker {
   virtual void RunOtherKernelTask();
   // try to run a single task
   bool TryRunTask(TaskSplit *task_split);
+  // try to steal a single task from the local task queues of other workers
+  bool StealKernelTask();
+  // the order of victim workers to steal task from, the nearest cores come first
+  void InitStealOrder(const std::vector<size_t> &steal_order) { steal_order_ = steal_order; }
+  int bind_core() const { return bind_core_; }
+  void set_numa_node(int numa_node) { numa_node_ = numa_node; }
+  int numa_node() const { return numa_node_; }
   // set max spin count before running
   void SetMaxSpinCount(int max_spin_count) { max_spin_count_ = max_spin_count; }
   void InitWorkerMask(const std::vector<int> &core_list, const size_t workers_size);
@@ -156,6 +167,10 @@ class Worker {
   HQueue<TaskSplit> *local_task_queue_{nullptr};
   size_t worker_id_{0};
   std::vector<int> core_list_;
+  int bind_core_{-1};
+  // the numa node which the worker belongs to, -1 if the numa topology is not set
+  int numa_node_{-1};
+  std::vector<size_t> steal_order_;
 
  private:
   void Run();
@@ -176,6 +191,9 @@ class MS_CORE_API ThreadPool {
   int SyncRunFunc(const Func &func, Content content, int start, int end) const;
 
   virtual int ParallelLaunch(const Func &func, Content content, int task_num);
+  // distribute the task splits to the workers of the numa node which owns the input buffers,
+  // fall back to ParallelLaunch if the numa topology is not set or the numa node is invalid
+  int ParallelLaunchOnNumaNode(const Func &func, Content content, int task_num, int numa_node);
 
   void DisableOccupiedActorThread() { occupied_actor_thread_ = false; }
   void SetActorThreadNum(size_t actor_thread_num) { actor_thread_num_ = actor_thread_num; }
@@ -187,7 +205,19 @@ class MS_CORE_API ThreadPool {
   void SetSpinCountMinValue();
   void SetMaxSpinCount(int spin_count);
   void SetMinSpinCount(int spin_count);
+  // enable the idle workers and the waiting launcher to steal task splits from the other workers
+  void SetWorkStealing(bool enable);
+  bool work_stealing() const { return work_stealing_.load(std::memory_order_acquire); }
+  // steal a single task split from the local task queues and run it in the current thread
+  bool StealTask() const;
   void ActiveWorkers();
+  // partition the workers per numa node and bind each worker to the cpus of its numa node,
+  // the numa_node_cpus[i] is the cpu list of the numa node i
+  int SetNumaTopology(const std::vector<std::vector<int>> &numa_node_cpus);
+  size_t numa_node_num() const { return numa_node_workers_.size(); }
+  const std::vector<Worker *> &numa_node_workers(size_t numa_node) const { return numa_node_workers_.at(numa_node); }
+  // get the numa node of the memory page which the address is located at, return -1 if unknown
+  static int GetNumaNodeOfAddress(const void *addr);
   void SetWorkerIdMap();
   // init task queues
   int TaskQueuesInit(size_t thread_num);
@@ -231,13 +261,16 @@ class MS_CORE_API ThreadPool {
 
   int InitAffinityInfo();
 
-  void DistributeTask(std::vector<TaskSplit> *task_list, Task *task, int task_num, Worker *curr) const;
+  void DistributeTask(std::vector<TaskSplit> *task_list, Task *task, int task_num, Worker *curr,
+                      int numa_node = -1) const;
+  int LaunchTask(const Func &func, Content content, int task_num, int numa_node = -1);
   void CalculateScales(const std::vector<Worker *> &workers, int sum_frequency) const;
   void ActiveWorkers(const std::vector<Worker *> &workers, std::vector<TaskSplit> *task_list, int task_num,
                      const Worker *curr) const;
 
   Worker *CurrentWorker(size_t *index) const;
   Worker *CurrentWorker() const;
+  void InitStealOrder();
 
   std::mutex pool_mutex_;
   std::vector<Worker *> workers_;
@@ -249,6 +282,10 @@ class MS_CORE_API ThreadPool {
   bool occupied_actor_thread_{true};
   std::atomic_int max_spin_count_{kDefaultSpinCount};
   std::atomic_int min_spin_count_{kMinSpinCount};
+  std::atomic_bool work_stealing_{false};
+  bool steal_order_inited_{false};
+  // the workers of each numa node, empty if the numa topology is not set
+  std::vector<std::vector<Worker *>> numa_node_workers_;
   float server_cpu_frequence = -1.0f;  // Unit : GHz
   static std::mutex create_thread_pool_muntex_;
 };
@@ -23,6 +23,7 @@
 #include <cerrno>
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 #include "utils/log_adapter.h"
 
@@ -202,4 +203,30 @@ Status LoadNumaCpuInfo(void *handle, const int32_t rank_id, std::vector<int> *nu
   numa_bitmask_free(numa_cpu_mask);
   return Status::OK();
 }
+
+Status LoadNumaNodesCpuInfo(void *handle, std::vector<std::vector<int>> *numa_nodes_cpus) {
+  if (numa_nodes_cpus == nullptr) {
+    RETURN_STATUS_UNEXPECTED("The pointer[numa_nodes_cpus] is null.");
+  }
+  DEFINE_NUMA_METHOD(handle, numa_available, int);
+  if (numa_available() == -1) {
+    return Status::OK();
+  }
+  DEFINE_NUMA_METHOD(handle, numa_max_node, int);
+  auto numa_node_max_id = numa_max_node();
+  if (numa_node_max_id < 0) {
+    RETURN_STATUS_UNEXPECTED("Get numa max node failed.");
+  }
+  numa_nodes_cpus->clear();
+  for (int32_t node_id = 0; node_id <= numa_node_max_id; ++node_id) {
+    std::vector<int> numa_cpus;
+    auto ret = LoadNumaCpuInfo(handle, node_id, &numa_cpus);
+    if (ret != StatusCode::kSuccess) {
+      return ret;
+    }
+    MS_LOG(INFO) << "Numa node " << node_id << " cpu num : " << numa_cpus.size() << ".";
+    (void)numa_nodes_cpus->emplace_back(std::move(numa_cpus));
+  }
+  return Status::OK();
+}
 }  // namespace mindspore
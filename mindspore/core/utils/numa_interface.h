@@ -34,5 +34,8 @@ MS_CORE_API std::shared_ptr<void> GetNumaAdapterHandle();
 MS_CORE_API Status NumaBind(void *handle, const int32_t &rank_id);
 
 MS_CORE_API Status LoadNumaCpuInfo(void *handle, const int32_t rank_id, std::vector<int> *numa_cpus);
+
+// Load the cpus of all the numa nodes, the numa_nodes_cpus[i] is the cpu list of the numa node i.
+MS_CORE_API Status LoadNumaNodesCpuInfo(void *handle, std::vector<std::vector<int>> *numa_nodes_cpus);
 }  // namespace mindspore
 #endif  // MINDSPORE_CORE_UTILS_NUMA_INTERFACE_H_
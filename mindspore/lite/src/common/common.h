@@ -79,6 +79,12 @@ static const char *const kSharedThreadPoolSection = "shared_thread_pool";
 static const char *const kEnableSharedThreadPoolKey = "enable_shared_thread_pool";
 static const char *const kThreadNumLimitPerWorkerKey = "thread_num_limit_per_worker";
 static const char *const kThreadNumRemainingPerWorkerKey = "thread_num_remaining_per_worker";
+// dynamic batch of model pool
+static const char *const kDynamicBatchSection = "dynamic_batch";
+static const char *const kEnableDynamicBatchKey = "enable_dynamic_batch";
+static const char *const kMaxBatchSizeKey = "max_batch_size";
+static const char *const kMaxQueueDelayUsKey = "max_queue_delay_us";
+static const char *const kBatchBucketsKey = "batch_buckets";
 // model pool inner section and key
 static const char *const kInnerModelParallelRunnerSection = "inner_model_parallel_runner";
 static const char *const kInnerSharingWeightCopyBufKey = "sharing_weight_copy_buf";
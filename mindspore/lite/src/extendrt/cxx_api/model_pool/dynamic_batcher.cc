@@ -0,0 +1,295 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/extendrt/cxx_api/model_pool/dynamic_batcher.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "src/common/log_adapter.h"
+#include "src/common/common.h"
+#include "src/common/utils.h"
+namespace mindspore {
+namespace {
+constexpr int64_t kDefaultMaxDelayUs = 1000;
+constexpr int kMinBatchSize = 2;
+}  // namespace
+
+Status DynamicBatcher::ParseConfig(const std::map<std::string, std::map<std::string, std::string>> &config_info,
+                                   DynamicBatchConfig *config, bool *enable) {
+  if (config == nullptr || enable == nullptr) {
+    MS_LOG(ERROR) << "config or enable is nullptr.";
+    return kLiteNullptr;
+  }
+  *enable = false;
+  auto section = config_info.find(lite::kDynamicBatchSection);
+  if (section == config_info.end()) {
+    MS_LOG(INFO) << "not set dynamic batch.";
+    return kSuccess;
+  }
+  auto &params = section->second;
+  auto enable_iter = params.find(lite::kEnableDynamicBatchKey);
+  if (enable_iter == params.end() || enable_iter->second != "true") {
+    MS_LOG(INFO) << "Not use dynamic batch";
+    return kSuccess;
+  }
+  auto max_batch_iter = params.find(lite::kMaxBatchSizeKey);
+  int max_batch_size = 0;
+  if (max_batch_iter == params.end() || !lite::ConvertStrToInt(max_batch_iter->second, &max_batch_size) ||
+      max_batch_size < kMinBatchSize) {
+    MS_LOG(ERROR) << "max_batch_size of dynamic batch should be an integer greater than 1.";
+    return kLiteParamInvalid;
+  }
+  config->max_batch_size = static_cast<size_t>(max_batch_size);
+  config->max_delay_us = kDefaultMaxDelayUs;
+  auto delay_iter = params.find(lite::kMaxQueueDelayUsKey);
+  if (delay_iter != params.end() && !delay_iter->second.empty()) {
+    if (!lite::ConvertStrToInt(delay_iter->second, &config->max_delay_us) || config->max_delay_us < 0) {
+      MS_LOG(ERROR) << "max_queue_delay_us of dynamic batch is invalid: " << delay_iter->second;
+      return kLiteParamInvalid;
+    }
+  }
+  config->batch_buckets.clear();
+  auto buckets_iter = params.find(lite::kBatchBucketsKey);
+  if (buckets_iter != params.end() && !buckets_iter->second.empty()) {
+    for (auto &item : lite::StrSplit(buckets_iter->second, ",")) {
+      int bucket = 0;
+      if (!lite::ConvertStrToInt(item, &bucket) || bucket <= 0 || bucket > max_batch_size) {
+        MS_LOG(ERROR) << "batch_buckets of dynamic batch should be integers in [1, max_batch_size], but got: "
+                      << buckets_iter->second;
+        return kLiteParamInvalid;
+      }
+      config->batch_buckets.push_back(static_cast<size_t>(bucket));
+    }
+    std::sort(config->batch_buckets.begin(), config->batch_buckets.end());
+  }
+  *enable = true;
+  MS_LOG(INFO) << "use dynamic batch, max batch size: " << config->max_batch_size
+               << " | max queue delay us: " << config->max_delay_us
+               << " | batch bucket num: " << config->batch_buckets.size();
+  return kSuccess;
+}
+
+std::string DynamicBatcher::GetBatchKey(const std::vector<MSTensor> &inputs, size_t *batch) const {
+  std::string key;
+  *batch = 0;
+  for (auto &input : inputs) {
+    auto &shape = input.Shape();
+    if (shape.empty() || shape[0] <= 0 || input.DataType() == DataType::kObjectTypeString || input.Data() == nullptr) {
+      return "";
+    }
+    if (*batch != 0 && *batch != static_cast<size_t>(shape[0])) {
+      return "";
+    }
+    *batch = static_cast<size_t>(shape[0]);
+    key += std::to_string(static_cast<int>(input.DataType()));
+    for (size_t i = 1; i < shape.size(); i++) {
+      key += "," + std::to_string(shape[i]);
+    }
+    key += ";";
+  }
+  return key;
+}
+
+size_t DynamicBatcher::GetPaddedBatchSize(size_t batch_size) const {
+  auto iter = std::lower_bound(config_.batch_buckets.begin(), config_.batch_buckets.end(), batch_size);
+  return iter == config_.batch_buckets.end() ? batch_size : *iter;
+}
+
+void DynamicBatcher::CloseBatch(const std::string &key, const std::shared_ptr<Batch> &batch) {
+  batch->closed = true;
+  auto iter = open_batches_.find(key);
+  if (iter != open_batches_.end() && iter->second == batch) {
+    open_batches_.erase(iter);
+  }
+  batch->full_cond.notify_one();
+}
+
+Status DynamicBatcher::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                               const MSKernelCallBack &before, const MSKernelCallBack &after) {
+  if (outputs == nullptr) {
+    MS_LOG(ERROR) << "outputs is nullptr.";
+    return kLiteNullptr;
+  }
+  size_t batch = 0;
+  // the callbacks belong to each request, so the requests with callbacks are not batched
+  std::string key = (before == nullptr && after == nullptr) ? GetBatchKey(inputs, &batch) : "";
+  if (key.empty() || batch >= config_.max_batch_size) {
+    return predict_func_(inputs, outputs, before, after);
+  }
+  Request request;
+  request.inputs = &inputs;
+  request.outputs = outputs;
+  request.batch = batch;
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto iter = open_batches_.find(key);
+  if (iter != open_batches_.end() && iter->second->batch_size + batch <= config_.max_batch_size) {
+    auto open_batch = iter->second;
+    open_batch->requests.push_back(&request);
+    open_batch->batch_size += batch;
+    if (open_batch->batch_size == config_.max_batch_size) {
+      CloseBatch(key, open_batch);
+    }
+    open_batch->done_cond.wait(lock, [&open_batch]() { return open_batch->done; });
+    return request.status;
+  }
+  if (iter != open_batches_.end()) {
+    // the request does not fit into the open batch, which is run right now
+    CloseBatch(key, iter->second);
+  }
+  auto new_batch = std::make_shared<Batch>();
+  new_batch->requests.push_back(&request);
+  new_batch->batch_size = batch;
+  open_batches_[key] = new_batch;
+  (void)new_batch->full_cond.wait_for(lock, std::chrono::microseconds(config_.max_delay_us),
+                                      [&new_batch]() { return new_batch->closed; });
+  if (!new_batch->closed) {
+    CloseBatch(key, new_batch);
+  }
+  // no request joins the batch once it is closed, so it can be run without the lock
+  lock.unlock();
+  RunBatch(new_batch);
+  lock.lock();
+  new_batch->done = true;
+  new_batch->done_cond.notify_all();
+  return request.status;
+}
+
+void DynamicBatcher::RunBatch(const std::shared_ptr<Batch> &batch) {
+  auto &requests = batch->requests;
+  if (requests.size() == 1) {
+    auto request = requests.front();
+    request->status = predict_func_(*request->inputs, request->outputs, nullptr, nullptr);
+    return;
+  }
+  auto padded_batch = GetPaddedBatchSize(batch->batch_size);
+  std::vector<MSTensor> batch_inputs;
+  std::vector<MSTensor> batch_outputs;
+  auto status = ConcatInputs(requests, padded_batch, &batch_inputs);
+  if (status == kSuccess) {
+    status = predict_func_(batch_inputs, &batch_outputs, nullptr, nullptr);
+  }
+  // the outputs split before a failure must not be seen by the predictions one by one
+  std::vector<std::vector<MSTensor>> origin_outputs;
+  if (status == kSuccess) {
+    for (auto request : requests) {
+      origin_outputs.push_back(*request->outputs);
+    }
+    status = SplitOutputs(batch_outputs, padded_batch, requests);
+  }
+  if (status != kSuccess) {
+    MS_LOG(WARNING) << "predict with the batch of " << requests.size() << " requests failed, run them one by one.";
+    for (size_t i = 0; i < origin_outputs.size(); i++) {
+      *requests[i]->outputs = origin_outputs[i];
+    }
+    for (auto request : requests) {
+      request->status = predict_func_(*request->inputs, request->outputs, nullptr, nullptr);
+    }
+    return;
+  }
+  for (auto request : requests) {
+    request->status = kSuccess;
+  }
+}
+
+Status DynamicBatcher::ConcatInputs(const std::vector<Request *> &requests, size_t padded_batch,
+                                    std::vector<MSTensor> *inputs) {
+  auto &first_inputs = *requests.front()->inputs;
+  for (size_t i = 0; i < first_inputs.size(); i++) {
+    auto &first_input = first_inputs[i];
+    auto row_size = first_input.DataSize() / requests.front()->batch;
+    auto shape = first_input.Shape();
+    shape[0] = static_cast<int64_t>(padded_batch);
+    auto batch_tensor = MSTensor::CreateTensor(first_input.Name(), first_input.DataType(), shape, nullptr, 0);
+    if (batch_tensor == nullptr) {
+      MS_LOG(ERROR) << "create batched input tensor failed.";
+      return kLiteNullptr;
+    }
+    auto dst = static_cast<uint8_t *>(batch_tensor->MutableData());
+    if (dst == nullptr || batch_tensor->DataSize() != row_size * padded_batch) {
+      MS_LOG(ERROR) << "malloc batched input tensor failed.";
+      MSTensor::DestroyTensorPtr(batch_tensor);
+      return kLiteMemoryFailed;
+    }
+    size_t offset = 0;
+    for (auto request : requests) {
+      auto &input = request->inputs->at(i);
+      auto data = input.Data();
+      auto size = input.DataSize();
+      if (data == nullptr || size != row_size * request->batch) {
+        MS_LOG(ERROR) << "the input " << i << " of request has invalid data, size: " << size;
+        MSTensor::DestroyTensorPtr(batch_tensor);
+        return kLiteError;
+      }
+      (void)memcpy(dst + offset, data.get(), size);
+      offset += size;
+    }
+    // the padded rows are filled with zero and dropped from the outputs
+    (void)memset(dst + offset, 0, row_size * padded_batch - offset);
+    inputs->push_back(*batch_tensor);
+    MSTensor::DestroyTensorPtr(batch_tensor);
+  }
+  return kSuccess;
+}
+
+Status DynamicBatcher::SplitOutputs(const std::vector<MSTensor> &outputs, size_t padded_batch,
+                                    const std::vector<Request *> &requests) {
+  for (auto &output : outputs) {
+    auto &shape = output.Shape();
+    if (shape.empty() || shape[0] != static_cast<int64_t>(padded_batch) || output.Data() == nullptr) {
+      MS_LOG(WARNING) << "the first dimension of output " << output.Name() << " is not the batch dimension.";
+      return kLiteError;
+    }
+  }
+  for (auto request : requests) {
+    if (!request->outputs->empty() && request->outputs->size() != outputs.size()) {
+      MS_LOG(ERROR) << "the output size of request is " << request->outputs->size() << ", but model has "
+                    << outputs.size();
+      return kLiteError;
+    }
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    auto &output = outputs[i];
+    auto row_size = output.DataSize() / padded_batch;
+    auto src = static_cast<const uint8_t *>(output.Data().get());
+    size_t offset = 0;
+    for (auto request : requests) {
+      auto size = row_size * request->batch;
+      auto &user_outputs = *request->outputs;
+      if (user_outputs.size() == outputs.size()) {
+        // the outputs are allocated by user
+        auto &user_output = user_outputs[i];
+        auto dst = user_output.MutableData();
+        if (dst == nullptr || user_output.DataSize() != size) {
+          MS_LOG(ERROR) << "the output " << i << " of request has invalid data, size: " << user_output.DataSize();
+          return kLiteError;
+        }
+        (void)memcpy(dst, src + offset, size);
+      } else {
+        auto shape = output.Shape();
+        shape[0] = static_cast<int64_t>(request->batch);
+        auto tensor = MSTensor::CreateTensor(output.Name(), output.DataType(), shape, src + offset, size);
+        if (tensor == nullptr) {
+          MS_LOG(ERROR) << "create output tensor of request failed.";
+          return kLiteNullptr;
+        }
+        user_outputs.push_back(*tensor);
+        MSTensor::DestroyTensorPtr(tensor);
+      }
+      offset += size;
+    }
+  }
+  return kSuccess;
+}
+}  // namespace mindspore
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_DYNAMIC_BATCHER_H_
+#define MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_DYNAMIC_BATCHER_H_
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "include/api/types.h"
+#include "include/api/status.h"
+namespace mindspore {
+struct DynamicBatchConfig {
+  size_t max_batch_size = 0;
+  // the time the first request of a batch waits for the others
+  int64_t max_delay_us = 0;
+  // the batch size is padded up to the nearest bucket, ascending
+  std::vector<size_t> batch_buckets;
+};
+
+// Coalesce the concurrent requests with the same input shape into one batched predict, the first dimension of inputs
+// and outputs is the batch dimension. The caller which opens a batch waits for the others up to the delay, runs the
+// batch in its own thread and splits the outputs back to each request.
+class DynamicBatcher {
+ public:
+  using PredictFunc = std::function<Status(const std::vector<MSTensor> &, std::vector<MSTensor> *,
+                                           const MSKernelCallBack &, const MSKernelCallBack &)>;
+
+  DynamicBatcher(const DynamicBatchConfig &config, PredictFunc predict_func)
+      : config_(config), predict_func_(std::move(predict_func)) {}
+
+  ~DynamicBatcher() = default;
+
+  Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                 const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
+
+  // parse the section of dynamic batch, enable is false if the section is not set
+  static Status ParseConfig(const std::map<std::string, std::map<std::string, std::string>> &config_info,
+                            DynamicBatchConfig *config, bool *enable);
+
+ private:
+  struct Request {
+    const std::vector<MSTensor> *inputs = nullptr;
+    std::vector<MSTensor> *outputs = nullptr;
+    size_t batch = 0;
+    Status status = kSuccess;
+  };
+
+  struct Batch {
+    std::vector<Request *> requests;
+    size_t batch_size = 0;
+    bool closed = false;
+    bool done = false;
+    std::condition_variable full_cond;
+    std::condition_variable done_cond;
+  };
+
+  // the key of requests which can be batched together, empty if the request can not be batched
+  std::string GetBatchKey(const std::vector<MSTensor> &inputs, size_t *batch) const;
+
+  size_t GetPaddedBatchSize(size_t batch_size) const;
+
+  // run the requests of batch, fall back to predict them one by one if the model can not be batched
+  void RunBatch(const std::shared_ptr<Batch> &batch);
+
+  Status ConcatInputs(const std::vector<Request *> &requests, size_t padded_batch, std::vector<MSTensor> *inputs);
+
+  Status SplitOutputs(const std::vector<MSTensor> &outputs, size_t padded_batch,
+                      const std::vector<Request *> &requests);
+
+  // close the batch so that no request joins it, should be called with mutex_ held
+  void CloseBatch(const std::string &key, const std::shared_ptr<Batch> &batch);
+
+  DynamicBatchConfig config_;
+  PredictFunc predict_func_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Batch>> open_batches_;
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_DYNAMIC_BATCHER_H_
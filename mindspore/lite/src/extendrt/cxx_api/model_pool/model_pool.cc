@@ -939,12 +939,53 @@ Status ModelPool::ParseSharedThreadPoolParam(const std::shared_ptr<RunnerConfig>
   return ParseParamByConfigInfo(runner_config->GetConfigInfo());
 }
 
+Status ModelPool::ParseDynamicBatchParam(const std::shared_ptr<RunnerConfig> &runner_config) {
+  if (runner_config == nullptr) {
+    MS_LOG(INFO) << "runner config is nullptr.";
+    return kSuccess;
+  }
+  std::map<std::string, std::map<std::string, std::string>> config_info;
+  if (!runner_config->GetConfigPath().empty()) {
+    int ret = lite::GetAllSectionInfoFromConfigFile(runner_config->GetConfigPath(), &config_info);
+    if (ret != lite::RET_OK) {
+      MS_LOG(ERROR) << "GetAllSectionInfoFromConfigFile failed.";
+      return kLiteError;
+    }
+  }
+  // the config info set by user overrides the config file
+  auto user_config_info = runner_config->GetConfigInfo();
+  if (user_config_info.find(lite::kDynamicBatchSection) != user_config_info.end()) {
+    config_info[lite::kDynamicBatchSection] = user_config_info[lite::kDynamicBatchSection];
+  }
+  DynamicBatchConfig batch_config;
+  bool enable = false;
+  auto status = DynamicBatcher::ParseConfig(config_info, &batch_config, &enable);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "parse dynamic batch param failed.";
+    return status;
+  }
+  if (!enable) {
+    return kSuccess;
+  }
+  dynamic_batcher_ = std::make_shared<DynamicBatcher>(
+    batch_config, [this](const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                         const MSKernelCallBack &before, const MSKernelCallBack &after) {
+      return DispatchPredict(inputs, outputs, before, after);
+    });
+  return kSuccess;
+}
+
 ModelPoolConfig ModelPool::Init(const std::shared_ptr<RunnerConfig> &runner_config) {
   auto status = ParseSharedThreadPoolParam(runner_config);
   if (status != kSuccess) {
     MS_LOG(WARNING) << "ParseSharedThreadPoolParam failed, Not use thread pool shared.";
     enable_shared_thread_pool_ = false;
   }
+  status = ParseDynamicBatchParam(runner_config);
+  if (status != kSuccess) {
+    MS_LOG(WARNING) << "ParseDynamicBatchParam failed, Not use dynamic batch.";
+    dynamic_batcher_ = nullptr;
+  }
   ModelPoolConfig model_pool_config = {};
   status = CanUseAllPhysicalResources();
   if (status != kSuccess) {
@@ -1115,6 +1156,14 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
       return kSuccess;
     }
   }
+  if (dynamic_batcher_ != nullptr) {
+    return dynamic_batcher_->Predict(inputs, outputs, before, after);
+  }
+  return DispatchPredict(inputs, outputs, before, after);
+}
+
+Status ModelPool::DispatchPredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                                  const MSKernelCallBack &before, const MSKernelCallBack &after) {
   int max_wait_worker_node_id = 0;
   int max_wait_worker_num = 0;
   auto available_worker = GetMaxWaitWorkerNum(&max_wait_worker_node_id, &max_wait_worker_num);
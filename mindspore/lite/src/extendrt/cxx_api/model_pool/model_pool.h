@@ -30,6 +30,7 @@
 #include "include/api/model_parallel_runner.h"
 #include "src/extendrt/cxx_api/model_pool/model_worker.h"
 #include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
+#include "src/extendrt/cxx_api/model_pool/dynamic_batcher.h"
 namespace mindspore {
 using ModelPoolConfig = std::vector<std::shared_ptr<WorkerConfig>>;
 
@@ -117,6 +118,12 @@ class ModelPool {
 
   Status ParseParamByConfigInfo(std::map<std::string, std::map<std::string, std::string>> config_info);
 
+  Status ParseDynamicBatchParam(const std::shared_ptr<RunnerConfig> &runner_config);
+
+  // dispatch the request to an idle worker or the task queue
+  Status DispatchPredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                         const MSKernelCallBack &before, const MSKernelCallBack &after);
+
   Status CheckSharingThreadPoolParam(const ModelPoolConfig &model_pool_config);
 
   Status ParseDeviceIds(const std::shared_ptr<RunnerConfig> &runner_config, ModelPoolConfig *model_pool_config);
@@ -170,6 +177,9 @@ class ModelPool {
   int thread_num_limit_ = 0;
   int remaining_thread_num_ = 0;
 
+  // coalesce the concurrent requests into batches, nullptr if dynamic batch is not enabled
+  std::shared_ptr<DynamicBatcher> dynamic_batcher_ = nullptr;
+
   char *graph_buf_ = nullptr;
   // malloc for graph_buf_
   std::shared_ptr<Allocator> allocator_ = nullptr;
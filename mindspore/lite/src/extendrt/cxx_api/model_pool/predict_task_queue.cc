@@ -15,8 +15,15 @@
  */
 
 #include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
+#include <thread>
 #include "src/common/log_adapter.h"
 namespace mindspore {
+namespace {
+// the predict of small models takes tens of microseconds, spin a while before parking the caller
+constexpr int kSpinCountBeforePark = 2000;
+constexpr int kSpinCountBeforeYield = 200;
+}  // namespace
+
 PredictTaskQueue::~PredictTaskQueue() {
   MS_LOG(INFO) << "free predict task queue.";
   if (predict_task_ != nullptr) {
@@ -47,8 +54,8 @@ Status PredictTaskQueue::InitTaskQueue(size_t num, size_t max_queue_size) {
     MS_LOG(ERROR) << "task queue size should greater than 0";
     return kLiteError;
   }
-#ifdef USE_HQUEUE
   task_queue_num_ = num;
+#ifdef USE_HQUEUE
   predict_task_ = new (std::nothrow) HQueue<PredictTask>[num]();
   if (predict_task_ == nullptr) {
     MS_LOG(ERROR) << "new predict task failed.";
@@ -76,9 +83,19 @@ Status PredictTaskQueue::InitTaskQueue(size_t num, size_t max_queue_size) {
 }
 
 void PredictTaskQueue::WaitUntilPredictActive(PredictTask *task, int node_id) {
-  std::unique_lock<std::mutex> result_lock(task->task_done_mutex);
-  while (!task->ready) {
-    task->task_done_condition.wait(result_lock);
+  for (int i = 0; i < kSpinCountBeforePark && !task->ready; i++) {
+    if (i >= kSpinCountBeforeYield) {
+      std::this_thread::yield();
+    }
+  }
+  if (!task->ready) {
+    // ready is checked under the lock after waiting is set, so the notify of worker can not be lost
+    task->waiting = true;
+    std::unique_lock<std::mutex> result_lock(task->task_done_mutex);
+    while (!task->ready) {
+      task->task_done_condition.wait(result_lock);
+    }
+    task->waiting = false;
   }
   task->ready = false;
   idle_worker_num_[node_id] += 1;
@@ -86,11 +103,17 @@ void PredictTaskQueue::WaitUntilPredictActive(PredictTask *task, int node_id) {
 }
 
 void PredictTaskQueue::ActiveTask(PredictTask *task) {
+  if (!task->waiting) {
+    return;
+  }
   std::unique_lock<std::mutex> result_lock(task->task_done_mutex);
   task->task_done_condition.notify_one();
 }
 
 void PredictTaskQueue::ActiveTaskQueue() {
+  if (sleeping_worker_num_ == 0) {
+    return;
+  }
   std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
   task_push_cond_.notify_all();
 }
@@ -100,6 +123,11 @@ void PredictTaskQueue::PushPredictTask(PredictTask *task, int node_id) {
 #ifdef USE_HQUEUE
   while (!predict_task_[node_id].Enqueue(task)) {
   }
+  // pairs with the increment of sleeping_worker_num_ before the worker checks the queues
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_worker_num_ == 0) {
+    return;
+  }
   std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
 #else
   std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
@@ -108,29 +136,63 @@ void PredictTaskQueue::PushPredictTask(PredictTask *task, int node_id) {
   task_push_cond_.notify_all();
 }
 
+bool PredictTaskQueue::AllTaskQueueEmpty() {
+  for (size_t i = 0; i < task_queue_num_; i++) {
+#ifdef USE_HQUEUE
+    if (!predict_task_[i].Empty()) {
+#else
+    if (!predict_task_[i].empty()) {
+#endif
+      return false;
+    }
+  }
+  return true;
+}
+
+PredictTask *PredictTaskQueue::PopPredictTask(int node_id) {
+  // the own queue goes first, the others are visited in turn so that the stealing is spread over the nodes
+  for (size_t i = 0; i < task_queue_num_; i++) {
+    auto queue_id = (static_cast<size_t>(node_id) + i) % task_queue_num_;
+#ifdef USE_HQUEUE
+    auto task = predict_task_[queue_id].Dequeue();
+    if (task != nullptr) {
+      return task;
+    }
+#else
+    if (!predict_task_[queue_id].empty()) {
+      auto task = predict_task_[queue_id].front();
+      predict_task_[queue_id].pop();
+      return task;
+    }
+#endif
+  }
+  return nullptr;
+}
+
 PredictTask *PredictTaskQueue::GetPredictTask(int node_id, ModelWorker *worker) {
 #ifdef USE_HQUEUE
-  if (!predict_task_[node_id].Empty() && worker->IsAvailable()) {
-    return predict_task_[node_id].Dequeue();
+  if (!AllTaskQueueEmpty() && worker->IsAvailable()) {
+    return PopPredictTask(node_id);
   } else {
     std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
-    while ((predict_task_[node_id].Empty() || (!worker->IsAvailable())) && (!predict_task_done_)) {
+    sleeping_worker_num_ += 1;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while ((AllTaskQueueEmpty() || (!worker->IsAvailable())) && (!predict_task_done_)) {
       task_push_cond_.wait(task_lock);
     }
-    return predict_task_[node_id].Dequeue();
+    sleeping_worker_num_ -= 1;
+    return PopPredictTask(node_id);
   }
   return nullptr;
 #else
   std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
-  while ((predict_task_[node_id].empty() || (!worker->IsAvailable())) && (!predict_task_done_)) {
+  while ((AllTaskQueueEmpty() || (!worker->IsAvailable())) && (!predict_task_done_)) {
     task_push_cond_.wait(task_lock);
   }
   if (predict_task_done_) {
     return nullptr;
   }
-  auto predict_task = predict_task_[node_id].front();
-  predict_task_[node_id].pop();
-  return predict_task;
+  return PopPredictTask(node_id);
 #endif
 }
 }  // namespace mindspore
@@ -39,6 +39,8 @@ struct PredictTask {
   MSKernelCallBack before;
   MSKernelCallBack after;
   std::atomic_bool ready;
+  // the caller parks on the condition only after spinning, the worker notifies it only if it is parked
+  std::atomic_bool waiting = false;
   std::condition_variable task_done_condition;
   std::mutex task_done_mutex;
 };
@@ -62,6 +64,10 @@ class PredictTaskQueue {
   void IncreaseWaitModelNum(int num, int node_id) { idle_worker_num_[node_id] += num; }
 
  private:
+  // take a task from the queue of node_id, or steal one from the other nodes if it is empty
+  PredictTask *PopPredictTask(int node_id);
+  bool AllTaskQueueEmpty();
+
   // use an array to save predict tasks, different numa nodes correspond to different arrays
 #ifdef USE_HQUEUE
   HQueue<PredictTask> *predict_task_;
@@ -73,7 +79,9 @@ class PredictTaskQueue {
   std::mutex mtx_predict_task_;
   std::condition_variable task_pop_cond_;
   std::condition_variable task_push_cond_;
-  bool predict_task_done_ = false;
+  // the number of workers blocked on task_push_cond_, the pusher takes the lock only if some one waits
+  std::atomic_int sleeping_worker_num_ = 0;
+  std::atomic_bool predict_task_done_ = false;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
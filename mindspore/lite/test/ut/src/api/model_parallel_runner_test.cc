@@ -14,9 +14,15 @@
  * limitations under the License.
  */
 #include "include/api/model_parallel_runner.h"
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include "common/common_test.h"
 #include "src/common/file_utils.h"
+#include "src/extendrt/cxx_api/model_pool/dynamic_batcher.h"
 
 namespace mindspore {
 namespace {
@@ -24,6 +30,9 @@ const char in_data_path[] = "./mobilenetv2.ms.bin";
 const char model_path[] = "./mobilenetv2.ms";
 const size_t kInputDataSize = 1 * 224 * 224 * 3 * sizeof(float);
 const size_t kOutputDataSize = 1 * 1001 * sizeof(float);
+const int64_t kBatchMaxDelayUs = 1000000;
+const float kBatchOutputErrBound = 1e-5;
+const size_t kBatchRequestNum = 4;
 
 void SetInputTensorData(std::vector<MSTensor> *inputs) {
   ASSERT_EQ(inputs->size(), 1);
@@ -240,4 +249,102 @@ TEST_F(ModelParallelRunnerTest, RunnerInitByBuf) {
     tensor.SetData(nullptr);
   }
 }
+
+TEST_F(ModelParallelRunnerTest, RunnerPredictWithDynamicBatch) {
+  auto context = std::make_shared<Context>();
+  ASSERT_NE(nullptr, context);
+  auto &device_list = context->MutableDeviceInfo();
+  auto device_info = std::make_shared<mindspore::CPUDeviceInfo>();
+  ASSERT_NE(nullptr, device_info);
+  device_list.push_back(device_info);
+  ASSERT_EQ(device_list.size(), 1);
+
+  // the outputs of the unbatched runner are the expected ones
+  auto config = std::make_shared<RunnerConfig>();
+  ASSERT_NE(nullptr, config);
+  config->SetContext(context);
+  config->SetWorkersNum(2);
+  ModelParallelRunner unbatched_runner;
+  auto status = unbatched_runner.Init(model_path, config);
+  ASSERT_EQ(status, kSuccess);
+  auto inputs = unbatched_runner.GetInputs();
+  SetInputTensorData(&inputs);
+  std::vector<MSTensor> expect_outputs;
+  status = unbatched_runner.Predict(inputs, &expect_outputs);
+  ASSERT_EQ(status, kSuccess);
+  ASSERT_EQ(expect_outputs.size(), 1);
+  ASSERT_EQ(expect_outputs.front().DataSize(), kOutputDataSize);
+  auto expect_data = static_cast<const float *>(expect_outputs.front().Data().get());
+  ASSERT_NE(expect_data, nullptr);
+
+  // the batch is closed once it is full, so the long delay only bounds the wait of a missing request
+  auto predict_concurrently = [&inputs, &expect_data](const DynamicBatcher::PredictFunc &predict) {
+    std::vector<std::vector<MSTensor>> all_outputs(kBatchRequestNum);
+    std::vector<Status> all_status(kBatchRequestNum, kLiteError);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kBatchRequestNum; i++) {
+      threads.emplace_back([&predict, &inputs, &all_outputs, &all_status, i]() {
+        all_status[i] = predict(inputs, &all_outputs[i], nullptr, nullptr);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    for (size_t i = 0; i < kBatchRequestNum; i++) {
+      ASSERT_EQ(all_status[i], kSuccess);
+      ASSERT_EQ(all_outputs[i].size(), 1);
+      ASSERT_EQ(all_outputs[i].front().DataSize(), kOutputDataSize);
+      auto data = static_cast<const float *>(all_outputs[i].front().Data().get());
+      ASSERT_NE(data, nullptr);
+      for (size_t j = 0; j < kOutputDataSize / sizeof(float); j++) {
+        ASSERT_NEAR(data[j], expect_data[j], kBatchOutputErrBound) << "request " << i << " output " << j;
+      }
+    }
+  };
+
+  // the concurrent requests are merged into one batched predict of the model
+  DynamicBatchConfig batch_config;
+  batch_config.max_batch_size = kBatchRequestNum;
+  batch_config.max_delay_us = kBatchMaxDelayUs;
+  std::mutex batch_mutex;
+  std::vector<int64_t> predicted_batches;
+  DynamicBatcher batcher(batch_config, [&unbatched_runner, &batch_mutex, &predicted_batches](
+                                         const std::vector<MSTensor> &batch_inputs, std::vector<MSTensor> *outputs,
+                                         const MSKernelCallBack &before, const MSKernelCallBack &after) {
+    {
+      std::lock_guard<std::mutex> lock(batch_mutex);
+      predicted_batches.push_back(batch_inputs.front().Shape().front());
+    }
+    return unbatched_runner.Predict(batch_inputs, outputs, before, after);
+  });
+  predict_concurrently([&batcher](const std::vector<MSTensor> &request_inputs, std::vector<MSTensor> *outputs,
+                                  const MSKernelCallBack &before, const MSKernelCallBack &after) {
+    return batcher.Predict(request_inputs, outputs, before, after);
+  });
+  ASSERT_EQ(predicted_batches, std::vector<int64_t>{static_cast<int64_t>(kBatchRequestNum)});
+
+  // the runner configured with dynamic batch gives the same outputs
+  auto batch_runner_config = std::make_shared<RunnerConfig>();
+  ASSERT_NE(nullptr, batch_runner_config);
+  batch_runner_config->SetContext(context);
+  batch_runner_config->SetWorkersNum(2);
+  std::map<std::string, std::string> dynamic_batch = {{"enable_dynamic_batch", "true"},
+                                                      {"max_batch_size", std::to_string(kBatchRequestNum)},
+                                                      {"max_queue_delay_us", std::to_string(kBatchMaxDelayUs)},
+                                                      {"batch_buckets", "2,4"}};
+  batch_runner_config->SetConfigInfo("dynamic_batch", dynamic_batch);
+  ModelParallelRunner runner;
+  status = runner.Init(model_path, batch_runner_config);
+  ASSERT_EQ(status, kSuccess);
+  predict_concurrently([&runner](const std::vector<MSTensor> &request_inputs, std::vector<MSTensor> *outputs,
+                                 const MSKernelCallBack &before, const MSKernelCallBack &after) {
+    return runner.Predict(request_inputs, outputs, before, after);
+  });
+  // free user data
+  for (auto &tensor : inputs) {
+    char *data = static_cast<char *>(tensor.MutableData());
+    delete[] data;
+    tensor.SetData(nullptr);
+  }
+}
 }  // namespace mindspore
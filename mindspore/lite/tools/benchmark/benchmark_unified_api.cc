@@ -1120,6 +1120,7 @@ void BenchmarkUnifiedApi::ModelParallelRunnerRun(int task_num, int parallel_idx)
       return;
     }
     auto predict_end = GetTimeUs();
+    parallel_latencies_[parallel_idx].push_back((predict_end - predict_start) / kFloatMSEC);
     std::cout << "parallel index: " << parallel_idx << " | task index: " << i
               << " | predict time: " << (predict_end - predict_start) / kFloatMSEC << " ms\n";
     for (size_t j = 0; j < in.size(); j++) {
@@ -1220,6 +1221,7 @@ int BenchmarkUnifiedApi::ParallelInference(std::shared_ptr<mindspore::Context> c
   }
   std::cout << "=============== end warm up ===============\n";
   // do loop count
+  parallel_latencies_.assign(flags_->parallel_num_, {});
   std::vector<std::thread> model_thread_run;
   for (int parallel_num_idx = 0; parallel_num_idx < flags_->parallel_num_; parallel_num_idx++) {
     model_thread_run.push_back(
@@ -1237,9 +1239,33 @@ int BenchmarkUnifiedApi::ParallelInference(std::shared_ptr<mindspore::Context> c
   std::cout << "=================================" << std::endl;
   std::cout << "parallel predict init time: " << (model_init_end - model_init_start) / kFloatMSEC << " ms\n";
   std::cout << "parallel predict all run time: " << (end_run_time - start_run_time) / kFloatMSEC << " ms\n";
+  PrintParallelLatency((end_run_time - start_run_time) / kFloatMSEC);
   std::cout << "=================================" << std::endl;
   return RET_OK;
 }
+
+void BenchmarkUnifiedApi::PrintParallelLatency(float all_run_time_ms) {
+  std::vector<float> latencies;
+  for (auto &thread_latencies : parallel_latencies_) {
+    latencies.insert(latencies.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+  if (latencies.empty() || all_run_time_ms <= 0) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](float ratio) {
+    auto index = static_cast<size_t>(ratio * static_cast<float>(latencies.size() - 1) + 0.5f);
+    return latencies[std::min(index, latencies.size() - 1)];
+  };
+  constexpr float kP50 = 0.5f;
+  constexpr float kP90 = 0.9f;
+  constexpr float kP99 = 0.99f;
+  constexpr float kMsPerSecond = 1000.0f;
+  std::cout << "parallel predict request num: " << latencies.size()
+            << " | qps: " << latencies.size() * kMsPerSecond / all_run_time_ms << "\n";
+  std::cout << "parallel predict latency p50: " << percentile(kP50) << " ms | p90: " << percentile(kP90)
+            << " ms | p99: " << percentile(kP99) << " ms | max: " << latencies.back() << " ms\n";
+}
 #endif
 
 int BenchmarkUnifiedApi::PrintOutputData() {
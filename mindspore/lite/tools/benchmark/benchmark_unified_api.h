@@ -104,6 +104,7 @@ class MS_API BenchmarkUnifiedApi : public BenchmarkBase {
   void ModelParallelRunnerRun(int task_num, int parallel_idx);
   int ParallelInference(std::shared_ptr<mindspore::Context> context);
   int AddConfigInfo(const std::shared_ptr<RunnerConfig> &runner_config);
+  void PrintParallelLatency(float all_run_time_ms);
 #endif
 
   int PrintOutputData();
@@ -141,6 +142,8 @@ class MS_API BenchmarkUnifiedApi : public BenchmarkBase {
   std::vector<std::vector<mindspore::MSTensor>> all_outputs_;
   std::atomic<bool> model_parallel_runner_ret_failed_{false};
   std::atomic<bool> runner_run_start_ = false;
+  // predict latency in ms of each parallel thread
+  std::vector<std::vector<float>> parallel_latencies_;
   mindspore::ModelParallelRunner model_runner_;
 #endif
 
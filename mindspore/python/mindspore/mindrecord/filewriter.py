@@ -471,9 +471,16 @@ class FileWriter:
             if os.path.exists(index_file):
                 os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
                 index_files.append(index_file)
+            columnar_index_file = item + ".idx"
+            if os.path.exists(columnar_index_file):
+                os.chmod(columnar_index_file, stat.S_IRUSR | stat.S_IWUSR)
 
         for item in self._paths:
             if os.path.exists(item):
+                # the columnar index is neither hashed nor encrypted, the reader falls back to the checked meta file
+                if (_get_hash_mode() is not None or _get_enc_key() is not None) and os.path.exists(item + ".idx"):
+                    os.remove(item + ".idx")
+
                 # add the integrity check string
                 if _get_hash_mode() is not None:
                     append_hash_to_file(item)
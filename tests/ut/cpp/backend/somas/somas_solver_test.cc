@@ -0,0 +1,230 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/common/somas/somas.h"
+#include "backend/common/somas/somas_solver_pre.h"
+
+namespace mindspore {
+namespace somas {
+namespace {
+constexpr size_t kSmallSize = 1024;
+constexpr size_t kLargeSize = 2048;
+
+// The tensor 0 lives in [0, 1], the tensor 1 lives in [1, 2] and the tensor 2 lives in [2, 3].
+ReuseConstraints BuildChainConstraints() {
+  ReuseConstraints constraints;
+  constraints.InitLifetimes(3);
+  constraints.SetLifetime(0, 0, 1);
+  constraints.SetLifetime(1, 1, 2);
+  constraints.SetLifetime(2, 2, 3);
+  return constraints;
+}
+
+TensorsDescMap BuildChainTensors(const std::vector<size_t> &sizes = {kSmallSize, kLargeSize, kSmallSize}) {
+  TensorsDescMap tensors;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    tensors[i] = std::make_shared<SomasSolverTensorDesc>(i, sizes[i], 0, false);
+  }
+  return tensors;
+}
+
+// The lifetimes of the tensors which overlap in several ways.
+const std::vector<std::pair<size_t, size_t>> kOverlappedLifetimes = {{0, 1}, {1, 3}, {2, 2}, {3, 5}, {4, 4}, {0, 5}};
+
+// The bitset matrix equivalent to the lifetime intervals: the tensors can reuse each other if the lifetimes don't
+// overlap.
+ReuseConstraints BuildMatrixFromLifetimes(const std::vector<std::pair<size_t, size_t>> &lifetimes) {
+  ReuseConstraints constraints;
+  constraints.InitMatrix(lifetimes.size());
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    for (size_t j = 0; j < lifetimes.size(); ++j) {
+      if (lifetimes[i].first > lifetimes[j].second || lifetimes[j].first > lifetimes[i].second) {
+        constraints.SetReuse(i, j);
+      }
+    }
+  }
+  return constraints;
+}
+
+// Check that the tensors which can't reuse each other don't share any byte of memory.
+void CheckNoConflictOverlap(const ReuseConstraints &constraints, const TensorsDescMap &tensors) {
+  for (const auto &[index1, tensor1] : tensors) {
+    for (const auto &[index2, tensor2] : tensors) {
+      if (index1 == index2 || constraints.CanReuse(index1, index2)) {
+        continue;
+      }
+      bool disjoint = tensor1->offset_ + tensor1->size_ <= tensor2->offset_ ||
+                      tensor2->offset_ + tensor2->size_ <= tensor1->offset_;
+      EXPECT_TRUE(disjoint) << "tensor " << index1 << " overlaps tensor " << index2;
+    }
+  }
+}
+}  // namespace
+
+class SomasSolverTest : public UT::Common {
+ public:
+  SomasSolverTest() = default;
+};
+
+/// Feature: Reuse constraints of somas.
+/// Description: Check the reuse relation of the lifetime intervals and the merged lifetime.
+/// Expectation: The tensors can reuse each other only if their lifetimes don't overlap and both are reusable.
+TEST_F(SomasSolverTest, LifetimeIntervalConstraints) {
+  auto constraints = BuildChainConstraints();
+  ASSERT_TRUE(constraints.is_interval());
+  ASSERT_TRUE(constraints.CanReuse(0, 2));
+  ASSERT_TRUE(constraints.CanReuse(2, 0));
+  ASSERT_FALSE(constraints.CanReuse(0, 1));
+  ASSERT_FALSE(constraints.CanReuse(1, 2));
+
+  // The tensor 0 covers the lifetime of tensor 1 after merged.
+  constraints.MergeLifetime(0, 1);
+  ASSERT_FALSE(constraints.CanReuse(0, 2));
+  ASSERT_EQ(constraints.MemorySize(), 3 * sizeof(TensorLifetime));
+
+  // The tensor without lifetime is not reusable.
+  constraints.InitLifetimes(2);
+  constraints.SetLifetime(0, 0, 1);
+  ASSERT_FALSE(constraints.CanReuse(0, 1));
+}
+
+/// Feature: Somas solver with the lifetime intervals.
+/// Description: Solve the chain of tensors by the full set of strategies and then by the best strategy only.
+/// Expectation: The tensors with disjoint lifetimes share the memory and the single strategy gets the same result.
+TEST_F(SomasSolverTest, SolveByLifetimeIntervals) {
+  auto constraints = BuildChainConstraints();
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto tensors = BuildChainTensors();
+  SomasSolverPre solver;
+  ASSERT_EQ(solver.Solving(*graph, &tensors, &constraints, {}, {}, true), SUCCESS);
+  ASSERT_EQ(solver.GetMaxOffset(), kSmallSize + kLargeSize);
+  ASSERT_EQ(tensors[0]->offset_, tensors[2]->offset_);
+
+  auto new_tensors = BuildChainTensors();
+  SomasSolverPre incremental_solver;
+  ASSERT_EQ(incremental_solver.Solving(*graph, &new_tensors, &constraints, {}, {}, true, false,
+                                       solver.GetBestSorting(), solver.GetBestFitting(), solver.GetBestAlgorithm()),
+            SUCCESS);
+  ASSERT_EQ(incremental_solver.GetMaxOffset(), solver.GetMaxOffset());
+}
+
+/// Feature: Solved model cache of somas.
+/// Description: Insert the solved models and fetch them by the same key, by the keys which differ slightly, and after
+/// more models than the capacity are inserted.
+/// Expectation: Only the exactly same key hits, and the least recently used model is evicted first.
+TEST_F(SomasSolverTest, SolvedModelCacheHitAndMiss) {
+  auto &cache = SolvedModelCache::GetInstance();
+  cache.Clear();
+  auto model = std::make_shared<SolvedModel>();
+  model->constraints_ = std::make_shared<ReuseConstraints>(BuildChainConstraints());
+  const std::string key = "Ascend 1 1 3 3\nN0 0:\nN1 0: 0\n";
+  cache.Insert(key, model);
+  ASSERT_EQ(cache.Fetch(key), model);
+  ASSERT_EQ(cache.Fetch(key + "N2 0: 1\n"), nullptr);
+  ASSERT_EQ(cache.Fetch("Ascend 1 1 3 3\nN0 0:\nN1 0: 1\n"), nullptr);
+
+  // The hit model becomes the most recently used one, so the other models are evicted before it.
+  constexpr size_t kCapacity = 8;
+  for (size_t i = 0; i < kCapacity; ++i) {
+    cache.Insert("graph_" + std::to_string(i), std::make_shared<SolvedModel>(*model));
+    ASSERT_NE(cache.Fetch(key), nullptr);
+  }
+  ASSERT_EQ(cache.size(), kCapacity);
+  ASSERT_EQ(cache.Fetch(key), model);
+  ASSERT_EQ(cache.Fetch("graph_0"), nullptr);
+  cache.Clear();
+  ASSERT_EQ(cache.Fetch(key), nullptr);
+}
+
+/// Feature: Incremental re-solve of somas.
+/// Description: Solve the chain of tensors and cache the solved model, then reuse the cached constraints and the best
+/// strategy for the chain of the same structure whose tensor sizes changed, like another bucket of dynamic shape.
+/// Expectation: The reused model gives a valid layout of the new sizes, as small as the full solve of them.
+TEST_F(SomasSolverTest, ReuseSolvedModelWithChangedSizes) {
+  auto &cache = SolvedModelCache::GetInstance();
+  cache.Clear();
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto constraints = std::make_shared<ReuseConstraints>(BuildChainConstraints());
+  auto tensors = BuildChainTensors();
+  SomasSolverPre solver;
+  ASSERT_EQ(solver.Solving(*graph, &tensors, constraints.get(), {}, {}, true), SUCCESS);
+  auto model = std::make_shared<SolvedModel>();
+  model->constraints_ = constraints;
+  model->sorting_ = solver.GetBestSorting();
+  model->fitting_ = solver.GetBestFitting();
+  model->algorithm_ = solver.GetBestAlgorithm();
+  const std::string key = "chain";
+  cache.Insert(key, model);
+
+  const std::vector<size_t> new_sizes = {kLargeSize * 2, kSmallSize / 2, kLargeSize};
+  auto cached = cache.Fetch(key);
+  ASSERT_NE(cached, nullptr);
+  auto new_tensors = BuildChainTensors(new_sizes);
+  SomasSolverPre incremental_solver;
+  ASSERT_EQ(incremental_solver.Solving(*graph, &new_tensors, cached->constraints_.get(), {}, {}, true, false,
+                                       cached->sorting_, cached->fitting_, cached->algorithm_),
+            SUCCESS);
+  CheckNoConflictOverlap(*cached->constraints_, new_tensors);
+  ASSERT_EQ(new_tensors[0]->offset_, new_tensors[2]->offset_);
+
+  auto full_tensors = BuildChainTensors(new_sizes);
+  SomasSolverPre full_solver;
+  ASSERT_EQ(full_solver.Solving(*graph, &full_tensors, cached->constraints_.get(), {}, {}, true), SUCCESS);
+  ASSERT_EQ(incremental_solver.GetMaxOffset(), full_solver.GetMaxOffset());
+  ASSERT_EQ(incremental_solver.GetMaxOffset(), new_sizes[0] + new_sizes[1]);
+  cache.Clear();
+}
+
+/// Feature: Reuse constraints of somas.
+/// Description: Build the lifetime intervals and the equivalent bitset matrix of the overlapped lifetimes, and solve
+/// the same tensors by both.
+/// Expectation: Both constraints give the same reuse relation of every pair and the same memory layout.
+TEST_F(SomasSolverTest, IntervalAndBitsetConstraintsEquivalent) {
+  ReuseConstraints intervals;
+  intervals.InitLifetimes(kOverlappedLifetimes.size());
+  for (size_t i = 0; i < kOverlappedLifetimes.size(); ++i) {
+    intervals.SetLifetime(i, kOverlappedLifetimes[i].first, kOverlappedLifetimes[i].second);
+  }
+  auto matrix = BuildMatrixFromLifetimes(kOverlappedLifetimes);
+  ASSERT_TRUE(intervals.is_interval());
+  ASSERT_FALSE(matrix.is_interval());
+  for (size_t i = 0; i < kOverlappedLifetimes.size(); ++i) {
+    for (size_t j = 0; j < kOverlappedLifetimes.size(); ++j) {
+      ASSERT_EQ(intervals.CanReuse(i, j), matrix.CanReuse(i, j)) << "tensor " << i << " and tensor " << j;
+    }
+  }
+
+  const std::vector<size_t> sizes = {kSmallSize, kLargeSize, kSmallSize, kLargeSize, kSmallSize, kSmallSize};
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto interval_tensors = BuildChainTensors(sizes);
+  SomasSolverPre interval_solver;
+  ASSERT_EQ(interval_solver.Solving(*graph, &interval_tensors, &intervals, {}, {}, true), SUCCESS);
+  auto matrix_tensors = BuildChainTensors(sizes);
+  SomasSolverPre matrix_solver;
+  ASSERT_EQ(matrix_solver.Solving(*graph, &matrix_tensors, &matrix, {}, {}, true), SUCCESS);
+  CheckNoConflictOverlap(intervals, interval_tensors);
+  CheckNoConflictOverlap(matrix, matrix_tensors);
+  ASSERT_EQ(interval_solver.GetMaxOffset(), matrix_solver.GetMaxOffset());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    ASSERT_EQ(interval_tensors[i]->offset_, matrix_tensors[i]->offset_) << "tensor " << i;
+  }
+}
+}  // namespace somas
+}  // namespace mindspore
@@ -64,6 +64,16 @@ class DummyPool : public DynamicMemPoolBestFit {
   std::unordered_set<DeviceMemPtr> allocated_mems_;
 };
 
+class DummyCachedPool : public DummyPool {
+ public:
+  const bool IsEnableMemBufCache() const override { return true; }
+};
+
+class DummyDefragmentPool : public DummyPool {
+ public:
+  const bool IsEnableDefragment() const override { return true; }
+};
+
 class TestMemDynamicAllocator : public UT::Common {
  public:
   TestMemDynamicAllocator() = default;
@@ -73,6 +83,8 @@ class TestMemDynamicAllocator : public UT::Common {
   void TearDown() override {}
 
   DummyPool mem_pool_;
+  DummyCachedPool cached_mem_pool_;
+  DummyDefragmentPool defragment_mem_pool_;
 };
 
 /// Feature: test basic memory allocation from mem dynamic allocator.
@@ -217,5 +229,99 @@ TEST_F(TestMemDynamicAllocator, test_malloc_with_multi_stream_id) {
   mem_pool_.FreeTensorMem(addr2);
   EXPECT_EQ(persitent_mem_pool->idle_mem_bufs_[stream1].size(), expected_size_two);
 }
+
+/// Feature: test memory alloc and free by the fast path of mem buf cache.
+/// Description: test the cached memory buf is reused by the same size and stream, and returned when draining.
+/// Expectation: all interface work normally and can not throw exception.
+TEST_F(TestMemDynamicAllocator, test_mem_buf_cache) {
+  uint32_t stream0 = 0;
+  uint32_t stream1 = 1;
+  constexpr size_t kSmallSize = 1024;
+  auto common_mem_pool = cached_mem_pool_.common_mem();
+  auto addr1 = cached_mem_pool_.AllocTensorMem(kSmallSize, false, false, stream0);
+  auto used_size = cached_mem_pool_.TotalUsedMemStatistics();
+  // Free into the cache, the memory buf keeps the used status.
+  cached_mem_pool_.FreeTensorMem(addr1);
+  EXPECT_EQ(cached_mem_pool_.MemBufCacheStatistics(), kSmallSize);
+  EXPECT_EQ(cached_mem_pool_.TotalUsedMemStatistics(), used_size);
+  // The same size and stream hits the cache.
+  auto addr2 = cached_mem_pool_.AllocTensorMem(kSmallSize, false, false, stream0);
+  EXPECT_EQ(addr2, addr1);
+  EXPECT_EQ(cached_mem_pool_.MemBufCacheStatistics(), expected_size_zero);
+  // The other stream can't reuse the cached memory buf.
+  cached_mem_pool_.FreeTensorMem(addr2);
+  auto addr3 = cached_mem_pool_.AllocTensorMem(kSmallSize, false, false, stream1);
+  EXPECT_NE(addr3, addr1);
+  // Drain returns the cached memory buf to the best-fit index.
+  cached_mem_pool_.DrainMemBufCache(stream0);
+  EXPECT_EQ(cached_mem_pool_.MemBufCacheStatistics(), expected_size_zero);
+  EXPECT_EQ(common_mem_pool->idle_mem_bufs_[stream0].size(), expected_size_one);
+  cached_mem_pool_.FreeTensorMem(addr3);
+  cached_mem_pool_.DrainAllMemBufCache();
+  EXPECT_EQ(cached_mem_pool_.TotalUsedMemStatistics(), expected_size_zero);
+  // The continuous memory is split, so it is freed by the locked path.
+  auto addr_list = cached_mem_pool_.AllocContinuousTensorMem({kSmallSize, kSmallSize}, stream0);
+  EXPECT_EQ(addr_list.size(), expected_size_two);
+  cached_mem_pool_.FreeTensorMem(addr_list[0]);
+  EXPECT_EQ(cached_mem_pool_.MemBufCacheStatistics(), expected_size_zero);
+}
+
+/// Feature: test the fragmentation statistics and defragmentation of mem dynamic allocator.
+/// Description: alloc fails because the idle memory is not continuous, the idle memory blocks are released.
+/// Expectation: the memory pool is defragmented rather than extended and the alloc succeeds.
+TEST_F(TestMemDynamicAllocator, test_defragment) {
+  auto common_mem_pool = defragment_mem_pool_.common_mem();
+  const size_t block_num = 10;
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < block_num; i++) {
+    addrs.emplace_back(defragment_mem_pool_.AllocTensorMem(kSize1G, false, false));
+  }
+  EXPECT_EQ(common_mem_pool->mem_block_list_.size(), block_num);
+  // Free two memory blocks, the idle memory is enough but not continuous.
+  defragment_mem_pool_.FreeTensorMem(addrs[0]);
+  defragment_mem_pool_.FreeTensorMem(addrs[1]);
+  auto stream_infos = defragment_mem_pool_.StreamFragmentationStatistics();
+  EXPECT_EQ(stream_infos[kDefaultStreamId].total_idle_size_, kSize1G * 2);
+  EXPECT_EQ(stream_infos[kDefaultStreamId].largest_idle_size_, kSize1G);
+  EXPECT_EQ(stream_infos[kDefaultStreamId].idle_buf_count_, expected_size_two);
+  EXPECT_EQ(defragment_mem_pool_.BlockFragmentationStatistics().size(), block_num);
+  // The idle memory blocks are released, and a continuous memory block is added.
+  auto addr = defragment_mem_pool_.AllocTensorMem(kSize1G * 2, false, false);
+  EXPECT_NE(addr, nullptr);
+  EXPECT_EQ(defragment_mem_pool_.DefragmentCountStatistics(), expected_size_one);
+  EXPECT_EQ(common_mem_pool->mem_block_list_.size(), block_num - 1);
+  EXPECT_EQ(defragment_mem_pool_.TotalMemStatistics(), kTotalMem);
+  EXPECT_EQ(defragment_mem_pool_.TotalIdleMemStatistics(), expected_size_zero);
+}
+
+/// Feature: test the defragmentation of mem dynamic allocator when nothing can be released.
+/// Description: the idle memory is in partially used memory blocks, or in the pool other than the one of the alloc.
+/// Expectation: the memory pool is extended and the defragment count is not increased.
+TEST_F(TestMemDynamicAllocator, test_defragment_without_release) {
+  const size_t half_size = kSize1G / 2;
+  DummyDefragmentPool partial_pool;
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < 4; i++) {
+    addrs.emplace_back(partial_pool.AllocTensorMem(half_size, false, false));
+  }
+  EXPECT_EQ(partial_pool.common_mem()->mem_block_list_.size(), expected_size_two);
+  partial_pool.FreeTensorMem(addrs[0]);
+  partial_pool.FreeTensorMem(addrs[2]);
+  EXPECT_NE(partial_pool.AllocTensorMem(kSize1G, false, false), nullptr);
+  EXPECT_EQ(partial_pool.DefragmentCountStatistics(), expected_size_zero);
+  EXPECT_EQ(partial_pool.common_mem()->mem_block_list_.size(), expected_size_three);
+
+  DummyDefragmentPool persistent_pool;
+  addrs.clear();
+  for (size_t i = 0; i < 4; i++) {
+    addrs.emplace_back(persistent_pool.AllocTensorMem(kSize1G, false, false));
+  }
+  persistent_pool.FreeTensorMem(addrs[0]);
+  persistent_pool.FreeTensorMem(addrs[1]);
+  EXPECT_NE(persistent_pool.AllocTensorMem(kSize1G * 2, true, false), nullptr);
+  EXPECT_EQ(persistent_pool.DefragmentCountStatistics(), expected_size_zero);
+  EXPECT_EQ(persistent_pool.common_mem()->mem_block_list_.size(), 4u);
+  EXPECT_EQ(persistent_pool.persistent_mem()->mem_block_list_.size(), expected_size_one);
+}
 }  // namespace device
 }  // namespace mindspore
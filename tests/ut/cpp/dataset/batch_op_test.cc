@@ -20,6 +20,7 @@
 // #include "minddata/dataset/core/tensor.h"
 // #include "minddata/dataset/core/tensor_shape.h"
 // #include "minddata/dataset/engine/datasetops/batch_op.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -136,3 +137,54 @@ TEST_F(MindDataTestBatchOp, DISABLED_TestSimpleBatchPadding) {
     EXPECT_TRUE(rc.IsOk());
   }
 }
+
+// Feature: Test Batch op with the pool of output buffers
+// Description: Batch the rows of different shapes with padding, by PadColumns and BatchRows and by BatchRowsWithPool
+// Expectation: The batched tensors should be the same, and the buffer should be reused after the batch is released
+TEST_F(MindDataTestBatchOp, TestBatchRowsWithPool) {
+  std::shared_ptr<Tensor> pad_value;
+  ASSERT_OK(Tensor::CreateScalar<float>(-1, &pad_value));
+  PadInfo pad_info;
+  pad_info.insert({"col_2d", std::make_pair(TensorShape({-1, 3}), pad_value)});
+  std::unordered_map<std::string, int32_t> column_name_id_map = {{"col_2d", 0}, {"col_scalar", 1}, {"col_str", 2}};
+
+  auto make_table = [](std::unique_ptr<TensorQTable> *table) {
+    *table = std::make_unique<TensorQTable>();
+    for (int32_t row_id = 0; row_id < 4; ++row_id) {
+      std::vector<int32_t> values(static_cast<size_t>((row_id + 1) * 2), row_id);
+      std::shared_ptr<Tensor> col_2d, col_scalar, col_str;
+      ASSERT_OK(Tensor::CreateFromVector(values, TensorShape({row_id + 1, 2}), &col_2d));
+      ASSERT_OK(Tensor::CreateScalar<double>(row_id * 0.5, &col_scalar));
+      ASSERT_OK(Tensor::CreateScalar<std::string>(std::to_string(row_id), &col_str));
+      (*table)->emplace_back(TensorRow(row_id, {col_2d, col_scalar, col_str}));
+    }
+  };
+
+  std::unique_ptr<TensorQTable> expected_table;
+  make_table(&expected_table);
+  TensorRow expected_row;
+  ASSERT_OK(BatchOp::PadColumns(&expected_table, pad_info, column_name_id_map));
+  ASSERT_OK(BatchOp::BatchRows(&expected_table, &expected_row));
+
+  auto pool = std::make_shared<BatchBufferPool>(1024 * 1024);
+  const uchar *first_buffer = nullptr;
+  for (int32_t epoch = 0; epoch < 2; ++epoch) {
+    std::unique_ptr<TensorQTable> table;
+    make_table(&table);
+    TensorRow batched_row;
+    ASSERT_OK(BatchOp::BatchRowsWithPool(&table, &batched_row, true, pad_info, column_name_id_map, false, pool));
+    ASSERT_EQ(batched_row.size(), expected_row.size());
+    for (size_t col_id = 0; col_id < batched_row.size(); ++col_id) {
+      EXPECT_EQ(batched_row[col_id]->shape(), expected_row[col_id]->shape());
+      EXPECT_TRUE(*(batched_row[col_id]) == *(expected_row[col_id]));
+    }
+    if (epoch == 0) {
+      first_buffer = batched_row[0]->GetBuffer();
+    } else {
+      // the buffer of the first batch has been given back to the pool and is taken again
+      EXPECT_EQ(batched_row[0]->GetBuffer(), first_buffer);
+    }
+  }
+  EXPECT_GT(pool->HitCount(), 0u);
+  EXPECT_GT(pool->CachedBytes(), 0);
+}
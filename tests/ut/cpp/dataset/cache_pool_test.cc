@@ -0,0 +1,179 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
+#include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+#include "minddata/dataset/engine/cache/cache_server.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+constexpr size_t kRowSize = 4096;
+constexpr float kMemoryCapRatio = 0.01;
+constexpr int32_t kNumWorkers = 1;
+constexpr int32_t kPort = 50052;
+constexpr int32_t kSharedMemSzInGb = 1;
+constexpr int8_t kLogLevel = 1;
+}  // namespace
+
+class MindDataTestCachePool : public UT::DatasetOpTesting {
+ public:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    GlobalInit();
+    numa_pool_ = std::make_shared<NumaMemoryPool>(std::make_shared<CacheServerHW>(), kMemoryCapRatio);
+    ASSERT_GT(numa_pool_->GetAvailableMemory(), 0);
+  }
+
+  void TearDown() override {
+    (void)unsetenv("MS_DEV_DATASET_CACHE_TIERING");
+    (void)unsetenv("MS_DEV_DATASET_CACHE_HOT_RATIO");
+  }
+
+  // Turn on the tiering with the hot tier which holds the given number of rows and a half.
+  void EnableTiering(int64_t hot_row_num) {
+    std::ostringstream ratio;
+    ratio << std::setprecision(9)
+          << (hot_row_num + 0.5) * kRowSize / static_cast<double>(numa_pool_->GetAvailableMemory());
+    (void)setenv("MS_DEV_DATASET_CACHE_TIERING", "1", 1);
+    (void)setenv("MS_DEV_DATASET_CACHE_HOT_RATIO", ratio.str().c_str(), 1);
+  }
+
+  // Read the row, which triggers the promotion if it has been located often enough.
+  std::vector<uint8_t> ReadRow(const std::shared_ptr<CachePool> &cp, CachePool::key_type key) {
+    std::vector<uint8_t> row(kRowSize, 0);
+    WritableSlice dest(row.data(), row.size());
+    size_t bytes_read = 0;
+    EXPECT_OK(cp->Read(key, &dest, &bytes_read));
+    EXPECT_EQ(bytes_read, kRowSize);
+    return row;
+  }
+
+  // Locate the row as the cache service does before each fetch of the row.
+  void LocateRow(const std::shared_ptr<CachePool> &cp, CachePool::key_type key, int times) {
+    for (int i = 0; i < times; ++i) {
+      auto fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
+      flatbuffers::Offset<DataLocatorMsg> offset;
+      EXPECT_OK(cp->GetDataLocator(key, fbb, &offset));
+    }
+  }
+
+  std::shared_ptr<NumaMemoryPool> numa_pool_;
+};
+
+/// Feature: CachePool
+/// Description: Insert compressible rows beyond the hot tier, then locate and read a warm row often enough.
+/// Expectation: The warm row is promoted, the idle hot row is demoted, and all the rows read back unchanged.
+TEST_F(MindDataTestCachePool, TestHotWarmPromoteDemote) {
+  constexpr int64_t kHotRowNum = 2;
+  constexpr int64_t kRowNum = 4;
+  EnableTiering(kHotRowNum);
+  auto cp = std::make_shared<CachePool>(numa_pool_);
+  ASSERT_OK(cp->ServiceStart());
+
+  std::vector<std::vector<uint8_t>> rows;
+  for (int64_t i = 0; i < kRowNum; ++i) {
+    (void)rows.emplace_back(kRowSize, static_cast<uint8_t>(i + 1));
+    ASSERT_OK(cp->Insert(i, {ReadableSlice(rows[i].data(), kRowSize)}));
+  }
+  auto stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, kHotRowNum);
+  EXPECT_EQ(stat.num_compressed_cached, kRowNum - kHotRowNum);
+  EXPECT_EQ(stat.num_disk_cached, 0);
+
+  // The warm row reads back before it is promoted.
+  const CachePool::key_type warm_key = kRowNum - 1;
+  EXPECT_EQ(ReadRow(cp, warm_key), rows[warm_key]);
+  LocateRow(cp, warm_key, 2);
+  EXPECT_EQ(ReadRow(cp, warm_key), rows[warm_key]);
+
+  // The first hot row is never located, so it gives its place to the promoted row.
+  stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, kHotRowNum);
+  EXPECT_EQ(stat.num_compressed_cached, kRowNum - kHotRowNum);
+  EXPECT_EQ(stat.num_warm_hit, 2);
+  LocateRow(cp, warm_key, 1);
+  LocateRow(cp, 0, 1);
+  stat = cp->GetStat();
+  EXPECT_EQ(stat.num_hot_hit, 1);
+  EXPECT_EQ(stat.num_warm_hit, 3);
+  for (int64_t i = 0; i < kRowNum; ++i) {
+    EXPECT_EQ(ReadRow(cp, i), rows[i]);
+  }
+  ASSERT_OK(cp->ServiceStop());
+}
+
+/// Feature: CachePool
+/// Description: Insert incompressible rows beyond the hot tier with a spill folder, then promote a spilled row.
+/// Expectation: The rows are spilled, the promoted row swaps with the idle hot row, and all rows read back unchanged.
+TEST_F(MindDataTestCachePool, TestColdPromoteDemote) {
+  constexpr int64_t kHotRowNum = 1;
+  constexpr int64_t kRowNum = 3;
+  // The spill folder is a unique subfolder of the root, which is removed when the pool stops.
+  std::string spill_path = ".";
+  ASSERT_OK(CacheServer::CreateInstance(spill_path, kNumWorkers, kPort, kSharedMemSzInGb, kMemoryCapRatio, kLogLevel,
+                                        std::make_shared<CacheServerHW>()));
+  EnableTiering(kHotRowNum);
+  auto cp = std::make_shared<CachePool>(numa_pool_, spill_path);
+  ASSERT_OK(cp->ServiceStart());
+
+  // The random bytes never compress well, so the rows beyond the hot tier go to the cold tier.
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> dist(0, UINT8_MAX);
+  std::vector<std::vector<uint8_t>> rows(kRowNum, std::vector<uint8_t>(kRowSize));
+  for (int64_t i = 0; i < kRowNum; ++i) {
+    for (auto &byte : rows[i]) {
+      byte = static_cast<uint8_t>(dist(gen));
+    }
+    ASSERT_OK(cp->Insert(i, {ReadableSlice(rows[i].data(), kRowSize)}));
+  }
+  auto stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, kHotRowNum);
+  EXPECT_EQ(stat.num_compressed_cached, 0);
+  EXPECT_EQ(stat.num_disk_cached, kRowNum - kHotRowNum);
+  for (int64_t i = 0; i < kRowNum; ++i) {
+    EXPECT_EQ(ReadRow(cp, i), rows[i]);
+  }
+
+  // Promote the last row from the disk, and the first row is demoted back to the disk.
+  const CachePool::key_type cold_key = kRowNum - 1;
+  LocateRow(cp, cold_key, 2);
+  EXPECT_EQ(ReadRow(cp, cold_key), rows[cold_key]);
+  stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, kHotRowNum);
+  EXPECT_EQ(stat.num_disk_cached, kRowNum - kHotRowNum);
+  EXPECT_EQ(stat.num_cold_hit, 2);
+  LocateRow(cp, 0, 1);
+  LocateRow(cp, cold_key, 1);
+  stat = cp->GetStat();
+  EXPECT_EQ(stat.num_cold_hit, 3);
+  EXPECT_EQ(stat.num_hot_hit, 1);
+  for (int64_t i = 0; i < kRowNum; ++i) {
+    EXPECT_EQ(ReadRow(cp, i), rows[i]);
+  }
+  ASSERT_OK(cp->ServiceStop());
+}
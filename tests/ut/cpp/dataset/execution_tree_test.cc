@@ -13,7 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <string>
+#include <vector>
 #include "minddata/dataset/util/circular_pool.h"
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/execution_tree.h"
@@ -112,3 +114,53 @@ TEST_F(MindDataTestExecutionTree, TestExecutionTree2) {
   rc = my_tree->Launch();
   ASSERT_OK(rc);
 }
+
+/// Feature: Execution Tree
+/// Description: Test ShuffleOp over TFReaderOp with the shuffle buffer bounded in bytes
+/// Expectation: The buffer never holds more bytes than the limit, and the shuffled rows are a permutation of the
+///     rows read sequentially
+TEST_F(MindDataTestExecutionTree, TestShuffleBoundedBuffer) {
+  MS_LOG(INFO) << "Doing MindDataTestExecutionTree-TestShuffleBoundedBuffer.";
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  // Serialize each row, so that the rows can be compared regardless of their order
+  auto collect_rows = [](const std::shared_ptr<ExecutionTree> &tree, std::vector<std::string> *rows,
+                         int64_t *total_bytes) {
+    ASSERT_OK(tree->Prepare());
+    ASSERT_OK(tree->Launch());
+    DatasetIterator di(tree);
+    TensorRow tensor_list;
+    ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+    while (!tensor_list.empty()) {
+      std::string row;
+      for (const auto &tensor : tensor_list) {
+        row.append(reinterpret_cast<const char *>(tensor->GetBuffer()), tensor->SizeInBytes());
+        *total_bytes += tensor->SizeInBytes();
+      }
+      rows->push_back(std::move(row));
+      ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+    }
+  };
+
+  std::vector<std::string> expected_rows;
+  int64_t total_bytes = 0;
+  collect_rows(Build({TFReader(dataset_path, 1)}), &expected_rows, &total_bytes);
+  ASSERT_EQ(expected_rows.size(), 12u);
+
+  // The shuffle size covers the whole dataset, but the buffer is limited to the bytes of about 3 rows
+  constexpr int32_t kShuffleSize = 12;
+  constexpr int64_t kBufferedRows = 3;
+  int64_t max_buffer_bytes = total_bytes / static_cast<int64_t>(expected_rows.size()) * kBufferedRows;
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  auto shuffle_op = std::make_shared<ShuffleOp>(kShuffleSize, 0, config_manager->op_connector_size(), true);
+  shuffle_op->SetMaxBufferBytes(max_buffer_bytes);
+  std::vector<std::string> shuffled_rows;
+  int64_t shuffled_bytes = 0;
+  collect_rows(Build({TFReader(dataset_path, 1), shuffle_op}), &shuffled_rows, &shuffled_bytes);
+
+  EXPECT_GT(shuffle_op->PeakBufferMemoryUsage(), 0);
+  EXPECT_LE(shuffle_op->PeakBufferMemoryUsage(), max_buffer_bytes);
+  EXPECT_EQ(shuffled_bytes, total_bytes);
+  std::sort(expected_rows.begin(), expected_rows.end());
+  std::sort(shuffled_rows.begin(), shuffled_rows.end());
+  EXPECT_EQ(shuffled_rows, expected_rows);
+}
@@ -0,0 +1,216 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "distributed/embedding_cache/cache_strategy/cache_factory.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+// The environment variable of a recorded id stream file, in which the ids are separated by white spaces. A synthetic
+// skewed id stream is replayed if it is not set.
+constexpr auto kEnvReplayFile = "MS_EMBEDDING_CACHE_REPLAY_FILE";
+
+std::vector<int> LoadIdStream() {
+  std::vector<int> ids;
+  std::string replay_file = common::GetEnv(kEnvReplayFile);
+  if (replay_file.empty()) {
+    return ids;
+  }
+  std::ifstream ifs(replay_file);
+  int id = 0;
+  while (ifs >> id) {
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+// Generate a Zipf distributed id stream like the CTR workloads, with a sequential scan of cold ids in the middle.
+std::vector<int> GenerateIdStream(size_t id_num, size_t access_num) {
+  const double kSkew = 0.9;
+  std::vector<double> cdf(id_num);
+  double sum = 0;
+  for (size_t i = 0; i < id_num; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), kSkew);
+    cdf[i] = sum;
+  }
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(0, sum);
+  std::vector<int> ids;
+  ids.reserve(access_num + id_num);
+  for (size_t i = 0; i < access_num; ++i) {
+    if (i == access_num / 2) {
+      for (size_t j = 0; j < id_num; ++j) {
+        ids.push_back(static_cast<int>(id_num + j));
+      }
+    }
+    ids.push_back(static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin()));
+  }
+  return ids;
+}
+
+// Replay the id stream as the embedding storage does: look up the cache first, evict one element if the cache is full
+// and insert the missed id. The element reported by Back must be the one evicted.
+CacheStatistics Replay(Cache<int, int> *cache, const std::vector<int> &ids) {
+  int value = 0;
+  std::vector<Cache<int, int>::Element> evicted_elements;
+  for (auto id : ids) {
+    if (cache->Get(id, &value)) {
+      EXPECT_EQ(value, id);
+      continue;
+    }
+    if (cache->IsFull()) {
+      auto back = cache->Back();
+      evicted_elements.clear();
+      cache->TryEvict(1, &evicted_elements);
+      EXPECT_EQ(evicted_elements.size(), 1);
+      EXPECT_EQ(evicted_elements.front(), back);
+    }
+    cache->Put(id, id);
+  }
+  EXPECT_EQ(cache->Export().size(), cache->size());
+  return cache->statistics();
+}
+}  // namespace
+
+class TestCachePolicy : public UT::Common {
+ public:
+  TestCachePolicy() = default;
+  virtual ~TestCachePolicy() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+using Element = typename Cache<int, int>::Element;
+/// Feature: test lfu cache.
+/// Description: access elements with different frequencies and evict.
+/// Expectation: the least frequently used elements are evicted first.
+TEST_F(TestCachePolicy, test_lfu_cache) {
+  LFUCache<int, int> cache(3);
+  cache.Put(1, 11);
+  cache.Put(2, 22);
+  cache.Put(3, 33);
+  EXPECT_TRUE(cache.IsFull());
+  EXPECT_THROW(cache.Put(4, 44), std::runtime_error);
+
+  int value = 0;
+  EXPECT_TRUE(cache.Get(1, &value));
+  EXPECT_EQ(value, 11);
+  EXPECT_TRUE(cache.Get(1, &value));
+  EXPECT_TRUE(cache.Get(3, &value));
+  EXPECT_FALSE(cache.Get(4, &value));
+  EXPECT_EQ(cache.Front(), Element(1, 11));
+  EXPECT_EQ(cache.Back(), Element(2, 22));
+  EXPECT_EQ(cache.Export(), (std::vector<Element>{{1, 11}, {3, 33}, {2, 22}}));
+
+  std::vector<Element> evicted_elements;
+  cache.TryEvict(2, &evicted_elements);
+  EXPECT_EQ(evicted_elements, (std::vector<Element>{{2, 22}, {3, 33}}));
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_TRUE(cache.Exists(1));
+
+  const auto &statistics = cache.statistics();
+  EXPECT_EQ(statistics.hit_count, 3);
+  EXPECT_EQ(statistics.miss_count, 1);
+  EXPECT_EQ(statistics.evict_count, 2);
+  EXPECT_THROW(cache.TryEvict(4, &evicted_elements), std::runtime_error);
+}
+
+/// Feature: test w-tinylfu cache.
+/// Description: access hot elements, then scan a lot of elements accessed only once.
+/// Expectation: the hot elements are kept in cache and Back is the element evicted by TryEvict.
+TEST_F(TestCachePolicy, test_tiny_lfu_cache) {
+  const int kCapacity = 100;
+  const int kHotNum = 50;
+  TinyLFUCache<int, int> cache(kCapacity);
+  int value = 0;
+  std::vector<Element> evicted_elements;
+  for (int round = 0; round < 3; ++round) {
+    for (int id = 0; id < kHotNum; ++id) {
+      if (!cache.Get(id, &value)) {
+        cache.Put(id, id);
+      }
+    }
+  }
+  for (int id = kHotNum; id < kHotNum + 10 * kCapacity; ++id) {
+    EXPECT_FALSE(cache.Get(id, &value));
+    if (cache.IsFull()) {
+      auto back = cache.Back();
+      evicted_elements.clear();
+      cache.TryEvict(1, &evicted_elements);
+      EXPECT_EQ(evicted_elements.size(), 1);
+      EXPECT_EQ(evicted_elements.front(), back);
+    }
+    cache.Put(id, id);
+  }
+  EXPECT_EQ(cache.size(), kCapacity);
+  // The hot ids hit in the probation segment are protected. The last hot id is hit in the window instead, so it falls
+  // into probation and may lose to a scanned id whose frequency is overestimated by the sketch.
+  int kept_hot_num = 0;
+  for (int id = 0; id < kHotNum; ++id) {
+    kept_hot_num += cache.Exists(id) ? 1 : 0;
+  }
+  EXPECT_GE(kept_hot_num, kHotNum - 1);
+  EXPECT_EQ(cache.Export().size(), kCapacity);
+}
+
+/// Feature: test cache policy config.
+/// Description: parse the default policy and the policies of embedding tables.
+/// Expectation: the policy of table takes precedence, and the invalid policy throws exception.
+TEST_F(TestCachePolicy, test_cache_policy_config) {
+  EXPECT_EQ(GetCachePolicy("", -1), CachePolicy::kLRU);
+  EXPECT_EQ(GetCachePolicy("lfu", 3), CachePolicy::kLFU);
+  EXPECT_EQ(GetCachePolicy("3:tinylfu,lfu", 3), CachePolicy::kTinyLFU);
+  EXPECT_EQ(GetCachePolicy("3:tinylfu,lfu", 5), CachePolicy::kLFU);
+  EXPECT_EQ(GetCachePolicy("3:tinylfu", -1), CachePolicy::kLRU);
+  EXPECT_THROW(GetCachePolicy("arc", -1), std::runtime_error);
+  EXPECT_THROW(GetCachePolicy("a:lfu", 1), std::runtime_error);
+}
+
+/// Feature: replay id stream against each cache policy.
+/// Description: replay the recorded id stream set by MS_EMBEDDING_CACHE_REPLAY_FILE, or a synthetic skewed id stream.
+/// Expectation: all policies work normally, and the frequency based policies beat lru on the synthetic stream.
+TEST_F(TestCachePolicy, test_replay_id_stream) {
+  const size_t kIdNum = 20000;
+  const size_t kAccessNum = 200000;
+  const size_t kCapacity = 1000;
+  auto ids = LoadIdStream();
+  bool synthetic = ids.empty();
+  if (synthetic) {
+    ids = GenerateIdStream(kIdNum, kAccessNum);
+  }
+  std::vector<CacheStatistics> results;
+  for (auto policy : {CachePolicy::kLRU, CachePolicy::kLFU, CachePolicy::kTinyLFU}) {
+    auto cache = CreateCache<int, int>(policy, kCapacity);
+    results.push_back(Replay(cache.get(), ids));
+    MS_LOG(INFO) << "Replay " << ids.size() << " ids with cache policy " << CachePolicyName(policy) << ", "
+                 << results.back().ToString();
+  }
+  if (synthetic) {
+    EXPECT_GT(results[1].hit_rate(), results[0].hit_rate());
+    EXPECT_GT(results[2].hit_rate(), results[0].hit_rate());
+  }
+}
+}  // namespace distributed
+}  // namespace mindspore
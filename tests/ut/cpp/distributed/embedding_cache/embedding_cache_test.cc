@@ -21,6 +21,11 @@
 #include <vector>
 #include <string>
 #include <random>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 
 #include "include/common/random.h"
 #include "include/backend/distributed/embedding_cache/embedding_cache_utils.h"
@@ -132,6 +137,67 @@ TEST_F(TestEmbeddingCache, test_embedding_cache) {
     EXPECT_EQ(0, *(host_address_ptr + i));
   }
 }
+
+/// Feature: test embedding cache.
+/// Description: run the pull task overlapped with the push task by the runner for steps, in which the push task waits
+/// for the pull task to start and the pull task waits for the push task to finish.
+/// Expectation: both tasks run on different threads in each step, the worker thread is reused by the steps, and the
+/// results of the tasks are combined.
+TEST_F(TestEmbeddingCache, test_overlapped_task_runner) {
+  constexpr int kStepNum = 3;
+  constexpr auto kTimeout = std::chrono::seconds(30);
+  OverlappedTaskRunner runner;
+  std::thread::id worker_id;
+  for (int step = 0; step < kStepNum; ++step) {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<std::string> events;
+    auto pull_task = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (step == 0) {
+        worker_id = std::this_thread::get_id();
+      }
+      EXPECT_EQ(worker_id, std::this_thread::get_id());
+      events.emplace_back("pull_start");
+      cond.notify_all();
+      EXPECT_TRUE(cond.wait_for(lock, kTimeout, [&events]() { return events.size() == 2; }));
+      events.emplace_back("pull_end");
+      return true;
+    };
+    auto push_task = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      EXPECT_TRUE(cond.wait_for(lock, kTimeout, [&events]() { return !events.empty(); }));
+      events.emplace_back("push");
+      cond.notify_all();
+      return true;
+    };
+    EXPECT_TRUE(runner.Run(pull_task, push_task));
+    EXPECT_EQ(events, std::vector<std::string>({"pull_start", "push", "pull_end"}));
+  }
+  EXPECT_NE(worker_id, std::this_thread::get_id());
+
+  EXPECT_FALSE(runner.Run([]() { return false; }, []() { return true; }));
+  EXPECT_FALSE(runner.Run([]() { return true; }, []() { return false; }));
+}
+
+/// Feature: test embedding cache.
+/// Description: throw an exception in the push task or in the pull task run by the runner.
+/// Expectation: the exception is rethrown to the caller after the pull task finishes, and the runner can run again.
+TEST_F(TestEmbeddingCache, test_overlapped_task_runner_exception) {
+  OverlappedTaskRunner runner;
+  bool pull_finished = false;
+  auto slow_pull_task = [&pull_finished]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pull_finished = true;
+    return true;
+  };
+  EXPECT_THROW(runner.Run(slow_pull_task, []() -> bool { throw std::runtime_error("push failed"); }),
+               std::runtime_error);
+  EXPECT_TRUE(pull_finished);
+  EXPECT_THROW(runner.Run([]() -> bool { throw std::runtime_error("pull failed"); }, []() { return true; }),
+               std::runtime_error);
+  EXPECT_TRUE(runner.Run([]() { return true; }, []() { return true; }));
+}
 }  // namespace persistent
 }  // namespace distributed
 }  // namespace mindspore
@@ -15,7 +15,6 @@
  */
 
 #include <vector>
-#include <list>
 
 #include "common/common_test.h"
 #include "distributed/embedding_cache/cache_strategy/lru_cache.h"
@@ -50,7 +49,7 @@ TEST_F(TestLRUCache, test_lru_cache) {
   EXPECT_EQ(origin_elements.size(), cache.size());
   EXPECT_FALSE(cache.IsFull());
 
-  std::list<Element> cache_elements = cache.Export();
+  std::vector<Element> cache_elements = cache.Export();
   auto vec_reverse_iter = origin_elements.rbegin();
   for (auto list_iter = cache_elements.begin(); list_iter != cache_elements.end(); ++list_iter, ++vec_reverse_iter) {
     EXPECT_EQ((*list_iter), (*vec_reverse_iter));
@@ -80,7 +79,7 @@ TEST_F(TestLRUCache, test_lru_cache) {
   EXPECT_EQ(value, 22);
   EXPECT_NO_THROW(cache.Put(1, 11));
 
-  std::list<Element> new_cache_elements = cache.Export();
+  std::vector<Element> new_cache_elements = cache.Export();
   auto vec_iter = origin_elements.begin();
   for (auto list_iter = new_cache_elements.begin(); list_iter != new_cache_elements.end(); ++list_iter, ++vec_iter) {
     EXPECT_EQ((*list_iter), (*vec_iter));
@@ -18,8 +18,11 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <atomic>
+#include <chrono>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 #include <csignal>
 
 #include <gtest/gtest.h>
@@ -37,6 +40,9 @@ int g_exit_msg_num = 0;
 
 static size_t g_data_msg_num = 0;
 
+constexpr size_t kWaitBatchRetryNum = 50;
+constexpr int64_t kWaitBatchIntervalMs = 10;
+
 static void Init() { g_data_msg_num = 0; }
 
 static bool WaitForDataMsg(size_t expected_msg_num, int timeout_in_sec) {
@@ -335,6 +341,118 @@ TEST_F(TCPTest, SendLargeMessages) {
   server->Finalize();
 }
 
+/// Feature: test batching and zero copy sending on the loopback.
+/// Description: send a lot of messages of different sizes asynchronously, with and without zero copy sending.
+/// Expectation: the server received all the messages in the order of sending, and the small messages were sent in
+/// fewer batches than messages.
+TEST_F(TCPTest, SendMessagesInBatchesOnLoopback) {
+  static std::atomic<size_t> disorder_num(0);
+  static std::atomic<uint32_t> expected_index(0);
+  std::vector<std::pair<size_t, size_t>> msg_sizes_and_nums = {{64, 5000}, {4096, 2000}, {1024000, 20}};
+  for (const auto &zero_copy_threshold : {"0", "16384"}) {
+    (void)setenv(kEnvRpcZeroCopyThreshold, zero_copy_threshold, 1);
+    std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+    ASSERT_TRUE(server->Initialize());
+    server->SetMessageHandler([](MessageBase *const message) -> MessageBase *const {
+      uint32_t index = 0;
+      (void)memcpy_s(&index, sizeof(index), message->body.data(), sizeof(index));
+      if (index != expected_index++) {
+        ++disorder_num;
+      }
+      IncrDataMsgNum(1);
+      return NULL_MSG;
+    });
+    std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+    ASSERT_TRUE(client->Initialize());
+    auto server_url = server->GetIP() + ":" + std::to_string(server->GetPort());
+    client->Connect(server_url);
+
+    for (const auto &[msg_size, msg_num] : msg_sizes_and_nums) {
+      Init();
+      disorder_num = 0;
+      expected_index = 0;
+      auto start_batch_num = client->GetSendBatchNum(server_url);
+      for (uint32_t i = 0; i < msg_num; ++i) {
+        auto message = CreateMessage(server_url, "127.0.0.1:1234", msg_size);
+        (void)memcpy_s(message->data, msg_size, &i, sizeof(i));
+        client->SendAsync(std::move(message));
+      }
+      EXPECT_TRUE(WaitForDataMsg(msg_num, 30));
+      EXPECT_EQ(msg_num, GetDataMsgNum());
+      EXPECT_EQ(0, disorder_num.load());
+      // The batch is counted after its sendmsg calls return, which may be later than the messages are received.
+      size_t batch_num = 0;
+      for (size_t retry = 0; retry < kWaitBatchRetryNum; ++retry) {
+        batch_num = client->GetSendBatchNum(server_url) - start_batch_num;
+        if (batch_num > 0) {
+          break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kWaitBatchIntervalMs));
+      }
+      EXPECT_GT(batch_num, 0u);
+      if (msg_size <= kDefaultBatchMessageSize) {
+        EXPECT_LT(batch_num, msg_num);
+      }
+      MS_LOG(INFO) << "Sent " << msg_num << " messages of " << msg_size << " bytes in " << batch_num
+                   << " batches with zero copy threshold " << zero_copy_threshold << ".";
+    }
+    client->Disconnect(server_url);
+    client->Finalize();
+    server->Finalize();
+  }
+  (void)unsetenv(kEnvRpcZeroCopyThreshold);
+}
+
+/// Feature: test the shared memory transport between the tcp client and server on the same host.
+/// Description: send messages larger than the shared memory ring, with and without the shared memory transport.
+/// Expectation: the connection goes through the shared memory only if enabled, and the server received all the
+/// messages in the order of sending.
+TEST_F(TCPTest, SendMessagesThroughShmOnLoopback) {
+  static std::atomic<size_t> disorder_num(0);
+  static std::atomic<uint32_t> expected_index(0);
+  std::vector<std::pair<size_t, size_t>> msg_sizes_and_nums = {{64, 5000}, {1024000, 20}};
+  (void)setenv(kEnvRpcShmBufferSize, "65536", 1);
+  for (const auto &shm_transport : {"1", "0"}) {
+    (void)setenv(kEnvRpcShmTransport, shm_transport, 1);
+    std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+    ASSERT_TRUE(server->Initialize());
+    server->SetMessageHandler([](MessageBase *const message) -> MessageBase *const {
+      uint32_t index = 0;
+      (void)memcpy_s(&index, sizeof(index), message->body.data(), sizeof(index));
+      if (index != expected_index++) {
+        ++disorder_num;
+      }
+      IncrDataMsgNum(1);
+      return NULL_MSG;
+    });
+    std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+    ASSERT_TRUE(client->Initialize());
+    auto server_url = server->GetIP() + ":" + std::to_string(server->GetPort());
+    client->Connect(server_url);
+    // The server on the loopback is on the same host, so the connection switches to the shared memory if enabled.
+    EXPECT_EQ(client->IsConnectedThroughShm(server_url), std::string(shm_transport) == "1");
+
+    for (const auto &[msg_size, msg_num] : msg_sizes_and_nums) {
+      Init();
+      disorder_num = 0;
+      expected_index = 0;
+      for (uint32_t i = 0; i < msg_num; ++i) {
+        auto message = CreateMessage(server_url, "127.0.0.1:1234", msg_size);
+        (void)memcpy_s(message->data, msg_size, &i, sizeof(i));
+        client->SendAsync(std::move(message));
+      }
+      EXPECT_TRUE(WaitForDataMsg(msg_num, 30));
+      EXPECT_EQ(msg_num, GetDataMsgNum());
+      EXPECT_EQ(0, disorder_num.load());
+    }
+    client->Disconnect(server_url);
+    client->Finalize();
+    server->Finalize();
+  }
+  (void)unsetenv(kEnvRpcShmTransport);
+  (void)unsetenv(kEnvRpcShmBufferSize);
+}
+
 /// Feature: test delete invalid tcp connection used in connection pool in tcp client when some socket error happened.
 /// Description: start a socket server and tcp client pair and stop the tcp server.
 /// Expectation: the connection from the tcp client to the tcp server will be deleted automatically.
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_async_io.h"
+#include "ut_common.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+constexpr size_t kFileSize = 1000003;
+constexpr size_t kRequestNum = 200;
+constexpr size_t kRequestSize = 4099;
+constexpr uint64_t kChunkSize = 65536;
+constexpr uint32_t kReadaheadNum = 4;
+const char kFileName[] = "./async_io.bin";
+}  // namespace
+
+class TestShardAsyncIO : public UT::Common {
+ public:
+  TestShardAsyncIO() {}
+
+  void SetUp() override {
+    data_.resize(kFileSize);
+    for (size_t i = 0; i < kFileSize; ++i) {
+      data_[i] = static_cast<uint8_t>(i * 7 % 251);
+    }
+    std::ofstream out(kFileName, std::ios::out | std::ios::binary);
+    out.write(reinterpret_cast<const char *>(data_.data()), static_cast<std::streamsize>(data_.size()));
+    out.close();
+  }
+
+  void TearDown() override { remove(kFileName); }
+
+  std::vector<uint8_t> data_;
+};
+
+/// Feature: Async io of mindrecord.
+/// Description: Submit a batch of reads, and read a read beyond the end of file.
+/// Expectation: The buffers are the same as the file, and the read beyond the end of file fails.
+TEST_F(TestShardAsyncIO, TestSubmitRead) {
+  MS_LOG(INFO) << FormatInfo("Test async io, io_uring enabled: " +
+                             std::to_string(AsyncIOEngine::GetInstance().IsIOUringEnabled()));
+  int fd = open(kFileName, O_RDONLY);
+  ASSERT_GE(fd, 0);
+  std::vector<std::shared_ptr<AsyncReadRequest>> requests;
+  for (size_t i = 0; i < kRequestNum; ++i) {
+    requests.push_back(std::make_shared<AsyncReadRequest>(fd, i * kRequestSize, kRequestSize));
+  }
+  ASSERT_TRUE(AsyncIOEngine::GetInstance().SubmitRead(requests).IsOk());
+  for (size_t i = 0; i < kRequestNum; ++i) {
+    ASSERT_TRUE(requests[i]->Wait().IsOk());
+    EXPECT_TRUE(requests[i]->IsDone());
+    EXPECT_EQ(memcmp(requests[i]->GetBuffer()->data(), data_.data() + i * kRequestSize, kRequestSize), 0);
+  }
+
+  auto request = std::make_shared<AsyncReadRequest>(fd, kFileSize - 1, kRequestSize);
+  ASSERT_TRUE(AsyncIOEngine::GetInstance().SubmitRead({request}).IsOk());
+  EXPECT_TRUE(request->Wait().IsError());
+  close(fd);
+}
+
+/// Feature: Async io of mindrecord.
+/// Description: Read the file sequentially with readahead.
+/// Expectation: The data is the same as the file, and the read beyond the end of file fails.
+TEST_F(TestShardAsyncIO, TestSequentialReader) {
+  AsyncSequentialReader reader(kChunkSize, kReadaheadNum);
+  ASSERT_TRUE(reader.Open(kFileName).IsOk());
+  std::vector<uint8_t> out(kFileSize);
+  size_t position = 0;
+  while (!reader.Eof()) {
+    size_t size = std::min(kRequestSize, kFileSize - position);
+    // skip the odd blocks and read the even blocks
+    bool skip = (position / kRequestSize) % 2 == 1;
+    ASSERT_TRUE(reader.Read(skip ? nullptr : out.data() + position, size).IsOk());
+    if (skip) {
+      (void)memcpy(out.data() + position, data_.data() + position, size);
+    }
+    position += size;
+  }
+  EXPECT_EQ(out, data_);
+  EXPECT_TRUE(reader.Read(out.data(), 1).IsError());
+}
+}  // namespace mindrecord
+}  // namespace mindspore
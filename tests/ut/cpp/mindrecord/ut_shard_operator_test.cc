@@ -17,6 +17,7 @@
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,8 +44,10 @@ class TestShardOperator : public UT::Common {
     for (int i = 1; i <= 4; i++) {
       string filename = std::string("./imagenet.shard0") + std::to_string(i);
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+      string index_name = std::string("./imagenet.shard0") + std::to_string(i) + ".idx";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(index_name));
     }
   }
 };
@@ -261,6 +264,52 @@ TEST_F(TestShardOperator, TestShardShuffle) {
   dataset.Close();
 }
 
+TEST_F(TestShardOperator, TestShardShuffleBlocks) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet with blocks shuffled"));
+
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+  auto read_file_names = [&](const std::vector<std::shared_ptr<ShardOperator>> &ops) {
+    std::vector<std::string> file_names;
+    ShardReader dataset;
+    dataset.Open({file_name}, true, 4, column_list, ops);
+    dataset.Launch();
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      file_names.push_back((std::get<1>(x[0]))["file_name"]);
+    }
+    dataset.Close();
+    return file_names;
+  };
+  auto expected_names = read_file_names({});
+
+  const int64_t kBlockRows = 4;
+  (void)setenv("MS_DEV_DATASET_SHUFFLE_BLOCK_ROWS", std::to_string(kBlockRows).c_str(), 1);
+  auto shuffle_op = std::make_shared<ShardShuffle>(1, 0, false, true, kShuffleSample);
+  (void)unsetenv("MS_DEV_DATASET_SHUFFLE_BLOCK_ROWS");
+  shuffle_op->UpdateShuffleMode(dataset::ShuffleMode::kFiles);
+  auto shuffled_names = read_file_names({shuffle_op});
+  ASSERT_EQ(shuffled_names.size(), expected_names.size());
+
+  // the rows of each block keep their order, so the shuffled rows are broken into at most one run per block
+  std::map<std::string, size_t> positions;
+  for (size_t i = 0; i < expected_names.size(); ++i) {
+    positions[expected_names[i]] = i;
+  }
+  size_t runs = shuffled_names.empty() ? 0 : 1;
+  for (size_t i = 1; i < shuffled_names.size(); ++i) {
+    if (positions[shuffled_names[i]] != positions[shuffled_names[i - 1]] + 1) {
+      runs++;
+    }
+  }
+  const size_t kShardNum = 4;
+  ASSERT_LE(runs, (expected_names.size() + kBlockRows - 1) / kBlockRows + kShardNum);
+  std::sort(shuffled_names.begin(), shuffled_names.end());
+  std::sort(expected_names.begin(), expected_names.end());
+  ASSERT_EQ(shuffled_names, expected_names);
+}
+
 TEST_F(TestShardOperator, TestShardSampleShuffle) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet"));
 
@@ -15,6 +15,7 @@
  */
 
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -24,6 +25,8 @@
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
+#include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "ut_common.h"
@@ -39,12 +42,33 @@ class TestShardReader : public UT::Common {
     for (int i = 1; i <= 4; i++) {
       string filename = std::string("./imagenet.shard0") + std::to_string(i);
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+      string index_name = std::string("./imagenet.shard0") + std::to_string(i) + kColumnarIndexSuffix;
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(index_name));
     }
   }
 };
 
+namespace {
+std::vector<std::string> ReadAllLabels(const std::string &file_name, const std::vector<std::string> &column_list,
+                                       const std::vector<std::shared_ptr<ShardOperator>> &ops) {
+  std::vector<std::string> labels;
+  ShardReader dataset;
+  EXPECT_TRUE(dataset.Open({file_name}, true, 4, column_list, ops).IsOk());
+  EXPECT_TRUE(dataset.Launch().IsOk());
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      labels.push_back(std::get<1>(j).dump());
+    }
+  }
+  dataset.Close();
+  return labels;
+}
+}  // namespace
+
 TEST_F(TestShardReader, TestShardReaderGeneral) {
   MS_LOG(INFO) << FormatInfo("Test read imageNet");
   std::string file_name = "./imagenet.shard01";
@@ -239,5 +263,110 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+/// Feature: Zero copy read of mindrecord.
+/// Description: Read the rows by id with and without zero copy.
+/// Expectation: The blob views of mapped pages are the same as the copied blob data.
+TEST_F(TestShardReader, TestShardReaderZeroCopy) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with zero copy");
+  std::string file_name = "./imagenet.shard01";
+
+  ShardReader dataset;
+  ASSERT_TRUE(dataset.Open({file_name}, true, 1).IsOk());
+  ASSERT_TRUE(dataset.Launch(true).IsOk());
+  ShardReader zero_copy_dataset;
+  zero_copy_dataset.SetZeroCopy(true);
+  ASSERT_TRUE(zero_copy_dataset.Open({file_name}, true, 1).IsOk());
+  ASSERT_TRUE(zero_copy_dataset.Launch(true).IsOk());
+  ASSERT_EQ(dataset.GetNumRows(), zero_copy_dataset.GetNumRows());
+
+  for (int64_t row_id = 0; row_id < dataset.GetNumRows(); ++row_id) {
+    auto task_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    ASSERT_TRUE(dataset.GetNextById(row_id, 0, &task_content_ptr).IsOk());
+    auto task_view_ptr =
+      std::make_shared<TASK_VIEW_CONTENT>(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobView, json>>());
+    ASSERT_TRUE(zero_copy_dataset.GetNextById(row_id, 0, &task_view_ptr).IsOk());
+    ASSERT_EQ(task_content_ptr->second.size(), task_view_ptr->second.size());
+    for (size_t i = 0; i < task_view_ptr->second.size(); ++i) {
+      const auto &blob = std::get<0>(task_content_ptr->second[i]);
+      const auto &blob_view = std::get<0>(task_view_ptr->second[i]);
+      ASSERT_NE(blob_view.page(), nullptr);
+      ASSERT_EQ(blob.size(), blob_view.size());
+      EXPECT_EQ(memcmp(blob.data(), blob_view.data(), blob.size()), 0);
+      EXPECT_EQ(std::get<1>(task_content_ptr->second[i]), std::get<1>(task_view_ptr->second[i]));
+    }
+  }
+  dataset.Close();
+  zero_copy_dataset.Close();
+}
+
+/// Feature: Readahead of mindrecord.
+/// Description: Read the rows by id with and without readahead.
+/// Expectation: The rows which are read ahead are the same as the rows read directly.
+TEST_F(TestShardReader, TestShardReaderPrefetch) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with readahead");
+  std::string file_name = "./imagenet.shard01";
+  const uint32_t prefetch_size = 8;
+
+  ShardReader dataset;
+  ASSERT_TRUE(dataset.Open({file_name}, true, 1).IsOk());
+  ASSERT_TRUE(dataset.Launch(true).IsOk());
+  ShardReader prefetch_dataset;
+  prefetch_dataset.SetPrefetchSize(prefetch_size);
+  ASSERT_TRUE(prefetch_dataset.Open({file_name}, true, 1).IsOk());
+  ASSERT_TRUE(prefetch_dataset.Launch(true).IsOk());
+  ASSERT_EQ(prefetch_dataset.GetPrefetchSize(), prefetch_size);
+
+  const auto *sample_ids = prefetch_dataset.GetSampleIds();
+  ASSERT_EQ(dataset.GetSampleIds()->size(), sample_ids->size());
+  for (auto row_id : *sample_ids) {
+    auto task_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    ASSERT_TRUE(dataset.GetNextById(row_id, 0, &task_content_ptr).IsOk());
+    auto prefetch_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    ASSERT_TRUE(prefetch_dataset.GetNextById(row_id, 0, &prefetch_content_ptr).IsOk());
+    EXPECT_EQ(task_content_ptr->second, prefetch_content_ptr->second);
+  }
+  dataset.Close();
+  prefetch_dataset.Close();
+}
+
+/// Feature: Columnar index of mindrecord.
+/// Description: Read the dataset with category sampler by the columnar index and by the sqlite meta file.
+/// Expectation: The rows read by the columnar index are the same as the rows read by the sqlite meta file.
+TEST_F(TestShardReader, TestShardReaderColumnarIndex) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet by columnar index");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  std::shared_ptr<ShardColumnarIndex> columnar_index;
+  ASSERT_TRUE(ShardColumnarIndex::Load(file_name + kColumnarIndexSuffix, &columnar_index).IsOk());
+  ASSERT_GT(columnar_index->GetRowCount(), 0);
+  EXPECT_TRUE(columnar_index->MatchMetaFile(file_name + ".db"));
+  // the meta file which is rewritten after the index is generated makes the index stale
+  std::string meta_copy = file_name + ".db.copy";
+  {
+    std::ifstream src(file_name + ".db", std::ios::binary);
+    std::ofstream dst(meta_copy, std::ios::binary);
+    dst << src.rdbuf();
+  }
+  EXPECT_FALSE(columnar_index->MatchMetaFile(meta_copy));
+  remove(common::SafeCStr(meta_copy));
+
+  std::vector<std::shared_ptr<ShardOperator>> pk_ops = {std::make_shared<ShardPkSample>("label", 2, 0)};
+  auto index_labels = ReadAllLabels(file_name, column_list, {});
+  auto index_pk_labels = ReadAllLabels(file_name, column_list, pk_ops);
+  ASSERT_FALSE(index_pk_labels.empty());
+
+  // the reader falls back to the sqlite meta file without the columnar index
+  for (int i = 1; i <= 4; i++) {
+    string index_name = std::string("./imagenet.shard0") + std::to_string(i) + kColumnarIndexSuffix;
+    remove(common::SafeCStr(index_name));
+  }
+  EXPECT_EQ(ReadAllLabels(file_name, column_list, {}), index_labels);
+  EXPECT_EQ(ReadAllLabels(file_name, column_list, pk_ops), index_pk_labels);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -15,7 +15,10 @@
  */
 
 #include <vector>
+#include <algorithm>
 #include <numeric>
+#include <random>
+#include <thread>
 
 #include "common/common_test.h"
 #include "plugin/device/cpu/hal/device/cpu_hash_table.h"
@@ -363,6 +366,76 @@ TEST_F(TestCPUHashTable, test_cpu_hash_table_export_slice) {
 
   EXPECT_TRUE(hash_table.Clear());
 }
+/// Feature: test cpu hash table with many keys.
+/// Description: insert, find and erase many keys from several threads, which grows and shrinks the shards.
+/// Expectation: the content of hash table is the same as a std::unordered_map.
+TEST_F(TestCPUHashTable, test_cpu_hash_table_many_keys) {
+  size_t value_dim = 2;
+  size_t thread_num = 4;
+  size_t key_num_per_thread = 20000;
+  CPUHashTable<Key, Value> hash_table(value_dim, 0.0);
+
+  // Each thread inserts its own keys, the keys of different threads fall into the same shards.
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<Key> keys(key_num_per_thread);
+      std::vector<Value> values(key_num_per_thread * value_dim);
+      for (size_t i = 0; i < key_num_per_thread; ++i) {
+        keys[i] = static_cast<Key>(i * thread_num + t);
+        values[i * value_dim] = static_cast<Value>(keys[i]);
+        values[i * value_dim + 1] = static_cast<Value>(t);
+      }
+      EXPECT_TRUE(hash_table.Insert(keys.data(), keys.size(), values.data(), nullptr));
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  size_t key_num = thread_num * key_num_per_thread;
+  EXPECT_EQ(hash_table.size(), key_num);
+
+  // Erase the keys randomly, the remaining elements are moved inside the shards.
+  std::vector<Key> all_keys(key_num);
+  std::iota(all_keys.begin(), all_keys.end(), 0);
+  std::shuffle(all_keys.begin(), all_keys.end(), std::mt19937(0));
+  size_t erase_key_num = key_num / 2;
+  EXPECT_TRUE(hash_table.Erase(all_keys.data(), erase_key_num, nullptr));
+  EXPECT_EQ(hash_table.size(), key_num - erase_key_num);
+  EXPECT_FALSE(hash_table.Find(all_keys.data(), 1, false, std::vector<Value>(value_dim).data(), nullptr));
+
+  std::vector<Key> remaining_keys(all_keys.begin() + erase_key_num, all_keys.end());
+  std::vector<Value> values_to_check(remaining_keys.size() * value_dim);
+  EXPECT_TRUE(
+    hash_table.Find(remaining_keys.data(), remaining_keys.size(), false, values_to_check.data(), nullptr));
+  for (size_t i = 0; i < remaining_keys.size(); ++i) {
+    EXPECT_EQ(values_to_check[i * value_dim], static_cast<Value>(remaining_keys[i]));
+    EXPECT_EQ(values_to_check[i * value_dim + 1], static_cast<Value>(remaining_keys[i] % thread_num));
+  }
+
+  // The exported elements are the same as the remaining keys.
+  std::unordered_map<Key, Value> keys_values;
+  for (auto key : remaining_keys) {
+    keys_values.emplace(key, static_cast<Value>(key));
+  }
+  std::vector<Key> keys_to_check(remaining_keys.size());
+  EXPECT_TRUE(hash_table.GetKeysAndValues(keys_to_check.data(), values_to_check.data(), nullptr));
+  for (size_t i = 0; i < keys_to_check.size(); ++i) {
+    auto iter = keys_values.find(keys_to_check[i]);
+    ASSERT_TRUE(iter != keys_values.end());
+    EXPECT_EQ(values_to_check[i * value_dim], iter->second);
+    keys_values.erase(iter);
+  }
+  EXPECT_TRUE(keys_values.empty());
+
+  // The erased keys are inserted with the default value again.
+  EXPECT_TRUE(hash_table.Find(all_keys.data(), erase_key_num, true, values_to_check.data(), nullptr));
+  EXPECT_EQ(hash_table.size(), key_num);
+  EXPECT_EQ(values_to_check[0], static_cast<Value>(0));
+
+  EXPECT_TRUE(hash_table.Clear());
+  EXPECT_EQ(hash_table.size(), 0);
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
\ No newline at end of file
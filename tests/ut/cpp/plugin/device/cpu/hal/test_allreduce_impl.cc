@@ -0,0 +1,273 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
+#include "utils/convert_utils_base.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kMaxRankSize = 16;
+// The AllToAll with the blocks above the pipeline segment only runs for the small rank sizes to bound the memory.
+constexpr size_t kLargeBlockMaxRankSize = 4;
+constexpr auto kReceiveTimeout = std::chrono::seconds(30);
+
+// The messages in flight between the simulated ranks, in the order of sending for each pair of ranks.
+class SimulatedNetwork {
+ public:
+  void Send(uint32_t from, uint32_t to, const void *data, size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    auto message = std::make_shared<std::vector<unsigned char>>(bytes, bytes + size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_[{from, to}].push_back(message);
+    cond_.notify_all();
+  }
+
+  bool Receive(uint32_t from, uint32_t to, std::shared_ptr<std::vector<unsigned char>> *data) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto &queue = messages_[{from, to}];
+    if (!cond_.wait_for(lock, kReceiveTimeout, [&queue]() { return !queue.empty(); })) {
+      return false;
+    }
+    *data = queue.front();
+    queue.pop_front();
+    return true;
+  }
+
+  bool Empty() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &item : messages_) {
+      if (!item.second.empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::map<std::pair<uint32_t, uint32_t>, std::deque<std::shared_ptr<std::vector<unsigned char>>>> messages_;
+};
+
+// The launcher of a rank which runs in a thread and talks to the other ranks by the simulated network.
+class SimulatedAllReduceLauncher : public AllReduceLauncher {
+ public:
+  SimulatedAllReduceLauncher(SimulatedNetwork *network, size_t rank_id, size_t rank_size,
+                             AllReduceAlgorithm algorithm, const std::vector<std::string> &host_names)
+      : network_(network), rank_(SizeToUint(rank_id)) {
+    InitRanks(rank_id, rank_size, algorithm, host_names);
+  }
+  ~SimulatedAllReduceLauncher() override = default;
+
+ protected:
+  uint64_t SendAsync(uint32_t rank, const void *data, size_t size) const override {
+    network_->Send(rank_, rank, data, size);
+    return 0;
+  }
+  bool WaitSend(uint64_t) const override { return true; }
+  bool Receive(uint32_t rank, std::shared_ptr<std::vector<unsigned char>> *data) const override {
+    return network_->Receive(rank, rank_, data);
+  }
+
+ private:
+  SimulatedNetwork *network_;
+  uint32_t rank_;
+};
+
+// The ranks are on two hosts alternately if the rank size is even, otherwise they are all on one host.
+std::vector<std::string> AlternateHostNames(size_t rank_size) {
+  std::vector<std::string> host_names;
+  for (size_t i = 0; i < rank_size; ++i) {
+    (void)host_names.emplace_back(rank_size % 2 == 0 ? "host" + std::to_string(i % 2) : "host0");
+  }
+  return host_names;
+}
+
+// Run the collective of every rank in its own thread, and return whether all the ranks succeed.
+bool RunRanks(size_t rank_size, const std::function<bool(size_t)> &rank_func) {
+  std::vector<std::thread> threads;
+  std::vector<int> rets(rank_size, 0);
+  for (size_t rank = 0; rank < rank_size; ++rank) {
+    (void)threads.emplace_back([&rets, &rank_func, rank]() { rets[rank] = rank_func(rank) ? 1 : 0; });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return std::all_of(rets.begin(), rets.end(), [](int ret) { return ret == 1; });
+}
+
+// AllReduce the data of the ranks on the hosts, and check that every rank gets the sum.
+void CheckAllReduce(const std::vector<std::string> &host_names, AllReduceAlgorithm algorithm, size_t data_num) {
+  size_t rank_size = host_names.size();
+  SimulatedNetwork network;
+  std::vector<std::unique_ptr<SimulatedAllReduceLauncher>> launchers;
+  std::vector<std::vector<float>> inputs(rank_size, std::vector<float>(data_num));
+  std::vector<std::vector<float>> outputs(rank_size, std::vector<float>(data_num, 0));
+  for (size_t rank = 0; rank < rank_size; ++rank) {
+    (void)launchers.emplace_back(
+      std::make_unique<SimulatedAllReduceLauncher>(&network, rank, rank_size, algorithm, host_names));
+    for (size_t i = 0; i < data_num; ++i) {
+      inputs[rank][i] = static_cast<float>((rank + 1) * (i % 17 + 1));
+    }
+  }
+  ASSERT_TRUE(RunRanks(rank_size, [&](size_t rank) {
+    return launchers[rank]->Execute(inputs[rank].data(), outputs[rank].data(), data_num * sizeof(float));
+  })) << "rank size: " << rank_size << ", algorithm: " << static_cast<int>(algorithm) << ", data num: " << data_num;
+  EXPECT_TRUE(network.Empty());
+
+  float rank_sum = static_cast<float>(rank_size * (rank_size + 1) / 2);
+  for (size_t rank = 0; rank < rank_size; ++rank) {
+    for (size_t i = 0; i < data_num; ++i) {
+      ASSERT_FLOAT_EQ(outputs[rank][i], rank_sum * (i % 17 + 1))
+        << "rank size: " << rank_size << ", algorithm: " << static_cast<int>(algorithm) << ", data num: " << data_num
+        << ", rank: " << rank << ", index: " << i;
+    }
+  }
+}
+}  // namespace
+
+class TestAllReduceImpl : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+/// Feature: AllReduce algorithms of the cpu collective library.
+/// Description: run the AllReduce by the simulated ranks for 1 to 16 ranks, with every algorithm and the data sizes
+/// below and above the pipeline segment, on one host or on two hosts.
+/// Expectation: every rank gets the sum of the data of all the ranks, and no message is left.
+TEST_F(TestAllReduceImpl, AllReduceAlgorithms) {
+  const std::vector<AllReduceAlgorithm> algorithms = {
+    AllReduceAlgorithm::kAuto,         AllReduceAlgorithm::kRing,         AllReduceAlgorithm::kRecursiveDoubling,
+    AllReduceAlgorithm::kRabenseifner, AllReduceAlgorithm::kHierarchical, AllReduceAlgorithm::kReduceBroadcast};
+  const std::vector<size_t> data_nums = {1, 7, 1000, kPipelineSegmentSize / sizeof(float) + 100};
+  for (size_t rank_size = 1; rank_size <= kMaxRankSize; ++rank_size) {
+    for (auto algorithm : algorithms) {
+      for (auto data_num : data_nums) {
+        CheckAllReduce(AlternateHostNames(rank_size), algorithm, data_num);
+      }
+    }
+  }
+}
+
+/// Feature: AllReduce algorithms of the cpu collective library.
+/// Description: run the hierarchical AllReduce on 4 hosts of 3 ranks, and on hosts with different rank numbers.
+/// Expectation: every rank gets the sum, and the hosts with different rank numbers fall back to the flat algorithms.
+TEST_F(TestAllReduceImpl, HierarchicalAllReduceTopology) {
+  std::vector<std::string> block_hosts;
+  for (size_t i = 0; i < 12; ++i) {
+    (void)block_hosts.emplace_back("host" + std::to_string(i / 3));
+  }
+  std::vector<std::string> uneven_hosts = {"host0", "host0", "host0", "host1", "host1"};
+  for (const auto &host_names : {block_hosts, uneven_hosts}) {
+    for (auto algorithm : {AllReduceAlgorithm::kAuto, AllReduceAlgorithm::kHierarchical}) {
+      for (size_t data_num : {5, 100000}) {
+        CheckAllReduce(host_names, algorithm, data_num);
+      }
+    }
+  }
+}
+
+/// Feature: ReduceScatter of the cpu collective library.
+/// Description: run the ReduceScatter by the simulated ranks for 1 to 16 ranks.
+/// Expectation: the rank i gets the i-th block of the sum of the data of all the ranks.
+TEST_F(TestAllReduceImpl, ReduceScatter) {
+  for (size_t rank_size = 1; rank_size <= kMaxRankSize; ++rank_size) {
+    for (size_t block_num : {1, 5, 1000}) {
+      SimulatedNetwork network;
+      std::vector<std::unique_ptr<SimulatedAllReduceLauncher>> launchers;
+      std::vector<std::vector<float>> inputs(rank_size, std::vector<float>(block_num * rank_size));
+      std::vector<std::vector<float>> outputs(rank_size, std::vector<float>(block_num, 0));
+      for (size_t rank = 0; rank < rank_size; ++rank) {
+        (void)launchers.emplace_back(std::make_unique<SimulatedAllReduceLauncher>(
+          &network, rank, rank_size, AllReduceAlgorithm::kAuto, AlternateHostNames(rank_size)));
+        for (size_t i = 0; i < block_num * rank_size; ++i) {
+          inputs[rank][i] = static_cast<float>(rank * 10 + i % 10);
+        }
+      }
+      ASSERT_TRUE(RunRanks(rank_size, [&](size_t rank) {
+        return launchers[rank]->ReduceScatter(inputs[rank].data(), outputs[rank].data(), block_num * sizeof(float));
+      }));
+      EXPECT_TRUE(network.Empty());
+      for (size_t rank = 0; rank < rank_size; ++rank) {
+        for (size_t i = 0; i < block_num; ++i) {
+          float expected = 0;
+          for (size_t src = 0; src < rank_size; ++src) {
+            expected += static_cast<float>(src * 10 + (rank * block_num + i) % 10);
+          }
+          ASSERT_FLOAT_EQ(outputs[rank][i], expected) << "rank size: " << rank_size << ", rank: " << rank;
+        }
+      }
+    }
+  }
+}
+
+/// Feature: AllToAll of the cpu collective library.
+/// Description: run the AllToAll by the simulated ranks for 1 to 16 ranks, and the blocks above the pipeline segment
+/// for the small rank sizes.
+/// Expectation: the rank i gets the i-th block of every rank in the order of the ranks, and no message is left.
+TEST_F(TestAllReduceImpl, AllToAll) {
+  for (size_t rank_size = 1; rank_size <= kMaxRankSize; ++rank_size) {
+    std::vector<size_t> block_nums = {1, 5, 1000};
+    if (rank_size <= kLargeBlockMaxRankSize) {
+      (void)block_nums.emplace_back(kPipelineSegmentSize / sizeof(int32_t) + 3);
+    }
+    for (auto block_num : block_nums) {
+      SimulatedNetwork network;
+      std::vector<std::unique_ptr<SimulatedAllReduceLauncher>> launchers;
+      std::vector<std::vector<int32_t>> inputs(rank_size, std::vector<int32_t>(block_num * rank_size));
+      std::vector<std::vector<int32_t>> outputs(rank_size, std::vector<int32_t>(block_num * rank_size, -1));
+      for (size_t rank = 0; rank < rank_size; ++rank) {
+        (void)launchers.emplace_back(std::make_unique<SimulatedAllReduceLauncher>(
+          &network, rank, rank_size, AllReduceAlgorithm::kAuto, AlternateHostNames(rank_size)));
+        for (size_t i = 0; i < block_num * rank_size; ++i) {
+          inputs[rank][i] = SizeToInt(rank * 10000000 + i);
+        }
+      }
+      ASSERT_TRUE(RunRanks(rank_size, [&](size_t rank) {
+        return launchers[rank]->AllToAll(inputs[rank].data(), outputs[rank].data(), block_num * sizeof(int32_t));
+      }));
+      EXPECT_TRUE(network.Empty());
+      for (size_t rank = 0; rank < rank_size; ++rank) {
+        for (size_t src = 0; src < rank_size; ++src) {
+          for (size_t i = 0; i < block_num; ++i) {
+            ASSERT_EQ(outputs[rank][src * block_num + i], inputs[src][rank * block_num + i])
+              << "rank size: " << rank_size << ", rank: " << rank << ", source rank: " << src;
+          }
+        }
+      }
+    }
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
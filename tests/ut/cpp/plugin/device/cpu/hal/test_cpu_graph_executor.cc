@@ -0,0 +1,273 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "common/device_common_test.h"
+#include "mindspore/core/ops/framework_ops.h"
+#include "mindspore/core/ops/sequence_ops.h"
+#include "plugin/device/cpu/hal/hardware/cpu_graph_executor.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using runtime::test::TestDeviceResManager;
+using runtime::test::TestKernelExecutor;
+using session::KernelGraph;
+
+namespace {
+constexpr size_t kSomasBlockSize = 64;
+constexpr size_t kSomasOutputOffset = 16;
+constexpr size_t kSomasWorkspaceOffset = 32;
+
+// Allocate the host memory for the static memory of the replay, and record the memory which is not freed.
+class ReplayDeviceResManager : public TestDeviceResManager {
+ public:
+  ~ReplayDeviceResManager() override {
+    for (auto ptr : allocated_) {
+      free(ptr);
+    }
+  }
+
+  void *AllocateMemory(size_t size, const uint32_t stream_id = UINT32_MAX) const override {
+    auto ptr = malloc(size);
+    (void)allocated_.insert(ptr);
+    ++allocate_num_;
+    return ptr;
+  }
+  void FreeMemory(void *const ptr) const override {
+    if (allocated_.erase(ptr) > 0) {
+      free(ptr);
+    }
+  }
+
+  mutable std::set<void *> allocated_;
+  mutable size_t allocate_num_{0};
+};
+
+// Record the launch order of the kernels instead of launching them.
+class ReplayKernelExecutor : public TestKernelExecutor {
+ public:
+  bool LaunchKernel(const CNodePtr &kernel, const std::vector<KernelTensor *> &, const std::vector<KernelTensor *> &,
+                    const std::vector<KernelTensor *> &, KernelMod *, void *) const override {
+    (void)launched_kernels_.emplace_back(kernel);
+    return true;
+  }
+
+  mutable std::vector<CNodePtr> launched_kernels_;
+};
+
+class ReplayDeviceContext : public DeviceInterface<ReplayKernelExecutor, ReplayDeviceResManager, CPUGraphExecutor> {
+ public:
+  explicit ReplayDeviceContext(const DeviceContextKey &device_context_key) : DeviceInterface(device_context_key) {}
+  ~ReplayDeviceContext() override = default;
+
+  void Initialize() override {}
+  RunMode GetRunMode(const FuncGraphPtr &func_graph) const override { return RunMode::kGraphMode; }
+};
+
+CNodePtr NewKernel(const KernelGraphPtr &graph, const std::string &name, const AnfNodePtrList &inputs,
+                   const abstract::AbstractBasePtr &abstract) {
+  AnfNodePtrList kernel_inputs{NewValueNode(std::make_shared<Primitive>(name))};
+  (void)kernel_inputs.insert(kernel_inputs.end(), inputs.begin(), inputs.end());
+  auto kernel = graph->NewCNode(kernel_inputs);
+  kernel->set_abstract(abstract);
+  return kernel;
+}
+
+// The kernels in the execution order:
+//   k0 = Add(p0, p1)             k1 = Mul(p0, p1)
+//   k2 = Sub(Depend(p0, k1), p0) k3 = Split(p0)
+//   k4 = Neg(TupleGetItem(k3, 1))
+//   k5 = AssignAdd(p1, k2)       which updates p1 in place
+//   k6 = Mul(p0, p0)             which reads p1 neither, but is after the in-place kernel
+// and the graph outputs are (k4, k5, k6).
+KernelGraphPtr BuildReplayGraph(const DeviceContext &device_context) {
+  auto graph = std::make_shared<KernelGraph>();
+  ShapeVector shape{2, 2};
+  auto tensor_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+  auto p0 = graph->add_parameter();
+  p0->set_abstract(tensor_abstract);
+  auto p1 = graph->add_parameter();
+  p1->set_abstract(tensor_abstract);
+  (void)graph->input_nodes_.emplace_back(p0);
+  (void)graph->input_nodes_.emplace_back(p1);
+
+  auto k0 = NewKernel(graph, "Add", {p0, p1}, tensor_abstract);
+  auto k1 = NewKernel(graph, "Mul", {p0, p1}, tensor_abstract);
+  auto depend = graph->NewCNode({NewValueNode(prim::kPrimDepend), p0, k1});
+  depend->set_abstract(tensor_abstract);
+  auto k2 = NewKernel(graph, "Sub", {depend, p0}, tensor_abstract);
+  auto split_abstract = std::make_shared<abstract::AbstractTuple>(
+    abstract::AbstractBasePtrList{std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{1, 2}),
+                                  std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{1, 2})});
+  auto k3 = NewKernel(graph, "Split", {p0}, split_abstract);
+  auto index = NewValueNode(static_cast<int64_t>(1));
+  index->set_abstract(index->value()->ToAbstract());
+  auto tuple_get_item = graph->NewCNode({NewValueNode(prim::kPrimTupleGetItem), k3, index});
+  tuple_get_item->set_abstract(split_abstract->elements()[1]);
+  auto k4 = NewKernel(graph, "Neg", {tuple_get_item}, split_abstract->elements()[1]);
+  auto k5 = NewKernel(graph, "AssignAdd", {p1, k2}, tensor_abstract);
+  auto k6 = NewKernel(graph, "Mul", {p0, p0}, tensor_abstract);
+
+  auto make_tuple = graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), k4, k5, k6});
+  make_tuple->set_abstract(std::make_shared<abstract::AbstractTuple>(
+    abstract::AbstractBasePtrList{k4->abstract(), k5->abstract(), k6->abstract()}));
+  auto return_node = graph->NewCNode({NewValueNode(prim::kPrimReturn), make_tuple});
+  return_node->set_abstract(make_tuple->abstract());
+  graph->set_return(return_node);
+  graph->set_execution_order({k0, k1, k2, k3, k4, k5, k6});
+  graph->AddRefCorrespondPairs({k5, 0}, {p1, 0});
+
+  device_context.GetKernelExecutor(false)->CreateKernel(graph->execution_order());
+  return graph;
+}
+}  // namespace
+
+class TestCPUGraphExecutor : public UT::Common {
+ protected:
+  void SetUp() override {
+    device_context_ = std::make_shared<ReplayDeviceContext>(DeviceContextKey{"CPU", 0});
+    graph_executor_ = dynamic_cast<CPUGraphExecutor *>(device_context_->graph_executor_.get());
+    ASSERT_NE(graph_executor_, nullptr);
+    res_manager_ = dynamic_cast<ReplayDeviceResManager *>(device_context_->device_res_manager_.get());
+    ASSERT_NE(res_manager_, nullptr);
+    kernel_executor_ = dynamic_cast<ReplayKernelExecutor *>(device_context_->GetKernelExecutor(false).get());
+    ASSERT_NE(kernel_executor_, nullptr);
+  }
+  void TearDown() override {
+    graph_executor_->Clear();
+    (void)common::SetEnv(kEnvCpuGraphReplay, "");
+  }
+
+  std::shared_ptr<ReplayDeviceContext> device_context_;
+  CPUGraphExecutor *graph_executor_{nullptr};
+  ReplayDeviceResManager *res_manager_{nullptr};
+  ReplayKernelExecutor *kernel_executor_{nullptr};
+};
+
+/// Feature: Replay the graph by the CPU graph executor.
+/// Description: Capture the graph with the data dependencies through Depend and TupleGetItem and an in-place kernel
+/// in the parallel replay mode.
+/// Expectation: The independent kernels are in the same level, Depend and TupleGetItem pass the dependencies through,
+/// and the in-place kernel is a barrier which runs after all the kernels before it and before all the kernels after it.
+TEST_F(TestCPUGraphExecutor, BuildLevels) {
+  (void)common::SetEnv(kEnvCpuGraphReplay, kCpuGraphReplayParallel);
+  auto graph = BuildReplayGraph(*device_context_);
+  auto schedule = graph_executor_->Capture(graph);
+  ASSERT_NE(schedule, nullptr);
+  ASSERT_EQ(schedule->kernels_.size(), graph->execution_order().size());
+  std::vector<std::vector<size_t>> expected_levels{{0, 1, 3}, {2, 4}, {5}, {6}};
+  ASSERT_EQ(schedule->levels_, expected_levels);
+
+  // The graph whose kernels depend on each other one by one is launched serially.
+  auto serial_graph = std::make_shared<KernelGraph>();
+  auto tensor_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{2, 2});
+  auto parameter = serial_graph->add_parameter();
+  parameter->set_abstract(tensor_abstract);
+  auto first = NewKernel(serial_graph, "Neg", {parameter}, tensor_abstract);
+  auto second = NewKernel(serial_graph, "Neg", {first}, tensor_abstract);
+  auto return_node = serial_graph->NewCNode({NewValueNode(prim::kPrimReturn), second});
+  return_node->set_abstract(tensor_abstract);
+  serial_graph->set_return(return_node);
+  serial_graph->set_execution_order({first, second});
+  device_context_->GetKernelExecutor(false)->CreateKernel(serial_graph->execution_order());
+  auto serial_schedule = graph_executor_->Capture(serial_graph);
+  ASSERT_NE(serial_schedule, nullptr);
+  ASSERT_TRUE(serial_schedule->levels_.empty());
+}
+
+/// Feature: Replay the graph by the CPU graph executor.
+/// Description: Capture the graph without and with somas.
+/// Expectation: The internal outputs and workspaces get their own memory or the somas offsets, the graph outputs are
+/// left to the super kernel actor, and the graph using somas is not replayed in parallel.
+TEST_F(TestCPUGraphExecutor, CaptureStaticMemory) {
+  (void)common::SetEnv(kEnvCpuGraphReplay, kCpuGraphReplayParallel);
+  auto graph = BuildReplayGraph(*device_context_);
+  const auto &kernels = graph->execution_order();
+  auto schedule = graph_executor_->Capture(graph);
+  ASSERT_NE(schedule, nullptr);
+  // The outputs of k0 ~ k3 are internal, k3 has two outputs, and every kernel has one workspace.
+  ASSERT_EQ(schedule->static_memory_.size(), 5 + kernels.size());
+  ASSERT_EQ(schedule->captured_addresses_.size(), schedule->static_memory_.size());
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_NE(AnfAlgo::GetMutableOutputAddr(kernels[i], 0, false)->GetPtr(), nullptr);
+  }
+  for (size_t i = 4; i < kernels.size(); ++i) {
+    ASSERT_EQ(AnfAlgo::GetMutableOutputAddr(kernels[i], 0, false)->GetPtr(), nullptr);
+  }
+  for (const auto &kernel : kernels) {
+    ASSERT_NE(AnfAlgo::GetMutableWorkspaceAddr(kernel, 0)->GetPtr(), nullptr);
+  }
+
+  // The somas block is allocated once and the kernels with the somas result get the offsets in it.
+  auto somas_graph = BuildReplayGraph(*device_context_);
+  somas_graph->MutableSomasInfo()->whole_block_size_ = kSomasBlockSize;
+  const auto &somas_kernel = somas_graph->execution_order()[0];
+  auto kernel_info = dynamic_cast<KernelInfo *>(somas_kernel->kernel_info());
+  ASSERT_NE(kernel_info, nullptr);
+  kernel_info->somas_output_result_ = {{kSomasOutputOffset, 16}};
+  kernel_info->somas_workspace_result_ = {{kSomasWorkspaceOffset, 4}};
+  auto somas_schedule = graph_executor_->Capture(somas_graph);
+  ASSERT_NE(somas_schedule, nullptr);
+  ASSERT_TRUE(somas_schedule->levels_.empty());
+  ASSERT_EQ(somas_schedule->static_memory_.size(), 1 + schedule->static_memory_.size() - 2);
+  auto somas_base = static_cast<uint8_t *>(somas_schedule->static_memory_[0]);
+  ASSERT_EQ(AnfAlgo::GetMutableOutputAddr(somas_kernel, 0, false)->GetPtr(), somas_base + kSomasOutputOffset);
+  ASSERT_EQ(AnfAlgo::GetMutableWorkspaceAddr(somas_kernel, 0)->GetPtr(), somas_base + kSomasWorkspaceOffset);
+}
+
+/// Feature: Replay the graph by the CPU graph executor.
+/// Description: Run the graph twice in the serial replay mode, and then clear the executor.
+/// Expectation: The graph is captured only at the first step, the kernels are launched in the execution order, and
+/// the clear releases all the static memory and resets the captured addresses.
+TEST_F(TestCPUGraphExecutor, RunAndClear) {
+  (void)common::SetEnv(kEnvCpuGraphReplay, kCpuGraphReplaySerial);
+  auto graph = BuildReplayGraph(*device_context_);
+  std::vector<tensor::Tensor> outputs;
+  ASSERT_TRUE(graph_executor_->RunGraph(graph, {}, &outputs, {}));
+  auto allocate_num = res_manager_->allocate_num_;
+  ASSERT_GT(allocate_num, 0U);
+  ASSERT_TRUE(graph_executor_->RunGraph(graph, {}, &outputs, {}));
+  ASSERT_EQ(res_manager_->allocate_num_, allocate_num);
+  ASSERT_EQ(graph_executor_->schedules_.size(), 1U);
+  ASSERT_TRUE(graph_executor_->schedules_.begin()->second->levels_.empty());
+
+  const auto &kernels = graph->execution_order();
+  ASSERT_EQ(kernel_executor_->launched_kernels_.size(), kernels.size() * 2);
+  for (size_t i = 0; i < kernel_executor_->launched_kernels_.size(); ++i) {
+    ASSERT_EQ(kernel_executor_->launched_kernels_[i], kernels[i % kernels.size()]);
+  }
+
+  graph_executor_->Clear();
+  ASSERT_TRUE(graph_executor_->schedules_.empty());
+  ASSERT_TRUE(res_manager_->allocated_.empty());
+  for (const auto &kernel : kernels) {
+    ASSERT_EQ(AnfAlgo::GetMutableOutputAddr(kernel, 0, false)->GetPtr(), nullptr);
+    ASSERT_EQ(AnfAlgo::GetMutableWorkspaceAddr(kernel, 0)->GetPtr(), nullptr);
+  }
+
+  // The graph is captured again after the clear.
+  ASSERT_TRUE(graph_executor_->RunGraph(graph, {}, &outputs, {}));
+  ASSERT_EQ(res_manager_->allocate_num_, allocate_num * 2);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/log_adapter.h"
+#include "runtime/device/gsm/file_async_io.h"
+
+namespace mindspore::device {
+namespace {
+constexpr size_t kBlockSize = 4096;
+constexpr size_t kQueueDepth = 4;
+// Not a multiple of the block size, so the last block is partial.
+constexpr size_t kDataSize = 64 * kBlockSize + 100;
+constexpr size_t kRequestNum = 8;
+}  // namespace
+
+class TestFileAsyncIO : public UT::Common {
+ public:
+  TestFileAsyncIO() = default;
+
+  void SetUp() override {
+    for (size_t i = 0; i < kRequestNum; ++i) {
+      (void)file_names_.emplace_back("./file_async_io_test_" + std::to_string(getpid()) + "_" + std::to_string(i));
+    }
+  }
+
+  void TearDown() override {
+    for (const auto &file_name : file_names_) {
+      (void)std::remove(file_name.c_str());
+    }
+  }
+
+  std::vector<std::string> file_names_;
+};
+
+/// Feature: FileAsyncIO
+/// Description: Write and read the local files by the io threads with multiple requests in flight.
+/// Expectation: The data read back is the same as written, and the io statistics are recorded.
+TEST_F(TestFileAsyncIO, test_read_write_async) {
+  FileAsyncIO file_aio;
+  EXPECT_TRUE(file_aio.Init({kBlockSize, kQueueDepth}));
+
+  std::vector<std::vector<uint8_t>> write_data(kRequestNum, std::vector<uint8_t>(kDataSize));
+  for (size_t i = 0; i < kRequestNum; ++i) {
+    for (size_t j = 0; j < kDataSize; ++j) {
+      write_data[i][j] = static_cast<uint8_t>((i + j) % UINT8_MAX);
+    }
+  }
+  std::vector<AsyncIOToken> tokens(kRequestNum, kInvalidAsyncIOToken);
+  for (size_t i = 0; i < kRequestNum; ++i) {
+    EXPECT_TRUE(file_aio.WriteAsync(file_names_[i], write_data[i].data(), kDataSize, &tokens[i]));
+  }
+  for (auto token : tokens) {
+    EXPECT_TRUE(file_aio.Wait(token));
+  }
+
+  std::vector<std::vector<uint8_t>> read_data(kRequestNum, std::vector<uint8_t>(kDataSize));
+  for (size_t i = 0; i < kRequestNum; ++i) {
+    EXPECT_TRUE(file_aio.ReadAsync(file_names_[i], read_data[i].data(), kDataSize, &tokens[i]));
+  }
+  for (size_t i = 0; i < kRequestNum; ++i) {
+    EXPECT_TRUE(file_aio.Wait(tokens[i]));
+    EXPECT_EQ(read_data[i], write_data[i]);
+  }
+
+  auto statistics = file_aio.GetStatistics();
+  EXPECT_EQ(statistics.write_bytes_, kRequestNum * kDataSize);
+  EXPECT_EQ(statistics.read_bytes_, kRequestNum * kDataSize);
+  EXPECT_GT(statistics.busy_time_us_, 0);
+  MS_LOG(INFO) << "File async io bandwidth: " << statistics.Bandwidth() << " MB/s, stall time "
+               << statistics.stall_time_us_ << " us.";
+}
+
+/// Feature: FileAsyncIO
+/// Description: Read and write synchronously, read the missing file and wait for the invalid token.
+/// Expectation: The sync io succeeds, and the invalid io fails without exception.
+TEST_F(TestFileAsyncIO, test_read_write_sync) {
+  FileAsyncIO file_aio;
+  std::vector<uint8_t> write_data(kDataSize, 1);
+  EXPECT_FALSE(file_aio.Write(file_names_[0], write_data.data(), kDataSize));
+  EXPECT_TRUE(file_aio.Init({kBlockSize, kQueueDepth}));
+  EXPECT_TRUE(file_aio.Write(file_names_[0], write_data.data(), kDataSize));
+  std::vector<uint8_t> read_data(kDataSize, 0);
+  EXPECT_TRUE(file_aio.Read(file_names_[0], read_data.data(), kDataSize));
+  EXPECT_EQ(read_data, write_data);
+
+  EXPECT_FALSE(file_aio.Read(file_names_[1], read_data.data(), kDataSize));
+  EXPECT_FALSE(file_aio.Wait(kInvalidAsyncIOToken));
+}
+
+/// Feature: FileAsyncIO
+/// Description: Write a file, then overwrite it with the data of a smaller size.
+/// Expectation: The file only holds the data of the last write.
+TEST_F(TestFileAsyncIO, test_overwrite_with_smaller_data) {
+  FileAsyncIO file_aio;
+  EXPECT_TRUE(file_aio.Init({kBlockSize, kQueueDepth}));
+  std::vector<uint8_t> large_data(kDataSize, 1);
+  EXPECT_TRUE(file_aio.Write(file_names_[0], large_data.data(), kDataSize));
+  std::vector<uint8_t> small_data(kBlockSize, 2);
+  EXPECT_TRUE(file_aio.Write(file_names_[0], small_data.data(), kBlockSize));
+
+  struct stat file_stat {};
+  ASSERT_EQ(stat(file_names_[0].c_str(), &file_stat), 0);
+  EXPECT_EQ(static_cast<size_t>(file_stat.st_size), kBlockSize);
+  std::vector<uint8_t> read_data(kBlockSize, 0);
+  EXPECT_TRUE(file_aio.Read(file_names_[0], read_data.data(), kBlockSize));
+  EXPECT_EQ(read_data, small_data);
+}
+}  // namespace mindspore::device
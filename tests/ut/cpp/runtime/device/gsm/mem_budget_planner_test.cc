@@ -0,0 +1,151 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "ir/primitive.h"
+#include "runtime/device/gsm/mem_budget_planner.h"
+
+namespace mindspore::device {
+namespace {
+constexpr size_t kKernelNum = 6;
+constexpr size_t kWeightSize = 10;
+constexpr size_t kActivationSize = 1000;
+constexpr size_t kMemBudget = 1000;
+constexpr double kKernelCost = 10;
+
+// The forward kernels 0 to 4 form a chain from the weight, and the backward kernel 5 uses the activation of kernel 0
+// again, so the activation leaves a gap in kernels 2 to 4.
+class PlannerGraph {
+ public:
+  explicit PlannerGraph(bool random_activation) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto weight = func_graph->add_parameter();
+    auto primitive = std::make_shared<Primitive>("ReLU");
+    if (random_activation) {
+      (void)primitive->AddAttr("seed", MakeValue<int64_t>(0));
+    }
+    auto activation = func_graph->NewCNode({NewValueNode(primitive), weight});
+    std::vector<AnfNodePtr> nodes = {weight, activation};
+    for (size_t i = 2; i <= kKernelNum; ++i) {
+      (void)nodes.emplace_back(func_graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Add")), nodes.back()}));
+    }
+    for (size_t i = 0; i <= kKernelNum; ++i) {
+      auto info = std::make_shared<MemUsageTensorInfo>();
+      info->tensor_id_ = i;
+      info->node_ = nodes[i];
+      info->tensor_size_ = i == 0 ? kWeightSize : kActivationSize;
+      (void)tensor_infos_.emplace_back(info);
+    }
+    tensor_infos_[0]->is_graph_input_ = true;
+    tensor_infos_[kKernelNum]->is_graph_output_ = true;
+    for (size_t i = 0; i < kKernelNum; ++i) {
+      auto info = std::make_shared<MemUsageKernelInfo>();
+      info->input_tensors_ = {i};
+      info->output_tensors_ = {i + 1};
+      (void)kernel_infos_.emplace_back(info);
+    }
+    (void)kernel_infos_[kKernelNum - 1]->input_tensors_.emplace_back(1);
+    for (size_t i = 0; i < kKernelNum; ++i) {
+      for (auto tensor_id : kernel_infos_[i]->input_tensors_) {
+        (void)tensor_infos_[tensor_id]->used_by_kernels_.emplace_back(i);
+      }
+      for (auto tensor_id : kernel_infos_[i]->output_tensors_) {
+        (void)tensor_infos_[tensor_id]->used_by_kernels_.emplace_back(i);
+      }
+    }
+  }
+
+  // The weight is kept from the kernel 0 to the next step, and the activation 1 is used by kernel 1 and kernel 5.
+  std::vector<ActivationSpanPtr> BuildSpans() const {
+    auto weight_span = std::make_shared<ActivationSpan>();
+    weight_span->tensor_id_ = 0;
+    weight_span->tensor_size_ = kWeightSize;
+    weight_span->last_index_ = 0;
+    weight_span->current_index_ = kKernelNum;
+    weight_span->weight_ = (kKernelNum - 1) * kWeightSize;
+    auto activation_span = std::make_shared<ActivationSpan>();
+    activation_span->tensor_id_ = 1;
+    activation_span->tensor_size_ = kActivationSize;
+    activation_span->last_index_ = 1;
+    activation_span->current_index_ = kKernelNum - 1;
+    activation_span->weight_ = (kKernelNum - 3) * kActivationSize;
+    return {weight_span, activation_span};
+  }
+
+  std::vector<ActivationSpanPtr> Plan(const std::shared_ptr<SwapContext> &context) const {
+    MemBudgetPlanner planner(kernel_infos_, tensor_infos_, context);
+    planner.SetKernelCosts(std::vector<double>(kKernelNum, kKernelCost));
+    auto spans = BuildSpans();
+    std::vector<size_t> mem_used(kKernelNum, kActivationSize / 10);
+    std::vector<size_t> host_mem_used(kKernelNum, 0);
+    planner.Plan(spans, &mem_used, &host_mem_used);
+    return spans;
+  }
+
+ private:
+  std::vector<std::shared_ptr<MemUsageKernelInfo>> kernel_infos_;
+  std::vector<std::shared_ptr<MemUsageTensorInfo>> tensor_infos_;
+};
+
+std::shared_ptr<SwapContext> BuildContext(bool swap_supported) {
+  auto context = std::make_shared<SwapContext>();
+  context->hbm_mem_size_ = kMemBudget;
+  context->cpu_mem_size_ = kActivationSize;
+  context->swap_supported_ = swap_supported;
+  return context;
+}
+}  // namespace
+
+class TestMemBudgetPlanner : public UT::Common {
+ public:
+  TestMemBudgetPlanner() = default;
+};
+
+/// Feature: MemBudgetPlanner
+/// Description: Plan the activation which exceeds the budget on the device which can't swap.
+/// Expectation: The activation is recomputed by the kernel 0, and the random kernel is kept beyond the budget.
+TEST_F(TestMemBudgetPlanner, test_recompute_without_swap) {
+  auto spans = PlannerGraph(false).Plan(BuildContext(false));
+  EXPECT_EQ(spans[0]->plan_, ActivationPlanType::kKeep);
+  EXPECT_EQ(spans[1]->plan_, ActivationPlanType::kRecompute);
+  EXPECT_EQ(spans[1]->cost_, kKernelCost);
+
+  spans = PlannerGraph(true).Plan(BuildContext(false));
+  EXPECT_EQ(spans[1]->plan_, ActivationPlanType::kKeep);
+}
+
+/// Feature: MemBudgetPlanner
+/// Description: Plan the activation with the host memory, the slow disk and the recompute.
+/// Expectation: The swap hidden by the gap is preferred, otherwise the recompute is cheaper than the slow disk.
+TEST_F(TestMemBudgetPlanner, test_choose_swap_or_recompute) {
+  auto context = BuildContext(true);
+  auto spans = PlannerGraph(false).Plan(context);
+  EXPECT_EQ(spans[1]->plan_, ActivationPlanType::kSwapToHost);
+  EXPECT_EQ(spans[1]->cost_, 0);
+
+  context->cpu_mem_size_ = 0;
+  context->disk_bandwidth_ = 1;
+  spans = PlannerGraph(false).Plan(context);
+  EXPECT_EQ(spans[1]->plan_, ActivationPlanType::kRecompute);
+
+  context->disk_bandwidth_ = kActivationSize;
+  spans = PlannerGraph(true).Plan(context);
+  EXPECT_EQ(spans[1]->plan_, ActivationPlanType::kSwapToDisk);
+}
+}  // namespace mindspore::device
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "common/common_test.h"
+#include "include/common/debug/common.h"
+#include "include/common/utils/compile_cache_context.h"
+#include "runtime/graph_scheduler/backend_compile_cache.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr char kDeviceTarget[] = "Ascend";
+constexpr char kGraphHash[] = "graph_hash_0";
+constexpr uint64_t kCompileTime = 1000;
+
+void WriteFile(const std::string &file_path, const std::string &content) {
+  std::ofstream ofs(file_path);
+  ofs << content;
+}
+}  // namespace
+
+class BackendCompileCacheTest : public UT::Common {
+ public:
+  BackendCompileCacheTest() = default;
+
+  void SetUp() override { cache_path_ = "./backend_compile_cache_test_" + std::to_string(getpid()); }
+  void TearDown() override {
+    BackendCompileCache::Remove(cache_path_);
+    CompileCacheContext::GetInstance().SetUseCompileCache(false);
+  }
+
+  // Write the cache files as the session caches the kernel graph.
+  void WriteCacheFiles() const {
+    WriteFile(cache_path_ + kJsonSuffix, "{}");
+    WriteFile(cache_path_ + kMindIrSuffix, "mindir");
+  }
+
+  bool MetaExists() const { return mindspore::Common::FileExists(cache_path_ + kBackendCompileCacheMetaSuffix); }
+
+  std::string cache_path_;
+};
+
+/// Feature: Backend compile cache.
+/// Description: Check the cache against the keys with a different version, device target or graph hash, and the
+/// missing or broken meta.
+/// Expectation: Only the same key hits the cache and gets the recorded compile time, the others miss.
+TEST_F(BackendCompileCacheTest, MetaMismatch) {
+  const auto &key = BackendCompileCache::GenKey(kDeviceTarget, kGraphHash);
+  uint64_t compile_time = 0;
+  WriteCacheFiles();
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, key, &compile_time));
+  ASSERT_TRUE(BackendCompileCache::ExportMeta(cache_path_, key, kCompileTime));
+  ASSERT_TRUE(BackendCompileCache::Check(cache_path_, key, &compile_time));
+  ASSERT_EQ(compile_time, kCompileTime);
+
+  const auto &other_device_key = BackendCompileCache::GenKey("CPU", kGraphHash);
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, other_device_key, &compile_time));
+  const auto &other_graph_key = BackendCompileCache::GenKey(kDeviceTarget, "graph_hash_1");
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, other_graph_key, &compile_time));
+  auto old_version_key = key;
+  old_version_key["version"] = "0";
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, old_version_key, &compile_time));
+
+  // The cache files are lost while the meta is left.
+  ASSERT_EQ(std::remove((cache_path_ + kMindIrSuffix).c_str()), 0);
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, key, &compile_time));
+
+  // The meta is broken.
+  BackendCompileCache::Remove(cache_path_);
+  WriteCacheFiles();
+  WriteFile(cache_path_ + kBackendCompileCacheMetaSuffix, "{\"version\": ");
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, key, &compile_time));
+  BackendCompileCache::Remove(cache_path_);
+  WriteCacheFiles();
+  WriteFile(cache_path_ + kBackendCompileCacheMetaSuffix, "[]");
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, key, &compile_time));
+}
+
+/// Feature: Backend compile cache.
+/// Description: Export the cache over the stale cache of another graph, with the caching succeeded and failed.
+/// Expectation: The stale files are removed before caching, and no meta is left if the caching fails.
+TEST_F(BackendCompileCacheTest, RemoveStaleFiles) {
+  const auto &stale_key = BackendCompileCache::GenKey(kDeviceTarget, kGraphHash);
+  const auto &key = BackendCompileCache::GenKey(kDeviceTarget, "graph_hash_1");
+  WriteCacheFiles();
+  ASSERT_TRUE(BackendCompileCache::ExportMeta(cache_path_, stale_key, kCompileTime));
+
+  BackendCompileCache cache;
+  cache.BeginCompile(cache_path_, key, true);
+  ASSERT_TRUE(cache.export_cache());
+  bool stale_files_removed = false;
+  cache.Export(
+    [this, &stale_files_removed]() {
+      stale_files_removed = !mindspore::Common::FileExists(cache_path_ + kJsonSuffix) &&
+                            !mindspore::Common::FileExists(cache_path_ + kMindIrSuffix) && !MetaExists();
+      WriteCacheFiles();
+    },
+    "graph_0");
+  ASSERT_TRUE(stale_files_removed);
+  uint64_t compile_time = 0;
+  ASSERT_TRUE(BackendCompileCache::Check(cache_path_, key, &compile_time));
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, stale_key, &compile_time));
+
+  // The caching of kernel graph fails, and the cache of the last graph is not valid any more.
+  cache.BeginCompile(cache_path_, stale_key, true);
+  ASSERT_TRUE(cache.export_cache());
+  cache.Export([]() {}, "graph_1");
+  ASSERT_FALSE(MetaExists());
+  ASSERT_FALSE(mindspore::Common::FileExists(cache_path_ + kJsonSuffix));
+  ASSERT_FALSE(BackendCompileCache::Check(cache_path_, key, &compile_time));
+}
+
+/// Feature: Backend compile cache.
+/// Description: Compile the graphs with the cache hit, missed and disabled in turn.
+/// Expectation: The cache is used only when it hits and exported only when it misses, and neither flag is left
+/// after the reset, so the graphs compiled later neither use nor export the cache.
+TEST_F(BackendCompileCacheTest, ResetFlags) {
+  const auto &key = BackendCompileCache::GenKey(kDeviceTarget, kGraphHash);
+  WriteCacheFiles();
+  ASSERT_TRUE(BackendCompileCache::ExportMeta(cache_path_, key, kCompileTime));
+
+  BackendCompileCache cache;
+  cache.BeginCompile(cache_path_, key, true);
+  ASSERT_TRUE(cache.use_cache());
+  ASSERT_FALSE(cache.export_cache());
+  cache.Reset();
+  ASSERT_FALSE(cache.use_cache());
+  ASSERT_FALSE(cache.export_cache());
+
+  // The frontend compile cache is not used, so the backend one is exported again even though it matches.
+  cache.BeginCompile(cache_path_, key, false);
+  ASSERT_FALSE(cache.use_cache());
+  ASSERT_TRUE(cache.export_cache());
+  cache.Reset();
+  ASSERT_FALSE(cache.export_cache());
+
+  cache.BeginCompile(cache_path_, BackendCompileCache::GenKey("CPU", kGraphHash), true);
+  ASSERT_FALSE(cache.use_cache());
+  ASSERT_TRUE(cache.export_cache());
+
+  // The flags of the last compiling don't leak into the next one which hits.
+  cache.BeginCompile(cache_path_, key, true);
+  ASSERT_TRUE(cache.use_cache());
+  ASSERT_FALSE(cache.export_cache());
+  cache.Reset();
+  ASSERT_EQ(cache.hit_num(), 2U);
+  ASSERT_EQ(cache.miss_num(), 2U);
+}
+
+/// Feature: Backend compile cache.
+/// Description: Compile the graphs with the frontend compile cache used, and the backend cache hit, missed by the
+/// missing files and missed by the stale key.
+/// Expectation: The device compile cache keeps being used only if the backend cache hits, otherwise it is disabled so
+/// that the device compiles the graph again instead of loading the stale cache.
+TEST_F(BackendCompileCacheTest, MissDisablesDeviceCache) {
+  auto &compile_cache_context = CompileCacheContext::GetInstance();
+  const auto &key = BackendCompileCache::GenKey(kDeviceTarget, kGraphHash);
+  BackendCompileCache cache;
+
+  compile_cache_context.SetUseCompileCache(true);
+  cache.BeginCompile(cache_path_, key, compile_cache_context.UseCompileCache());
+  ASSERT_FALSE(cache.use_cache());
+  ASSERT_TRUE(cache.export_cache());
+  ASSERT_FALSE(compile_cache_context.UseCompileCache());
+  cache.Reset();
+
+  WriteCacheFiles();
+  ASSERT_TRUE(BackendCompileCache::ExportMeta(cache_path_, key, kCompileTime));
+  compile_cache_context.SetUseCompileCache(true);
+  cache.BeginCompile(cache_path_, key, compile_cache_context.UseCompileCache());
+  ASSERT_TRUE(cache.use_cache());
+  ASSERT_TRUE(compile_cache_context.UseCompileCache());
+  cache.Reset();
+
+  cache.BeginCompile(cache_path_, BackendCompileCache::GenKey(kDeviceTarget, "graph_hash_1"),
+                     compile_cache_context.UseCompileCache());
+  ASSERT_FALSE(cache.use_cache());
+  ASSERT_TRUE(cache.export_cache());
+  ASSERT_FALSE(compile_cache_context.UseCompileCache());
+}
+}  // namespace runtime
+}  // namespace mindspore
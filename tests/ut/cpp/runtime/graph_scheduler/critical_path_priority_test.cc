@@ -0,0 +1,353 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/graph_scheduler/optimizer/critical_path_priority.h"
+#include "thread/actor_threadpool.h"
+#include "async/async.h"
+#include "mindrt.hpp"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// One actor thread makes the run order of the ready actors decided only by the scheduling.
+constexpr size_t kActorThreadNum = 1;
+constexpr size_t kTowerNum = 3;
+constexpr size_t kTowerDepth = 8;
+constexpr size_t kSideBranchNum = 48;
+constexpr int64_t kHeavyCost = 40;
+constexpr int64_t kLightCost = 4;
+constexpr int kStepNum = 3;
+constexpr size_t kSourceIndex = 0;
+constexpr size_t kSinkIndex = 1;
+constexpr int64_t kProbePriority = 20;
+
+// The actor of the branchy graph, which records its run order and then triggers its successors.
+class BranchyNodeActor : public ActorBase {
+ public:
+  BranchyNodeActor(const std::string &name, ActorThreadPool *pool, size_t index, size_t input_num)
+      : ActorBase(name, pool), index_(index), input_num_(input_num) {}
+  ~BranchyNodeActor() override = default;
+
+  void OnInput() {
+    if (++received_num_ < input_num_) {
+      return;
+    }
+    received_num_ = 0;
+    {
+      std::lock_guard<std::mutex> lock(*run_order_mutex_);
+      (void)run_order_->emplace_back(index_);
+    }
+    for (const auto &successor : successors_) {
+      Async(successor, &BranchyNodeActor::OnInput);
+    }
+    if (finished_step_num_ != nullptr) {
+      finished_step_num_->fetch_add(1);
+    }
+  }
+
+  std::vector<AID> successors_;
+  std::mutex *run_order_mutex_{nullptr};
+  std::vector<size_t> *run_order_{nullptr};
+  std::atomic_int *finished_step_num_{nullptr};
+
+ private:
+  size_t index_;
+  size_t input_num_;
+  size_t received_num_{0};
+};
+using BranchyNodeActorPtr = std::shared_ptr<BranchyNodeActor>;
+
+// The branchy graph like the multi-tower recommender: the source triggers the cheap side branches first and then the
+// towers of heavy kernels, and the sink waits for all of them.
+struct BranchyGraph {
+  std::vector<std::vector<size_t>> successors_;
+  std::vector<int64_t> costs_;
+  std::vector<size_t> input_nums_;
+
+  size_t AddNode(int64_t cost) {
+    (void)successors_.emplace_back();
+    (void)costs_.emplace_back(cost);
+    (void)input_nums_.emplace_back(0);
+    return costs_.size() - 1;
+  }
+  void AddEdge(size_t from, size_t to) {
+    (void)successors_[from].emplace_back(to);
+    ++input_nums_[to];
+  }
+  bool IsSideBranch(size_t index) const { return index > kSinkIndex && costs_[index] == kLightCost; }
+  bool IsTower(size_t index) const { return costs_[index] == kHeavyCost; }
+};
+
+BranchyGraph BuildBranchyGraph() {
+  BranchyGraph graph;
+  auto source = graph.AddNode(1);
+  auto sink = graph.AddNode(1);
+  for (size_t i = 0; i < kSideBranchNum; ++i) {
+    auto side = graph.AddNode(kLightCost);
+    graph.AddEdge(source, side);
+    graph.AddEdge(side, sink);
+  }
+  for (size_t i = 0; i < kTowerNum; ++i) {
+    auto prev = source;
+    for (size_t j = 0; j < kTowerDepth; ++j) {
+      auto node = graph.AddNode(kHeavyCost);
+      graph.AddEdge(prev, node);
+      prev = node;
+    }
+    graph.AddEdge(prev, sink);
+  }
+  return graph;
+}
+
+// Run the branchy graph by the actors for steps and return the run order of the nodes in every step.
+std::vector<std::vector<size_t>> RunBranchyGraph(const BranchyGraph &graph, bool priority_scheduling,
+                                                 const std::string &name) {
+  std::unique_ptr<ActorThreadPool> pool(ActorThreadPool::CreateThreadPool(kActorThreadNum));
+  EXPECT_NE(pool, nullptr);
+  pool->SetPriorityScheduling(priority_scheduling);
+  auto priorities = ComputeCriticalPathPriorities(graph.successors_, graph.costs_);
+
+  std::mutex run_order_mutex;
+  std::vector<size_t> run_order;
+  std::vector<BranchyNodeActorPtr> actors;
+  for (size_t i = 0; i < graph.costs_.size(); ++i) {
+    auto input_num = graph.input_nums_[i] == 0 ? 1 : graph.input_nums_[i];
+    auto actor = std::make_shared<BranchyNodeActor>(name + "_" + std::to_string(i), pool.get(), i, input_num);
+    actor->set_priority(priorities[i]);
+    actor->run_order_mutex_ = &run_order_mutex;
+    actor->run_order_ = &run_order;
+    (void)actors.emplace_back(actor);
+  }
+  for (size_t i = 0; i < actors.size(); ++i) {
+    for (auto successor : graph.successors_[i]) {
+      (void)actors[i]->successors_.emplace_back(actors[successor]->GetAID());
+    }
+    (void)Spawn(actors[i]);
+  }
+
+  std::atomic_int finished_step_num{0};
+  actors[kSinkIndex]->finished_step_num_ = &finished_step_num;
+  std::vector<std::vector<size_t>> step_run_orders;
+  for (int step = 0; step < kStepNum; ++step) {
+    Async(actors[kSourceIndex]->GetAID(), &BranchyNodeActor::OnInput);
+    while (finished_step_num.load() <= step) {
+      std::this_thread::yield();
+    }
+    // The sink runs at last, so all the nodes of this step have been recorded.
+    std::lock_guard<std::mutex> lock(run_order_mutex);
+    (void)step_run_orders.emplace_back(std::move(run_order));
+    run_order.clear();
+  }
+
+  for (const auto &actor : actors) {
+    Terminate(actor->GetAID());
+    Await(actor->GetAID());
+  }
+  return step_run_orders;
+}
+
+// The time when the last tower node finishes, that is when the critical path completes, if the nodes run one after
+// another in the run order with their costs.
+int64_t CriticalPathCompletionTime(const BranchyGraph &graph, const std::vector<size_t> &run_order) {
+  int64_t time = 0;
+  int64_t completion_time = 0;
+  for (auto index : run_order) {
+    time += graph.costs_[index];
+    if (graph.IsTower(index)) {
+      completion_time = time;
+    }
+  }
+  return completion_time;
+}
+
+// The actor of the inline probe, which records its run order, waits for the gate if set, and then triggers its
+// successors.
+class InlineProbeActor : public ActorBase {
+ public:
+  InlineProbeActor(const std::string &name, ActorThreadPool *pool, size_t index, std::vector<size_t> *run_order)
+      : ActorBase(name, pool), index_(index), run_order_(run_order) {}
+  ~InlineProbeActor() override = default;
+
+  void OnInput() {
+    (void)run_order_->emplace_back(index_);
+    started_ = true;
+    while (gate_ != nullptr && !gate_->load()) {
+      std::this_thread::yield();
+    }
+    for (const auto &successor : successors_) {
+      Async(successor, &InlineProbeActor::OnInput);
+    }
+    (void)finished_num_->fetch_add(1);
+  }
+
+  std::vector<AID> successors_;
+  std::atomic_bool *gate_{nullptr};
+  std::atomic_int *finished_num_{nullptr};
+  std::atomic_bool started_{false};
+
+ private:
+  size_t index_;
+  std::vector<size_t> *run_order_;
+};
+
+// The actor 0 triggers the successors 1 (and 2 if fan out) with the lower priorities, while the actor 3 without
+// priority is queued in the fifo queue by another thread. Return the run order of the actors.
+std::vector<size_t> RunInlineProbe(bool fan_out, const std::string &name) {
+  std::unique_ptr<ActorThreadPool> pool(ActorThreadPool::CreateThreadPool(kActorThreadNum));
+  EXPECT_NE(pool, nullptr);
+  pool->SetPriorityScheduling(true);
+  const std::vector<int64_t> priorities = {kProbePriority, kProbePriority / 2, kProbePriority / 4, 0};
+  std::vector<size_t> run_order;
+  std::atomic_bool gate{false};
+  std::atomic_int finished_num{0};
+  std::vector<std::shared_ptr<InlineProbeActor>> actors;
+  for (size_t i = 0; i < priorities.size(); ++i) {
+    auto actor = std::make_shared<InlineProbeActor>(name + "_" + std::to_string(i), pool.get(), i, &run_order);
+    actor->set_priority(priorities[i]);
+    actor->finished_num_ = &finished_num;
+    (void)actors.emplace_back(actor);
+    (void)Spawn(actor);
+  }
+  actors[0]->gate_ = &gate;
+  (void)actors[0]->successors_.emplace_back(actors[1]->GetAID());
+  if (fan_out) {
+    (void)actors[0]->successors_.emplace_back(actors[2]->GetAID());
+  }
+
+  Async(actors[0]->GetAID(), &InlineProbeActor::OnInput);
+  while (!actors[0]->started_.load()) {
+    std::this_thread::yield();
+  }
+  Async(actors[3]->GetAID(), &InlineProbeActor::OnInput);
+  gate = true;
+  int run_num = fan_out ? 4 : 3;
+  while (finished_num.load() < run_num) {
+    std::this_thread::yield();
+  }
+
+  for (const auto &actor : actors) {
+    Terminate(actor->GetAID());
+    Await(actor->GetAID());
+  }
+  return run_order;
+}
+
+// The positions of the first side branch and the last tower node in the run order.
+std::pair<size_t, size_t> FirstSideAndLastTower(const BranchyGraph &graph, const std::vector<size_t> &run_order) {
+  size_t first_side = run_order.size();
+  size_t last_tower = 0;
+  for (size_t i = 0; i < run_order.size(); ++i) {
+    if (graph.IsSideBranch(run_order[i]) && first_side == run_order.size()) {
+      first_side = i;
+    }
+    if (graph.IsTower(run_order[i])) {
+      last_tower = i;
+    }
+  }
+  return {first_side, last_tower};
+}
+}  // namespace
+
+class CriticalPathPriorityTest : public UT::Common {
+ public:
+  CriticalPathPriorityTest() = default;
+};
+
+/// Feature: Critical path scheduling of actors.
+/// Description: Compute the priorities of the diamond graph and the graph with cycle.
+/// Expectation: The priority is the cost of the longest path to the end, and the edge in the cycle is ignored.
+TEST_F(CriticalPathPriorityTest, ComputePriorities) {
+  // 0 -> 1 -> 3, 0 -> 2 -> 3.
+  std::vector<std::vector<size_t>> successors = {{1, 2}, {3}, {3}, {}};
+  ASSERT_EQ(ComputeCriticalPathPriorities(successors, {1, 5, 2, 1}), (std::vector<int64_t>{7, 6, 3, 1}));
+
+  // The loop from the node 3 back to the node 0 is ignored.
+  successors[3] = {0};
+  ASSERT_EQ(ComputeCriticalPathPriorities(successors, {1, 5, 2, 1}), (std::vector<int64_t>{7, 6, 3, 1}));
+  ASSERT_TRUE(ComputeCriticalPathPriorities({}, {}).empty());
+}
+
+/// Feature: Critical path scheduling of actors.
+/// Description: Run the branchy graph of towers and side branches, whose source triggers the side branches first, by
+/// the fifo and the critical path scheduling.
+/// Expectation: The fifo runs the side branches in the triggered order before the towers, and the critical path
+/// scheduling runs all the tower nodes on the critical path before any side branch in every step.
+TEST_F(CriticalPathPriorityTest, BranchyGraphSchedulingOrder) {
+  auto graph = BuildBranchyGraph();
+  const size_t node_num = graph.costs_.size();
+
+  auto fifo_orders = RunBranchyGraph(graph, false, "FifoBranchy");
+  ASSERT_EQ(fifo_orders.size(), IntToSize(kStepNum));
+  for (const auto &run_order : fifo_orders) {
+    ASSERT_EQ(run_order.size(), node_num);
+    ASSERT_EQ(run_order.front(), kSourceIndex);
+    ASSERT_EQ(run_order.back(), kSinkIndex);
+    ASSERT_TRUE(graph.IsSideBranch(run_order[1]));
+  }
+
+  auto priority_orders = RunBranchyGraph(graph, true, "PriorityBranchy");
+  ASSERT_EQ(priority_orders.size(), IntToSize(kStepNum));
+  for (const auto &run_order : priority_orders) {
+    ASSERT_EQ(run_order.size(), node_num);
+    ASSERT_EQ(run_order.front(), kSourceIndex);
+    ASSERT_EQ(run_order.back(), kSinkIndex);
+    auto [first_side, last_tower] = FirstSideAndLastTower(graph, run_order);
+    ASSERT_LT(last_tower, first_side);
+  }
+}
+
+/// Feature: Critical path scheduling of actors.
+/// Description: Run the branchy graph, whose side branches contend with the towers for the actor thread, by the fifo
+/// and the critical path scheduling, and replay the run order with the costs of the nodes.
+/// Expectation: The critical path completes earlier under the critical path scheduling than under the fifo in every
+/// step.
+TEST_F(CriticalPathPriorityTest, CriticalPathCompletionUnderContention) {
+  auto graph = BuildBranchyGraph();
+  auto fifo_orders = RunBranchyGraph(graph, false, "FifoContention");
+  auto priority_orders = RunBranchyGraph(graph, true, "PriorityContention");
+  ASSERT_EQ(fifo_orders.size(), IntToSize(kStepNum));
+  ASSERT_EQ(priority_orders.size(), IntToSize(kStepNum));
+  // All the tower nodes run before the side branches under the critical path scheduling, and after them under fifo.
+  const int64_t tower_cost = SizeToLong(kTowerNum * kTowerDepth) * kHeavyCost;
+  const int64_t side_cost = SizeToLong(kSideBranchNum) * kLightCost;
+  for (size_t step = 0; step < IntToSize(kStepNum); ++step) {
+    auto fifo_time = CriticalPathCompletionTime(graph, fifo_orders[step]);
+    auto priority_time = CriticalPathCompletionTime(graph, priority_orders[step]);
+    EXPECT_EQ(priority_time, graph.costs_[kSourceIndex] + tower_cost);
+    EXPECT_EQ(fifo_time, graph.costs_[kSourceIndex] + tower_cost + side_cost);
+    EXPECT_LT(priority_time, fifo_time);
+  }
+}
+
+/// Feature: Critical path scheduling of actors.
+/// Description: An actor triggers a single successor or two successors, while an actor without priority is queued in
+/// the fifo queue.
+/// Expectation: The single successor runs inline before the queued actor. The two successors are both queued, so the
+/// queued actor runs first and then the successors in the order of priority.
+TEST_F(CriticalPathPriorityTest, InlineOnlySingleReadySuccessor) {
+  EXPECT_EQ(RunInlineProbe(false, "InlineChain"), (std::vector<size_t>{0, 1, 3}));
+  EXPECT_EQ(RunInlineProbe(true, "InlineFanOut"), (std::vector<size_t>{0, 3, 1, 2}));
+}
+}  // namespace runtime
+}  // namespace mindspore
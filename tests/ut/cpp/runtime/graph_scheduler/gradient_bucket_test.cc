@@ -0,0 +1,197 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/gradient_bucket_actor.h"
+#include "plugin/device/cpu/hal/device/cpu_device_address.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace runtime {
+class GradientBucketTest : public UT::Common {
+ public:
+  GradientBucketTest() {}
+};
+
+using Buckets = std::vector<std::vector<size_t>>;
+using device::DeviceAddressPtr;
+using device::cpu::CPUDeviceAddress;
+
+namespace {
+// Build the group of buckets with the gradient sizes in bytes, the members are placeholders because only the number of
+// them is used by the group.
+GradientBucketGroupPtr BuildBucketGroup(const std::vector<std::vector<size_t>> &bucket_gradient_sizes) {
+  auto group = std::make_shared<GradientBucketGroup>();
+  for (const auto &gradient_sizes : bucket_gradient_sizes) {
+    auto bucket = std::make_shared<GradientBucket>(group->buckets_.size(), group.get());
+    for (auto size : gradient_sizes) {
+      (void)bucket->members_.emplace_back(nullptr);
+      (void)bucket->offsets_.emplace_back(bucket->size_);
+      bucket->size_ += size;
+    }
+    (void)group->buckets_.emplace_back(bucket);
+  }
+  return group;
+}
+
+std::vector<size_t> BucketIndexes(const std::vector<GradientBucket *> &buckets) {
+  std::vector<size_t> indexes;
+  for (const auto &bucket : buckets) {
+    (void)indexes.emplace_back(bucket->index_);
+  }
+  return indexes;
+}
+}  // namespace
+
+/// Feature: Partition the gradient buckets.
+/// Description: Partition the independent gradients with the same fusion id.
+/// Expectation: The bucket size is not exceeded, and the gradient larger than bucket size takes a bucket alone.
+TEST_F(GradientBucketTest, PartitionBySize) {
+  std::vector<GradientInfo> gradients = {{0, 40, 1, -1}, {1, 40, 1, -1}, {2, 40, 1, -1}, {4, 200, 1, -1},
+                                         {5, 20, 1, -1}, {6, 80, 1, -1}};
+  ASSERT_EQ(PartitionGradientBuckets(gradients, 100), (Buckets{{0, 1}, {2}, {3}, {4, 5}}));
+  ASSERT_EQ(PartitionGradientBuckets(gradients, 1000), (Buckets{{0, 1, 2, 3, 4, 5}}));
+  ASSERT_TRUE(PartitionGradientBuckets({}, 100).empty());
+}
+
+/// Feature: Partition the gradient buckets.
+/// Description: Partition the gradients with different fusion ids and dependencies.
+/// Expectation: A new bucket is started when the fusion id changes or the gradient depends on the current bucket.
+TEST_F(GradientBucketTest, PartitionByFusionAndDependency) {
+  std::vector<GradientInfo> gradients = {{0, 10, 1, -1}, {1, 10, 1, -1}, {2, 10, 2, -1}, {3, 10, 2, -1}};
+  ASSERT_EQ(PartitionGradientBuckets(gradients, 100), (Buckets{{0, 1}, {2, 3}}));
+
+  // The third gradient depends on the first one, and the fourth one depends on the gradient in the previous bucket.
+  gradients = {{0, 10, 1, -1}, {1, 10, 1, -1}, {3, 10, 1, 0}, {4, 10, 1, 1}};
+  ASSERT_EQ(PartitionGradientBuckets(gradients, 100), (Buckets{{0, 1}, {2, 3}}));
+}
+
+/// Feature: Launch the gradient buckets.
+/// Description: Make the gradients ready in a different order from the buckets in two steps.
+/// Expectation: The full buckets are launched only after all the previous buckets, in the order of index every step.
+TEST_F(GradientBucketTest, LaunchInOrder) {
+  auto group = BuildBucketGroup({{4, 4}, {4}, {4, 4}});
+  auto &buckets = group->buckets_;
+  for (size_t step = 0; step < 2; ++step) {
+    ASSERT_TRUE(group->AddReadyGradient(buckets[2].get()).empty());
+    ASSERT_TRUE(group->AddReadyGradient(buckets[1].get()).empty());
+    ASSERT_TRUE(group->AddReadyGradient(buckets[2].get()).empty());
+    ASSERT_TRUE(group->AddReadyGradient(buckets[0].get()).empty());
+    ASSERT_EQ(BucketIndexes(group->AddReadyGradient(buckets[0].get())), (std::vector<size_t>{0, 1, 2}));
+    ASSERT_EQ(group->next_launch_index_, 0U);
+    for (const auto &bucket : buckets) {
+      ASSERT_EQ(bucket->ready_num_, 0U);
+    }
+  }
+
+  ASSERT_TRUE(group->AddReadyGradient(buckets[1].get()).empty());
+  ASSERT_TRUE(group->AddReadyGradient(buckets[0].get()).empty());
+  ASSERT_EQ(BucketIndexes(group->AddReadyGradient(buckets[0].get())), (std::vector<size_t>{0, 1}));
+  ASSERT_EQ(group->next_launch_index_, 2U);
+}
+
+/// Feature: Launch the gradient buckets.
+/// Description: Fail the step with some buckets partially filled and some launched, then reset and run the next step.
+/// Expectation: The next step starts from the first bucket without the gradients left by the failed step.
+TEST_F(GradientBucketTest, ResetAfterFailedStep) {
+  auto group = BuildBucketGroup({{4}, {4, 4}, {4}});
+  auto &buckets = group->buckets_;
+  ASSERT_EQ(BucketIndexes(group->AddReadyGradient(buckets[0].get())), (std::vector<size_t>{0}));
+  ASSERT_TRUE(group->AddReadyGradient(buckets[1].get()).empty());
+  ASSERT_TRUE(group->AddReadyGradient(buckets[2].get()).empty());
+  group->Reset();
+  ASSERT_EQ(group->next_launch_index_, 0U);
+  for (const auto &bucket : buckets) {
+    ASSERT_EQ(bucket->ready_num_, 0U);
+  }
+
+  // Without the reset, the second bucket would be full with only one gradient of this step.
+  ASSERT_TRUE(group->AddReadyGradient(buckets[2].get()).empty());
+  ASSERT_TRUE(group->AddReadyGradient(buckets[1].get()).empty());
+  ASSERT_TRUE(group->AddReadyGradient(buckets[1].get()).empty());
+  ASSERT_EQ(BucketIndexes(group->AddReadyGradient(buckets[0].get())), (std::vector<size_t>{0, 1, 2}));
+}
+
+/// Feature: Launch the gradient buckets.
+/// Description: Pack the gradients of the full buckets, reduce the staging buffer in place as the AllReduce of two
+/// ranks does, and unpack it, with the buckets filled in reverse order.
+/// Expectation: The buckets are reduced in the order of index, and every output is the reduced gradient of its own.
+TEST_F(GradientBucketTest, PackLaunchUnpack) {
+  const std::vector<std::vector<size_t>> gradient_nums = {{3, 1}, {2}, {4, 2, 5}};
+  std::vector<std::vector<size_t>> gradient_sizes;
+  for (const auto &nums : gradient_nums) {
+    (void)gradient_sizes.emplace_back();
+    for (auto num : nums) {
+      (void)gradient_sizes.back().emplace_back(num * sizeof(float));
+    }
+  }
+  auto group = BuildBucketGroup(gradient_sizes);
+
+  std::vector<std::vector<std::vector<float>>> input_data(gradient_nums.size());
+  std::vector<std::vector<std::vector<float>>> output_data(gradient_nums.size());
+  std::vector<std::vector<DeviceAddressPtr>> inputs(gradient_nums.size());
+  std::vector<std::vector<DeviceAddressPtr>> outputs(gradient_nums.size());
+  float value = 1;
+  for (size_t i = 0; i < gradient_nums.size(); ++i) {
+    for (auto num : gradient_nums[i]) {
+      (void)input_data[i].emplace_back(num);
+      (void)output_data[i].emplace_back(num, 0);
+      for (auto &data : input_data[i].back()) {
+        data = value++;
+      }
+      (void)inputs[i].emplace_back(
+        std::make_shared<CPUDeviceAddress>(input_data[i].back().data(), num * sizeof(float)));
+      (void)outputs[i].emplace_back(
+        std::make_shared<CPUDeviceAddress>(output_data[i].back().data(), num * sizeof(float)));
+    }
+  }
+
+  std::vector<size_t> launch_order;
+  for (size_t i = gradient_nums.size(); i > 0; --i) {
+    auto &bucket = group->buckets_[i - 1];
+    for (size_t j = 0; j < gradient_nums[i - 1].size(); ++j) {
+      for (auto launch_bucket : group->AddReadyGradient(bucket.get())) {
+        std::vector<DeviceTensor *> launch_inputs;
+        std::vector<DeviceTensor *> launch_outputs;
+        for (size_t k = 0; k < launch_bucket->members_.size(); ++k) {
+          (void)launch_inputs.emplace_back(inputs[launch_bucket->index_][k].get());
+          (void)launch_outputs.emplace_back(outputs[launch_bucket->index_][k].get());
+        }
+        launch_bucket->Pack(launch_inputs);
+        auto buffer = reinterpret_cast<float *>(launch_bucket->buffer_.data());
+        for (size_t k = 0; k < launch_bucket->size_ / sizeof(float); ++k) {
+          buffer[k] *= 2;
+        }
+        launch_bucket->Unpack(launch_outputs);
+        (void)launch_order.emplace_back(launch_bucket->index_);
+      }
+    }
+  }
+  ASSERT_EQ(launch_order, (std::vector<size_t>{0, 1, 2}));
+  for (size_t i = 0; i < gradient_nums.size(); ++i) {
+    for (size_t j = 0; j < gradient_nums[i].size(); ++j) {
+      for (size_t k = 0; k < gradient_nums[i][j]; ++k) {
+        ASSERT_FLOAT_EQ(output_data[i][j][k], input_data[i][j][k] * 2);
+      }
+    }
+  }
+
+  // The gradient whose size doesn't match the bucket can't be packed.
+  std::vector<float> wrong_data(1);
+  auto wrong_input = std::make_shared<CPUDeviceAddress>(wrong_data.data(), sizeof(float));
+  ASSERT_ANY_THROW(group->buckets_[1]->Pack({wrong_input.get()}));
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "thread/threadpool.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kThreadNum = 4;
+constexpr int kTaskNum = 16;
+
+struct NumaContent {
+  std::vector<std::thread::id> thread_ids_;
+};
+
+int NumaFunc(void *content, int task_id, float, float) {
+  auto numa_content = static_cast<NumaContent *>(content);
+  numa_content->thread_ids_[task_id] = std::this_thread::get_id();
+  return THREAD_OK;
+}
+}  // namespace
+
+class ThreadPoolNumaTest : public UT::Common {
+ public:
+  ThreadPoolNumaTest() = default;
+};
+
+/// Feature: Numa aware thread pool.
+/// Description: Partition the workers to two numa nodes and launch the task on each numa node.
+/// Expectation: All the task splits are run by the workers of the specified numa node.
+TEST_F(ThreadPoolNumaTest, ParallelLaunchOnNumaNode) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  if (pool->thread_num() < kThreadNum) {
+    return;
+  }
+  pool->SetWorkerIdMap();
+  std::vector<std::vector<int>> numa_node_cpus = {{0, 1}, {2, 3}};
+  ASSERT_EQ(pool->SetNumaTopology(numa_node_cpus), THREAD_OK);
+  ASSERT_EQ(pool->numa_node_num(), numa_node_cpus.size());
+
+  for (size_t numa_node = 0; numa_node < numa_node_cpus.size(); ++numa_node) {
+    std::set<std::thread::id> node_thread_ids;
+    for (const auto &worker : pool->numa_node_workers(numa_node)) {
+      EXPECT_EQ(worker->numa_node(), static_cast<int>(numa_node));
+      (void)node_thread_ids.insert(worker->thread_id());
+    }
+    EXPECT_EQ(node_thread_ids.size(), kThreadNum / numa_node_cpus.size());
+
+    // The task splits are queued to the workers of the numa node even if they are still busy.
+    NumaContent content{std::vector<std::thread::id>(kTaskNum)};
+    EXPECT_EQ(pool->ParallelLaunchOnNumaNode(NumaFunc, &content, kTaskNum, static_cast<int>(numa_node)), THREAD_OK);
+    for (const auto &thread_id : content.thread_ids_) {
+      EXPECT_NE(node_thread_ids.find(thread_id), node_thread_ids.end());
+    }
+  }
+
+  // The invalid numa node falls back to the normal parallel launch.
+  NumaContent content{std::vector<std::thread::id>(kTaskNum)};
+  EXPECT_EQ(pool->ParallelLaunchOnNumaNode(NumaFunc, &content, kTaskNum, -1), THREAD_OK);
+  int dummy = 0;
+  EXPECT_GE(ThreadPool::GetNumaNodeOfAddress(&dummy), -1);
+}
+}  // namespace runtime
+}  // namespace mindspore
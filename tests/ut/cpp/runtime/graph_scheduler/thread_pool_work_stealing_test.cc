@@ -0,0 +1,258 @@
+/**
+ * Copyright 2024 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "thread/actor_threadpool.h"
+#include "async/async.h"
+#include "mindrt.hpp"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kThreadNum = 4;
+constexpr int kTaskNum = 32;
+constexpr int kLaunchNum = 20;
+constexpr size_t kCostUnit = 2000;
+constexpr auto kBlockTimeout = std::chrono::seconds(10);
+constexpr auto kStaticBlockTimeout = std::chrono::milliseconds(200);
+constexpr size_t kRangePerThread = 16;
+
+// The content of skewed parallel kernel, the cost of each task split is different.
+struct SkewedContent {
+  explicit SkewedContent(const std::vector<size_t> &costs) : costs_(costs), run_counts_(costs.size()) {}
+  std::vector<size_t> costs_;
+  std::vector<std::atomic_int> run_counts_;
+};
+
+int SkewedFunc(void *content, int task_id, float, float) {
+  auto skewed_content = static_cast<SkewedContent *>(content);
+  volatile size_t sum = 0;
+  for (size_t i = 0; i < skewed_content->costs_[task_id] * kCostUnit; ++i) {
+    sum = sum + i % 7;
+  }
+  (void)++skewed_content->run_counts_[task_id];
+  return THREAD_OK;
+}
+
+// Launch the skewed kernel repeatedly and check that every task split is run exactly once in each launch.
+void LaunchSkewedKernel(ThreadPool *pool, const std::vector<size_t> &costs) {
+  SkewedContent content(costs);
+  for (int i = 0; i < kLaunchNum; ++i) {
+    EXPECT_EQ(pool->ParallelLaunch(SkewedFunc, &content, static_cast<int>(costs.size())), THREAD_OK);
+  }
+  for (const auto &run_count : content.run_counts_) {
+    EXPECT_EQ(run_count.load(), kLaunchNum);
+  }
+}
+
+// The task split 0 blocks its worker until the task split 1 finishes. The task split 1 is queued behind the task split
+// 0 in the same worker, so it can only be finished in time by another thread which steals it.
+struct BlockedContent {
+  std::atomic_bool second_finished_{false};
+  std::atomic_bool first_unblocked_{false};
+  std::thread::id first_thread_;
+  std::thread::id second_thread_;
+};
+
+int BlockedFunc(void *content, int task_id, float, float) {
+  auto blocked_content = static_cast<BlockedContent *>(content);
+  if (task_id == 0) {
+    blocked_content->first_thread_ = std::this_thread::get_id();
+    auto start = std::chrono::steady_clock::now();
+    while (!blocked_content->second_finished_.load() && std::chrono::steady_clock::now() - start < kBlockTimeout) {
+      std::this_thread::yield();
+    }
+    blocked_content->first_unblocked_ = blocked_content->second_finished_.load();
+  } else if (task_id == 1) {
+    blocked_content->second_thread_ = std::this_thread::get_id();
+    blocked_content->second_finished_ = true;
+  }
+  return THREAD_OK;
+}
+
+// The skewed range of the parallel for: the first element is slow, it blocks until the last element of the static split
+// of the first thread is done. Under the static split, the last element is queued behind the first one in the same
+// task split, so it can only be done in time when the range is split into chunks which other threads can steal.
+struct SkewedRangeContent {
+  SkewedRangeContent(size_t count, size_t static_split_size, std::chrono::milliseconds timeout)
+      : static_split_size_(static_split_size), timeout_(timeout), run_counts_(count) {}
+  size_t static_split_size_;
+  std::chrono::milliseconds timeout_;
+  std::vector<std::atomic_int> run_counts_;
+  std::atomic_bool last_finished_{false};
+  std::atomic_bool first_unblocked_{false};
+  std::mutex mutex_;
+  // the threads which run the static split of the first thread
+  std::set<std::thread::id> first_split_threads_;
+};
+
+void RunSkewedRange(SkewedRangeContent *content, size_t start, size_t end) {
+  for (size_t i = start; i < end; ++i) {
+    if (i < content->static_split_size_) {
+      std::lock_guard<std::mutex> lock(content->mutex_);
+      (void)content->first_split_threads_.insert(std::this_thread::get_id());
+    }
+    if (i == 0) {
+      auto start_time = std::chrono::steady_clock::now();
+      while (!content->last_finished_.load() && std::chrono::steady_clock::now() - start_time < content->timeout_) {
+        std::this_thread::yield();
+      }
+      content->first_unblocked_ = content->last_finished_.load();
+    } else if (i == content->static_split_size_ - 1) {
+      content->last_finished_ = true;
+    }
+    (void)++content->run_counts_[i];
+  }
+}
+
+// The task splits are queued in the workers only when the kernel is launched by an actor thread, which runs its share
+// of the task splits by itself, so the kernels are launched by the actor.
+class LaunchActor : public ActorBase {
+ public:
+  LaunchActor(const std::string &name, ActorThreadPool *pool) : ActorBase(name, pool) {}
+  ~LaunchActor() override = default;
+
+  void Run() {
+    job_();
+    finished_ = true;
+  }
+
+  // Run the job in the actor thread and wait for it to finish.
+  void RunAndWait(const std::function<void()> &job) {
+    job_ = job;
+    finished_ = false;
+    Async(GetAID(), &LaunchActor::Run);
+    while (!finished_.load()) {
+      std::this_thread::yield();
+    }
+  }
+
+ private:
+  std::function<void()> job_;
+  std::atomic_bool finished_{false};
+};
+}  // namespace
+
+class ThreadPoolWorkStealingTest : public UT::Common {
+ public:
+  ThreadPoolWorkStealingTest() = default;
+};
+
+/// Feature: Work stealing of the thread pool.
+/// Description: Launch the sparse and ragged workloads with the static split and work stealing.
+/// Expectation: All the task splits are run exactly once in both modes.
+TEST_F(ThreadPoolWorkStealingTest, SkewedParallelLaunch) {
+  std::unique_ptr<ActorThreadPool> pool(ActorThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  auto actor = std::make_shared<LaunchActor>("SkewedLaunchActor", pool.get());
+  (void)Spawn(actor);
+
+  // Sparse workload: only a few task splits have the heavy work.
+  std::vector<size_t> sparse_costs(kTaskNum, 1);
+  sparse_costs[0] = kTaskNum;
+  sparse_costs[1] = kTaskNum;
+  // Ragged workload: the cost of task splits grows like the ragged batch.
+  std::vector<size_t> ragged_costs;
+  for (int i = 0; i < kTaskNum; ++i) {
+    ragged_costs.push_back(static_cast<size_t>(i % (kTaskNum / 2) + 1));
+  }
+
+  auto launch = [&pool, &sparse_costs, &ragged_costs]() {
+    LaunchSkewedKernel(pool.get(), sparse_costs);
+    LaunchSkewedKernel(pool.get(), ragged_costs);
+  };
+  actor->RunAndWait(launch);
+  pool->SetWorkStealing(true);
+  EXPECT_TRUE(pool->work_stealing());
+  actor->RunAndWait(launch);
+  pool->SetWorkStealing(false);
+  EXPECT_FALSE(pool->work_stealing());
+  Terminate(actor->GetAID());
+  Await(actor->GetAID());
+}
+
+/// Feature: Work stealing of the thread pool.
+/// Description: The first task split of a worker blocks until the second one queued behind it finishes.
+/// Expectation: The second task split is stolen and run by another thread, which unblocks the first one.
+TEST_F(ThreadPoolWorkStealingTest, StealQueuedTaskSplit) {
+  std::unique_ptr<ActorThreadPool> pool(ActorThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  pool->SetWorkStealing(true);
+  auto actor = std::make_shared<LaunchActor>("StealLaunchActor", pool.get());
+  (void)Spawn(actor);
+  BlockedContent content;
+  int ret = THREAD_ERROR;
+  // Each worker gets two task splits, so the task split 1 is queued in the worker of the task split 0.
+  actor->RunAndWait([&pool, &content, &ret]() {
+    ret = pool->ParallelLaunch(BlockedFunc, &content, static_cast<int>(kThreadNum * 2));
+  });
+  EXPECT_EQ(ret, THREAD_OK);
+  EXPECT_TRUE(content.first_unblocked_.load());
+  EXPECT_NE(content.first_thread_, content.second_thread_);
+  Terminate(actor->GetAID());
+  Await(actor->GetAID());
+}
+
+/// Feature: Chunked range splitting of the parallel for.
+/// Description: Launch a skewed range whose first element waits for the last element of the first static split, with
+///     the static split and with work stealing.
+/// Expectation: The static split runs the first split in a single thread, so the first element times out. Work
+///     stealing splits the range into chunks, and the chunks behind the slow one are stolen and run by other threads.
+TEST_F(ThreadPoolWorkStealingTest, ChunkedParallelForOnSkewedRange) {
+  std::unique_ptr<ActorThreadPool> pool(ActorThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  auto actor = std::make_shared<LaunchActor>("ChunkedLaunchActor", pool.get());
+  (void)Spawn(actor);
+  size_t thread_num = pool->GetKernelThreadNum();
+  ASSERT_GT(thread_num, 1u);
+  size_t count = thread_num * kRangePerThread;
+
+  auto launch_skewed_range = [&pool, &actor, count](SkewedRangeContent *content) {
+    actor->RunAndWait([&pool, count, content]() {
+      kernel::ParallelLaunch([content](size_t start, size_t end) { RunSkewedRange(content, start, end); }, count,
+                             1.0, nullptr, pool.get());
+    });
+    for (const auto &run_count : content->run_counts_) {
+      EXPECT_EQ(run_count.load(), 1);
+    }
+  };
+
+  SkewedRangeContent static_content(count, kRangePerThread, kStaticBlockTimeout);
+  launch_skewed_range(&static_content);
+  EXPECT_FALSE(static_content.first_unblocked_.load());
+  EXPECT_EQ(static_content.first_split_threads_.size(), 1u);
+
+  pool->SetWorkStealing(true);
+  SkewedRangeContent stealing_content(count, kRangePerThread,
+                                      std::chrono::duration_cast<std::chrono::milliseconds>(kBlockTimeout));
+  launch_skewed_range(&stealing_content);
+  EXPECT_TRUE(stealing_content.first_unblocked_.load());
+  EXPECT_GT(stealing_content.first_split_threads_.size(), 1u);
+  pool->SetWorkStealing(false);
+  Terminate(actor->GetAID());
+  Await(actor->GetAID());
+}
+}  // namespace runtime
+}  // namespace mindspore